@@ -39,6 +39,8 @@ struct MetricsStd {
     static MetricID QuicStreamsClosed;   // Total streams closed
     static MetricID QuicStreamsBytesRx;  // Total bytes received on streams
     static MetricID QuicStreamsBytesTx;  // Total bytes transmitted on streams
+    static MetricID QuicStreamsBytesRetransmit;  // Stream bytes resent after loss
+    static MetricID QuicStreamsSendRetainedBytes;  // Sent stream bytes held until ACKed (Gauge)
     static MetricID QuicStreamsResetRx;  // Total received RESET_STREAM frames
     static MetricID QuicStreamsResetTx;  // Total sent RESET_STREAM frames
 
@@ -61,6 +63,8 @@ struct MetricsStd {
     static MetricID CongestionEventsTotal;  // Total congestion events
     static MetricID SlowStartExits;         // Times exited slow start
     static MetricID BytesInFlight;          // Current bytes in flight (Gauge)
+    static MetricID CarefulResumeJumps;     // Connections that jumped to a saved cwnd
+    static MetricID CarefulResumeRetreats;  // Careful Resume jumps undone by loss
 
     // ==================== Performance / Latency ====================
     static MetricID RttSmoothedUs;        // Smoothed RTT (Gauge)
@@ -192,6 +192,20 @@ public:
      */
     virtual void SetPathParams(const std::unordered_map<std::string, std::string>& params) = 0;
 
+    /**
+     * @brief Get the transport statistics of the connection carrying the request
+     *
+     * Same snapshot as IQuicConnection::GetStats(); safe from any thread.
+     *
+     * @param stats Filled with the snapshot
+     * @return false if the request is not bound to a connection (not sent or
+     *         received yet, or the connection is gone)
+     */
+    virtual bool GetConnectionStats(QuicConnectionStats& stats) const {
+        (void)stats;
+        return false;
+    }
+
     /**
      * @brief Create a request instance
      *
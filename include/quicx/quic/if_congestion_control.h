@@ -0,0 +1,148 @@
+#ifndef QUIC_INCLUDE_IF_CONGESTION_CONTROL
+#define QUIC_INCLUDE_IF_CONGESTION_CONTROL
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace quicx {
+
+namespace common {
+    class QlogTrace;
+}
+
+namespace quic {
+
+/**
+ * @brief Congestion control algorithm used by a connection.
+ */
+enum class CongestionControlType {
+    kCubic,   //!< CUBIC (RFC 9438), the default.
+    kBbrV1,   //!< BBR v1.
+    kBbrV2,   //!< BBR v2.
+    kBbrV3,   //!< BBR v3.
+    kReno,    //!< NewReno (RFC 9002 §7).
+    kPrague,  //!< Prague, a scalable controller for L4S paths (RFC 9330). Needs QuicConfig::enable_ecn_.
+    kCustom,  //!< A controller registered with RegisterCongestionControl().
+};
+
+struct CcConfigV2 {
+    uint64_t initial_cwnd_bytes = 10 * 1460;
+    uint64_t min_cwnd_bytes = 2 * 1460;
+    uint64_t max_cwnd_bytes = 1000 * 1460;
+    uint64_t mss_bytes = 1460;
+    double beta = 0.5;        // cwnd *= beta on loss
+    bool ecn_enabled = false; // reserved
+};
+
+struct SentPacketEvent {
+    uint64_t pn = 0;
+    uint64_t bytes = 0;
+    uint64_t sent_time = 0;
+    bool is_retransmit = false;
+};
+
+struct AckEvent {
+    uint64_t pn = 0;
+    uint64_t bytes_acked = 0;
+    uint64_t ack_time = 0;
+    uint64_t ack_delay = 0;
+    bool ecn_ce = false;
+    // RFC 9002 §7.3.2: send time of the acknowledged packet (us); used by
+    // recovery-exit checks to compare against recovery_start_time_. Defaults
+    // to 0 for legacy callers (which prevents early/spurious recovery exit).
+    uint64_t acked_packet_send_time = 0;
+};
+
+struct LossEvent {
+    uint64_t pn = 0;
+    uint64_t bytes_lost = 0;
+    uint64_t lost_time = 0;
+};
+
+class ICongestionControl {
+public:
+    virtual ~ICongestionControl() = default;
+
+    virtual void Configure(const CcConfigV2& cfg) = 0;
+
+    virtual void OnPacketSent(const SentPacketEvent& ev) = 0;
+    virtual void OnPacketAcked(const AckEvent& ev) = 0;
+    virtual void OnPacketLost(const LossEvent& ev) = 0;
+    // Everything one ACK frame (or one loss-timer pass) acknowledged and
+    // declared lost, in a single call, so per-event work such as pacing-rate
+    // recomputation runs once instead of once per packet. Losses are handled
+    // before acknowledgements (RFC 9002 Appendix A.7). prior_in_flight is the
+    // controller's bytes in flight before the event; event_time is in
+    // microseconds. The default forwards packet by packet.
+    virtual void OnCongestionEvent(const std::vector<AckEvent>& acked, const std::vector<LossEvent>& lost,
+        uint64_t prior_in_flight, uint64_t event_time) {
+        for (const auto& ev : lost) {
+            OnPacketLost(ev);
+        }
+        for (const auto& ev : acked) {
+            OnPacketAcked(ev);
+        }
+    }
+    virtual void OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay = 0) = 0;
+
+    enum class SendState { kOk, kBlockedByCwnd, kBlockedByPacing };
+    virtual SendState CanSend(uint64_t now, uint64_t& can_send_bytes) const = 0;
+
+    virtual uint64_t GetCongestionWindow() const = 0;
+    virtual uint64_t GetBytesInFlight() const = 0;
+    // Pacing rate in bytes/sec (matches IPacer::OnPacingRateUpdated unit).
+    virtual uint64_t GetPacingRateBytesPerSec() const = 0;
+    // Path bandwidth the controller's model holds, in bytes/sec (BBR's max
+    // bandwidth filter). 0 if the controller keeps no bandwidth model, as
+    // the loss-based ones do.
+    virtual uint64_t GetBandwidthEstimate() const { return 0; }
+    virtual uint64_t NextSendTime(uint64_t now) const = 0;
+
+    // Observability helpers
+    virtual bool InSlowStart() const = 0;
+    virtual bool InRecovery() const = 0;
+    virtual uint64_t GetSsthresh() const = 0;
+
+    // Install a window chosen outside the controller, as Careful Resume does
+    // when it jumps to a remembered path capacity or retreats from it.
+    // ssthresh_bytes == UINT64_MAX keeps slow start going. Returns false if
+    // the controller does not support it (the default).
+    virtual bool SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) { return false; }
+
+    // Scalable (L4S, RFC 9331) controllers return true: their packets are
+    // sent ECT(1) and they expect CE marks from a shallow L4S queue at a
+    // high rate, reacting in proportion rather than halving on each one.
+    // Everyone else is sent ECT(0) when ECN is enabled.
+    virtual bool UsesL4sEcn() const { return false; }
+
+    // Qlog support. Built-in controllers emit their own events; plug-ins may
+    // ignore the trace.
+    virtual void SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) {}
+};
+
+/**
+ * @brief Creates a fresh controller for one connection.
+ */
+typedef std::function<std::unique_ptr<ICongestionControl>()> congestion_control_factory;
+
+/**
+ * @brief Register a user-supplied congestion controller.
+ *
+ * Connections select it with CongestionControlType::kCustom and the same
+ * @p name (see QuicConfig::congestion_control_name_). The factory is invoked
+ * on the worker thread that owns the connection, once per connection, and
+ * the controller then receives that connection's SentPacketEvent, AckEvent
+ * and LossEvent callbacks. Registering an existing name replaces it for
+ * connections created afterwards.
+ *
+ * @return false if @p name is empty or @p factory is null.
+ */
+bool RegisterCongestionControl(const std::string& name, congestion_control_factory factory);
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
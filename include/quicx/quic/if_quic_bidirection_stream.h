@@ -31,6 +31,8 @@ public:
     /** Send raw bytes or buffered data to the peer. */
     virtual int32_t Send(uint8_t* data, uint32_t len) = 0;
     virtual int32_t Send(std::shared_ptr<IBufferRead> buffer) = 0;
+    /** Send caller memory without copying it, see IQuicSendStream::SendZeroCopy(). */
+    virtual int32_t SendZeroCopy(const uint8_t* data, uint32_t len, std::function<void()> release) = 0;
     virtual std::shared_ptr<IBufferWrite> GetSendBuffer() = 0;
     virtual bool Flush() = 0;
 
@@ -41,6 +43,13 @@ public:
      */
     virtual void SetStreamWriteCallBack(stream_write_callback cb) = 0;
 
+    /**
+     * @brief Send buffer watermarks and the callback fired once a Send() cut
+     * short may go on, see IQuicSendStream::SetSendBufferWatermark().
+     */
+    virtual void SetSendBufferWatermark(uint32_t high, uint32_t low) = 0;
+    virtual void SetStreamWritableCallBack(stream_writable_callback cb) = 0;
+
     /**
      * @brief Provide the handler that consumes inbound data.
      *
@@ -48,6 +57,8 @@ public:
      * heavy lifting to other threads if necessary.
      */
     virtual void SetStreamReadCallBack(stream_read_callback cb) = 0;
+    /** Hand received data over without copying it, see IQuicRecvStream::SetZeroCopyRead(). */
+    virtual void SetZeroCopyRead(bool enable) = 0;
 
     /**
      * @brief Number of bytes currently buffered inside the stream awaiting
@@ -60,6 +71,19 @@ public:
      * buffer the entire payload in memory. See ReqRespBaseStream::HandleSent.
      */
     virtual uint64_t GetPendingSendBytes() = 0;
+
+    /**
+     * @brief Number of sent bytes still held for retransmission because the
+     * peer has not ACKed them yet.
+     */
+    virtual uint64_t GetRetainedSendBytes() = 0;
+
+    /**
+     * @brief Number of bytes that could be written now and go out without
+     * queueing, see IQuicSendStream::GetSendableBytes(). Event loop thread
+     * only.
+     */
+    virtual uint64_t GetSendableBytes() = 0;
 };
 
 }
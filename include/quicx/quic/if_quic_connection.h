@@ -181,12 +181,130 @@ public:
      */
     virtual bool IsMigrationInProgress() const { return false; }
 
+    // ==================== Multipath (draft-ietf-quic-multipath) ====================
+
+    /**
+     * @brief Open an additional path from a local address (client-side only).
+     *
+     * Requires QuicTransportParams::initial_max_path_id_ > 0 on both endpoints.
+     * The path carries data once the server answered its PATH_CHALLENGE; from
+     * then on packets are spread over all validated paths (see
+     * SetPathScheduler()), and a path that stops answering is left for the
+     * others. Path 0 is the path of the handshake.
+     *
+     * @param local_ip Local IP the socket of the path binds to.
+     * @param local_port Local port; if 0, the system chooses one.
+     * @return Id of the new path, or 0 if no path could be opened.
+     */
+    virtual uint32_t OpenPath(const std::string& local_ip, uint16_t local_port = 0) {
+        (void)local_ip;
+        (void)local_port;
+        return 0;
+    }
+
+    /**
+     * @brief Abandon a path (PATH_ABANDON).
+     *
+     * Data in flight on the path is sent again on the others. Path 0 stays
+     * until the connection closes.
+     *
+     * @param path_id Id returned by OpenPath(), or of a path the peer opened.
+     * @return false for path 0 and unknown paths.
+     */
+    virtual bool ClosePath(uint32_t path_id) {
+        (void)path_id;
+        return false;
+    }
+
+    /**
+     * @brief Choose how packets are spread over the validated paths.
+     *
+     * @param type Path scheduler; kMinRtt by default.
+     */
+    virtual void SetPathScheduler(PathSchedulerType type) { (void)type; }
+
     /**
      * @brief Get the qlog trace associated with this connection.
      *
      * @return Shared pointer to QlogTrace, or nullptr if qlog is not enabled.
      */
     virtual std::shared_ptr<common::QlogTrace> GetQlogTrace() const { return nullptr; }
+
+    // ==================== Unreliable Datagrams (RFC 9221) ====================
+
+    /**
+     * @brief Queue an unreliable datagram for sending.
+     *
+     * Only available once the handshake is complete and if the peer advertised
+     * max_datagram_frame_size. The data is copied; it is sent in 1-RTT packets
+     * under congestion control but is never retransmitted.
+     *
+     * @param data Datagram payload.
+     * @param len Payload length; must fit GetMaxDatagramSize().
+     * @param ttl_ms Drop the datagram if still unsent after this long (0 = no limit).
+     * @return Non-zero id reported to the status callback, or 0 if rejected.
+     *         Called off the connection's thread, the datagram is queued
+     *         asynchronously and a late refusal is reported as kDropped.
+     */
+    virtual uint64_t SendDatagram(const uint8_t* data, uint32_t len, uint32_t ttl_ms = 0) {
+        (void)data;
+        (void)len;
+        (void)ttl_ms;
+        return 0;
+    }
+
+    /**
+     * @brief Largest payload SendDatagram() currently accepts, 0 if datagrams
+     *        are unavailable on this connection.
+     */
+    virtual uint32_t GetMaxDatagramSize() { return 0; }
+
+    /**
+     * @brief Set callback for received datagrams.
+     *
+     * Receiving requires QuicTransportParams::max_datagram_frame_size_ > 0.
+     */
+    virtual void SetDatagramRecvCallBack(datagram_recv_callback cb) { (void)cb; }
+
+    /**
+     * @brief Set callback reporting the fate of each sent datagram.
+     */
+    virtual void SetDatagramStatusCallBack(datagram_status_callback cb) { (void)cb; }
+
+    // ==================== Statistics ====================
+
+    /**
+     * @brief Read the connection's transport statistics.
+     *
+     * Returns the snapshot the connection's thread published last, after its
+     * latest batch of received packets or send round. Lock-free and safe to
+     * call from any thread, e.g. a monitoring timer.
+     *
+     * @param stats Filled with the snapshot.
+     * @return false if no snapshot is available yet.
+     */
+    virtual bool GetStats(QuicConnectionStats& stats) {
+        (void)stats;
+        return false;
+    }
+
+    /**
+     * @brief Follow the congestion controller's view of the path.
+     *
+     * Opt-in feedback for rate-adaptive applications, e.g. picking a video
+     * bitrate. The callback fires on the connection's thread when the
+     * bandwidth estimate or the delivery rate moved by more than
+     * @p min_change (a fraction of the last reported value), and whenever
+     * the sender enters or leaves an application-limited period. Pass a
+     * null callback to stop.
+     *
+     * @param cb Callback receiving the new estimate.
+     * @param min_change Relative change that triggers a report, e.g. 0.1 for 10%.
+     */
+    virtual void SetBandwidthCallBack(bandwidth_callback cb, double min_change = 0.1) {
+        (void)cb;
+        (void)min_change;
+    }
 };
 
 }  // namespace quicx
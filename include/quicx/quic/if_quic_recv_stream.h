@@ -35,6 +35,20 @@ public:
      * lightweight to avoid blocking packet processing.
      */
     virtual void SetStreamReadCallBack(stream_read_callback cb) = 0;
+
+    /**
+     * @brief Hand received data over without copying it.
+     *
+     * Each read callback then gets a buffer of its own holding only the new
+     * bytes; in-order data still points into the decrypted packet. The
+     * application may keep the buffer as long as it likes, on any thread,
+     * but the stream's receive window only reopens once it is dropped, so
+     * the peer can never have more than a window's worth outstanding.
+     *
+     * Set it before data arrives; bytes already buffered go out with the
+     * next callback.
+     */
+    virtual void SetZeroCopyRead(bool enable) = 0;
 };
 
 }
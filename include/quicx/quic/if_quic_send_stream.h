@@ -35,10 +35,33 @@ public:
     /**
      * @brief Write a memory buffer into the stream.
      *
-     * @return Number of bytes accepted into the send pipeline.
+     * With a send buffer high watermark set, only the room below it is taken
+     * and the rest is left to the caller; see SetStreamWritableCallBack().
+     * Send(IBufferRead) takes the leading bytes and does not move the
+     * buffer's read position.
+     *
+     * @return Number of bytes accepted into the send pipeline, 0 if the send
+     * buffer is full, -1 if the stream can no longer send.
      */
     virtual int32_t Send(uint8_t* data, uint32_t len) = 0;
     virtual int32_t Send(std::shared_ptr<IBufferRead> buffer) = 0;
+    /**
+     * @brief Hand caller memory to the stream without copying it.
+     *
+     * The bytes are chained into the send buffer as they are and must stay
+     * unchanged until `release` runs, once the peer acknowledged all of them
+     * or the stream dropped them. It may run on the connection's thread.
+     * Small payloads may be copied and released right away. To hand over a
+     * shared_ptr, capture it in `release`.
+     *
+     * The data is taken whole as long as the send buffer is below its high
+     * watermark.
+     *
+     * @return len once taken, then `release` is guaranteed to run; 0 if the
+     * send buffer is full and -1 if the stream can no longer send. With those
+     * the caller keeps the memory and `release` is never called.
+     */
+    virtual int32_t SendZeroCopy(const uint8_t* data, uint32_t len, std::function<void()> release) = 0;
     /**
      * @brief Get the buffer to write data to the stream.
      * 
@@ -59,6 +82,25 @@ public:
      */
     virtual void SetStreamWriteCallBack(stream_write_callback cb) = 0;
 
+    /**
+     * @brief Bound what Send() buffers on this stream.
+     *
+     * Overrides QuicConfig::stream_send_buffer_high_/low_. The connection's
+     * own marks still apply. A high mark of 0 removes the stream's limit.
+     * Data written through GetSendBuffer() counts against the marks but is
+     * never refused.
+     */
+    virtual void SetSendBufferWatermark(uint32_t high, uint32_t low) = 0;
+
+    /**
+     * @brief Install a callback that fires after Send() was cut short, once
+     * the stream's and the connection's send buffers drained to their low
+     * watermarks.
+     *
+     * Runs on the connection's thread, once per blocked period.
+     */
+    virtual void SetStreamWritableCallBack(stream_writable_callback cb) = 0;
+
     /**
      * @brief Number of bytes currently buffered inside the stream awaiting
      * transmission to the wire (i.e. queued in the send buffer but not yet
@@ -73,6 +115,30 @@ public:
      * state).
      */
     virtual uint64_t GetPendingSendBytes() = 0;
+
+    /**
+     * @brief Number of bytes already sent on the stream that are still held
+     * for retransmission because the peer has not ACKed them yet.
+     *
+     * Data ACKed behind a lost packet is released right away, so this only
+     * counts bytes that may still have to be resent.
+     */
+    virtual uint64_t GetRetainedSendBytes() = 0;
+
+    /**
+     * @brief Number of bytes that could be written now and go out without
+     * queueing: the smaller of the stream's and the connection's flow-control
+     * credit and the congestion window's free room, minus what is already
+     * buffered on this stream.
+     *
+     * Rate-adaptive producers (e.g. a video encoder) can size their next
+     * chunk by it instead of over-committing data into the send buffer.
+     * The connection-level part is shared by every stream of the connection.
+     *
+     * Call it on the connection's event loop thread only (e.g. from the
+     * writable callback); other threads abort.
+     */
+    virtual uint64_t GetSendableBytes() = 0;
 };
 
 }
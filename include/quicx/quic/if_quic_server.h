@@ -44,6 +44,21 @@ struct SelectiveRetryConfig {
     uint32_t ip_window_seconds_ = 60;
 };
 
+/**
+ * @brief Per-connection congestion control hook.
+ *
+ * Invoked on the worker thread when a new connection is accepted, before it
+ * sends anything. @p type and @p custom_name arrive set from
+ * QuicConfig::congestion_control_ / congestion_control_name_ and may be
+ * changed to pick a different controller for this peer.
+ *
+ * @param peer_ip Client address.
+ * @param peer_port Client UDP port.
+ */
+typedef std::function<void(const std::string& peer_ip, uint16_t peer_port, quic::CongestionControlType& type,
+    std::string& custom_name)>
+    congestion_control_selector;
+
 /**
  * @brief Server-side configuration bundle.
  *
@@ -81,6 +96,20 @@ struct QuicServerConfig {
 
     /** Transport/runtime knobs (threading, logging, congestion control, etc.). */
     QuicConfig config_;
+
+    /** Optional connection-accept hook overriding config_'s congestion control per peer. */
+    congestion_control_selector congestion_control_selector_;
+
+    /**
+     * @brief Give each worker thread its own UDP socket and advertise it to
+     * new connections as preferred_address (RFC 9000 §9.6).
+     *
+     * Clients that migrate there after the handshake reach the connection's
+     * worker directly, skipping the listener thread and its dispatch queue.
+     * Only used in multi-thread mode, and only for listeners bound to a
+     * concrete IP: a wildcard address cannot be advertised.
+     */
+    bool worker_preferred_address_ = false;
 };
 
 /**
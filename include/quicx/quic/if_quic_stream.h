@@ -26,6 +26,17 @@ public:
     virtual StreamDirection GetDirection() = 0;
     /** Stream ID unique within the owning connection. */
     virtual uint64_t GetStreamID() = 0;
+
+    /**
+     * @brief Set the send priority of the stream (RFC 9218).
+     *
+     * How the priority is applied depends on QuicConfig::stream_scheduler_.
+     *
+     * @param urgency 0 (most urgent) to kStreamUrgencyMax; defaults to kStreamUrgencyDefault.
+     * @param incremental Whether the stream may share bandwidth with other
+     *        streams of the same urgency instead of being sent in one go.
+     */
+    virtual void SetPriority(uint8_t urgency, bool incremental) = 0;
 };
 
 }  // namespace quicx
@@ -8,6 +8,7 @@
 
 #include <quicx/common/if_buffer_read.h>
 #include <quicx/common/type.h>
+#include <quicx/quic/if_congestion_control.h>
 
 namespace quicx {
 
@@ -30,6 +31,38 @@ enum class StreamDirection : uint8_t {
     kBidi = 0x03,  //!< Bidirectional stream supporting send + receive.
 };
 
+/**
+ * @brief RFC 9218 stream urgency: 0 is the most urgent, 7 the least.
+ */
+static constexpr uint8_t kStreamUrgencyMax = 7;
+static constexpr uint8_t kStreamUrgencyDefault = 3;
+
+/**
+ * @brief How a connection shares its send capacity among streams with data ready.
+ */
+enum class StreamSchedulerType : uint8_t {
+    //! RFC 9218: lowest urgency first; within an urgency, non-incremental
+    //! streams are sent one at a time in stream ID order, then incremental
+    //! streams take turns packet by packet.
+    kUrgencyIncremental = 0x00,
+    //! Lowest urgency first; streams of the same urgency take turns.
+    kStrictPriority = 0x01,
+    //! Every ready stream takes turns, getting (8 - urgency) packets per turn,
+    //! so low-urgency streams slow down but never stall.
+    kWeightedRoundRobin = 0x02,
+};
+
+/**
+ * @brief How a multipath connection picks the path of each packet.
+ */
+enum class PathSchedulerType : uint8_t {
+    //! Fill the path with the lowest smoothed RTT first; a slower path only
+    //! carries what does not fit in the faster one's congestion window.
+    kMinRtt = 0x00,
+    //! Paths with room in their congestion window take turns packet by packet.
+    kRoundRobin = 0x01,
+};
+
 /**
  * @brief Controls how the library orchestrates master/worker loops.
  */
@@ -50,6 +83,9 @@ struct QuicConfig {
     bool enable_ecn_ = false;         //!< Toggle ECN handling.
     bool enable_0rtt_ = false;        //!< Allow 0-RTT data when tickets are available.
     bool enable_key_update_ = false;  //!< Enable automatic Key Update during connection.
+    //! Careful Resume: start new connections from the cwnd/RTT/bandwidth an earlier
+    //! connection to the same server (client) or client subnet (server) observed.
+    bool enable_careful_resume_ = false;
     std::string cipher_suites_ = "";  //!< Cipher suites (e.g. TLS_AES_128_GCM_SHA256).
 
     //! QUIC version to use (RFC 9000 v1 or RFC 9369 v2).
@@ -59,6 +95,26 @@ struct QuicConfig {
     QlogConfig qlog_config_;  //!< QLog configuration.
 
     std::string keylog_file_;  //!< Path to SSLKEYLOGFILE for TLS key logging (Wireshark debugging).
+
+    //! Congestion controller for every connection created with this config.
+    quic::CongestionControlType congestion_control_ = quic::CongestionControlType::kCubic;
+    //! Name passed to quic::RegisterCongestionControl(); used when congestion_control_ is kCustom.
+    std::string congestion_control_name_ = "";
+
+    //! How each connection orders its streams when they compete for packets.
+    //! Streams are prioritized with IQuicStream::SetPriority(). The default
+    //! rotates streams of equal urgency, so a bulk transfer never holds back
+    //! a stream opened after it.
+    StreamSchedulerType stream_scheduler_ = StreamSchedulerType::kStrictPriority;
+
+    //! Send buffer watermarks applied by IQuicSendStream::Send(), per stream and
+    //! summed over every stream of a connection. Above the high mark Send()
+    //! takes part of the data or none; the writable callback fires once the
+    //! buffer drained to the low mark. A high mark of 0 means no limit.
+    uint32_t stream_send_buffer_high_ = 0;
+    uint32_t stream_send_buffer_low_ = 0;
+    uint32_t connection_send_buffer_high_ = 0;
+    uint32_t connection_send_buffer_low_ = 0;
 };
 
 /**
@@ -71,16 +127,18 @@ struct QuicTransportParams {
     std::string original_destination_connection_id_ = "";
     uint32_t max_idle_timeout_ms_ = 120000;  // 2 minutes
     std::string stateless_reset_token_ = "";
-    uint32_t max_udp_payload_size_ = 1472;  // 1500 - 28
+    // 1500 - 28. Up to 9000 for jumbo-frame links: receive buffers are sized
+    // from it and the peer's path MTU search stops there.
+    uint32_t max_udp_payload_size_ = 1472;
 
     // RFC 9000 Section 4.1: Flow control limits
-    // Large initial windows for high-throughput scenarios (file transfer, streaming)
-    // These values allow congestion control to operate effectively without being
-    // artificially limited by flow control
-    uint32_t initial_max_data_ = 64 * 1024 * 1024;                     // 64MB connection-level
-    uint32_t initial_max_stream_data_bidi_local_ = 16 * 1024 * 1024;   // 16MB per stream (local->remote)
-    uint32_t initial_max_stream_data_bidi_remote_ = 16 * 1024 * 1024;  // 16MB per stream (remote->local)
-    uint32_t initial_max_stream_data_uni_ = 16 * 1024 * 1024;          // 16MB for unidirectional streams
+    // Initial receive windows only. They double while the application keeps
+    // draining them (up to 24MB per connection and 16MB per stream), so small
+    // connections stay cheap and bulk transfers still reach the path's BDP
+    uint32_t initial_max_data_ = 2 * 1024 * 1024;                     // 2MB connection-level
+    uint32_t initial_max_stream_data_bidi_local_ = 1 * 1024 * 1024;   // 1MB per stream (local->remote)
+    uint32_t initial_max_stream_data_bidi_remote_ = 1 * 1024 * 1024;  // 1MB per stream (remote->local)
+    uint32_t initial_max_stream_data_uni_ = 1 * 1024 * 1024;          // 1MB for unidirectional streams
 
     uint32_t initial_max_streams_bidi_ = 200;  // default value
     uint32_t initial_max_streams_uni_ = 200;   // default value
@@ -89,6 +147,16 @@ struct QuicTransportParams {
     bool disable_active_migration_ = false;
     std::string preferred_address_ = "";
     uint32_t active_connection_id_limit_ = 3;
+    // draft-ietf-quic-ack-frequency: advertise support for ACK_FREQUENCY with
+    // the smallest ACK delay (in microseconds) we can honor. 0 disables.
+    uint32_t min_ack_delay_us_ = 1000;
+    // RFC 9221: largest DATAGRAM frame (type, length and payload) we accept.
+    // 0 disables unreliable datagrams in both directions for this endpoint.
+    uint32_t max_datagram_frame_size_ = 0;
+    // draft-ietf-quic-multipath: the largest path ID the peer may open. Paths
+    // other than the handshake path are usable only if both endpoints set it.
+    // 0 disables multipath for this endpoint.
+    uint32_t initial_max_path_id_ = 0;
     std::string initial_source_connection_id_ = "";
     std::string retry_source_connection_id_ = "";
 };
@@ -143,6 +211,14 @@ typedef std::function<void(std::shared_ptr<IBufferRead> data, bool is_last, uint
  */
 typedef std::function<void(uint32_t length, uint32_t error)> stream_write_callback;
 
+/**
+ * @brief Invoked once a send buffer cut short by its high watermark drained
+ * to the low watermark.
+ *
+ * @param writable_bytes How much the next Send() will accept.
+ */
+typedef std::function<void(uint64_t writable_bytes)> stream_writable_callback;
+
 /** @brief Generic timer callback used by IQuicClient/IQuicServer. */
 typedef std::function<void()> timer_callback;
 
@@ -153,6 +229,99 @@ typedef std::function<void()> timer_callback;
  */
 typedef std::function<void(std::shared_ptr<IQuicStream>)> stream_creation_callback;
 
+// ==================== Unreliable Datagrams (RFC 9221) ====================
+
+/**
+ * @brief Final state of a datagram handed to IQuicConnection::SendDatagram().
+ *
+ * Datagrams are never retransmitted: each one is reported exactly once.
+ */
+enum class DatagramStatus : uint8_t {
+    kAcked = 0x00,    //!< The packet carrying it was acknowledged
+    kLost = 0x01,     //!< The packet carrying it was declared lost
+    kExpired = 0x02,  //!< Its TTL passed before it could be sent
+    kDropped = 0x03,  //!< Discarded unsent (too large for the path, or connection closed)
+};
+
+/**
+ * @brief Callback invoked for every DATAGRAM frame received.
+ *
+ * @param data Buffer referencing the datagram payload.
+ */
+typedef std::function<void(std::shared_ptr<IBufferRead> data)> datagram_recv_callback;
+
+/**
+ * @brief Callback reporting the fate of a sent datagram.
+ *
+ * @param datagram_id Id returned by SendDatagram().
+ * @param status What became of it.
+ */
+typedef std::function<void(uint64_t datagram_id, DatagramStatus status)> datagram_status_callback;
+
+// ==================== Connection Statistics ====================
+
+/**
+ * @brief Transport statistics of one connection, see IQuicConnection::GetStats().
+ *
+ * A consistent snapshot taken by the connection's thread after each batch of
+ * received packets and each send round. Counters are totals since the
+ * connection was created. Every field is a uint64_t.
+ */
+struct QuicConnectionStats {
+    uint64_t snapshot_time_ms_ = 0;             //!< When the snapshot was taken (UTC ms)
+
+    uint64_t smoothed_rtt_ms_ = 0;              //!< RFC 9002 smoothed_rtt
+    uint64_t min_rtt_ms_ = 0;                   //!< RFC 9002 min_rtt
+    uint64_t latest_rtt_ms_ = 0;                //!< Most recent RTT sample
+    uint64_t rtt_var_ms_ = 0;                   //!< RFC 9002 rttvar
+
+    uint64_t cwnd_bytes_ = 0;                   //!< Congestion window
+    uint64_t bytes_in_flight_ = 0;              //!< Sent, not yet acked or lost
+    uint64_t pacing_rate_bytes_per_sec_ = 0;    //!< 0 if the controller does not pace
+    uint64_t delivery_rate_bytes_per_sec_ = 0;  //!< Acked bytes/s over the last RTT
+    uint64_t bandwidth_estimate_bytes_per_sec_ = 0;  //!< Controller's path model, cwnd/srtt if it has none
+    uint64_t app_limited_ = 0;                  //!< 1 while the sender runs out of data before cwnd
+
+    uint64_t packets_sent_ = 0;
+    uint64_t bytes_sent_ = 0;
+    uint64_t packets_received_ = 0;
+    uint64_t bytes_received_ = 0;
+    uint64_t packets_lost_ = 0;
+    uint64_t bytes_lost_ = 0;
+    uint64_t packets_retransmitted_ = 0;        //!< Lost packets whose content was queued again
+    uint64_t pto_count_ = 0;                    //!< Probe timeouts fired
+
+    uint64_t mtu_ = 0;                          //!< Current maximum UDP payload size
+
+    uint64_t streams_active_ = 0;               //!< Streams currently open
+    uint64_t streams_opened_ = 0;               //!< Streams opened by either side
+    uint64_t flow_control_blocked_ms_ = 0;      //!< Time sending waited on the peer's MAX_DATA
+};
+
+/**
+ * @brief The congestion controller's view of the path, reported to
+ *        bandwidth_callback.
+ */
+struct BandwidthInfo {
+    uint64_t bandwidth_estimate_bytes_per_sec_ = 0;  //!< Controller's path model, cwnd/srtt if it has none
+    uint64_t delivery_rate_bytes_per_sec_ = 0;       //!< Acked bytes/s over the last RTT
+    uint64_t pacing_rate_bytes_per_sec_ = 0;
+    uint64_t cwnd_bytes_ = 0;
+    uint64_t smoothed_rtt_ms_ = 0;
+    //! The sender ran out of data with room left in the congestion window,
+    //! so the rates above may understate what the path could carry.
+    bool app_limited_ = false;
+};
+
+/**
+ * @brief Callback invoked when the bandwidth estimate or the delivery rate
+ *        moves by more than the configured fraction, or the sender enters or
+ *        leaves an application-limited period.
+ *
+ * Runs on the connection's thread; keep it short.
+ */
+typedef std::function<void(const BandwidthInfo& info)> bandwidth_callback;
+
 // ==================== Connection Migration Types (RFC 9000 Section 9) ====================
 
 /**
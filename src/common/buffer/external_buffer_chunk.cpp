@@ -0,0 +1,18 @@
+#include "common/buffer/external_buffer_chunk.h"
+
+namespace quicx {
+namespace common {
+
+ExternalBufferChunk::ExternalBufferChunk(const uint8_t* data, uint32_t length, std::function<void()> release):
+    data_(data),
+    length_(data ? length : 0),
+    release_(std::move(release)) {}
+
+ExternalBufferChunk::~ExternalBufferChunk() {
+    if (release_) {
+        release_();
+    }
+}
+
+}  // namespace common
+}  // namespace quicx
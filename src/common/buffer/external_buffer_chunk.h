@@ -0,0 +1,49 @@
+#ifndef COMMON_BUFFER_EXTERNAL_BUFFER_CHUNK
+#define COMMON_BUFFER_EXTERNAL_BUFFER_CHUNK
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "common/buffer/if_buffer_chunk.h"
+
+namespace quicx {
+namespace common {
+
+/**
+ * @brief A read-only buffer chunk over memory owned by the caller
+ *
+ * Lets immutable payloads (cached objects, mmap'd files) join a buffer
+ * without being copied into pool blocks. The release callback runs when the
+ * chunk is destroyed, i.e. once the last SharedBufferSpan over it is gone.
+ *
+ * The whole chunk counts as frozen: its write floor is its end, and its
+ * length is exactly the data's, so a MultiBlockBuffer holding it never finds
+ * room to write into it.
+ */
+class ExternalBufferChunk: public IBufferChunk {
+public:
+    ExternalBufferChunk(const uint8_t* data, uint32_t length, std::function<void()> release);
+    ~ExternalBufferChunk();
+
+    ExternalBufferChunk(const ExternalBufferChunk&) = delete;
+    ExternalBufferChunk& operator=(const ExternalBufferChunk&) = delete;
+
+    bool Valid() const override { return data_ != nullptr && length_ > 0; }
+    // Writable only in the type system; nothing may write through it.
+    uint8_t* GetData() const override { return const_cast<uint8_t*>(data_); }
+    uint32_t GetLength() const override { return length_; }
+    std::shared_ptr<BlockMemoryPool> GetPool() const override { return nullptr; }
+
+    uint8_t* GetWriteFloor() const override { return GetData() + length_; }
+
+private:
+    const uint8_t* data_;
+    uint32_t length_;
+    std::function<void()> release_;
+};
+
+}  // namespace common
+}  // namespace quicx
+
+#endif
@@ -513,9 +513,17 @@ uint32_t MultiBlockBuffer::Write(const SharedBufferSpan& span, uint32_t data_len
     // tiny ChunkStates by itself. The histogram disambiguates.
     Metrics::HistogramObserve(MetricsStd::DiagSpanWriteHist, data_len);
 
-    // if the last chunk has enough writable space, write to it
     if (!chunks_.empty()) {
         auto& back = chunks_.back();
+        // the span continues the last chunk's readable bytes in place (a
+        // reassembly ring handing out a block piece by piece): just extend it
+        if (back.chunk_ == chunk_ && back.write_pos_ == span.GetStart()) {
+            back.write_pos_ += data_len;
+            total_data_length_ += data_len;
+            return data_len;
+        }
+
+        // if the last chunk has enough writable space, write to it
         uint32_t capacity = back.Writable();
         if (capacity >= data_len) {
             return Write(span.GetStart(), data_len);
@@ -30,6 +30,8 @@ MetricID MetricsStd::QuicStreamsCreated = kInvalidMetricID;
 MetricID MetricsStd::QuicStreamsClosed = kInvalidMetricID;
 MetricID MetricsStd::QuicStreamsBytesRx = kInvalidMetricID;
 MetricID MetricsStd::QuicStreamsBytesTx = kInvalidMetricID;
+MetricID MetricsStd::QuicStreamsBytesRetransmit = kInvalidMetricID;
+MetricID MetricsStd::QuicStreamsSendRetainedBytes = kInvalidMetricID;
 MetricID MetricsStd::QuicStreamsResetRx = kInvalidMetricID;
 MetricID MetricsStd::QuicStreamsResetTx = kInvalidMetricID;
 
@@ -49,6 +51,8 @@ MetricID MetricsStd::CongestionWindowBytes = kInvalidMetricID;
 MetricID MetricsStd::CongestionEventsTotal = kInvalidMetricID;
 MetricID MetricsStd::SlowStartExits = kInvalidMetricID;
 MetricID MetricsStd::BytesInFlight = kInvalidMetricID;
+MetricID MetricsStd::CarefulResumeJumps = kInvalidMetricID;
+MetricID MetricsStd::CarefulResumeRetreats = kInvalidMetricID;
 
 MetricID MetricsStd::RttSmoothedUs = kInvalidMetricID;
 MetricID MetricsStd::RttVarianceUs = kInvalidMetricID;
@@ -192,6 +196,10 @@ void InitializeStandardMetrics() {
         Metrics::RegisterCounter("quic_streams_bytes_rx", "Total bytes received on streams");
     MetricsStd::QuicStreamsBytesTx =
         Metrics::RegisterCounter("quic_streams_bytes_tx", "Total bytes transmitted on streams");
+    MetricsStd::QuicStreamsBytesRetransmit =
+        Metrics::RegisterCounter("quic_streams_bytes_retransmit", "Stream bytes resent after loss");
+    MetricsStd::QuicStreamsSendRetainedBytes =
+        Metrics::RegisterGauge("quic_streams_send_retained_bytes", "Sent stream bytes held until ACKed");
     MetricsStd::QuicStreamsResetRx =
         Metrics::RegisterCounter("quic_streams_reset_rx", "Total received RESET_STREAM frames");
     MetricsStd::QuicStreamsResetTx =
@@ -223,6 +231,10 @@ void InitializeStandardMetrics() {
     MetricsStd::CongestionEventsTotal = Metrics::RegisterCounter("congestion_events_total", "Total congestion events");
     MetricsStd::SlowStartExits = Metrics::RegisterCounter("slow_start_exits", "Times exited slow start");
     MetricsStd::BytesInFlight = Metrics::RegisterGauge("bytes_in_flight", "Current bytes in flight");
+    MetricsStd::CarefulResumeJumps =
+        Metrics::RegisterCounter("careful_resume_jumps", "Connections that jumped to a saved cwnd");
+    MetricsStd::CarefulResumeRetreats =
+        Metrics::RegisterCounter("careful_resume_retreats", "Careful Resume jumps undone by loss");
 
     // Performance / Latency
     MetricsStd::RttSmoothedUs = Metrics::RegisterGauge("rtt_smoothed_us", "Smoothed RTT in microseconds");
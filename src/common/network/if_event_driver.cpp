@@ -1,3 +1,5 @@
+#include <mutex>
+
 #include "common/network/if_event_driver.h"
 
 #ifdef _WIN32
@@ -11,7 +13,16 @@
 namespace quicx {
 namespace common {
 
+static std::mutex factory_mutex_;
+static std::function<std::unique_ptr<IEventDriver>()> factory_;
+
 std::unique_ptr<IEventDriver> IEventDriver::Create() {
+    {
+        std::lock_guard<std::mutex> lock(factory_mutex_);
+        if (factory_) {
+            return factory_();
+        }
+    }
 #ifdef _WIN32
     return std::unique_ptr<IEventDriver>(new SelectEventDriver());
 #elif defined(__APPLE__)
@@ -21,6 +32,11 @@ std::unique_ptr<IEventDriver> IEventDriver::Create() {
 #endif
 }
 
+void IEventDriver::SetFactoryForTest(std::function<std::unique_ptr<IEventDriver>()> factory) {
+    std::lock_guard<std::mutex> lock(factory_mutex_);
+    factory_ = std::move(factory);
+}
+
 }
 }
 
@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <cstdint>
+#include <functional>
 
 namespace quicx {
 namespace common {
@@ -52,6 +53,10 @@ public:
 
     // Create platform-specific event driver
     static std::unique_ptr<IEventDriver> Create();
+
+    // Make Create() return drivers from `factory` instead (e.g. a simulated
+    // driver on a virtual clock). An empty function restores the platform driver.
+    static void SetFactoryForTest(std::function<std::unique_ptr<IEventDriver>()> factory);
 };
 
 } // namespace common
@@ -167,6 +167,11 @@ SysCallInt32Result RecvFromWithEcn(int32_t sockfd, char *buf, uint32_t len, uint
 // ecn_codepoint: 0x00 Not-ECT, 0x01 ECT(1), 0x02 ECT(0), 0x03 CE (not recommended)
 SysCallInt32Result EnableUdpEcnMarking(int32_t sockfd, uint8_t ecn_codepoint);
 
+// Set the Don't Fragment bit on outgoing UDP datagrams, so that packets larger
+// than the path MTU are dropped instead of fragmented (RFC 9000 §14). Needed
+// for PMTU probes to mean anything; the kernel's own PMTU cache is bypassed.
+SysCallInt32Result EnableUdpDontFragment(int32_t sockfd);
+
 // Per-datagram entry passed to RecvFromBatch.
 //   buf_ / buf_len_ : in.  caller-owned receive buffer (one per datagram).
 //   bytes_          : out. number of bytes actually received into buf_.
@@ -643,6 +643,25 @@ SysCallInt32Result EnableUdpEcnMarking(int32_t sockfd, uint8_t ecn_codepoint) {
     return {0, 0};
 }
 
+SysCallInt32Result EnableUdpDontFragment(int32_t sockfd) {
+    // PMTUDISC_PROBE sets DF but ignores the kernel's PMTU estimate, so probes
+    // larger than it still go out. Try both, one may fail on a dual-stack socket.
+    int val = IP_PMTUDISC_PROBE;
+    int rc = setsockopt(sockfd, IPPROTO_IP, IP_MTU_DISCOVER, &val, sizeof(val));
+#ifdef IPV6_MTU_DISCOVER
+    int val6 = IPV6_PMTUDISC_PROBE;
+    int rc6 = setsockopt(sockfd, IPPROTO_IPV6, IPV6_MTU_DISCOVER, &val6, sizeof(val6));
+    if (rc == -1 && rc6 == -1) {
+        return {-1, errno};
+    }
+#else
+    if (rc == -1) {
+        return {-1, errno};
+    }
+#endif
+    return {0, 0};
+}
+
 }
 }
 
@@ -611,6 +611,21 @@ SysCallInt32Result EnableUdpEcnMarking(int32_t sockfd, uint8_t ecn_codepoint) {
     return {ok, ok != -1 ? 0 : errno};
 }
 
+SysCallInt32Result EnableUdpDontFragment(int32_t sockfd) {
+    int on = 1;
+    int rc1 = -1;
+#ifdef IP_DONTFRAG
+    rc1 = setsockopt(sockfd, IPPROTO_IP, IP_DONTFRAG, &on, sizeof(on));
+#endif
+    int rc2 = -1;
+#ifdef IPV6_DONTFRAG
+    rc2 = setsockopt(sockfd, IPPROTO_IPV6, IPV6_DONTFRAG, &on, sizeof(on));
+#endif
+    // one of them fails on a single-stack socket
+    int ok = (rc1 == -1 && rc2 == -1) ? -1 : 0;
+    return {ok, ok != -1 ? 0 : errno};
+}
+
 }
 }
 
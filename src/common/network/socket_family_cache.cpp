@@ -1,4 +1,5 @@
 #include "common/network/socket_family_cache.h"
+#include "common/network/io_handle.h"
 
 #include <mutex>
 #include <unordered_map>
@@ -13,14 +14,21 @@ namespace {
 // (typically: one per worker + one per in-flight migration). The map is
 // only touched from Bind(), SendTo() and the create/close pair, never per
 // packet on the steady-state datapath because SendTo() short-circuits via
-// the connected-socket family that's been written here once.
+// the connected-socket family that's been written here once. The ECN
+// codepoint is looked up once per send: one uncontended lock next to a
+// sendto().
+struct SocketEntry {
+    int32_t family = 0;
+    uint8_t ecn = 0;
+};
+
 std::mutex& Mutex() {
     static std::mutex m;
     return m;
 }
 
-std::unordered_map<int32_t, int32_t>& Map() {
-    static std::unordered_map<int32_t, int32_t> m;
+std::unordered_map<int32_t, SocketEntry>& Map() {
+    static std::unordered_map<int32_t, SocketEntry> m;
     return m;
 }
 
@@ -29,7 +37,7 @@ std::unordered_map<int32_t, int32_t>& Map() {
 void RememberSocketFamily(int32_t fd, int32_t family) {
     if (fd < 0) return;
     std::lock_guard<std::mutex> lk(Mutex());
-    Map()[fd] = family;
+    Map()[fd].family = family;
 }
 
 void ForgetSocketFamily(int32_t fd) {
@@ -43,7 +51,24 @@ int32_t GetSocketFamily(int32_t fd) {
     std::lock_guard<std::mutex> lk(Mutex());
     auto it = Map().find(fd);
     if (it == Map().end()) return 0;
-    return it->second;
+    return it->second.family;
+}
+
+void ApplySocketEcnCodepoint(int32_t fd, uint8_t ecn_codepoint) {
+    if (fd < 0) return;
+    std::lock_guard<std::mutex> lk(Mutex());
+    SocketEntry& entry = Map()[fd];
+    if (entry.ecn == ecn_codepoint) return;
+    EnableUdpEcnMarking(fd, ecn_codepoint);
+    entry.ecn = ecn_codepoint;
+}
+
+uint8_t GetSocketEcnCodepoint(int32_t fd) {
+    if (fd < 0) return 0;
+    std::lock_guard<std::mutex> lk(Mutex());
+    auto it = Map().find(fd);
+    if (it == Map().end()) return 0;
+    return it->second.ecn;
 }
 
 }  // namespace common
@@ -35,6 +35,18 @@ void RememberSocketFamily(int32_t fd, int32_t family);
 void ForgetSocketFamily(int32_t fd);
 int32_t GetSocketFamily(int32_t fd);  // returns 0 if unknown
 
+// Outgoing ECN codepoint of a UDP socket (IP_TOS / IPV6_TCLASS).
+//
+// The codepoint is a socket option rather than a per-send argument, so the
+// one last set on each fd is kept in the same per-socket entry as its family
+// and EnableUdpEcnMarking() only runs when a packet asks for something else.
+// A new fd starts out as Not-ECT, like the kernel's default, and Close()
+// drops the entry along with the family, so a reused fd is set again. Both
+// the compare and the setsockopt happen under the lock, which keeps the send
+// thread and the fault-injection delay thread consistent on a shared fd.
+void ApplySocketEcnCodepoint(int32_t fd, uint8_t ecn_codepoint);
+uint8_t GetSocketEcnCodepoint(int32_t fd);  // returns 0 (Not-ECT) if unknown
+
 }  // namespace common
 }  // namespace quicx
 
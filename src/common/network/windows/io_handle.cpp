@@ -460,6 +460,15 @@ SysCallInt32Result EnableUdpEcnMarking(int32_t sockfd, uint8_t ecn_codepoint) {
     return {0, 0};
 }
 
+SysCallInt32Result EnableUdpDontFragment(int32_t sockfd) {
+    DWORD on = 1;
+    int rc = setsockopt(sockfd, IPPROTO_IP, IP_DONTFRAGMENT, reinterpret_cast<const char*>(&on), sizeof(on));
+    if (rc == SOCKET_ERROR) {
+        return {-1, WSAGetLastError()};
+    }
+    return {0, 0};
+}
+
 }  // namespace common
 }  // namespace quicx
 
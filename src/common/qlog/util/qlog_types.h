@@ -86,6 +86,22 @@ inline const char* FrameTypeToQlogString(quic::FrameType type) {
             return "connection_close_app";
         case quic::FrameType::kHandshakeDone:
             return "handshake_done";
+        case quic::FrameType::kPathAck:
+            return "path_ack";
+        case quic::FrameType::kPathAckEcn:
+            return "path_ack_ecn";
+        case quic::FrameType::kPathAbandon:
+            return "path_abandon";
+        case quic::FrameType::kPathStatusBackup:
+            return "path_status_backup";
+        case quic::FrameType::kPathStatusAvailable:
+            return "path_status_available";
+        case quic::FrameType::kPathNewConnectionId:
+            return "path_new_connection_id";
+        case quic::FrameType::kPathRetireConnectionId:
+            return "path_retire_connection_id";
+        case quic::FrameType::kMaxPathId:
+            return "max_path_id";
         default:
             // Handle STREAM frame range (0x08-0x0f)
             if (type >= quic::FrameType::kStream && type <= 0x0f) {
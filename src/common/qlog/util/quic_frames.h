@@ -18,11 +18,17 @@
 #include "quic/frame/if_frame.h"
 #include "quic/frame/max_data_frame.h"
 #include "quic/frame/max_stream_data_frame.h"
+#include "quic/frame/max_path_id_frame.h"
 #include "quic/frame/max_streams_frame.h"
 #include "quic/frame/new_connection_id_frame.h"
 #include "quic/frame/new_token_frame.h"
+#include "quic/frame/path_abandon_frame.h"
+#include "quic/frame/path_ack_frame.h"
 #include "quic/frame/path_challenge_frame.h"
+#include "quic/frame/path_new_connection_id_frame.h"
 #include "quic/frame/path_response_frame.h"
+#include "quic/frame/path_retire_connection_id_frame.h"
+#include "quic/frame/path_status_frame.h"
 #include "quic/frame/reset_stream_frame.h"
 #include "quic/frame/retire_connection_id_frame.h"
 #include "quic/frame/stop_sending_frame.h"
@@ -135,6 +141,59 @@ inline std::string FrameToJson(quic::IFrame* frame) {
             }
             break;
         }
+        case quic::FrameType::kPathAck:
+        case quic::FrameType::kPathAckEcn: {
+            if (auto* pf = dynamic_cast<quic::PathAckFrame*>(frame)) {
+                oss << ",\"path_id\":" << pf->GetPathId();
+                oss << ",\"ack_delay\":" << pf->GetAckDelay();
+                oss << ",\"acked_ranges\":" << SerializeAckRanges(pf);
+                if (pf->HasEcnCounts()) {
+                    oss << ",\"ect0\":" << pf->GetEct0();
+                    oss << ",\"ect1\":" << pf->GetEct1();
+                    oss << ",\"ce\":" << pf->GetEcnCe();
+                }
+            }
+            break;
+        }
+        case quic::FrameType::kPathAbandon: {
+            if (auto* pf = dynamic_cast<quic::PathAbandonFrame*>(frame)) {
+                oss << ",\"path_id\":" << pf->GetPathId();
+                oss << ",\"error_code\":" << pf->GetErrorCode();
+            }
+            break;
+        }
+        case quic::FrameType::kPathStatusBackup:
+        case quic::FrameType::kPathStatusAvailable: {
+            if (auto* pf = dynamic_cast<quic::PathStatusFrame*>(frame)) {
+                oss << ",\"path_id\":" << pf->GetPathId();
+                oss << ",\"sequence_number\":" << pf->GetSequenceNumber();
+            }
+            break;
+        }
+        case quic::FrameType::kPathNewConnectionId: {
+            if (auto* pf = dynamic_cast<quic::PathNewConnectionIDFrame*>(frame)) {
+                oss << ",\"path_id\":" << pf->GetPathId();
+                oss << ",\"sequence_number\":" << pf->GetSequenceNumber();
+                oss << ",\"retire_prior_to\":" << pf->GetRetirePriorTo();
+                quic::ConnectionID cid;
+                pf->GetConnectionID(cid);
+                oss << ",\"connection_id\":\"" << BytesToHex(cid.GetID(), cid.GetLength()) << "\"";
+            }
+            break;
+        }
+        case quic::FrameType::kPathRetireConnectionId: {
+            if (auto* pf = dynamic_cast<quic::PathRetireConnectionIDFrame*>(frame)) {
+                oss << ",\"path_id\":" << pf->GetPathId();
+                oss << ",\"sequence_number\":" << pf->GetSequenceNumber();
+            }
+            break;
+        }
+        case quic::FrameType::kMaxPathId: {
+            if (auto* mf = dynamic_cast<quic::MaxPathIdFrame*>(frame)) {
+                oss << ",\"maximum\":" << mf->GetMaxPathId();
+            }
+            break;
+        }
         case quic::FrameType::kCrypto: {
             if (auto* cf = dynamic_cast<quic::CryptoFrame*>(frame)) {
                 oss << ",\"offset\":" << cf->GetOffset();
@@ -0,0 +1,110 @@
+#ifndef COMMON_STRUCTURE_INTERVAL_LIST
+#define COMMON_STRUCTURE_INTERVAL_LIST
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace quicx {
+namespace common {
+
+/**
+ * @brief Sorted set of disjoint half-open [start, end) ranges
+ *
+ * Tuned for ranges that mostly arrive in increasing order, like ACKed
+ * stream bytes: adding a range at or past the last one extends or appends
+ * the tail without a search or an allocation per range, and trimming the
+ * low end pops from the front. Out-of-order inserts fall back to a binary
+ * search and merge whatever the new range touches.
+ *
+ * NOTE: Not thread-safe.
+ */
+class IntervalList {
+public:
+    struct Interval {
+        uint64_t start;
+        uint64_t end;
+    };
+    using const_iterator = std::deque<Interval>::const_iterator;
+
+    /**
+     * @brief Add [start, end), merging every range it overlaps or abuts
+     */
+    void Insert(uint64_t start, uint64_t end) {
+        if (start >= end) {
+            return;
+        }
+        // fast path: extends or follows the last range
+        if (intervals_.empty() || start > intervals_.back().end) {
+            intervals_.push_back(Interval{start, end});
+            return;
+        }
+        if (start >= intervals_.back().start) {
+            intervals_.back().end = std::max(intervals_.back().end, end);
+            return;
+        }
+
+        // first range that ends at or after start can merge with it
+        auto first = std::lower_bound(intervals_.begin(), intervals_.end(), start,
+            [](const Interval& interval, uint64_t pos) { return interval.end < pos; });
+        auto last = first;
+        while (last != intervals_.end() && last->start <= end) {
+            start = std::min(start, last->start);
+            end = std::max(end, last->end);
+            ++last;
+        }
+        if (first == last) {
+            intervals_.insert(first, Interval{start, end});
+            return;
+        }
+        first->start = start;
+        first->end = end;
+        intervals_.erase(first + 1, last);
+    }
+
+    /**
+     * @brief Drop everything below offset
+     */
+    void TrimBelow(uint64_t offset) {
+        while (!intervals_.empty() && intervals_.front().end <= offset) {
+            intervals_.pop_front();
+        }
+        if (!intervals_.empty() && intervals_.front().start < offset) {
+            intervals_.front().start = offset;
+        }
+    }
+
+    /**
+     * @brief First range whose end lies after pos, i.e. the range holding
+     * pos if there is one, otherwise the next range above it
+     */
+    const_iterator FindEndingAfter(uint64_t pos) const {
+        return std::upper_bound(intervals_.begin(), intervals_.end(), pos,
+            [](uint64_t p, const Interval& interval) { return p < interval.end; });
+    }
+
+    /**
+     * @brief Whether [start, end) is covered by a single range
+     */
+    bool Contains(uint64_t start, uint64_t end) const {
+        auto it = FindEndingAfter(start);
+        return it != intervals_.end() && it->start <= start && it->end >= end;
+    }
+
+    const_iterator begin() const { return intervals_.begin(); }
+    const_iterator end() const { return intervals_.end(); }
+    const Interval& Front() const { return intervals_.front(); }
+
+    bool IsEmpty() const { return intervals_.empty(); }
+    size_t Size() const { return intervals_.size(); }
+    void Clear() { intervals_.clear(); }
+
+private:
+    std::deque<Interval> intervals_;
+};
+
+}  // namespace common
+}  // namespace quicx
+
+#endif
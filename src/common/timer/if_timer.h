@@ -1,6 +1,7 @@
 #ifndef COMMON_TIMER_TIMER_INTERFACE
 #define COMMON_TIMER_TIMER_INTERFACE
 
+#include "common/timer/timer_node.h"
 #include "common/timer/timer_task.h"
 
 namespace quicx {
@@ -15,6 +16,11 @@ public:
     virtual uint64_t AddTimer(TimerTask& task, uint32_t time, uint64_t now = 0) = 0;
     virtual bool RemoveTimer(TimerTask& task) = 0;
 
+    // intrusive timers: the node itself is linked in, nothing is copied.
+    // arming an armed node re-arms it.
+    virtual void ArmTimer(TimerNode& node, uint32_t time, uint64_t now = 0) = 0;
+    virtual bool DisarmTimer(TimerNode& node) = 0;
+
     // get min next time out time
     // return: 
     // >= 0  : the next time
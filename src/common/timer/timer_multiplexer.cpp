@@ -0,0 +1,119 @@
+#include <limits>
+
+#include "common/timer/timer_multiplexer.h"
+#include "common/util/time.h"
+
+namespace quicx {
+namespace common {
+
+TimerMultiplexer::TimerMultiplexer(std::shared_ptr<ITimer> timer):
+    timer_(timer) {
+    entry_.SetTimeoutCallback([this]() { OnEntryTimeout(); });
+}
+
+TimerMultiplexer::~TimerMultiplexer() {
+    while (!nodes_.Empty()) {
+        TimerNode* node = static_cast<TimerNode*>(nodes_.next);
+        node->Unlink();
+        node->timer_ = nullptr;
+    }
+    if (entry_.IsArmed()) {
+        timer_->DisarmTimer(entry_);
+    }
+}
+
+uint64_t TimerMultiplexer::AddTimer(TimerTask& task, uint32_t time_ms, uint64_t now) {
+    return timer_->AddTimer(task, time_ms, now);
+}
+
+bool TimerMultiplexer::RemoveTimer(TimerTask& task) {
+    return timer_->RemoveTimer(task);
+}
+
+void TimerMultiplexer::ArmTimer(TimerNode& node, uint32_t time_ms, uint64_t now) {
+    if (now == 0) {
+        now = UTCTimeMsec();
+    }
+    if (node.timer_) {
+        node.timer_->DisarmTimer(node);
+    }
+    node.time_ = now + time_ms;
+    node.timer_ = this;
+    nodes_.PushBack(&node);
+    armed_count_++;
+
+    if (!entry_.IsArmed() || node.time_ < entry_.GetDeadline()) {
+        timer_->ArmTimer(entry_, time_ms, now);
+    }
+}
+
+bool TimerMultiplexer::DisarmTimer(TimerNode& node) {
+    if (node.timer_ != this) {
+        return false;
+    }
+    node.Unlink();
+    node.timer_ = nullptr;
+    armed_count_--;
+
+    // an entry left at a disarmed deadline fires early and moves on, which
+    // is cheaper than finding the next deadline on every disarm
+    if (armed_count_ == 0 && entry_.IsArmed()) {
+        timer_->DisarmTimer(entry_);
+    }
+    return true;
+}
+
+int32_t TimerMultiplexer::MinTime(uint64_t now) {
+    return timer_->MinTime(now);
+}
+
+void TimerMultiplexer::TimerRun(uint64_t now) {
+    timer_->TimerRun(now);
+}
+
+bool TimerMultiplexer::Empty() {
+    return timer_->Empty();
+}
+
+void TimerMultiplexer::OnEntryTimeout() {
+    uint64_t due = entry_.GetDeadline();
+
+    // Collect first, then fire: a callback may arm or disarm any node,
+    // including one still waiting in the batch, which just unlinks it.
+    TimerLink fired;
+    for (TimerLink* link = nodes_.next; link != &nodes_;) {
+        TimerNode* node = static_cast<TimerNode*>(link);
+        link = link->next;
+        if (node->time_ <= due) {
+            node->Unlink();
+            fired.PushBack(node);
+        }
+    }
+    while (!fired.Empty()) {
+        TimerNode* node = static_cast<TimerNode*>(fired.next);
+        node->Unlink();
+        node->timer_ = nullptr;
+        armed_count_--;
+        if (node->cb_) {
+            node->cb_();
+        }
+    }
+
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    for (TimerLink* link = nodes_.next; link != &nodes_; link = link->next) {
+        uint64_t time = static_cast<TimerNode*>(link)->time_;
+        if (time < next) {
+            next = time;
+        }
+    }
+    if (armed_count_ == 0 || (entry_.IsArmed() && entry_.GetDeadline() <= next)) {
+        return;
+    }
+    // `due` is the shared timer's current time while it fires us. A deadline
+    // at or before it (armed by a callback) goes to the next tick.
+    uint32_t delay = next > due ? static_cast<uint32_t>(next - due) : 1;
+    timer_->ArmTimer(entry_, delay, due);
+}
+
+}  // namespace common
+}  // namespace quicx
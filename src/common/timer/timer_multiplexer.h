@@ -0,0 +1,61 @@
+#ifndef COMMON_TIMER_TIMER_MULTIPLEXER
+#define COMMON_TIMER_TIMER_MULTIPLEXER
+
+#include <cstddef>
+#include <memory>
+
+#include "common/timer/if_timer.h"
+
+namespace quicx {
+namespace common {
+
+/**
+ * @brief Folds the timers of one owner into a single entry of a shared timer
+ *
+ * A connection re-arms its PTO, loss, ACK-delay, pacing and flow-control
+ * timers on nearly every packet. Armed through the multiplexer, those nodes
+ * sit in a short local list and the shared timer holds one entry for the
+ * whole connection, at the earliest of their deadlines. The entry is only
+ * touched when that earliest deadline moves earlier; disarming a node
+ * leaves it in place. When the entry fires, every node due by then fires
+ * and the entry moves on to the next deadline.
+ *
+ * TimerTask calls, MinTime(), TimerRun() and Empty() go straight to the
+ * shared timer, whose owner keeps driving it.
+ *
+ * NOTE: Not thread-safe, use it on the shared timer's thread.
+ */
+class TimerMultiplexer: public ITimer {
+public:
+    explicit TimerMultiplexer(std::shared_ptr<ITimer> timer);
+    ~TimerMultiplexer();
+
+    virtual uint64_t AddTimer(TimerTask& task, uint32_t time_ms, uint64_t now = 0) override;
+    virtual bool RemoveTimer(TimerTask& task) override;
+
+    virtual void ArmTimer(TimerNode& node, uint32_t time_ms, uint64_t now = 0) override;
+    virtual bool DisarmTimer(TimerNode& node) override;
+
+    virtual int32_t MinTime(uint64_t now = 0) override;
+    virtual void TimerRun(uint64_t now = 0) override;
+    virtual bool Empty() override;
+
+    // nodes armed here
+    size_t GetArmedCount() const { return armed_count_; }
+    // whether the shared timer holds our entry
+    bool IsEntryArmed() const { return entry_.IsArmed(); }
+
+private:
+    void OnEntryTimeout();
+
+private:
+    std::shared_ptr<ITimer> timer_;
+    TimerLink nodes_;  // armed nodes, unordered: an owner has only a few
+    size_t armed_count_ = 0;
+    TimerNode entry_;  // our single entry in timer_
+};
+
+}  // namespace common
+}  // namespace quicx
+
+#endif
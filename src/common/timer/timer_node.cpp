@@ -0,0 +1,14 @@
+#include "common/timer/if_timer.h"
+#include "common/timer/timer_node.h"
+
+namespace quicx {
+namespace common {
+
+TimerNode::~TimerNode() {
+    if (timer_) {
+        timer_->DisarmTimer(*this);
+    }
+}
+
+}  // namespace common
+}  // namespace quicx
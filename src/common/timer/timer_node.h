@@ -0,0 +1,108 @@
+#ifndef COMMON_TIMER_TIMER_NODE
+#define COMMON_TIMER_TIMER_NODE
+
+#include <cstdint>
+#include <functional>
+
+namespace quicx {
+namespace common {
+
+class ITimer;
+class TreeMapTimer;
+class TimingWheelTimer;
+class TimerMultiplexer;
+
+/**
+ * @brief Link of an intrusive, circular doubly-linked list.
+ *
+ * A list head is a bare TimerLink pointing at itself, and an unlinked node
+ * points at itself too, so a node can leave its list in O(1) without
+ * knowing which list (wheel slot, fired batch, ...) currently holds it.
+ */
+struct TimerLink {
+    TimerLink* prev;
+    TimerLink* next;
+
+    TimerLink(): prev(this), next(this) {}
+    TimerLink(const TimerLink&) = delete;
+    TimerLink& operator=(const TimerLink&) = delete;
+
+    // For a head: the list is empty. For a node: it is in no list.
+    bool Empty() const { return next == this; }
+
+    // Append node to the list headed by this.
+    void PushBack(TimerLink* node) {
+        node->prev = prev;
+        node->next = this;
+        prev->next = node;
+        prev = node;
+    }
+
+    // Take this node out of its list.
+    void Unlink() {
+        prev->next = next;
+        next->prev = prev;
+        prev = this;
+        next = this;
+    }
+
+    // Move every node of from to the back of this list.
+    void Splice(TimerLink& from) {
+        if (from.Empty()) {
+            return;
+        }
+        TimerLink* first = from.next;
+        TimerLink* last = from.prev;
+        first->prev = prev;
+        prev->next = first;
+        last->next = this;
+        prev = last;
+        from.prev = &from;
+        from.next = &from;
+    }
+};
+
+/**
+ * @brief A timer embedded in its owner.
+ *
+ * Unlike TimerTask, which the timer copies (callback included) on every
+ * AddTimer(), a node is linked into the timer in place: arming it writes a
+ * deadline and two pointers, with no allocation and no std::function copy.
+ * The callback is set once, and re-arming an armed node just moves it.
+ *
+ * The node must not be copied or moved while armed; destroying an armed
+ * node disarms it, so the timer must outlive every node armed in it.
+ */
+class TimerNode: private TimerLink {
+public:
+    TimerNode() {}
+    explicit TimerNode(std::function<void()> cb): cb_(std::move(cb)) {}
+    ~TimerNode();
+
+    void SetTimeoutCallback(std::function<void()> cb) { cb_ = std::move(cb); }
+
+    bool IsArmed() const { return timer_ != nullptr; }
+    // absolute deadline (ms) of the last arm
+    uint64_t GetDeadline() const { return time_; }
+
+private:
+    std::function<void()> cb_;
+    ITimer* timer_ = nullptr;  // the timer this node is armed in
+    uint64_t time_ = 0;
+
+    // Timing-wheel placement, see TimingWheelTimer.
+    int8_t wheel_idx_ = -1;
+    uint32_t slot_idx_ = 0;
+    // Set on the nodes TimingWheelTimer allocates for copied TimerTasks.
+    bool owned_ = false;
+    uint64_t id_ = 0;
+
+    friend class TreeMapTimer;
+    friend class TimingWheelTimer;
+    friend class TimerMultiplexer;
+};
+
+}  // namespace common
+}  // namespace quicx
+
+#endif  // COMMON_TIMER_TIMER_NODE
@@ -3,7 +3,6 @@
 
 #include <cstdint>
 #include <functional>
-#include <list>
 
 namespace quicx {
 namespace common {
@@ -13,11 +12,11 @@ class TreeMapTimer;
 class TimingWheelTimer;
 
 /**
- * @brief A timer task that holds a callback and placement metadata.
+ * @brief A timer task that holds a callback, copied into the timer.
  *
- * When registered with TimingWheelTimer, the internal fields (time_, id_,
- * wheel_idx_, slot_idx_, list_it_) are populated so the timer can be
- * cancelled in O(1) time.
+ * AddTimer() copies the callback and writes time_ and id_ back, so the
+ * task can be cancelled by id later. Timers re-armed on a hot path should
+ * use an embedded TimerNode instead, see timer_node.h.
  */
 class TimerTask {
 public:
@@ -26,8 +25,7 @@ public:
     TimerTask() {}
     TimerTask(std::function<void()> tcb): tcb_(tcb) {}
     TimerTask(const TimerTask& t)
-        : tcb_(t.tcb_), time_(t.time_), id_(t.id_),
-          wheel_idx_(t.wheel_idx_), slot_idx_(t.slot_idx_), list_it_(t.list_it_) {}
+        : tcb_(t.tcb_), time_(t.time_), id_(t.id_) {}
 
     void SetTimeoutCallback(std::function<void()> tcb) { tcb_ = tcb; }
     uint64_t GetId() const { return id_; }
@@ -37,15 +35,6 @@ private:
     uint64_t time_ = 0;
     uint64_t id_   = 0;
 
-    // Timing-wheel placement metadata.
-    // wheel_idx_ == -1 means "not currently registered in the wheel".
-    // Values 0/1/2 → wheel0_/wheel1_/wheel2_; 3 → overflow list.
-    int8_t   wheel_idx_ = -1;
-    uint32_t slot_idx_  = 0;
-    // Iterator into the slot's value-list (list<TimerTask>).
-    // Valid only when wheel_idx_ >= 0.
-    std::list<TimerTask>::iterator list_it_;
-
     friend class TreeMapTimer;
     friend class TimingWheelTimer;
 };
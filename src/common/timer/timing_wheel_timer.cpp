@@ -34,24 +34,97 @@ TimingWheelTimer::TimingWheelTimer()
     wheel2_slot_min_.fill(kInvalidDeadline);
 }
 
+TimingWheelTimer::~TimingWheelTimer() {
+    // Detach every node still armed so its owner can outlive the wheel, and
+    // free the nodes allocated for copied TimerTasks.
+    auto drain = [](Slot& slot) {
+        while (!slot.Empty()) {
+            TimerNode* node = static_cast<TimerNode*>(slot.next);
+            node->Unlink();
+            node->timer_     = nullptr;
+            node->wheel_idx_ = -1;
+            if (node->owned_) {
+                delete node;
+            }
+        }
+    };
+    for (auto& slot : wheel0_) drain(slot);
+    for (auto& slot : wheel1_) drain(slot);
+    for (auto& slot : wheel2_) drain(slot);
+    drain(overflow_);
+}
+
 // ---------------------------------------------------------------------------
 // AddTimer
 //
-// O(1): copy task into wheel slot, update min cache if needed.
+// O(1): copy the task's callback into a wheel-owned node and link it.
 // ---------------------------------------------------------------------------
 uint64_t TimingWheelTimer::AddTimer(TimerTask& task, uint32_t time_ms, uint64_t now) {
     uint64_t reference = (now != 0) ? now : UTCTimeMsec();
 
+    TimerNode* node = new TimerNode(task.tcb_);
+    node->owned_ = true;
+    node->id_    = static_cast<uint64_t>(random_.Random());
+    node->time_  = reference + time_ms;
+
+    task.id_   = node->id_;
+    task.time_ = node->time_;
+    location_map_[node->id_] = node;
+
+    Arm(*node, reference);
+    return task.id_;
+}
+
+// ---------------------------------------------------------------------------
+// RemoveTimer
+//
+// O(1): find the task's node by id, unlink and free it.
+// ---------------------------------------------------------------------------
+bool TimingWheelTimer::RemoveTimer(TimerTask& task) {
+    auto loc_it = location_map_.find(task.id_);
+    if (loc_it == location_map_.end()) {
+        return false;
+    }
+    TimerNode* node = loc_it->second;
+    location_map_.erase(loc_it);
+    Unlink(*node);
+    delete node;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// ArmTimer / DisarmTimer
+//
+// O(1), allocation-free: the caller's node is linked in place.
+// ---------------------------------------------------------------------------
+void TimingWheelTimer::ArmTimer(TimerNode& node, uint32_t time_ms, uint64_t now) {
+    uint64_t reference = (now != 0) ? now : UTCTimeMsec();
+    if (node.timer_) {
+        node.timer_->DisarmTimer(node);
+    }
+    node.time_ = reference + time_ms;
+    Arm(node, reference);
+}
+
+bool TimingWheelTimer::DisarmTimer(TimerNode& node) {
+    if (node.timer_ != this) {
+        return false;
+    }
+    Unlink(node);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Arm (internal)
+// ---------------------------------------------------------------------------
+void TimingWheelTimer::Arm(TimerNode& node, uint64_t reference) {
     if (!initialized_) {
         current_ms_  = reference;
         initialized_ = true;
     }
 
-    task.id_        = static_cast<uint64_t>(random_.Random());
-    task.time_      = reference + time_ms;
-    task.wheel_idx_ = -1;
-
-    Insert(task, reference);
+    node.timer_ = this;
+    Insert(node, reference);
     ++total_tasks_;
 
     // O(1) cache update.
@@ -63,7 +136,7 @@ uint64_t TimingWheelTimer::AddTimer(TimerTask& task, uint32_t time_ms, uint64_t
     // When the cache is DIRTY (set kInvalidDeadline by RemoveTimer or by a
     // fired slot), there may be unscanned tasks whose deadlines are smaller
     // than this newly-inserted one. If we naively wrote
-    //     min_deadline_cache_ = task.time_; cache_dirty_ = false;
+    //     min_deadline_cache_ = node.time_; cache_dirty_ = false;
     // we would wrongly advertise this new task as the minimum and skip the
     // earlier tasks still living in higher-level wheels — MinTime() would
     // then return a deadline far in the future (e.g. a 10 s idle timer
@@ -71,40 +144,26 @@ uint64_t TimingWheelTimer::AddTimer(TimerTask& task, uint32_t time_ms, uint64_t
     // recheck timer scheduled at t0 was reported by MinTime as 10 000 ms
     // because a subsequent ResetIdleTimer (Remove+Add 10 s) corrupted the
     // cache here. Keep dirty so the next MinTime() rescans the full wheel.
-    if (!cache_dirty_ && task.time_ < min_deadline_cache_) {
-        min_deadline_cache_ = task.time_;
+    if (!cache_dirty_ && node.time_ < min_deadline_cache_) {
+        min_deadline_cache_ = node.time_;
     }
-
-    return task.id_;
 }
 
 // ---------------------------------------------------------------------------
-// RemoveTimer
+// Unlink (internal)
 //
-// O(1) erase. Invalidate cache if this task held the current minimum.
+// O(1) erase. Invalidate cache if this node held the current minimum.
 // ---------------------------------------------------------------------------
-bool TimingWheelTimer::RemoveTimer(TimerTask& task) {
-    auto loc_it = location_map_.find(task.id_);
-    if (loc_it == location_map_.end()) {
-        return false;
-    }
-
-    auto it = loc_it->second;
-    Slot* slot = nullptr;
-    int8_t  level    = it->wheel_idx_;
-    uint32_t slot_idx = it->slot_idx_;
-    switch (level) {
-        case 0: slot = &wheel0_[slot_idx]; break;
-        case 1: slot = &wheel1_[slot_idx]; break;
-        case 2: slot = &wheel2_[slot_idx]; break;
-        case 3: slot = &overflow_;         break;
-        default: return false;
-    }
-
-    uint64_t old_time = it->time_;
-    slot->erase(it);
-    location_map_.erase(loc_it);
-    task.wheel_idx_ = -1;
+void TimingWheelTimer::Unlink(TimerNode& node) {
+    int8_t   level    = node.wheel_idx_;
+    uint32_t slot_idx = node.slot_idx_;
+    uint64_t old_time = node.time_;
+
+    // A node of a slot being fired sits in Tick()'s local list; unlinking it
+    // from there is the same O(1) operation.
+    node.Unlink();
+    node.timer_     = nullptr;
+    node.wheel_idx_ = -1;
     --total_tasks_;
 
     // ---- Maintain per-level occupancy bitmaps and per-slot min caches. ----
@@ -119,32 +178,32 @@ bool TimingWheelTimer::RemoveTimer(TimerTask& task) {
     //   * Removing a non-min task from a slot leaves slot_min_ valid.
     switch (level) {
         case 0:
-            if (slot->empty()) {
+            if (wheel0_[slot_idx].Empty()) {
                 ClrWheel0Bit(slot_idx);
             }
             break;
         case 1:
-            if (slot->empty()) {
+            if (wheel1_[slot_idx].Empty()) {
                 ClrWheel1Bit(slot_idx);
                 wheel1_slot_min_[slot_idx] = kInvalidDeadline;
             } else if (old_time == wheel1_slot_min_[slot_idx]) {
-                wheel1_slot_min_[slot_idx] = ScanSlotMin(*slot);
+                wheel1_slot_min_[slot_idx] = ScanSlotMin(wheel1_[slot_idx]);
             }
             break;
         case 2:
-            if (slot->empty()) {
+            if (wheel2_[slot_idx].Empty()) {
                 ClrWheel2Bit(slot_idx);
                 wheel2_slot_min_[slot_idx] = kInvalidDeadline;
             } else if (old_time == wheel2_slot_min_[slot_idx]) {
-                wheel2_slot_min_[slot_idx] = ScanSlotMin(*slot);
+                wheel2_slot_min_[slot_idx] = ScanSlotMin(wheel2_[slot_idx]);
             }
             break;
         case 3:
-            if (slot->empty()) {
+            if (overflow_.Empty()) {
                 overflow_nonempty_ = false;
                 overflow_slot_min_ = kInvalidDeadline;
             } else if (old_time == overflow_slot_min_) {
-                overflow_slot_min_ = ScanSlotMin(*slot);
+                overflow_slot_min_ = ScanSlotMin(overflow_);
             }
             break;
         default: break;
@@ -156,7 +215,6 @@ bool TimingWheelTimer::RemoveTimer(TimerTask& task) {
         min_deadline_cache_ = kInvalidDeadline;
         cache_dirty_        = true;
     }
-    return true;
 }
 
 // ---------------------------------------------------------------------------
@@ -221,27 +279,17 @@ bool TimingWheelTimer::Empty() {
 // ---------------------------------------------------------------------------
 // Insert (internal)
 //
-// Copies `task` into the appropriate slot, writes placement metadata back
-// into the caller's task. Also maintains the level occupancy bitmap and
-// per-slot min cache.
+// Links `node` into the appropriate slot and records its placement. Also
+// maintains the level occupancy bitmap and per-slot min cache.
 // ---------------------------------------------------------------------------
-void TimingWheelTimer::Insert(TimerTask& task, uint64_t reference) {
-    uint64_t deadline = task.time_;
+void TimingWheelTimer::Insert(TimerNode& node, uint64_t reference) {
+    uint64_t deadline = node.time_;
     uint64_t delta    = (deadline > reference) ? (deadline - reference) : 0;
 
     auto place = [&](Slot& slot, int8_t level, uint32_t slot_idx) {
-        slot.push_back(task);
-        auto it        = std::prev(slot.end());
-        it->wheel_idx_ = level;
-        it->slot_idx_  = slot_idx;
-        it->list_it_   = it;
-
-        location_map_[task.id_] = it;
-
-        // Write back to caller's task for RemoveTimer.
-        task.wheel_idx_ = level;
-        task.slot_idx_  = slot_idx;
-        task.list_it_   = it;
+        slot.PushBack(&node);
+        node.wheel_idx_ = level;
+        node.slot_idx_  = slot_idx;
 
         // Maintain occupancy bitmap + per-slot min cache.
         switch (level) {
@@ -296,7 +344,7 @@ void TimingWheelTimer::Cascade(int level, uint32_t slot) {
     }
 
     Slot local;
-    local.swap(*src);
+    local.Splice(*src);
 
     // The source slot is now empty — clear its bitmap bit and per-slot min
     // before re-inserting; the re-inserts will re-populate the destinations.
@@ -315,13 +363,12 @@ void TimingWheelTimer::Cascade(int level, uint32_t slot) {
             break;
     }
 
-    for (TimerTask& t : local) {
-        t.wheel_idx_ = -1;
-        --total_tasks_;
-        Insert(t, current_ms_);
-        ++total_tasks_;
-        // Cascaded tasks may now be in a lower level — cache is still valid
-        // (their deadlines didn't change), so no dirty flag needed here.
+    // Cascaded tasks may now be in a lower level — cache is still valid
+    // (their deadlines didn't change), so no dirty flag needed here.
+    while (!local.Empty()) {
+        TimerNode* node = static_cast<TimerNode*>(local.next);
+        node->Unlink();
+        Insert(*node, current_ms_);
     }
 }
 
@@ -349,20 +396,31 @@ void TimingWheelTimer::Tick(uint64_t now) {
             Cascade(1, c1);
         }
 
-        // Swap out the current L0 slot and fire all tasks in it.
+        // Move the current L0 slot out and fire all tasks in it. A callback
+        // may disarm a node still waiting in `fired`, which unlinks it.
         Slot fired;
-        fired.swap(wheel0_[c0]);
+        fired.Splice(wheel0_[c0]);
 
-        bool any_fired = !fired.empty();
+        bool any_fired = !fired.Empty();
         if (any_fired) {
             // L0 slot is now empty: clear its occupancy bit.
             ClrWheel0Bit(c0);
         }
-        for (TimerTask& t : fired) {
+        while (!fired.Empty()) {
+            TimerNode* node = static_cast<TimerNode*>(fired.next);
+            node->Unlink();
+            node->timer_     = nullptr;
+            node->wheel_idx_ = -1;
             --total_tasks_;
-            location_map_.erase(t.id_);
-            if (t.tcb_) {
-                t.tcb_();
+            if (node->owned_) {
+                location_map_.erase(node->id_);
+                std::function<void()> cb = std::move(node->cb_);
+                delete node;
+                if (cb) {
+                    cb();
+                }
+            } else if (node->cb_) {
+                node->cb_();
             }
         }
 
@@ -408,8 +466,9 @@ uint32_t TimingWheelTimer::Wheel0NextSetFrom(const std::array<uint64_t, 4>& bm,
 
 uint64_t TimingWheelTimer::ScanSlotMin(const Slot& slot) {
     uint64_t m = kInvalidDeadline;
-    for (const TimerTask& t : slot) {
-        if (t.time_ < m) m = t.time_;
+    for (const TimerLink* link = slot.next; link != &slot; link = link->next) {
+        uint64_t t = static_cast<const TimerNode*>(link)->time_;
+        if (t < m) m = t;
     }
     return m;
 }
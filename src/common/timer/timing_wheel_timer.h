@@ -4,8 +4,6 @@
 #include <array>
 #include <cstdint>
 #include <limits>
-#include <list>
-#include <vector>
 #include <unordered_map>
 
 #include "common/timer/if_timer.h"
@@ -32,14 +30,17 @@ namespace common {
  * when the wheel catches up.
  *
  * Ownership model:
- *   Each slot stores TimerTask VALUES (copies), NOT pointers.
- *   AddTimer() copies the caller's task into the appropriate slot and writes
- *   the slot iterator back into the caller's task so that RemoveTimer() can
- *   erase the copy in O(1).
+ *   Each slot is an intrusive list of TimerNodes. ArmTimer() links the
+ *   caller's node in place: no allocation, no callback copy, and the node
+ *   unlinks itself in O(1). AddTimer() keeps the copying TimerTask API by
+ *   allocating a node that holds a copy of the task's callback; the wheel
+ *   owns that node and finds it by id on RemoveTimer().
  *
  * Complexity:
- *   AddTimer    – O(1)
+ *   AddTimer    – O(1), one allocation
  *   RemoveTimer – O(1)
+ *   ArmTimer    – O(1), no allocation
+ *   DisarmTimer – O(1)
  *   TimerRun    – O(k) where k = number of expired timers in the ticked range
  *   MinTime     – O(1) amortised (lazy scan only after remove/fire)
  *                  Cache is maintained incrementally: AddTimer always updates
@@ -67,22 +68,30 @@ public:
     static constexpr uint64_t kL1Range = kL0Range * kL1Size;        //    16 384
     static constexpr uint64_t kL2Range = kL1Range * kL2Size;        // 1 048 576
 
-    // Each slot holds TimerTask *values* so the wheel owns them.
-    using Slot = std::list<TimerTask>;
+    // Each slot is the head of an intrusive list of TimerNodes.
+    using Slot = TimerLink;
 
     TimingWheelTimer();
-    ~TimingWheelTimer() = default;
+    ~TimingWheelTimer();
 
     // ITimer interface
     uint64_t AddTimer(TimerTask& task, uint32_t time_ms, uint64_t now = 0) override;
     bool     RemoveTimer(TimerTask& task) override;
+    void     ArmTimer(TimerNode& node, uint32_t time_ms, uint64_t now = 0) override;
+    bool     DisarmTimer(TimerNode& node) override;
     int32_t  MinTime(uint64_t now = 0) override;
     void     TimerRun(uint64_t now = 0) override;
     bool     Empty() override;
 
 private:
-    // Copy `task` into the appropriate wheel slot and update task's placement fields.
-    void Insert(TimerTask& task, uint64_t reference);
+    // Link `node`, whose time_ is set, `reference` being the current time.
+    void Arm(TimerNode& node, uint64_t reference);
+
+    // Unlink an armed `node` and keep the slot bookkeeping up to date.
+    void Unlink(TimerNode& node);
+
+    // Link `node` into the appropriate wheel slot and set its placement fields.
+    void Insert(TimerNode& node, uint64_t reference);
 
     // Re-insert all tasks from a higher-level slot into lower levels.
     void Cascade(int level, uint32_t slot);
@@ -152,8 +161,8 @@ private:
 
     RangeRandom random_;
 
-    // Map to keep track of timer locations because user objects are copied.
-    std::unordered_map<uint64_t, std::list<TimerTask>::iterator> location_map_;
+    // Nodes allocated for copied TimerTasks, by task id.
+    std::unordered_map<uint64_t, TimerNode*> location_map_;
 };
 
 }  // namespace common
@@ -7,7 +7,11 @@ namespace common {
 TreeMapTimer::TreeMapTimer():
     next_id_(0) {}
 
-TreeMapTimer::~TreeMapTimer() {}
+TreeMapTimer::~TreeMapTimer() {
+    for (auto& item : node_map_) {
+        item.second->timer_ = nullptr;
+    }
+}
 
 uint64_t TreeMapTimer::AddTimer(TimerTask& task, uint32_t time_ms, uint64_t now) {
     if (now == 0) {
@@ -33,8 +37,40 @@ bool TreeMapTimer::RemoveTimer(TimerTask& task) {
     return false;
 }
 
+void TreeMapTimer::ArmTimer(TimerNode& node, uint32_t time_ms, uint64_t now) {
+    if (now == 0) {
+        now = UTCTimeMsec();
+    }
+    if (node.timer_) {
+        node.timer_->DisarmTimer(node);
+    }
+    node.time_ = now + time_ms;
+    node.timer_ = this;
+    node_map_.emplace(node.time_, &node);
+}
+
+bool TreeMapTimer::DisarmTimer(TimerNode& node) {
+    if (node.timer_ != this) {
+        return false;
+    }
+    node.timer_ = nullptr;
+    // waiting in TimerRun()'s fired batch
+    if (!node.Empty()) {
+        node.Unlink();
+        return true;
+    }
+    auto range = node_map_.equal_range(node.time_);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        if (iter->second == &node) {
+            node_map_.erase(iter);
+            break;
+        }
+    }
+    return true;
+}
+
 int32_t TreeMapTimer::MinTime(uint64_t now) {
-    if (timer_map_.empty()) {
+    if (timer_map_.empty() && node_map_.empty()) {
         return -1;
     }
 
@@ -42,7 +78,14 @@ int32_t TreeMapTimer::MinTime(uint64_t now) {
         now = UTCTimeMsec();
     }
 
-    int32_t next_time = (int32_t)(timer_map_.begin()->first - now);
+    uint64_t next = UINT64_MAX;
+    if (!timer_map_.empty()) {
+        next = timer_map_.begin()->first;
+    }
+    if (!node_map_.empty() && node_map_.begin()->first < next) {
+        next = node_map_.begin()->first;
+    }
+    int32_t next_time = (int32_t)(next - now);
 
     // If next_time is negative, it means the timer has already expired
     // Return 0 to indicate immediate execution
@@ -78,15 +121,32 @@ void TreeMapTimer::TimerRun(uint64_t now) {
         }
     }
 
+    // Expired nodes move to an intrusive batch, so a callback disarming a
+    // node that has not fired yet just unlinks it.
+    TimerLink fired;
+    while (!node_map_.empty() && node_map_.begin()->first <= now) {
+        fired.PushBack(node_map_.begin()->second);
+        node_map_.erase(node_map_.begin());
+    }
+
     // Execute callbacks after removing from map to avoid iterator invalidation
     for (auto& callback : callbacks) {
         callback();
         executed_count++;
     }
+    while (!fired.Empty()) {
+        TimerNode* node = static_cast<TimerNode*>(fired.next);
+        node->Unlink();
+        node->timer_ = nullptr;
+        if (node->cb_) {
+            node->cb_();
+        }
+        executed_count++;
+    }
 }
 
 bool TreeMapTimer::Empty() {
-    return timer_map_.empty();
+    return timer_map_.empty() && node_map_.empty();
 }
 
 }  // namespace common
@@ -18,6 +18,9 @@ public:
     virtual uint64_t AddTimer(TimerTask& task, uint32_t time_ms, uint64_t now = 0);
     virtual bool RemoveTimer(TimerTask& task);
 
+    virtual void ArmTimer(TimerNode& node, uint32_t time_ms, uint64_t now = 0);
+    virtual bool DisarmTimer(TimerNode& node);
+
     // get min next time out time
     // return: 
     // >= 0  : the next time
@@ -33,6 +36,9 @@ private:
     uint64_t next_id_ = 0;  // monotonically increasing timer ID
     // time => id => task
     std::map<uint64_t, std::unordered_map<uint64_t, TimerTask>> timer_map_;
+    // time => armed nodes; a node is linked only while TimerRun() holds it
+    // in its fired batch
+    std::multimap<uint64_t, TimerNode*> node_map_;
 };
 
 }
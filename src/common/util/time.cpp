@@ -1,3 +1,4 @@
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include "common/util/time.h"
@@ -6,14 +7,28 @@
 namespace quicx {
 namespace common {
 
+static std::atomic<uint64_t (*)()> test_clock_{nullptr};
+
 uint64_t UTCTimeSec() {
+    auto clock = test_clock_.load(std::memory_order_relaxed);
+    if (clock) {
+        return clock() / 1000000;
+    }
     return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
 uint64_t UTCTimeMsec() {
+    auto clock = test_clock_.load(std::memory_order_relaxed);
+    if (clock) {
+        return clock() / 1000;
+    }
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
+void SetUTCClockForTest(uint64_t (*now_usec)()) {
+    test_clock_.store(now_usec, std::memory_order_relaxed);
+}
+
 std::string GetFormatTime(FormatTimeUnit unit) {
     char buf[kFormatTimeBufSize] = {0};
     uint32_t len = kFormatTimeBufSize;
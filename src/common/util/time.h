@@ -36,6 +36,11 @@ void GetFormatTime(char* buf, uint32_t& len, FormatTimeUnit unit = FormatTimeUni
 uint64_t UTCTimeSec();
 uint64_t UTCTimeMsec();
 
+// replace the clock behind UTCTimeSec/UTCTimeMsec, e.g. with the virtual clock of a
+// simulation. the function returns microseconds since epoch, nullptr restores the
+// system clock. install it before any event loop starts.
+void SetUTCClockForTest(uint64_t (*now_usec)());
+
 // sleep interval milliseconds
 void Sleep(uint32_t interval);
 
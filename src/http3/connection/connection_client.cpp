@@ -165,6 +165,7 @@ void ClientConnection::CreateAndSendRequestStream(
     if (qlog_trace) {
         request_stream->SetQlogTrace(qlog_trace);
     }
+    request_stream->SetConnectionStatsProvider(MakeStatsProvider());
 
     streams_[stream->GetStreamID()] = request_stream;
 
@@ -199,6 +200,7 @@ void ClientConnection::CreateAndSendRequestStream(std::shared_ptr<IRequest> requ
     if (qlog_trace) {
         request_stream->SetQlogTrace(qlog_trace);
     }
+    request_stream->SetConnectionStatsProvider(MakeStatsProvider());
 
     streams_[stream->GetStreamID()] = request_stream;
 
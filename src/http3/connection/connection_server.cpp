@@ -307,6 +307,7 @@ void ServerConnection::HandleStream(std::shared_ptr<IQuicStream> stream, uint32_
         if (qlog_trace) {
             response_stream->SetQlogTrace(qlog_trace);
         }
+        response_stream->SetConnectionStatsProvider(MakeStatsProvider());
 
         streams_[response_stream->GetStreamID()] = response_stream;
 
@@ -234,6 +234,14 @@ std::function<void(uint64_t, uint32_t)> IConnection::MakeErrorHandler() {
     };
 }
 
+std::function<bool(QuicConnectionStats&)> IConnection::MakeStatsProvider() {
+    std::weak_ptr<IQuicConnection> weak_conn = quic_connection_;
+    return [weak_conn](QuicConnectionStats& stats) {
+        auto conn = weak_conn.lock();
+        return conn && conn->GetStats(stats);
+    };
+}
+
 std::function<void(const std::unordered_map<uint16_t, uint64_t>&)> IConnection::MakeSettingsHandler() {
     std::weak_ptr<IConnection> weak_self = weak_from_this();
     return [weak_self](const std::unordered_map<uint16_t, uint64_t>& settings) {
@@ -200,6 +200,11 @@ protected:
     // through a weak_ptr<IConnection>. Safe to bind into stream callbacks.
     std::function<void(uint64_t, uint32_t)> MakeErrorHandler();
 
+    // Build a reader of the QUIC connection's statistics for the requests
+    // of this connection. Holds the QUIC connection through a weak_ptr, so
+    // a request kept by the application does not keep it alive.
+    std::function<bool(QuicConnectionStats&)> MakeStatsProvider();
+
     // Build a settings handler that forwards to IConnection::HandleSettings
     // through a weak_ptr<IConnection>.
     std::function<void(const std::unordered_map<uint16_t, uint64_t>&)> MakeSettingsHandler();
@@ -1,6 +1,7 @@
 #ifndef HTTP3_HTTP_REQUEST
 #define HTTP3_HTTP_REQUEST
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -69,6 +70,14 @@ public:
     }
     virtual const std::unordered_map<std::string, std::string>& GetPathParams() const override { return path_params_; }
 
+    // Connection statistics (set by the stream carrying the request)
+    void SetConnectionStatsProvider(const std::function<bool(QuicConnectionStats&)>& provider) {
+        stats_provider_ = provider;
+    }
+    virtual bool GetConnectionStats(QuicConnectionStats& stats) const override {
+        return stats_provider_ && stats_provider_(stats);
+    }
+
 private:
     HttpMethod method_;
     std::string path_;
@@ -83,6 +92,7 @@ private:
 
     std::unordered_map<std::string, std::string> query_params_;  // Parsed from ?key=value
     std::unordered_map<std::string, std::string> path_params_;   // Extracted from /users/:id pattern
+    std::function<bool(QuicConnectionStats&)> stats_provider_;   // Reads the QUIC connection's snapshot
 };
 
 }  // namespace http3
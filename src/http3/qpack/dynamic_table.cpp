@@ -1,10 +1,30 @@
+#include <cstring>
+#include <algorithm>
+#include <functional>
 #include "http3/qpack/dynamic_table.h"
 
 namespace quicx {
 namespace http3 {
 
-DynamicTable::DynamicTable(uint32_t max_size) : max_size_(max_size), current_size_(0), total_insert_count_(0) {
+static uint32_t HashName(const std::string& name) {
+    return static_cast<uint32_t>(std::hash<std::string>{}(name));
+}
+
+static uint32_t HashField(uint32_t name_hash, const std::string& value) {
+    // boost::hash_combine
+    uint32_t value_hash = static_cast<uint32_t>(std::hash<std::string>{}(value));
+    return name_hash ^ (value_hash + 0x9e3779b9u + (name_hash << 6) + (name_hash >> 2));
+}
 
+DynamicTable::DynamicTable(uint32_t max_size):
+    arena_head_(0),
+    entry_tail_(0),
+    entry_count_(0),
+    index_mask_(0),
+    max_size_(max_size),
+    current_size_(0),
+    total_insert_count_(0) {
+    Rebuild();
 }
 
 DynamicTable::~DynamicTable() {
@@ -13,8 +33,8 @@ DynamicTable::~DynamicTable() {
 
 bool DynamicTable::AddHeaderItem(const std::string& name, const std::string& value) {
     // Allow duplicate entries per QPACK (Duplicate instruction). Do not de-duplicate by name/value.
-    uint32_t entry_size = CalculateEntrySize(name, value);
-    
+    uint32_t entry_size = CalculateEntrySize(static_cast<uint32_t>(name.length()), static_cast<uint32_t>(value.length()));
+
     // Check if new entry would exceed max size
     if (entry_size > max_size_) {
         return false;
@@ -25,145 +45,269 @@ bool DynamicTable::AddHeaderItem(const std::string& name, const std::string& val
         EvictEntries();
     }
 
-    // Incremental index update: shift all existing indices by +1
-    // since we push_front and indices are relative positions in deque
-    for (auto& kv : headeritem_index_map_) {
-        kv.second += 1;
-    }
+    // The 32 bytes of overhead per entry guarantee the arena has room for the
+    // bytes of all entries that fit max_size_, so writing never overtakes the tail
+    Entry& entry = entries_[(entry_tail_ + entry_count_) % entries_.size()];
+    entry.offset_ = ArenaWrite(name);
+    ArenaWrite(value);
+    entry.name_len_ = static_cast<uint32_t>(name.length());
+    entry.value_len_ = static_cast<uint32_t>(value.length());
+    entry.name_hash_ = HashName(name);
+    entry.field_hash_ = HashField(entry.name_hash_, value);
 
-    // Add new entry at front (newest) with index 0
-    headeritem_deque_.push_front(HeaderItem(name, value));
+    entry_count_++;
     current_size_ += entry_size;
-    total_insert_count_++;
-
-    // Insert (or update) the new entry's index to 0
-    headeritem_index_map_[{name, value}] = 0;
+    uint64_t absolute_index = total_insert_count_++;
 
+    // The new entry is now the newest match for its name and for its name+value
+    IndexInsert(field_index_, entry.field_hash_, absolute_index, name, &value);
+    IndexInsert(name_index_, entry.name_hash_, absolute_index, name, nullptr);
     return true;
 }
 
-HeaderItem* DynamicTable::FindHeaderItem(uint32_t index) {
-    if (index < headeritem_deque_.size()) {
-        return &headeritem_deque_[index];
+bool DynamicTable::FindHeaderItem(uint32_t index, HeaderItem& item) const {
+    if (index >= entry_count_) {
+        return false;
     }
-    return nullptr;
+    return FindHeaderItemByAbsoluteIndex(total_insert_count_ - 1 - index, item);
 }
 
-int32_t DynamicTable::FindHeaderItemIndex(const std::string& name, const std::string& value) {
-    auto iter = headeritem_index_map_.find({name, value});
-    if (iter != headeritem_index_map_.end()) {
-        return iter->second;
+bool DynamicTable::FindHeaderItemByAbsoluteIndex(uint64_t absolute_index, HeaderItem& item) const {
+    const Entry* entry = GetEntry(absolute_index);
+    if (!entry) {
+        return false;
     }
-    return -1;
+    ArenaRead(entry->offset_, entry->name_len_, item.name_);
+    ArenaRead(static_cast<uint32_t>((entry->offset_ + entry->name_len_) % arena_.size()), entry->value_len_,
+        item.value_);
+    return true;
 }
 
-HeaderItem* DynamicTable::FindHeaderItemByAbsoluteIndex(uint64_t absolute_index) {
-    // BUGFIX P1-1: Correct absolute-to-deque conversion.
-    // absolute_index = total_insert_count_ - 1 - deque_position  (at insertion time)
-    // But after evictions, the deque shrinks from the back.
-    // evicted_count = total_insert_count_ - deque.size()
-    // deque_position = absolute_index - evicted_count
-    //                = absolute_index - (total_insert_count_ - deque.size())
-    uint64_t evicted_count = total_insert_count_ - headeritem_deque_.size();
-    if (absolute_index < evicted_count) {
-        return nullptr;  // Entry was evicted
-    }
-    // deque_position: newest entry has the highest absolute index and deque position 0
-    // absolute_index of front (newest) = total_insert_count_ - 1
-    // absolute_index of back (oldest)  = evicted_count
-    // deque_position = (total_insert_count_ - 1) - absolute_index
-    uint64_t deque_pos = (total_insert_count_ - 1) - absolute_index;
-    if (deque_pos >= headeritem_deque_.size()) {
-        return nullptr;
+bool DynamicTable::FindHeaderNameByAbsoluteIndex(uint64_t absolute_index, std::string& name) const {
+    const Entry* entry = GetEntry(absolute_index);
+    if (!entry) {
+        return false;
     }
-    return &headeritem_deque_[static_cast<size_t>(deque_pos)];
+    ArenaRead(entry->offset_, entry->name_len_, name);
+    return true;
 }
 
-int64_t DynamicTable::FindAbsoluteIndex(const std::string& name, const std::string& value) {
-    int32_t deque_pos = FindHeaderItemIndex(name, value);
-    if (deque_pos < 0) {
+int32_t DynamicTable::FindHeaderItemIndex(const std::string& name, const std::string& value) const {
+    int64_t absolute_index = FindAbsoluteIndex(name, value);
+    if (absolute_index < 0) {
         return -1;
     }
-    // absolute_index = total_insert_count_ - 1 - deque_position
-    return static_cast<int64_t>(total_insert_count_) - 1 - deque_pos;
+    // relative position = total_insert_count_ - 1 - absolute_index
+    return static_cast<int32_t>(static_cast<int64_t>(total_insert_count_) - 1 - absolute_index);
 }
 
-int32_t DynamicTable::FindHeaderNameIndex(const std::string& name) {
-    for (uint32_t i = 0; i < headeritem_deque_.size(); ++i) {
-        if (headeritem_deque_[i].name_ == name) return static_cast<int32_t>(i);
-    }
-    return -1;
+int64_t DynamicTable::FindAbsoluteIndex(const std::string& name, const std::string& value) const {
+    return IndexFind(field_index_, HashField(HashName(name), value), name, &value);
 }
 
-int64_t DynamicTable::FindAbsoluteNameIndex(const std::string& name) {
-    int32_t deque_pos = FindHeaderNameIndex(name);
-    if (deque_pos < 0) {
+int32_t DynamicTable::FindHeaderNameIndex(const std::string& name) const {
+    int64_t absolute_index = FindAbsoluteNameIndex(name);
+    if (absolute_index < 0) {
         return -1;
     }
-    return static_cast<int64_t>(total_insert_count_) - 1 - deque_pos;
+    return static_cast<int32_t>(static_cast<int64_t>(total_insert_count_) - 1 - absolute_index);
+}
+
+int64_t DynamicTable::FindAbsoluteNameIndex(const std::string& name) const {
+    return IndexFind(name_index_, HashName(name), name, nullptr);
 }
 
 void DynamicTable::EvictEntries() {
-    if (headeritem_deque_.empty()) {
+    if (entry_count_ == 0) {
         return;
     }
 
-    // Remove oldest entry (back of deque)
-    const HeaderItem& item = headeritem_deque_.back();
-    uint32_t evicted_index = static_cast<uint32_t>(headeritem_deque_.size() - 1);
+    // Remove oldest entry. Its bytes are simply left behind in the arena: the
+    // next entry's offset is the new tail.
+    const Entry& entry = entries_[entry_tail_];
+    uint64_t absolute_index = total_insert_count_ - entry_count_;
 
-    // Incremental index update: only remove the evicted entry from the map
-    // if the map entry points to the evicted index (it could point to a newer duplicate)
-    auto it = headeritem_index_map_.find({item.name_, item.value_});
-    if (it != headeritem_index_map_.end() && it->second == evicted_index) {
-        headeritem_index_map_.erase(it);
-    }
+    // Only drop index slots still pointing to the evicted entry (they may point to a newer duplicate)
+    IndexErase(field_index_, entry.field_hash_, absolute_index);
+    IndexErase(name_index_, entry.name_hash_, absolute_index);
 
-    current_size_ -= CalculateEntrySize(item.name_, item.value_);
-    headeritem_deque_.pop_back();
+    current_size_ -= CalculateEntrySize(entry.name_len_, entry.value_len_);
+    entry_tail_ = (entry_tail_ + 1) % entries_.size();
+    entry_count_--;
+    if (entry_count_ == 0) {
+        arena_head_ = 0;
+    }
 }
 
 void DynamicTable::UpdateMaxTableSize(uint32_t new_size) {
     // RFC 9204 Section 3.2.3: Dynamic Table Capacity
-    // The decoder MUST treat a new maximum size value that exceeds the limit 
+    // The decoder MUST treat a new maximum size value that exceeds the limit
     // set by SETTINGS_QPACK_MAX_TABLE_CAPACITY as a connection error
-    
+
     // Note: This check should be done at a higher level (connection) where
     // SETTINGS_QPACK_MAX_TABLE_CAPACITY is known. Here we just update the size.
     // The caller is responsible for validating against the setting.
-    
+    if (new_size == max_size_) {
+        return;
+    }
+
     max_size_ = new_size;
-    
+
     // Evict entries if current size exceeds new max size
     while (current_size_ > max_size_) {
         EvictEntries();
     }
+    Rebuild();
 }
 
 bool DynamicTable::DuplicateEntry(uint32_t absolute_index) {
     // RFC 9204 Section 4.3.4: Duplicate instruction
     // Duplicates an existing dynamic table entry by its absolute index
-    // Uses FindHeaderItemByAbsoluteIndex for correct absolute→deque conversion
-    
-    HeaderItem* item = FindHeaderItemByAbsoluteIndex(static_cast<uint64_t>(absolute_index));
-    if (!item) {
+
+    // Copy name and value out BEFORE calling AddHeaderItem, because AddHeaderItem
+    // may evict the entry we're duplicating and reuse its arena bytes.
+    HeaderItem item;
+    if (!FindHeaderItemByAbsoluteIndex(static_cast<uint64_t>(absolute_index), item)) {
         return false; // Invalid or evicted entry
     }
-    
-    // Copy name and value BEFORE calling AddHeaderItem, because AddHeaderItem
-    // may call EvictEntries which could pop_back the entry we're referencing,
-    // causing a dangling reference.
-    std::string name = item->name_;
-    std::string value = item->value_;
-    
-    return AddHeaderItem(name, value);
+    return AddHeaderItem(item.name_, item.value_);
+}
+
+const DynamicTable::Entry* DynamicTable::GetEntry(uint64_t absolute_index) const {
+    // absolute index of the oldest entry = number of evicted entries
+    uint64_t evicted_count = total_insert_count_ - entry_count_;
+    if (absolute_index < evicted_count || absolute_index >= total_insert_count_) {
+        return nullptr;
+    }
+    return &entries_[(entry_tail_ + (absolute_index - evicted_count)) % entries_.size()];
+}
+
+void DynamicTable::Rebuild() {
+    // Only on capacity changes: copy the live entries out and insert them again
+    std::vector<HeaderItem> live;
+    live.reserve(entry_count_);
+    uint64_t evicted_count = total_insert_count_ - entry_count_;
+    for (uint64_t i = evicted_count; i < total_insert_count_; i++) {
+        live.emplace_back();
+        FindHeaderItemByAbsoluteIndex(i, live.back());
+    }
+
+    arena_.assign(max_size_, 0);
+    arena_head_ = 0;
+    // every entry takes at least its 32 bytes of overhead
+    entries_.assign(std::max<uint32_t>(max_size_ / 32, 1), Entry());
+    entry_tail_ = 0;
+    entry_count_ = 0;
+
+    // keep the indexes at most half full
+    uint32_t index_size = 4;
+    while (index_size < entries_.size() * 2) {
+        index_size <<= 1;
+    }
+    field_index_.assign(index_size, IndexSlot());
+    name_index_.assign(index_size, IndexSlot());
+    index_mask_ = index_size - 1;
+
+    current_size_ = 0;
+    total_insert_count_ = evicted_count;
+    for (const auto& item : live) {
+        AddHeaderItem(item.name_, item.value_);
+    }
+}
+
+uint32_t DynamicTable::ArenaWrite(const std::string& data) {
+    uint32_t offset = arena_head_;
+    uint32_t len = static_cast<uint32_t>(data.length());
+    uint32_t first = std::min<uint32_t>(len, static_cast<uint32_t>(arena_.size()) - offset);
+    memcpy(arena_.data() + offset, data.data(), first);
+    memcpy(arena_.data(), data.data() + first, len - first);
+    arena_head_ = static_cast<uint32_t>((offset + len) % arena_.size());
+    return offset;
+}
+
+void DynamicTable::ArenaRead(uint32_t offset, uint32_t len, std::string& out) const {
+    uint32_t first = std::min<uint32_t>(len, static_cast<uint32_t>(arena_.size()) - offset);
+    out.assign(reinterpret_cast<const char*>(arena_.data()) + offset, first);
+    out.append(reinterpret_cast<const char*>(arena_.data()), len - first);
+}
+
+bool DynamicTable::ArenaEquals(uint32_t offset, const std::string& data) const {
+    uint32_t len = static_cast<uint32_t>(data.length());
+    uint32_t first = std::min<uint32_t>(len, static_cast<uint32_t>(arena_.size()) - offset);
+    return memcmp(arena_.data() + offset, data.data(), first) == 0 &&
+           memcmp(arena_.data(), data.data() + first, len - first) == 0;
+}
+
+bool DynamicTable::NameEquals(const Entry& entry, const std::string& name) const {
+    return entry.name_len_ == name.length() && ArenaEquals(entry.offset_, name);
+}
+
+bool DynamicTable::FieldEquals(const Entry& entry, const std::string& name, const std::string& value) const {
+    return entry.value_len_ == value.length() && NameEquals(entry, name) &&
+           ArenaEquals(static_cast<uint32_t>((entry.offset_ + entry.name_len_) % arena_.size()), value);
+}
+
+int64_t DynamicTable::IndexFind(const std::vector<IndexSlot>& index, uint32_t hash, const std::string& name,
+    const std::string* value) const {
+    // linear probing; the index is never more than half full, so an empty slot ends the run
+    for (uint32_t pos = hash & index_mask_; index[pos].absolute_ != 0; pos = (pos + 1) & index_mask_) {
+        const IndexSlot& slot = index[pos];
+        if (slot.hash_ != hash) {
+            continue;
+        }
+        const Entry* entry = GetEntry(slot.absolute_ - 1);
+        if (entry && (value ? FieldEquals(*entry, name, *value) : NameEquals(*entry, name))) {
+            return static_cast<int64_t>(slot.absolute_ - 1);
+        }
+    }
+    return -1;
+}
+
+void DynamicTable::IndexInsert(std::vector<IndexSlot>& index, uint32_t hash, uint64_t absolute_index,
+    const std::string& name, const std::string* value) {
+    uint32_t pos = hash & index_mask_;
+    for (; index[pos].absolute_ != 0; pos = (pos + 1) & index_mask_) {
+        IndexSlot& slot = index[pos];
+        if (slot.hash_ != hash) {
+            continue;
+        }
+        const Entry* entry = GetEntry(slot.absolute_ - 1);
+        if (entry && (value ? FieldEquals(*entry, name, *value) : NameEquals(*entry, name))) {
+            // an older entry with the same key: point to the newer one
+            slot.absolute_ = absolute_index + 1;
+            return;
+        }
+    }
+    index[pos].hash_ = hash;
+    index[pos].absolute_ = absolute_index + 1;
+}
+
+void DynamicTable::IndexErase(std::vector<IndexSlot>& index, uint32_t hash, uint64_t absolute_index) {
+    uint32_t pos = hash & index_mask_;
+    for (; index[pos].absolute_ != absolute_index + 1; pos = (pos + 1) & index_mask_) {
+        if (index[pos].absolute_ == 0) {
+            return;
+        }
+    }
+
+    // backward shift deletion: pull later slots of the run into the hole
+    // unless their home position lies cyclically after the hole
+    uint32_t hole = pos;
+    for (uint32_t next = (hole + 1) & index_mask_; index[next].absolute_ != 0; next = (next + 1) & index_mask_) {
+        uint32_t home = index[next].hash_ & index_mask_;
+        if (((next - home) & index_mask_) >= ((next - hole) & index_mask_)) {
+            index[hole] = index[next];
+            hole = next;
+        }
+    }
+    index[hole] = IndexSlot();
 }
 
-uint32_t DynamicTable::CalculateEntrySize(const std::string& name, const std::string& value) {
+uint32_t DynamicTable::CalculateEntrySize(uint32_t name_len, uint32_t value_len) {
     // Per RFC 7541 Section 4.1:
     // The size of an entry is the sum of its name's length in bytes, its value's
     // length in bytes, and 32 bytes (for overhead)
-    return name.length() + value.length() + 32;
+    return name_len + value_len + 32;
 }
 
 }
@@ -1,48 +1,63 @@
 #ifndef HTTP3_QPACK_DYNAMIC_TABLE
 #define HTTP3_QPACK_DYNAMIC_TABLE
 
-#include <deque>
-#include <utility>
+#include <vector>
+#include <string>
 #include <cstdint>
-#include <unordered_map>
 #include "http3/qpack/type.h"
-#include "http3/qpack/util.h"
 
 namespace quicx {
 namespace http3 {
 
+/**
+ * @brief QPACK dynamic table (RFC 9204 §3.2)
+ *
+ * Names and values live back to back in one circular byte arena of exactly
+ * the table capacity; an entry only records where its bytes start. Since every
+ * entry also counts 32 bytes of overhead, the bytes of the live entries always
+ * fit. Entries themselves sit in a ring sized for the most entries the
+ * capacity allows, so inserting appends at the head and evicting only advances
+ * the tail, without allocating.
+ *
+ * Two open addressing indexes (name+value and name only) map hashes computed
+ * once per insert or lookup to the absolute index of the newest matching entry.
+ */
 class DynamicTable {
 public:
     DynamicTable(uint32_t max_size);
     virtual ~DynamicTable();
 
     // Add a new header item to dynamic table
-    // Returns the index of the added item, or -1 if failed
+    // Returns false if the entry alone exceeds max_size_
     bool AddHeaderItem(const std::string& name, const std::string& value);
 
-    // Get header item by deque position (0 = newest). Used internally.
-    HeaderItem* FindHeaderItem(uint32_t index);
+    // Copy out the header item at relative position (0 = newest).
+    // Returns false if there is no such entry.
+    bool FindHeaderItem(uint32_t index, HeaderItem& item) const;
 
-    // Get header item by absolute index (RFC 9204 §3.2.4).
+    // Copy out the header item at absolute index (RFC 9204 §3.2.4).
     // Absolute index = total_insert_count at insertion time - 1.
-    // Converts to deque position internally.
-    HeaderItem* FindHeaderItemByAbsoluteIndex(uint64_t absolute_index);
+    // Returns false if the entry was evicted or not inserted yet.
+    bool FindHeaderItemByAbsoluteIndex(uint64_t absolute_index, HeaderItem& item) const;
 
-    // Get header item deque position by name and value.
-    // Returns -1 if not found. NOTE: returns deque position, NOT absolute index.
-    int32_t FindHeaderItemIndex(const std::string& name, const std::string& value);
+    // Same as above but only copies the name (for literals with name reference).
+    bool FindHeaderNameByAbsoluteIndex(uint64_t absolute_index, std::string& name) const;
 
-    // Find absolute index (RFC 9204) by name and value.
-    // Returns -1 if not found. Absolute index = total_insert_count_ - 1 - deque_position.
-    int64_t FindAbsoluteIndex(const std::string& name, const std::string& value);
+    // Get header item relative position by name and value.
+    // Returns -1 if not found. NOTE: returns relative position, NOT absolute index.
+    int32_t FindHeaderItemIndex(const std::string& name, const std::string& value) const;
 
-    // Get header item index by name only (first match), returns deque position or -1
-    int32_t FindHeaderNameIndex(const std::string& name);
+    // Find absolute index (RFC 9204) of the newest entry with name and value.
+    // Returns -1 if not found.
+    int64_t FindAbsoluteIndex(const std::string& name, const std::string& value) const;
 
-    // Find absolute index by name only (first match), returns -1 if not found
-    int64_t FindAbsoluteNameIndex(const std::string& name);
+    // Get header item relative position by name only (newest match), or -1
+    int32_t FindHeaderNameIndex(const std::string& name) const;
 
-    // Evict entries to ensure table size doesn't exceed max_size_
+    // Find absolute index by name only (newest match), returns -1 if not found
+    int64_t FindAbsoluteNameIndex(const std::string& name) const;
+
+    // Evict the oldest entry
     void EvictEntries();
 
     // Get current size of dynamic table
@@ -51,25 +66,62 @@ public:
     // Get maximum allowed size of dynamic table
     uint32_t GetMaxTableSize() const { return max_size_; }
     // Get current entry count in table
-    uint32_t GetEntryCount() const { return static_cast<uint32_t>(headeritem_deque_.size()); }
+    uint32_t GetEntryCount() const { return entry_count_; }
 
     // Get total number of inserts (monotonically increasing, used for RIC encoding)
     uint64_t GetInsertCount() const { return total_insert_count_; }
 
-    // Update maximum size of dynamic table
+    // Update maximum size of dynamic table, evicting and re-laying out entries
     void UpdateMaxTableSize(uint32_t new_size);
-    
+
     // RFC 9204 Section 4.3.4: Duplicate an existing entry
     // Duplicates the entry at the given absolute index
     // Returns true if successful, false if index is invalid
     bool DuplicateEntry(uint32_t absolute_index);
 
 private:
-    // Calculate size of a header entry (per RFC 7541 Section 4.1)
-    uint32_t CalculateEntrySize(const std::string& name, const std::string& value);
+    struct Entry {
+        uint32_t offset_;     // start of the name in arena_, the value follows
+        uint32_t name_len_;
+        uint32_t value_len_;
+        uint32_t name_hash_;
+        uint32_t field_hash_; // name and value
+    };
+    struct IndexSlot {
+        uint32_t hash_;
+        uint64_t absolute_;   // absolute index + 1, 0 if the slot is empty
+    };
 
-    std::deque<HeaderItem> headeritem_deque_;  // Dynamic table entries (front=newest, back=oldest)
-    std::unordered_map<std::pair<std::string, std::string>, uint32_t, pair_hash> headeritem_index_map_;
+    // Calculate size of a header entry (per RFC 7541 Section 4.1)
+    static uint32_t CalculateEntrySize(uint32_t name_len, uint32_t value_len);
+
+    // Entry of a live absolute index, nullptr otherwise
+    const Entry* GetEntry(uint64_t absolute_index) const;
+    // Size the arena, entry ring and indexes for max_size_ and move the live entries over
+    void Rebuild();
+
+    uint32_t ArenaWrite(const std::string& data);
+    void ArenaRead(uint32_t offset, uint32_t len, std::string& out) const;
+    bool ArenaEquals(uint32_t offset, const std::string& data) const;
+    bool NameEquals(const Entry& entry, const std::string& name) const;
+    bool FieldEquals(const Entry& entry, const std::string& name, const std::string& value) const;
+
+    int64_t IndexFind(const std::vector<IndexSlot>& index, uint32_t hash, const std::string& name,
+        const std::string* value) const;
+    void IndexInsert(std::vector<IndexSlot>& index, uint32_t hash, uint64_t absolute_index, const std::string& name,
+        const std::string* value);
+    void IndexErase(std::vector<IndexSlot>& index, uint32_t hash, uint64_t absolute_index);
+
+    std::vector<uint8_t> arena_;        // circular, max_size_ bytes
+    uint32_t arena_head_;               // where the next entry's bytes go
+
+    std::vector<Entry> entries_;        // ring, one slot per entry max_size_ can hold
+    uint32_t entry_tail_;               // ring position of the oldest entry
+    uint32_t entry_count_;
+
+    std::vector<IndexSlot> field_index_;  // name+value hash -> newest absolute index
+    std::vector<IndexSlot> name_index_;   // name hash -> newest absolute index
+    uint32_t index_mask_;
 
     uint32_t max_size_;      // Maximum allowed size of dynamic table
     uint32_t current_size_;  // Current size of dynamic table
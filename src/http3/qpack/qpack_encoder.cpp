@@ -312,12 +312,12 @@ bool QpackEncoder::Decode(
                 LOG_ERROR("QpackEncoder::Decode: absolute index is less than 0. abs_index:%lld", abs_index);
                 return false;
             }
-            auto item = dynamic_table_.FindHeaderItemByAbsoluteIndex(static_cast<uint64_t>(abs_index));
-            if (!item) {
+            HeaderItem item;
+            if (!dynamic_table_.FindHeaderItemByAbsoluteIndex(static_cast<uint64_t>(abs_index), item)) {
                 LOG_ERROR("QpackEncoder::Decode: find header item failed. abs_index:%lld", abs_index);
                 return false;
             }
-            headers[item->name_] = item->value_;
+            headers[std::move(item.name_)] = std::move(item.value_);
 
         } else if ((first_byte & QpackHeaderPattern::kLiteralNameRefStaticMask) ==
                    QpackHeaderPattern::kLiteralNameRefStatic) {
@@ -353,8 +353,8 @@ bool QpackEncoder::Decode(
                 LOG_ERROR("QpackEncoder::Decode: absolute index is less than 0. abs_index:%lld", abs_index);
                 return false;
             }
-            auto item = dynamic_table_.FindHeaderItemByAbsoluteIndex(static_cast<uint64_t>(abs_index));
-            if (!item) {
+            std::string name;
+            if (!dynamic_table_.FindHeaderNameByAbsoluteIndex(static_cast<uint64_t>(abs_index), name)) {
                 LOG_ERROR("QpackEncoder::Decode: find header item failed. abs_index:%lld", abs_index);
                 return false;
             }
@@ -363,7 +363,7 @@ bool QpackEncoder::Decode(
                 LOG_ERROR("QpackEncoder::Decode: decode string failed. value:%s", value.c_str());
                 return false;
             }
-            headers[item->name_] = value;
+            headers[std::move(name)] = std::move(value);
 
         } else if ((first_byte & QpackHeaderPattern::kLiteralNoNameRefMask) == QpackHeaderPattern::kLiteralNoNameRef) {
             // RFC 9204 Section 4.5.6: Literal Field Line With Literal Name (001xxxxx)
@@ -424,17 +424,17 @@ bool QpackEncoder::Decode(
             // Upper bound is the monotonic insert count, not the post-eviction
             // deque size: a valid absolute index lives in [evicted_count,
             // insert_count); FindHeaderItemByAbsoluteIndex below catches the
-            // lower bound (returns nullptr on already-evicted entries).
+            // lower bound (returns false on already-evicted entries).
             if (abs_index < 0 || abs_index >= static_cast<int64_t>(dynamic_table_.GetInsertCount())) {
                 LOG_ERROR("QpackEncoder::Decode: absolute index is out of range. abs_index:%lld", abs_index);
                 return false;
             }
-            auto item = dynamic_table_.FindHeaderItemByAbsoluteIndex(static_cast<uint64_t>(abs_index));
-            if (!item) {
+            HeaderItem item;
+            if (!dynamic_table_.FindHeaderItemByAbsoluteIndex(static_cast<uint64_t>(abs_index), item)) {
                 LOG_ERROR("QpackEncoder::Decode: find header item failed. abs_index:%lld", abs_index);
                 return false;
             }
-            headers[item->name_] = item->value_;
+            headers[std::move(item.name_)] = std::move(item.value_);
 
         } else if ((first_byte & QpackHeaderPattern::kPostBaseLiteralNameRefMask) ==
                    QpackHeaderPattern::kPostBaseLiteralNameRef) {
@@ -454,8 +454,8 @@ bool QpackEncoder::Decode(
                 LOG_ERROR("QpackEncoder::Decode: absolute index is out of range. abs_index:%lld", abs_index);
                 return false;
             }
-            auto item = dynamic_table_.FindHeaderItemByAbsoluteIndex(static_cast<uint64_t>(abs_index));
-            if (!item) {
+            std::string name;
+            if (!dynamic_table_.FindHeaderNameByAbsoluteIndex(static_cast<uint64_t>(abs_index), name)) {
                 LOG_ERROR("QpackEncoder::Decode: find header item failed. abs_index:%lld", abs_index);
                 return false;
             }
@@ -464,7 +464,7 @@ bool QpackEncoder::Decode(
                 LOG_ERROR("QpackEncoder::Decode: decode string failed. value:%s", value.c_str());
                 return false;
             }
-            headers[item->name_] = value;
+            headers[std::move(name)] = std::move(value);
 
         } else {
             LOG_ERROR("QpackEncoder::Decode: unknown header pattern. first_byte:%d", first_byte);
@@ -670,13 +670,11 @@ bool QpackEncoder::DecodeEncoderInstructions(const std::shared_ptr<common::IBuff
                         "QpackEncoder::DecodeEncoderInstructions: absolute index is less than 0. abs:%lld", abs);
                     return false;
                 }
-                auto hi = dynamic_table_.FindHeaderItemByAbsoluteIndex(static_cast<uint64_t>(abs));
-                if (!hi) {
+                if (!dynamic_table_.FindHeaderNameByAbsoluteIndex(static_cast<uint64_t>(abs), name)) {
                     LOG_ERROR(
                         "QpackEncoder::DecodeEncoderInstructions: find header item failed. abs:%lld", abs);
                     return false;
                 }
-                name = hi->name_;
             }
             // RFC 9204 §3.2.3 / RFC 7541 §4.4: An Insert instruction whose
             // entry alone exceeds the dynamic table capacity is a protocol
@@ -9,6 +9,7 @@ namespace http3 {
 struct HeaderItem {
     std::string name_;
     std::string value_;
+    HeaderItem() {}
     HeaderItem(const std::string& name, const std::string& value) : name_(name), value_(value) {}
 };
 
@@ -51,7 +51,7 @@ bool ControlClientSenderStream::SendCancelPush(uint64_t push_id) {
         error_handler_(0, Http3ErrorCode::kInternalError);
         return false;
     }
-    return stream_->Send(buffer) > 0;
+    return stream_->Flush();
 }
 
 }  // namespace http3
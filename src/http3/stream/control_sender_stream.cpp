@@ -64,7 +64,16 @@ bool ControlSenderStream::SendQpackInstructions(const std::vector<uint8_t>& blob
     if (blob.empty()) {
         return true;
     }
-    return stream_->Send((uint8_t*)blob.data(), blob.size()) > 0;
+    // Through the send buffer rather than Send(): Send() may take only part
+    // of the blob once the send buffer watermarks are reached, which would
+    // cut an instruction in half. Control data is never refused.
+    auto buffer = std::dynamic_pointer_cast<common::IBuffer>(stream_->GetSendBuffer());
+    if (!buffer || buffer->Write(blob.data(), static_cast<uint32_t>(blob.size())) != blob.size()) {
+        LOG_ERROR("ControlSenderStream::SendQpackInstructions: Failed to buffer %zu bytes", blob.size());
+        error_handler_(stream_->GetStreamID(), Http3ErrorCode::kInternalError);
+        return false;
+    }
+    return stream_->Flush();
 }
 
 }
@@ -25,7 +25,14 @@ public:
                 const std::function<void(uint64_t stream_id, uint32_t error_code)>& error_handler):
                 IStream(stream_type, error_handler),
                 wrote_type_(false),
-                stream_(stream) {}
+                stream_(stream) {
+        // Control and QPACK streams carry what every request depends on
+        // (SETTINGS, dynamic table inserts and acks): never queue them
+        // behind request or push data (RFC 9218 urgency 0).
+        if (stream_ && stream_type != StreamType::kPush) {
+            stream_->SetPriority(0, false);
+        }
+    }
     virtual ~ISendStream() {}
 
     virtual uint64_t GetStreamID() override { return stream_->GetStreamID(); }
@@ -45,6 +45,11 @@ public:
     // Set qlog trace for HTTP/3 frame events
     void SetQlogTrace(std::shared_ptr<common::QlogTrace> trace);
 
+    // Set the source of IRequest::GetConnectionStats() for the request on this stream
+    void SetConnectionStatsProvider(const std::function<bool(QuicConnectionStats&)>& provider) {
+        stats_provider_ = provider;
+    }
+
     virtual void OnData(std::shared_ptr<IBufferRead> data, bool is_last, uint32_t error);
 
 protected:
@@ -118,6 +123,9 @@ protected:
     // Qlog trace for HTTP/3 frame events
     std::shared_ptr<common::QlogTrace> qlog_trace_;
 
+    // Transport statistics of the QUIC connection, handed to the request
+    std::function<bool(QuicConnectionStats&)> stats_provider_;
+
     // ------------------------------------------------------------------
     // QPACK head-of-line blocking buffer.
     //
@@ -5,6 +5,7 @@
 
 #include "http3/frame/push_promise_frame.h"
 #include "http3/http/error.h"
+#include "http3/http/request.h"
 #include "http3/http/response.h"
 #include "http3/stream/pseudo_header.h"
 #include "http3/stream/request_stream.h"
@@ -44,6 +45,11 @@ RequestStream::~RequestStream() {
 bool RequestStream::SendRequest(std::shared_ptr<IRequest> request) {
     PseudoHeader::Instance().EncodeRequest(request);
 
+    auto impl = std::dynamic_pointer_cast<Request>(request);
+    if (impl && stats_provider_) {
+        impl->SetConnectionStatsProvider(stats_provider_);
+    }
+
     // Check if using streaming mode for request body sending
     auto body_provider = request->GetRequestBodyProvider();
 
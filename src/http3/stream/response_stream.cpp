@@ -149,6 +149,9 @@ void ResponseStream::HandleHeaders() {
     response_ = std::make_shared<Response>();
 
     request_->SetHeaders(headers_);
+    if (stats_provider_) {
+        request_->SetConnectionStatsProvider(stats_provider_);
+    }
 
     PseudoHeader::Instance().DecodeRequest(request_);
 
@@ -37,6 +37,15 @@ const uint8_t kHeaderProtectLength = 5;
 // initial datagrams.
 constexpr uint16_t kMinInitialPacketSize = 1200;
 
+// RFC 8899 DPLPMTUD (see PmtuProber): the PLPMTU a connection assumes until
+// the handshake is confirmed and the search starts. Unverified, so black-hole
+// detection falls back to kMinInitialPacketSize (BASE_PLPMTU) if the path
+// does not carry it.
+constexpr uint16_t kDefaultPlpmtu = kMaxV4PacketSize;
+// Largest PLPMTU the search goes up to, for 9000-byte jumbo-frame links
+// (the peer's max_udp_payload_size may lower it).
+constexpr uint16_t kMaxPlpmtu = 9000;
+
 // RFC 9000 §8.2.4: An endpoint SHOULD abandon path validation based on
 // timer. The timer SHOULD be at least three times the current PTO. We use a
 // fixed 6 s default that is comfortably above 3×PTO for typical Internet
@@ -37,14 +37,21 @@ static constexpr uint64_t kDataBlockedThreshold = 16384;
 // Used in: send_flow_controller.h
 static constexpr uint64_t kStreamsBlockedThreshold = 4;
 
-// Bytes remaining before sending MAX_DATA to increase peer's send limit
-// Used in: recv_flow_controller.h
-static constexpr uint64_t kDataIncreaseThreshold = 512 * 1024;  // 512KB
-
-// Amount to increase connection-level data limit in MAX_DATA frame (RFC 9000 Section 4.2)
-// 2MB provides ample headroom for high-throughput transfers
-// Used in: recv_flow_controller.h
-static constexpr uint64_t kDataIncreaseAmount = 2 * 1024 * 1024;  // 2MB
+// Receive windows start at the initial_max_data / initial_max_stream_data
+// transport parameters and double while the application drains them within
+// this many smoothed RTTs (RFC 9000 Section 4.2 leaves the strategy open)
+// Used in: recv_window_tuner.cpp
+static constexpr uint32_t kWindowAutoTuneRttMultiple = 2;
+
+// Largest connection-level receive window (MAX_DATA credit beyond what the
+// application consumed). This is the per-connection receive memory budget.
+// Used in: recv_flow_controller.cpp
+static constexpr uint64_t kMaxConnectionWindowSize = 24 * 1024 * 1024;  // 24MB
+
+// Total window growth all connections of the process may hold together.
+// Once spent, windows stay at their current size until others shrink
+// Used in: recv_window_tuner.cpp
+static constexpr uint64_t kRecvWindowGlobalBudget = 1024ull * 1024 * 1024;  // 1GB
 
 // Streams remaining before proactively sending MAX_STREAMS
 // Used in: recv_flow_controller.h
@@ -69,41 +76,20 @@ static constexpr uint32_t kMaxAckDelay = 25;
 // Used in: send_stream.cpp
 static constexpr uint64_t kStreamDataBlockedThreshold = 4096;
 
-// Amount to increase stream-level receive window in MAX_STREAM_DATA frame
-// 2MB aligns with connection-level window increment
-// Used in: recv_stream.cpp
-static constexpr uint64_t kStreamWindowIncrement = 2 * 1024 * 1024;  // 2MB
-
-// Amount to increase stream window when peer sends STREAM_DATA_BLOCKED
-// 4MB provides burst capacity for large file transfers
-// Used in: recv_stream.cpp
-static constexpr uint64_t kBlockedWindowIncrement = 4 * 1024 * 1024;  // 4MB
-
-// Maximum stream-level receive window size (hard upper limit)
-// Prevents malicious peers from inflating window indefinitely via BLOCKED frames
-// Used in: recv_stream.cpp
-static constexpr uint64_t kMaxStreamWindowSize = 64 * 1024 * 1024;  // 64MB
-
-// Maximum number of out-of-order frames buffered per stream
-// Prevents OOM from malicious peers sending many different-offset frames
+// Largest stream-level receive window (hard upper limit). Windows only grow
+// when the application keeps up, never because the peer says it is blocked
 // Used in: recv_stream.cpp
-static constexpr size_t kMaxOutOfOrderFrames = 1024;
+static constexpr uint64_t kMaxStreamWindowSize = 16 * 1024 * 1024;  // 16MB
 
-// ============================================================================
-// Congestion Control Configuration
-// ============================================================================
+// Maximum number of disjoint out-of-order ranges buffered per stream or
+// crypto level. Prevents peers from fragmenting the reassembly buffer
+// Used in: reassembly_buffer.cpp
+static constexpr size_t kMaxReassemblyRanges = 1024;
 
-// Congestion control algorithm selection.
-// Available options:
-//   "reno"   - NewReno (default, conservative, good baseline)
-//   "cubic"  - CUBIC (Linux default, better throughput on high-BDP paths)
-//   "bbrv1"  - BBR v1 (Google's bandwidth-based CC)
-//   "bbrv2"  - BBR v2 (improved fairness and loss handling)
-//   "bbrv3"  - BBR v3 (latest, improved ProbeRTT and loss tolerance)
-//
-// Change this value and rebuild to quickly switch CC algorithm for benchmarking.
-// No environment variable needed — just modify, make, and run.
-static constexpr const char* kDefaultCongestionControl = "cubic";
+// How far past the next expected offset CRYPTO data may land per encryption
+// level (RFC 9000 Section 7.5 requires at least 4096 bytes)
+// Used in: crypto_stream.cpp
+static constexpr uint64_t kMaxCryptoReassemblyBytes = 64 * 1024;  // 64KB
 
 // ============================================================================
 // TLS/Crypto Configuration
@@ -136,7 +122,8 @@ static constexpr uint32_t kRetryCidLength = 8;
 static constexpr uint32_t kPacketPoolSize = 256;
 
 // Individual packet buffer size (bytes)
-// 1500 bytes matches typical Ethernet MTU
+// 1500 bytes matches typical Ethernet MTU. A max_udp_payload_size above it
+// makes the receivers read into kMaxPlpmtu blocks of the jumbo pool instead.
 static constexpr uint32_t kPacketBufferSize = 1500;
 
 // Number of blocks in packet pool allocator
@@ -149,7 +136,7 @@ static constexpr uint32_t kPacketPoolBlockCount = 64;
 
 // Socket-drain batch ceiling for UdpReceiver::OnRead.
 // Trades latency-per-wakeup against ACK aggregation:
-//   - Too small  → ACK aggregation defeated (wait_ack_packet_numbers_ never
+//   - Too small  → ACK aggregation defeated (RecvControl pending ACKs never
 //                  accumulates beyond 1 entry, kAckThreshold branch is rarely
 //                  hit, ACKs flow ~1:1 with data packets).
 //   - Too large  → starves co-resident timers/write events that share this
@@ -187,6 +174,39 @@ static constexpr int kMaxPacketsPerRound = 128;
 // Used in: connection/controler/recv_control.cpp
 static constexpr size_t kAckThreshold = 10;
 
+// Upper bound on the number of disjoint packet-number ranges RecvControl
+// remembers per packet number space, which is also the most ranges a single
+// ACK frame carries (~64 * 16 bytes = 1KB worst case, fits in one MTU).
+// Ranges are dropped once a packet carrying an ACK that covered them is
+// itself acknowledged (RFC 9000 §13.2.4); when the history is full the
+// oldest range is forgotten first.
+// Used in: connection/controler/ack_range_set.h
+static constexpr size_t kMaxAckRanges = 64;
+
+// draft-ietf-quic-ack-frequency sender policy. Once the congestion window
+// holds at least kAckFrequencyMinCwndPackets full-sized packets we ask the
+// peer (if it advertised min_ack_delay) to acknowledge only about
+// kAckFrequencyAcksPerCwnd times per window, never less often than every
+// kMaxAckElicitingThreshold packets. A smaller window keeps the peer's
+// default ACK rate: frequent ACKs matter most for slow start and loss
+// recovery, and cost least when the window is small.
+// Used in: connection/controler/ack_frequency_controller.cpp
+static constexpr uint64_t kAckFrequencyMinCwndPackets = 64;
+static constexpr uint64_t kAckFrequencyAcksPerCwnd = 8;
+static constexpr uint64_t kMaxAckElicitingThreshold = 64;
+
+// Reordering threshold requested in ACK_FREQUENCY frames. Matches the
+// RFC 9002 §6.1.1 packet threshold our loss detection uses, so the peer only
+// rushes an ACK for a gap that we would declare lost anyway.
+// Used in: connection/controler/ack_frequency_controller.cpp
+static constexpr uint64_t kAckFrequencyReorderingThreshold = 3;
+
+// RFC 9221: DATAGRAM frames waiting for the congestion window. A datagram
+// pushed onto a full queue is rejected; stale ones are dropped on their TTL
+// rather than queued forever, since late unreliable data is rarely useful.
+// Used in: connection/controler/datagram_queue.cpp
+static constexpr size_t kMaxDatagramQueueSize = 256;
+
 }  // namespace quic
 }  // namespace quicx
 
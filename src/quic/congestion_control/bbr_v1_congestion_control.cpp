@@ -84,61 +84,47 @@ void BBRv1CongestionControl::OnPacketSent(const SentPacketEvent& ev) {
 }
 
 void BBRv1CongestionControl::OnPacketAcked(const AckEvent& ev) {
-    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
+    OnCongestionEvent({ev}, {}, bytes_in_flight_, ev.ack_time);
+}
 
-    // ECN-CE: reduce pacing gain slightly and cap cwnd to BDP to react to congestion
-    if (ev.ecn_ce) {
-        // Reduce pacing a bit for this round
-        pacing_gain_ = std::max<double>(1.0, pacing_gain_ * 0.95);
-        uint64_t target = BdpBytes(static_cast<uint64_t>(cwnd_gain_ * 1000), 1000);
-        cwnd_bytes_ = std::min<uint64_t>(cwnd_bytes_, target);
-        UpdatePacingRate();
-        return;
-    }
+void BBRv1CongestionControl::OnPacketLost(const LossEvent& ev) {
+    OnCongestionEvent({}, {ev}, bytes_in_flight_, ev.lost_time);
+}
 
-    // Update min_rtt timestamp when min_rtt is updated (from OnRoundTripSample)
-    // This must be done after RTT sample is taken
-    if (min_rtt_stamp_us_ == 0 || srtt_us_ <= min_rtt_us_) {
-        min_rtt_stamp_us_ = ev.ack_time;
+void BBRv1CongestionControl::OnCongestionEvent(const std::vector<AckEvent>& acked,
+    const std::vector<LossEvent>& lost, uint64_t prior_in_flight, uint64_t event_time) {
+    (void)prior_in_flight;
+    for (const auto& ev : lost) {
+        bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_lost) ? bytes_in_flight_ - ev.bytes_lost : 0;
+    }
+    if (!lost.empty()) {
+        ExitStartupOnLoss();
     }
 
-    // Aggregate bandwidth samples over at least one SRTT to avoid underestimation
-    if (srtt_us_ > 0) {
-        if (bw_sample_start_us_ == 0) {
-            bw_sample_start_us_ = ev.ack_time;
-            bw_sample_bytes_acc_ = ev.bytes_acked;
+    // The model is driven by the bytes one ACK frame delivered, not by how
+    // many packets carried them: sum them and update once.
+    bool ecn_ce = false;
+    bool delivered = false;
+    uint64_t bytes_acked = 0;
+    for (const auto& ev : acked) {
+        bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
+        if (ev.ecn_ce) {
+            ecn_ce = true;
         } else {
-            bw_sample_bytes_acc_ += ev.bytes_acked;
-            uint64_t elapsed = ev.ack_time - bw_sample_start_us_;
-            if (elapsed >= srtt_us_) {
-                uint64_t bytes_per_sec = MulDiv(bw_sample_bytes_acc_, 1000000ull, elapsed);
-                UpdateMaxBandwidth(bytes_per_sec, ev.ack_time);
-                bw_sample_start_us_ = ev.ack_time;
-                bw_sample_bytes_acc_ = 0;
-            }
+            delivered = true;
+            bytes_acked += ev.bytes_acked;
         }
     }
-
-    CheckFullBandwidthReached(ev.ack_time);
-    MaybeEnterOrExitProbeRtt(ev.ack_time);
-
-    // Update cwnd toward target but do not reduce cwnd on ACK
-    uint64_t target = BdpBytes(static_cast<uint64_t>(cwnd_gain_ * 1000), 1000);
-    if (cwnd_bytes_ < target) {
-        cwnd_bytes_ += ev.bytes_acked;
-        cwnd_bytes_ = std::min<uint64_t>(cwnd_bytes_, target);
-        cwnd_bytes_ = std::min<uint64_t>(cwnd_bytes_, cfg_.max_cwnd_bytes);
+    if (ecn_ce) {
+        ReactToEcnCe();
     }
-
-    // Advance ProbeBW cycle if needed
-    if (mode_ == Mode::kProbeBw) {
-        AdvanceProbeBwCycle(ev.ack_time);
+    if (delivered) {
+        UpdateModelOnAck(bytes_acked, event_time);
     }
     UpdatePacingRate();
 }
 
-void BBRv1CongestionControl::OnPacketLost(const LossEvent& ev) {
-    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_lost) ? bytes_in_flight_ - ev.bytes_lost : 0;
+void BBRv1CongestionControl::ExitStartupOnLoss() {
     // BBR-Draft-02 §4.1.2: STARTUP exits to DRAIN on any of {bandwidth
     // plateau (handled in CheckFullBandwidthReached), high in-flight, or
     // packet loss}. We use the loss signal as the secondary trigger so
@@ -157,7 +143,54 @@ void BBRv1CongestionControl::OnPacketLost(const LossEvent& ev) {
         pacing_gain_ = 1.0 / 2.885; // drain faster by pacing below bw
         cwnd_gain_ = 2.0;
     }
-    UpdatePacingRate();
+}
+
+void BBRv1CongestionControl::ReactToEcnCe() {
+    // ECN-CE: reduce pacing gain slightly and cap cwnd to BDP to react to congestion
+    pacing_gain_ = std::max<double>(1.0, pacing_gain_ * 0.95);
+    uint64_t target = BdpBytes(static_cast<uint64_t>(cwnd_gain_ * 1000), 1000);
+    cwnd_bytes_ = std::min<uint64_t>(cwnd_bytes_, target);
+}
+
+void BBRv1CongestionControl::UpdateModelOnAck(uint64_t bytes_acked, uint64_t now_us) {
+    // Update min_rtt timestamp when min_rtt is updated (from OnRoundTripSample)
+    // This must be done after RTT sample is taken
+    if (min_rtt_stamp_us_ == 0 || srtt_us_ <= min_rtt_us_) {
+        min_rtt_stamp_us_ = now_us;
+    }
+
+    // Aggregate bandwidth samples over at least one SRTT to avoid underestimation
+    if (srtt_us_ > 0) {
+        if (bw_sample_start_us_ == 0) {
+            bw_sample_start_us_ = now_us;
+            bw_sample_bytes_acc_ = bytes_acked;
+        } else {
+            bw_sample_bytes_acc_ += bytes_acked;
+            uint64_t elapsed = now_us - bw_sample_start_us_;
+            if (elapsed >= srtt_us_) {
+                uint64_t bytes_per_sec = MulDiv(bw_sample_bytes_acc_, 1000000ull, elapsed);
+                UpdateMaxBandwidth(bytes_per_sec, now_us);
+                bw_sample_start_us_ = now_us;
+                bw_sample_bytes_acc_ = 0;
+            }
+        }
+    }
+
+    CheckFullBandwidthReached(now_us);
+    MaybeEnterOrExitProbeRtt(now_us);
+
+    // Update cwnd toward target but do not reduce cwnd on ACK
+    uint64_t target = BdpBytes(static_cast<uint64_t>(cwnd_gain_ * 1000), 1000);
+    if (cwnd_bytes_ < target) {
+        cwnd_bytes_ += bytes_acked;
+        cwnd_bytes_ = std::min<uint64_t>(cwnd_bytes_, target);
+        cwnd_bytes_ = std::min<uint64_t>(cwnd_bytes_, cfg_.max_cwnd_bytes);
+    }
+
+    // Advance ProbeBW cycle if needed
+    if (mode_ == Mode::kProbeBw) {
+        AdvanceProbeBwCycle(now_us);
+    }
 }
 
 void BBRv1CongestionControl::OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay) {
@@ -169,7 +202,7 @@ void BBRv1CongestionControl::OnRoundTripSample(uint64_t latest_rtt, uint64_t ack
     if (srtt_us_ == 0) srtt_us_ = latest_rtt;
     srtt_us_ = (7 * srtt_us_ + latest_rtt) / 8;
     if (srtt_us_ == 0) srtt_us_ = 1;  // guard against EWMA rounding to zero
-    // Note: min_rtt timestamp is updated in OnPacketAcked where ack_time is available
+    // Note: min_rtt timestamp is updated in UpdateModelOnAck where ack_time is available
     if (min_rtt_us_ == 0 || latest_rtt < min_rtt_us_) {
         min_rtt_us_ = latest_rtt;
     }
@@ -350,6 +383,14 @@ void BBRv1CongestionControl::CheckFullBandwidthReached(uint64_t now_us) {
     }
 }
 
+bool BBRv1CongestionControl::SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) {
+    cwnd_bytes_ = std::min<uint64_t>(std::max<uint64_t>(cwnd_bytes, cfg_.min_cwnd_bytes), cfg_.max_cwnd_bytes);
+    ssthresh_bytes_ = ssthresh_bytes;
+    // The model keeps driving cwnd toward BDP × gain from here on.
+    UpdatePacingRate();
+    return true;
+}
+
 void BBRv1CongestionControl::SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) {
     qlog_trace_ = trace;
 }
@@ -21,6 +21,8 @@ public:
     void OnPacketSent(const SentPacketEvent& ev) override;
     void OnPacketAcked(const AckEvent& ev) override;
     void OnPacketLost(const LossEvent& ev) override;
+    void OnCongestionEvent(const std::vector<AckEvent>& acked, const std::vector<LossEvent>& lost,
+        uint64_t prior_in_flight, uint64_t event_time) override;
     void OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay = 0) override;
 
     SendState CanSend(uint64_t now, uint64_t& can_send_bytes) const override;
@@ -28,11 +30,13 @@ public:
     uint64_t GetCongestionWindow() const override { return cwnd_bytes_; }
     uint64_t GetBytesInFlight() const override { return bytes_in_flight_; }
     uint64_t GetPacingRateBytesPerSec() const override;
+    uint64_t GetBandwidthEstimate() const override { return max_bw_bps_; }
     uint64_t NextSendTime(uint64_t now) const override;
 
     bool InSlowStart() const override { return mode_ == Mode::kStartup; }
     bool InRecovery() const override { return false; }
     uint64_t GetSsthresh() const override { return ssthresh_bytes_; }
+    bool SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) override;
 
     void SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) override;
 
@@ -45,6 +49,9 @@ private:
     };
 
     // Helpers
+    void ExitStartupOnLoss();
+    void ReactToEcnCe();
+    void UpdateModelOnAck(uint64_t bytes_acked, uint64_t now_us);
     void MaybeEnterOrExitProbeRtt(uint64_t now_us);
     void AdvanceProbeBwCycle(uint64_t now_us);
     void UpdateMaxBandwidth(uint64_t sample_bps, uint64_t now_us);
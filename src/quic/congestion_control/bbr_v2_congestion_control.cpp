@@ -72,94 +72,123 @@ void BBRv2CongestionControl::OnPacketSent(const SentPacketEvent& ev) {
 }
 
 void BBRv2CongestionControl::OnPacketAcked(const AckEvent& ev) {
-    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
+    OnCongestionEvent({ev}, {}, bytes_in_flight_, ev.ack_time);
+}
+
+void BBRv2CongestionControl::OnPacketLost(const LossEvent& ev) {
+    OnCongestionEvent({}, {ev}, bytes_in_flight_, ev.lost_time);
+}
+
+void BBRv2CongestionControl::OnCongestionEvent(const std::vector<AckEvent>& acked,
+    const std::vector<LossEvent>& lost, uint64_t prior_in_flight, uint64_t event_time) {
+    (void)prior_in_flight;
+    for (const auto& ev : lost) {
+        bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_lost) ? bytes_in_flight_ - ev.bytes_lost : 0;
+    }
+    // A burst of packets declared lost together is one congestion event:
+    // inflight_hi is cut once, not once per packet.
+    if (!lost.empty()) {
+        OnLossEvent();
+    }
+
+    bool ecn_ce = false;
+    uint64_t bytes_acked = 0;
+    for (const auto& ev : acked) {
+        bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
+        bytes_acked += ev.bytes_acked;
+        ecn_ce = ecn_ce || ev.ecn_ce;
+    }
 
     // ECN-CE: similar to BBRv3 simple reaction, slightly tighten inflight_hi
     // [BBRv2-Slides] §"ECN response": ECN-CE is treated as a soft
     // congestion signal (RFC 8311 §4.2 / RFC 9000 §13.4). v2 reacts more
-    // gently than the loss path (5% trim here vs 30% in OnPacketLost),
+    // gently than the loss path (5% trim here vs 30% in OnLossEvent),
     // because ECN marks fire before any actual queue overflow.
-    if (ev.ecn_ce) {
+    if (ecn_ce) {
         inflight_hi_bytes_ = std::max<uint64_t>(inflight_lo_bytes_, (inflight_hi_bytes_ * 95) / 100); // -5%
     }
+    if (!acked.empty()) {
+        UpdateModelOnAck(bytes_acked, acked.size(), event_time);
+    }
+    if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
+}
+
+void BBRv2CongestionControl::OnLossEvent() {
+    loss_event_count_in_round_++;
+
+    // BBRv2: reduce hi bound on loss using multiplicative decrease (beta = 0.7)
+    // [BBRv2-Slides] §"Loss response": v2 trims inflight_hi by beta=0.7
+    // on loss instead of v1's binary STARTUP→DRAIN exit. This is the
+    // model-based analogue of Reno's beta=0.5 (RFC 9002 §7.3.2) and
+    // CUBIC's beta=0.7 (RFC 9438 §4.6) — same multiplicative-decrease
+    // shape, but applied to the *probe ceiling* rather than cwnd
+    // directly, so steady-state throughput is bounded by inflight_hi
+    // while cwnd_bytes_ continues to track BDP × gain.
+    inflight_hi_bytes_ = std::max<uint64_t>(inflight_lo_bytes_, (inflight_hi_bytes_ * 7) / 10);
+
+    if (mode_ == Mode::kStartup) {
+        {
+            common::CongestionStateUpdatedData qlog_data;
+            qlog_data.old_state = "slow_start";
+            qlog_data.new_state = "recovery";
+            QLOG_CONGESTION_STATE_UPDATED(qlog_trace_, qlog_data);
+        }
+        mode_ = Mode::kDrain;
+        pacing_gain_ = 1.0 / 2.885;
+        cwnd_gain_ = 2.0;
+    }
+}
 
+void BBRv2CongestionControl::UpdateModelOnAck(uint64_t bytes_acked, uint64_t packets_acked, uint64_t now_us) {
     // Update min_rtt timestamp when min_rtt is updated (from OnRoundTripSample)
     if (min_rtt_stamp_us_ == 0 || srtt_us_ <= min_rtt_us_) {
-        min_rtt_stamp_us_ = ev.ack_time;
+        min_rtt_stamp_us_ = now_us;
     }
 
     // Aggregate bandwidth over at least one SRTT to avoid underestimation
     if (srtt_us_ > 0) {
         if (bw_sample_start_us_ == 0) {
-            bw_sample_start_us_ = ev.ack_time;
-            bw_sample_bytes_acc_ = ev.bytes_acked;
+            bw_sample_start_us_ = now_us;
+            bw_sample_bytes_acc_ = bytes_acked;
         } else {
-            bw_sample_bytes_acc_ += ev.bytes_acked;
-            uint64_t elapsed = ev.ack_time - bw_sample_start_us_;
+            bw_sample_bytes_acc_ += bytes_acked;
+            uint64_t elapsed = now_us - bw_sample_start_us_;
             if (elapsed >= srtt_us_) {
                 uint64_t bytes_per_sec = MulDiv(bw_sample_bytes_acc_, 1000000ull, elapsed);
-                UpdateMaxBandwidth(bytes_per_sec, ev.ack_time);
-                bw_sample_start_us_ = ev.ack_time;
+                UpdateMaxBandwidth(bytes_per_sec, now_us);
+                bw_sample_start_us_ = now_us;
                 bw_sample_bytes_acc_ = 0;
             }
         }
     }
 
     // BBRv2: gradually increase inflight_hi when no loss
-    // Note: inflight_hi is reduced in OnPacketLost with beta=0.7
+    // Note: inflight_hi is reduced in OnLossEvent with beta=0.7
     // We should NOT reduce it again here to avoid double penalization
     if (loss_event_count_in_round_ > 0) {
-        // Reset counter but don't reduce inflight_hi (already done in OnPacketLost)
+        // Reset counter but don't reduce inflight_hi (already done in OnLossEvent)
         loss_event_count_in_round_ = 0;
     } else if (max_bw_bps_ > 0) {
-        // loosen hi by small step when no loss
-        inflight_hi_bytes_ = std::min<uint64_t>(inflight_hi_bytes_ + cfg_.mss_bytes, cfg_.max_cwnd_bytes);
+        // loosen hi by a small step per acknowledged packet when no loss
+        inflight_hi_bytes_ =
+            std::min<uint64_t>(inflight_hi_bytes_ + cfg_.mss_bytes * packets_acked, cfg_.max_cwnd_bytes);
     }
 
-    CheckStartupFullBandwidth(ev.ack_time);
-    MaybeEnterOrExitProbeRtt(ev.ack_time);
+    CheckStartupFullBandwidth(now_us);
+    MaybeEnterOrExitProbeRtt(now_us);
 
     // Target cwnd = min(hi, gain*BDP). Do not reduce cwnd on ACK.
     uint64_t bdp = BdpBytes(static_cast<uint64_t>(cwnd_gain_ * 1000), 1000);
     uint64_t target = std::min<uint64_t>(bdp, inflight_hi_bytes_);
     if (cwnd_bytes_ < target) {
-        cwnd_bytes_ += ev.bytes_acked;
+        cwnd_bytes_ += bytes_acked;
         cwnd_bytes_ = std::min<uint64_t>(cwnd_bytes_, target);
         cwnd_bytes_ = std::min<uint64_t>(cwnd_bytes_, cfg_.max_cwnd_bytes);
     }
 
     if (mode_ == Mode::kProbeBw) {
-        AdvanceProbeBwCycle(ev.ack_time);
-    }
-    if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
-}
-
-void BBRv2CongestionControl::OnPacketLost(const LossEvent& ev) {
-    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_lost) ? bytes_in_flight_ - ev.bytes_lost : 0;
-    loss_event_count_in_round_++;
-    
-    // BBRv2: reduce hi bound on loss using multiplicative decrease (beta = 0.7)
-    // [BBRv2-Slides] §"Loss response": v2 trims inflight_hi by beta=0.7
-    // on loss instead of v1's binary STARTUP→DRAIN exit. This is the
-    // model-based analogue of Reno's beta=0.5 (RFC 9002 §7.3.2) and
-    // CUBIC's beta=0.7 (RFC 9438 §4.6) — same multiplicative-decrease
-    // shape, but applied to the *probe ceiling* rather than cwnd
-    // directly, so steady-state throughput is bounded by inflight_hi
-    // while cwnd_bytes_ continues to track BDP × gain.
-    inflight_hi_bytes_ = std::max<uint64_t>(inflight_lo_bytes_, (inflight_hi_bytes_ * 7) / 10);
-    
-    if (mode_ == Mode::kStartup) {
-        {
-            common::CongestionStateUpdatedData qlog_data;
-            qlog_data.old_state = "slow_start";
-            qlog_data.new_state = "recovery";
-            QLOG_CONGESTION_STATE_UPDATED(qlog_trace_, qlog_data);
-        }
-        mode_ = Mode::kDrain;
-        pacing_gain_ = 1.0 / 2.885;
-        cwnd_gain_ = 2.0;
+        AdvanceProbeBwCycle(now_us);
     }
-    if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
 }
 
 void BBRv2CongestionControl::OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay) {
@@ -169,7 +198,7 @@ void BBRv2CongestionControl::OnRoundTripSample(uint64_t latest_rtt, uint64_t ack
     if (srtt_us_ == 0) srtt_us_ = latest_rtt;
     srtt_us_ = (7 * srtt_us_ + latest_rtt) / 8;
     if (srtt_us_ == 0) srtt_us_ = 1;
-    // Note: min_rtt timestamp is updated in OnPacketAcked where ack_time is available
+    // Note: min_rtt timestamp is updated in UpdateModelOnAck where ack_time is available
     if (min_rtt_us_ == 0 || latest_rtt < min_rtt_us_) {
         min_rtt_us_ = latest_rtt;
     }
@@ -284,7 +313,7 @@ void BBRv2CongestionControl::CheckStartupFullBandwidth(uint64_t now_us) {
     // detector unchanged: three consecutive rounds with <25% bandwidth
     // growth → pipe is full, exit STARTUP. v2 keeps this signal-driven
     // exit even though it also has the inflight_hi loss-driven path
-    // (OnPacketLost above), since on lossless paths the bandwidth-plateau
+    // (OnLossEvent above), since on lossless paths the bandwidth-plateau
     // signal is the only one that fires.
     // Check if bandwidth is still growing (>25% increase)
     if (full_bw_bps_ == 0 || max_bw_bps_ > full_bw_bps_ * 125 / 100) {
@@ -324,6 +353,14 @@ void BBRv2CongestionControl::CheckStartupFullBandwidth(uint64_t now_us) {
     }
 }
 
+bool BBRv2CongestionControl::SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) {
+    cwnd_bytes_ = std::min<uint64_t>(std::max<uint64_t>(cwnd_bytes, cfg_.min_cwnd_bytes), cfg_.max_cwnd_bytes);
+    ssthresh_bytes_ = ssthresh_bytes;
+    // The model keeps driving cwnd toward min(BDP × gain, inflight_hi).
+    if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
+    return true;
+}
+
 void BBRv2CongestionControl::SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) {
     qlog_trace_ = trace;
 }
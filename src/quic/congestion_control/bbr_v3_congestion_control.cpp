@@ -83,21 +83,69 @@ void BBRv3CongestionControl::OnPacketSent(const SentPacketEvent& ev) {
 }
 
 void BBRv3CongestionControl::OnPacketAcked(const AckEvent& ev) {
-    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
-    
+    OnCongestionEvent({ev}, {}, bytes_in_flight_, ev.ack_time);
+}
+
+void BBRv3CongestionControl::OnPacketLost(const LossEvent& ev) {
+    OnCongestionEvent({}, {ev}, bytes_in_flight_, ev.lost_time);
+}
+
+void BBRv3CongestionControl::OnCongestionEvent(const std::vector<AckEvent>& acked,
+    const std::vector<LossEvent>& lost, uint64_t prior_in_flight, uint64_t event_time) {
+    (void)prior_in_flight;
+    for (const auto& ev : lost) {
+        bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_lost) ? bytes_in_flight_ - ev.bytes_lost : 0;
+        round_lost_bytes_ += ev.bytes_lost;
+    }
+    // Don't call AdaptInflightBoundsOnLoss here - it's called at round end for accuracy
+    if (!lost.empty()) {
+        ExitStartupOnLoss(event_time);
+    }
+
+    uint64_t bytes_acked = 0;
+    uint64_t largest_acked_pn = 0;
+    for (const auto& ev : acked) {
+        bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
+        bytes_acked += ev.bytes_acked;
+        largest_acked_pn = std::max<uint64_t>(largest_acked_pn, ev.pn);
+        if (ev.ecn_ce) {
+            ecn_seen_in_round_ = true;
+            // ECN handling will be done at round end via AdaptOnEcn()
+        }
+    }
+    if (!acked.empty()) {
+        UpdateModelOnAck(bytes_acked, largest_acked_pn, event_time);
+    }
+    UpdatePacingRate();
+}
+
+void BBRv3CongestionControl::ExitStartupOnLoss(uint64_t now_us) {
+    if (mode_ == Mode::kStartup) {
+        {
+            common::CongestionStateUpdatedData qlog_data;
+            qlog_data.old_state = "slow_start";
+            qlog_data.new_state = "recovery";
+            QLOG_CONGESTION_STATE_UPDATED(qlog_trace_, qlog_data);
+        }
+        mode_ = Mode::kDrain;
+        pacing_gain_ = 1.0 / 2.885;
+        cwnd_gain_ = 2.0;
+        // Also exit Probe UP if in that state
+        if (probe_bw_state_ == ProbeBwState::kUp) {
+            EnterProbeBwState(ProbeBwState::kDown, now_us);
+        }
+    }
+}
+
+void BBRv3CongestionControl::UpdateModelOnAck(uint64_t bytes_acked, uint64_t largest_acked_pn, uint64_t now_us) {
     // Update min_rtt timestamp when min_rtt is updated (from OnRoundTripSample)
     if (min_rtt_stamp_us_ == 0 || srtt_us_ <= min_rtt_us_) {
-        min_rtt_stamp_us_ = ev.ack_time;
-    }
-    
-    if (ev.ecn_ce) {
-        ecn_seen_in_round_ = true;
-        // ECN handling will be done at round end via AdaptOnEcn()
+        min_rtt_stamp_us_ = now_us;
     }
 
     // per-round accounting: accumulate BEFORE checking round boundary
     // so this ACK's data is attributed to the current round
-    round_delivered_bytes_ += ev.bytes_acked;
+    round_delivered_bytes_ += bytes_acked;
 
     // Detect round boundary: when ACKs pass end_of_round_pn_
     // [BBRv3-Draft] §4.2: round-trip boundaries are the natural beat at
@@ -108,70 +156,47 @@ void BBRv3CongestionControl::OnPacketAcked(const AckEvent& ev) {
     // on bursty single-packet losses. This mirrors the round-based
     // accounting PRR uses in TCP (RFC 6937), but applied to v3's
     // model-based bounds instead of cwnd.
-    if (end_of_round_pn_ > 0 && ev.pn >= end_of_round_pn_) {
+    if (end_of_round_pn_ > 0 && largest_acked_pn >= end_of_round_pn_) {
         // Call loss and ECN adaptation at round end with complete data
-        AdaptInflightBoundsOnLoss(ev.ack_time);
+        AdaptInflightBoundsOnLoss(now_us);
         AdaptOnEcn();
         UpdateInflightBounds();
-        StartNewRound(ev.pn);
+        StartNewRound(largest_acked_pn);
     }
 
     if (srtt_us_ > 0) {
         if (bw_sample_start_us_ == 0) {
-            bw_sample_start_us_ = ev.ack_time;
-            bw_sample_bytes_acc_ = ev.bytes_acked;
+            bw_sample_start_us_ = now_us;
+            bw_sample_bytes_acc_ = bytes_acked;
         } else {
-            bw_sample_bytes_acc_ += ev.bytes_acked;
-            uint64_t elapsed = ev.ack_time - bw_sample_start_us_;
+            bw_sample_bytes_acc_ += bytes_acked;
+            uint64_t elapsed = now_us - bw_sample_start_us_;
             if (elapsed >= srtt_us_) {
                 uint64_t bytes_per_sec = MulDiv(bw_sample_bytes_acc_, 1000000ull, elapsed);
-                UpdateMaxBandwidth(bytes_per_sec, ev.ack_time);
-                bw_sample_start_us_ = ev.ack_time;
+                UpdateMaxBandwidth(bytes_per_sec, now_us);
+                bw_sample_start_us_ = now_us;
                 bw_sample_bytes_acc_ = 0;
             }
         }
     }
 
     // Startup/Drain transitions
-    CheckStartupFullBandwidth(ev.ack_time);
-    MaybeEnterOrExitProbeRtt(ev.ack_time);
+    CheckStartupFullBandwidth(now_us);
+    MaybeEnterOrExitProbeRtt(now_us);
 
     // cwnd target with hi/lo bounds
     uint64_t bdp = BdpBytes(static_cast<uint64_t>(cwnd_gain_ * 1000), 1000);
     uint64_t target = std::min<uint64_t>(bdp, inflight_hi_bytes_);
     target = std::max<uint64_t>(target, inflight_lo_bytes_);
     if (cwnd_bytes_ < target) {
-        cwnd_bytes_ += ev.bytes_acked;
+        cwnd_bytes_ += bytes_acked;
         if (cwnd_bytes_ > target) cwnd_bytes_ = target;
     }
     if (cwnd_bytes_ > cfg_.max_cwnd_bytes) cwnd_bytes_ = cfg_.max_cwnd_bytes;
 
     if (mode_ == Mode::kProbeBw) {
-        AdvanceProbeBwCycle(ev.ack_time);
+        AdvanceProbeBwCycle(now_us);
     }
-    UpdatePacingRate();
-}
-
-void BBRv3CongestionControl::OnPacketLost(const LossEvent& ev) {
-    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_lost) ? bytes_in_flight_ - ev.bytes_lost : 0;
-    round_lost_bytes_ += ev.bytes_lost;
-    // Don't call AdaptInflightBoundsOnLoss here - it's called at round end for accuracy
-    if (mode_ == Mode::kStartup) {
-        {
-            common::CongestionStateUpdatedData qlog_data;
-            qlog_data.old_state = "slow_start";
-            qlog_data.new_state = "recovery";
-            QLOG_CONGESTION_STATE_UPDATED(qlog_trace_, qlog_data);
-        }
-        mode_ = Mode::kDrain;
-        pacing_gain_ = 1.0 / 2.885;
-        cwnd_gain_ = 2.0;
-        // Also exit Probe UP if in that state
-        if (probe_bw_state_ == ProbeBwState::kUp) {
-            EnterProbeBwState(ProbeBwState::kDown, ev.lost_time);
-        }
-    }
-    UpdatePacingRate();
 }
 
 void BBRv3CongestionControl::OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay) {
@@ -183,7 +208,7 @@ void BBRv3CongestionControl::OnRoundTripSample(uint64_t latest_rtt, uint64_t ack
     if (srtt_us_ == 0) srtt_us_ = 1;
     if (min_rtt_us_ == 0 || latest_rtt < min_rtt_us_) {
         min_rtt_us_ = latest_rtt;
-        // min_rtt_stamp_us_ is updated in OnPacketAcked where ack_time is available
+        // min_rtt_stamp_us_ is updated in UpdateModelOnAck where ack_time is available
     }
 }
 
@@ -495,6 +520,14 @@ bool BBRv3CongestionControl::ShouldAdvanceProbeBwState(uint64_t now_us) const {
     }
 }
 
+bool BBRv3CongestionControl::SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) {
+    cwnd_bytes_ = std::min<uint64_t>(std::max<uint64_t>(cwnd_bytes, cfg_.min_cwnd_bytes), cfg_.max_cwnd_bytes);
+    ssthresh_bytes_ = ssthresh_bytes;
+    // The model keeps driving cwnd toward the inflight-bounded BDP target.
+    UpdatePacingRate();
+    return true;
+}
+
 void BBRv3CongestionControl::SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) {
     qlog_trace_ = trace;
 }
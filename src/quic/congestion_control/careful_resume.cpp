@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <quicx/common/metrics.h>
+#include <quicx/common/metrics_std.h>
+
+#include "common/log/log.h"
+#include "quic/congestion_control/careful_resume.h"
+
+namespace quicx {
+namespace quic {
+
+void CarefulResume::Start(const PathCapacity& saved) {
+    if (latest_rtt_us_ != 0 || saved.min_rtt_us == 0 || saved.cwnd_bytes == 0) {
+        return;
+    }
+    saved_ = saved;
+    phase_ = Phase::kReconnaissance;
+    LOG_DEBUG("CarefulResume: armed, saved min_rtt=%lluus bw=%lluB/s cwnd=%llu", saved.min_rtt_us,
+        saved.bandwidth_bytes_per_sec, saved.cwnd_bytes);
+}
+
+void CarefulResume::OnPacketSent(uint64_t pn) {
+    largest_sent_pn_ = std::max(largest_sent_pn_, pn);
+}
+
+void CarefulResume::OnRoundTripSample(uint64_t latest_rtt_us) {
+    latest_rtt_us_ = latest_rtt_us;
+    if (min_rtt_us_ == 0 || latest_rtt_us < min_rtt_us_) {
+        min_rtt_us_ = latest_rtt_us;
+    }
+}
+
+void CarefulResume::OnCongestionEvent(const std::vector<AckEvent>& acked, const std::vector<LossEvent>& lost,
+    uint64_t now_us, ICongestionControl& cc) {
+    uint64_t bytes_acked = 0;
+    uint64_t largest_acked = 0;
+    bool ecn_ce = false;
+    for (const auto& ev : acked) {
+        bytes_acked += ev.bytes_acked;
+        largest_acked = std::max(largest_acked, ev.pn);
+        ecn_ce = ecn_ce || ev.ecn_ce;
+    }
+    UpdateDeliveryRate(bytes_acked, now_us);
+
+    bool congested = !lost.empty() || ecn_ce;
+    switch (phase_) {
+        case Phase::kNormal:
+            break;
+        case Phase::kReconnaissance:
+            OnReconnaissance(congested, cc);
+            break;
+        case Phase::kUnvalidated:
+            if (congested) {
+                last_unvalidated_pn_ = largest_sent_pn_;
+                EnterSafeRetreat(cc);
+                break;
+            }
+            pipe_size_ += bytes_acked;
+            // A packet sent after the jump came back: one RTT has passed and
+            // PipeSize now reflects what the path delivered at the new rate.
+            if (!acked.empty() && largest_acked >= first_unvalidated_pn_) {
+                last_unvalidated_pn_ = largest_sent_pn_;
+                phase_ = Phase::kValidating;
+                uint64_t validated_cwnd = std::min(cc.GetCongestionWindow(), pipe_size_);
+                cc.SetCongestionWindow(validated_cwnd, validated_cwnd);
+                LOG_DEBUG("CarefulResume: validating, pipe_size=%llu", pipe_size_);
+            }
+            break;
+        case Phase::kValidating:
+            if (congested) {
+                EnterSafeRetreat(cc);
+                break;
+            }
+            pipe_size_ += bytes_acked;
+            if (!acked.empty() && largest_acked >= last_unvalidated_pn_) {
+                phase_ = Phase::kNormal;
+                LOG_DEBUG("CarefulResume: jump validated, cwnd=%llu", cc.GetCongestionWindow());
+            }
+            break;
+        case Phase::kSafeRetreat:
+            if (!acked.empty() && largest_acked >= last_unvalidated_pn_) {
+                phase_ = Phase::kNormal;
+            }
+            break;
+    }
+}
+
+bool CarefulResume::GetObservedCapacity(const ICongestionControl& cc, PathCapacity& out) const {
+    if (min_rtt_us_ == 0) {
+        return false;
+    }
+    out.min_rtt_us = min_rtt_us_;
+    out.bandwidth_bytes_per_sec = max_delivery_rate_;
+    out.cwnd_bytes = cc.GetCongestionWindow();
+    // A window that was never validated is not worth remembering.
+    if (phase_ == Phase::kUnvalidated || phase_ == Phase::kValidating) {
+        out.cwnd_bytes = std::min(out.cwnd_bytes, pipe_size_);
+    }
+    return true;
+}
+
+void CarefulResume::OnReconnaissance(bool congested, ICongestionControl& cc) {
+    bool cwnd_limited = cwnd_limited_;
+    cwnd_limited_ = false;
+    if (congested) {
+        phase_ = Phase::kNormal;
+        LOG_DEBUG("CarefulResume: congestion before the jump, resuming normally");
+        return;
+    }
+    if (latest_rtt_us_ == 0) {
+        return;
+    }
+    if (latest_rtt_us_ < saved_.min_rtt_us / kRttConfirmMinDivisor ||
+        latest_rtt_us_ > saved_.min_rtt_us * kRttConfirmMaxFactor) {
+        phase_ = Phase::kNormal;
+        LOG_DEBUG("CarefulResume: rtt %lluus does not match saved %lluus", latest_rtt_us_, saved_.min_rtt_us);
+        return;
+    }
+
+    uint64_t jump_cwnd = saved_.cwnd_bytes;
+    if (saved_.bandwidth_bytes_per_sec > 0) {
+        jump_cwnd = std::min(jump_cwnd, saved_.bandwidth_bytes_per_sec * latest_rtt_us_ / 1000000);
+    }
+    jump_cwnd /= 2;
+    if (jump_cwnd <= cc.GetCongestionWindow()) {
+        phase_ = Phase::kNormal;
+        return;
+    }
+    // A sender that does not fill the current window gains nothing from a
+    // larger one and would leave the jump unvalidated.
+    if (!cwnd_limited) {
+        return;
+    }
+    // ssthresh = jump_cwnd: no slow start on top of a window that is itself
+    // still unvalidated.
+    if (!cc.SetCongestionWindow(jump_cwnd, jump_cwnd)) {
+        phase_ = Phase::kNormal;
+        return;
+    }
+
+    phase_ = Phase::kUnvalidated;
+    first_unvalidated_pn_ = largest_sent_pn_ + 1;
+    pipe_size_ = cc.GetBytesInFlight();
+    common::Metrics::CounterInc(common::MetricsStd::CarefulResumeJumps);
+    LOG_INFO("CarefulResume: jumped to cwnd=%llu (rtt=%lluus)", cc.GetCongestionWindow(), latest_rtt_us_);
+}
+
+void CarefulResume::EnterSafeRetreat(ICongestionControl& cc) {
+    phase_ = Phase::kSafeRetreat;
+    uint64_t retreat_cwnd = pipe_size_ / 2;
+    cc.SetCongestionWindow(retreat_cwnd, retreat_cwnd);
+    common::Metrics::CounterInc(common::MetricsStd::CarefulResumeRetreats);
+    LOG_WARN("CarefulResume: loss after the jump, retreating to cwnd=%llu", cc.GetCongestionWindow());
+}
+
+void CarefulResume::UpdateDeliveryRate(uint64_t bytes_acked, uint64_t now_us) {
+    if (bytes_acked == 0) {
+        return;
+    }
+    if (rate_sample_start_us_ == 0) {
+        rate_sample_start_us_ = now_us;
+        rate_sample_bytes_ = 0;
+        return;
+    }
+    // One sample per RTT (at least 1ms, the clock's granularity).
+    rate_sample_bytes_ += bytes_acked;
+    uint64_t elapsed = now_us > rate_sample_start_us_ ? now_us - rate_sample_start_us_ : 0;
+    if (elapsed < std::max<uint64_t>(latest_rtt_us_, 1000)) {
+        return;
+    }
+    latest_delivery_rate_ = rate_sample_bytes_ * 1000000 / elapsed;
+    max_delivery_rate_ = std::max(max_delivery_rate_, latest_delivery_rate_);
+    rate_sample_start_us_ = now_us;
+    rate_sample_bytes_ = 0;
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,108 @@
+#ifndef QUIC_CONGESTION_CONTROL_CAREFUL_RESUME
+#define QUIC_CONGESTION_CONTROL_CAREFUL_RESUME
+
+#include <cstdint>
+#include <vector>
+
+#include "quic/congestion_control/if_congestion_control.h"
+
+namespace quicx {
+namespace quic {
+
+// Path characteristics one connection observed, remembered for the next
+// connection over the same path.
+struct PathCapacity {
+    uint64_t min_rtt_us = 0;
+    uint64_t bandwidth_bytes_per_sec = 0;  // highest per-RTT delivery rate
+    uint64_t cwnd_bytes = 0;
+};
+
+/**
+ * @brief Careful Resume (draft-ietf-tsvwg-careful-resume): start a connection
+ * from the capacity an earlier connection saw on the same path instead of
+ * slow-starting from the initial window.
+ *
+ *   Reconnaissance  the controller runs normally until the first RTT sample.
+ *                   The jump is taken only if that RTT lies within
+ *                   [saved/2, saved*10], nothing was lost or CE-marked, and
+ *                   the sender filled its window since the previous ACK; an
+ *                   application-limited sender keeps waiting here.
+ *   Unvalidated     cwnd and ssthresh jump to jump_cwnd = min(saved cwnd,
+ *                   saved bandwidth × current RTT) / 2, so the controller
+ *                   grows no faster than congestion avoidance from there.
+ *                   PipeSize counts what the path actually delivers. Ends
+ *                   once a packet sent in this phase is acknowledged, i.e.
+ *                   after one RTT.
+ *   Validating      cwnd and ssthresh fall back to PipeSize until the last
+ *                   packet sent while unvalidated is acknowledged.
+ *   Safe Retreat    loss or CE in either phase above: cwnd and ssthresh drop
+ *                   to PipeSize/2 until that same packet is acknowledged.
+ *   Normal          the controller runs unaided.
+ *
+ * Independently of the phase, the connection's min RTT and delivery rate are
+ * tracked so that its capacity can be saved when it closes.
+ */
+class CarefulResume {
+public:
+    enum class Phase {
+        kNormal,
+        kReconnaissance,
+        kUnvalidated,
+        kValidating,
+        kSafeRetreat,
+    };
+
+    CarefulResume() = default;
+    ~CarefulResume() = default;
+
+    // Arm with the capacity an earlier connection saved. Ignored once the
+    // connection has taken an RTT sample, or if the values are unusable.
+    void Start(const PathCapacity& saved);
+
+    void OnPacketSent(uint64_t pn);
+    // The sender had more to send than the congestion window allowed.
+    void OnCwndLimited() { cwnd_limited_ = true; }
+    void OnRoundTripSample(uint64_t latest_rtt_us);
+    // Called after `cc` has processed the event.
+    void OnCongestionEvent(const std::vector<AckEvent>& acked, const std::vector<LossEvent>& lost, uint64_t now_us,
+        ICongestionControl& cc);
+
+    Phase GetPhase() const { return phase_; }
+    // What this connection observed; false until there is an RTT sample.
+    bool GetObservedCapacity(const ICongestionControl& cc, PathCapacity& out) const;
+    // Bytes/s acknowledged over the last complete round trip, 0 until the
+    // first one has been measured.
+    uint64_t GetDeliveryRate() const { return latest_delivery_rate_; }
+
+    // The first RTT sample must fall within [saved/2, saved*10] for the path
+    // to be treated as the one the capacity was saved on.
+    static constexpr uint64_t kRttConfirmMinDivisor = 2;
+    static constexpr uint64_t kRttConfirmMaxFactor = 10;
+
+private:
+    void OnReconnaissance(bool congested, ICongestionControl& cc);
+    void EnterSafeRetreat(ICongestionControl& cc);
+    void UpdateDeliveryRate(uint64_t bytes_acked, uint64_t now_us);
+
+    Phase phase_ = Phase::kNormal;
+    PathCapacity saved_;
+
+    uint64_t largest_sent_pn_ = 0;
+    uint64_t first_unvalidated_pn_ = 0;
+    uint64_t last_unvalidated_pn_ = 0;
+    uint64_t pipe_size_ = 0;
+    bool cwnd_limited_ = false;  // since the last congestion event
+
+    // Observation of this connection.
+    uint64_t latest_rtt_us_ = 0;
+    uint64_t min_rtt_us_ = 0;
+    uint64_t rate_sample_start_us_ = 0;
+    uint64_t rate_sample_bytes_ = 0;
+    uint64_t latest_delivery_rate_ = 0;
+    uint64_t max_delivery_rate_ = 0;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
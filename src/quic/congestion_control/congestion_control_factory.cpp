@@ -1,29 +1,72 @@
-#include "quic/congestion_control/reno_congestion_control.h"
-#include "quic/congestion_control/cubic_congestion_control.h"
-#include "quic/congestion_control/bbr_v1_congestion_control.h"
-#include "quic/congestion_control/bbr_v2_congestion_control.h"
-#include "quic/congestion_control/bbr_v3_congestion_control.h"
-#include "quic/congestion_control/congestion_control_factory.h"
-
-namespace quicx {
-namespace quic {
-
-std::unique_ptr<ICongestionControl> CreateCongestionControl(CongestionControlType type) {
-    switch (type) {
-        case CongestionControlType::kCubic:
-            return std::unique_ptr<CubicCongestionControl>(new CubicCongestionControl());
-        case CongestionControlType::kReno:
-            return std::unique_ptr<RenoCongestionControl>(new RenoCongestionControl());
-        case CongestionControlType::kBbrV1:
-            return std::unique_ptr<BBRv1CongestionControl>(new BBRv1CongestionControl());
-        case CongestionControlType::kBbrV2:
-            return std::unique_ptr<BBRv2CongestionControl>(new BBRv2CongestionControl());
-        case CongestionControlType::kBbrV3:
-            return std::unique_ptr<BBRv3CongestionControl>(new BBRv3CongestionControl());
-        default:
-            return nullptr;
-    }
-}
-
-}
-}
+#include <mutex>
+#include <unordered_map>
+
+#include "quic/congestion_control/reno_congestion_control.h"
+#include "quic/congestion_control/cubic_congestion_control.h"
+#include "quic/congestion_control/bbr_v1_congestion_control.h"
+#include "quic/congestion_control/bbr_v2_congestion_control.h"
+#include "quic/congestion_control/bbr_v3_congestion_control.h"
+#include "quic/congestion_control/prague_congestion_control.h"
+#include "quic/congestion_control/congestion_control_factory.h"
+
+namespace quicx {
+namespace quic {
+
+namespace {
+
+// Registered plug-ins. Registration normally happens once at startup, but
+// lookups run on every worker thread as connections are created.
+std::mutex& RegistryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<std::string, congestion_control_factory>& Registry() {
+    static std::unordered_map<std::string, congestion_control_factory> registry;
+    return registry;
+}
+
+}  // namespace
+
+bool RegisterCongestionControl(const std::string& name, congestion_control_factory factory) {
+    if (name.empty() || !factory) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    Registry()[name] = std::move(factory);
+    return true;
+}
+
+std::unique_ptr<ICongestionControl> CreateCongestionControl(CongestionControlType type, const std::string& custom_name) {
+    switch (type) {
+        case CongestionControlType::kCubic:
+            return std::unique_ptr<CubicCongestionControl>(new CubicCongestionControl());
+        case CongestionControlType::kReno:
+            return std::unique_ptr<RenoCongestionControl>(new RenoCongestionControl());
+        case CongestionControlType::kBbrV1:
+            return std::unique_ptr<BBRv1CongestionControl>(new BBRv1CongestionControl());
+        case CongestionControlType::kBbrV2:
+            return std::unique_ptr<BBRv2CongestionControl>(new BBRv2CongestionControl());
+        case CongestionControlType::kBbrV3:
+            return std::unique_ptr<BBRv3CongestionControl>(new BBRv3CongestionControl());
+        case CongestionControlType::kPrague:
+            return std::unique_ptr<PragueCongestionControl>(new PragueCongestionControl());
+        case CongestionControlType::kCustom: {
+            congestion_control_factory factory;
+            {
+                std::lock_guard<std::mutex> lock(RegistryMutex());
+                auto iter = Registry().find(custom_name);
+                if (iter == Registry().end()) {
+                    return nullptr;
+                }
+                factory = iter->second;
+            }
+            return factory();
+        }
+        default:
+            return nullptr;
+    }
+}
+
+}
+}
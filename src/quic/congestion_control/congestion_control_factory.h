@@ -2,22 +2,19 @@
 #define QUIC_CONGESTION_CONTROL_FACTORY
 
 #include <memory>
+#include <string>
 #include "quic/congestion_control/if_congestion_control.h"
 
 namespace quicx {
 namespace quic {
 
-enum class CongestionControlType {
-    kCubic,
-    kBbrV1,
-    kBbrV2,
-    kBbrV3,
-    kReno
-};
-
-std::unique_ptr<ICongestionControl> CreateCongestionControl(CongestionControlType type);
+// Build a controller of the given type. kCustom looks `custom_name` up among
+// the controllers registered with RegisterCongestionControl(). Returns nullptr
+// for an unknown type or an unregistered name.
+std::unique_ptr<ICongestionControl> CreateCongestionControl(
+    CongestionControlType type, const std::string& custom_name = "");
 
 } // namespace quic
 } // namespace quicx
 
-#endif // QUIC_CONGESTION_CONTROL_FACTORY_H
\ No newline at end of file
+#endif // QUIC_CONGESTION_CONTROL_FACTORY_H
@@ -15,9 +15,9 @@
 //                  *before* the first loss instead of waiting for it.
 //   [RFC9002 §7]   QUIC pluggable congestion control + recovery period
 //                  semantics consumed by the in_recovery_ branch in
-//                  OnPacketAcked / OnPacketLost.
+//                  OnAck / OnLoss.
 //   [RFC8311 §4.2] ECN-CE feedback semantics; we treat CE as an early
-//                  congestion signal in the OnPacketAcked ECN branch.
+//                  congestion signal in the OnAck ECN branch.
 
 namespace quicx {
 namespace quic {
@@ -64,6 +64,30 @@ void CubicCongestionControl::OnPacketSent(const SentPacketEvent& ev) {
 }
 
 void CubicCongestionControl::OnPacketAcked(const AckEvent& ev) {
+    OnCongestionEvent({ev}, {}, bytes_in_flight_, ev.ack_time);
+}
+
+void CubicCongestionControl::OnPacketLost(const LossEvent& ev) {
+    OnCongestionEvent({}, {ev}, bytes_in_flight_, ev.lost_time);
+}
+
+void CubicCongestionControl::OnCongestionEvent(const std::vector<AckEvent>& acked,
+    const std::vector<LossEvent>& lost, uint64_t prior_in_flight, uint64_t event_time) {
+    (void)prior_in_flight;
+    (void)event_time;
+    // RFC 9002 Appendix A.7: losses first. The first loss enters recovery and
+    // the rest of the batch is absorbed by it, so one ACK frame reporting a
+    // burst of losses reduces the window once.
+    for (const auto& ev : lost) {
+        OnLoss(ev);
+    }
+    for (const auto& ev : acked) {
+        OnAck(ev);
+    }
+    if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
+}
+
+void CubicCongestionControl::OnAck(const AckEvent& ev) {
     bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
 
     // ECN-CE: treat as early congestion signal, exit slow start and reduce cwnd
@@ -102,7 +126,6 @@ void CubicCongestionControl::OnPacketAcked(const AckEvent& ev) {
             // Reset HyStart on congestion signal
             ResetHyStart();
         }
-        if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
         return;
     }
 
@@ -131,8 +154,6 @@ void CubicCongestionControl::OnPacketAcked(const AckEvent& ev) {
             hystart_found_exit_ = true;
             ResetEpoch(ev.ack_time);
         }
-
-        if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
         return;
     }
 
@@ -154,15 +175,13 @@ void CubicCongestionControl::OnPacketAcked(const AckEvent& ev) {
     }
 
     IncreaseOnAck(ev.bytes_acked, ev.ack_time);
-    if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
 }
 
-void CubicCongestionControl::OnPacketLost(const LossEvent& ev) {
+void CubicCongestionControl::OnLoss(const LossEvent& ev) {
     bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_lost) ? bytes_in_flight_ - ev.bytes_lost : 0;
 
     // Skip duplicate cwnd reduction if already in recovery
     if (in_recovery_) {
-        if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
         return;
     }
 
@@ -203,15 +222,13 @@ void CubicCongestionControl::OnPacketLost(const LossEvent& ev) {
 
     // Reset HyStart on loss
     ResetHyStart();
-
-    if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
 }
 
 void CubicCongestionControl::OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay) {
     (void)ack_delay;
     if (srtt_us_ == 0) srtt_us_ = latest_rtt;
     srtt_us_ = (7 * srtt_us_ + latest_rtt) / 8;
-    // Note: HyStart logic is handled in OnPacketAcked where ack_time is available
+    // Note: HyStart logic is handled in OnAck where ack_time is available
 }
 
 ICongestionControl::SendState CubicCongestionControl::CanSend(uint64_t now, uint64_t& can_send_bytes) const {
@@ -370,6 +387,19 @@ bool CubicCongestionControl::CheckHyStartExit(uint64_t latest_rtt, uint64_t now)
     return false;
 }
 
+bool CubicCongestionControl::SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) {
+    cwnd_bytes_ = std::min<uint64_t>(std::max<uint64_t>(cwnd_bytes, cfg_.min_cwnd_bytes), cfg_.max_cwnd_bytes);
+    ssthresh_bytes_ = ssthresh_bytes;
+    in_slow_start_ = cwnd_bytes_ < ssthresh_bytes_;
+    if (!in_slow_start_) {
+        // Restart the cubic curve from the installed window.
+        w_max_pkts_ = BytesToPkts(cwnd_bytes_, cfg_.mss_bytes);
+        epoch_start_us_ = 0;
+    }
+    if (pacer_) pacer_->OnPacingRateUpdated(GetPacingRateBytesPerSec());
+    return true;
+}
+
 void CubicCongestionControl::SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) {
     qlog_trace_ = trace;
 }
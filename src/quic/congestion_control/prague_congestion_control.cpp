@@ -0,0 +1,261 @@
+#include <algorithm>
+
+#include "common/log/log.h"
+#include <quicx/common/metrics.h>
+#include <quicx/common/metrics_std.h>
+#include "common/qlog/qlog.h"
+
+#include "quic/congestion_control/normal_pacer.h"
+#include "quic/congestion_control/prague_congestion_control.h"
+
+namespace quicx {
+namespace quic {
+
+PragueCongestionControl::PragueCongestionControl() {
+    Configure({});
+}
+
+void PragueCongestionControl::Configure(const CcConfigV2& cfg) {
+    cfg_ = cfg;
+    cwnd_bytes_ = cfg_.initial_cwnd_bytes;
+    ssthresh_bytes_ = UINT64_MAX;
+    bytes_in_flight_ = 0;
+    in_slow_start_ = true;
+    in_recovery_ = false;
+    recovery_start_time_ = 0;
+    alpha_ = 1.0;
+    largest_sent_pn_ = 0;
+    round_end_pn_ = 0;
+    round_acked_bytes_ = 0;
+    round_ce_bytes_ = 0;
+    in_cwr_ = false;
+    cwr_end_pn_ = 0;
+    if (!pacer_) {
+        pacer_.reset(new NormalPacer());
+    }
+}
+
+void PragueCongestionControl::OnPacketSent(const SentPacketEvent& ev) {
+    bytes_in_flight_ += ev.bytes;
+    largest_sent_pn_ = std::max(largest_sent_pn_, ev.pn);
+
+    // Metrics: Bytes in flight
+    common::Metrics::GaugeSet(common::MetricsStd::BytesInFlight, bytes_in_flight_);
+
+    if (pacer_) {
+        pacer_->OnPacketSent(ev.sent_time / 1000, static_cast<size_t>(ev.bytes));
+    }
+}
+
+void PragueCongestionControl::OnPacketAcked(const AckEvent& ev) {
+    OnCongestionEvent({ev}, {}, bytes_in_flight_, ev.ack_time);
+}
+
+void PragueCongestionControl::OnPacketLost(const LossEvent& ev) {
+    OnCongestionEvent({}, {ev}, bytes_in_flight_, ev.lost_time);
+}
+
+void PragueCongestionControl::OnCongestionEvent(const std::vector<AckEvent>& acked,
+    const std::vector<LossEvent>& lost, uint64_t prior_in_flight, uint64_t event_time) {
+    (void)prior_in_flight;
+    for (const auto& ev : lost) {
+        OnLoss(ev);
+    }
+
+    uint64_t largest_acked = 0;
+    bool ce_marked = false;
+    for (const auto& ev : acked) {
+        OnAck(ev);
+        largest_acked = std::max(largest_acked, ev.pn);
+        ce_marked = ce_marked || ev.ecn_ce;
+    }
+    if (!acked.empty()) {
+        if (in_cwr_ && largest_acked > cwr_end_pn_) {
+            in_cwr_ = false;
+        }
+        MaybeEndRound(largest_acked);
+        if (ce_marked && !in_cwr_) {
+            ReduceOnCe(event_time);
+        }
+    }
+
+    // Metrics: Bytes in flight
+    common::Metrics::GaugeSet(common::MetricsStd::BytesInFlight, bytes_in_flight_);
+
+    UpdatePacingRate();
+}
+
+void PragueCongestionControl::OnAck(const AckEvent& ev) {
+    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
+
+    round_acked_bytes_ += ev.bytes_acked;
+    if (ev.ecn_ce) {
+        round_ce_bytes_ += ev.bytes_acked;
+        return;
+    }
+
+    if (in_recovery_) {
+        // RFC 9002 §7.3.2: only a packet sent after recovery started ends it.
+        if (ev.acked_packet_send_time <= recovery_start_time_) {
+            return;
+        }
+        if (qlog_trace_) {
+            common::CongestionStateUpdatedData data;
+            data.old_state = "recovery";
+            data.new_state = "congestion_avoidance";
+            QLOG_CONGESTION_STATE_UPDATED(qlog_trace_, data);
+        }
+        in_recovery_ = false;
+    }
+
+    if (in_slow_start_) {
+        cwnd_bytes_ += ev.bytes_acked;
+        if (cwnd_bytes_ >= ssthresh_bytes_) {
+            in_slow_start_ = false;
+        }
+    } else {
+        // 1 MSS per round trip, spread over the ACKs of one window.
+        uint64_t add = (cfg_.mss_bytes * ev.bytes_acked) / std::max<uint64_t>(cwnd_bytes_, 1);
+        cwnd_bytes_ += std::max<uint64_t>(add, 1);
+    }
+    cwnd_bytes_ = std::min<uint64_t>(cwnd_bytes_, cfg_.max_cwnd_bytes);
+
+    // Metrics: Congestion window updated
+    common::Metrics::GaugeSet(common::MetricsStd::CongestionWindowBytes, cwnd_bytes_);
+}
+
+void PragueCongestionControl::OnLoss(const LossEvent& ev) {
+    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_lost) ? bytes_in_flight_ - ev.bytes_lost : 0;
+    LOG_WARN("PragueCongestionControl::OnPacketLost: pn=%llu, bytes_lost=%llu, cwnd=%llu", ev.pn, ev.bytes_lost,
+        cwnd_bytes_);
+    if (!in_recovery_) {
+        EnterRecovery(ev.lost_time);
+    }
+}
+
+void PragueCongestionControl::MaybeEndRound(uint64_t largest_acked) {
+    if (largest_acked < round_end_pn_) {
+        return;
+    }
+    if (round_acked_bytes_ > 0) {
+        double fraction = static_cast<double>(round_ce_bytes_) / static_cast<double>(round_acked_bytes_);
+        alpha_ += kAlphaGain * (fraction - alpha_);
+    }
+    round_acked_bytes_ = 0;
+    round_ce_bytes_ = 0;
+    round_end_pn_ = largest_sent_pn_ + 1;
+}
+
+void PragueCongestionControl::ReduceOnCe(uint64_t now) {
+    (void)now;
+    uint64_t old_cwnd = cwnd_bytes_;
+    uint64_t reduction = static_cast<uint64_t>(static_cast<double>(cwnd_bytes_) * alpha_ / 2.0);
+    cwnd_bytes_ = std::max<uint64_t>(cfg_.min_cwnd_bytes, cwnd_bytes_ - std::min(reduction, cwnd_bytes_));
+    ssthresh_bytes_ = cwnd_bytes_;
+    if (in_slow_start_ && qlog_trace_) {
+        common::CongestionStateUpdatedData data;
+        data.old_state = "slow_start";
+        data.new_state = "congestion_avoidance";
+        QLOG_CONGESTION_STATE_UPDATED(qlog_trace_, data);
+    }
+    if (in_slow_start_) {
+        common::Metrics::CounterInc(common::MetricsStd::SlowStartExits);
+    }
+    in_slow_start_ = false;
+    in_cwr_ = true;
+    cwr_end_pn_ = largest_sent_pn_;
+
+    LOG_DEBUG("PragueCongestionControl::ReduceOnCe: alpha=%.3f, cwnd: %llu->%llu", alpha_, old_cwnd, cwnd_bytes_);
+
+    // Metrics: Congestion event
+    common::Metrics::CounterInc(common::MetricsStd::CongestionEventsTotal);
+    common::Metrics::GaugeSet(common::MetricsStd::CongestionWindowBytes, cwnd_bytes_);
+}
+
+void PragueCongestionControl::EnterRecovery(uint64_t now) {
+    uint64_t old_cwnd = cwnd_bytes_;
+    if (qlog_trace_) {
+        common::CongestionStateUpdatedData data;
+        data.old_state = in_slow_start_ ? "slow_start" : "congestion_avoidance";
+        data.new_state = "recovery";
+        QLOG_CONGESTION_STATE_UPDATED(qlog_trace_, data);
+    }
+
+    ssthresh_bytes_ = static_cast<uint64_t>(cwnd_bytes_ * cfg_.beta);
+    cwnd_bytes_ = std::max<uint64_t>(cfg_.min_cwnd_bytes, ssthresh_bytes_);
+    in_recovery_ = true;
+    recovery_start_time_ = now;
+    in_slow_start_ = false;
+    // A CE mark from the same window must not cut it a second time.
+    in_cwr_ = true;
+    cwr_end_pn_ = largest_sent_pn_;
+
+    LOG_WARN("PragueCongestionControl::EnterRecovery: cwnd: %llu->%llu, bytes_in_flight=%llu", old_cwnd, cwnd_bytes_,
+        bytes_in_flight_);
+
+    // Metrics: Congestion event
+    common::Metrics::CounterInc(common::MetricsStd::CongestionEventsTotal);
+    common::Metrics::GaugeSet(common::MetricsStd::CongestionWindowBytes, cwnd_bytes_);
+}
+
+void PragueCongestionControl::OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay) {
+    (void)ack_delay;
+    if (srtt_us_ == 0) {
+        srtt_us_ = latest_rtt;
+    }
+    srtt_us_ = (7 * srtt_us_ + latest_rtt) / 8;
+}
+
+ICongestionControl::SendState PragueCongestionControl::CanSend(uint64_t now, uint64_t& can_send_bytes) const {
+    (void)now;
+    uint64_t left = (cwnd_bytes_ > bytes_in_flight_) ? (cwnd_bytes_ - bytes_in_flight_) : 0;
+    can_send_bytes = left;
+    if (left == 0) {
+        return SendState::kBlockedByCwnd;
+    }
+    return SendState::kOk;
+}
+
+uint64_t PragueCongestionControl::GetPacingRateBytesPerSec() const {
+    if (srtt_us_ == 0) {
+        return cfg_.min_cwnd_bytes;
+    }
+    // Pace slightly above cwnd/RTT (2x in slow start, 1.25x after) so the
+    // pacer smooths bursts without becoming the limit. Bursts are what
+    // would otherwise trip the L-queue's ~1ms marking threshold.
+    uint64_t rate = (cwnd_bytes_ * 1000000ull) / srtt_us_;
+    return in_slow_start_ ? rate * 2 : rate + rate / 4;
+}
+
+uint64_t PragueCongestionControl::NextSendTime(uint64_t now) const {
+    if (!pacer_) {
+        return now;
+    }
+    return now + pacer_->TimeUntilSend();
+}
+
+void PragueCongestionControl::UpdatePacingRate() {
+    if (!pacer_) {
+        return;
+    }
+    uint64_t pacing_rate = GetPacingRateBytesPerSec();
+    pacer_->OnPacingRateUpdated(pacing_rate);
+
+    // Metrics: Pacing rate (already in bytes/sec)
+    common::Metrics::GaugeSet(common::MetricsStd::PacingRateBytesPerSec, pacing_rate);
+}
+
+bool PragueCongestionControl::SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) {
+    cwnd_bytes_ = std::min<uint64_t>(std::max<uint64_t>(cwnd_bytes, cfg_.min_cwnd_bytes), cfg_.max_cwnd_bytes);
+    ssthresh_bytes_ = ssthresh_bytes;
+    in_slow_start_ = cwnd_bytes_ < ssthresh_bytes_;
+    UpdatePacingRate();
+    return true;
+}
+
+void PragueCongestionControl::SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) {
+    qlog_trace_ = trace;
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,104 @@
+#ifndef QUIC_CONGESTION_CONTROL_PRAGUE_CONGESTION_CONTROL
+#define QUIC_CONGESTION_CONTROL_PRAGUE_CONGESTION_CONTROL
+
+#include <memory>
+
+#include "quic/congestion_control/if_congestion_control.h"
+#include "quic/congestion_control/if_pacer.h"
+
+namespace quicx {
+namespace quic {
+
+/**
+ * @brief Prague congestion control for L4S (RFC 9330/9331,
+ * draft-briscoe-iccrg-prague-congestion-control).
+ *
+ * Packets are sent ECT(1), which steers them into the shallow L-queue of a
+ * DualQ AQM. That queue CE-marks as soon as its sojourn time passes about a
+ * millisecond, so marks are frequent and carry information in their rate:
+ *
+ *   alpha   EWMA (gain 1/16) of the fraction of bytes CE-marked per round
+ *           trip, updated once per round.
+ *   on CE   cwnd -= cwnd * alpha / 2, at most once per round trip (CWR).
+ *           With a steady 2 marks per RTT this keeps the queue near the
+ *           marking threshold instead of sawing between empty and full.
+ *   growth  slow start until the first CE or loss, then Reno-style
+ *           1 MSS per RTT.
+ *   on loss the classic response (cwnd *= beta), so Prague stays safe on
+ *           paths or bottlenecks that drop instead of marking.
+ */
+class PragueCongestionControl:
+    public ICongestionControl {
+public:
+    PragueCongestionControl();
+    ~PragueCongestionControl() override = default;
+
+    void Configure(const CcConfigV2& cfg) override;
+    void OnPacketSent(const SentPacketEvent& ev) override;
+    void OnPacketAcked(const AckEvent& ev) override;
+    void OnPacketLost(const LossEvent& ev) override;
+    void OnCongestionEvent(const std::vector<AckEvent>& acked, const std::vector<LossEvent>& lost,
+        uint64_t prior_in_flight, uint64_t event_time) override;
+    void OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay = 0) override;
+
+    SendState CanSend(uint64_t now, uint64_t& can_send_bytes) const override;
+
+    uint64_t GetCongestionWindow() const override { return cwnd_bytes_; }
+    uint64_t GetBytesInFlight() const override { return bytes_in_flight_; }
+    uint64_t GetPacingRateBytesPerSec() const override;
+    uint64_t NextSendTime(uint64_t now) const override;
+
+    bool InSlowStart() const override { return in_slow_start_; }
+    bool InRecovery() const override { return in_recovery_; }
+    uint64_t GetSsthresh() const override { return ssthresh_bytes_; }
+    bool SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) override;
+    bool UsesL4sEcn() const override { return true; }
+
+    void SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) override;
+
+    // Current CE fraction estimate, in [0, 1].
+    double GetAlpha() const { return alpha_; }
+
+    // EWMA gain for alpha (1/16, as in DCTCP).
+    static constexpr double kAlphaGain = 1.0 / 16.0;
+
+private:
+    void OnAck(const AckEvent& ev);
+    void OnLoss(const LossEvent& ev);
+    // Close the round if `largest_acked` passed its end: fold the round's CE
+    // fraction into alpha and start the next one.
+    void MaybeEndRound(uint64_t largest_acked);
+    void ReduceOnCe(uint64_t now);
+    void EnterRecovery(uint64_t now);
+    void UpdatePacingRate();
+
+    CcConfigV2 cfg_{};
+
+    uint64_t cwnd_bytes_ = 0;
+    uint64_t bytes_in_flight_ = 0;
+    uint64_t ssthresh_bytes_ = UINT64_MAX;
+    bool in_slow_start_ = true;
+    bool in_recovery_ = false;
+    uint64_t recovery_start_time_ = 0;
+    uint64_t srtt_us_ = 0;
+
+    // Round-trip accounting for alpha.
+    double alpha_ = 1.0;
+    uint64_t largest_sent_pn_ = 0;
+    uint64_t round_end_pn_ = 0;
+    uint64_t round_acked_bytes_ = 0;
+    uint64_t round_ce_bytes_ = 0;
+
+    // Congestion Window Reduced: no further CE reduction until a packet sent
+    // after the last one is acknowledged.
+    bool in_cwr_ = false;
+    uint64_t cwr_end_pn_ = 0;
+
+    std::unique_ptr<IPacer> pacer_;
+    std::shared_ptr<common::QlogTrace> qlog_trace_;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
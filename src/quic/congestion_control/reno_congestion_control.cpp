@@ -44,14 +44,38 @@ void RenoCongestionControl::OnPacketSent(const SentPacketEvent& ev) {
 }
 
 void RenoCongestionControl::OnPacketAcked(const AckEvent& ev) {
-    uint64_t old_bytes_in_flight = bytes_in_flight_;
-    uint64_t old_cwnd = cwnd_bytes_;
+    OnCongestionEvent({ev}, {}, bytes_in_flight_, ev.ack_time);
+}
 
-    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
+void RenoCongestionControl::OnPacketLost(const LossEvent& ev) {
+    OnCongestionEvent({}, {ev}, bytes_in_flight_, ev.lost_time);
+}
+
+void RenoCongestionControl::OnCongestionEvent(const std::vector<AckEvent>& acked,
+    const std::vector<LossEvent>& lost, uint64_t prior_in_flight, uint64_t event_time) {
+    (void)prior_in_flight;
+    (void)event_time;
+    // RFC 9002 Appendix A.7: losses first, so that ACKs for packets sent
+    // before the loss don't grow the window we just reduced.
+    for (const auto& ev : lost) {
+        OnLoss(ev);
+    }
+    for (const auto& ev : acked) {
+        OnAck(ev);
+    }
 
     // Metrics: Bytes in flight
     common::Metrics::GaugeSet(common::MetricsStd::BytesInFlight, bytes_in_flight_);
 
+    UpdatePacingRate();
+}
+
+void RenoCongestionControl::OnAck(const AckEvent& ev) {
+    uint64_t old_bytes_in_flight = bytes_in_flight_;
+    uint64_t old_cwnd = cwnd_bytes_;
+
+    bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_acked) ? bytes_in_flight_ - ev.bytes_acked : 0;
+
     LOG_DEBUG(
         "RenoCongestionControl::OnPacketAcked: pn=%llu, bytes_acked=%llu, bytes_in_flight: %llu->%llu, cwnd=%llu",
         ev.pn, ev.bytes_acked, old_bytes_in_flight, bytes_in_flight_, cwnd_bytes_);
@@ -61,7 +85,6 @@ void RenoCongestionControl::OnPacketAcked(const AckEvent& ev) {
         if (!in_recovery_) {
             EnterRecovery(ev.ack_time);
         }
-        UpdatePacingRate();
         return;
     }
     if (in_recovery_) {
@@ -87,24 +110,18 @@ void RenoCongestionControl::OnPacketAcked(const AckEvent& ev) {
 
     LOG_DEBUG("RenoCongestionControl::OnPacketAcked: cwnd: %llu->%llu, in_slow_start=%d", old_cwnd, cwnd_bytes_,
         in_slow_start_);
-
-    UpdatePacingRate();
 }
 
-void RenoCongestionControl::OnPacketLost(const LossEvent& ev) {
+void RenoCongestionControl::OnLoss(const LossEvent& ev) {
     uint64_t old_bytes_in_flight = bytes_in_flight_;
     bytes_in_flight_ = (bytes_in_flight_ > ev.bytes_lost) ? bytes_in_flight_ - ev.bytes_lost : 0;
 
-    // Metrics: Bytes in flight
-    common::Metrics::GaugeSet(common::MetricsStd::BytesInFlight, bytes_in_flight_);
-
     LOG_WARN(
         "RenoCongestionControl::OnPacketLost: pn=%llu, bytes_lost=%llu, bytes_in_flight: %llu->%llu, cwnd=%llu", ev.pn,
         ev.bytes_lost, old_bytes_in_flight, bytes_in_flight_, cwnd_bytes_);
     if (!in_recovery_) {
         EnterRecovery(ev.lost_time);
     }
-    UpdatePacingRate();
 }
 
 void RenoCongestionControl::OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay) {
@@ -221,6 +238,14 @@ void RenoCongestionControl::UpdatePacingRate() {
     common::Metrics::GaugeSet(common::MetricsStd::PacingRateBytesPerSec, pacing_rate);
 }
 
+bool RenoCongestionControl::SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) {
+    cwnd_bytes_ = std::min<uint64_t>(std::max<uint64_t>(cwnd_bytes, cfg_.min_cwnd_bytes), cfg_.max_cwnd_bytes);
+    ssthresh_bytes_ = ssthresh_bytes;
+    in_slow_start_ = cwnd_bytes_ < ssthresh_bytes_;
+    UpdatePacingRate();
+    return true;
+}
+
 void RenoCongestionControl::SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) {
     qlog_trace_ = trace;
 }
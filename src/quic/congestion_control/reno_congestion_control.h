@@ -19,6 +19,8 @@ public:
     void OnPacketSent(const SentPacketEvent& ev) override;
     void OnPacketAcked(const AckEvent& ev) override;
     void OnPacketLost(const LossEvent& ev) override;
+    void OnCongestionEvent(const std::vector<AckEvent>& acked, const std::vector<LossEvent>& lost,
+        uint64_t prior_in_flight, uint64_t event_time) override;
     void OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay = 0) override;
 
     SendState CanSend(uint64_t now, uint64_t& can_send_bytes) const override;
@@ -31,10 +33,14 @@ public:
     bool InSlowStart() const override { return in_slow_start_; }
     bool InRecovery() const override { return in_recovery_; }
     uint64_t GetSsthresh() const override { return ssthresh_bytes_; }
+    bool SetCongestionWindow(uint64_t cwnd_bytes, uint64_t ssthresh_bytes) override;
 
     void SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) override;
 
 private:
+    // Per-packet state updates; the pacing rate is refreshed once per event.
+    void OnAck(const AckEvent& ev);
+    void OnLoss(const LossEvent& ev);
     void IncreaseOnAck(uint64_t bytes_acked);
     void EnterRecovery(uint64_t now);
     void UpdatePacingRate();
@@ -61,4 +67,4 @@ private:
 } // namespace quic
 } // namespace quicx
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
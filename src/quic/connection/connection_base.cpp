@@ -1,8 +1,11 @@
 #include <cstring>
 #include <cstdio>
+#include <cstdlib>
 
 #include "common/buffer/buffer_chunk.h"
+#include "common/buffer/multi_block_buffer.h"
 #include "common/buffer/single_block_buffer.h"
+#include "common/buffer/standalone_buffer_chunk.h"
 #include "common/log/log.h"
 #include <quicx/common/metrics.h>
 #include <quicx/common/metrics_std.h>
@@ -20,8 +23,10 @@
 #include "quic/connection/connection_timer_coordinator.h"
 #include "quic/connection/encryption_level_scheduler.h"
 #include "quic/connection/error.h"
+#include "quic/connection/path_capacity_cache.h"
 #include "quic/connection/util.h"
 #include "quic/frame/connection_close_frame.h"
+#include "quic/frame/datagram_frame.h"
 #include "quic/frame/ping_frame.h"
 #include "quic/frame/type.h"
 #include "quic/packet/packet_number.h"
@@ -38,8 +43,9 @@ BaseConnection::BaseConnection(StreamIDGenerator::StreamStarter start, bool ecn_
     std::shared_ptr<common::IEventLoop> loop, const ConnectionCallbacks& callbacks):
     IConnection(callbacks),
     ecn_enabled_(ecn_enabled),
-    recv_control_(loop->GetTimer()),
-    send_manager_(loop->GetTimer()),
+    timer_multiplexer_(std::make_shared<common::TimerMultiplexer>(loop->GetTimer())),
+    recv_control_(timer_multiplexer_),
+    send_manager_(timer_multiplexer_),
     event_loop_(loop),
     last_communicate_time_(0),
     send_flow_controller_(start),
@@ -112,6 +118,10 @@ BaseConnection::BaseConnection(StreamIDGenerator::StreamStarter start, bool ecn_
     // Setup delayed ACK callback for normal Application packets
     recv_control_.SetActiveSendCB([this]() { ActiveSend(); });
 
+    // RFC 9000 §13.2.4: stop repeating ACK ranges the peer has confirmed.
+    send_manager_.GetSendControl().SetAckFrameAckedCallback(
+        [this](PacketNumberSpace ns, uint64_t largest_acked) { recv_control_.OnAckFrameAcked(ns, largest_acked); });
+
     transport_param_.AddTransportParamListener(
         [this](const auto& tp) { recv_control_.UpdateConfig(tp); });
     transport_param_.AddTransportParamListener(
@@ -124,6 +134,9 @@ BaseConnection::BaseConnection(StreamIDGenerator::StreamStarter start, bool ecn_
     // Set stream data ACK callback for tracking stream completion
     send_manager_.send_control_.SetStreamDataAckCallback(
         [this](auto a, auto b, auto c, auto d) { OnStreamDataAcked(a, b, c, d); });
+    // Lost STREAM ranges go back to their stream, which resends what is still unacked
+    send_manager_.send_control_.SetStreamDataLostCallback(
+        [this](auto a, auto b, auto c, auto d) { OnStreamDataLost(a, b, c, d); });
 
     // Initialize timer coordinator (refactored)
     timer_coordinator_ =
@@ -142,6 +155,10 @@ BaseConnection::BaseConnection(StreamIDGenerator::StreamStarter start, bool ecn_
     path_deps.to_send_frame_cb = [this](auto&& f) { ToSendFrame(std::forward<decltype(f)>(f)); };
     path_deps.active_send_cb   = [this]() { ActiveSend(); };
     path_deps.set_peer_addr_cb = [this](const common::Address& addr) { this->SetPeerAddress(addr); };
+    path_deps.timer            = timer_multiplexer_;
+    path_deps.send_on_path_cb  = [this](uint32_t path_id, std::shared_ptr<IFrame> frame) {
+        SendFrameOnPath(path_id, frame);
+    };
     path_manager_ = std::make_unique<PathManager>(std::move(path_deps));
 
     // Initialize encryption level scheduler (refactored) - centralizes encryption level selection
@@ -162,9 +179,15 @@ BaseConnection::BaseConnection(StreamIDGenerator::StreamStarter start, bool ecn_
     // Initialize frame processor (refactored) - uses IConnectionEventSink interface (no callbacks!)
     frame_processor_ = std::make_unique<FrameProcessor>(*this, state_machine_, connection_crypto_, send_manager_,
         *stream_manager_, *cid_coordinator_, *path_manager_, *connection_closer_, transport_param_, token_,
-        &send_flow_controller_, &recv_flow_controller_);
+        &send_flow_controller_, &recv_flow_controller_, &recv_control_);
     // Set application-level callbacks only
     frame_processor_->SetStreamStateCallback(stream_state_cb_);
+    frame_processor_->SetDatagramCallback([this](const common::SharedBufferSpan& data) { OnDatagramFrame(data); });
+    send_manager_.GetDatagramQueue().SetStatusCallback([this](uint64_t id, DatagramStatus status) {
+        if (datagram_status_cb_) {
+            datagram_status_cb_(id, status);
+        }
+    });
 
     // Metrics: Connection created
     common::Metrics::GaugeInc(common::MetricsStd::QuicConnectionsActive);
@@ -301,6 +324,84 @@ void BaseConnection::SetStreamStateCallBack(stream_state_callback cb) {
         "BaseConnection::SetStreamStateCallBack: callback updated in both IConnection and FrameProcessor");
 }
 
+uint64_t BaseConnection::SendDatagram(const uint8_t* data, uint32_t len, uint32_t ttl_ms) {
+    if ((!data && len > 0) || len > GetMaxDatagramSize()) {
+        LOG_WARN("BaseConnection::SendDatagram: rejected %u bytes, max datagram size %u", len, GetMaxDatagramSize());
+        return 0;
+    }
+    auto loop = event_loop_.lock();
+    if (!loop) {
+        return 0;
+    }
+
+    // The payload is copied into a standalone chunk: unlike the thread-local
+    // block pools it may be allocated on the caller's thread and released on
+    // the loop thread.
+    auto chunk = std::make_shared<common::StandaloneBufferChunk>(len > 0 ? len : 1);
+    if (!chunk->Valid()) {
+        LOG_ERROR("BaseConnection::SendDatagram: failed to allocate %u bytes", len);
+        return 0;
+    }
+    if (len > 0) {
+        memcpy(chunk->GetData(), data, len);
+    }
+    common::SharedBufferSpan span(chunk, chunk->GetData(), len);
+    uint64_t id = ++next_datagram_id_;
+
+    if (loop->IsInLoopThread()) {
+        return PushDatagram(id, span, ttl_ms) ? id : 0;
+    }
+
+    // Cross-thread path: the id is already handed out, so a datagram the
+    // queue refuses once the task runs is reported as dropped.
+    std::weak_ptr<BaseConnection> weak_self = std::static_pointer_cast<BaseConnection>(shared_from_this());
+    loop->PostTask([weak_self, id, span, ttl_ms]() {
+        auto self = weak_self.lock();
+        if (!self) {
+            return;
+        }
+        if (!self->PushDatagram(id, span, ttl_ms) && self->datagram_status_cb_) {
+            self->datagram_status_cb_(id, DatagramStatus::kDropped);
+        }
+    });
+    return id;
+}
+
+uint32_t BaseConnection::GetMaxDatagramSize() {
+    uint32_t peer_limit = peer_max_datagram_payload_.load(std::memory_order_relaxed);
+    if (peer_limit == 0) {
+        return 0;
+    }
+    // A DATAGRAM frame cannot be split, so it must also fit a single packet
+    // on the current path.
+    uint32_t budget = send_manager_.GetMaxPacketSize() - PacketBuilder::kPacketOverheadReserve;
+    uint32_t path_limit = budget - DatagramFrame::GetOverhead(budget);
+    return std::min(peer_limit, path_limit);
+}
+
+bool BaseConnection::PushDatagram(uint64_t id, const common::SharedBufferSpan& data, uint32_t ttl_ms) {
+    if (!state_machine_.CanSendData()) {
+        return false;
+    }
+    uint64_t expire_time = ttl_ms > 0 ? common::UTCTimeMsec() + ttl_ms : 0;
+    if (!send_manager_.GetDatagramQueue().Push(id, data, expire_time)) {
+        return false;
+    }
+    ActiveSend();
+    return true;
+}
+
+void BaseConnection::OnDatagramFrame(const common::SharedBufferSpan& data) {
+    if (!datagram_recv_cb_) {
+        return;
+    }
+    // Zero copy: the buffer references the received packet's block.
+    auto buffer =
+        std::make_shared<common::MultiBlockBuffer>(GlobalResource::Instance().GetThreadLocalBlockPool(), false);
+    buffer->Write(data);
+    datagram_recv_cb_(buffer);
+}
+
 uint64_t BaseConnection::AddTimer(timer_callback callback, uint32_t timeout_ms) {
     if (!timer_coordinator_) {
         LOG_ERROR("BaseConnection::AddTimer: timer_coordinator_ is null");
@@ -349,6 +450,9 @@ void BaseConnection::AddTransportParam(const QuicTransportParams& tp_config) {
         }
     }
     transport_param_.Init(tp);
+    if (version_ctx_.is_server && !tp.preferred_address_.empty()) {
+        AdvertisePreferredAddress(tp.preferred_address_);
+    }
 
     // RFC 9368 §3: Include the version_information (id 0x11) transport parameter.
     // chosen_version is the version this endpoint is currently using for its Initial
@@ -365,6 +469,77 @@ void BaseConnection::AddTransportParam(const QuicTransportParams& tp_config) {
     }
 }
 
+void BaseConnection::AdvertisePreferredAddress(const std::string& addr) {
+    // "ip:port", with the IPv6 form written as "[ip]:port"
+    auto pos = addr.rfind(':');
+    if (pos == std::string::npos || pos == 0 || pos + 1 == addr.size()) {
+        LOG_WARN("Invalid preferred address format: %s (expected ip:port)", addr.c_str());
+        return;
+    }
+    std::string ip = addr.substr(0, pos);
+    if (ip.size() > 2 && ip.front() == '[' && ip.back() == ']') {
+        ip = ip.substr(1, ip.size() - 2);
+    }
+    uint16_t port = static_cast<uint16_t>(std::strtoul(addr.c_str() + pos + 1, nullptr, 10));
+
+    // the CID handed out with a preferred address has sequence number 1
+    auto local_cid_manager = cid_coordinator_->GetLocalConnectionIDManager();
+    if (local_cid_manager->GetAvailableIDCount() != 1) {
+        LOG_WARN("preferred address not advertised: local CID pool already holds %zu CIDs",
+            local_cid_manager->GetAvailableIDCount());
+        return;
+    }
+    PreferredAddress preferred;
+    if (common::Address::CheckAddressType(ip) == common::AddressType::kIpv6) {
+        preferred.ipv6 = common::Address(ip, port);
+    } else {
+        preferred.ipv4 = common::Address(ip, port);
+    }
+    preferred.cid = local_cid_manager->Generator();
+    // random like the reset tokens of NEW_CONNECTION_ID frames
+    preferred.stateless_reset_token.resize(16);
+    for (auto& byte : preferred.stateless_reset_token) {
+        byte = static_cast<char>(rand() % 256);
+    }
+    if (!transport_param_.SetPreferredAddress(preferred)) {
+        LOG_WARN("preferred address not advertised: cannot encode %s", addr.c_str());
+        return;
+    }
+    LOG_INFO("Advertising preferred address %s:%d", ip.c_str(), port);
+}
+
+void BaseConnection::OnPreferredAddress(const TransportParam& remote_tp) {
+    PreferredAddress preferred;
+    if (!remote_tp.GetPreferredAddress(preferred)) {
+        return;
+    }
+    // The CID is ours to use whether or not we migrate, but only on the new
+    // path (RFC 9000 §9.5): AddID() makes the first CID of an empty pool the
+    // current one, so put the handshake CID back.
+    auto remote_cid_manager = cid_coordinator_->GetRemoteConnectionIDManager();
+    ConnectionID handshake_cid = remote_cid_manager->GetCurrentID();
+    remote_cid_manager->AddID(preferred.cid);
+    if (remote_cid_manager->GetCurrentID() != handshake_cid) {
+        remote_cid_manager->SetCurrentID(
+            handshake_cid.GetID(), handshake_cid.GetLength(), handshake_cid.GetSequenceNumber());
+    }
+
+    if (transport_param_.GetDisableActiveMigration()) {
+        return;
+    }
+    const common::Address& addr = GetPeerAddress().IsIPv6() ? preferred.ipv6 : preferred.ipv4;
+    if (addr.GetPort() == 0) {
+        LOG_DEBUG("Server advertised no preferred address of our address family");
+        return;
+    }
+    if (addr == GetPeerAddress()) {
+        LOG_DEBUG("Preferred address is same as current address, no migration needed");
+        return;
+    }
+    LOG_INFO("Client initiating migration to server's preferred address: %s:%d", addr.GetIp().c_str(), addr.GetPort());
+    path_manager_->MigrateToPreferredAddress(addr, preferred.cid.GetSequenceNumber());
+}
+
 bool BaseConnection::EncodeAndPushTpToTls(TransportParam& tp) {
     if (!tls_connection_) return false;
     // Sizing rationale (1024 bytes): the QUIC v1 standard transport
@@ -571,6 +746,10 @@ uint64_t BaseConnection::GetConnectionIDHash() {
 }
 
 void BaseConnection::OnPackets(uint64_t now, std::vector<std::shared_ptr<IPacket>>& packets) {
+    // Multipath: path of these packets, see SetRecvConnectionID()
+    uint32_t path_id = recv_path_id_;
+    recv_path_id_ = 0;
+
     // Closing state: Check if packet contains CONNECTION_CLOSE, otherwise retransmit
     if (state_machine_.IsClosing()) {
         HandlePacketsInClosingState(now, packets);
@@ -583,23 +762,91 @@ void BaseConnection::OnPackets(uint64_t now, std::vector<std::shared_ptr<IPacket
         return;
     }
 
+    // Multipath: a datagram of another path is acknowledged in that path's
+    // packet number space. The server sets up a path the first time the peer
+    // uses one of its CIDs, and drops it again if nothing decrypts.
+    bool new_path = false;
+    if (path_id != 0 && !path_manager_->HasPath(path_id)) {
+        path_manager_->AcceptPath(path_id, recv_peer_addr_, recv_sockfd_);
+        if (!path_manager_->HasPath(path_id)) {
+            LOG_DEBUG("BaseConnection::OnPackets: datagram for unusable path %u dropped", path_id);
+            return;
+        }
+        new_path = true;
+    }
+
     // Normal processing for Connecting/Connected states
     // Accumulate ECN to ACK_ECN counters based on first packet number space
     if (!packets.empty() && ecn_enabled_) {
         auto ns = CryptoLevel2PacketNumberSpace(packets[0]->GetCryptoLevel());
-        recv_control_.OnEcnCounters(pending_ecn_, ns);
+        GetPathRecvControl(path_id).OnEcnCounters(pending_ecn_, ns);
     }
+    bool path_processed = false;
     for (size_t i = 0; i < packets.size(); i++) {
+        recv_path_id_ = path_id;
         bool packet_processed = DispatchByType(packets[i]);
+        recv_path_id_ = 0;
 
         // After processing (decrypting and decoding frames), record packet for ACK tracking
         if (packet_processed) {
-            recv_control_.OnPacketRecv(now, packets[i]);
+            // the frames may have abandoned the path meanwhile
+            if (path_id != 0 && !path_manager_->HasPath(path_id)) {
+                continue;
+            }
+            GetPathRecvControl(path_id).OnPacketRecv(now, packets[i]);
+            packets_received_++;
+            bytes_received_ += packets[i]->GetSrcBuffer().GetLength();
+            path_processed = true;
+            if (path_id == 0) {
+                FollowPeerSocket(packets[i]);
+            }
+        }
+    }
+    if (path_id != 0) {
+        if (path_processed) {
+            path_manager_->OnPathPacketReceived(path_id, recv_peer_addr_, recv_sockfd_);
+        } else if (new_path) {
+            path_manager_->DiscardPath(path_id);
         }
     }
 
     // reset idle timeout timer task
     timer_coordinator_->ResetIdleTimer();
+    PublishStats();
+}
+
+void BaseConnection::SetRecvConnectionID(ConnectionID& cid) {
+    recv_path_id_ = path_manager_->IsMultipathEnabled() ? cid_coordinator_->FindPathByLocalConnectionID(cid.Hash()) : 0;
+}
+
+RecvControl& BaseConnection::GetPathRecvControl(uint32_t path_id) {
+    RecvControl* recv_control = path_id == 0 ? nullptr : path_manager_->GetPathRecvControl(path_id);
+    return recv_control ? *recv_control : recv_control_;
+}
+
+void BaseConnection::SetRecvSocket(int32_t sockfd) {
+    recv_sockfd_ = sockfd;
+    if (sockfd_ <= 0) {
+        sockfd_ = sockfd;
+    }
+}
+
+void BaseConnection::FollowPeerSocket(std::shared_ptr<IPacket>& packet) {
+    // the client picks its own sockets (InitiateMigration)
+    if (!version_ctx_.is_server || packet->GetCryptoLevel() != kApplication || IsProbingPacket(packet->GetFrameTypeBit())) {
+        return;
+    }
+    uint64_t pn = packet->GetPacketNumber();
+    if (has_non_probing_pn_ && pn <= largest_non_probing_pn_) {
+        return;  // reordered: an older packet does not move the path back
+    }
+    has_non_probing_pn_ = true;
+    largest_non_probing_pn_ = pn;
+    // a client-initiated migration switches sockets itself (OnMigrationComplete)
+    if (recv_sockfd_ > 0 && recv_sockfd_ != sockfd_ && migration_sockfd_ <= 0) {
+        LOG_INFO("peer moved to socket %d (was %d) with packet %llu", recv_sockfd_, sockfd_, pn);
+        sockfd_ = recv_sockfd_;
+    }
 }
 
 void BaseConnection::HandlePacketsInClosingState(uint64_t now,
@@ -787,6 +1034,8 @@ bool BaseConnection::On1rttPacket(const std::shared_ptr<IPacket>& packet) {
     auto rtt1_pkt = std::dynamic_pointer_cast<Rtt1Packet>(packet);
     if (rtt1_pkt) {
         rtt1_pkt->SetExpectedKeyPhase(connection_crypto_.GetCurrentKeyPhase());
+        // multipath: the path id is part of the AEAD nonce
+        rtt1_pkt->SetPathId(recv_path_id_);
     }
 
     // Try normal decrypt path
@@ -924,7 +1173,7 @@ bool BaseConnection::OnNormalPacket(const std::shared_ptr<IPacket>& packet) {
     // The full PN is recovered from the truncated encoding using the largest PN
     // successfully received so far in the same packet number space.
     auto ns = CryptoLevel2PacketNumberSpace(packet->GetCryptoLevel());
-    packet->SetLargestReceivedPn(recv_control_.GetLargestReceivedPn(ns));
+    packet->SetLargestReceivedPn(GetPathRecvControl(recv_path_id_).GetLargestReceivedPn(ns));
 
     // PERF: previously this path allocated a pooled BufferChunk + SingleBlockBuffer
     // here and passed it as `out_plaintext` to DecodeWithCrypto. Site-attribution
@@ -1019,6 +1268,11 @@ void BaseConnection::OnTransportParams(TransportParam& remote_tp) {
     send_flow_controller_.UpdateConfig(remote_tp);
     recv_control_.UpdateConfig(remote_tp);
     send_manager_.UpdateConfig(remote_tp);
+    // - PmtuProber: the peer's max_udp_payload_size bounds the PLPMTU search
+    send_manager_.SetPeerMaxUdpPayloadSize(remote_tp.GetmaxUdpPayloadSize());
+    // - DatagramQueue: the peer's max_datagram_frame_size bounds the DATAGRAM frames we send
+    send_manager_.SetPeerMaxDatagramFrameSize(remote_tp.GetMaxDatagramFrameSize());
+    peer_max_datagram_payload_.store(send_manager_.GetDatagramQueue().GetMaxPayloadSize(), std::memory_order_relaxed);
 
     // Remember remote transport params for 0-RTT session caching (RFC 9000 Section 7.4.1)
     remote_tp_snapshot_ = RemoteTransportParamSnapshot::From(remote_tp);
@@ -1028,52 +1282,21 @@ void BaseConnection::OnTransportParams(TransportParam& remote_tp) {
     // Start idle timeout timer through coordinator
     timer_coordinator_->StartIdleTimer([this]() { OnIdleTimeout(); });
 
-    // Preferred Address Migration (RFC 9000 Section 9.6)
-    //
-    // IMPORTANT: This is CLIENT-SIDE ONLY logic for handling server's preferred address.
-    //
-    // How it works:
-    // 1. SERVER: Advertises a preferred_address in transport parameters during handshake
-    //    - This is typically used when the server wants the client to use a different address
-    //    - Example: Load balancer forwards initial connection, server wants client to connect directly
-    //    - Server sets this via transport_param.SetPreferredAddress("ip:port") before handshake
-    //
-    // 2. CLIENT: Receives preferred_address and decides whether to migrate (this code)
-    //    - Only if active migration is not disabled
-    //    - Only if the preferred address is different from current peer address
-    //    - Initiates path validation to the new address
-    //    - If validation succeeds, switches to the new address
-    //
-    // 3. SERVER: Does NOT actively migrate its own address
-    //    - Server continues listening on all its addresses
-    //    - Server responds to PATH_CHALLENGE from client on the preferred address
-    //    - After client validates, communication happens on the new address
-    //
-    if (!transport_param_.GetDisableActiveMigration()) {
-        const auto& pref = transport_param_.GetPreferredAddress();
-        if (!pref.empty()) {
-            LOG_INFO("Server advertised preferred address: %s", pref.c_str());
-
-            // Parse "ip:port" format
-            auto pos = pref.find(':');
-            if (pos != std::string::npos) {
-                common::Address addr(pref.substr(0, pos), static_cast<uint16_t>(std::stoi(pref.substr(pos + 1))));
-                if (!(addr == GetPeerAddress())) {
-                    LOG_INFO("Client initiating migration to server's preferred address: %s:%d",
-                        addr.GetIp().c_str(), addr.GetPort());
-                    path_manager_->OnObservedPeerAddress(addr);
-                } else {
-                    LOG_DEBUG("Preferred address is same as current address, no migration needed");
-                }
-            } else {
-                LOG_WARN("Invalid preferred address format: %s (expected ip:port)", pref.c_str());
-            }
-        }
+    // Preferred Address Migration (RFC 9000 Section 9.6): the server
+    // advertises an address it wants the client on after the handshake,
+    // e.g. a socket owned by the worker thread serving this connection.
+    // The client validates it with PATH_CHALLENGE and switches to it, and to
+    // the CID that came with it, once the PATH_RESPONSE arrives.
+    if (!version_ctx_.is_server) {
+        OnPreferredAddress(remote_tp);
     }
 
     // Initialize local CID pool for potential path migrations
     CheckAndReplenishLocalCIDPool();
 
+    // Multipath: issue the CIDs of the paths both sides allow
+    path_manager_->OnMultipathNegotiated();
+
     // Start any deferred path probes now that Application keys should be ready
     // (OnTransportParams is called after handshake completes)
     path_manager_->StartNextPathProbe();
@@ -1168,6 +1391,11 @@ EncryptionLevel BaseConnection::GetCurEncryptionLevel() {
 }
 
 void BaseConnection::OnObservedPeerAddress(const common::Address& addr) {
+    recv_peer_addr_ = addr;
+    // another multipath path moving is handled by OnPackets()
+    if (recv_path_id_ != 0) {
+        return;
+    }
     if (path_manager_) {
         path_manager_->OnObservedPeerAddress(addr);
     }
@@ -1207,6 +1435,18 @@ void BaseConnection::OnStreamDataReady(std::shared_ptr<IStream> stream) {
 }
 
 void BaseConnection::OnFrameReady(std::shared_ptr<IFrame> frame) {
+    // RFC 9000 §8.2.2: a PATH_RESPONSE goes out on the path its PATH_CHALLENGE
+    // came in on. On another of our sockets than the send socket (a preferred
+    // address being probed) it is answered from there right away, and so it
+    // is on another multipath path.
+    if (frame->GetType() == FrameType::kPathResponse && recv_path_id_ != 0 &&
+        SendFrameOnPath(recv_path_id_, frame)) {
+        return;
+    }
+    if (frame->GetType() == FrameType::kPathResponse && recv_sockfd_ > 0 && recv_sockfd_ != sockfd_ &&
+        SendImmediateFrame(frame, kApplication, recv_sockfd_)) {
+        return;
+    }
     // Delegate to existing ToSendFrame method
     ToSendFrame(frame);
 }
@@ -1221,6 +1461,14 @@ void BaseConnection::OnStreamClosed(uint64_t stream_id) {
     InnerStreamClose(stream_id);
 }
 
+void BaseConnection::OnStreamDataConsumed(uint64_t bytes) {
+    recv_flow_controller_.OnDataConsumed(bytes);
+    std::shared_ptr<IFrame> frame;
+    if (recv_flow_controller_.ShouldSendMaxData(frame, common::UTCTimeMsec(), send_manager_.GetRtt()) && frame) {
+        ToSendFrame(frame);
+    }
+}
+
 void BaseConnection::OnConnectionClose(uint64_t error, uint16_t frame_type, const std::string& reason) {
     // Delegate to existing InnerConnectionClose method
     InnerConnectionClose(error, frame_type, reason);
@@ -1230,7 +1478,7 @@ void BaseConnection::OnConnectionClose(uint64_t error, uint16_t frame_type, cons
 
 // Immediate send for critical frames (ACK, PATH_CHALLENGE/RESPONSE, CONNECTION_CLOSE)
 // Bypasses normal send path for low latency
-bool BaseConnection::SendImmediate(std::shared_ptr<common::IBuffer> buffer) {
+bool BaseConnection::SendImmediate(std::shared_ptr<common::IBuffer> buffer, int32_t sockfd) {
     if (!buffer || buffer->GetDataLength() == 0) {
         LOG_WARN("SendImmediate: empty buffer");
         return false;
@@ -1241,10 +1489,11 @@ bool BaseConnection::SendImmediate(std::shared_ptr<common::IBuffer> buffer) {
         auto net_packet = std::make_shared<NetPacket>();
         net_packet->SetData(buffer);
         // During migration, use migration socket for sending
-        int32_t send_sock = (migration_sockfd_ > 0) ? migration_sockfd_ : sockfd_;
+        int32_t send_sock = sockfd > 0 ? sockfd : (migration_sockfd_ > 0) ? migration_sockfd_ : sockfd_;
         net_packet->SetSocket(send_sock);
         net_packet->SetAddress(AcquireSendAddress());
         net_packet->SetTime(common::UTCTimeMsec());
+        net_packet->SetEcn(OutgoingEcnCodepoint());
 
         bool result = sender_->Send(net_packet);
         if (result) {
@@ -1320,6 +1569,11 @@ void BaseConnection::OnStreamDataAcked(uint64_t stream_id, uint64_t offset_start
     stream_manager_->OnStreamDataAcked(stream_id, offset_start, length, has_fin);
 }
 
+void BaseConnection::OnStreamDataLost(uint64_t stream_id, uint64_t offset_start, uint64_t length, bool has_fin) {
+    // Delegate to stream manager
+    stream_manager_->OnStreamDataLost(stream_id, offset_start, length, has_fin);
+}
+
 void BaseConnection::AddConnectionId(ConnectionID& id) {
     if (add_conn_id_cb_) {
         add_conn_id_cb_(id, shared_from_this());
@@ -1419,6 +1673,35 @@ MigrationResult BaseConnection::InitiateMigrationTo(const std::string& local_ip,
     return result;
 }
 
+uint32_t BaseConnection::OpenPath(const std::string& local_ip, uint16_t local_port) {
+    if (version_ctx_.is_server) {
+        LOG_WARN("OpenPath: only the client opens paths");
+        return 0;
+    }
+    if (!state_machine_.CanSendData()) {
+        LOG_WARN("OpenPath: connection not in connected state");
+        return 0;
+    }
+
+    uint32_t path_id = path_manager_->OpenPath(common::Address(local_ip, local_port));
+    // the answer to the PATH_CHALLENGE arrives on the socket of the path
+    if (path_id != 0 && register_socket_cb_) {
+        int32_t sockfd = path_manager_->GetPathSocket(path_id);
+        if (!register_socket_cb_(sockfd)) {
+            LOG_ERROR("OpenPath: failed to register socket %d of path %u with receiver", sockfd, path_id);
+        }
+    }
+    return path_id;
+}
+
+bool BaseConnection::ClosePath(uint32_t path_id) {
+    if (path_id == 0 || !path_manager_->ClosePath(path_id)) {
+        return false;
+    }
+    ActiveSend();
+    return true;
+}
+
 void BaseConnection::SetMigrationCallback(migration_callback cb) {
     migration_cb_ = cb;
 }
@@ -1502,6 +1785,8 @@ void BaseConnection::OnStateToConnected() {
 }
 
 void BaseConnection::OnStateToClosing() {
+    SavePathCapacity();
+
     // Log connection_state_updated event to qlog
     if (qlog_trace_) {
         common::ConnectionStateUpdatedData data;
@@ -1577,6 +1862,8 @@ void BaseConnection::OnStateToClosing() {
 }
 
 void BaseConnection::OnStateToDraining() {
+    SavePathCapacity();
+
     // Log connection_state_updated event to qlog
     if (qlog_trace_) {
         common::ConnectionStateUpdatedData data;
@@ -1614,6 +1901,8 @@ void BaseConnection::OnStateToDraining() {
 }
 
 void BaseConnection::OnStateToClosed() {
+    SavePathCapacity();
+
     // Log connection_closed event
     if (qlog_trace_) {
         common::ConnectionClosedData data;
@@ -1641,6 +1930,34 @@ void BaseConnection::OnStateToClosed() {
     connection_closer_->InvokeConnectionCloseCallback(shared_from_this(), QuicErrorCode::kNoError, "normal close.");
 }
 
+void BaseConnection::SetStreamScheduler(StreamSchedulerType type) {
+    stream_manager_->SetStreamScheduler(type);
+}
+
+void BaseConnection::SetSendBufferWatermarks(
+    uint32_t stream_high, uint32_t stream_low, uint32_t conn_high, uint32_t conn_low) {
+    stream_manager_->SetSendBufferWatermarks(stream_high, stream_low, conn_high, conn_low);
+}
+
+void BaseConnection::EnableCarefulResume(const std::string& path_key) {
+    path_capacity_key_ = path_key;
+    PathCapacity saved;
+    if (!path_key.empty() && PathCapacityCache::Instance().Lookup(path_key, saved)) {
+        send_manager_.GetSendControl().StartCarefulResume(saved);
+    }
+}
+
+void BaseConnection::SavePathCapacity() {
+    if (path_capacity_key_.empty()) {
+        return;
+    }
+    PathCapacity observed;
+    if (send_manager_.GetSendControl().GetObservedPathCapacity(observed)) {
+        PathCapacityCache::Instance().Store(path_capacity_key_, observed);
+    }
+    path_capacity_key_.clear();
+}
+
 // ==================== New High-Level Send Interfaces Implementation ====================
 
 bool BaseConnection::TrySend() {
@@ -1660,17 +1977,82 @@ bool BaseConnection::TrySend() {
     // fall through to the normal-send path. Both helpers preserve the
     // original return-value contract used by Worker::ProcessSend (true ⇒
     // re-enter TrySend, false ⇒ stop this round).
-    if (send_manager_.GetSendControl().NeedReSend()) {
-        return TrySendRetransmit();
+    bool more = send_manager_.GetSendControl().NeedReSend() ? TrySendRetransmit() : TrySendNew();
+    if (!more) {
+        PublishStats();
+    }
+    return more;
+}
+
+void BaseConnection::PublishStats() {
+    QuicConnectionStats stats;
+    stats.snapshot_time_ms_ = common::UTCTimeMsec();
+    send_manager_.FillStats(stats);
+    stats.packets_received_ = packets_received_;
+    stats.bytes_received_ = bytes_received_;
+    stats.streams_active_ = stream_manager_->GetStreamCount();
+    stats.streams_opened_ = stream_manager_->GetOpenedStreamCount();
+    stats.flow_control_blocked_ms_ = send_flow_controller_.GetBlockedTime(stats.snapshot_time_ms_);
+    stats_snapshot_.Publish(stats);
+    if (bandwidth_cb_) {
+        ReportBandwidthIfChanged(stats);
+    }
+}
+
+void BaseConnection::SetBandwidthCallBack(bandwidth_callback cb, double min_change) {
+    auto loop = event_loop_.lock();
+    if (loop && !loop->IsInLoopThread()) {
+        auto weak_self = weak_from_this();
+        loop->RunInLoop([weak_self, cb, min_change]() {
+            auto self = std::dynamic_pointer_cast<BaseConnection>(weak_self.lock());
+            if (self) {
+                self->SetBandwidthCallBack(cb, min_change);
+            }
+        });
+        return;
+    }
+    bandwidth_cb_ = cb;
+    bandwidth_min_change_ = min_change > 0 ? min_change : 0;
+    // the first estimate after (re)arming is always reported
+    last_bandwidth_report_ = BandwidthInfo();
+}
+
+static bool MovedBy(uint64_t last, uint64_t now, double fraction) {
+    if (last == 0) {
+        return now != 0;
+    }
+    uint64_t delta = now > last ? now - last : last - now;
+    return static_cast<double>(delta) > static_cast<double>(last) * fraction;
+}
+
+void BaseConnection::ReportBandwidthIfChanged(const QuicConnectionStats& stats) {
+    bool app_limited = stats.app_limited_ != 0;
+    if (!MovedBy(last_bandwidth_report_.bandwidth_estimate_bytes_per_sec_, stats.bandwidth_estimate_bytes_per_sec_,
+            bandwidth_min_change_) &&
+        !MovedBy(last_bandwidth_report_.delivery_rate_bytes_per_sec_, stats.delivery_rate_bytes_per_sec_,
+            bandwidth_min_change_) &&
+        app_limited == last_bandwidth_report_.app_limited_) {
+        return;
     }
-    return TrySendNew();
+    BandwidthInfo info;
+    info.bandwidth_estimate_bytes_per_sec_ = stats.bandwidth_estimate_bytes_per_sec_;
+    info.delivery_rate_bytes_per_sec_ = stats.delivery_rate_bytes_per_sec_;
+    info.pacing_rate_bytes_per_sec_ = stats.pacing_rate_bytes_per_sec_;
+    info.cwnd_bytes_ = stats.cwnd_bytes_;
+    info.smoothed_rtt_ms_ = stats.smoothed_rtt_ms_;
+    info.app_limited_ = app_limited;
+    last_bandwidth_report_ = info;
+    bandwidth_cb_(info);
 }
 
 bool BaseConnection::TrySendRetransmit() {
     // RFC 9000 §13.3: Retransmit lost packets first.
-    // QUIC does not retransmit lost packets directly. Instead, the lost packet
-    // (which still holds its original payload/frames) is re-encoded with a new
+    // Only Initial/Handshake packets end up here: the lost packet (which
+    // still holds its original payload/frames) is re-encoded with a new
     // packet number and re-encrypted, then sent as a brand-new packet.
+    // Lost application-space packets are never replayed; SendControl hands
+    // their STREAM ranges back to the streams and their control frames back
+    // to SendManager, and TrySendNew packs whatever is still needed.
     auto& send_control = send_manager_.GetSendControl();
     auto& lost_packets = send_control.GetLostPacket();
     auto lost_entry = lost_packets.front();
@@ -1698,8 +2080,6 @@ bool BaseConnection::TrySendRetransmit() {
     // Assign new packet number
     auto ns = CryptoLevel2PacketNumberSpace(crypto_level);
     uint64_t new_pn = send_manager_.GetPacketNumber().NextPacketNumber(ns);
-    // [DIAG-RTX] Capture the *original* PN before we overwrite it, so the
-    // first-send log line can be correlated with this retransmission.
     uint64_t orig_pn = lost_pkt->GetPacketNumber();
     lost_pkt->SetPacketNumber(new_pn);
     lost_pkt->GetHeader()->SetPacketNumberLength(PacketNumber::GetPacketNumberLength(new_pn));
@@ -1727,25 +2107,6 @@ bool BaseConnection::TrySendRetransmit() {
     }
     auto buffer = std::make_shared<common::SingleBlockBuffer>(chunk);
 
-    // [DIAG-RTX] Snapshot the payload bytes that lost_pkt is about to re-encode.
-    // Compare with the matching "first-send pn=<old_pn>" log to determine
-    // whether the SharedBufferSpan still points to the original plaintext or
-    // whether the underlying chunk has been overwritten / freed by some
-    // intermediate path.
-    if (auto rtt1 = std::dynamic_pointer_cast<Rtt1Packet>(lost_pkt)) {
-        auto pl = rtt1->GetPayload();
-        char head[64] = {0};
-        uint32_t dump_len = pl.GetLength() < 16 ? pl.GetLength() : 16;
-        for (uint32_t i = 0; i < dump_len; ++i) {
-            std::snprintf(head + i * 3, sizeof(head) - i * 3, "%02x ",
-                pl.Valid() ? pl.GetStart()[i] : 0);
-        }
-        LOG_INFO("[DIAG-RTX] retransmit-pre orig_pn=%llu new_pn=%llu payload_len=%u "
-                 "payload_valid=%d chunk=%p head=%s",
-            (unsigned long long)orig_pn, (unsigned long long)new_pn, pl.GetLength(),
-            (int)pl.Valid(), (void*)pl.GetChunk().get(), head);
-    }
-
     if (!lost_pkt->Encode(buffer)) {
         LOG_ERROR("BaseConnection::TrySendRetransmit: failed to re-encode lost packet pn=%llu", new_pn);
         return false;
@@ -1770,9 +2131,9 @@ bool BaseConnection::TrySendRetransmit() {
                       ",len=" + std::to_string(sd.length) +
                       ",fin=" + std::to_string(sd.has_fin) + "}";
     }
-    LOG_INFO("BaseConnection::TrySendRetransmit: retransmitted lost packet with new pn=%llu, size=%u, "
+    LOG_INFO("BaseConnection::TrySendRetransmit: retransmitted lost packet pn=%llu with new pn=%llu, size=%u, "
                     "stream_data count=%zu ranges=%s",
-        new_pn, encoded_size, lost_entry.stream_data.size(), sd_summary.c_str());
+        orig_pn, new_pn, encoded_size, lost_entry.stream_data.size(), sd_summary.c_str());
 
     return SendBuffer(buffer);
 }
@@ -1793,8 +2154,18 @@ bool BaseConnection::TrySendNew() {
         return false;
     }
 
+    // 3b. Multipath: a 1-RTT packet goes out on the path the path scheduler
+    // picks, falling back to path 0 when none is usable
+    uint32_t path_id = 0;
+    if (send_ctx.level == kApplication && send_manager_.GetPathCount() > 1) {
+        uint64_t selected = send_manager_.SelectPath();
+        if (selected != kInvalidPathId) {
+            path_id = static_cast<uint32_t>(selected);
+        }
+    }
+
     // 4. Check congestion window
-    uint32_t max_bytes = send_manager_.GetAvailableWindow();
+    uint32_t max_bytes = send_manager_.GetPathAvailableWindow(path_id);
     if (max_bytes == 0) {
         // RFC 9000 §9.3.3: An endpoint sending a probing packet on a path is exempt from
         // amplification limits and any congestion limits that would prevent that packet from
@@ -1823,6 +2194,15 @@ bool BaseConnection::TrySendNew() {
         }
     }
 
+    // 4b. RFC 9000 §14.3: a due DPLPMTUD probe goes out ahead of data
+    // (only path 0 is probed)
+    if (send_ctx.level == kApplication && path_id == 0) {
+        uint16_t probe_size = send_manager_.GetMtuProbeSize();
+        if (probe_size > 0 && TrySendMtuProbe(cryptographer, probe_size)) {
+            return true;
+        }
+    }
+
     // 5. Get pending frames
     auto frames = send_manager_.GetPendingFrames(send_ctx.level, max_bytes);
     LOG_DEBUG("BaseConnection::TrySend: got %zu pending frames", frames.size());
@@ -1836,13 +2216,37 @@ bool BaseConnection::TrySendNew() {
         }
     }
 
+    // 6b. Multipath: due PATH_ACKs of the other paths go out on any path
+    if (send_ctx.level == kApplication && path_manager_->IsMultipathEnabled()) {
+        for (uint32_t ack_path_id : path_manager_->GetPathIds()) {
+            RecvControl& path_recv_control = GetPathRecvControl(ack_path_id);
+            if (!path_recv_control.ShouldSendAckNow(kApplicationNumberSpace)) {
+                continue;
+            }
+            auto path_ack = path_recv_control.MayGenerateAckFrame(
+                common::UTCTimeMsec(), kApplicationNumberSpace, ecn_enabled_);
+            if (path_ack) {
+                frames.insert(frames.begin(), path_ack);
+                LOG_DEBUG("BaseConnection::TrySend: added PATH_ACK frame for path %u", ack_path_id);
+            }
+        }
+    }
+
     // 7. Check if there's stream data to send
     bool has_stream_data = send_manager_.HasStreamData(send_ctx.level);
     LOG_DEBUG("BaseConnection::TrySend: has_stream_data=%d", has_stream_data);
 
+    // 7b. RFC 9221: unreliable datagrams only go out in 1-RTT packets, and
+    // not while the path is still being validated
+    bool has_datagram = send_ctx.level == kApplication && send_manager_.streams_allowed_ &&
+                        !send_manager_.GetDatagramQueue().Empty();
+
     // 8. If no data at all, return
-    if (frames.empty() && !has_stream_data) {
+    if (frames.empty() && !has_stream_data && !has_datagram) {
         LOG_DEBUG("BaseConnection::TrySend: no data to send");
+        if (send_ctx.level == kApplication) {
+            send_manager_.SetAppLimited();
+        }
         common::Metrics::CounterInc(common::MetricsStd::DiagTrySendNoData);
         return false;
     }
@@ -1851,15 +2255,20 @@ bool BaseConnection::TrySendNew() {
     PacketBuilder::DataPacketContext build_ctx;
     build_ctx.level = send_ctx.level;
     build_ctx.cryptographer = cryptographer;
-    build_ctx.local_cid_manager = cid_coordinator_->GetLocalConnectionIDManager().get();
-    build_ctx.remote_cid_manager = cid_coordinator_->GetRemoteConnectionIDManager().get();
+    auto local_cid_manager = cid_coordinator_->GetPathLocalConnectionIDManager(path_id);
+    auto remote_cid_manager = cid_coordinator_->GetPathRemoteConnectionIDManager(path_id);
+    build_ctx.local_cid_manager = local_cid_manager.get();
+    build_ctx.remote_cid_manager = remote_cid_manager.get();
     build_ctx.quic_version = connection_crypto_.GetVersion();
     build_ctx.key_phase = connection_crypto_.GetCurrentKeyPhase();
+    build_ctx.path_id = path_id;
     build_ctx.frames = std::move(frames);
     build_ctx.stream_manager = stream_manager_.get();
     build_ctx.include_stream_data = has_stream_data;
+    build_ctx.datagram_queue = has_datagram ? &send_manager_.GetDatagramQueue() : nullptr;
     build_ctx.add_padding = (send_ctx.level == kInitial);
     build_ctx.min_size = kMinInitialPacketSize;  // RFC 9000 §14.1
+    build_ctx.max_packet_size = send_manager_.GetPathMaxPacketSize(path_id);
     build_ctx.token = send_manager_.GetToken();
 
     // Set connection-level flow control limit for stream data
@@ -1936,7 +2345,8 @@ bool BaseConnection::TrySendNew() {
     }
 
     // 10. Build packet - allocate buffer chunk first
-    auto chunk = std::make_shared<common::BufferChunk>(quic::GlobalResource::Instance().GetThreadLocalBlockPool());
+    auto chunk = std::make_shared<common::BufferChunk>(
+        quic::GlobalResource::Instance().GetThreadLocalBlockPool(build_ctx.max_packet_size));
     if (!chunk || !chunk->Valid()) {
         LOG_ERROR("BaseConnection::TrySend: failed to allocate buffer chunk");
         return false;
@@ -1953,8 +2363,8 @@ bool BaseConnection::TrySendNew() {
     // unaffected.
     uint64_t t_build_start = common::Metrics::NowUs();
 
-    auto result = packet_builder_->BuildDataPacket(
-        build_ctx, buffer, send_manager_.GetPacketNumber(), send_manager_.GetSendControl());
+    auto result = packet_builder_->BuildDataPacket(build_ctx, buffer, *send_manager_.GetPathPacketNumber(path_id),
+        *send_manager_.GetPathSendControl(path_id));
 
     {
         uint64_t t_build_end = common::Metrics::NowUs();
@@ -2002,7 +2412,7 @@ bool BaseConnection::TrySendNew() {
 
     // 12. Send buffer
     uint64_t t_send_start = common::Metrics::NowUs();
-    bool send_success = SendBuffer(buffer);
+    bool send_success = SendBuffer(buffer, path_id);
     {
         uint64_t t_send_end = common::Metrics::NowUs();
         if (t_send_end > t_send_start) {
@@ -2044,7 +2454,35 @@ bool BaseConnection::TrySendNew() {
     return send_success;
 }
 
-bool BaseConnection::SendBuffer(std::shared_ptr<common::IBuffer> buffer) {
+bool BaseConnection::TrySendMtuProbe(std::shared_ptr<ICryptographer> cryptographer, uint16_t probe_size) {
+    auto chunk = std::make_shared<common::BufferChunk>(
+        quic::GlobalResource::Instance().GetThreadLocalBlockPool(probe_size));
+    if (!chunk || !chunk->Valid()) {
+        LOG_ERROR("BaseConnection::TrySendMtuProbe: failed to allocate buffer chunk");
+        return false;
+    }
+    auto buffer = std::make_shared<common::SingleBlockBuffer>(chunk);
+
+    auto result = packet_builder_->BuildMtuProbePacket(probe_size, cryptographer,
+        cid_coordinator_->GetLocalConnectionIDManager().get(), cid_coordinator_->GetRemoteConnectionIDManager().get(),
+        buffer, send_manager_.GetPacketNumber(), send_manager_.GetSendControl(),
+        connection_crypto_.GetCurrentKeyPhase());
+    if (!result.success) {
+        LOG_WARN("BaseConnection::TrySendMtuProbe: failed to build %u byte probe: %s", probe_size,
+            result.error_message.c_str());
+        return false;
+    }
+
+    // A probe the path drops (or the local interface refuses) is declared
+    // lost by loss detection like any other packet.
+    send_manager_.OnMtuProbeSent(result.packet_number, result.packet_size);
+    SendBuffer(buffer);
+    LOG_DEBUG("BaseConnection::TrySendMtuProbe: sent probe pn=%llu size=%u", result.packet_number,
+        result.packet_size);
+    return true;
+}
+
+bool BaseConnection::SendBuffer(std::shared_ptr<common::IBuffer> buffer, uint32_t path_id) {
     if (!buffer || buffer->GetDataLength() == 0) {
         LOG_WARN("BaseConnection::SendBuffer: empty buffer");
         common::Metrics::CounterInc(common::MetricsStd::DiagSendBufferFail);
@@ -2068,10 +2506,20 @@ bool BaseConnection::SendBuffer(std::shared_ptr<common::IBuffer> buffer) {
 
         auto packet = std::make_shared<NetPacket>();
         packet->SetData(buffer);
-        packet->SetAddress(AcquireSendAddress());
         // During migration, use migration socket for sending
         int32_t send_sock = (migration_sockfd_ > 0) ? migration_sockfd_ : sockfd_;
+        if (path_id == 0) {
+            packet->SetAddress(AcquireSendAddress());
+        } else {
+            // multipath: every other path has its own socket (client) or peer address (server)
+            common::Address path_addr = path_manager_->GetPathPeerAddress(path_id);
+            path_addr.EnsureSockaddrCache(AF_INET);
+            path_addr.EnsureSockaddrCache(AF_INET6);
+            packet->SetAddress(path_addr);
+            send_sock = path_manager_->GetPathSocket(path_id);
+        }
         packet->SetSocket(send_sock);
+        packet->SetEcn(OutgoingEcnCodepoint(path_id));
 
         // PERF (sendmmsg batch path): if Worker installed a sink for this
         // drain round, just hand the packet to it and return. The actual
@@ -2101,6 +2549,47 @@ bool BaseConnection::SendBuffer(std::shared_ptr<common::IBuffer> buffer) {
     return false;
 }
 
+bool BaseConnection::SendFrameOnPath(uint32_t path_id, std::shared_ptr<IFrame> frame) {
+    auto cryptographer = connection_crypto_.GetCryptographer(kApplication);
+    SendControl* send_control = send_manager_.GetPathSendControl(path_id);
+    PacketNumber* packet_number = send_manager_.GetPathPacketNumber(path_id);
+    auto local_cid_manager = cid_coordinator_->GetPathLocalConnectionIDManager(path_id);
+    auto remote_cid_manager = cid_coordinator_->GetPathRemoteConnectionIDManager(path_id);
+    if (!cryptographer || !send_control || !packet_number || !local_cid_manager || !remote_cid_manager) {
+        LOG_WARN("BaseConnection::SendFrameOnPath: path %u cannot send, frame type=%d dropped", path_id,
+            frame->GetType());
+        return false;
+    }
+
+    PacketBuilder::DataPacketContext ctx;
+    ctx.level = kApplication;
+    ctx.cryptographer = cryptographer;
+    ctx.local_cid_manager = local_cid_manager.get();
+    ctx.remote_cid_manager = remote_cid_manager.get();
+    ctx.quic_version = connection_crypto_.GetVersion();
+    ctx.key_phase = connection_crypto_.GetCurrentKeyPhase();
+    ctx.path_id = path_id;
+    ctx.frames.push_back(frame);
+    ctx.include_stream_data = false;
+    ctx.max_packet_size = send_manager_.GetPathMaxPacketSize(path_id);
+
+    auto chunk = std::make_shared<common::BufferChunk>(quic::GlobalResource::Instance().GetThreadLocalBlockPool());
+    if (!chunk || !chunk->Valid()) {
+        LOG_ERROR("BaseConnection::SendFrameOnPath: failed to allocate buffer chunk");
+        return false;
+    }
+    auto buffer = std::make_shared<common::SingleBlockBuffer>(chunk);
+
+    auto result = packet_builder_->BuildDataPacket(ctx, buffer, *packet_number, *send_control);
+    if (!result.success) {
+        LOG_ERROR("BaseConnection::SendFrameOnPath: failed to build packet: %s", result.error_message.c_str());
+        return false;
+    }
+    LOG_DEBUG("BaseConnection::SendFrameOnPath: path %u pn=%llu, frame type=%d", path_id, result.packet_number,
+        frame->GetType());
+    return SendBuffer(buffer, path_id);
+}
+
 bool BaseConnection::SendImmediateAck(PacketNumberSpace ns) {
     LOG_DEBUG("BaseConnection::SendImmediateAck: ns=%d", ns);
 
@@ -2160,7 +2649,7 @@ bool BaseConnection::SendImmediateAck(PacketNumberSpace ns) {
     return SendImmediate(buffer);
 }
 
-bool BaseConnection::SendImmediateFrame(std::shared_ptr<IFrame> frame, EncryptionLevel level) {
+bool BaseConnection::SendImmediateFrame(std::shared_ptr<IFrame> frame, EncryptionLevel level, int32_t sockfd) {
     LOG_DEBUG("BaseConnection::SendImmediateFrame: frame_type=%d, level=%d", frame->GetType(), level);
 
     // 1. Get cryptographer
@@ -2193,7 +2682,7 @@ bool BaseConnection::SendImmediateFrame(std::shared_ptr<IFrame> frame, Encryptio
         "BaseConnection::SendImmediateFrame: built packet pn=%llu, size=%u", result.packet_number, result.packet_size);
 
     // 3. Send immediately
-    return SendImmediate(buffer);
+    return SendImmediate(buffer, sockfd);
 }
 
 }  // namespace quic
@@ -1,6 +1,7 @@
 #ifndef QUIC_CONNECTION_CONNECTION_BASE
 #define QUIC_CONNECTION_CONNECTION_BASE
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -8,11 +9,14 @@
 
 #include <quicx/common/if_event_loop.h>
 
+#include "common/timer/timer_multiplexer.h"
+
 #include "quic/connection/connection_crypto.h"
 #include "quic/connection/connection_id_coordinator.h"
 #include "quic/connection/connection_id_manager.h"
 #include "quic/connection/connection_path_manager.h"
 #include "quic/connection/connection_state_machine.h"
+#include "quic/connection/connection_stats.h"
 #include "quic/connection/controler/recv_control.h"
 #include "quic/connection/controler/recv_flow_controller.h"
 #include "quic/connection/controler/send_flow_controller.h"
@@ -65,6 +69,20 @@ public:
     void SetKeyUpdateEnabled(bool enabled) { key_update_trigger_.SetEnabled(enabled); }
     bool TriggerKeyUpdate() { return connection_crypto_.TriggerKeyUpdate(); }
 
+    // Per-connection congestion control; must be called before the first packet is sent
+    bool SetCongestionControl(CongestionControlType type, const std::string& custom_name = "") {
+        return send_manager_.SetCongestionControl(type, custom_name);
+    }
+    // How streams with data ready share the packets of this connection
+    void SetStreamScheduler(StreamSchedulerType type);
+    // High/low marks on what IQuicSendStream::Send() buffers, per stream and
+    // for the whole connection (see QuicConfig)
+    void SetSendBufferWatermarks(uint32_t stream_high, uint32_t stream_low, uint32_t conn_high, uint32_t conn_low);
+    // Careful Resume: start from the path capacity saved under |path_key|
+    // (server name on clients, client subnet on servers) and save this
+    // connection's own observation under the same key when it closes.
+    void EnableCarefulResume(const std::string& path_key);
+
     // RFC 9369: QUIC Version management
     void SetVersion(uint32_t version) {
         version_ctx_.quic_version = version;
@@ -112,14 +130,25 @@ public:
 // PATH_RESPONSE, or CONNECTION_CLOSE.
 // @param frame Frame to send
 // @param level Encryption level (defaults to current level)
+// @param sockfd Socket to send on, -1 for the current send socket
 // @return true if successfully sent
-    bool SendImmediateFrame(std::shared_ptr<IFrame> frame, EncryptionLevel level = kApplication);
+    bool SendImmediateFrame(std::shared_ptr<IFrame> frame, EncryptionLevel level = kApplication, int32_t sockfd = -1);
 
     // handle packets
     virtual void OnPackets(uint64_t now, std::vector<std::shared_ptr<IPacket>>& packets) override;
     virtual void SetPendingEcn(uint8_t ecn) override { pending_ecn_ = ecn; }
+    // Every local socket a datagram arrives on is a path of its own (a
+    // server with a preferred address has two). A server's send socket stays
+    // put until the peer sends its newest non-probing packet on another one
+    // (RFC 9000 §9.3); a PATH_RESPONSE is answered on the socket its
+    // PATH_CHALLENGE came in on (§8.2.2).
+    virtual void SetRecvSocket(int32_t sockfd) override;
     virtual EncryptionLevel GetCurEncryptionLevel() override;
 
+    // Multipath: a CID issued for another path than path 0 routes the
+    // datagram to that path's packet number space and RecvControl
+    virtual void SetRecvConnectionID(ConnectionID& cid) override;
+
     // observed peer address from network; store as candidate if different
     virtual void OnObservedPeerAddress(const common::Address& addr) override;
 
@@ -167,6 +196,7 @@ public:
     const std::string& GetInitialSecretDcidForTest() const {
         return connection_crypto_.GetInitialSecretDcid();
     }
+    PathManager* GetPathManagerForTest() { return path_manager_.get(); }
     // ==================== End Test-Only Accessors ====================
 
     // IConnectionStateListener
@@ -181,6 +211,7 @@ public:
     virtual void OnFrameReady(std::shared_ptr<IFrame> frame) override;
     virtual void OnConnectionActive() override;
     virtual void OnStreamClosed(uint64_t stream_id) override;
+    virtual void OnStreamDataConsumed(uint64_t bytes) override;
     virtual void OnConnectionClose(uint64_t error, uint16_t frame_type, const std::string& reason) override;
 
 protected:
@@ -243,6 +274,23 @@ private:
     // version differs from default).  Returns false if encode/push fails.
     bool RebuildAndPushVersionInformation();
 
+    // RFC 9000 §9.6, server side: turn the configured "ip:port" preferred
+    // address into the preferred_address TP, allocating the local CID of
+    // sequence number 1 and its stateless reset token for it.
+    void AdvertisePreferredAddress(const std::string& addr);
+    // Client side: record the CID of the server's preferred_address and
+    // start validating the address of our family.
+    void OnPreferredAddress(const TransportParam& remote_tp);
+
+    // Store what this connection observed in PathCapacityCache; runs once,
+    // on the first transition out of the connected state.
+    void SavePathCapacity();
+
+    // RFC 9221: hand a received DATAGRAM payload to the application, and
+    // queue an outgoing one on the loop thread.
+    void OnDatagramFrame(const common::SharedBufferSpan& data);
+    bool PushDatagram(uint64_t id, const common::SharedBufferSpan& data, uint32_t ttl_ms);
+
     // Internal helper methods for TrySend()
 
     // Retransmit-side branch of TrySend: re-encode the next lost packet (with
@@ -261,10 +309,29 @@ private:
     // (FC accounting, key-update trigger).  Returns the SendBuffer outcome.
     bool TrySendNew();
 
+    // DPLPMTUD branch of TrySendNew: send the PING+PADDING probe of
+    // probe_size bytes the PmtuProber asked for. Returns false if it could
+    // not be built, so TrySendNew goes on with regular data.
+    bool TrySendMtuProbe(std::shared_ptr<ICryptographer> cryptographer, uint16_t probe_size);
+
+    // Gather QuicConnectionStats from the send, stream and flow-control
+    // state and publish it for GetStats(). Runs after each batch of received
+    // packets and at the end of each send round.
+    void PublishStats();
+    // Report to bandwidth_cb_ if the estimate moved enough (see SetBandwidthCallBack)
+    void ReportBandwidthIfChanged(const QuicConnectionStats& stats);
+
     // Send buffer using sender_ (internal helper)
 // @param buffer Buffer to send
+// @param path_id Multipath: path whose socket and peer address are used
 // @return true if successfully sent
-    bool SendBuffer(std::shared_ptr<common::IBuffer> buffer);
+    bool SendBuffer(std::shared_ptr<common::IBuffer> buffer, uint32_t path_id = 0);
+
+    // Multipath: send `frame` right away in a 1-RTT packet of `path_id`
+    // (PATH_CHALLENGE, PATH_RESPONSE, PTO probe of the path)
+    bool SendFrameOnPath(uint32_t path_id, std::shared_ptr<IFrame> frame);
+    // RecvControl of the 1-RTT packets of a path
+    RecvControl& GetPathRecvControl(uint32_t path_id);
 
 public:
     // PERF (sendmmsg batch path): when set non-null, SendBuffer() appends the
@@ -297,7 +364,10 @@ protected:
 
     // Immediate send for critical frames (ACK, PATH_CHALLENGE/RESPONSE, CONNECTION_CLOSE)
     // Bypasses normal send path and uses sender_ directly
-    bool SendImmediate(std::shared_ptr<common::IBuffer> buffer);
+    bool SendImmediate(std::shared_ptr<common::IBuffer> buffer, int32_t sockfd = -1);
+    // Move the send socket to the one `packet` arrived on if it is the
+    // newest non-probing 1-RTT packet, see SetRecvSocket()
+    void FollowPeerSocket(std::shared_ptr<IPacket>& packet);
 
     void InnerConnectionClose(uint64_t error, uint16_t trigger_frame, std::string reason);
     void ImmediateClose(uint64_t error, uint16_t trigger_frame, std::string reason);
@@ -305,6 +375,8 @@ protected:
 
     // Stream data ACK notification callback
     void OnStreamDataAcked(uint64_t stream_id, uint64_t offset_start, uint64_t length, bool has_fin);
+    // Stream data loss notification callback
+    void OnStreamDataLost(uint64_t stream_id, uint64_t offset_start, uint64_t length, bool has_fin);
 
     // Retry pending stream creation requests after receiving MAX_STREAMS
     void RetryPendingStreamRequests();
@@ -316,7 +388,7 @@ protected:
 
     // record bytes received on candidate path to increase amp budget while probing
     virtual void OnCandidatePathDatagramReceived(const common::Address& addr, uint32_t bytes) override {
-        if (path_manager_ && path_manager_->IsPathProbeInflight() &&
+        if (recv_path_id_ == 0 && path_manager_ && path_manager_->IsPathProbeInflight() &&
             (addr == path_manager_->GetCandidatePeerAddress())) {
             path_manager_->OnCandidatePathBytesReceived(bytes);
         }
@@ -327,6 +399,14 @@ protected:
         }
         return peer_addr_;
     }
+    // IP ECN codepoint stamped on every datagram this connection sends.
+    uint8_t OutgoingEcnCodepoint(uint32_t path_id = 0) {
+        if (!ecn_enabled_) {
+            return 0;
+        }
+        auto send_control = send_manager_.GetPathSendControl(path_id);
+        return send_control ? send_control->GetEcnCodepoint() : 0;
+    }
 
     // RFC 9000 Section 9: Connection Migration
     // Simple API: delegates to production API with current IP and system-chosen port
@@ -351,6 +431,21 @@ protected:
     // Internal: Handle migration completion callback from PathManager
     void OnMigrationComplete(const MigrationInfo& info);
 
+    // Multipath (draft-ietf-quic-multipath, see PathManager)
+    virtual uint32_t OpenPath(const std::string& local_ip, uint16_t local_port = 0) override;
+    virtual bool ClosePath(uint32_t path_id) override;
+    virtual void SetPathScheduler(PathSchedulerType type) override { send_manager_.SetPathScheduler(type); }
+
+    // RFC 9221: unreliable datagrams (see DatagramQueue)
+    virtual uint64_t SendDatagram(const uint8_t* data, uint32_t len, uint32_t ttl_ms = 0) override;
+    virtual uint32_t GetMaxDatagramSize() override;
+    virtual void SetDatagramRecvCallBack(datagram_recv_callback cb) override { datagram_recv_cb_ = cb; }
+    virtual void SetDatagramStatusCallBack(datagram_status_callback cb) override { datagram_status_cb_ = cb; }
+
+    // Last snapshot published by PublishStats(); safe from any thread
+    virtual bool GetStats(QuicConnectionStats& stats) override { return stats_snapshot_.Read(stats); }
+    virtual void SetBandwidthCallBack(bandwidth_callback cb, double min_change = 0.1) override;
+
     void CloseInternal();
 
     // Connection ID pool management
@@ -375,10 +470,23 @@ protected:
     uint64_t last_communicate_time_;
 
     uint8_t pending_ecn_{0};
+    // socket of the datagram being processed, see SetRecvSocket()
+    int32_t recv_sockfd_{-1};
+    // multipath: path and source address of the datagram being processed,
+    // see SetRecvConnectionID()
+    uint32_t recv_path_id_{0};
+    common::Address recv_peer_addr_;
+    // newest 1-RTT packet number with non-probing frames; the send socket
+    // follows the socket it arrived on
+    uint64_t largest_non_probing_pn_{0};
+    bool has_non_probing_pn_{false};
     bool ecn_enabled_;
     // flow control
     SendFlowController send_flow_controller_;  // Send-side flow controller
     RecvFlowController recv_flow_controller_;  // Receive-side flow controller
+    // PTO, loss, ACK-delay, pacing and flow-control timers of this connection,
+    // folded into one entry of the event loop's timer
+    std::shared_ptr<common::TimerMultiplexer> timer_multiplexer_;
     RecvControl recv_control_;
     SendManager send_manager_;
     // crypto
@@ -404,6 +512,9 @@ protected:
     // Remembered remote transport params for 0-RTT session caching (RFC 9000 Section 7.4.1)
     RemoteTransportParamSnapshot remote_tp_snapshot_;
 
+    // PathCapacityCache key for Careful Resume; empty when disabled.
+    std::string path_capacity_key_;
+
     // EventLoop reference — observer only (owner is QuicClient/QuicServer)
     std::weak_ptr<common::IEventLoop> event_loop_;
 
@@ -437,6 +548,25 @@ protected:
 
     // Version negotiation callback (RFC 9000 Section 6)
     version_negotiation_callback version_negotiation_cb_;
+
+    // RFC 9221 datagrams. Ids are handed out on the caller's thread; the
+    // payload limit is published from the loop thread once the peer's
+    // transport parameters arrive.
+    datagram_recv_callback datagram_recv_cb_;
+    datagram_status_callback datagram_status_cb_;
+    std::atomic<uint64_t> next_datagram_id_{0};
+    std::atomic<uint32_t> peer_max_datagram_payload_{0};
+
+    // Transport statistics. The counters are kept by the loop thread, the
+    // snapshot is what other threads read.
+    uint64_t packets_received_ = 0;
+    uint64_t bytes_received_ = 0;
+    ConnectionStatsSnapshot stats_snapshot_;
+
+    // Bandwidth feedback, loop thread only
+    bandwidth_callback bandwidth_cb_;
+    double bandwidth_min_change_ = 0.1;
+    BandwidthInfo last_bandwidth_report_;
 };
 
 }  // namespace quic
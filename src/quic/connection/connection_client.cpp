@@ -299,6 +299,8 @@ bool ClientConnection::HandleHandshakeDoneFrame(std::shared_ptr<IFrame> frame) {
 
     // Mark handshake complete to stop PTO probing
     send_manager_.GetSendControl().SetHandshakeComplete();
+    // RFC 9000 §14.3: the handshake is confirmed, search for a larger PLPMTU
+    send_manager_.StartMtuProbe();
 
     // RFC 9000 Section 4.10: Discard Initial and Handshake packet number spaces
     recv_control_.DiscardPacketNumberSpace(PacketNumberSpace::kInitialNumberSpace);
@@ -435,6 +437,8 @@ bool ClientConnection::OnRetryPacket(const std::shared_ptr<IPacket>& packet) {
     updated_tp.max_ack_delay_ms_ = static_cast<uint32_t>(transport_param_.GetMaxAckDelay());
     updated_tp.disable_active_migration_ = transport_param_.GetDisableActiveMigration();
     updated_tp.active_connection_id_limit_ = static_cast<uint32_t>(transport_param_.GetActiveConnectionIdLimit());
+    updated_tp.min_ack_delay_us_ = static_cast<uint32_t>(transport_param_.GetMinAckDelay());
+    updated_tp.max_datagram_frame_size_ = static_cast<uint32_t>(transport_param_.GetMaxDatagramFrameSize());
     updated_tp.initial_source_connection_id_ = transport_param_.GetInitialSourceConnectionId();
 
     // Do NOT set original_destination_connection_id_ — it's server-only (RFC 9000 §18.2)
@@ -1,6 +1,7 @@
 #include "common/log/log.h"
 #include "common/log/log_context.h"
 #include "common/qlog/qlog.h"
+#include "common/util/time.h"
 
 #include <sstream>
 
@@ -12,6 +13,7 @@
 #include "quic/connection/connection_path_manager.h"
 #include "quic/connection/connection_state_machine.h"
 #include "quic/connection/connection_stream_manager.h"
+#include "quic/connection/controler/recv_control.h"
 #include "quic/connection/controler/recv_flow_controller.h"
 #include "quic/connection/controler/send_flow_controller.h"
 #include "quic/connection/controler/send_manager.h"
@@ -19,14 +21,22 @@
 #include "quic/connection/if_connection_event_sink.h"
 #include "quic/connection/transport_param.h"
 #include "quic/connection/util.h"
+#include "quic/frame/ack_frequency_frame.h"
 #include "quic/frame/connection_close_frame.h"
 #include "quic/frame/crypto_frame.h"
+#include "quic/frame/datagram_frame.h"
 #include "quic/frame/max_data_frame.h"
+#include "quic/frame/max_path_id_frame.h"
 #include "quic/frame/max_streams_frame.h"
 #include "quic/frame/new_connection_id_frame.h"
 #include "quic/frame/new_token_frame.h"
+#include "quic/frame/path_abandon_frame.h"
+#include "quic/frame/path_ack_frame.h"
 #include "quic/frame/path_challenge_frame.h"
+#include "quic/frame/path_new_connection_id_frame.h"
 #include "quic/frame/path_response_frame.h"
+#include "quic/frame/path_retire_connection_id_frame.h"
+#include "quic/frame/path_status_frame.h"
 #include "quic/frame/retire_connection_id_frame.h"
 #include "quic/frame/stream_frame.h"
 #include "quic/stream/stream_id_generator.h"
@@ -53,12 +63,13 @@ FrameProcessor::FrameProcessor(IConnectionEventSink& event_sink, ConnectionState
     ConnectionCrypto& connection_crypto, SendManager& send_manager, StreamManager& stream_manager,
     ConnectionIDCoordinator& cid_coordinator, PathManager& path_manager, ConnectionCloser& connection_closer,
     TransportParam& transport_param, std::string& token, SendFlowController* send_flow_controller,
-    RecvFlowController* recv_flow_controller):
+    RecvFlowController* recv_flow_controller, RecvControl* recv_control):
     event_sink_(event_sink),
     state_machine_(state_machine),
     connection_crypto_(connection_crypto),
     send_flow_controller_(send_flow_controller),
     recv_flow_controller_(recv_flow_controller),
+    recv_control_(recv_control),
     send_manager_(send_manager),
     stream_manager_(stream_manager),
     cid_coordinator_(cid_coordinator),
@@ -153,6 +164,55 @@ bool FrameProcessor::OnFrames(std::vector<std::shared_ptr<IFrame>>& frames, uint
                     return false;
                 }
                 break;
+            case FrameType::kAckFrequency:
+                if (!OnAckFrequencyFrame(frames[i])) {
+                    return false;
+                }
+                break;
+            case FrameType::kImmediateAck:
+                if (!OnImmediateAckFrame(frames[i], crypto_level)) {
+                    return false;
+                }
+                break;
+            case FrameType::kDatagram:
+            case FrameType::kDatagramWithLength:
+                if (!OnDatagramFrame(frames[i])) {
+                    return false;
+                }
+                break;
+            // ********** multipath frame **********
+            case FrameType::kPathAck:
+            case FrameType::kPathAckEcn:
+                if (!OnPathAckFrame(frames[i])) {
+                    return false;
+                }
+                break;
+            case FrameType::kPathAbandon:
+                if (!OnPathAbandonFrame(frames[i])) {
+                    return false;
+                }
+                break;
+            case FrameType::kPathStatusBackup:
+            case FrameType::kPathStatusAvailable:
+                if (!OnPathStatusFrame(frames[i])) {
+                    return false;
+                }
+                break;
+            case FrameType::kPathNewConnectionId:
+                if (!OnPathNewConnectionIDFrame(frames[i])) {
+                    return false;
+                }
+                break;
+            case FrameType::kPathRetireConnectionId:
+                if (!OnPathRetireConnectionIDFrame(frames[i])) {
+                    return false;
+                }
+                break;
+            case FrameType::kMaxPathId:
+                if (!OnMaxPathIdFrame(frames[i])) {
+                    return false;
+                }
+                break;
             // ********** stream frame **********
             case FrameType::kResetStream:
             case FrameType::kStopSending:
@@ -189,7 +249,8 @@ bool FrameProcessor::OnStreamFrame(std::shared_ptr<IFrame> frame) {
     // RFC 9000 Section 4.1: A receiver MUST close the connection with an error of type FLOW_CONTROL_ERROR if the
     // sender violates the advertised connection or stream data limits
     std::shared_ptr<IFrame> send_frame;
-    if (recv_flow_controller_ && recv_flow_controller_->ShouldSendMaxData(send_frame)) {
+    if (recv_flow_controller_ &&
+        recv_flow_controller_->ShouldSendMaxData(send_frame, common::UTCTimeMsec(), send_manager_.GetRtt())) {
         if (send_frame) {
             event_sink_.OnFrameReady(send_frame);
         }
@@ -315,9 +376,10 @@ bool FrameProcessor::OnMaxDataFrame(std::shared_ptr<IFrame> frame) {
 }
 
 bool FrameProcessor::OnDataBlockFrame(std::shared_ptr<IFrame> frame) {
-    // Peer is blocked - send updated MAX_DATA
+    // Peer is blocked - credit back whatever the application has consumed
     std::shared_ptr<IFrame> send_frame;
-    if (recv_flow_controller_ && recv_flow_controller_->ShouldSendMaxData(send_frame)) {
+    if (recv_flow_controller_ &&
+        recv_flow_controller_->ShouldSendMaxData(send_frame, common::UTCTimeMsec(), send_manager_.GetRtt(), true)) {
         if (send_frame) {
             event_sink_.OnFrameReady(send_frame);
         }
@@ -522,5 +584,206 @@ bool FrameProcessor::OnPathResponseFrame(std::shared_ptr<IFrame> frame) {
     return true;
 }
 
+bool FrameProcessor::OnAckFrequencyFrame(std::shared_ptr<IFrame> frame) {
+    auto ack_frequency_frame = std::dynamic_pointer_cast<AckFrequencyFrame>(frame);
+    if (!ack_frequency_frame) {
+        LOG_ERROR("invalid ack frequency frame.");
+        return false;
+    }
+
+    // draft-ietf-quic-ack-frequency §4: receiving ACK_FREQUENCY without having
+    // advertised min_ack_delay, or with a Request Max Ack Delay below it, is a
+    // PROTOCOL_VIOLATION.
+    uint64_t min_ack_delay = transport_param_.GetMinAckDelay();
+    if (min_ack_delay == 0) {
+        event_sink_.OnConnectionClose(QuicErrorCode::kProtocolViolation, frame->GetType(),
+            "ack frequency frame without min_ack_delay.");
+        LOG_ERROR("ACK_FREQUENCY received but min_ack_delay was not advertised");
+        return false;
+    }
+    if (ack_frequency_frame->GetRequestMaxAckDelay() < min_ack_delay) {
+        event_sink_.OnConnectionClose(QuicErrorCode::kProtocolViolation, frame->GetType(),
+            "request max ack delay below min_ack_delay.");
+        LOG_ERROR("ACK_FREQUENCY request_max_ack_delay (%llu) < min_ack_delay (%llu)",
+            ack_frequency_frame->GetRequestMaxAckDelay(), min_ack_delay);
+        return false;
+    }
+
+    if (recv_control_) {
+        recv_control_->OnAckFrequency(ack_frequency_frame->GetSequenceNumber(),
+            ack_frequency_frame->GetAckElicitingThreshold(), ack_frequency_frame->GetRequestMaxAckDelay(),
+            ack_frequency_frame->GetReorderingThreshold());
+    }
+    return true;
+}
+
+bool FrameProcessor::OnImmediateAckFrame(std::shared_ptr<IFrame> frame, uint16_t crypto_level) {
+    // The frame is handled before RecvControl::OnPacketRecv() sees the packet
+    // carrying it; the request is consumed there.
+    if (recv_control_) {
+        recv_control_->OnImmediateAck(CryptoLevel2PacketNumberSpace(crypto_level));
+    }
+    return true;
+}
+
+bool FrameProcessor::OnDatagramFrame(std::shared_ptr<IFrame> frame) {
+    auto datagram_frame = std::dynamic_pointer_cast<DatagramFrame>(frame);
+    if (!datagram_frame) {
+        LOG_ERROR("invalid datagram frame.");
+        return false;
+    }
+
+    // RFC 9221 §3: a DATAGRAM frame we did not advertise support for, or one
+    // larger than our max_datagram_frame_size, is a PROTOCOL_VIOLATION.
+    uint64_t max_frame_size = transport_param_.GetMaxDatagramFrameSize();
+    if (max_frame_size == 0) {
+        event_sink_.OnConnectionClose(QuicErrorCode::kProtocolViolation, frame->GetType(),
+            "datagram frame without max_datagram_frame_size.");
+        LOG_ERROR("DATAGRAM received but max_datagram_frame_size was not advertised");
+        return false;
+    }
+    if (datagram_frame->EncodeSize() > max_frame_size) {
+        event_sink_.OnConnectionClose(QuicErrorCode::kProtocolViolation, frame->GetType(),
+            "datagram frame exceeds max_datagram_frame_size.");
+        LOG_ERROR("DATAGRAM frame size (%u) > max_datagram_frame_size (%llu)", datagram_frame->EncodeSize(),
+            max_frame_size);
+        return false;
+    }
+
+    if (datagram_cb_) {
+        datagram_cb_(datagram_frame->GetData());
+    }
+    return true;
+}
+
+// ==================== Multipath (draft-ietf-quic-multipath) ====================
+
+bool FrameProcessor::CheckMultipathNegotiated(std::shared_ptr<IFrame> frame) {
+    if (path_manager_.IsMultipathEnabled()) {
+        return true;
+    }
+    event_sink_.OnConnectionClose(
+        QuicErrorCode::kProtocolViolation, frame->GetType(), "multipath frame without initial_max_path_id.");
+    LOG_ERROR("multipath frame type 0x%x received but multipath was not negotiated", frame->GetType());
+    return false;
+}
+
+bool FrameProcessor::OnPathAckFrame(std::shared_ptr<IFrame> frame) {
+    auto path_ack_frame = std::dynamic_pointer_cast<PathAckFrame>(frame);
+    if (!path_ack_frame) {
+        LOG_ERROR("invalid path ack frame.");
+        return false;
+    }
+    if (!CheckMultipathNegotiated(frame)) {
+        return false;
+    }
+    send_manager_.OnPathAck(path_ack_frame->GetPathId(), frame);
+    return true;
+}
+
+bool FrameProcessor::OnPathAbandonFrame(std::shared_ptr<IFrame> frame) {
+    auto abandon_frame = std::dynamic_pointer_cast<PathAbandonFrame>(frame);
+    if (!abandon_frame) {
+        LOG_ERROR("invalid path abandon frame.");
+        return false;
+    }
+    if (!CheckMultipathNegotiated(frame)) {
+        return false;
+    }
+    path_manager_.OnPeerPathAbandon(abandon_frame->GetPathId(), abandon_frame->GetErrorCode());
+    return true;
+}
+
+bool FrameProcessor::OnPathStatusFrame(std::shared_ptr<IFrame> frame) {
+    auto status_frame = std::dynamic_pointer_cast<PathStatusFrame>(frame);
+    if (!status_frame) {
+        LOG_ERROR("invalid path status frame.");
+        return false;
+    }
+    if (!CheckMultipathNegotiated(frame)) {
+        return false;
+    }
+    path_manager_.OnPeerPathStatus(
+        status_frame->GetPathId(), status_frame->GetSequenceNumber(), status_frame->IsBackup());
+    return true;
+}
+
+bool FrameProcessor::OnPathNewConnectionIDFrame(std::shared_ptr<IFrame> frame) {
+    auto new_cid_frame = std::dynamic_pointer_cast<PathNewConnectionIDFrame>(frame);
+    if (!new_cid_frame) {
+        LOG_ERROR("invalid path new connection id frame.");
+        return false;
+    }
+    if (!CheckMultipathNegotiated(frame)) {
+        return false;
+    }
+
+    // CIDs for a path id above the limit we advertised are a PROTOCOL_VIOLATION
+    uint32_t path_id = new_cid_frame->GetPathId();
+    if (path_id > path_manager_.GetLocalMaxPathId()) {
+        event_sink_.OnConnectionClose(
+            QuicErrorCode::kProtocolViolation, frame->GetType(), "path id above max_path_id.");
+        LOG_ERROR("PATH_NEW_CONNECTION_ID: path id %u > max path id %u", path_id, path_manager_.GetLocalMaxPathId());
+        return false;
+    }
+    uint64_t sequence_number = new_cid_frame->GetSequenceNumber();
+    uint64_t retire_prior_to = new_cid_frame->GetRetirePriorTo();
+    if (retire_prior_to > sequence_number) {
+        event_sink_.OnConnectionClose(
+            QuicErrorCode::kFrameEncodingError, frame->GetType(), "retire_prior_to > sequence_number");
+        LOG_ERROR("PATH_NEW_CONNECTION_ID: retire_prior_to (%llu) > sequence_number (%llu)", retire_prior_to,
+            sequence_number);
+        return false;
+    }
+
+    // same DoS bound as NEW_CONNECTION_ID
+    static const uint64_t kMaxRetirePerFrame = 256;
+    uint64_t retire_count = std::min(retire_prior_to, kMaxRetirePerFrame);
+    for (uint64_t seq = 0; seq < retire_count; ++seq) {
+        auto retire = std::make_shared<PathRetireConnectionIDFrame>();
+        retire->SetPathId(path_id);
+        retire->SetSequenceNumber(seq);
+        event_sink_.OnFrameReady(retire);
+    }
+
+    ConnectionID id;
+    new_cid_frame->GetConnectionID(id);
+    cid_coordinator_.OnPathNewConnectionID(path_id, id, retire_prior_to);
+    return true;
+}
+
+bool FrameProcessor::OnPathRetireConnectionIDFrame(std::shared_ptr<IFrame> frame) {
+    auto retire_cid_frame = std::dynamic_pointer_cast<PathRetireConnectionIDFrame>(frame);
+    if (!retire_cid_frame) {
+        LOG_ERROR("invalid path retire connection id frame.");
+        return false;
+    }
+    if (!CheckMultipathNegotiated(frame)) {
+        return false;
+    }
+    uint32_t path_id = retire_cid_frame->GetPathId();
+    if (path_id == 0) {
+        // path 0 shares its CIDs with RETIRE_CONNECTION_ID
+        cid_coordinator_.GetLocalConnectionIDManager()->RetireIDBySequence(retire_cid_frame->GetSequenceNumber());
+        cid_coordinator_.CheckAndReplenishLocalCIDPool();
+        return true;
+    }
+    cid_coordinator_.OnPathRetireConnectionID(path_id, retire_cid_frame->GetSequenceNumber());
+    return true;
+}
+
+bool FrameProcessor::OnMaxPathIdFrame(std::shared_ptr<IFrame> frame) {
+    auto max_path_id_frame = std::dynamic_pointer_cast<MaxPathIdFrame>(frame);
+    if (!max_path_id_frame) {
+        LOG_ERROR("invalid max path id frame.");
+        return false;
+    }
+    if (!CheckMultipathNegotiated(frame)) {
+        return false;
+    }
+    path_manager_.OnPeerMaxPathId(max_path_id_frame->GetMaxPathId());
+    return true;
+}
+
 }  // namespace quic
 }  // namespace quicx
@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 
+#include "common/buffer/shared_buffer_span.h"
 #include "quic/frame/if_frame.h"
 
 namespace quicx {
@@ -21,6 +22,7 @@ class ConnectionCrypto;
 class IConnectionEventSink;
 class SendFlowController;
 class RecvFlowController;
+class RecvControl;
 class SendManager;
 class StreamManager;
 class ConnectionIDCoordinator;
@@ -39,6 +41,10 @@ class IStream;
  * - Process flow control frames (MAX_DATA, MAX_STREAMS, etc.)
  * - Process path validation frames (PATH_CHALLENGE, PATH_RESPONSE)
  * - Process connection ID frames (NEW_CONNECTION_ID, RETIRE_CONNECTION_ID)
+ * - Process ACK frequency frames (ACK_FREQUENCY, IMMEDIATE_ACK)
+ * - Process unreliable datagrams (DATAGRAM)
+ * - Process multipath frames (PATH_ACK, PATH_ABANDON, PATH_STATUS_*,
+ *   PATH_NEW/RETIRE_CONNECTION_ID, MAX_PATH_ID)
  *
  * Refactored (Phase 3): Uses IConnectionEventSink interface instead of callbacks
  * to reduce std::bind overhead and improve performance.
@@ -48,12 +54,13 @@ public:
     // Application-level callbacks (cannot be replaced by event interface)
     using StreamStateCallback = std::function<void(std::shared_ptr<IStream>, uint32_t error)>;
     using HandshakeDoneCallback = std::function<bool(std::shared_ptr<IFrame>)>;
+    using DatagramCallback = std::function<void(const common::SharedBufferSpan& data)>;
 
     FrameProcessor(IConnectionEventSink& event_sink, ConnectionStateMachine& state_machine,
         ConnectionCrypto& connection_crypto, SendManager& send_manager, StreamManager& stream_manager,
         ConnectionIDCoordinator& cid_coordinator, PathManager& path_manager, ConnectionCloser& connection_closer,
         TransportParam& transport_param, std::string& token, SendFlowController* send_flow_controller = nullptr,
-        RecvFlowController* recv_flow_controller = nullptr);
+        RecvFlowController* recv_flow_controller = nullptr, RecvControl* recv_control = nullptr);
 
     ~FrameProcessor() = default;
 
@@ -79,6 +86,11 @@ public:
      */
     void SetHandshakeDoneCallback(HandshakeDoneCallback cb) { handshake_done_cb_ = cb; }
 
+    /**
+     * @brief Set callback for received DATAGRAM payloads (application notification)
+     */
+    void SetDatagramCallback(DatagramCallback cb) { datagram_cb_ = cb; }
+
     /**
      * @brief Set qlog trace for connection ID events
      */
@@ -101,6 +113,17 @@ private:
     bool OnConnectionCloseAppFrame(std::shared_ptr<IFrame> frame);
     bool OnPathChallengeFrame(std::shared_ptr<IFrame> frame);
     bool OnPathResponseFrame(std::shared_ptr<IFrame> frame);
+    bool OnAckFrequencyFrame(std::shared_ptr<IFrame> frame);
+    bool OnImmediateAckFrame(std::shared_ptr<IFrame> frame, uint16_t crypto_level);
+    bool OnDatagramFrame(std::shared_ptr<IFrame> frame);
+    bool OnPathAckFrame(std::shared_ptr<IFrame> frame);
+    bool OnPathAbandonFrame(std::shared_ptr<IFrame> frame);
+    bool OnPathStatusFrame(std::shared_ptr<IFrame> frame);
+    bool OnPathNewConnectionIDFrame(std::shared_ptr<IFrame> frame);
+    bool OnPathRetireConnectionIDFrame(std::shared_ptr<IFrame> frame);
+    bool OnMaxPathIdFrame(std::shared_ptr<IFrame> frame);
+    // A multipath frame without the extension negotiated is a PROTOCOL_VIOLATION
+    bool CheckMultipathNegotiated(std::shared_ptr<IFrame> frame);
 
     // Dependencies (injected references)
     IConnectionEventSink& event_sink_;  // Event interface (replaces most callbacks)
@@ -108,6 +131,7 @@ private:
     ConnectionCrypto& connection_crypto_;
     SendFlowController* send_flow_controller_;  // Send-side flow controller
     RecvFlowController* recv_flow_controller_;  // Recv-side flow controller
+    RecvControl* recv_control_;                 // Receiver ACK policy (ACK_FREQUENCY / IMMEDIATE_ACK)
     SendManager& send_manager_;
     StreamManager& stream_manager_;
     ConnectionIDCoordinator& cid_coordinator_;
@@ -119,6 +143,7 @@ private:
     // Application-level callbacks (cannot be replaced by event interface)
     StreamStateCallback stream_state_cb_;
     HandshakeDoneCallback handshake_done_cb_;
+    DatagramCallback datagram_cb_;
 
     // Qlog trace for connection ID events
     std::shared_ptr<common::QlogTrace> qlog_trace_;
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include "quic/connection/connection_id_coordinator.h"
 #include "quic/connection/controler/send_manager.h"
 #include "quic/frame/new_connection_id_frame.h"
+#include "quic/frame/path_new_connection_id_frame.h"
 #include "quic/frame/retire_connection_id_frame.h"
 
 namespace quicx {
@@ -80,7 +82,11 @@ std::vector<uint64_t> ConnectionIDCoordinator::GetAllLocalCIDHashes() const {
         LOG_ERROR("ConnectionIDCoordinator::GetAllLocalCIDHashes: local_conn_id_manager_ is null");
         return std::vector<uint64_t>();
     }
-    return local_conn_id_manager_->GetAllIDHashes();
+    auto hashes = local_conn_id_manager_->GetAllIDHashes();
+    for (auto& kv : local_cid_path_) {
+        hashes.push_back(kv.first);
+    }
+    return hashes;
 }
 
 // ==================== Connection ID Pool Management ====================
@@ -162,6 +168,29 @@ bool ConnectionIDCoordinator::RotateRemoteConnectionID() {
         return false;
     }
 
+    OnRemoteConnectionIDRotated(old_cid);
+    return true;
+}
+
+bool ConnectionIDCoordinator::RotateRemoteConnectionID(uint64_t sequence) {
+    if (!remote_conn_id_manager_) {
+        LOG_ERROR("ConnectionIDCoordinator::RotateRemoteConnectionID: remote_conn_id_manager_ is null");
+        return false;
+    }
+
+    auto old_cid = remote_conn_id_manager_->GetCurrentID();
+    if (!remote_conn_id_manager_->UseID(sequence)) {
+        LOG_WARN("ConnectionIDCoordinator::RotateRemoteConnectionID: no remote CID with seq=%llu", sequence);
+        return false;
+    }
+    if (remote_conn_id_manager_->GetCurrentID() == old_cid) {
+        return true;
+    }
+    OnRemoteConnectionIDRotated(old_cid);
+    return true;
+}
+
+void ConnectionIDCoordinator::OnRemoteConnectionIDRotated(const ConnectionID& old_cid) {
     auto new_cid = remote_conn_id_manager_->GetCurrentID();
 
     // Send RETIRE_CONNECTION_ID for the old CID
@@ -180,8 +209,6 @@ bool ConnectionIDCoordinator::RotateRemoteConnectionID() {
     }
 
     LOG_DEBUG("ConnectionIDCoordinator: rotated remote CID, retired seq=%llu", old_cid.GetSequenceNumber());
-
-    return true;
 }
 
 void ConnectionIDCoordinator::SetPeerActiveConnectionIDLimit(uint64_t limit) {
@@ -192,5 +219,124 @@ void ConnectionIDCoordinator::SetPeerActiveConnectionIDLimit(uint64_t limit) {
     CheckAndReplenishLocalCIDPool();  // Trigger replenishment if limit increased
 }
 
+// ==================== Multipath ====================
+
+void ConnectionIDCoordinator::IssuePathConnectionIDs(uint32_t max_path_id) {
+    // a path id is never reused, so ids issued before stay done even once abandoned
+    for (uint32_t path_id = path_cids_issued_up_to_ + 1; path_id <= max_path_id; ++path_id) {
+        for (size_t i = 0; i < kPathCIDPoolSize; ++i) {
+            IssuePathConnectionID(path_id);
+        }
+    }
+    path_cids_issued_up_to_ = std::max(path_cids_issued_up_to_, max_path_id);
+}
+
+void ConnectionIDCoordinator::IssuePathConnectionID(uint32_t path_id) {
+    auto manager = GetPathLocalConnectionIDManager(path_id);
+    if (!manager) {
+        return;
+    }
+    // sequence numbers are per path and start at 0
+    ConnectionID new_cid = manager->Generator();
+
+    auto frame = std::make_shared<PathNewConnectionIDFrame>();
+    frame->SetPathId(path_id);
+    frame->SetSequenceNumber(new_cid.GetSequenceNumber());
+    frame->SetRetirePriorTo(0);
+    frame->SetConnectionID(const_cast<uint8_t*>(new_cid.GetID()), new_cid.GetLength());
+
+    uint8_t reset_token[16];
+    for (int j = 0; j < 16; ++j) {
+        reset_token[j] = static_cast<uint8_t>(rand() % 256);
+    }
+    frame->SetStatelessResetToken(reset_token);
+    send_manager_.ToSendFrame(frame);
+
+    LOG_DEBUG("ConnectionIDCoordinator: generated PATH_NEW_CONNECTION_ID: path=%u, seq=%llu", path_id,
+        new_cid.GetSequenceNumber());
+}
+
+void ConnectionIDCoordinator::OnPathNewConnectionID(uint32_t path_id, ConnectionID& id, uint64_t retire_prior_to) {
+    auto manager = GetPathRemoteConnectionIDManager(path_id);
+    if (!manager) {
+        return;  // late frame for an abandoned path
+    }
+    if (retire_prior_to > 0) {
+        manager->RetireIDsUpTo(retire_prior_to);
+    }
+    manager->AddID(id);
+    LOG_DEBUG("ConnectionIDCoordinator: peer issued CID for path %u, seq=%llu", path_id, id.GetSequenceNumber());
+}
+
+void ConnectionIDCoordinator::OnPathRetireConnectionID(uint32_t path_id, uint64_t sequence) {
+    auto iter = path_local_managers_.find(path_id);
+    if (iter == path_local_managers_.end()) {
+        return;
+    }
+    iter->second->RetireIDBySequence(sequence);
+    if (iter->second->GetAvailableIDCount() < kPathCIDPoolSize && !closed_paths_.count(path_id)) {
+        IssuePathConnectionID(path_id);
+    }
+}
+
+uint32_t ConnectionIDCoordinator::FindPathByLocalConnectionID(uint64_t cid_hash) const {
+    auto iter = local_cid_path_.find(cid_hash);
+    return iter == local_cid_path_.end() ? 0 : iter->second;
+}
+
+bool ConnectionIDCoordinator::HasPathConnectionIDs(uint32_t path_id) const {
+    auto local = path_local_managers_.find(path_id);
+    auto remote = path_remote_managers_.find(path_id);
+    return local != path_local_managers_.end() && local->second->GetAvailableIDCount() > 0 &&
+           remote != path_remote_managers_.end() && remote->second->GetAvailableIDCount() > 0;
+}
+
+void ConnectionIDCoordinator::RemovePath(uint32_t path_id) {
+    auto iter = path_local_managers_.find(path_id);
+    if (iter != path_local_managers_.end()) {
+        // reports every CID retired, which also drops its routing entry
+        iter->second->RetireIDsUpTo(UINT64_MAX);
+        path_local_managers_.erase(iter);
+    }
+    path_remote_managers_.erase(path_id);
+    closed_paths_.insert(path_id);
+}
+
+std::shared_ptr<ConnectionIDManager> ConnectionIDCoordinator::GetPathLocalConnectionIDManager(uint32_t path_id) {
+    if (path_id == 0) {
+        return local_conn_id_manager_;
+    }
+    if (closed_paths_.count(path_id)) {
+        return nullptr;
+    }
+    auto& manager = path_local_managers_[path_id];
+    if (!manager) {
+        manager = std::make_shared<ConnectionIDManager>(
+            [this, path_id](ConnectionID& id) {
+                local_cid_path_[id.Hash()] = path_id;
+                AddConnectionId(id);
+            },
+            [this](ConnectionID& id) {
+                local_cid_path_.erase(id.Hash());
+                RetireConnectionId(id);
+            });
+    }
+    return manager;
+}
+
+std::shared_ptr<ConnectionIDManager> ConnectionIDCoordinator::GetPathRemoteConnectionIDManager(uint32_t path_id) {
+    if (path_id == 0) {
+        return remote_conn_id_manager_;
+    }
+    if (closed_paths_.count(path_id)) {
+        return nullptr;
+    }
+    auto& manager = path_remote_managers_[path_id];
+    if (!manager) {
+        manager = std::make_shared<ConnectionIDManager>();
+    }
+    return manager;
+}
+
 }  // namespace quic
 }  // namespace quicx
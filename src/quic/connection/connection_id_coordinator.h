@@ -3,7 +3,10 @@
 
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "quic/connection/connection_id_manager.h"
@@ -29,6 +32,7 @@ class SendManager;
  * - Handle connection ID rotation
  * - Manage connection ID pool
  * - Send NEW_CONNECTION_ID and RETIRE_CONNECTION_ID frames
+ * - Keep the path-bound CIDs of multipath (PATH_NEW_CONNECTION_ID)
  */
 class ConnectionIDCoordinator {
 public:
@@ -88,12 +92,60 @@ public:
      */
     bool RotateRemoteConnectionID();
 
+    /**
+     * @brief Rotate to the remote connection ID of a given sequence number
+     * Used for the CID of the server's preferred_address (RFC 9000 §9.6)
+     * @return true if that CID is known and now in use
+     */
+    bool RotateRemoteConnectionID(uint64_t sequence);
+
     /**
      * @brief Set peer's active connection ID limit (from transport parameters)
      * @param limit Active connection ID limit
      */
     void SetPeerActiveConnectionIDLimit(uint64_t limit);
 
+    // ==================== Multipath (draft-ietf-quic-multipath) ====================
+    // Path 0 uses the managers above; every other path has its own pair, and a
+    // CID issued for one path is never used on another.
+
+    /**
+     * @brief Issue CIDs for every path id in [1, max_path_id] that has none yet
+     * Sends PATH_NEW_CONNECTION_ID frames
+     */
+    void IssuePathConnectionIDs(uint32_t max_path_id);
+
+    /**
+     * @brief Peer issued a CID for `path_id` (PATH_NEW_CONNECTION_ID)
+     */
+    void OnPathNewConnectionID(uint32_t path_id, ConnectionID& id, uint64_t retire_prior_to);
+
+    /**
+     * @brief Peer retired one of our CIDs of `path_id` (PATH_RETIRE_CONNECTION_ID)
+     * Issues a replacement while the path is in use
+     */
+    void OnPathRetireConnectionID(uint32_t path_id, uint64_t sequence);
+
+    /**
+     * @brief Path a local CID was issued for
+     * @return path id, 0 for CIDs of the initial path and unknown ones
+     */
+    uint32_t FindPathByLocalConnectionID(uint64_t cid_hash) const;
+
+    /**
+     * @brief Whether both sides have issued CIDs for `path_id`
+     */
+    bool HasPathConnectionIDs(uint32_t path_id) const;
+
+    /**
+     * @brief Drop both sides' CIDs of an abandoned path; its id is not used again
+     */
+    void RemovePath(uint32_t path_id);
+
+    // nullptr once the path was removed
+    std::shared_ptr<ConnectionIDManager> GetPathLocalConnectionIDManager(uint32_t path_id);
+    std::shared_ptr<ConnectionIDManager> GetPathRemoteConnectionIDManager(uint32_t path_id);
+
     // ==================== Accessors ====================
 
     /**
@@ -128,6 +180,9 @@ public:
     std::shared_ptr<ConnectionIDManager> GetRemoteConnectionIDManagerForTest() { return remote_conn_id_manager_; }
 
 private:
+    // RETIRE_CONNECTION_ID and qlog for the remote CID just replaced by `old_cid`
+    void OnRemoteConnectionIDRotated(const ConnectionID& old_cid);
+
     // Dependencies (injected)
     std::weak_ptr<::quicx::common::IEventLoop> event_loop_;
     SendManager& send_manager_;
@@ -138,9 +193,21 @@ private:
     std::shared_ptr<ConnectionIDManager> local_conn_id_manager_;
     std::shared_ptr<ConnectionIDManager> remote_conn_id_manager_;
 
+    // Generate a CID for `path_id` and send it in PATH_NEW_CONNECTION_ID
+    void IssuePathConnectionID(uint32_t path_id);
+
     // Pool size constants
     static constexpr size_t kMinLocalCIDPoolSize = 3;  // Keep at least 3 CIDs in pool
     static constexpr size_t kMaxLocalCIDPoolSize = 8;  // Generate up to 8 CIDs
+    static constexpr size_t kPathCIDPoolSize = 2;      // CIDs issued per extra path
+
+    // Multipath: per-path CID managers (path 0 excluded) and the path of each
+    // local CID hash, used to tell which path a datagram arrived on
+    std::map<uint32_t, std::shared_ptr<ConnectionIDManager>> path_local_managers_;
+    std::map<uint32_t, std::shared_ptr<ConnectionIDManager>> path_remote_managers_;
+    std::unordered_map<uint64_t, uint32_t> local_cid_path_;
+    uint32_t path_cids_issued_up_to_{0};
+    std::set<uint32_t> closed_paths_;
 
     uint64_t peer_active_cid_limit_{2};  // Default to 2 (RFC 9000)
 
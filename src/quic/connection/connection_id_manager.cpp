@@ -136,8 +136,7 @@ bool ConnectionIDManager::UseNextID() {
         return false;
     }
 
-    // Remember the current CID's sequence and identity so we can identify which entry to retire.
-    uint64_t old_seq = cur_id_.GetSequenceNumber();
+    // Remember the current CID's identity so we can identify which entry to retire.
     ConnectionID old_cid = cur_id_;
 
     // Pick the next CID from the pool that is not equal to the current one.
@@ -162,7 +161,25 @@ bool ConnectionIDManager::UseNextID() {
 
     // Switch to next CID first so subsequent packets use the new DCID.
     cur_id_ = next_cid;
+    RetireReplacedID(old_cid);
+    return true;
+}
 
+bool ConnectionIDManager::UseID(uint64_t sequence) {
+    auto iter = sequence_cid_map_.find(sequence);
+    if (iter == sequence_cid_map_.end()) {
+        return false;
+    }
+    if (iter->second == cur_id_) {
+        return true;
+    }
+    ConnectionID old_cid = cur_id_;
+    cur_id_ = iter->second;
+    RetireReplacedID(old_cid);
+    return true;
+}
+
+void ConnectionIDManager::RetireReplacedID(const ConnectionID& old_cid) {
     // FIX: Retire ONLY the old CID's entry, not "everything <= old_seq". The previous
     // behavior of RetireIDBySequence(old_seq) accidentally evicted the freshly chosen
     // next_cid as well whenever the map happened to contain entries with sequence == old_seq
@@ -178,9 +195,6 @@ bool ConnectionIDManager::UseNextID() {
             break;
         }
     }
-    (void)old_seq;  // sequence is implicit in the entry we just erased
-
-    return true;
 }
 
 std::vector<uint64_t> ConnectionIDManager::GetAllIDHashes() {
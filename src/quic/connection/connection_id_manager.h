@@ -51,6 +51,9 @@ public:
     bool AddID(ConnectionID& id);
     bool AddID(const uint8_t* id, uint16_t len);
     bool UseNextID();
+    // Switch to the CID of `sequence` (the one of a preferred_address), retiring
+    // the current one like UseNextID(). Returns false if there is no such CID.
+    bool UseID(uint64_t sequence);
 
     // Get the number of available CIDs in the pool
     size_t GetAvailableIDCount() const { return sequence_cid_map_.size(); }
@@ -59,6 +62,9 @@ public:
     std::vector<uint64_t> GetAllIDHashes();
 
 private:
+    // Drop `old_cid` from the map, if it is there, and report it retired
+    void RetireReplacedID(const ConnectionID& old_cid);
+
     ConnectionID cur_id_;
     int64_t cur_sequence_number_;
     std::map<uint64_t, ConnectionID> sequence_cid_map_;
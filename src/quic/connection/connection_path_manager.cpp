@@ -10,10 +10,14 @@
 #include "common/network/io_handle.h"
 #include "quic/connection/connection_id_coordinator.h"
 #include "quic/connection/connection_path_manager.h"
+#include "quic/connection/controler/recv_control.h"
 #include "quic/connection/controler/send_manager.h"
 #include "quic/connection/transport_param.h"
+#include "quic/frame/max_path_id_frame.h"
+#include "quic/frame/path_abandon_frame.h"
 #include "quic/frame/path_challenge_frame.h"
 #include "quic/frame/path_response_frame.h"
+#include "quic/frame/ping_frame.h"
 
 namespace quicx {
 namespace quic {
@@ -33,13 +37,22 @@ PathManager::PathManager(Deps deps):
     is_client_initiated_migration_(false),
     migration_socket_(-1),
     migration_start_time_(0),
-    path_validation_timeout_ms_(kDefaultPathValidationTimeoutMs) {
+    path_validation_timeout_ms_(kDefaultPathValidationTimeoutMs),
+    timer_(std::move(deps.timer)),
+    send_on_path_cb_(std::move(deps.send_on_path_cb)) {
     memset(pending_path_challenge_data_, 0, sizeof(pending_path_challenge_data_));
 }
 
 PathManager::~PathManager() {
     // Cleanup any pending migration socket
     CleanupMigrationState();
+
+    for (auto& kv : paths_) {
+        CancelTimer(kv.second->challenge_task);
+        if (kv.second->owns_socket && kv.second->sockfd > 0) {
+            common::Close(kv.second->sockfd);
+        }
+    }
 }
 
 // ==================== Path Validation ====================
@@ -113,6 +126,9 @@ void PathManager::StartNextPathProbe() {
 }
 
 void PathManager::OnPathResponse(const uint8_t* data) {
+    if (OnMultipathResponse(data)) {
+        return;
+    }
     if (!path_probe_inflight_) {
         return;
     }
@@ -279,7 +295,7 @@ MigrationResult PathManager::InitiateMigrationToAddress(const ::quicx::common::A
     LOG_DEBUG("PathManager: pre-rotated DCID for client-initiated migration");
 
     // 4. Create new socket bound to the specified local address
-    int32_t new_socket = CreateBoundSocket(local_addr);
+    int32_t new_socket = CreateBoundSocket(local_addr, new_local_addr_);
     if (new_socket < 0) {
         // Rotation already happened, but we failed. This is bad but we continue with old socket.
         LOG_ERROR("PathManager: failed to create socket for migration");
@@ -296,7 +312,6 @@ MigrationResult PathManager::InitiateMigrationToAddress(const ::quicx::common::A
 
     // 6. Store migration state
     migration_socket_ = new_socket;
-    // new_local_addr_ is populated by CreateBoundSocket
     is_client_initiated_migration_ = true;
     migration_start_time_ = common::UTCTimeMsec();
 
@@ -318,6 +333,25 @@ MigrationResult PathManager::InitiateMigrationToAddress(const ::quicx::common::A
     return MigrationResult::kSuccess;
 }
 
+void PathManager::MigrateToPreferredAddress(const ::quicx::common::Address& peer_addr, uint64_t cid_sequence) {
+    if (path_probe_inflight_) {
+        LOG_WARN("PathManager: probe in progress, preferred address %s:%d not probed", peer_addr.GetIp().c_str(),
+            peer_addr.GetPort());
+        return;
+    }
+    if (!cid_coordinator_.RotateRemoteConnectionID(cid_sequence)) {
+        LOG_WARN("PathManager: CID of the preferred address unavailable, staying on %s:%d",
+            peer_addr_.GetIp().c_str(), peer_addr_.GetPort());
+        return;
+    }
+    LOG_DEBUG("PathManager: pre-rotated DCID to preferred address CID seq=%llu", cid_sequence);
+
+    candidate_peer_addr_ = peer_addr;
+    StartPathValidationProbeWithPreRotation();
+    LOG_INFO("PathManager: started path validation probe to preferred address %s:%d", peer_addr.GetIp().c_str(),
+        peer_addr.GetPort());
+}
+
 // ==================== Anti-Amplification ====================
 
 void PathManager::EnterAntiAmplification() {
@@ -527,7 +561,8 @@ void PathManager::CleanupMigrationState() {
     migration_start_time_ = 0;
 }
 
-int32_t PathManager::CreateBoundSocket(const ::quicx::common::Address& local_addr) {
+int32_t PathManager::CreateBoundSocket(
+    const ::quicx::common::Address& local_addr, ::quicx::common::Address& bound_addr) {
     // Determine if peer is IPv4 or IPv6 to create matching socket type
     bool peer_is_ipv4 = (peer_addr_.GetIp().find(':') == std::string::npos);
 
@@ -556,6 +591,7 @@ int32_t PathManager::CreateBoundSocket(const ::quicx::common::Address& local_add
 
     // Set non-blocking
     common::SocketNoblocking(sockfd);
+    common::EnableUdpDontFragment(sockfd);
 
     // Bind to specified address (for IPv4 socket, use 0.0.0.0 if address is :: or empty)
     common::Address bind_addr = local_addr;
@@ -573,15 +609,337 @@ int32_t PathManager::CreateBoundSocket(const ::quicx::common::Address& local_add
     }
 
     // Get the actual assigned port and address
-    if (!common::ParseLocalAddress(sockfd, new_local_addr_)) {
-        new_local_addr_ = bind_addr;
+    if (!common::ParseLocalAddress(sockfd, bound_addr)) {
+        bound_addr = bind_addr;
     }
 
-    LOG_INFO("PathManager: created migration socket %d bound to %s:%d (peer_is_ipv4=%d)", sockfd,
-        new_local_addr_.GetIp().c_str(), new_local_addr_.GetPort(), peer_is_ipv4);
+    LOG_INFO("PathManager: created socket %d bound to %s:%d (peer_is_ipv4=%d)", sockfd,
+        bound_addr.GetIp().c_str(), bound_addr.GetPort(), peer_is_ipv4);
 
     return sockfd;
 }
 
+// ==================== Multipath ====================
+
+void PathManager::OnMultipathNegotiated() {
+    if (multipath_enabled_ || !transport_param_.IsMultipathEnabled()) {
+        return;
+    }
+    multipath_enabled_ = true;
+    local_max_path_id_ = static_cast<uint32_t>(std::min<uint64_t>(transport_param_.GetInitialMaxPathId(), UINT32_MAX));
+    peer_max_path_id_ =
+        static_cast<uint32_t>(std::min<uint64_t>(transport_param_.GetPeerInitialMaxPathId(), UINT32_MAX));
+    LOG_INFO("PathManager: multipath negotiated, max path id local=%u peer=%u", local_max_path_id_, peer_max_path_id_);
+    IssuePathConnectionIDs();
+}
+
+uint32_t PathManager::OpenPath(const ::quicx::common::Address& local_addr) {
+    if (!multipath_enabled_) {
+        LOG_WARN("PathManager: multipath not negotiated, no path opened");
+        return 0;
+    }
+    while (paths_.count(next_path_id_) > 0) {
+        next_path_id_++;
+    }
+    uint32_t path_id = next_path_id_;
+    if (path_id > std::min(local_max_path_id_, peer_max_path_id_)) {
+        LOG_WARN("PathManager: path id %u above the limit (local=%u, peer=%u)", path_id, local_max_path_id_,
+            peer_max_path_id_);
+        return 0;
+    }
+    // the peer needs a CID of ours to answer on the path, and we one of its
+    if (!cid_coordinator_.HasPathConnectionIDs(path_id)) {
+        LOG_WARN("PathManager: no connection IDs for path %u yet", path_id);
+        return 0;
+    }
+
+    ::quicx::common::Address bound_addr;
+    int32_t sockfd = CreateBoundSocket(local_addr, bound_addr);
+    if (sockfd < 0) {
+        return 0;
+    }
+    PathInfo* path = CreatePath(path_id);
+    if (!path) {
+        common::Close(sockfd);
+        return 0;
+    }
+    next_path_id_++;
+    path->sockfd = sockfd;
+    path->owns_socket = true;
+    path->local_addr = bound_addr;
+    path->peer_addr = peer_addr_;
+
+    LOG_INFO("PathManager: opening path %u from %s:%d to %s:%d", path_id, bound_addr.GetIp().c_str(),
+        bound_addr.GetPort(), peer_addr_.GetIp().c_str(), peer_addr_.GetPort());
+    StartPathChallenge(*path);
+    return path_id;
+}
+
+bool PathManager::ClosePath(uint32_t path_id) {
+    if (!HasPath(path_id)) {
+        return false;
+    }
+    RemovePath(path_id, kApplicationAbandonPath, true);
+    return true;
+}
+
+bool PathManager::CanAcceptPath(uint32_t path_id) const {
+    return multipath_enabled_ && path_id > 0 && path_id <= local_max_path_id_ &&
+           cid_coordinator_.HasPathConnectionIDs(path_id);
+}
+
+void PathManager::AcceptPath(uint32_t path_id, const ::quicx::common::Address& peer_addr, int32_t sockfd) {
+    if (HasPath(path_id) || !CanAcceptPath(path_id)) {
+        return;
+    }
+    PathInfo* path = CreatePath(path_id);
+    if (!path) {
+        return;
+    }
+    path->sockfd = sockfd;
+    path->peer_addr = peer_addr;
+    LOG_INFO("PathManager: peer opened path %u from %s:%d", path_id, peer_addr.GetIp().c_str(), peer_addr.GetPort());
+}
+
+void PathManager::DiscardPath(uint32_t path_id) {
+    auto iter = paths_.find(path_id);
+    if (iter == paths_.end() || iter->second->validated || iter->second->challenge_inflight) {
+        return;
+    }
+    send_manager_.AbandonPath(path_id);
+    paths_.erase(iter);
+}
+
+bool PathManager::IsPathValidated(uint32_t path_id) const {
+    auto iter = paths_.find(path_id);
+    return iter != paths_.end() && iter->second->validated;
+}
+
+void PathManager::OnPathPacketReceived(
+    uint32_t path_id, const ::quicx::common::Address& addr, int32_t sockfd) {
+    auto iter = paths_.find(path_id);
+    if (iter == paths_.end()) {
+        return;
+    }
+    PathInfo& path = *iter->second;
+    if (!path.owns_socket && sockfd > 0) {
+        path.sockfd = sockfd;
+    }
+    if (!(addr == path.peer_addr)) {
+        // the peer address of this path moved (NAT rebinding): no data until
+        // the new address answered a PATH_CHALLENGE
+        LOG_INFO("PathManager: path %u moved from %s:%d to %s:%d", path_id, path.peer_addr.GetIp().c_str(),
+            path.peer_addr.GetPort(), addr.GetIp().c_str(), addr.GetPort());
+        path.peer_addr = addr;
+        path.validated = false;
+        send_manager_.SetPathUsable(path_id, false);
+        StartPathChallenge(path);
+    } else if (!path.validated && !path.challenge_inflight) {
+        StartPathChallenge(path);
+    }
+}
+
+void PathManager::OnPeerPathAbandon(uint32_t path_id, uint64_t error_code) {
+    LOG_INFO("PathManager: peer abandoned path %u, error=0x%llx", path_id, error_code);
+    if (path_id == 0) {
+        // path 0 carries the connection until it closes
+        LOG_WARN("PathManager: abandoning path 0 is not supported, ignored");
+        return;
+    }
+    // answered with a PATH_ABANDON of our own
+    RemovePath(path_id, kApplicationAbandonPath, true);
+}
+
+void PathManager::OnPeerPathStatus(uint32_t path_id, uint64_t sequence, bool backup) {
+    auto iter = path_status_sequences_.find(path_id);
+    if (iter != path_status_sequences_.end() && sequence <= iter->second) {
+        return;  // reordered, a newer status was applied already
+    }
+    path_status_sequences_[path_id] = sequence;
+    send_manager_.SetPathBackup(path_id, backup);
+}
+
+void PathManager::OnPeerMaxPathId(uint32_t max_path_id) {
+    if (max_path_id <= peer_max_path_id_) {
+        return;
+    }
+    peer_max_path_id_ = max_path_id;
+    IssuePathConnectionIDs();
+}
+
+std::vector<uint32_t> PathManager::GetPathIds() const {
+    std::vector<uint32_t> ids;
+    ids.reserve(paths_.size());
+    for (auto& kv : paths_) {
+        ids.push_back(kv.first);
+    }
+    return ids;
+}
+
+RecvControl* PathManager::GetPathRecvControl(uint32_t path_id) {
+    auto iter = paths_.find(path_id);
+    return iter == paths_.end() ? nullptr : iter->second->recv_control.get();
+}
+
+int32_t PathManager::GetPathSocket(uint32_t path_id) const {
+    auto iter = paths_.find(path_id);
+    return iter == paths_.end() ? -1 : iter->second->sockfd;
+}
+
+::quicx::common::Address PathManager::GetPathPeerAddress(uint32_t path_id) const {
+    auto iter = paths_.find(path_id);
+    return iter == paths_.end() ? peer_addr_ : iter->second->peer_addr;
+}
+
+PathManager::PathInfo* PathManager::CreatePath(uint32_t path_id) {
+    if (!send_manager_.AddPath(path_id)) {
+        return nullptr;
+    }
+    auto path = std::unique_ptr<PathInfo>(new PathInfo());
+    path->path_id = path_id;
+    path->recv_control.reset(new RecvControl(timer_));
+    path->recv_control->SetPathId(path_id);
+    path->recv_control->SetActiveSendCB(active_send_cb_);
+    path->recv_control->UpdateConfig(transport_param_);
+
+    // ACK-of-ACK and PTO probes stay on the path
+    RecvControl* recv_control = path->recv_control.get();
+    SendControl* send_control = send_manager_.GetPathSendControl(path_id);
+    send_control->SetAckFrameAckedCallback([recv_control](PacketNumberSpace ns, uint64_t largest_acked) {
+        recv_control->OnAckFrameAcked(ns, largest_acked);
+    });
+    send_control->SetApplicationProbeCallback(
+        [this, path_id]() { send_on_path_cb_(path_id, std::make_shared<PingFrame>()); });
+
+    PathInfo* raw = path.get();
+    paths_.emplace(path_id, std::move(path));
+    return raw;
+}
+
+void PathManager::StartPathChallenge(PathInfo& path) {
+    auto challenge = std::make_shared<PathChallengeFrame>();
+    challenge->MakeData();
+    memcpy(path.challenge_data, challenge->GetData(), 8);
+    path.challenge_inflight = true;
+    path.challenge_retries = 0;
+    path.challenge_delay_ms = kInitialProbeDelayMs;
+    send_on_path_cb_(path.path_id, challenge);
+    SchedulePathChallengeRetry(path);
+}
+
+void PathManager::SchedulePathChallengeRetry(PathInfo& path) {
+    auto loop = event_loop_.lock();
+    if (!loop) return;
+    loop->RemoveTimer(path.challenge_task);
+    if (!path.challenge_inflight) {
+        return;
+    }
+
+    if (path.challenge_retries >= kMaxProbeRetries) {
+        LOG_WARN("PathManager: path %u not validated after %u attempts, abandoning it", path.path_id,
+            path.challenge_retries);
+        RemovePath(path.path_id, kPathUnstableOrPoor, true);
+        return;
+    }
+
+    path.challenge_retries++;
+    path.challenge_delay_ms = std::min<uint32_t>(path.challenge_delay_ms * 2, kMaxProbeDelayMs);
+
+    uint32_t path_id = path.path_id;
+    path.challenge_task.SetTimeoutCallback([this, path_id]() {
+        auto iter = paths_.find(path_id);
+        if (iter == paths_.end() || !iter->second->challenge_inflight) {
+            return;
+        }
+        PathInfo& retry_path = *iter->second;
+        auto challenge = std::make_shared<PathChallengeFrame>();
+        challenge->MakeData();
+        memcpy(retry_path.challenge_data, challenge->GetData(), 8);
+        LOG_DEBUG("PathManager: retrying validation of path %u (attempt %u/%u)", path_id,
+            retry_path.challenge_retries + 1, kMaxProbeRetries);
+        send_on_path_cb_(path_id, challenge);
+        SchedulePathChallengeRetry(retry_path);
+    });
+    loop->AddTimer(path.challenge_task, path.challenge_delay_ms, 0);
+}
+
+void PathManager::RemovePath(uint32_t path_id, uint64_t error_code, bool send_abandon) {
+    auto iter = paths_.find(path_id);
+    if (iter == paths_.end()) {
+        return;
+    }
+    // out of the map first: what is resent below must not pick this path
+    std::unique_ptr<PathInfo> path = std::move(iter->second);
+    paths_.erase(iter);
+    path_status_sequences_.erase(path_id);
+    auto loop = event_loop_.lock();
+    if (loop) {
+        loop->RemoveTimer(path->challenge_task);
+    }
+
+    if (send_abandon) {
+        auto abandon = std::make_shared<PathAbandonFrame>();
+        abandon->SetPathId(path_id);
+        abandon->SetErrorCode(error_code);
+        to_send_frame_cb_(abandon);
+    }
+    send_manager_.AbandonPath(path_id);
+    cid_coordinator_.RemovePath(path_id);
+    if (path->owns_socket && path->sockfd > 0) {
+        common::Close(path->sockfd);
+    }
+    LOG_INFO("PathManager: path %u removed, error=0x%llx", path_id, error_code);
+
+    // the id is never used again; let the peer open another path instead
+    local_max_path_id_++;
+    auto max_path_id = std::make_shared<MaxPathIdFrame>();
+    max_path_id->SetMaxPathId(local_max_path_id_);
+    to_send_frame_cb_(max_path_id);
+    IssuePathConnectionIDs();
+}
+
+void PathManager::IssuePathConnectionIDs() {
+    cid_coordinator_.IssuePathConnectionIDs(std::min(local_max_path_id_, peer_max_path_id_));
+}
+
+bool PathManager::OnMultipathResponse(const uint8_t* data) {
+    for (auto& kv : paths_) {
+        PathInfo& path = *kv.second;
+        if (!path.challenge_inflight || memcmp(data, path.challenge_data, 8) != 0) {
+            continue;
+        }
+        path.challenge_inflight = false;
+        auto loop = event_loop_.lock();
+        if (loop) {
+            loop->RemoveTimer(path.challenge_task);
+        }
+        path.validated = true;
+        send_manager_.SetPathUsable(path.path_id, true);
+        LOG_INFO("PathManager: path %u validated, peer %s:%d", path.path_id, path.peer_addr.GetIp().c_str(),
+            path.peer_addr.GetPort());
+        active_send_cb_();
+        return true;
+    }
+    return false;
+}
+
+void PathManager::CancelTimer(::quicx::common::TimerTask& task) {
+    // see CleanupMigrationState() for why the loop thread matters
+    auto loop = event_loop_.lock();
+    if (!loop) {
+        return;
+    }
+    if (loop->IsInLoopThread()) {
+        loop->RemoveTimer(task);
+        return;
+    }
+    uint64_t task_id = task.GetId();
+    loop->RunInLoop([loop, task_id]() {
+        common::TimerTask probe;
+        probe.SetIdForTest(task_id);
+        loop->RemoveTimer(probe);
+    });
+}
+
 }  // namespace quic
 }  // namespace quicx
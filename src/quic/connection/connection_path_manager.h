@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -16,6 +17,7 @@ namespace quicx {
 // Forward declarations from common namespace
 namespace common {
 class IEventLoop;
+class ITimer;
 }
 
 namespace quic {
@@ -25,6 +27,7 @@ class SendManager;
 class ConnectionIDCoordinator;
 class TransportParam;
 class IFrame;
+class RecvControl;
 
 /**
  * @brief Path manager for connection migration and path validation
@@ -35,8 +38,10 @@ class IFrame;
  * - Anti-amplification protection during path validation
  * - Candidate address queue management
  * - Local address change support for production-grade migration
+ * - Multipath: opening, validating and abandoning the paths besides path 0
  *
  * RFC 9000 Section 9: Connection Migration
+ * draft-ietf-quic-multipath: Multipath Extension for QUIC
  */
 class PathManager {
 public:
@@ -46,6 +51,7 @@ public:
     using MigrationCompleteCallback = std::function<void(const MigrationInfo&)>;
     using GetSocketCallback = std::function<int32_t()>;
     using SetMigrationSocketCallback = std::function<void(int32_t)>;
+    using SendOnPathCallback = std::function<void(uint32_t path_id, std::shared_ptr<IFrame>)>;
 
     /**
      * @brief Construction-time dependencies for PathManager.
@@ -59,7 +65,8 @@ public:
      *  - `event_loop` is held as `weak_ptr` (no lifetime bump).
      *  - `send_manager`, `cid_coordinator`, `transport_param`, `peer_addr`
      *    are stored as references and MUST outlive the PathManager.
-     *  - The three callbacks are copied (std::function); they capture
+     *  - `timer` drives the ACK timers of the per-path RecvControls.
+     *  - The callbacks are copied (std::function); they capture
      *    `BaseConnection*` via `this`, so the connection must outlive the
      *    PathManager (it does — PathManager is a member of BaseConnection).
      */
@@ -72,6 +79,9 @@ public:
         ToSendFrameCallback                          to_send_frame_cb;
         ActiveSendCallback                           active_send_cb;
         SetPeerAddressCallback                       set_peer_addr_cb;
+        std::shared_ptr<::quicx::common::ITimer>     timer;
+        // Multipath: send a frame right away in a 1-RTT packet of that path
+        SendOnPathCallback                           send_on_path_cb;
     };
 
     explicit PathManager(Deps deps);
@@ -140,6 +150,19 @@ public:
      */
     MigrationResult InitiateMigrationToAddress(const ::quicx::common::Address& local_addr);
 
+    /**
+     * @brief Migrate to the server's preferred address (RFC 9000 §9.6)
+     *
+     * Like InitiateMigrationToAddress(), the DCID is rotated before the
+     * PATH_CHALLENGE goes out, here to the CID that came with the preferred
+     * address, so the new path never sees the CID of the handshake path.
+     * The peer address switches once the PATH_RESPONSE arrives.
+     *
+     * @param peer_addr Preferred address of our address family
+     * @param cid_sequence Sequence number of the CID it came with
+     */
+    void MigrateToPreferredAddress(const ::quicx::common::Address& peer_addr, uint64_t cid_sequence);
+
     /**
      * @brief Set callback for migration completion events
      * @param cb Callback invoked when migration completes (success or failure)
@@ -202,6 +225,105 @@ public:
      */
     bool IsClientInitiatedMigration() const { return is_client_initiated_migration_; }
 
+    // ==================== Multipath (draft-ietf-quic-multipath) ====================
+    // Path 0 is the path of the handshake and keeps using everything above.
+    // Every other path has its own socket (client) or peer address (server),
+    // its own packet number space in SendManager and its own RecvControl, and
+    // carries data once a PATH_CHALLENGE sent on it is answered. A path id is
+    // never reused: abandoning one raises the limit of the peer by one.
+
+    /**
+     * @brief Both sides sent initial_max_path_id; issue CIDs for the paths allowed
+     */
+    void OnMultipathNegotiated();
+
+    /**
+     * @brief Whether the multipath extension is in use on this connection
+     */
+    bool IsMultipathEnabled() const { return multipath_enabled_; }
+
+    /**
+     * @brief Client: open a new path from `local_addr` to the current peer address
+     * Binds a socket, adds the path to SendManager and starts validating it.
+     * @return the path id, 0 if no path can be opened (extension not negotiated,
+     *         path id limit reached, no CID for the path yet, bind failed)
+     */
+    uint32_t OpenPath(const ::quicx::common::Address& local_addr);
+
+    /**
+     * @brief Abandon a path (PATH_ABANDON); its data in flight goes out on the others
+     * @return false for path 0 and unknown paths
+     */
+    bool ClosePath(uint32_t path_id);
+
+    /**
+     * @brief Server: whether a datagram that arrived with a CID of `path_id` may
+     * open that path
+     */
+    bool CanAcceptPath(uint32_t path_id) const;
+
+    /**
+     * @brief Server: a datagram with a CID of the unknown `path_id` arrived
+     * Sets up the path; it carries no data before OnPathPacketReceived() validated it.
+     */
+    void AcceptPath(uint32_t path_id, const ::quicx::common::Address& peer_addr, int32_t sockfd);
+
+    /**
+     * @brief Drop a path set up by AcceptPath() whose first datagram did not decrypt
+     */
+    void DiscardPath(uint32_t path_id);
+
+    /**
+     * @brief A packet of `path_id` was processed
+     * Starts validating the path, or validates it again if the peer address changed.
+     */
+    void OnPathPacketReceived(uint32_t path_id, const ::quicx::common::Address& addr, int32_t sockfd);
+
+    // Frames of the peer
+    void OnPeerPathAbandon(uint32_t path_id, uint64_t error_code);
+    void OnPeerPathStatus(uint32_t path_id, uint64_t sequence, bool backup);
+    void OnPeerMaxPathId(uint32_t max_path_id);
+
+    bool HasPath(uint32_t path_id) const { return paths_.count(path_id) > 0; }
+    // answered a PATH_CHALLENGE, i.e. carries data
+    bool IsPathValidated(uint32_t path_id) const;
+    std::vector<uint32_t> GetPathIds() const;
+    // nullptr for path 0 and unknown paths
+    RecvControl* GetPathRecvControl(uint32_t path_id);
+    // -1 / the connection's peer address for path 0 and unknown paths
+    int32_t GetPathSocket(uint32_t path_id) const;
+    ::quicx::common::Address GetPathPeerAddress(uint32_t path_id) const;
+    uint32_t GetLocalMaxPathId() const { return local_max_path_id_; }
+
+private:
+    struct PathInfo {
+        uint32_t path_id{0};
+        int32_t sockfd{-1};
+        bool owns_socket{false};  // opened by OpenPath(), closed with the path
+        ::quicx::common::Address local_addr;
+        ::quicx::common::Address peer_addr;
+        bool validated{false};
+        bool challenge_inflight{false};
+        uint8_t challenge_data[8]{0};
+        ::quicx::common::TimerTask challenge_task;
+        uint32_t challenge_retries{0};
+        uint32_t challenge_delay_ms{0};
+        std::unique_ptr<RecvControl> recv_control;
+    };
+
+    // Add the path to SendManager and create its receive state
+    PathInfo* CreatePath(uint32_t path_id);
+    void StartPathChallenge(PathInfo& path);
+    void SchedulePathChallengeRetry(PathInfo& path);
+    // Forget everything about a path; sends PATH_ABANDON if `send_abandon`
+    void RemovePath(uint32_t path_id, uint64_t error_code, bool send_abandon);
+    // Issue CIDs for the path ids both sides allow
+    void IssuePathConnectionIDs();
+    // Match a PATH_RESPONSE against the challenges of the paths
+    bool OnMultipathResponse(const uint8_t* data);
+    // Remove a timer, also from outside the loop thread (destructor)
+    void CancelTimer(::quicx::common::TimerTask& task);
+
 private:
     /**
      * @brief Internal implementation for starting path validation probe
@@ -236,7 +358,7 @@ private:
      * @param local_addr Address to bind to
      * @return Socket fd on success, -1 on failure
      */
-    int32_t CreateBoundSocket(const ::quicx::common::Address& local_addr);
+    int32_t CreateBoundSocket(const ::quicx::common::Address& local_addr, ::quicx::common::Address& bound_addr);
 
 private:
     // Dependencies (injected)
@@ -296,6 +418,25 @@ private:
     // — at least 3×PTO, see kDefaultPathValidationTimeoutMs in
     // quic/common/constants.h).
     uint32_t path_validation_timeout_ms_{kDefaultPathValidationTimeoutMs};
+
+    // ==================== Multipath State ====================
+
+    std::shared_ptr<::quicx::common::ITimer> timer_;
+    SendOnPathCallback send_on_path_cb_;
+    bool multipath_enabled_{false};
+    // Highest path id we allow (advertised in initial_max_path_id / MAX_PATH_ID)
+    // and the highest one the peer allows
+    uint32_t local_max_path_id_{0};
+    uint32_t peer_max_path_id_{0};
+    // Next path id OpenPath() tries; ids of paths the peer opened are skipped
+    uint32_t next_path_id_{1};
+    std::map<uint32_t, std::unique_ptr<PathInfo>> paths_;
+    // Sequence number of the last PATH_STATUS_* frame applied, per path
+    std::map<uint32_t, uint64_t> path_status_sequences_;
+
+    // PATH_ABANDON error codes (draft-ietf-quic-multipath)
+    static constexpr uint64_t kApplicationAbandonPath = 0x004150504142414e;
+    static constexpr uint64_t kPathUnstableOrPoor = 0x0041505041424153;
 };
 
 }  // namespace quic
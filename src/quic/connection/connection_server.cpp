@@ -160,6 +160,8 @@ void ServerConnection::WriteCryptoData(std::shared_ptr<IBufferRead> buffer, int3
 
         // Mark handshake complete to stop PTO probing
         send_manager_.GetSendControl().SetHandshakeComplete();
+        // RFC 9000 §14.3: the handshake is confirmed, search for a larger PLPMTU
+        send_manager_.StartMtuProbe();
 
         // RFC 9000 Section 4.10: Server discards Initial and Handshake spaces after sending HANDSHAKE_DONE
         recv_control_.DiscardPacketNumberSpace(PacketNumberSpace::kInitialNumberSpace);
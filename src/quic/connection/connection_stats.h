@@ -0,0 +1,80 @@
+#ifndef QUIC_CONNECTION_CONNECTION_STATS
+#define QUIC_CONNECTION_CONNECTION_STATS
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include <quicx/quic/type.h>
+
+namespace quicx {
+namespace quic {
+
+/**
+ * @brief Copy of QuicConnectionStats readable from any thread
+ *
+ * A sequence lock: the connection's thread is the only writer and bumps the
+ * sequence to odd before storing the fields and back to even after; a reader
+ * copies the fields and retries if the sequence was odd or moved meanwhile.
+ * Neither side takes a lock or allocates, and a reader never sees half of
+ * one snapshot mixed with another.
+ *
+ * The fields are kept as relaxed atomics so that the racing reads are well
+ * defined; the fences around them order them against the sequence.
+ */
+class ConnectionStatsSnapshot {
+public:
+    ConnectionStatsSnapshot() {
+        for (auto& field : fields_) {
+            field.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Connection thread only.
+    void Publish(const QuicConnectionStats& stats) {
+        uint64_t values[kFieldCount];
+        memcpy(values, &stats, sizeof(values));
+
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kFieldCount; i++) {
+            fields_[i].store(values[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Any thread. False if nothing was published yet.
+    bool Read(QuicConnectionStats& stats) const {
+        uint64_t values[kFieldCount];
+        uint32_t before;
+        uint32_t after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < kFieldCount; i++) {
+                values[i] = fields_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        if (before == 0) {
+            return false;
+        }
+        memcpy(&stats, values, sizeof(values));
+        return true;
+    }
+
+private:
+    static_assert(sizeof(QuicConnectionStats) % sizeof(uint64_t) == 0,
+        "QuicConnectionStats must only hold uint64_t fields");
+    static constexpr size_t kFieldCount = sizeof(QuicConnectionStats) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<uint64_t> fields_[kFieldCount];
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -42,16 +42,25 @@ const char* StreamStateToString(StreamState state) {
 StreamManager::StreamManager(IConnectionEventSink& event_sink, std::shared_ptr<::quicx::common::IEventLoop> event_loop,
     TransportParam& transport_param, SendManager& send_manager, StreamStateCallback stream_state_cb,
     SendFlowController* send_flow_controller):
+    scheduler_(MakeStreamScheduler(StreamSchedulerType::kStrictPriority)),
+    building_frames_(false),
     event_sink_(event_sink),
     event_loop_(event_loop),
     send_flow_controller_(send_flow_controller),
     transport_param_(transport_param),
     send_manager_(send_manager),
-    stream_state_cb_(stream_state_cb) {}
+    stream_state_cb_(stream_state_cb),
+    send_buffer_watermark_(std::make_shared<SendBufferWatermark>()),
+    stream_send_buffer_high_(0),
+    stream_send_buffer_low_(0) {}
 
 StreamManager::~StreamManager() {
     // Clear callback to prevent use-after-free
     stream_state_cb_ = nullptr;
+    // the application may still hold streams
+    for (auto& entry : streams_map_) {
+        DetachStream(entry.second);
+    }
 
     // Metric balance: any stream still in streams_map_ at destruction time was
     // never routed through InnerStreamClose (e.g. CONNECTION_CLOSE / abrupt
@@ -198,6 +207,21 @@ std::shared_ptr<IStream> StreamManager::MakeStream(uint32_t send_size, uint64_t
             event_loop_, recv_size, stream_id, active_send_cb, stream_close_cb, connection_close_cb);
     }
 
+    // Receive windows auto-tune on the connection's RTT, and what the
+    // application reads is credited back at the connection level too
+    auto recv_stream = std::dynamic_pointer_cast<RecvStream>(stream);
+    if (recv_stream) {
+        recv_stream->SetRttProvider([this]() { return send_manager_.GetRtt(); });
+        recv_stream->SetDataConsumedCallBack([this](uint64_t bytes) { event_sink_.OnStreamDataConsumed(bytes); });
+    }
+    // and what a sender may write now depends on the connection's budget
+    auto send_stream = std::dynamic_pointer_cast<SendStream>(stream);
+    if (send_stream) {
+        send_stream->SetSendBudgetProvider([this]() { return send_manager_.GetSendBudget(); });
+        send_stream->SetSendBufferWatermark(stream_send_buffer_high_, stream_send_buffer_low_);
+        send_stream->SetConnectionWatermark(send_buffer_watermark_);
+    }
+
     LOG_DEBUG("StreamManager::MakeStream: created stream %llu, type %d, send_size %u, recv_size %u", stream_id,
         static_cast<int>(type), send_size, recv_size);
 
@@ -224,6 +248,7 @@ std::shared_ptr<IStream> StreamManager::MakeStream(uint32_t send_size, uint64_t
             }
         }
         streams_map_[stream_id] = stream;
+        opened_streams_++;
         LOG_DEBUG("StreamManager: created stream %llu (type=%d)", stream_id, static_cast<int>(type));
     }
     return stream;
@@ -231,12 +256,39 @@ std::shared_ptr<IStream> StreamManager::MakeStream(uint32_t send_size, uint64_t
 
 // ==================== Stream Closure ====================
 
+void StreamManager::DetachStream(const std::shared_ptr<IStream>& stream) {
+    auto send_stream = std::dynamic_pointer_cast<SendStream>(stream);
+    if (send_stream) {
+        send_stream->SetSendBudgetProvider(nullptr);
+        send_stream->ReleaseSendBuffer();
+    }
+    // zero-copy reads dropped later were already credited on close
+    auto recv_stream = std::dynamic_pointer_cast<RecvStream>(stream);
+    if (recv_stream) {
+        recv_stream->SetRttProvider(nullptr);
+        recv_stream->SetDataConsumedCallBack(nullptr);
+    }
+}
+
+void StreamManager::SetSendBufferWatermarks(uint32_t stream_high, uint32_t stream_low, uint32_t conn_high, uint32_t conn_low) {
+    stream_send_buffer_high_ = stream_high;
+    stream_send_buffer_low_ = stream_low;
+    send_buffer_watermark_->SetMarks(conn_high, conn_low);
+}
+
 void StreamManager::CloseStream(uint64_t stream_id) {
     auto iter = streams_map_.find(stream_id);
     if (iter == streams_map_.end()) {
         return;
     }
 
+    // data the application never read must not stay charged against MAX_DATA
+    auto recv_stream = std::dynamic_pointer_cast<RecvStream>(iter->second);
+    if (recv_stream && recv_stream->GetUnconsumedBytes() > 0) {
+        event_sink_.OnStreamDataConsumed(recv_stream->GetUnconsumedBytes());
+    }
+    DetachStream(iter->second);
+
     streams_map_.erase(iter);
 
     LOG_DEBUG("StreamManager: closed stream %llu", stream_id);
@@ -304,6 +356,23 @@ void StreamManager::OnStreamDataAcked(uint64_t stream_id, uint64_t offset_start,
     send_stream->OnDataAcked(offset_start, length, has_fin);
 }
 
+void StreamManager::OnStreamDataLost(uint64_t stream_id, uint64_t offset_start, uint64_t length, bool has_fin) {
+    common::LogTagGuard guard("|strm:" + std::to_string(stream_id));
+    auto stream = FindStream(stream_id);
+    if (!stream) {
+        LOG_DEBUG("StreamManager: stream %llu not found in OnStreamDataLost, dropping lost range", stream_id);
+        return;
+    }
+
+    auto send_stream = std::dynamic_pointer_cast<SendStream>(stream);
+    if (!send_stream) {
+        LOG_DEBUG("StreamManager: stream %llu is not a SendStream", stream_id);
+        return;
+    }
+
+    send_stream->OnDataLost(offset_start, length, has_fin);
+}
+
 // ==================== Stream Reset ====================
 
 void StreamManager::ResetAllStreams(uint64_t error) {
@@ -342,6 +411,17 @@ std::vector<uint64_t> StreamManager::GetAllStreamIDs() const {
 
 // ==================== Stream Scheduling (Week 4 Refactoring) ====================
 
+void StreamManager::SetStreamScheduler(StreamSchedulerType type) {
+    if (scheduler_->GetType() == type) {
+        return;
+    }
+    auto scheduler = MakeStreamScheduler(type);
+    while (auto stream = scheduler_->Pop()) {
+        scheduler->Push(stream);
+    }
+    scheduler_ = std::move(scheduler);
+}
+
 void StreamManager::MarkStreamActive(std::shared_ptr<IStream> stream) {
     if (!stream) {
         LOG_ERROR("StreamManager::MarkStreamActive: null stream");
@@ -352,8 +432,21 @@ void StreamManager::MarkStreamActive(std::shared_ptr<IStream> stream) {
     common::LogTagGuard guard("|strm:" + std::to_string(stream_id));
     LOG_DEBUG("StreamManager: marking stream %llu as active", stream_id);
 
-    // Add to write buffer (safe during BuildStreamFrames processing)
-    active_streams_.Add(stream);
+    // Queued after the current BuildStreamFrames() pass
+    if (building_frames_) {
+        marked_while_building_.push_back(stream);
+        return;
+    }
+
+    // The CryptoStream uses stream_id == 0, BUT a client-initiated bidi stream
+    // can ALSO have id == 0 (RFC 9000 §2.1: client-initiated bidi stream ids
+    // = 0, 4, 8, ...), so we MUST differentiate by actual object type, not by
+    // stream_id.
+    if (std::dynamic_pointer_cast<CryptoStream>(stream) != nullptr) {
+        active_crypto_stream_ = stream;
+    } else {
+        scheduler_->Push(stream);
+    }
 
     // NOTE: Do NOT call event_sink_.OnStreamDataReady(stream) here!
     // This would cause infinite recursion:
@@ -367,77 +460,96 @@ bool StreamManager::BuildStreamFrames(IFrameVisitor* visitor, uint8_t encrypto_l
         return false;
     }
 
-    // Swap buffers: move unfinished streams from read to write buffer
-    active_streams_.Swap();
-    auto& streams = active_streams_.GetReadBuffer();
-
     bool has_more_data = false;
     bool all_flow_control_blocked = true;  // Track if ALL streams are flow control blocked
-
-    // Iterate through active streams
-    for (auto iter = streams.begin(); iter != streams.end();) {
-        auto stream = *iter;
-        if (!stream) {
-            iter = streams.erase(iter);
-            continue;
+    bool packet_full = false;
+    building_frames_ = true;
+
+    // CRYPTO frames are allowed at Initial/Handshake/Application (the
+    // CryptoStream keeps a buffer per level) and the handshake gates
+    // everything else, so the crypto stream always goes first.
+    if (active_crypto_stream_) {
+        auto crypto_stream = active_crypto_stream_;
+        auto ret = crypto_stream->TrySendData(visitor, (EncryptionLevel)encrypto_level);
+        if (ret == IStream::TrySendResult::kBreak) {
+            LOG_INFO("StreamManager: packet full, crypto stream will retry");
+            has_more_data = true;
+            packet_full = true;
+        } else {
+            active_crypto_stream_ = nullptr;
         }
+        all_flow_control_blocked = false;
+    }
 
-        uint64_t sid = stream->GetStreamID();
-        common::LogTagGuard guard("|strm:" + std::to_string(sid));
-
-        // Encryption level filtering (RFC 9000 §12.4 / §12.5):
-        //  - CRYPTO frames: allowed at Initial/Handshake/Application (handled by CryptoStream per-level buffer)
-        //  - STREAM frames: only allowed at 0-RTT (kEarlyData) or 1-RTT (kApplication)
-        // The CryptoStream uses stream_id == 0, BUT a client-initiated bidi stream can ALSO have id == 0
-        // (RFC 9000 §2.1: client-initiated bidi stream ids = 0, 4, 8, ...), so we MUST differentiate
-        // by actual object type, not by stream_id.
-        bool is_crypto_stream = (std::dynamic_pointer_cast<CryptoStream>(stream) != nullptr);
-        LOG_DEBUG("StreamManager loop: stream %llu, level %u, is_crypto=%d", sid, encrypto_level,
-            is_crypto_stream ? 1 : 0);
-        if (!is_crypto_stream && !(encrypto_level == kEarlyData || encrypto_level == kApplication)) {
-            // STREAM frames are not allowed at Initial/Handshake encryption levels.
-            // Keep the stream in the active list so it can be sent at a later level.
-            LOG_DEBUG("StreamManager: stream %llu deferred (encryption level %u)", sid, encrypto_level);
+    if (!packet_full && !scheduler_->IsEmpty()) {
+        if (!(encrypto_level == kEarlyData || encrypto_level == kApplication)) {
+            // STREAM frames are only allowed at 0-RTT (kEarlyData) or 1-RTT
+            // (kApplication) (RFC 9000 §12.4 / §12.5). Keep the streams
+            // queued so they can be sent at a later level.
+            LOG_DEBUG("StreamManager: %zu streams deferred (encryption level %u)", scheduler_->Size(), encrypto_level);
             has_more_data = true;
             all_flow_control_blocked = false;  // Deferred is not flow control blocked
-            ++iter;    // Move to next stream
-            continue;  // Skip this stream and continue with others
+        } else {
+            // Streams blocked by flow control go back to the queue after the
+            // pass, waiting for MAX_STREAM_DATA
+            std::vector<std::shared_ptr<IStream>> blocked_streams;
+            while (auto stream = scheduler_->Pop()) {
+                uint64_t sid = stream->GetStreamID();
+                common::LogTagGuard guard("|strm:" + std::to_string(sid));
+
+                LOG_DEBUG("StreamManager: building frames for stream %llu", sid);
+                auto ret = stream->TrySendData(visitor, (EncryptionLevel)encrypto_level);
+
+                if (ret == IStream::TrySendResult::kSuccess) {
+                    // Stream data sent successfully, leaves the queue
+                    LOG_DEBUG("StreamManager: stream %llu send complete", sid);
+                    all_flow_control_blocked = false;
+
+                } else if (ret == IStream::TrySendResult::kFailed) {
+                    // Stream send failed (permanent error), leaves the queue
+                    LOG_WARN("StreamManager: stream %llu send failed, removing", sid);
+                    all_flow_control_blocked = false;
+
+                } else if (ret == IStream::TrySendResult::kFlowControlBlocked) {
+                    // Note: STREAM_DATA_BLOCKED frame was already sent by TrySendData
+                    LOG_DEBUG("StreamManager: stream %llu flow control blocked, keeping in active list", sid);
+                    blocked_streams.push_back(stream);
+                    has_more_data = true;
+
+                } else if (ret == IStream::TrySendResult::kBreak) {
+                    // Packet full, but stream has more data: the scheduler
+                    // decides whether it keeps the next packet
+                    LOG_INFO("StreamManager: packet full, stream %llu will retry", sid);
+                    scheduler_->Requeue(stream);
+                    has_more_data = true;
+                    all_flow_control_blocked = false;  // Break means we can send more
+                    break;
+                }
+            }
+            for (auto& stream : blocked_streams) {
+                scheduler_->Push(stream);
+            }
         }
+    }
 
-        // Try to send stream data
-        LOG_DEBUG("StreamManager: building frames for stream %llu", sid);
-        auto ret = stream->TrySendData(visitor, (EncryptionLevel)encrypto_level);
-
-        if (ret == IStream::TrySendResult::kSuccess) {
-            // Stream data sent successfully, remove from active list
-            LOG_DEBUG("StreamManager: stream %llu send complete", sid);
-            iter = streams.erase(iter);
-            all_flow_control_blocked = false;  // Successfully sent data
-
-        } else if (ret == IStream::TrySendResult::kFailed) {
-            // Stream send failed (permanent error), remove from active list
-            LOG_WARN("StreamManager: stream %llu send failed, removing", sid);
-            iter = streams.erase(iter);
-            all_flow_control_blocked = false;  // Failed is not flow control blocked
-
-        } else if (ret == IStream::TrySendResult::kFlowControlBlocked) {
-            // Flow control blocked, keep in active list waiting for MAX_STREAM_DATA
-            // Note: STREAM_DATA_BLOCKED frame was already sent by TrySendData
-            LOG_DEBUG("StreamManager: stream %llu flow control blocked, keeping in active list", sid);
-            has_more_data = true;
-            // Don't set all_flow_control_blocked = false, this stream IS flow control blocked
-            ++iter;  // Move to next stream, don't remove
-
-        } else if (ret == IStream::TrySendResult::kBreak) {
-            // Packet full, but stream has more data
-            // Keep in active list for next packet
-            LOG_INFO("StreamManager: packet full, stream %llu will retry", sid);
-            has_more_data = true;
-            all_flow_control_blocked = false;  // Break means we can send more
-            break;
+    // Streams cut short by the connection's high watermark go on once the
+    // connection drained; writes they make are held back like any other
+    if (send_buffer_watermark_->TakeBlockedIfDrained()) {
+        for (auto& entry : streams_map_) {
+            auto send_stream = std::dynamic_pointer_cast<SendStream>(entry.second);
+            if (send_stream) {
+                send_stream->CheckWritable();
+            }
         }
     }
 
+    building_frames_ = false;
+    std::vector<std::shared_ptr<IStream>> marked;
+    marked.swap(marked_while_building_);
+    for (auto& stream : marked) {
+        MarkStreamActive(stream);
+    }
+
     // If ALL streams are flow control blocked, return false to stop the send loop
     // This prevents infinite sending of STREAM_DATA_BLOCKED frames
     // The streams remain in active list and will be retried when MAX_STREAM_DATA arrives
@@ -465,42 +577,28 @@ bool StreamManager::BuildStreamFrames(IFrameVisitor* visitor, uint8_t encrypto_l
 
 void StreamManager::ClearActiveStreams() {
     LOG_DEBUG("StreamManager: clearing all active streams");
-    active_streams_.Clear();
+    active_crypto_stream_ = nullptr;
+    scheduler_->Clear();
+    marked_while_building_.clear();
 }
 
 bool StreamManager::HasActiveStreamsForLevel(uint8_t level) const {
-    if (active_streams_.IsEmpty()) {
-        return false;
-    }
-
     // For Application and EarlyData levels, any active stream qualifies
     if (level == kApplication || level == kEarlyData) {
-        return true;
+        return HasActiveStreams();
     }
 
     // For Initial/Handshake levels, only the CryptoStream can produce frames
     // (CRYPTO frames). Application streams cannot send STREAM frames at these
     // levels per RFC 9000 §12.4 / §12.5.
-    // NOTE: CryptoStream uses stream_id == 0, but a client-initiated bidi
-    // stream can ALSO have id == 0 (RFC 9000 §2.1: client bidi ids = 0,4,8,...).
-    // So we MUST differentiate by actual object type via dynamic_pointer_cast,
-    // NOT by stream_id value — otherwise a legit bidi stream 0 would cause us
-    // to wrongly schedule STREAM frames at Initial/Handshake level.
-    // Check both buffers since crypto stream may be in either one depending
-    // on timing relative to Swap().
-    const auto& read_buf = active_streams_.GetReadBuffer();
-    for (const auto& stream : read_buf) {
-        if (stream && std::dynamic_pointer_cast<CryptoStream>(stream) != nullptr) {
-            return true;
-        }
+    if (active_crypto_stream_) {
+        return true;
     }
-    const auto& write_buf = active_streams_.GetWriteBuffer();
-    for (const auto& stream : write_buf) {
-        if (stream && std::dynamic_pointer_cast<CryptoStream>(stream) != nullptr) {
+    for (const auto& stream : marked_while_building_) {
+        if (std::dynamic_pointer_cast<CryptoStream>(stream) != nullptr) {
             return true;
         }
     }
-
     return false;
 }
 
@@ -7,9 +7,11 @@
 #include <mutex>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
-#include "common/structure/double_buffer.h"
 #include <quicx/quic/type.h>
+#include "quic/stream/scheduler/if_stream_scheduler.h"
+#include "quic/stream/send_buffer_watermark.h"
 
 namespace quicx {
 
@@ -126,6 +128,19 @@ public:
      */
     void OnStreamDataAcked(uint64_t stream_id, uint64_t offset_start, uint64_t length, bool has_fin);
 
+    /**
+     * @brief Notify stream that data was declared lost
+     *
+     * Ranges of streams that no longer exist are dropped; the stream itself
+     * skips parts already ACKed and does nothing once it has been reset.
+     *
+     * @param stream_id Stream ID
+     * @param offset_start Start offset of the lost range (inclusive)
+     * @param length Length of the lost range (bytes)
+     * @param has_fin Whether the lost packet carried the FIN bit for this stream
+     */
+    void OnStreamDataLost(uint64_t stream_id, uint64_t offset_start, uint64_t length, bool has_fin);
+
     // ==================== Stream Reset ====================
 
     /**
@@ -140,13 +155,42 @@ public:
      */
     std::vector<uint64_t> GetAllStreamIDs() const;
 
+    /**
+     * @brief Number of streams currently open
+     */
+    size_t GetStreamCount() const { return streams_map_.size(); }
+
+    /**
+     * @brief Number of streams opened so far, by either side
+     */
+    uint64_t GetOpenedStreamCount() const { return opened_streams_; }
+
     // ==================== Stream Scheduling (Week 4 Refactoring) ====================
 
+    /**
+     * @brief Select how active streams share packets
+     *
+     * Streams already waiting to send move to the new scheduler.
+     *
+     * @param type Scheduling policy
+     */
+    void SetStreamScheduler(StreamSchedulerType type);
+
+    /**
+     * @brief Bound what IQuicSendStream::Send() buffers
+     *
+     * The stream marks apply to streams created afterwards; the connection
+     * marks cover the send buffers of all streams together. A high mark of 0
+     * means no limit.
+     */
+    void SetSendBufferWatermarks(uint32_t stream_high, uint32_t stream_low, uint32_t conn_high, uint32_t conn_low);
+
     /**
      * @brief Mark stream as active for sending
      *
-     * Adds stream to the active streams queue for scheduling. Uses double-buffer
-     * mechanism to avoid concurrency issues during packet building.
+     * Queues the stream on the stream scheduler. Streams marked while
+     * BuildStreamFrames() is running are held back until it returns, so a
+     * stream re-arming itself cannot be served twice in one pass.
      *
      * @param stream Stream to mark as active
      */
@@ -155,8 +199,9 @@ public:
     /**
      * @brief Build STREAM frames for active streams
      *
-     * Iterates through active streams and builds STREAM frames for packet.
-     * Handles encryption level filtering and flow control limits.
+     * Serves the crypto stream first, then application streams in the order
+     * the stream scheduler picks them. Handles encryption level filtering
+     * and flow control limits.
      *
      * @param visitor Frame visitor to receive STREAM frames
      * @param encrypto_level Current encryption level
@@ -174,7 +219,7 @@ public:
      * @return true if active streams exist, false otherwise
      */
     bool HasActiveStreams() const {
-        return !active_streams_.IsEmpty();
+        return active_crypto_stream_ || !scheduler_->IsEmpty() || !marked_while_building_.empty();
     }
 
     /**
@@ -194,11 +239,22 @@ public:
     void SetQlogTrace(std::shared_ptr<::quicx::common::QlogTrace> trace) { qlog_trace_ = trace; }
 
 private:
+    // The send budget provider and the receive callbacks point back here; a
+    // stream the application still holds must not call them once it left
+    // the map. Its buffered bytes stop counting against the connection's
+    // watermarks too.
+    void DetachStream(const std::shared_ptr<IStream>& stream);
+
     // Stream map
     std::unordered_map<uint64_t, std::shared_ptr<IStream>> streams_map_;
+    uint64_t opened_streams_ = 0;
 
-    // Active streams (Week 4 refactoring) - uses double-buffer for concurrency safety
-    common::DoubleBuffer<std::shared_ptr<IStream>> active_streams_;
+    // Active streams: the crypto stream is kept aside and always served
+    // first, application streams wait in the scheduler's ready queue.
+    std::shared_ptr<IStream> active_crypto_stream_;
+    std::unique_ptr<IStreamScheduler> scheduler_;
+    bool building_frames_;
+    std::vector<std::shared_ptr<IStream>> marked_while_building_;
 
     // Pending stream creation requests
     struct PendingStreamRequest {
@@ -219,6 +275,12 @@ private:
 
     // Qlog trace for stream state change tracking
     std::shared_ptr<::quicx::common::QlogTrace> qlog_trace_;
+
+    // Send buffer watermarks: shared by all streams, and the per-stream
+    // default for new streams
+    std::shared_ptr<SendBufferWatermark> send_buffer_watermark_;
+    uint32_t stream_send_buffer_high_;
+    uint32_t stream_send_buffer_low_;
 };
 
 }  // namespace quic
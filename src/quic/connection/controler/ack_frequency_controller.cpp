@@ -0,0 +1,68 @@
+#include <algorithm>
+
+#include "common/log/log.h"
+
+#include "quic/config.h"
+#include "quic/connection/controler/ack_frequency_controller.h"
+#include "quic/connection/transport_param.h"
+#include "quic/frame/ack_frequency_frame.h"
+
+namespace quicx {
+namespace quic {
+
+void AckFrequencyController::UpdateConfig(const TransportParam& tp) {
+    peer_min_ack_delay_us_ = tp.GetMinAckDelay();
+    peer_max_ack_delay_us_ = tp.GetMaxAckDelay() * 1000;
+}
+
+std::shared_ptr<AckFrequencyFrame> AckFrequencyController::MayGenerateFrame(
+    uint64_t now, uint64_t cwnd_bytes, uint32_t smoothed_rtt_ms, uint32_t mtu) {
+    if (!IsEnabled() || mtu == 0) {
+        return nullptr;
+    }
+
+    uint64_t cwnd_packets = cwnd_bytes / mtu;
+    if (requested_threshold_ == 0 && cwnd_packets < kAckFrequencyMinCwndPackets) {
+        // Nothing requested yet and the window is still small: leave the
+        // peer on its default ACK policy.
+        return nullptr;
+    }
+
+    // Threshold 1 is RFC 9000's "ACK every second packet", used once the
+    // window has shrunk back below the minimum.
+    uint64_t threshold = 1;
+    if (cwnd_packets >= kAckFrequencyMinCwndPackets) {
+        threshold = std::min(cwnd_packets / kAckFrequencyAcksPerCwnd, kMaxAckElicitingThreshold);
+    }
+    if (threshold < requested_threshold_ * 2 && threshold * 2 > requested_threshold_) {
+        return nullptr;
+    }
+    if (last_frame_time_ != 0 && now < last_frame_time_ + smoothed_rtt_ms) {
+        return nullptr;
+    }
+
+    // Ask for an ACK at least every quarter RTT, bounded below by what the
+    // peer can do and above by the max_ack_delay it advertised: our PTO
+    // already budgets for that one, so it stays valid whatever the peer
+    // does with this frame.
+    uint64_t max_ack_delay_us = static_cast<uint64_t>(smoothed_rtt_ms) * 1000 / 4;
+    max_ack_delay_us = std::max(max_ack_delay_us, peer_min_ack_delay_us_);
+    if (peer_max_ack_delay_us_ > 0) {
+        max_ack_delay_us = std::min(max_ack_delay_us, std::max(peer_max_ack_delay_us_, peer_min_ack_delay_us_));
+    }
+
+    auto frame = std::make_shared<AckFrequencyFrame>();
+    frame->SetSequenceNumber(next_sequence_number_++);
+    frame->SetAckElicitingThreshold(threshold);
+    frame->SetRequestMaxAckDelay(max_ack_delay_us);
+    frame->SetReorderingThreshold(kAckFrequencyReorderingThreshold);
+
+    LOG_DEBUG("AckFrequencyController: request threshold=%llu (was %llu), max_ack_delay=%lluus, cwnd=%llu packets",
+        threshold, requested_threshold_, max_ack_delay_us, cwnd_packets);
+    requested_threshold_ = threshold;
+    last_frame_time_ = now;
+    return frame;
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,53 @@
+#ifndef QUIC_CONNECTION_CONTROLER_ACK_FREQUENCY_CONTROLLER
+#define QUIC_CONNECTION_CONTROLER_ACK_FREQUENCY_CONTROLLER
+
+#include <cstdint>
+#include <memory>
+
+namespace quicx {
+namespace quic {
+
+class TransportParam;
+class AckFrequencyFrame;
+
+// AckFrequencyController is the sender half of draft-ietf-quic-ack-frequency.
+// It watches the congestion window and, once the window is large, asks the
+// peer to acknowledge less often by sending ACK_FREQUENCY frames. Every ACK
+// the peer does not send is one fewer packet for it to build and one fewer
+// ACK frame for SendControl to process.
+//
+// A new frame is only generated when the wanted threshold moved by at least
+// a factor of two since the last one, and at most once per smoothed RTT, so
+// a window that wobbles around a boundary does not turn into a stream of
+// ACK_FREQUENCY frames.
+class AckFrequencyController {
+public:
+    AckFrequencyController() = default;
+    ~AckFrequencyController() = default;
+
+    // Take the peer's min_ack_delay / max_ack_delay. The extension stays off
+    // unless the peer advertised min_ack_delay.
+    void UpdateConfig(const TransportParam& tp);
+
+    bool IsEnabled() const { return peer_min_ack_delay_us_ > 0; }
+
+    // Returns the ACK_FREQUENCY frame to send for the current window, or
+    // nullptr if the last request still fits.
+    std::shared_ptr<AckFrequencyFrame> MayGenerateFrame(
+        uint64_t now, uint64_t cwnd_bytes, uint32_t smoothed_rtt_ms, uint32_t mtu);
+
+    // Ack-eliciting threshold of the last frame generated, 0 if none.
+    uint64_t GetRequestedThreshold() const { return requested_threshold_; }
+
+private:
+    uint64_t peer_min_ack_delay_us_{0};
+    uint64_t peer_max_ack_delay_us_{0};
+    uint64_t next_sequence_number_{0};
+    uint64_t requested_threshold_{0};
+    uint64_t last_frame_time_{0};
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -0,0 +1,126 @@
+#include <cstring>
+
+#include "quic/connection/controler/ack_range_set.h"
+
+namespace quicx {
+namespace quic {
+
+bool AckRangeSet::Add(uint64_t packet_number) {
+    if (packet_number < floor_) {
+        return false;
+    }
+    if (count_ == 0) {
+        InsertAt(0, packet_number);
+        return true;
+    }
+
+    // Fast path: in-order arrival extends the newest range.
+    PacketNumberRange& newest = ranges_[0];
+    if (packet_number == newest.high + 1) {
+        newest.high = packet_number;
+        return true;
+    }
+    if (packet_number > newest.high) {
+        InsertAt(0, packet_number);
+        return true;
+    }
+
+    // Out-of-order arrival: reordering is usually shallow, so a linear scan
+    // from the newest range finds the slot within a step or two.
+    for (size_t i = 0; i < count_; ++i) {
+        PacketNumberRange& range = ranges_[i];
+        if (packet_number > range.high) {
+            // Falls in the gap between ranges_[i - 1] and ranges_[i] (i >= 1
+            // here, the i == 0 case was handled above).
+            PacketNumberRange& upper = ranges_[i - 1];
+            bool joins_upper = packet_number + 1 == upper.low;
+            bool joins_lower = packet_number == range.high + 1;
+            if (joins_upper && joins_lower) {
+                upper.low = range.low;
+                EraseAt(i);
+            } else if (joins_upper) {
+                upper.low = packet_number;
+            } else if (joins_lower) {
+                range.high = packet_number;
+            } else {
+                InsertAt(i, packet_number);
+            }
+            return true;
+        }
+        if (packet_number >= range.low) {
+            return false;  // duplicate
+        }
+    }
+
+    // Below every range we hold.
+    PacketNumberRange& oldest = ranges_[count_ - 1];
+    if (packet_number + 1 == oldest.low) {
+        oldest.low = packet_number;
+        return true;
+    }
+    if (count_ == kMaxAckRanges) {
+        return false;
+    }
+    InsertAt(count_, packet_number);
+    return true;
+}
+
+bool AckRangeSet::RemoveUpTo(uint64_t packet_number) {
+    if (packet_number + 1 > floor_) {
+        floor_ = packet_number + 1;
+    }
+    bool changed = false;
+    while (count_ > 0) {
+        PacketNumberRange& oldest = ranges_[count_ - 1];
+        if (oldest.low >= floor_) {
+            break;
+        }
+        changed = true;
+        if (oldest.high >= floor_) {
+            oldest.low = floor_;
+            break;
+        }
+        --count_;
+    }
+    return changed;
+}
+
+bool AckRangeSet::Contains(uint64_t packet_number) const {
+    for (size_t i = 0; i < count_; ++i) {
+        if (packet_number > ranges_[i].high) {
+            return false;
+        }
+        if (packet_number >= ranges_[i].low) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AckRangeSet::Clear() {
+    count_ = 0;
+    floor_ = 0;
+}
+
+void AckRangeSet::InsertAt(size_t index, uint64_t packet_number) {
+    if (count_ == kMaxAckRanges) {
+        // History full: forget the oldest range to make room.
+        --count_;
+    }
+    if (index < count_) {
+        memmove(&ranges_[index + 1], &ranges_[index], (count_ - index) * sizeof(PacketNumberRange));
+    }
+    ranges_[index].low = packet_number;
+    ranges_[index].high = packet_number;
+    ++count_;
+}
+
+void AckRangeSet::EraseAt(size_t index) {
+    if (index + 1 < count_) {
+        memmove(&ranges_[index], &ranges_[index + 1], (count_ - index - 1) * sizeof(PacketNumberRange));
+    }
+    --count_;
+}
+
+}  // namespace quic
+}  // namespace quicx
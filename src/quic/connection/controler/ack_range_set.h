@@ -0,0 +1,75 @@
+#ifndef QUIC_CONNECTION_CONTROLER_ACK_RANGE_SET
+#define QUIC_CONNECTION_CONTROLER_ACK_RANGE_SET
+
+#include <cstddef>
+#include <cstdint>
+
+#include "quic/config.h"
+
+namespace quicx {
+namespace quic {
+
+// Inclusive packet-number interval [low, high].
+struct PacketNumberRange {
+    uint64_t low = 0;
+    uint64_t high = 0;
+};
+
+/**
+ * @brief Received packet numbers kept as a bounded set of disjoint ranges.
+ *
+ * Ranges live in a fixed inline array ordered from the highest packet number
+ * down, which is exactly the order an ACK frame encodes them in, so building
+ * a frame is a straight copy. In-order arrival only extends ranges_[0] and
+ * costs O(1) without touching the heap; a new gap shifts the array by one.
+ *
+ * The history is bounded by kMaxAckRanges. When a new range does not fit,
+ * the oldest (lowest) range is forgotten: the peer has either seen it in an
+ * earlier ACK or has long since declared those packets lost.
+ *
+ * RFC 9000 §13.2.4: once a packet carrying one of our ACK frames is itself
+ * acknowledged, everything at or below that frame's Largest Acknowledged can
+ * be dropped (RemoveUpTo()); packets that old are not re-added afterwards.
+ */
+class AckRangeSet {
+public:
+    AckRangeSet() = default;
+    ~AckRangeSet() = default;
+
+    // Record a received packet number. Returns false if it was already
+    // covered, is below the RemoveUpTo() floor, or is older than every range
+    // while the history is full.
+    bool Add(uint64_t packet_number);
+
+    // Forget every packet number <= `packet_number`. Returns true if the set
+    // changed.
+    bool RemoveUpTo(uint64_t packet_number);
+
+    bool Contains(uint64_t packet_number) const;
+
+    void Clear();
+
+    bool Empty() const { return count_ == 0; }
+    // Number of disjoint ranges.
+    size_t Size() const { return count_; }
+    // Ranges ordered by descending packet number; index 0 holds the largest.
+    const PacketNumberRange& operator[](size_t index) const { return ranges_[index]; }
+    // Only meaningful when !Empty().
+    uint64_t Largest() const { return ranges_[0].high; }
+    // Packet numbers below this were dropped by RemoveUpTo().
+    uint64_t Floor() const { return floor_; }
+
+private:
+    void InsertAt(size_t index, uint64_t packet_number);
+    void EraseAt(size_t index);
+
+    PacketNumberRange ranges_[kMaxAckRanges];
+    size_t count_ = 0;
+    // Packet numbers below this have been acknowledged by an ACK-of-ACK.
+    uint64_t floor_ = 0;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -0,0 +1,90 @@
+#include "common/log/log.h"
+
+#include "quic/config.h"
+#include "quic/connection/controler/datagram_queue.h"
+#include "quic/frame/datagram_frame.h"
+#include "quic/stream/if_frame_visitor.h"
+
+namespace quicx {
+namespace quic {
+
+uint32_t DatagramQueue::GetMaxPayloadSize() const {
+    if (peer_max_frame_size_ == 0) {
+        return 0;
+    }
+    // The frame limit covers type and Length field too. Shrink the payload
+    // until its own Length field fits as well.
+    uint64_t limit = peer_max_frame_size_ > UINT32_MAX ? UINT32_MAX : peer_max_frame_size_;
+    uint32_t payload = static_cast<uint32_t>(limit);
+    while (payload > 0 && payload + DatagramFrame::GetOverhead(payload) > limit) {
+        payload--;
+    }
+    return payload;
+}
+
+bool DatagramQueue::Push(uint64_t id, const common::SharedBufferSpan& data, uint64_t expire_time) {
+    if (data.GetLength() > GetMaxPayloadSize()) {
+        LOG_WARN("datagram rejected: %u bytes, peer max frame size %llu", data.GetLength(), peer_max_frame_size_);
+        return false;
+    }
+    if (queue_.size() >= kMaxDatagramQueueSize) {
+        LOG_WARN("datagram rejected: send queue full");
+        return false;
+    }
+    queue_.push_back(Entry{id, data, expire_time});
+    return true;
+}
+
+uint32_t DatagramQueue::BuildFrames(IFrameVisitor* visitor, uint64_t now, uint32_t max_payload) {
+    uint32_t built = 0;
+    while (!queue_.empty()) {
+        Entry& entry = queue_.front();
+        if (entry.expire_time != 0 && now >= entry.expire_time) {
+            uint64_t id = entry.id;
+            queue_.pop_front();
+            Report(id, DatagramStatus::kExpired);
+            continue;
+        }
+
+        uint32_t frame_size = entry.data.GetLength() + DatagramFrame::GetOverhead(entry.data.GetLength());
+        if (frame_size > max_payload) {
+            // Even an empty packet cannot carry it (the PLPMTU shrank after
+            // it was queued): it would block the queue forever.
+            uint64_t id = entry.id;
+            queue_.pop_front();
+            LOG_WARN("datagram %llu dropped: frame size %u exceeds packet budget %u", id, frame_size, max_payload);
+            Report(id, DatagramStatus::kDropped);
+            continue;
+        }
+        if (frame_size > visitor->GetPacketLeftSize()) {
+            break;
+        }
+
+        auto frame = std::make_shared<DatagramFrame>();
+        frame->SetData(entry.data);
+        frame->SetDatagramId(entry.id);
+        if (!visitor->HandleFrame(frame)) {
+            break;
+        }
+        queue_.pop_front();
+        built++;
+    }
+    return built;
+}
+
+void DatagramQueue::Clear() {
+    std::deque<Entry> queue;
+    queue.swap(queue_);
+    for (auto& entry : queue) {
+        Report(entry.id, DatagramStatus::kDropped);
+    }
+}
+
+void DatagramQueue::Report(uint64_t id, DatagramStatus status) {
+    if (status_cb_) {
+        status_cb_(id, status);
+    }
+}
+
+}  // namespace quic
+}  // namespace quicx
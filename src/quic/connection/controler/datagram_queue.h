@@ -0,0 +1,81 @@
+#ifndef QUIC_CONNECTION_CONTROLER_DATAGRAM_QUEUE
+#define QUIC_CONNECTION_CONTROLER_DATAGRAM_QUEUE
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+#include <quicx/quic/type.h>
+#include "common/buffer/shared_buffer_span.h"
+
+namespace quicx {
+namespace quic {
+
+class IFrameVisitor;
+
+// DatagramQueue holds the application's unreliable datagrams (RFC 9221)
+// until the congestion window lets them out. Datagrams are packed into 1-RTT
+// packets ahead of stream data, so a real-time flow sharing the connection
+// with a bulk transfer is not stuck behind it.
+//
+// Every datagram pushed is reported exactly once through the status
+// callback: acked or lost (from loss detection, via the id its frame
+// carries), expired (its TTL passed while queued) or dropped (too large for
+// the path, or the connection went away). Nothing is ever retransmitted.
+class DatagramQueue {
+public:
+    using StatusCallback = std::function<void(uint64_t id, DatagramStatus status)>;
+
+    DatagramQueue() = default;
+    ~DatagramQueue() = default;
+
+    void SetStatusCallback(StatusCallback cb) { status_cb_ = std::move(cb); }
+
+    // The peer's max_datagram_frame_size, 0 when it does not accept
+    // DATAGRAM frames (in which case Push() rejects everything).
+    void SetPeerMaxFrameSize(uint64_t size) { peer_max_frame_size_ = size; }
+    uint64_t GetPeerMaxFrameSize() const { return peer_max_frame_size_; }
+
+    // Largest payload the peer accepts in a single frame, 0 if none.
+    uint32_t GetMaxPayloadSize() const;
+
+    // Queue `data` under `id`. `expire_time` (ms, 0 = never) is when it is
+    // no longer worth sending. Returns false, without reporting a status, if
+    // the peer does not accept a frame this size or the queue is full.
+    bool Push(uint64_t id, const common::SharedBufferSpan& data, uint64_t expire_time);
+
+    bool Empty() const { return queue_.empty(); }
+    size_t Size() const { return queue_.size(); }
+
+    // Encode queued datagrams into `visitor` in order, at most `max_payload`
+    // bytes of frame each (the packet's budget). Stops at the first one
+    // that does not fit in what is left of the packet; one that could never
+    // fit max_payload is dropped instead of blocking the queue. Returns the
+    // number of frames written.
+    uint32_t BuildFrames(IFrameVisitor* visitor, uint64_t now, uint32_t max_payload);
+
+    // Outcome of a sent datagram, from loss detection.
+    void OnAcked(uint64_t id) { Report(id, DatagramStatus::kAcked); }
+    void OnLost(uint64_t id) { Report(id, DatagramStatus::kLost); }
+
+    // Discard everything still queued, reporting each as dropped.
+    void Clear();
+
+private:
+    void Report(uint64_t id, DatagramStatus status);
+
+private:
+    struct Entry {
+        uint64_t id;
+        common::SharedBufferSpan data;
+        uint64_t expire_time;
+    };
+    std::deque<Entry> queue_;
+    uint64_t peer_max_frame_size_{0};
+    StatusCallback status_cb_;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -0,0 +1,62 @@
+#include "quic/connection/controler/path_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+static bool CanCarry(const PathCandidate& path, uint32_t packet_size) {
+    return path.usable && path.send_window >= packet_size;
+}
+
+uint64_t MinRttPathScheduler::SelectPath(const std::vector<PathCandidate>& paths, uint32_t packet_size) {
+    const PathCandidate* best = nullptr;
+    for (const auto& path : paths) {
+        if (!CanCarry(path, packet_size)) {
+            continue;
+        }
+        // ties go to the lower path id, so path 0 stays the default
+        if (!best || path.srtt < best->srtt || (path.srtt == best->srtt && path.path_id < best->path_id)) {
+            best = &path;
+        }
+    }
+    return best ? best->path_id : kInvalidPathId;
+}
+
+uint64_t RoundRobinPathScheduler::SelectPath(const std::vector<PathCandidate>& paths, uint32_t packet_size) {
+    // Ids are compared rather than positions: a path added or abandoned
+    // between two calls must not make the turn skip or repeat a path.
+    const PathCandidate* next = nullptr;
+    const PathCandidate* first = nullptr;
+    for (const auto& path : paths) {
+        if (!CanCarry(path, packet_size)) {
+            continue;
+        }
+        if (!first || path.path_id < first->path_id) {
+            first = &path;
+        }
+        if ((last_path_id_ == kInvalidPathId || path.path_id > last_path_id_) &&
+            (!next || path.path_id < next->path_id)) {
+            next = &path;
+        }
+    }
+    if (!next) {
+        next = first;
+    }
+    if (!next) {
+        return kInvalidPathId;
+    }
+    last_path_id_ = next->path_id;
+    return next->path_id;
+}
+
+std::unique_ptr<IPathScheduler> MakePathScheduler(PathSchedulerType type) {
+    switch (type) {
+        case PathSchedulerType::kRoundRobin:
+            return std::unique_ptr<IPathScheduler>(new RoundRobinPathScheduler());
+        case PathSchedulerType::kMinRtt:
+        default:
+            return std::unique_ptr<IPathScheduler>(new MinRttPathScheduler());
+    }
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,64 @@
+#ifndef QUIC_CONNECTION_CONTROLER_PATH_SCHEDULER
+#define QUIC_CONNECTION_CONTROLER_PATH_SCHEDULER
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <quicx/quic/type.h>
+
+namespace quicx {
+namespace quic {
+
+static constexpr uint64_t kInvalidPathId = UINT64_MAX;
+
+// What the scheduler knows about one path when a packet is to be sent.
+struct PathCandidate {
+    uint64_t path_id;
+    uint32_t srtt;          // ms
+    uint64_t send_window;   // bytes its congestion controller lets out now
+    bool usable;            // validated and not abandoned
+};
+
+/**
+ * @brief Chooses the path of the next 1-RTT packet (draft-ietf-quic-multipath)
+ *
+ * Each path has its own packet number space, loss detection, RTT estimate
+ * and congestion controller (see SendManager::AddPath()); the scheduler only
+ * decides which of them gets the next packet. A path qualifies when it is
+ * usable and its window has room for the packet.
+ */
+class IPathScheduler {
+public:
+    IPathScheduler() {}
+    virtual ~IPathScheduler() {}
+
+    // Path id for a packet of `packet_size` bytes, kInvalidPathId when every
+    // path is blocked by its congestion window.
+    virtual uint64_t SelectPath(const std::vector<PathCandidate>& paths, uint32_t packet_size) = 0;
+
+    virtual PathSchedulerType GetType() const = 0;
+};
+
+class MinRttPathScheduler: public IPathScheduler {
+public:
+    uint64_t SelectPath(const std::vector<PathCandidate>& paths, uint32_t packet_size) override;
+    PathSchedulerType GetType() const override { return PathSchedulerType::kMinRtt; }
+};
+
+class RoundRobinPathScheduler: public IPathScheduler {
+public:
+    uint64_t SelectPath(const std::vector<PathCandidate>& paths, uint32_t packet_size) override;
+    PathSchedulerType GetType() const override { return PathSchedulerType::kRoundRobin; }
+
+private:
+    // path id served last; the next turn goes to the first id above it
+    uint64_t last_path_id_{kInvalidPathId};
+};
+
+std::unique_ptr<IPathScheduler> MakePathScheduler(PathSchedulerType type);
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -3,85 +3,217 @@
 #include "common/log/log.h"
 #include "quic/common/constants.h"
 #include "quic/connection/controler/pmtu_prober.h"
-#include "quic/frame/ack_frame.h"
-#include "quic/frame/type.h"
 
 namespace quicx {
 namespace quic {
 
-PmtuProber::PmtuProber()
-    : probe_inflight_(false),
-      mtu_limit_bytes_(1450),
-      probe_target_bytes_(1450),
-      probe_packet_number_(0) {
+PmtuProber::PmtuProber(std::shared_ptr<common::ITimer> timer):
+    state_(State::kBase),
+    plpmtu_(kDefaultPlpmtu),
+    max_plpmtu_(kMaxPlpmtu),
+    search_low_(kDefaultPlpmtu),
+    search_high_(kMaxPlpmtu),
+    probe_inflight_(false),
+    probe_is_validation_(false),
+    probe_target_bytes_(kDefaultPlpmtu),
+    probe_packet_number_(0),
+    probe_count_(0),
+    validating_(false),
+    large_loss_count_(0),
+    largest_acked_large_(0),
+    timer_(timer) {
+    raise_timer_.SetTimeoutCallback([this]() { OnRaiseTimer(); });
 }
 
-void PmtuProber::StartProbe() {
-    if (mtu_limit_bytes_ < 1450) {
-        probe_target_bytes_ = 1450;
-    } else {
-        probe_target_bytes_ = static_cast<uint16_t>(std::min<int>(mtu_limit_bytes_ + 50, 1500));
+PmtuProber::~PmtuProber() {
+    if (timer_) {
+        timer_->DisarmTimer(raise_timer_);
     }
-    probe_inflight_ = true;
 }
 
-void PmtuProber::OnProbeResult(bool success) {
-    if (!probe_inflight_) return;
-    if (success) {
-        mtu_limit_bytes_ = probe_target_bytes_;
+void PmtuProber::SetPeerMaxUdpPayloadSize(uint64_t size) {
+    if (size == 0) {
+        size = 65527;  // RFC 9000 §18.2 default
     }
-    probe_inflight_ = false;
+    // RFC 9000 §18.2: values below 1200 are invalid; the handshake rejects them
+    max_plpmtu_ = static_cast<uint16_t>(
+        std::max<uint64_t>(kMinInitialPacketSize, std::min<uint64_t>(size, kMaxPlpmtu)));
+    plpmtu_ = std::min(plpmtu_, max_plpmtu_);
+    search_low_ = std::min(search_low_, max_plpmtu_);
+    search_high_ = std::min(search_high_, max_plpmtu_);
+}
+
+void PmtuProber::StartProbe() {
+    if (timer_) {
+        timer_->DisarmTimer(raise_timer_);
+    }
+    search_low_ = plpmtu_;
+    search_high_ = max_plpmtu_;
+    if (search_high_ < search_low_ + kSearchGranularity) {
+        CompleteSearch();
+        return;
+    }
+    state_ = State::kSearching;
+    NextProbe();
 }
 
 void PmtuProber::ResetForNewPath() {
+    if (timer_) {
+        timer_->DisarmTimer(raise_timer_);
+    }
+    state_ = State::kBase;
+    plpmtu_ = kMinInitialPacketSize;  // RFC 9000 §14.1: 1200-byte floor
+    search_low_ = plpmtu_;
+    search_high_ = max_plpmtu_;
     probe_inflight_ = false;
+    probe_is_validation_ = false;
     probe_packet_number_ = 0;
-    mtu_limit_bytes_ = kMinInitialPacketSize;  // RFC 9000 §14.1: 1200-byte floor
+    probe_count_ = 0;
+    validating_ = false;
+    large_loss_count_ = 0;
 }
 
-bool PmtuProber::CheckAckCoversProbe(std::shared_ptr<IFrame> frame) {
-    if (!probe_inflight_ || probe_packet_number_ == 0) {
-        return false;
+uint16_t PmtuProber::GetProbeSize() const {
+    if (probe_inflight_) {
+        return 0;
     }
-    if (frame->GetType() != FrameType::kAck && frame->GetType() != FrameType::kAckEcn) {
-        return false;
+    if (validating_) {
+        return plpmtu_;
     }
+    return state_ == State::kSearching ? probe_target_bytes_ : 0;
+}
 
-    auto ack = std::dynamic_pointer_cast<AckFrame>(frame);
-    if (!ack) {
-        return false;
+void PmtuProber::OnProbeSent(uint64_t packet_number, uint32_t size) {
+    probe_inflight_ = true;
+    probe_is_validation_ = validating_;
+    probe_packet_number_ = packet_number;
+    LOG_DEBUG("PmtuProber: probe sent pn=%llu size=%u target=%u plpmtu=%u", packet_number, size,
+        probe_is_validation_ ? plpmtu_ : probe_target_bytes_, plpmtu_);
+}
+
+void PmtuProber::OnPacketAcked(uint64_t packet_number, uint32_t size, bool mtu_probe) {
+    if (size > kMinInitialPacketSize && packet_number > largest_acked_large_) {
+        largest_acked_large_ = packet_number;
+        large_loss_count_ = 0;
+    }
+    // the path carries the current PLPMTU after all
+    if (validating_ && size >= plpmtu_) {
+        validating_ = false;
+        probe_count_ = 0;
+    }
+    if (!mtu_probe) {
+        return;
     }
 
-    uint64_t largest = ack->GetLargestAck();
-    uint64_t probe = probe_packet_number_;
-    if (probe > largest) {
-        return false;
+    bool current = probe_inflight_ && packet_number == probe_packet_number_;
+    if (current) {
+        probe_inflight_ = false;
+        if (probe_is_validation_) {
+            return;
+        }
+    }
+    // a late ACK of an earlier probe still proves its size
+    if (state_ != State::kSearching || size <= search_low_) {
+        return;
     }
+    plpmtu_ = static_cast<uint16_t>(std::min<uint32_t>(size, max_plpmtu_));
+    search_low_ = plpmtu_;
+    search_high_ = std::max(search_high_, search_low_);
+    LOG_INFO("PmtuProber: PLPMTU raised to %u", plpmtu_);
+    if (search_high_ < search_low_ + kSearchGranularity) {
+        CompleteSearch();
+    } else if (current || !probe_inflight_) {
+        NextProbe();
+    }
+}
 
-    // First contiguous range: [largest - first_range, largest]
-    uint32_t first_range = ack->GetFirstAckRange();
-    if (probe >= largest - first_range && probe <= largest) {
-        OnProbeResult(true);
-        return true;
+void PmtuProber::OnPacketLost(uint64_t packet_number, uint32_t size, bool mtu_probe) {
+    if (!mtu_probe) {
+        // RFC 8899 §4.3: packets larger than BASE_PLPMTU disappearing while
+        // none of that size gets through suggest the PLPMTU no longer fits.
+        // Ordinary congestion loss is usually followed by ACKs for later
+        // full-size packets, which resets the count.
+        if (size > kMinInitialPacketSize && plpmtu_ > kMinInitialPacketSize &&
+            packet_number > largest_acked_large_ && !validating_) {
+            if (++large_loss_count_ >= kMaxProbes) {
+                LOG_WARN("PmtuProber: %u packets above BASE_PLPMTU lost, validating PLPMTU %u", large_loss_count_,
+                    plpmtu_);
+                validating_ = true;
+                large_loss_count_ = 0;
+                probe_count_ = 0;
+            }
+        }
+        return;
+    }
+    if (!probe_inflight_ || packet_number != probe_packet_number_) {
+        return;
     }
+    probe_inflight_ = false;
+    if (++probe_count_ < kMaxProbes) {
+        return;  // send the same size again
+    }
+    probe_count_ = 0;
 
-    // Walk additional ACK ranges. Per RFC 9000 §19.3.1, gap_value is the
-    // unacked-count minus one, so the next range's largest PN is
-    // cursor - gap_value - 2.
-    uint64_t cursor = largest - first_range;
-    auto ranges = ack->GetAckRange();
-    for (auto it = ranges.begin(); it != ranges.end(); ++it) {
-        uint64_t range_high = cursor - it->GetGap() - 2;
-        uint64_t range_low =
-            (range_high >= it->GetAckRangeLength()) ? (range_high - it->GetAckRangeLength()) : 0;
-        if (probe >= range_low && probe <= range_high) {
-            OnProbeResult(true);
-            return true;
+    if (probe_is_validation_) {
+        if (validating_) {
+            OnBlackHole();
         }
-        cursor = range_low;
+        return;
+    }
+    if (state_ != State::kSearching) {
+        return;
+    }
+    // RFC 8899 §5.3.1: this size does not fit, search below it
+    search_high_ = std::max<uint16_t>(search_low_, probe_target_bytes_ - 1);
+    if (search_high_ < search_low_ + kSearchGranularity) {
+        CompleteSearch();
+    } else {
+        NextProbe();
+    }
+}
+
+void PmtuProber::NextProbe() {
+    probe_target_bytes_ = static_cast<uint16_t>(search_low_ + (search_high_ - search_low_ + 1) / 2);
+    probe_count_ = 0;
+}
+
+void PmtuProber::CompleteSearch() {
+    state_ = State::kSearchComplete;
+    LOG_INFO("PmtuProber: search complete, PLPMTU=%u (max %u)", plpmtu_, max_plpmtu_);
+    if (timer_ && plpmtu_ < max_plpmtu_) {
+        timer_->ArmTimer(raise_timer_, kRaiseTimerMs);
+    }
+}
+
+void PmtuProber::OnBlackHole() {
+    uint16_t failed = plpmtu_;
+    LOG_WARN("PmtuProber: black hole detected at PLPMTU %u, falling back to %u", failed, kMinInitialPacketSize);
+    validating_ = false;
+    large_loss_count_ = 0;
+    plpmtu_ = kMinInitialPacketSize;
+    // search again, below the size that stopped working
+    if (timer_) {
+        timer_->DisarmTimer(raise_timer_);
+    }
+    search_low_ = plpmtu_;
+    search_high_ = static_cast<uint16_t>(failed - 1);
+    if (search_high_ < search_low_ + kSearchGranularity) {
+        CompleteSearch();
+        return;
+    }
+    state_ = State::kSearching;
+    NextProbe();
+}
+
+void PmtuProber::OnRaiseTimer() {
+    if (state_ != State::kSearchComplete) {
+        return;
+    }
+    StartProbe();
+    if (state_ == State::kSearching && probe_needed_cb_) {
+        probe_needed_cb_();
     }
-    return false;
 }
 
 }  // namespace quic
-}  // namespace quicx
\ No newline at end of file
+}  // namespace quicx
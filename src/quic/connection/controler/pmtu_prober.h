@@ -2,58 +2,125 @@
 #define QUIC_CONNECTION_CONTROLER_PMTU_PROBER
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 
+#include "common/timer/if_timer.h"
+#include "common/timer/timer_node.h"
+
 namespace quicx {
 namespace quic {
 
-class IFrame;
-class AckFrame;
-
-// PmtuProber encapsulates Path MTU Discovery (PMTUD) logic.
-// Responsible for probing a larger MTU after migration and detecting probe
-// success via ACK range analysis. Extracted from SendManager for single
-// responsibility.
+// PmtuProber implements Datagram Packetization Layer PMTU Discovery
+// (DPLPMTUD, RFC 8899 §5, applied to QUIC by RFC 9000 §14.3).
+//
+// The PLPMTU (largest datagram the connection sends) is searched upwards
+// with PING+PADDING probe packets, binary search between what is known to
+// work and the peer's max_udp_payload_size (capped at kMaxPlpmtu for
+// jumbo-frame links). A probe size is given up after kMaxProbes losses.
+// Probes are tracked by loss detection like any packet but never reach
+// congestion control (RFC 9000 §14.4): their loss says nothing about
+// congestion.
+//
+// Black-hole detection: once kMaxProbes packets larger than BASE_PLPMTU are
+// lost with nothing of that size acked after them, a probe at the current
+// PLPMTU confirms the path still carries it. If that is lost too, the
+// PLPMTU drops to BASE_PLPMTU and the search restarts below the old value.
+//
+// After a search completes the PMTU_RAISE_TIMER re-probes for a larger
+// PMTU, since paths can change.
 class PmtuProber {
 public:
-    PmtuProber();
-    ~PmtuProber() = default;
+    // RFC 8899 §5.2 states. Disabled is not modelled (the prober is always
+    // on) and neither is Error: QUIC cannot go below BASE_PLPMTU
+    // (RFC 9000 §14.1), so a path that loses it is left to the idle timeout.
+    enum class State : uint8_t {
+        kBase,            // search not started (new path or handshake not confirmed)
+        kSearching,       // probing for a larger PLPMTU
+        kSearchComplete,  // waiting for the raise timer
+    };
 
-    // Start a PMTU probe sequence. Picks a target MTU slightly above the
-    // current limit and marks the probe as in-flight.
-    void StartProbe();
+    // RFC 8899 §5.1.2: probes of one size sent before it is declared too big.
+    static constexpr uint32_t kMaxProbes = 3;
+    // RFC 8899 §5.1.1: PMTU_RAISE_TIMER.
+    static constexpr uint32_t kRaiseTimerMs = 600 * 1000;
+    // The search stops once the bracket is narrower than this.
+    static constexpr uint16_t kSearchGranularity = 16;
+
+    explicit PmtuProber(std::shared_ptr<common::ITimer> timer);
+    ~PmtuProber();
 
-    // Notify probe result (success selects the higher MTU, failure falls back).
-    void OnProbeResult(bool success);
+    // Called when a probe becomes due outside of packet processing (the raise
+    // timer fired), so the connection schedules a send.
+    void SetProbeNeededCallback(std::function<void()> cb) { probe_needed_cb_ = std::move(cb); }
+
+    // Upper bound of the search from the peer's max_udp_payload_size
+    // transport parameter (0 when absent: the RFC 9000 default of 65527).
+    void SetPeerMaxUdpPayloadSize(uint64_t size);
+
+    // Start searching from the current PLPMTU. Called once the handshake is
+    // confirmed and after a path change.
+    void StartProbe();
 
-    // Reset probing state for a new path (use conservative size until probed).
+    // Reset probing state for a new path: back to BASE_PLPMTU, search stopped.
     void ResetForNewPath();
 
-    // Check whether an ACK frame covers the probe packet number. If so, calls
-    // OnProbeResult(true) internally and returns true.
-    bool CheckAckCoversProbe(std::shared_ptr<IFrame> ack_frame);
+    // Size of the probe packet to send now, 0 if none is due.
+    uint16_t GetProbeSize() const;
 
-    // Record the packet number used for the probe packet. Should be called by
-    // SendManager when the probe packet is actually sent.
-    void SetProbePacketNumber(uint64_t pn) { probe_packet_number_ = pn; }
+    // Record the probe actually built for GetProbeSize(): its packet number
+    // and encoded size (which may fall a few bytes short of the target).
+    void OnProbeSent(uint64_t packet_number, uint32_t size);
 
-    // Current effective MTU limit.
-    uint16_t GetMtuLimit() const { return mtu_limit_bytes_; }
+    // Outcome of an application-space packet, from loss detection. The probe
+    // is recognised by `mtu_probe`; other packets larger than BASE_PLPMTU
+    // feed black-hole detection.
+    void OnPacketAcked(uint64_t packet_number, uint32_t size, bool mtu_probe);
+    void OnPacketLost(uint64_t packet_number, uint32_t size, bool mtu_probe);
+
+    // Current PLPMTU: the UDP payload size regular packets may fill.
+    uint16_t GetMtuLimit() const { return plpmtu_; }
+
+    State GetState() const { return state_; }
 
     // Whether a probe is currently in-flight.
     bool IsProbeInflight() const { return probe_inflight_; }
 
-    // Target MTU for the current probe.
+    // Target size of the current or next probe.
     uint16_t GetProbeTargetBytes() const { return probe_target_bytes_; }
 
 private:
-    bool probe_inflight_{false};
-    uint16_t mtu_limit_bytes_{1450};
-    uint16_t probe_target_bytes_{1450};
-    uint64_t probe_packet_number_{0};
+    void NextProbe();
+    void CompleteSearch();
+    void OnBlackHole();
+    void OnRaiseTimer();
+
+private:
+    State state_;
+    uint16_t plpmtu_;
+    uint16_t max_plpmtu_;
+    // Search bracket: search_low_ is known to work, sizes above search_high_
+    // are known (or assumed) not to.
+    uint16_t search_low_;
+    uint16_t search_high_;
+
+    bool probe_inflight_;
+    bool probe_is_validation_;  // the in-flight probe is a black-hole check
+    uint16_t probe_target_bytes_;
+    uint64_t probe_packet_number_;
+    uint32_t probe_count_;  // losses of the current probe size
+
+    // Black-hole detection
+    bool validating_;  // the next probe confirms the current PLPMTU
+    uint32_t large_loss_count_;
+    uint64_t largest_acked_large_;  // largest PN of an acked packet > BASE_PLPMTU
+
+    std::shared_ptr<common::ITimer> timer_;
+    common::TimerNode raise_timer_;
+    std::function<void()> probe_needed_cb_;
 };
 
 }  // namespace quic
 }  // namespace quicx
 
-#endif
\ No newline at end of file
+#endif
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 
 #include "common/log/log.h"
@@ -8,6 +9,7 @@
 #include "quic/connection/controler/recv_control.h"
 #include "quic/connection/util.h"
 #include "quic/frame/ack_frame.h"
+#include "quic/frame/path_ack_frame.h"
 
 namespace quicx {
 namespace quic {
@@ -15,7 +17,8 @@ namespace quic {
 RecvControl::RecvControl(std::shared_ptr<common::ITimer> timer):
     timer_(timer),
     set_timer_(false),
-    max_ack_delay_(10) {
+    max_ack_delay_(10),
+    ack_threshold_(kAckThreshold) {
     memset(pkt_num_largest_recvd_, 0, sizeof(pkt_num_largest_recvd_));
     memset(largest_recv_time_, 0, sizeof(largest_recv_time_));
     memset(ect0_count_, 0, sizeof(ect0_count_));
@@ -25,7 +28,7 @@ RecvControl::RecvControl(std::shared_ptr<common::ITimer> timer):
         ack_due_[i] = false;
     }
 
-    timer_task_ = common::TimerTask([this] {
+    timer_task_.SetTimeoutCallback([this] {
         set_timer_ = false;
         // PERF FIX (P0): The max_ack_delay_ timer only ever fires for
         // Application-space packets (Initial/Handshake go through the
@@ -54,6 +57,7 @@ void RecvControl::OnPacketRecv(uint64_t time, std::shared_ptr<IPacket> packet) {
 
     auto ns = CryptoLevel2PacketNumberSpace(packet->GetCryptoLevel());
     uint64_t pkt_num = packet->GetPacketNumber();
+    uint64_t prev_largest = pkt_num_largest_recvd_[ns];
 
     // Update largest received packet number
     if (pkt_num_largest_recvd_[ns] < pkt_num) {
@@ -61,10 +65,14 @@ void RecvControl::OnPacketRecv(uint64_t time, std::shared_ptr<IPacket> packet) {
         largest_recv_time_[ns] = time;
     }
 
-    // Add to ACK queue
-    wait_ack_packet_numbers_[ns].insert(pkt_num);
-    LOG_DEBUG("RecvControl::OnPacketRecv: added packet %llu to ACK queue, ns=%d, queue size=%zu", pkt_num, ns,
-        wait_ack_packet_numbers_[ns].size());
+    // Add to ACK queue. A duplicate still counts as pending: the peer
+    // resending it suggests our earlier ACK did not get through.
+    if (received_ranges_[ns].Add(pkt_num)) {
+        ack_ranges_dirty_[ns] = true;
+    }
+    pending_ack_count_[ns]++;
+    LOG_DEBUG("RecvControl::OnPacketRecv: added packet %llu to ACK queue, ns=%d, pending=%zu, ranges=%zu", pkt_num,
+        ns, pending_ack_count_[ns], received_ranges_[ns].Size());
 
     // RFC 9000: Determine if immediate ACK is required.
     //
@@ -80,7 +88,7 @@ void RecvControl::OnPacketRecv(uint64_t time, std::shared_ptr<IPacket> packet) {
     // ECN-driven congestion-response responsiveness. Tracked as a
     // learning-only limitation in learning_project_roadmap.md §2.
     uint8_t ecn = 0;
-    bool need_immediate_ack = ShouldSendImmediateAck(ns, pkt_num, ecn);
+    bool need_immediate_ack = ShouldSendImmediateAck(ns, pkt_num, prev_largest, ecn);
 
     if (need_immediate_ack) {
         LOG_DEBUG("RecvControl::OnPacketRecv: triggering immediate ACK for ns=%d", ns);
@@ -115,7 +123,7 @@ void RecvControl::OnPacketRecv(uint64_t time, std::shared_ptr<IPacket> packet) {
         // For Application packets, use timer-based ACK
         if (!set_timer_) {
             set_timer_ = true;
-            timer_->AddTimer(timer_task_, max_ack_delay_);
+            timer_->ArmTimer(timer_task_, max_ack_delay_);
         }
         common::Metrics::CounterInc(common::MetricsStd::DiagRecvAckDelayed);
     }
@@ -141,117 +149,95 @@ void RecvControl::OnEcnCounters(uint8_t ecn, PacketNumberSpace ns) {
 std::shared_ptr<IFrame> RecvControl::MayGenerateAckFrame(uint64_t now, PacketNumberSpace ns, bool ecn_enabled) {
     common::Metrics::CounterInc(common::MetricsStd::DiagAckGenCalls);
     if (set_timer_) {
-        timer_->RemoveTimer(timer_task_);
+        timer_->DisarmTimer(timer_task_);
         set_timer_ = false;
     }
 
-    // PERF FIX (P0): clear the ack-due flag now; any remaining packets in
-    // the wait queue (e.g. after kMaxAckRanges truncation) will re-arm the
-    // flag via the threshold check in ShouldSendImmediateAck(), the
-    // max_ack_delay_ timer, or an OoO/gap trigger from a new arrival.
+    // PERF FIX (P0): clear the ack-due flag now; a later arrival re-arms it
+    // via the threshold check in ShouldSendImmediateAck(), the
+    // max_ack_delay_ timer, or an OoO/gap trigger.
     ack_due_[ns] = false;
 
-    // Build ACK ranges from contiguous runs (descending by packet number)
-    auto& nums = wait_ack_packet_numbers_[ns];
-    std::vector<uint64_t> acked_packets;  // Track packets included in this ACK frame
-
-    // Limit number of ranges to prevent oversized ACK frames
-    // RFC 9000 doesn't specify a hard limit, but we need to fit in MTU
-    // 64 ranges is a safe upper bound (approx 64 * 16 bytes = 1KB)
-    const size_t kMaxAckRanges = 64;
-
-    if (nums.empty()) {
+    auto& ranges = received_ranges_[ns];
+    if (pending_ack_count_[ns] == 0 || ranges.Empty()) {
         return nullptr;
     }
     common::Metrics::CounterInc(common::MetricsStd::DiagAckGenEmitted);
-    common::Metrics::CounterInc(common::MetricsStd::DiagAckQueueDepth, nums.size());
-
-    // Collect runs as [high, low]
-    std::vector<std::pair<uint64_t, uint64_t>> runs;
-    auto rit = nums.rbegin();
-    uint64_t run_high = *rit;
-    uint64_t run_low = run_high;
-    acked_packets.push_back(*rit);
-    ++rit;
-
-    for (; rit != nums.rend(); ++rit) {
-        uint64_t pn = *rit;
-        if (pn + 1 == run_low) {
-            // still contiguous downward
-            run_low = pn;
-            acked_packets.push_back(pn);
+    common::Metrics::CounterInc(common::MetricsStd::DiagAckQueueDepth, pending_ack_count_[ns]);
+
+    // Reuse the cached frame when we hold the only reference to it. A frame
+    // that went out in an ack-eliciting packet is still referenced by that
+    // packet (SendControl keeps it for retransmission and reads its Largest
+    // Acknowledged when the packet is acked), so it must not be rewritten;
+    // copy-on-write into a fresh frame instead.
+    auto& frame = cached_ack_frame_[ns];
+    uint16_t ack_type = ecn_enabled ? FrameType::kAckEcn : FrameType::kAck;
+    if (path_id_ != 0) {
+        ack_type = ecn_enabled ? FrameType::kPathAckEcn : FrameType::kPathAck;
+    }
+    if (!frame || frame.use_count() > 1 || frame->GetType() != ack_type) {
+        if (path_id_ != 0) {
+            auto path_ack = std::make_shared<PathAckFrame>(ack_type);
+            path_ack->SetPathId(path_id_);
+            frame = path_ack;
+        } else if (ecn_enabled) {
+            frame = std::make_shared<AckEcnFrame>();
         } else {
-            // close current run and start a new one
-            runs.emplace_back(run_high, run_low);
-
-            if (runs.size() >= kMaxAckRanges) {
-                // Stop collecting ranges if we hit the limit
-                // The remaining packets will be ACKed in the next frame
-                LOG_WARN(
-                    "RecvControl::MayGenerateAckFrame: hit max ACK ranges limit (%zu), deferring remaining ACKs",
-                    kMaxAckRanges);
-                break;
-            }
-
-            run_high = pn;
-            run_low = pn;
-            acked_packets.push_back(pn);
+            frame = std::make_shared<AckFrame>();
         }
+        ack_ranges_dirty_[ns] = true;
     }
-    // push last run if we haven't hit the limit
-    if (runs.size() < kMaxAckRanges) {
-        runs.emplace_back(run_high, run_low);
+    if (ack_ranges_dirty_[ns]) {
+        RebuildAckRanges(ns, *frame);
+        ack_ranges_dirty_[ns] = false;
     }
-
-    // Generate ACK or ACK_ECN frame based on ECN enable
-    std::shared_ptr<AckFrame> frame;
     if (ecn_enabled) {
-        auto f = std::make_shared<AckEcnFrame>();
+        auto f = std::static_pointer_cast<AckEcnFrame>(frame);
         f->SetEct0(ect0_count_[ns]);
         f->SetEct1(ect1_count_[ns]);
         f->SetEcnCe(ce_count_[ns]);
-        frame = f;
-    } else {
-        frame = std::make_shared<AckFrame>();
     }
 
-    // Largest Acknowledged is the highest packet number in the limited selection (first run's high)
-    uint64_t largest_ack_in_frame = runs[0].first;
-    frame->SetLargestAck(largest_ack_in_frame);
-
-    // BUGFIX P1-3: ACK Delay should reflect the time since receiving the
-    // largest acknowledged packet *in this frame*, not the global largest.
-    // When ACK ranges are truncated (kMaxAckRanges limit), largest_ack_in_frame
-    // may differ from pkt_num_largest_recvd_[ns].
-    // Since we only track time for the overall largest, use it when they match.
-    // When they differ, use 0 delay to avoid reporting a misleadingly small value
-    // that would cause the peer to underestimate RTT.
+    // ACK Delay reflects the time since receiving the largest acknowledged
+    // packet. Receive time is only tracked for the overall largest; if the
+    // frame's largest differs (that packet's range was already dropped by an
+    // ACK-of-ACK and a lower one re-arrived), report 0 so the peer slightly
+    // overestimates RTT rather than underestimating it.
     {
         uint64_t delay_ms = 0;
-        if (largest_ack_in_frame == pkt_num_largest_recvd_[ns]) {
-            // Exact: largest in frame IS the global largest, use tracked time
+        if (frame->GetLargestAck() == pkt_num_largest_recvd_[ns]) {
             delay_ms = now - largest_recv_time_[ns];
-        } else {
-            // Approximate: We don't track per-packet receive time.
-            // Report 0 delay so peer doesn't subtract an incorrect value from RTT.
-            // RFC 9000 §13.2: "An endpoint MIGHT intentionally delay sending
-            // an ACK frame... The ACK Delay field... indicates the time the
-            // largest acknowledged packet was received."
-            // Reporting 0 is safe — peer will slightly overestimate RTT, which
-            // is conservative and better than underestimation.
-            delay_ms = 0;
         }
         uint64_t encoded = delay_ms >> ack_delay_exponent_;
         frame->SetAckDelay(static_cast<uint32_t>(encoded));
     }
 
+    LOG_DEBUG("RecvControl::MayGenerateAckFrame: generated ACK for %zu new packets, largest=%llu, ranges=%zu",
+        pending_ack_count_[ns], frame->GetLargestAck(), ranges.Size());
+    pending_ack_count_[ns] = 0;
+
+    // Metrics: Track ACK frequency
+    ack_count_++;
+    if (last_ack_time_ > 0 && now > last_ack_time_) {
+        uint64_t frequency = 1000 / (now - last_ack_time_);  // ACKs per second
+        common::Metrics::GaugeSet(common::MetricsStd::AckFrequency, frequency);
+    }
+    last_ack_time_ = now;
+
+    return frame;
+}
+
+void RecvControl::RebuildAckRanges(PacketNumberSpace ns, AckFrame& frame) {
+    const auto& ranges = received_ranges_[ns];
+    frame.ClearAckRange();
+    frame.SetLargestAck(ranges[0].high);
+
     // First ACK Range is size of first run minus 1
-    uint64_t first_ack_range = runs[0].first - runs[0].second;
-    frame->SetFirstAckRange(static_cast<uint32_t>(first_ack_range));
+    frame.SetFirstAckRange(static_cast<uint32_t>(ranges[0].high - ranges[0].low));
 
     // Additional ranges: Gap and Range Length encoded per RFC 9000 §19.3.1.
     //
-    // For two adjacent runs runs[i-1] (smallest = prev_low) and runs[i]
+    // For two adjacent runs ranges[i-1] (smallest = prev_low) and ranges[i]
     // (largest = next_high) the actual count of unacked packets between
     // them is (prev_low - 1) - (next_high + 1) + 1 = prev_low - next_high - 1.
     // RFC 9000 §19.3.1: "Each Gap field encodes the length of a sequence of
@@ -261,54 +247,68 @@ std::shared_ptr<IFrame> RecvControl::MayGenerateAckFrame(uint64_t now, PacketNum
     // BUGFIX (G2 / Bug #22, encoder side):
     //   The previous code emitted gap = prev_low - next_high - 1, encoding one
     //   too few unacked packets. Combined with the symmetric -1 mistake on the
-    //   decoder side (send_control.cpp ~line 307), peers would see selective-
+    //   decoder side (send_control.cpp OnPacketAck), peers would see selective-
     //   ACK PNs shifted by exactly 0 (the two bugs cancelled). After fixing
     //   the decoder alone, this side started telling RFC-compliant peers
     //   (e.g. quic-go) that an extra packet was acknowledged — which broke
     //   transfer in the quicx-client direction (peer reused PNs for fresh
     //   data, our SendStream tracking went out-of-order, and quic-go's server
     //   reset the connection).
-    for (size_t i = 1; i < runs.size(); ++i) {
-        uint64_t prev_low = runs[i - 1].second;
-        uint64_t next_high = runs[i].first;
+    for (size_t i = 1; i < ranges.Size(); ++i) {
+        uint64_t prev_low = ranges[i - 1].low;
+        uint64_t next_high = ranges[i].high;
         uint64_t gap = (prev_low - next_high) - 2;
-        uint64_t range_len = runs[i].first - runs[i].second;
-        frame->AddAckRange(gap, range_len);
+        uint64_t range_len = ranges[i].high - ranges[i].low;
+        frame.AddAckRange(gap, range_len);
     }
+}
 
-    // Remove ONLY the packets that were actually included in this ACK frame
-    for (uint64_t pn : acked_packets) {
-        wait_ack_packet_numbers_[ns].erase(pn);
+void RecvControl::OnAckFrameAcked(PacketNumberSpace ns, uint64_t largest_acked) {
+    if (received_ranges_[ns].RemoveUpTo(largest_acked)) {
+        ack_ranges_dirty_[ns] = true;
+        LOG_DEBUG("RecvControl::OnAckFrameAcked: ns=%d dropped ranges up to %llu, ranges left=%zu", ns,
+            largest_acked, received_ranges_[ns].Size());
     }
-
-    LOG_DEBUG("RecvControl::MayGenerateAckFrame: generated ACK for %zu packets, remaining in queue: %zu",
-        acked_packets.size(), wait_ack_packet_numbers_[ns].size());
-
-    // PERF FIX (P0): If kMaxAckRanges truncated us and packets remain
-    // unacked, re-mark the space as ack-due so the next TrySend() can
-    // continue draining the queue without waiting for a fresh trigger.
-    if (!wait_ack_packet_numbers_[ns].empty()) {
-        ack_due_[ns] = true;
+    if (received_ranges_[ns].Empty()) {
+        // Anything still counted as pending was covered by the acked frame.
+        pending_ack_count_[ns] = 0;
     }
+}
 
-    // Metrics: Track ACK frequency
-    ack_count_++;
-    if (last_ack_time_ > 0 && now > last_ack_time_) {
-        uint64_t frequency = 1000 / (now - last_ack_time_);  // ACKs per second
-        common::Metrics::GaugeSet(common::MetricsStd::AckFrequency, frequency);
+bool RecvControl::OnAckFrequency(uint64_t sequence_number, uint64_t ack_eliciting_threshold,
+    uint64_t request_max_ack_delay_us, uint64_t reordering_threshold) {
+    if (ack_frequency_applied_ && sequence_number <= ack_frequency_sequence_) {
+        LOG_DEBUG("RecvControl::OnAckFrequency: ignore stale sequence %llu (applied %llu)", sequence_number,
+            ack_frequency_sequence_);
+        return false;
     }
-    last_ack_time_ = now;
-
-    return frame;
+    ack_frequency_applied_ = true;
+    ack_frequency_sequence_ = sequence_number;
+
+    // An ACK is due once more than Ack-Eliciting Threshold packets are
+    // unacknowledged, i.e. when the pending count reaches threshold + 1.
+    ack_threshold_ = static_cast<size_t>(std::min<uint64_t>(ack_eliciting_threshold, UINT32_MAX)) + 1;
+    // The delayed-ACK timer has millisecond granularity: round up so we
+    // never ACK later than asked, and never use a zero-length timer.
+    uint64_t delay_ms = (request_max_ack_delay_us + 999) / 1000;
+    max_ack_delay_ = static_cast<uint32_t>(std::max<uint64_t>(1, std::min<uint64_t>(delay_ms, UINT32_MAX)));
+    reordering_threshold_ = reordering_threshold;
+
+    LOG_DEBUG("RecvControl::OnAckFrequency: seq=%llu, ack_threshold=%zu, max_ack_delay=%ums, reordering=%llu",
+        sequence_number, ack_threshold_, max_ack_delay_, reordering_threshold_);
+    return true;
 }
 
 void RecvControl::UpdateConfig(const TransportParam& tp) {
-    max_ack_delay_ = static_cast<uint32_t>(tp.GetMaxAckDelay());
+    // Once the peer sent ACK_FREQUENCY its requested max_ack_delay wins.
+    if (!ack_frequency_applied_) {
+        max_ack_delay_ = static_cast<uint32_t>(tp.GetMaxAckDelay());
+    }
     ack_delay_exponent_ = static_cast<uint32_t>(tp.GetackDelayExponent());
 }
 
 // RFC 9000 Section 13.2.1: Determine if immediate ACK is required
-bool RecvControl::ShouldSendImmediateAck(PacketNumberSpace ns, uint64_t pkt_num, uint8_t ecn) {
+bool RecvControl::ShouldSendImmediateAck(PacketNumberSpace ns, uint64_t pkt_num, uint64_t prev_largest, uint8_t ecn) {
     // RFC 9000: Initial and Handshake packets MUST be ACKed immediately
     if (ns == kInitialNumberSpace || ns == kHandshakeNumberSpace) {
         LOG_DEBUG("ShouldSendImmediateAck: Initial/Handshake packet, immediate ACK required");
@@ -323,23 +323,34 @@ bool RecvControl::ShouldSendImmediateAck(PacketNumberSpace ns, uint64_t pkt_num,
         return true;
     }
 
-    auto& acked_packets = wait_ack_packet_numbers_[ns];
-
-    // RFC 9000: Immediate ACK if packet number < previously received packet (out of order)
-    if (pkt_num < pkt_num_largest_recvd_[ns]) {
-        LOG_DEBUG("ShouldSendImmediateAck: Out-of-order (pkt=%llu < largest=%llu), immediate ACK", pkt_num,
-            pkt_num_largest_recvd_[ns]);
-        common::Metrics::CounterInc(common::MetricsStd::DiagRecvAckOoo);
+    // draft-ietf-quic-ack-frequency §5: IMMEDIATE_ACK overrides every threshold
+    if (immediate_ack_requested_[ns]) {
+        immediate_ack_requested_[ns] = false;
+        LOG_DEBUG("ShouldSendImmediateAck: IMMEDIATE_ACK frame, immediate ACK");
         return true;
     }
 
-    // RFC 9000: Immediate ACK if packet number > largest but there are gaps
-    if (pkt_num > pkt_num_largest_recvd_[ns] + 1) {
-        LOG_DEBUG("ShouldSendImmediateAck: Gap detected (expected=%llu, got=%llu), immediate ACK",
-            pkt_num_largest_recvd_[ns] + 1, pkt_num);
+    if (reordering_threshold_ == 1) {
+        // RFC 9000: Immediate ACK if packet number < previously received packet (out of order)
+        if (pkt_num < pkt_num_largest_recvd_[ns]) {
+            LOG_DEBUG("ShouldSendImmediateAck: Out-of-order (pkt=%llu < largest=%llu), immediate ACK", pkt_num,
+                pkt_num_largest_recvd_[ns]);
+            common::Metrics::CounterInc(common::MetricsStd::DiagRecvAckOoo);
+            return true;
+        }
+
+        // RFC 9000: Immediate ACK if packet number > largest but there are gaps
+        if (pkt_num > pkt_num_largest_recvd_[ns] + 1) {
+            LOG_DEBUG("ShouldSendImmediateAck: Gap detected (expected=%llu, got=%llu), immediate ACK",
+                pkt_num_largest_recvd_[ns] + 1, pkt_num);
+            common::Metrics::CounterInc(common::MetricsStd::DiagRecvAckGap);
+            return true;
+        }
+    } else if (reordering_threshold_ > 1 && ReorderingThresholdCrossed(ns, prev_largest)) {
         common::Metrics::CounterInc(common::MetricsStd::DiagRecvAckGap);
         return true;
     }
+    // reordering_threshold_ == 0: the peer asked us to ignore reordering.
 
     // RFC 9000 Section 13.2.2: Send ACK after at least 2 ack-eliciting packets.
     // NOTE: RFC says "at least 2" as a *lower bound* against unbounded delay,
@@ -351,8 +362,9 @@ bool RecvControl::ShouldSendImmediateAck(PacketNumberSpace ns, uint64_t pkt_num,
     // bounds worst-case delay if traffic is sparse.
     // The threshold is centralized in quic/config.h::kAckThreshold so it can
     // be tuned in one place without recompiling individual call sites.
-    if (acked_packets.size() >= kAckThreshold) {
-        LOG_DEBUG("ShouldSendImmediateAck: %zu+ packets in queue, sending ACK", kAckThreshold);
+    // A peer's ACK_FREQUENCY frame replaces it through ack_threshold_.
+    if (pending_ack_count_[ns] >= ack_threshold_) {
+        LOG_DEBUG("ShouldSendImmediateAck: %zu+ packets in queue, sending ACK", ack_threshold_);
         common::Metrics::CounterInc(common::MetricsStd::DiagRecvAckThreshold);
         return true;
     }
@@ -360,15 +372,43 @@ bool RecvControl::ShouldSendImmediateAck(PacketNumberSpace ns, uint64_t pkt_num,
     return false;  // Can delay ACK
 }
 
+bool RecvControl::ReorderingThresholdCrossed(PacketNumberSpace ns, uint64_t prev_largest) const {
+    const auto& ranges = received_ranges_[ns];
+    if (ranges.Empty()) {
+        return false;
+    }
+    // The largest missing packet sits right below the newest range; there is
+    // none if that range reaches down to what was already acknowledged.
+    uint64_t newest_low = ranges[0].low;
+    if (ranges.Size() < 2 && newest_low <= ranges.Floor()) {
+        return false;
+    }
+    uint64_t missing = newest_low - 1;
+    uint64_t distance = ranges.Largest() - missing;
+    uint64_t prev_distance = prev_largest > missing ? prev_largest - missing : 0;
+    // Fire once, on the packet that pushes the gap past the threshold, not on
+    // every packet after it.
+    if (distance >= reordering_threshold_ && prev_distance < reordering_threshold_) {
+        LOG_DEBUG("ShouldSendImmediateAck: packet %llu missing for %llu packets (threshold %llu), immediate ACK",
+            missing, distance, reordering_threshold_);
+        return true;
+    }
+    return false;
+}
+
 // RFC 9000 Section 4.10: Discard packet number space state
 void RecvControl::DiscardPacketNumberSpace(PacketNumberSpace ns) {
-    wait_ack_packet_numbers_[ns].clear();
+    received_ranges_[ns].Clear();
+    pending_ack_count_[ns] = 0;
+    cached_ack_frame_[ns].reset();
+    ack_ranges_dirty_[ns] = true;
     pkt_num_largest_recvd_[ns] = 0;
     largest_recv_time_[ns] = 0;
     ect0_count_[ns] = 0;
     ect1_count_[ns] = 0;
     ce_count_[ns] = 0;
     ack_due_[ns] = false;
+    immediate_ack_requested_[ns] = false;
     LOG_INFO("RecvControl: Discarded packet number space %d per RFC 9000", ns);
 }
 
@@ -381,7 +421,7 @@ void RecvControl::DiscardPacketNumberSpace(PacketNumberSpace ns) {
 //   - Application space: ack_due_ is set by an immediate-ACK trigger
 //     (threshold / OoO / gap / ECN-CE) or by the max_ack_delay_ timer.
 bool RecvControl::ShouldSendAckNow(PacketNumberSpace ns) const {
-    if (wait_ack_packet_numbers_[ns].empty()) {
+    if (!HasPendingAck(ns)) {
         return false;
     }
     // RFC 9000 §13.2.1: Initial and Handshake packets MUST be ACKed
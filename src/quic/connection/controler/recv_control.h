@@ -2,11 +2,14 @@
 #define QUIC_CONNECTION_CONTROLER_RECV_CONTROL
 
 #include <functional>
-#include <set>
+#include <memory>
 
 #include "common/timer/if_timer.h"
+#include "common/timer/timer_node.h"
 
+#include "quic/connection/controler/ack_range_set.h"
 #include "quic/connection/transport_param.h"
+#include "quic/frame/ack_frame.h"
 #include "quic/packet/if_packet.h"
 #include "quic/packet/type.h"
 
@@ -26,6 +29,8 @@ an ACK trigger packet: When the packet number of the received packet is less tha
 packet, and the packet numbers are not contiguous.
 5. The receiver SHOULD send an ACK frame only after receiving at least two ACK trigger packets.
 6. The receiver SHOULD include an ACK Range in each ACK frame, which contains the largest received packet number.
+7. draft-ietf-quic-ack-frequency: the peer may replace the thresholds of 2. and 4. and the max_ack_delay with an
+ACK_FREQUENCY frame, or ask for an ACK right away with IMMEDIATE_ACK.
 */
 class RecvControl {
 public:
@@ -33,7 +38,7 @@ public:
     ~RecvControl() {
         // Cancel timer to prevent use-after-free when timer fires after destruction
         if (timer_ && set_timer_) {
-            timer_->RemoveTimer(timer_task_);
+            timer_->DisarmTimer(timer_task_);
         }
         // Clear callbacks to prevent dangling references
         immediate_ack_cb_ = nullptr;
@@ -45,12 +50,28 @@ public:
     std::shared_ptr<IFrame> MayGenerateAckFrame(uint64_t now, PacketNumberSpace ns, bool ecn_enabled = true);
 
     // Check if there are packets waiting to be ACKed
-    bool HasPendingAck(PacketNumberSpace ns) const { return !wait_ack_packet_numbers_[ns].empty(); }
+    bool HasPendingAck(PacketNumberSpace ns) const { return pending_ack_count_[ns] > 0; }
+
+    // RFC 9000 §13.2.4: a packet carrying one of our ACK frames (with the
+    // given Largest Acknowledged) was acknowledged by the peer, so packet
+    // numbers up to `largest_acked` need not be reported again.
+    void OnAckFrameAcked(PacketNumberSpace ns, uint64_t largest_acked);
+
+    // draft-ietf-quic-ack-frequency §4: adopt the thresholds of an
+    // ACK_FREQUENCY frame. Frames whose sequence number is not larger than
+    // the last one applied are stale and ignored (returns false). The
+    // requested max_ack_delay is in microseconds and must already have been
+    // checked against our min_ack_delay.
+    bool OnAckFrequency(uint64_t sequence_number, uint64_t ack_eliciting_threshold, uint64_t request_max_ack_delay_us,
+        uint64_t reordering_threshold);
+    // draft-ietf-quic-ack-frequency §5: the packet being processed carried an
+    // IMMEDIATE_ACK frame, so acknowledge it without waiting for a threshold.
+    void OnImmediateAck(PacketNumberSpace ns) { immediate_ack_requested_[ns] = true; }
 
     // Check whether an ACK frame should be emitted *right now* for `ns`.
     //
     // PERF FIX (P0): The previous send path treated any non-empty
-    // `wait_ack_packet_numbers_` as a reason to attach an ACK frame to the
+    // pending-ACK queue as a reason to attach an ACK frame to the
     // very next outgoing packet. On fast paths that effectively defeated
     // both `kAckThreshold` (RFC 9000 §13.2.2) and `max_ack_delay_` — a
     // single inbound packet would be ACKed immediately by the next
@@ -64,7 +85,7 @@ public:
     //     (threshold / OoO / gap / ECN-CE).
     //   - The max_ack_delay_ timer expired (active_send_cb_ marks the
     //     space as due before re-running the send loop).
-    // Otherwise the ACK keeps aggregating in `wait_ack_packet_numbers_`.
+    // Otherwise the ACK keeps aggregating in `received_ranges_`.
     bool ShouldSendAckNow(PacketNumberSpace ns) const;
 
     // Get largest received packet number for a given packet number space
@@ -81,13 +102,37 @@ public:
     void SetActiveSendCB(std::function<void()> cb) { active_send_cb_ = cb; }
     void UpdateConfig(const TransportParam& tp);
 
+    // Multipath: the receiver of a path other than path 0 acknowledges its
+    // 1-RTT packets with PATH_ACK frames carrying this path id.
+    void SetPathId(uint32_t path_id) { path_id_ = path_id; }
+    uint32_t GetPathId() const { return path_id_; }
+
 private:
     // RFC 9000 Section 13.2.1: Determine if immediate ACK is required
-    bool ShouldSendImmediateAck(PacketNumberSpace ns, uint64_t pkt_num, uint8_t ecn);
+    bool ShouldSendImmediateAck(PacketNumberSpace ns, uint64_t pkt_num, uint64_t prev_largest, uint8_t ecn);
+    // draft-ietf-quic-ack-frequency §6.2: with a reordering threshold above 1,
+    // only a gap that has stayed open for that many packets forces an ACK.
+    bool ReorderingThresholdCrossed(PacketNumberSpace ns, uint64_t prev_largest) const;
+    // Rewrite the cached frame's ranges from received_ranges_[ns].
+    void RebuildAckRanges(PacketNumberSpace ns, AckFrame& frame);
 
     uint64_t pkt_num_largest_recvd_[PacketNumberSpace::kNumberSpaceCount];
     uint64_t largest_recv_time_[PacketNumberSpace::kNumberSpaceCount];
-    std::set<uint64_t> wait_ack_packet_numbers_[PacketNumberSpace::kNumberSpaceCount];
+    // Every ack-eliciting packet number received and not yet known to be
+    // acknowledged by the peer (see OnAckFrameAcked()). ACK frames repeat
+    // these ranges, so a lost ACK costs nothing but the next one's delay.
+    AckRangeSet received_ranges_[PacketNumberSpace::kNumberSpaceCount];
+    // Ack-eliciting packets received since the last ACK frame was generated;
+    // drives the kAckThreshold trigger and HasPendingAck().
+    size_t pending_ack_count_[PacketNumberSpace::kNumberSpaceCount]{0, 0, 0};
+    // The last ACK frame handed out per space. It is reused while nobody
+    // else holds a reference and its ranges are only re-encoded when
+    // received_ranges_ changed, so an ACK for unchanged ranges costs no
+    // allocation and no range walk.
+    std::shared_ptr<AckFrame> cached_ack_frame_[PacketNumberSpace::kNumberSpaceCount];
+    bool ack_ranges_dirty_[PacketNumberSpace::kNumberSpaceCount]{true, true, true};
+    // 0 sends ACK frames, anything else PATH_ACK frames (see SetPathId())
+    uint32_t path_id_{0};
     // ECN counters per PN space
     uint64_t ect0_count_[PacketNumberSpace::kNumberSpaceCount]{0};
     uint64_t ect1_count_[PacketNumberSpace::kNumberSpaceCount]{0};
@@ -101,13 +146,23 @@ private:
     // inside MayGenerateAckFrame() once the ACK is emitted.
     bool ack_due_[PacketNumberSpace::kNumberSpaceCount]{false, false, false};
     std::shared_ptr<common::ITimer> timer_;
-    common::TimerTask timer_task_;
+    common::TimerNode timer_task_;
     std::function<void(PacketNumberSpace)> immediate_ack_cb_;  // Immediate ACK callback
     std::function<void()> active_send_cb_;                     // Delayed ACK callback
 
     uint32_t max_ack_delay_;
     uint32_t ack_delay_exponent_{3};
 
+    // draft-ietf-quic-ack-frequency state. Defaults reproduce the behaviour
+    // without the extension: kAckThreshold packets per ACK and an immediate
+    // ACK on any reordering (threshold 1). A peer's ACK_FREQUENCY frame
+    // replaces them (ack_threshold_ = Ack-Eliciting Threshold + 1).
+    size_t ack_threshold_;
+    uint64_t reordering_threshold_{1};
+    bool ack_frequency_applied_{false};
+    uint64_t ack_frequency_sequence_{0};
+    bool immediate_ack_requested_[PacketNumberSpace::kNumberSpaceCount]{false, false, false};
+
     // Metrics: ACK frequency tracking
     uint64_t ack_count_{0};
     uint64_t last_ack_time_{0};
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <climits>
 
 #include "common/log/log.h"
@@ -12,7 +13,7 @@ namespace quic {
 
 RecvFlowController::RecvFlowController(StreamIDGenerator::StreamStarter local_starter):
     received_bytes_(0),
-    max_data_(0),
+    consumed_bytes_(0),
     max_streams_bidi_(0),
     max_streams_uni_(0),
     max_bidi_stream_id_(0),
@@ -20,59 +21,51 @@ RecvFlowController::RecvFlowController(StreamIDGenerator::StreamStarter local_st
     local_starter_(local_starter) {}
 
 void RecvFlowController::UpdateConfig(const TransportParam& tp) {
-    max_data_ = tp.GetInitialMaxData();
+    window_tuner_.Reset(tp.GetInitialMaxData(), kMaxConnectionWindowSize);
     max_streams_bidi_ = tp.GetInitialMaxStreamsBidi();
     max_streams_uni_ = tp.GetInitialMaxStreamsUni();
 
     LOG_DEBUG("RecvFlowController::UpdateConfig: max_data=%llu, max_streams_bidi=%llu, max_streams_uni=%llu",
-        max_data_, max_streams_bidi_, max_streams_uni_);
+        window_tuner_.GetLimit(), max_streams_bidi_, max_streams_uni_);
 }
 
 bool RecvFlowController::OnDataReceived(uint32_t size) {
     received_bytes_ += size;
     LOG_DEBUG("RecvFlowController::OnDataReceived: received %u bytes, total=%llu, limit=%llu", size,
-        received_bytes_, max_data_);
+        received_bytes_, window_tuner_.GetLimit());
 
     // Check if peer exceeded our limit (protocol violation)
-    if (received_bytes_ > max_data_) {
+    if (received_bytes_ > window_tuner_.GetLimit()) {
         LOG_ERROR(
             "RecvFlowController::OnDataReceived: peer exceeded MAX_DATA limit (received=%llu, limit=%llu)",
-            received_bytes_, max_data_);
+            received_bytes_, window_tuner_.GetLimit());
         return false;
     }
 
     return true;
 }
 
-bool RecvFlowController::ShouldSendMaxData(std::shared_ptr<IFrame>& max_data_frame) {
+void RecvFlowController::OnDataConsumed(uint64_t size) {
+    // never credit bytes that have not arrived
+    consumed_bytes_ = std::min(consumed_bytes_ + size, received_bytes_);
+}
+
+bool RecvFlowController::ShouldSendMaxData(
+    std::shared_ptr<IFrame>& max_data_frame, uint64_t now, uint32_t smoothed_rtt_ms, bool peer_blocked) {
     // Check if peer violated limit
-    if (received_bytes_ > max_data_) {
+    if (received_bytes_ > window_tuner_.GetLimit()) {
         LOG_ERROR("RecvFlowController::ShouldSendMaxData: peer exceeded limit");
         return false;
     }
 
-    // Check if we should increase the limit (peer is near the window)
-    // Use percentage-based threshold: trigger when less than 10% remaining
-    uint64_t remaining = max_data_ - received_bytes_;
-    uint64_t threshold = max_data_ / 10;  // 10% of max_data
-
-    if (remaining <= threshold) {
-        // Increase the limit by doubling the window
-        // BUGFIX P2-3: Guard against uint64_t overflow when doubling
-        uint64_t increase_amount = max_data_;
-        if (max_data_ > UINT64_MAX - increase_amount) {
-            max_data_ = UINT64_MAX;  // Cap at max value instead of wrapping
-        } else {
-            max_data_ += increase_amount;
-        }
-
+    uint64_t new_limit = 0;
+    if (window_tuner_.OnConsumed(consumed_bytes_, now, smoothed_rtt_ms, new_limit, peer_blocked)) {
         auto frame = std::make_shared<MaxDataFrame>();
-        frame->SetMaximumData(max_data_);
+        frame->SetMaximumData(new_limit);
         max_data_frame = frame;
 
-        LOG_DEBUG(
-            "RecvFlowController::ShouldSendMaxData: increasing limit to %llu (remaining was %llu, threshold=%llu)",
-            max_data_, remaining, threshold);
+        LOG_DEBUG("RecvFlowController::ShouldSendMaxData: increasing limit to %llu (consumed=%llu, window=%llu)",
+            new_limit, consumed_bytes_, window_tuner_.GetWindow());
     }
 
     return true;
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <memory>
 
+#include "quic/connection/controler/recv_window_tuner.h"
 #include "quic/connection/transport_param.h"
 #include "quic/frame/if_frame.h"
 #include "quic/stream/stream_id_generator.h"
@@ -22,6 +23,10 @@ namespace quic {
 // 5. Generate MAX_DATA and MAX_STREAMS frames to grant more capacity
 // 6. Validate peer doesn't exceed limits (connection close if violated)
 //
+// MAX_DATA credit follows what the application consumed, not what arrived:
+// the window is auto-tuned by RecvWindowTuner and capped by
+// kMaxConnectionWindowSize, so a slow reader cannot make us buffer more.
+//
 // IMPORTANT: per RFC 9000 §4.6, MAX_STREAMS bounds the streams the *peer* may
 // open, not the streams we open ourselves. To honor that distinction this
 // controller is constructed with the *local* endpoint role; OnStreamCreated
@@ -61,12 +66,22 @@ public:
     // @return true if within limit, false if peer exceeded our MAX_DATA (protocol violation)
     bool OnDataReceived(uint32_t size);
 
+    // Record data the application has read out of stream buffers
+    // Only consumed bytes are credited back to the peer.
+    // @param size Number of bytes consumed
+    void OnDataConsumed(uint64_t size);
+
     // Check if we should send MAX_DATA frame
     // Determines if we should grant peer more send capacity. Returns MAX_DATA
-    // frame if we're near the limit and should increase it.
+    // frame once half of the window has been consumed (or, when the peer said
+    // it is blocked, as soon as anything consumed is still uncredited).
     // @param max_data_frame [out] MAX_DATA frame if we should increase limit, nullptr otherwise
+    // @param now Current time in ms, drives window auto-tuning (0 disables growth)
+    // @param smoothed_rtt_ms Current smoothed RTT (0 disables growth)
+    // @param peer_blocked Peer sent DATA_BLOCKED
     // @return true if peer can continue sending, false if peer violated limit
-    bool ShouldSendMaxData(std::shared_ptr<IFrame>& max_data_frame);
+    bool ShouldSendMaxData(std::shared_ptr<IFrame>& max_data_frame, uint64_t now = 0, uint32_t smoothed_rtt_ms = 0,
+        bool peer_blocked = false);
 
     // Validate and record peer's new stream creation
     // Called when peer creates a new stream (we receive first frame on that stream).
@@ -78,7 +93,11 @@ public:
 
     // Get current maximum data limit we've advertised to peer
     // @return Maximum bytes peer is allowed to send
-    uint64_t GetMaxData() const { return max_data_; }
+    uint64_t GetMaxData() const { return window_tuner_.GetLimit(); }
+
+    // Get current connection-level receive window
+    // @return Credit granted beyond consumed data at the last MAX_DATA
+    uint64_t GetWindow() const { return window_tuner_.GetWindow(); }
 
     // Get current bidirectional stream limit we've advertised
     // @return Maximum bidirectional streams peer can create
@@ -101,8 +120,9 @@ private:
 
 private:
     // Connection-level data flow control
-    uint64_t received_bytes_;  // Total bytes received on connection
-    uint64_t max_data_;        // Maximum bytes peer can send (our limit)
+    uint64_t received_bytes_;       // Total bytes received on connection
+    uint64_t consumed_bytes_;       // Total bytes the application has read
+    RecvWindowTuner window_tuner_;  // Window size and the limit we advertised
 
     // Stream creation limits (our limits for peer)
     uint64_t max_streams_bidi_;  // Maximum bidirectional streams peer can create
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <atomic>
+
+#include "common/log/log.h"
+
+#include "quic/config.h"
+#include "quic/connection/controler/recv_window_tuner.h"
+
+namespace quicx {
+namespace quic {
+
+static std::atomic<uint64_t> global_reserved_{0};
+
+RecvWindowTuner::RecvWindowTuner():
+    initial_window_(0),
+    max_window_(0),
+    window_(0),
+    limit_(0),
+    last_update_time_(0),
+    reserved_(0) {}
+
+RecvWindowTuner::~RecvWindowTuner() {
+    Release();
+}
+
+void RecvWindowTuner::Reset(uint64_t initial_window, uint64_t max_window) {
+    Release();
+    initial_window_ = initial_window;
+    max_window_ = std::max(initial_window, max_window);
+    window_ = initial_window;
+    limit_ = initial_window;
+    last_update_time_ = 0;
+}
+
+bool RecvWindowTuner::OnConsumed(
+    uint64_t consumed, uint64_t now, uint32_t smoothed_rtt_ms, uint64_t& new_limit, bool force) {
+    if (window_ == 0 || consumed > limit_) {
+        return false;
+    }
+
+    uint64_t available = limit_ - consumed;
+    if (available > window_ / 2 && !(force && consumed + window_ > limit_)) {
+        return false;
+    }
+
+    MaybeGrow(now, smoothed_rtt_ms);
+    last_update_time_ = now;
+
+    // a window that outgrew the limit can only move forward
+    new_limit = std::max(limit_, consumed + window_);
+    if (new_limit == limit_) {
+        return false;
+    }
+    LOG_DEBUG("recv window update. consumed:%llu, window:%llu, limit:%llu -> %llu", consumed, window_, limit_,
+        new_limit);
+    limit_ = new_limit;
+    return true;
+}
+
+void RecvWindowTuner::MaybeGrow(uint64_t now, uint32_t smoothed_rtt_ms) {
+    // the first update has nothing to compare against
+    if (last_update_time_ == 0 || smoothed_rtt_ms == 0 || window_ >= max_window_) {
+        return;
+    }
+    if (now - last_update_time_ >= static_cast<uint64_t>(smoothed_rtt_ms) * kWindowAutoTuneRttMultiple) {
+        return;
+    }
+
+    uint64_t grow = std::min(window_, max_window_ - window_);
+    uint64_t reserved = global_reserved_.load(std::memory_order_relaxed);
+    do {
+        if (reserved + grow > kRecvWindowGlobalBudget) {
+            LOG_DEBUG("recv window growth denied, global budget exhausted. window:%llu, reserved:%llu", window_,
+                reserved);
+            return;
+        }
+    } while (!global_reserved_.compare_exchange_weak(reserved, reserved + grow, std::memory_order_relaxed));
+
+    reserved_ += grow;
+    window_ += grow;
+}
+
+void RecvWindowTuner::Release() {
+    if (reserved_ > 0) {
+        global_reserved_.fetch_sub(reserved_, std::memory_order_relaxed);
+        reserved_ = 0;
+    }
+}
+
+uint64_t RecvWindowTuner::GetGlobalReserved() {
+    return global_reserved_.load(std::memory_order_relaxed);
+}
+
+}  // namespace quic
+}  // namespace quicx
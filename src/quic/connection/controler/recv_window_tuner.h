@@ -0,0 +1,59 @@
+#ifndef QUIC_CONNECTION_CONTROLER_RECV_WINDOW_TUNER
+#define QUIC_CONNECTION_CONTROLER_RECV_WINDOW_TUNER
+
+#include <cstdint>
+
+namespace quicx {
+namespace quic {
+
+// RecvWindowTuner sizes one receive window (the connection's MAX_DATA or a
+// stream's MAX_STREAM_DATA) from how fast the application drains it.
+//
+// The window starts at the advertised initial limit. Credit is handed back
+// once half of the window has been consumed; if that happens within
+// kWindowAutoTuneRttMultiple smoothed RTTs of the previous update, the window
+// was what held the sender back, so it doubles. Growth stops at the caller's
+// maximum window and at the process-wide kRecvWindowGlobalBudget, so many
+// connections cannot together pin an unbounded amount of receive memory.
+//
+// Thread safety: a tuner belongs to one connection's loop; only the global
+// budget it draws from is shared.
+class RecvWindowTuner {
+public:
+    RecvWindowTuner();
+    ~RecvWindowTuner();
+
+    // Start over with |initial_window| of credit. The window never grows past
+    // |max_window| (or the initial window, if that is larger).
+    void Reset(uint64_t initial_window, uint64_t max_window);
+
+    // Called with the total number of bytes the application has consumed.
+    // Returns true, with the new limit to advertise, when a credit update is
+    // due: half of the window is gone, or |force| (the peer reported itself
+    // blocked) and anything consumed has not been credited back yet.
+    bool OnConsumed(uint64_t consumed, uint64_t now, uint32_t smoothed_rtt_ms, uint64_t& new_limit, bool force = false);
+
+    uint64_t GetLimit() const { return limit_; }
+    uint64_t GetWindow() const { return window_; }
+
+    // Window growth currently held by all tuners of the process.
+    static uint64_t GetGlobalReserved();
+
+private:
+    void MaybeGrow(uint64_t now, uint32_t smoothed_rtt_ms);
+    void Release();
+
+private:
+    uint64_t initial_window_;
+    uint64_t max_window_;
+    uint64_t window_;
+    uint64_t limit_;
+    uint64_t last_update_time_;
+    // bytes of window_ beyond initial_window_, taken from the global budget
+    uint64_t reserved_;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -12,6 +12,8 @@
 #include "quic/connection/controler/send_control.h"
 #include "quic/connection/util.h"
 #include "quic/frame/ack_frame.h"
+#include "quic/frame/datagram_frame.h"
+#include "quic/frame/path_ack_frame.h"
 
 namespace quicx {
 namespace quic {
@@ -23,25 +25,12 @@ SendControl::SendControl(std::shared_ptr<common::ITimer> timer):
     memset(pkt_num_largest_acked_, 0, sizeof(pkt_num_largest_acked_));
     memset(largest_sent_time_, 0, sizeof(largest_sent_time_));
 
-    // CC algorithm selection: read from config.h constant (kDefaultCongestionControl).
-    // To switch algorithm, modify kDefaultCongestionControl in quic/config.h and rebuild.
-    CongestionControlType cc_type = CongestionControlType::kReno;
-    std::string v(kDefaultCongestionControl);
-    if (v == "cubic") {
-        cc_type = CongestionControlType::kCubic;
-    } else if (v == "bbrv1" || v == "bbr" || v == "bbr1") {
-        cc_type = CongestionControlType::kBbrV1;
-    } else if (v == "bbrv2" || v == "bbr2") {
-        cc_type = CongestionControlType::kBbrV2;
-    } else if (v == "bbrv3" || v == "bbr3") {
-        cc_type = CongestionControlType::kBbrV3;
-    } else if (v == "reno") {
-        cc_type = CongestionControlType::kReno;
-    } else {
-        LOG_WARN("SendControl: unknown CC algorithm \"%s\", falling back to reno", kDefaultCongestionControl);
-    }
-    LOG_INFO("SendControl: using congestion control: %s", v.c_str());
-    congestion_control_ = CreateCongestionControl(cc_type);
+    // Default controller; connections override it from QuicConfig through
+    // SetCongestionControl() before sending anything.
+    congestion_control_ = CreateCongestionControl(CongestionControlType::kCubic);
+
+    loss_timer_.SetTimeoutCallback([this]() { OnLossTimer(); });
+    pto_timer_.SetTimeoutCallback([this]() { OnPTOTimer(); });
 }
 
 void SendControl::OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& packet, uint32_t pkt_len) {
@@ -50,6 +39,11 @@ void SendControl::OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& pac
 
 void SendControl::OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& packet, uint32_t pkt_len,
     const std::vector<StreamDataInfo>& stream_data) {
+    OnPacketSend(now, packet, pkt_len, stream_data, std::vector<std::shared_ptr<IFrame>>());
+}
+
+void SendControl::OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& packet, uint32_t pkt_len,
+    const std::vector<StreamDataInfo>& stream_data, std::vector<std::shared_ptr<IFrame>> control_frames) {
     auto ns = CryptoLevel2PacketNumberSpace(packet->GetCryptoLevel());
     LOG_DEBUG("SendControl::OnPacketSend: packet_number=%llu, ns=%d, frame_type_bit=%u, stream_data count=%zu",
         packet->GetPacketNumber(), ns, packet->GetFrameTypeBit(), stream_data.size());
@@ -63,6 +57,8 @@ void SendControl::OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& pac
     }
     pkt_num_largest_sent_[ns] = packet->GetPacketNumber();
     largest_sent_time_[ns] = common::UTCTimeMsec();
+    packets_sent_++;
+    bytes_sent_ += pkt_len;
 
     // RFC 9002: Only ACK-eliciting packets count towards congestion control
     // ACK-only packets should NOT be accounted in bytes_in_flight
@@ -72,11 +68,50 @@ void SendControl::OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& pac
         return;
     }
 
-    // Count this packet in congestion control (bytes_in_flight)
-    // BUGFIX: CC algorithms (BBR/Cubic) use microsecond-based internal timing.
-    // The system clock (UTCTimeMsec) provides milliseconds; multiply by 1000
-    // so that CC bandwidth/BDP/epoch calculations use the correct time scale.
-    congestion_control_->OnPacketSent(SentPacketEvent{packet->GetPacketNumber(), pkt_len, now * 1000, false});
+    // RFC 9002 §6.2.1: Use PTO with exponential backoff. While the handshake
+    // is unconfirmed the peer's advertised max_ack_delay has not yet been
+    // reliably delivered and MUST be treated as 0 when computing PTO; see
+    // GetEffectiveMaxAckDelay(). The per-packet timeout used to be a
+    // TimerTask per packet; it is now a plain deadline on the record,
+    // serviced by the shared loss timer (see ArmLossTimer()).
+    uint64_t loss_deadline =
+        largest_sent_time_[ns] + rtt_calculator_.GetPTOWithBackoff(GetEffectiveMaxAckDelay());
+    // Application-space packets are tracked by their frame descriptors only
+    // (STREAM ranges + control frames); the IPacket, and with it the
+    // plaintext buffer, is released as soon as the packet is on the wire.
+    // Initial/Handshake packets are still kept for a whole-packet replay.
+    std::shared_ptr<IPacket> replay_packet = packet;
+    if (ns == PacketNumberSpace::kApplicationNumberSpace) {
+        replay_packet.reset();
+    } else {
+        control_frames.clear();
+    }
+    auto record = sent_packets_[ns].Add(packet->GetPacketNumber(), largest_sent_time_[ns], loss_deadline, pkt_len,
+        stream_data, replay_packet, std::move(control_frames));
+    if (!record) {
+        LOG_ERROR("SendControl::OnPacketSend: failed to track packet %llu", packet->GetPacketNumber());
+        return;
+    }
+    record->packet_type = packet->GetHeader()->GetPacketType();
+    if (packet->CarriesAck()) {
+        record->carries_ack = true;
+        record->carried_ack_largest = packet->GetCarriedAckLargest();
+    }
+
+    // RFC 9000 §14.4: a PMTU probe is not counted in bytes_in_flight, and
+    // its ACK or loss is not reported to congestion control either.
+    if (packet->IsMtuProbe()) {
+        record->mtu_probe = true;
+    } else {
+        // Count this packet in congestion control (bytes_in_flight)
+        // BUGFIX: CC algorithms (BBR/Cubic) use microsecond-based internal timing.
+        // The system clock (UTCTimeMsec) provides milliseconds; multiply by 1000
+        // so that CC bandwidth/BDP/epoch calculations use the correct time scale.
+        congestion_control_->OnPacketSent(SentPacketEvent{packet->GetPacketNumber(), pkt_len, now * 1000, false});
+        if (ns == PacketNumberSpace::kApplicationNumberSpace) {
+            careful_resume_.OnPacketSent(packet->GetPacketNumber());
+        }
+    }
 
     // Log packet_sent event to qlog
     if (qlog_trace_) {
@@ -99,63 +134,28 @@ void SendControl::OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& pac
     // Track when we last sent ack-eliciting data for PTO timer
     last_ack_eliciting_sent_time_ = now;
 
-    auto timer_task = common::TimerTask([this, pkt_len, packet, ns] {
-        // NOTE: Do NOT call rtt_calculator_.OnPTOExpired() here.
-        // PTO backoff is managed by the global OnPTOTimer() to avoid
-        // exponential over-counting when multiple packets time out together
-        // (e.g., packets 2-7 all lost → 6 callbacks → pto_count_ jumps to 6).
-
-        // BUGFIX P0-1: Guard against double loss declaration.
-        // If DetectLostPackets() already processed this packet (removed from
-        // unacked_packets_ or marked is_lost), skip all operations to prevent
-        // double-counting in congestion control (bytes_in_flight underflow).
-        auto it = unacked_packets_[ns].find(packet->GetPacketNumber());
-        if (it == unacked_packets_[ns].end() || it->second.is_lost) {
-            return;  // Already handled by DetectLostPackets or a previous timer
-        }
-
-        it->second.is_lost = true;
-        // Carry the stream_data along with the lost packet so that the
-        // retransmitted PN re-inherits the same byte-range tracking when
-        // the connection layer pushes it back through OnPacketSend.
-        lost_packets_.push_back(LostPacketEntry{packet, it->second.stream_data});
-        congestion_control_->OnPacketLost(LossEvent{packet->GetPacketNumber(), pkt_len, common::UTCTimeMsec() * 1000});
-
-        // Metrics: Packet lost
-        common::Metrics::CounterInc(common::MetricsStd::QuicPacketsLost);
-
-        if (packet_lost_cb_) {
-            packet_lost_cb_(packet);
-        }
-    });
-    // RFC 9002 §6.2.1: Use PTO with exponential backoff. While the handshake
-    // is unconfirmed the peer's advertised max_ack_delay has not yet been
-    // reliably delivered and MUST be treated as 0 when computing PTO; see
-    // GetEffectiveMaxAckDelay(). Once the teardown-path UAF in ~SendControl
-    // (per-packet timer_task lambdas that captured `this`) was fixed by
-    // delegating to ClearRetransmissionData(), it is safe to route all four
-    // PTO callsites through the accessor.
-    timer_->AddTimer(timer_task, rtt_calculator_.GetPTOWithBackoff(GetEffectiveMaxAckDelay()));
-    unacked_packets_[ns][packet->GetPacketNumber()] =
-        PacketTimerInfo(largest_sent_time_[ns], pkt_len, timer_task, stream_data, packet);
+    // Deadlines are (almost always) non-decreasing in send order, so the
+    // timer only needs re-arming when nothing is armed yet or this packet's
+    // deadline undercuts the armed one (PTO shrank after an RTT update).
+    if (!loss_timer_armed_ || loss_deadline < loss_timer_deadline_) {
+        ArmLossTimerAt(loss_deadline);
+    }
     LOG_DEBUG(
-        "SendControl::OnPacketSend: saved packet %llu to unacked_packets[%d], stream_data count=%zu, "
-        "unacked_packets[%d] size=%zu",
-        packet->GetPacketNumber(), ns, stream_data.size(), ns, unacked_packets_[ns].size());
+        "SendControl::OnPacketSend: tracked packet %llu in ns=%d, stream_data count=%zu, tracked[%d] size=%zu",
+        packet->GetPacketNumber(), ns, stream_data.size(), ns, sent_packets_[ns].Size());
 
     // RFC 9002: Schedule PTO timer to detect persistent timeouts
-    // Cancel existing timer and reschedule with current PTO value
-    timer_->RemoveTimer(pto_timer_);
-    pto_timer_.SetTimeoutCallback([this]() { OnPTOTimer(); });
+    // Re-arming moves the pending timer to the current PTO value
     uint64_t pto_ms_send = rtt_calculator_.GetPTOWithBackoff(GetEffectiveMaxAckDelay());
-    timer_->AddTimer(pto_timer_, pto_ms_send);
+    timer_->ArmTimer(pto_timer_, pto_ms_send);
     LOG_DEBUG(
-        "SendControl::OnPacketSend: PTO armed, ns=%d pn=%llu pto_ms=%llu unacked[%d]_size=%zu",
-        ns, packet->GetPacketNumber(), pto_ms_send, ns, unacked_packets_[ns].size());
+        "SendControl::OnPacketSend: PTO armed, ns=%d pn=%llu pto_ms=%llu tracked[%d]_size=%zu",
+        ns, packet->GetPacketNumber(), pto_ms_send, ns, sent_packets_[ns].Size());
 }
 
 void SendControl::OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::shared_ptr<IFrame>& frame) {
-    if (frame->GetType() != FrameType::kAck && frame->GetType() != FrameType::kAckEcn) {
+    if (frame->GetType() != FrameType::kAck && frame->GetType() != FrameType::kAckEcn &&
+        !PathAckFrame::IsPathAckFrame(frame->GetType())) {
         LOG_ERROR("invalid frame on packet ack.");
         return;
     }
@@ -218,16 +218,23 @@ void SendControl::OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::sha
         QLOG_EVENT(qlog_trace_, common::QlogEvents::kPacketsAcked, std::move(event_data));
     }
 
+    auto& tracker = sent_packets_[ns];
+    uint32_t ack_delay = ack_frame->GetAckDelay();
     uint64_t pkt_num = ack_frame->GetLargestAck();
+    // CE marks this frame reports beyond the previous one. ACK_ECN carries
+    // only cumulative counts, so they are attributed to the newly acked
+    // packets largest first; the count per frame is exact, which is what a
+    // proportional (L4S) response needs.
+    uint64_t ce_marks = 0;
     if (pkt_num_largest_acked_[ns] < pkt_num) {
         pkt_num_largest_acked_[ns] = pkt_num;
 
-        auto iter = unacked_packets_[ns].find(pkt_num);
-        if (iter != unacked_packets_[ns].end()) {
+        auto record = tracker.Find(pkt_num);
+        if (record) {
             // Scale peer-reported ACK delay by exponent to milliseconds
             uint64_t scaled_ack_delay = ack_frame->GetAckDelay() << ack_delay_exponent_;
             // Update RTT estimate with this ACK
-            if (!rtt_calculator_.UpdateRtt(iter->second.send_time_, now, scaled_ack_delay)) {
+            if (!rtt_calculator_.UpdateRtt(record->send_time, now, scaled_ack_delay)) {
                 LOG_WARN("Failed to update RTT for packet %llu", pkt_num);
             } else {
                 // Metrics: RTT updated
@@ -243,8 +250,7 @@ void SendControl::OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::sha
                 common::Metrics::GaugeSet(common::MetricsStd::AckRangesPerFrame, ack_range_count);
             }
 
-            bool ecn_ce = false;
-            if (frame->GetType() == FrameType::kAckEcn) {
+            if (frame->GetType() == FrameType::kAckEcn || frame->GetType() == FrameType::kPathAckEcn) {
                 auto ack_ecn = std::dynamic_pointer_cast<AckEcnFrame>(frame);
                 if (ack_ecn) {
                     // Validate ECN counters are non-decreasing per RFC (§13.4 of RFC9000)
@@ -261,22 +267,19 @@ void SendControl::OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::sha
                     if (ect0 < prev_ect0 || ect1 < prev_ect1 || ce < prev_ce) {
                         state = EcnState::kFailed;  // disable ECN responses if invalid
                     } else {
+                        ce_marks = ce - prev_ce;
                         prev_ect0 = ect0;
                         prev_ect1 = ect1;
                         prev_ce = ce;
-                        if (ce > 0) ecn_ce = true;
                     }
                 }
             }
 
-            // Cancel the PTO timer since packet is ACKed
-            timer_->RemoveTimer(iter->second.timer_task_);
-
-            // Only notify congestion control if packet wasn't already declared lost
-            if (!iter->second.is_lost) {
-                congestion_control_->OnPacketAcked(
-                    AckEvent{pkt_num, iter->second.pkt_len_, now * 1000, ack_frame->GetAckDelay(), ecn_ce,
-                        iter->second.send_time_ * 1000});
+            // Only the first ACK of a packet that wasn't already declared lost
+            // feeds a round-trip sample to congestion control.
+            bool was_outstanding = !record->IsLost();
+            OnRecordAcked(ns, *record, now, ack_delay, ce_marks);
+            if (was_outstanding) {
                 // BUGFIX: RttCalculator reports in milliseconds, but CC algorithms
                 // (BBR v1/v2/v3) store srtt_us_/min_rtt_us_ in *microseconds*.
                 // Without this ×1000 conversion, BBR's BDP = bw × min_rtt_us / 1e6
@@ -287,79 +290,23 @@ void SendControl::OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::sha
                 uint64_t srtt_us_for_cc = std::max<uint64_t>(1, rtt_calculator_.GetSmoothedRtt()) * 1000;
                 congestion_control_->OnRoundTripSample(srtt_us_for_cc,
                     static_cast<uint64_t>(ack_frame->GetAckDelay()) * 1000);
-
-                // Metrics: Packet acknowledged
-                common::Metrics::CounterInc(common::MetricsStd::QuicPacketsAcked);
-                // Metrics: Packet acknowledged (ACK aggregation ratio = QuicPacketsAcked / DiagAcksReceived)
-                common::Metrics::CounterInc(common::MetricsStd::QuicPacketsAcked);
-            }
-
-            // Notify stream data ACK if callback is set
-            if (stream_data_ack_cb_ && !iter->second.stream_data.empty()) {
-                LOG_DEBUG("SendControl::OnPacketAck: notifying %zu streams for packet %llu",
-                    iter->second.stream_data.size(), pkt_num);
-                for (const auto& stream_info : iter->second.stream_data) {
-                    LOG_DEBUG(
-                        "SendControl::OnPacketAck: calling callback for stream_id=%llu, offset=%llu, len=%llu, "
-                        "has_fin=%d",
-                        stream_info.stream_id, stream_info.offset_start, stream_info.length, stream_info.has_fin);
-                    stream_data_ack_cb_(
-                        stream_info.stream_id, stream_info.offset_start, stream_info.length, stream_info.has_fin);
-                }
+                careful_resume_.OnRoundTripSample(std::max<uint64_t>(1, rtt_calculator_.GetLatestRtt()) * 1000);
             }
-
-            // Remove from unacked_packets now that it's ACKed
-            unacked_packets_[ns].erase(iter);
         }
     }
 
-    // Process first ACK range and notify streams
-    // NOTE: largest_ack (pkt_num) was already processed above for RTT, so skip it
-    // by starting from pkt_num-1
-    for (uint32_t i = 0; i < ack_frame->GetFirstAckRange(); i++) {
-        pkt_num--;  // Move to next packet in range
-        auto task = unacked_packets_[ns].find(pkt_num);
-        if (task != unacked_packets_[ns].end()) {
-            LOG_DEBUG("SendControl::OnPacketAck: found packet %llu, stream_data count=%zu", pkt_num,
-                task->second.stream_data.size());
-            timer_->RemoveTimer(task->second.timer_task_);
-
-            // Notify congestion control to decrement bytes_in_flight
-            if (!task->second.is_lost) {
-                congestion_control_->OnPacketAcked(
-                    AckEvent{pkt_num, task->second.pkt_len_, now * 1000, ack_frame->GetAckDelay(), false,
-                        task->second.send_time_ * 1000});
-
-                // Metrics: Packet acknowledged
-                common::Metrics::CounterInc(common::MetricsStd::QuicPacketsAcked);
-            }
-
-            // Notify stream data ACK if callback is set
-            if (stream_data_ack_cb_ && !task->second.stream_data.empty()) {
-                LOG_DEBUG("SendControl::OnPacketAck: notifying %zu streams for packet %llu",
-                    task->second.stream_data.size(), pkt_num);
-                for (const auto& stream_info : task->second.stream_data) {
-                    LOG_DEBUG(
-                        "SendControl::OnPacketAck: calling callback for stream_id=%llu, offset=%llu, len=%llu, "
-                        "has_fin=%d",
-                        stream_info.stream_id, stream_info.offset_start, stream_info.length, stream_info.has_fin);
-                    stream_data_ack_cb_(
-                        stream_info.stream_id, stream_info.offset_start, stream_info.length, stream_info.has_fin);
-                }
-            } else {
-                LOG_DEBUG("SendControl::OnPacketAck: callback=%d, stream_data.empty()=%d",
-                    stream_data_ack_cb_ ? 1 : 0, task->second.stream_data.empty());
-            }
-
-            // Remove from unacked_packets
-            unacked_packets_[ns].erase(task);
-        } else {
-            LOG_DEBUG("SendControl::OnPacketAck: packet %llu not found in unacked_packets", pkt_num);
-        }
-    }
+    // Walk the first ACK range and every additional range, largest packet
+    // number first. Each range is clamped to the tracker's window, so a wide
+    // cumulative range over long-gone packets costs nothing, and every lookup
+    // inside the window is a direct slot access.
+    uint64_t first_range = ack_frame->GetFirstAckRange();
+    uint64_t range_low = pkt_num >= first_range ? pkt_num - first_range : 0;
+    tracker.ReverseForEachInRange(range_low, pkt_num, [&](SentPacketRecord& record) {
+        OnRecordAcked(ns, record, now, ack_delay, ce_marks);
+    });
 
     // Process additional ACK ranges
-    auto ranges = ack_frame->GetAckRange();
+    const auto& ranges = ack_frame->GetAckRange();
     for (auto iter = ranges.begin(); iter != ranges.end(); iter++) {
         // RFC 9000 §19.3.1: each Gap field is encoded as one less than the
         // actual number of unacknowledged packets between the previous range
@@ -370,45 +317,24 @@ void SendControl::OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::sha
         // (gap_value + 1), landing one PN too high. With gap_value=0 this
         // ACKed the immediately-preceding PN (which is supposed to be in the
         // gap) instead of the actual range start, leaving a real-data PN
-        // orphaned in unacked_packets_ until packet-threshold or PTO declared
-        // it lost. That stalled SendStream byte-range bookkeeping (FIN was
-        // never recognised as ACKed) and produced the cwnd-stuck-at-1..31B
-        // fingerprint observed in interop transfer-loss runs.
-        pkt_num = pkt_num - iter->GetGap() - 2;
-        for (uint32_t i = 0; i <= iter->GetAckRangeLength(); i++) {
-            auto task = unacked_packets_[ns].find(pkt_num);
-            if (task != unacked_packets_[ns].end()) {
-                timer_->RemoveTimer(task->second.timer_task_);
-
-                // Notify congestion control to decrement bytes_in_flight
-                // BUG FIX: Was missing this call, causing bytes_in_flight to leak
-                if (!task->second.is_lost) {
-                    congestion_control_->OnPacketAcked(
-                        AckEvent{pkt_num, task->second.pkt_len_, now * 1000, ack_frame->GetAckDelay(), false,
-                            task->second.send_time_ * 1000});
-
-                    // Metrics: Packet acknowledged
-                    common::Metrics::CounterInc(common::MetricsStd::QuicPacketsAcked);
-                }
-
-                // Notify stream data ACK if callback is set
-                if (stream_data_ack_cb_ && !task->second.stream_data.empty()) {
-                    for (const auto& stream_info : task->second.stream_data) {
-                        stream_data_ack_cb_(stream_info.stream_id, stream_info.offset_start, stream_info.length,
-                            stream_info.has_fin);
-                    }
-                }
-
-                // Remove from unacked_packets
-                unacked_packets_[ns].erase(task);
-            }
-            // BUGFIX P2-1: Only decrement pkt_num within the range, not after the last packet.
-            // The extra decrement caused off-by-one for subsequent additional ranges:
-            // next range would start at (lowest-1) instead of lowest.
-            if (i < iter->GetAckRangeLength()) {
-                pkt_num--;
-            }
+        // orphaned in the sent-packet tracker until packet-threshold or PTO
+        // declared it lost. That stalled SendStream byte-range bookkeeping
+        // (FIN was never recognised as ACKed) and produced the
+        // cwnd-stuck-at-1..31B fingerprint observed in interop transfer-loss
+        // runs.
+        if (range_low < iter->GetGap() + 2) {
+            LOG_WARN("SendControl::OnPacketAck: ACK range underflows packet number 0, ignoring the rest");
+            break;
+        }
+        uint64_t range_high = range_low - iter->GetGap() - 2;
+        if (range_high < iter->GetAckRangeLength()) {
+            LOG_WARN("SendControl::OnPacketAck: ACK range underflows packet number 0, ignoring the rest");
+            break;
         }
+        range_low = range_high - iter->GetAckRangeLength();
+        tracker.ReverseForEachInRange(range_low, range_high, [&](SentPacketRecord& record) {
+            OnRecordAcked(ns, record, now, ack_delay, ce_marks);
+        });
     }
 
     // RFC 9002 Section 6.1: Detect lost packets based on packet/time threshold
@@ -418,7 +344,7 @@ void SendControl::OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::sha
     rtt_calculator_.OnPacketAcked();
 
     // Cancel PTO timer since we received an ACK; we'll re-arm below if needed.
-    timer_->RemoveTimer(pto_timer_);
+    timer_->DisarmTimer(pto_timer_);
 
     // RFC 9002 §6.2.1 (Bug #18 fix):
     //   "A sender SHOULD restart its PTO timer every time an ack-eliciting
@@ -437,12 +363,12 @@ void SendControl::OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::sha
     // fires → 8s idle timeout (Bug #18, fixed).
     //
     // Correct behaviour: re-arm PTO whenever any ack-eliciting packet remains
-    // in flight in any packet number space.  unacked_packets_[] only contains
-    // ack-eliciting packets (see OnPacketSend line ~48 where ACK-only packets
+    // in flight in any packet number space.  sent_packets_[] only tracks
+    // ack-eliciting packets (see OnPacketSend where ACK-only packets
     // early-return before insertion), so emptiness is a sufficient test.
     bool has_ack_eliciting_in_flight = false;
     for (int s = 0; s < PacketNumberSpace::kNumberSpaceCount; s++) {
-        if (!unacked_packets_[s].empty()) {
+        if (!sent_packets_[s].Empty()) {
             has_ack_eliciting_in_flight = true;
             break;
         }
@@ -451,35 +377,76 @@ void SendControl::OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::sha
     if (has_ack_eliciting_in_flight) {
         // Re-arm with the freshly-reset backoff (OnPacketAcked above zeroed
         // pto_count_, so this is a non-backed-off PTO based on latest RTT).
-        pto_timer_.SetTimeoutCallback([this]() { OnPTOTimer(); });
         uint64_t pto_ms_ack = rtt_calculator_.GetPTOWithBackoff(GetEffectiveMaxAckDelay());
-        timer_->AddTimer(pto_timer_, pto_ms_ack);
+        timer_->ArmTimer(pto_timer_, pto_ms_ack);
         LOG_DEBUG(
-            "SendControl::OnPacketAck: PTO re-armed (in-flight), pto_ms=%llu unacked[0/1/2]={%zu,%zu,%zu}",
-            pto_ms_ack, unacked_packets_[0].size(), unacked_packets_[1].size(), unacked_packets_[2].size());
+            "SendControl::OnPacketAck: PTO re-armed (in-flight), pto_ms=%llu tracked[0/1/2]={%zu,%zu,%zu}",
+            pto_ms_ack, sent_packets_[0].Size(), sent_packets_[1].Size(), sent_packets_[2].Size());
     } else if (!handshake_complete_) {
         // RFC 9002 §6.2.2.1: During handshake, keep PTO timer alive even when
         // there is no ack-eliciting data in flight, so the client sends PING
         // probes if the handshake stalls (e.g. server anti-amplification
         // limited).  probe_needed_cb_ is the PING-injection path.
-        pto_timer_.SetTimeoutCallback([this]() { OnPTOTimer(); });
         // RFC 9002 §6.2.1: pre-handshake path → GetEffectiveMaxAckDelay() returns 0.
         uint64_t pto_ms_hs = rtt_calculator_.GetPTOWithBackoff(GetEffectiveMaxAckDelay());
-        timer_->AddTimer(pto_timer_, pto_ms_hs);
+        timer_->ArmTimer(pto_timer_, pto_ms_hs);
         LOG_DEBUG("SendControl::OnPacketAck: PTO armed (pre-handshake), pto_ms=%llu", pto_ms_hs);
     } else {
         LOG_DEBUG(
-            "SendControl::OnPacketAck: PTO LEFT CANCELLED (handshake done, nothing in-flight) unacked[0/1/2]={%zu,%zu,%zu}",
-            unacked_packets_[0].size(), unacked_packets_[1].size(), unacked_packets_[2].size());
+            "SendControl::OnPacketAck: PTO LEFT CANCELLED (handshake done, nothing in-flight) tracked[0/1/2]={%zu,%zu,%zu}",
+            sent_packets_[0].Size(), sent_packets_[1].Size(), sent_packets_[2].Size());
     }
     // else: handshake done AND nothing ack-eliciting in flight → PTO not
     // needed per RFC 9002 §6.2.1; leave it cancelled.
 
+    // The oldest outstanding packets may have been acked or declared lost;
+    // move the loss timer to the next earliest deadline (or cancel it).
+    ArmLossTimer();
+
     // Log recovery metrics with sampling
     LogRecoveryMetricsIfChanged(now);
 
-    LOG_DEBUG("SendControl::OnPacketAck: completed for ns=%d, unacked_packets[%d] size=%zu", ns, ns,
-        unacked_packets_[ns].size());
+    LOG_DEBUG("SendControl::OnPacketAck: completed for ns=%d, tracked[%d] size=%zu", ns, ns,
+        sent_packets_[ns].Size());
+}
+
+void SendControl::FillStats(QuicConnectionStats& stats) {
+    stats.smoothed_rtt_ms_ = rtt_calculator_.GetSmoothedRtt();
+    stats.min_rtt_ms_ = rtt_calculator_.GetMinRtt();
+    stats.latest_rtt_ms_ = rtt_calculator_.GetLatestRtt();
+    stats.rtt_var_ms_ = rtt_calculator_.GetRttVar();
+    stats.cwnd_bytes_ = congestion_control_->GetCongestionWindow();
+    stats.bytes_in_flight_ = congestion_control_->GetBytesInFlight();
+    stats.pacing_rate_bytes_per_sec_ = congestion_control_->GetPacingRateBytesPerSec();
+    stats.delivery_rate_bytes_per_sec_ = careful_resume_.GetDeliveryRate();
+    stats.bandwidth_estimate_bytes_per_sec_ = GetBandwidthEstimate();
+    stats.packets_sent_ = packets_sent_;
+    stats.bytes_sent_ = bytes_sent_;
+    stats.packets_lost_ = packets_lost_;
+    stats.bytes_lost_ = bytes_lost_;
+    stats.packets_retransmitted_ = packets_retransmitted_;
+    stats.pto_count_ = pto_count_;
+}
+
+uint64_t SendControl::GetBandwidthEstimate() {
+    uint64_t estimate = congestion_control_->GetBandwidthEstimate();
+    if (estimate > 0) {
+        return estimate;
+    }
+    uint32_t srtt = rtt_calculator_.GetSmoothedRtt();
+    if (srtt == 0 || rtt_calculator_.GetLatestRtt() == 0) {
+        return 0;
+    }
+    return congestion_control_->GetCongestionWindow() * 1000 / srtt;
+}
+
+uint8_t SendControl::GetEcnCodepoint() const {
+    for (int ns = 0; ns < PacketNumberSpace::kNumberSpaceCount; ns++) {
+        if (ecn_state_[ns] == EcnState::kFailed) {
+            return 0x00;  // Not-ECT
+        }
+    }
+    return congestion_control_->UsesL4sEcn() ? 0x01 /* ECT(1) */ : 0x02 /* ECT(0) */;
 }
 
 void SendControl::CanSend(uint64_t now, uint64_t& can_send_bytes) {
@@ -493,24 +460,54 @@ void SendControl::UpdateConfig(const TransportParam& tp) {
 
 void SendControl::ClearRetransmissionData() {
     LOG_DEBUG(
-        "SendControl::ClearRetransmissionData: clearing, unacked[0/1/2]={%zu,%zu,%zu}",
-        unacked_packets_[0].size(), unacked_packets_[1].size(), unacked_packets_[2].size());
+        "SendControl::ClearRetransmissionData: clearing, tracked[0/1/2]={%zu,%zu,%zu}",
+        sent_packets_[0].Size(), sent_packets_[1].Size(), sent_packets_[2].Size());
     lost_packets_.clear();
+    lost_stream_data_.clear();
+    lost_frames_.clear();
+    lost_datagrams_.clear();
+    lost_packet_numbers_.clear();
+    cc_acked_events_.clear();
+    cc_lost_events_.clear();
     for (int i = 0; i < PacketNumberSpace::kNumberSpaceCount; i++) {
-        for (auto& pair : unacked_packets_[i]) {
-            timer_->RemoveTimer(pair.second.timer_task_);
-        }
-        unacked_packets_[i].clear();
+        sent_packets_[i].Clear();
+    }
+    if (loss_timer_armed_) {
+        timer_->DisarmTimer(loss_timer_);
+        loss_timer_armed_ = false;
     }
 }
 
+void SendControl::InheritFrom(const SendControl& primary) {
+    stream_data_ack_cb_ = primary.stream_data_ack_cb_;
+    stream_data_lost_cb_ = primary.stream_data_lost_cb_;
+    frame_lost_cb_ = primary.frame_lost_cb_;
+    packet_lost_cb_ = primary.packet_lost_cb_;
+    datagram_outcome_cb_ = primary.datagram_outcome_cb_;
+    max_ack_delay_ = primary.max_ack_delay_;
+    ack_delay_exponent_ = primary.ack_delay_exponent_;
+    handshake_complete_ = primary.handshake_complete_;
+}
+
+void SendControl::DeclareInFlightLost(PacketNumberSpace ns) {
+    uint64_t now_us = common::UTCTimeMsec() * 1000;
+    sent_packets_[ns].ForEach([this, ns, now_us](SentPacketRecord& record) {
+        if (record.state == SentPacketRecord::State::kOutstanding) {
+            MarkRecordLost(ns, record, now_us);
+        }
+    });
+    sent_packets_[ns].Clear();
+    DeliverCongestionEvent(now_us);
+    ArmLossTimer();
+    timer_->DisarmTimer(pto_timer_);
+    DispatchLostData();
+}
+
 // RFC 9000 Section 4.10: Discard packet number space state
 void SendControl::DiscardPacketNumberSpace(PacketNumberSpace ns) {
-    // Clear unacked packets for this space
-    for (auto& pair : unacked_packets_[ns]) {
-        timer_->RemoveTimer(pair.second.timer_task_);
-    }
-    unacked_packets_[ns].clear();
+    // Clear tracked packets for this space
+    sent_packets_[ns].Clear();
+    ArmLossTimer();
 
     // Remove any lost packets from this space
     for (auto it = lost_packets_.begin(); it != lost_packets_.end();) {
@@ -531,11 +528,9 @@ void SendControl::DiscardPacketNumberSpace(PacketNumberSpace ns) {
 void SendControl::ResetInitialPacketNumber() {
     PacketNumberSpace ns = PacketNumberSpace::kInitialNumberSpace;
 
-    // Clear unacked packets for Initial space
-    for (auto& pair : unacked_packets_[ns]) {
-        timer_->RemoveTimer(pair.second.timer_task_);
-    }
-    unacked_packets_[ns].clear();
+    // Clear tracked packets for Initial space
+    sent_packets_[ns].Clear();
+    ArmLossTimer();
 
     // Remove any lost packets from Initial space
     for (auto it = lost_packets_.begin(); it != lost_packets_.end();) {
@@ -552,134 +547,377 @@ void SendControl::ResetInitialPacketNumber() {
     LOG_INFO("SendControl: Reset Initial packet state for Retry (PN not reset)");
 }
 
+void SendControl::OnRecordAcked(
+    PacketNumberSpace ns, SentPacketRecord& record, uint64_t now, uint32_t ack_delay, uint64_t& ce_marks) {
+    auto& tracker = sent_packets_[ns];
+    uint64_t pkt_num = record.packet_number;
+
+    // Only notify congestion control if packet wasn't already declared lost.
+    // The event is queued and handed over with the rest of this ACK frame by
+    // DeliverCongestionEvent().
+    if (!record.IsLost() && !record.mtu_probe) {
+        bool ecn_ce = ce_marks > 0;
+        if (ecn_ce) {
+            --ce_marks;
+        }
+        cc_acked_events_.push_back(
+            AckEvent{pkt_num, record.pkt_len, now * 1000, ack_delay, ecn_ce, record.send_time * 1000});
+
+        // Metrics: Packet acknowledged (ACK aggregation ratio = QuicPacketsAcked / DiagAcksReceived)
+        common::Metrics::CounterInc(common::MetricsStd::QuicPacketsAcked);
+    }
+
+    // Copy the stream ranges out and release the record before running the
+    // callbacks: they may re-enter SendControl (e.g. a stream finishing and
+    // the connection sending immediately), which can grow the rings.
+    acked_stream_data_.clear();
+    if (stream_data_ack_cb_) {
+        tracker.ForEachStreamData(record, [this](const StreamDataInfo& info) { acked_stream_data_.push_back(info); });
+    }
+    acked_datagrams_.clear();
+    if (datagram_outcome_cb_ && tracker.ControlFrameCount(record) > 0) {
+        for (auto& frame : tracker.TakeControlFrames(record)) {
+            if (DatagramFrame::IsDatagramFrame(frame->GetType())) {
+                acked_datagrams_.push_back(std::static_pointer_cast<DatagramFrame>(frame)->GetDatagramId());
+            }
+        }
+    }
+    bool carries_ack = record.carries_ack;
+    uint64_t carried_ack_largest = record.carried_ack_largest;
+    uint32_t pkt_len = record.pkt_len;
+    bool mtu_probe = record.mtu_probe;
+    tracker.Remove(&record);
+
+    if (ns == PacketNumberSpace::kApplicationNumberSpace && packet_outcome_cb_) {
+        packet_outcome_cb_(pkt_num, pkt_len, mtu_probe, true);
+    }
+
+    // RFC 9000 §13.2.4: the peer has seen the ACK frame this packet carried.
+    if (carries_ack && ack_frame_acked_cb_) {
+        ack_frame_acked_cb_(ns, carried_ack_largest);
+    }
+
+    if (!acked_datagrams_.empty()) {
+        std::vector<uint64_t> acked;
+        acked.swap(acked_datagrams_);
+        for (uint64_t id : acked) {
+            datagram_outcome_cb_(id, true);
+        }
+        acked.clear();
+        if (acked_datagrams_.capacity() < acked.capacity()) {
+            acked_datagrams_.swap(acked);
+        }
+    }
+
+    if (!acked_stream_data_.empty()) {
+        LOG_DEBUG("SendControl::OnPacketAck: notifying %zu streams for packet %llu", acked_stream_data_.size(),
+            pkt_num);
+        // Swap into a local so a reentrant OnPacketAck cannot clobber the
+        // list we are iterating.
+        std::vector<StreamDataInfo> acked;
+        acked.swap(acked_stream_data_);
+        for (const auto& stream_info : acked) {
+            LOG_DEBUG(
+                "SendControl::OnPacketAck: calling callback for stream_id=%llu, offset=%llu, len=%llu, has_fin=%d",
+                stream_info.stream_id, stream_info.offset_start, stream_info.length, stream_info.has_fin);
+            stream_data_ack_cb_(
+                stream_info.stream_id, stream_info.offset_start, stream_info.length, stream_info.has_fin);
+        }
+        // Hand the buffer back so its capacity is reused next time.
+        acked.clear();
+        if (acked_stream_data_.capacity() < acked.capacity()) {
+            acked_stream_data_.swap(acked);
+        }
+    }
+}
+
+void SendControl::MarkRecordLost(PacketNumberSpace ns, SentPacketRecord& record, uint64_t now_us) {
+    auto& tracker = sent_packets_[ns];
+    uint64_t pkt_num = record.packet_number;
+    uint32_t pkt_len = record.pkt_len;
+    const std::shared_ptr<IPacket>& packet = tracker.GetPacket(record);
+    size_t queued_before = lost_stream_data_.size() + lost_frames_.size();
+
+    if (packet) {
+        // Initial/Handshake: add to lost_packets_ list for a whole-packet
+        // replay, carrying the original packet's stream_data so the
+        // retransmitted PN can re-register the same byte-range tracking.
+        lost_packets_.push_back(LostPacketEntry{packet, tracker.CopyStreamData(record)});
+    } else {
+        // Application space: collect the frame descriptors. The streams
+        // decide what is still worth resending (data acked by a later packet
+        // or belonging to a reset stream is dropped), and the new packets
+        // are built with the current MTU, CID and key phase.
+        tracker.ForEachStreamData(record, [this](const StreamDataInfo& info) { lost_stream_data_.push_back(info); });
+        auto frames = tracker.TakeControlFrames(record);
+        for (auto& frame : frames) {
+            // DATAGRAM frames are unreliable: report them, never resend.
+            if (DatagramFrame::IsDatagramFrame(frame->GetType())) {
+                lost_datagrams_.push_back(std::static_pointer_cast<DatagramFrame>(frame)->GetDatagramId());
+                continue;
+            }
+            lost_frames_.push_back(std::move(frame));
+        }
+    }
+    lost_packet_numbers_.emplace_back(ns, pkt_num);
+
+    // A lost PMTU probe only says the path is narrower, it is not counted
+    if (!record.mtu_probe) {
+        packets_lost_++;
+        bytes_lost_ += pkt_len;
+        if (packet || lost_stream_data_.size() + lost_frames_.size() > queued_before) {
+            packets_retransmitted_++;
+        }
+    }
+
+    // A timed-out packet stays tracked as kLost so that a late ACK still
+    // reaches the streams; one declared lost by ACK-based detection is
+    // dropped right away (the retransmission carries its data).
+    record.state = SentPacketRecord::State::kLost;
+
+    if (ns == PacketNumberSpace::kApplicationNumberSpace && packet_outcome_cb_) {
+        packet_outcome_cb_(pkt_num, pkt_len, record.mtu_probe, false);
+    }
+    // Notify congestion control (batched, see DeliverCongestionEvent())
+    if (!record.mtu_probe) {
+        cc_lost_events_.push_back(LossEvent{pkt_num, pkt_len, now_us});
+    }
+
+    // Metrics: Packet lost
+    common::Metrics::CounterInc(common::MetricsStd::QuicPacketsLost);
+}
+
+void SendControl::DeliverCongestionEvent(uint64_t now_us) {
+    if (cc_acked_events_.empty() && cc_lost_events_.empty()) {
+        return;
+    }
+    // Swap into locals: the controller must see a stable batch even if
+    // something below re-enters SendControl.
+    std::vector<AckEvent> acked;
+    std::vector<LossEvent> lost;
+    acked.swap(cc_acked_events_);
+    lost.swap(cc_lost_events_);
+
+    congestion_control_->OnCongestionEvent(acked, lost, congestion_control_->GetBytesInFlight(), now_us);
+    // Initial/Handshake packet numbers live in their own spaces; Careful
+    // Resume only follows the application space.
+    if (handshake_complete_) {
+        careful_resume_.OnCongestionEvent(acked, lost, now_us, *congestion_control_);
+    }
+
+    // Hand the buffers back so their capacity is reused next time.
+    acked.clear();
+    lost.clear();
+    if (cc_acked_events_.capacity() < acked.capacity()) {
+        cc_acked_events_.swap(acked);
+    }
+    if (cc_lost_events_.capacity() < lost.capacity()) {
+        cc_lost_events_.swap(lost);
+    }
+}
+
+void SendControl::DispatchLostData() {
+    if (lost_packet_numbers_.empty()) {
+        return;
+    }
+    // Swap into locals so a reentrant loss pass cannot clobber the lists we
+    // are iterating.
+    std::vector<StreamDataInfo> stream_data;
+    std::vector<std::shared_ptr<IFrame>> frames;
+    std::vector<uint64_t> datagrams;
+    std::vector<std::pair<PacketNumberSpace, uint64_t>> packet_numbers;
+    stream_data.swap(lost_stream_data_);
+    frames.swap(lost_frames_);
+    datagrams.swap(lost_datagrams_);
+    packet_numbers.swap(lost_packet_numbers_);
+
+    if (stream_data_lost_cb_) {
+        for (const auto& info : stream_data) {
+            stream_data_lost_cb_(info.stream_id, info.offset_start, info.length, info.has_fin);
+        }
+    }
+    if (frame_lost_cb_) {
+        for (auto& frame : frames) {
+            frame_lost_cb_(std::move(frame));
+        }
+    }
+    if (datagram_outcome_cb_) {
+        for (uint64_t id : datagrams) {
+            datagram_outcome_cb_(id, false);
+        }
+    }
+    if (packet_lost_cb_) {
+        for (const auto& lost : packet_numbers) {
+            packet_lost_cb_(lost.first, lost.second);
+        }
+    }
+
+    // Hand the stream-data buffer back so its capacity is reused next time.
+    stream_data.clear();
+    if (lost_stream_data_.capacity() < stream_data.capacity()) {
+        lost_stream_data_.swap(stream_data);
+    }
+}
+
 // RFC 9002 Section 6.1: Detect lost packets based on packet/time threshold
 void SendControl::DetectLostPackets(uint64_t now, PacketNumberSpace ns, uint64_t largest_acked) {
+    auto& tracker = sent_packets_[ns];
+    if (tracker.Empty() || largest_acked == 0) {
+        DeliverCongestionEvent(now * 1000);
+        LogRecoveryMetricsIfChanged(now);
+        return;
+    }
+
     // RFC 9002 Section 6.1.2: Time threshold = 9/8 * smoothed_RTT
     uint64_t loss_delay = (rtt_calculator_.GetSmoothedRtt() * kTimeThresholdNum) / kTimeThresholdDen;
     loss_delay = std::max(loss_delay, uint64_t(1));  // At least 1ms
 
     // Find send time of largest_acked packet for time threshold calculation
     uint64_t largest_acked_send_time = 0;
-    auto largest_iter = unacked_packets_[ns].find(largest_acked);
-    if (largest_iter != unacked_packets_[ns].end()) {
-        largest_acked_send_time = largest_iter->second.send_time_;
+    auto largest_record = tracker.Find(largest_acked);
+    if (largest_record) {
+        largest_acked_send_time = largest_record->send_time;
     }
 
-    // Check all unacked packets with pkt_num < largest_acked
-    std::vector<uint64_t> lost_packet_nums;
-    for (auto& pair : unacked_packets_[ns]) {
-        uint64_t pkt_num = pair.first;
-        auto& info = pair.second;
-
-        if (pkt_num >= largest_acked) continue;  // Skip packets >= largest_acked
-        if (info.is_lost) continue;              // Already marked as lost
-
-        bool should_declare_lost = false;
+    // Walk packets with pkt_num < largest_acked. The window is ordered by
+    // packet number, so this is a single linear pass over the ring.
+    size_t lost_count = 0;
+    tracker.ForEachInRange(tracker.SmallestPacketNumber(), largest_acked - 1, [&](SentPacketRecord& record) {
+        uint64_t pkt_num = record.packet_number;
 
         // RFC 9002 Section 6.1.1: Packet threshold
         // Declare lost if kPacketThreshold (3) packets with higher numbers are acknowledged
-        if (largest_acked >= pkt_num + kPacketThreshold) {
-            should_declare_lost = true;
-            LOG_DEBUG(
-                "DetectLostPackets: packet %llu lost by packet threshold (largest_acked=%llu, threshold=%u)", pkt_num,
-                largest_acked, kPacketThreshold);
-        }
+        bool by_packet_threshold = largest_acked >= pkt_num + kPacketThreshold;
 
         // RFC 9002 Section 6.1.2: Time threshold
         // Declare lost if sent more than loss_delay before largest_acked
-        if (!should_declare_lost && largest_acked_send_time > 0) {
+        bool by_time_threshold = false;
+        if (!by_packet_threshold && largest_acked_send_time > 0) {
             uint64_t time_since_sent =
-                (largest_acked_send_time > info.send_time_) ? (largest_acked_send_time - info.send_time_) : 0;
-            if (time_since_sent > loss_delay) {
-                should_declare_lost = true;
-                LOG_DEBUG(
-                    "DetectLostPackets: packet %llu lost by time threshold (time_since_sent=%llums, loss_delay=%llums)",
-                    pkt_num, time_since_sent, loss_delay);
-            }
+                (largest_acked_send_time > record.send_time) ? (largest_acked_send_time - record.send_time) : 0;
+            by_time_threshold = time_since_sent > loss_delay;
         }
 
-        if (should_declare_lost) {
-            lost_packet_nums.push_back(pkt_num);
+        if (!by_packet_threshold && !by_time_threshold) {
+            return;
         }
-    }
-
-    // Mark packets as lost and trigger retransmission
-    for (uint64_t pkt_num : lost_packet_nums) {
-        auto it = unacked_packets_[ns].find(pkt_num);
-        if (it != unacked_packets_[ns].end()) {
-            timer_->RemoveTimer(it->second.timer_task_);  // Cancel PTO timer
 
-            // Add to lost_packets_ list for retransmission, carrying the
-            // original packet's stream_data so the retransmitted PN can
-            // re-register the same byte-range tracking with SendStream.
-            if (it->second.packet) {
-                lost_packets_.push_back(LostPacketEntry{it->second.packet, it->second.stream_data});
-            }
+        if (record.IsLost()) {
+            // Already retransmitted after a timeout; once the threshold is
+            // met a late ACK is no longer expected, so stop tracking it.
+            tracker.Remove(&record);
+            return;
+        }
 
-            // Notify congestion control
-            congestion_control_->OnPacketLost(LossEvent{pkt_num, it->second.pkt_len_, now * 1000});
+        if (by_packet_threshold) {
+            LOG_DEBUG("DetectLostPackets: packet %llu lost by packet threshold (largest_acked=%llu, threshold=%u)",
+                pkt_num, largest_acked, kPacketThreshold);
+        } else {
+            LOG_DEBUG("DetectLostPackets: packet %llu lost by time threshold (loss_delay=%llums)", pkt_num,
+                loss_delay);
+        }
 
-            // Metrics: Packet lost
-            common::Metrics::CounterInc(common::MetricsStd::QuicPacketsLost);
+        // Log packet_lost event to qlog
+        if (qlog_trace_) {
+            common::MarkedForRetransmitData retransmit_data;
+            retransmit_data.packet_number = pkt_num;
+            retransmit_data.trigger = "loss_detected";
+            QLOG_MARKED_FOR_RETRANSMIT(qlog_trace_, retransmit_data);
+
+            common::PacketLostData data;
+            data.packet_number = pkt_num;
+            data.packet_type = record.packet_type;
+            data.trigger = by_packet_threshold ? "packet_threshold" : "time_threshold";
+            QLOG_PACKET_LOST(qlog_trace_, data);
+        }
 
-            // Trigger retransmission callback
-            if (packet_lost_cb_ && it->second.packet) {
-                packet_lost_cb_(it->second.packet);
-            }
+        MarkRecordLost(ns, record, now * 1000);
+        LOG_WARN("DetectLostPackets: declared packet %llu lost, triggering retransmission", pkt_num);
 
-            LOG_WARN("DetectLostPackets: declared packet %llu lost, triggering retransmission", pkt_num);
+        // BUGFIX: Remove the lost packet from the tracker to prevent memory leak
+        // The retransmitted packet will be added with a new packet number
+        tracker.Remove(&record);
+        lost_count++;
+    });
 
-            // Log marked_for_retransmit event
-            if (qlog_trace_) {
-                common::MarkedForRetransmitData retransmit_data;
-                retransmit_data.packet_number = pkt_num;
-                retransmit_data.trigger = "loss_detected";
-                QLOG_MARKED_FOR_RETRANSMIT(qlog_trace_, retransmit_data);
-            }
+    if (lost_count > 0) {
+        LOG_INFO("DetectLostPackets: detected %zu lost packets in ns=%d", lost_count, ns);
+    }
+    // RFC 9002 Appendix A.7: congestion control sees this ACK frame's
+    // acknowledgements and the losses it revealed as one event.
+    DeliverCongestionEvent(now * 1000);
+    DispatchLostData();
 
-            // Log packet_lost event to qlog
-            if (qlog_trace_ && it->second.packet) {
-                common::PacketLostData data;
-                data.packet_number = pkt_num;
-                data.packet_type = it->second.packet->GetHeader()->GetPacketType();
-
-                // Determine trigger reason by re-checking conditions
-                if (largest_acked >= pkt_num + kPacketThreshold) {
-                    data.trigger = "packet_threshold";
-                } else if (largest_acked_send_time > 0 &&
-                           (largest_acked_send_time - it->second.send_time_) > loss_delay) {
-                    data.trigger = "time_threshold";
-                } else {
-                    data.trigger = "pto_expired";  // Fallback
-                }
+    // Log recovery metrics with sampling
+    LogRecoveryMetricsIfChanged(now);
+}
 
-                QLOG_PACKET_LOST(qlog_trace_, data);
-            }
+void SendControl::ArmLossTimer() {
+    uint64_t deadline = 0;
+    bool found = false;
+    for (int ns = 0; ns < PacketNumberSpace::kNumberSpaceCount; ns++) {
+        auto record = sent_packets_[ns].OldestOutstanding();
+        if (record && (!found || record->loss_deadline < deadline)) {
+            deadline = record->loss_deadline;
+            found = true;
+        }
+    }
 
-            // BUGFIX: Remove the lost packet from unacked_packets to prevent memory leak
-            // The retransmitted packet will be added with a new packet number
-            unacked_packets_[ns].erase(it);
+    if (!found) {
+        if (loss_timer_armed_) {
+            timer_->DisarmTimer(loss_timer_);
+            loss_timer_armed_ = false;
         }
+        return;
     }
+    if (loss_timer_armed_ && deadline == loss_timer_deadline_) {
+        return;
+    }
+    ArmLossTimerAt(deadline);
+}
 
-    if (!lost_packet_nums.empty()) {
-        LOG_INFO("DetectLostPackets: detected %zu lost packets in ns=%d", lost_packet_nums.size(), ns);
+void SendControl::ArmLossTimerAt(uint64_t deadline) {
+    uint64_t now = common::UTCTimeMsec();
+    uint32_t delay = deadline > now ? static_cast<uint32_t>(deadline - now) : 0;
+    timer_->ArmTimer(loss_timer_, delay, now);
+    loss_timer_armed_ = true;
+    loss_timer_deadline_ = deadline;
+}
+
+// Per-packet retransmission timeout: every outstanding packet whose
+// send-time + PTO deadline has passed is declared lost. Timed-out packets
+// stay tracked (kLost) so that a late ACK still reaches the streams.
+void SendControl::OnLossTimer() {
+    loss_timer_armed_ = false;
+    uint64_t now = common::UTCTimeMsec();
+
+    for (int s = 0; s < PacketNumberSpace::kNumberSpaceCount; s++) {
+        auto ns = static_cast<PacketNumberSpace>(s);
+        sent_packets_[ns].ForEach([&](SentPacketRecord& record) {
+            if (record.IsLost() || record.loss_deadline > now) {
+                return;
+            }
+            LOG_DEBUG("SendControl::OnLossTimer: packet %llu timed out in ns=%d", record.packet_number, ns);
+            MarkRecordLost(ns, record, now * 1000);
+        });
     }
 
-    // Log recovery metrics with sampling
-    LogRecoveryMetricsIfChanged(now);
+    ArmLossTimer();
+    DeliverCongestionEvent(now * 1000);
+    DispatchLostData();
 }
 
 // RFC 9002 §6.2: PTO timer callback - called when PTO expires without receiving ACK
 void SendControl::OnPTOTimer() {
     // RFC 9002: Increment PTO backoff once per PTO firing (not per packet)
     rtt_calculator_.OnPTOExpired();
+    pto_count_++;
 
     LOG_WARN(
         "SendControl::OnPTOTimer: PTO fired, pto_count=%u, triggering probe", rtt_calculator_.GetConsecutivePTOCount());
     LOG_DEBUG(
-        "SendControl::OnPTOTimer: entry, unacked[0/1/2]={%zu,%zu,%zu} handshake_complete=%d",
-        unacked_packets_[0].size(), unacked_packets_[1].size(), unacked_packets_[2].size(),
+        "SendControl::OnPTOTimer: entry, tracked[0/1/2]={%zu,%zu,%zu} handshake_complete=%d",
+        sent_packets_[0].Size(), sent_packets_[1].Size(), sent_packets_[2].Size(),
         handshake_complete_ ? 1 : 0);
 
     // RFC 9002 §6.2.4: Send probe packets to elicit ACK from peer
@@ -687,31 +925,28 @@ void SendControl::OnPTOTimer() {
     bool found_retransmit = false;
     if (packet_lost_cb_) {
         // Find the oldest unacked packet to probe with
-        // This ensures a probe is sent even if per-packet timers haven't fired yet
-        for (int ns = 0; ns < PacketNumberSpace::kNumberSpaceCount; ns++) {
-            if (!unacked_packets_[ns].empty()) {
-                auto it = unacked_packets_[ns].begin();
-                if (it->second.packet && !it->second.is_lost) {
-                    // Mark as lost and trigger retransmission
-                    it->second.is_lost = true;
-                    lost_packets_.push_back(LostPacketEntry{it->second.packet, it->second.stream_data});
-                    congestion_control_->OnPacketLost(LossEvent{it->first, it->second.pkt_len_, common::UTCTimeMsec() * 1000});
-                    timer_->RemoveTimer(it->second.timer_task_);
-
-                    // Log marked_for_retransmit event (PTO-triggered)
-                    if (qlog_trace_) {
-                        common::MarkedForRetransmitData retransmit_data;
-                        retransmit_data.packet_number = it->first;
-                        retransmit_data.trigger = "pto_expired";
-                        QLOG_MARKED_FOR_RETRANSMIT(qlog_trace_, retransmit_data);
-                    }
-
-                    packet_lost_cb_(it->second.packet);
-                    found_retransmit = true;
-                    break;
+        // This ensures a probe is sent even if its loss deadline hasn't passed yet
+        for (int s = 0; s < PacketNumberSpace::kNumberSpaceCount; s++) {
+            auto ns = static_cast<PacketNumberSpace>(s);
+            auto record = sent_packets_[ns].OldestOutstanding();
+            if (record) {
+                // Log marked_for_retransmit event (PTO-triggered)
+                if (qlog_trace_) {
+                    common::MarkedForRetransmitData retransmit_data;
+                    retransmit_data.packet_number = record->packet_number;
+                    retransmit_data.trigger = "pto_expired";
+                    QLOG_MARKED_FOR_RETRANSMIT(qlog_trace_, retransmit_data);
                 }
+
+                // Mark as lost and trigger retransmission
+                MarkRecordLost(ns, *record, common::UTCTimeMsec() * 1000);
+                found_retransmit = true;
+                break;
             }
         }
+        ArmLossTimer();
+        DeliverCongestionEvent(common::UTCTimeMsec() * 1000);
+        DispatchLostData();
     }
 
     // RFC 9002 §6.2.2.1: During handshake, if no ACK-eliciting data to retransmit,
@@ -722,8 +957,8 @@ void SendControl::OnPTOTimer() {
     }
 
     // RFC 9002 §6.2.4 (Bug-19 fix): post-handshake probe with PING.
-    // The retransmission path above re-emits the *same* original frames with a
-    // new PN. If those same frames keep losing on the wire (high-loss links,
+    // The retransmission path above resends the lost frames' content in new
+    // packets. If those keep losing on the wire (high-loss links,
     // peer's RX buffer full because peer hasn't yielded MAX_DATA, etc.), the
     // peer never sees a packet that advances loss detection at our end and
     // the connection stalls.  RFC 9002 §6.2.4 explicitly says the probe MUST
@@ -745,11 +980,9 @@ void SendControl::OnPTOTimer() {
     }
 
     // Reschedule PTO timer with updated backoff for next probe
-    timer_->RemoveTimer(pto_timer_);
-    pto_timer_.SetTimeoutCallback([this]() { OnPTOTimer(); });
     // RFC 9002 §6.2.1: route through GetEffectiveMaxAckDelay() so the pre-handshake
     // PTO treats peer max_ack_delay as 0 per spec.
-    timer_->AddTimer(pto_timer_, rtt_calculator_.GetPTOWithBackoff(GetEffectiveMaxAckDelay()));
+    timer_->ArmTimer(pto_timer_, rtt_calculator_.GetPTOWithBackoff(GetEffectiveMaxAckDelay()));
 }
 
 void SendControl::SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) {
@@ -759,6 +992,26 @@ void SendControl::SetQlogTrace(std::shared_ptr<common::QlogTrace> trace) {
     }
 }
 
+bool SendControl::SetCongestionControl(CongestionControlType type, const std::string& custom_name) {
+    if (congestion_control_ && congestion_control_->GetBytesInFlight() > 0) {
+        LOG_WARN("SendControl: can't switch congestion control with %llu bytes in flight",
+            congestion_control_->GetBytesInFlight());
+        return false;
+    }
+    auto cc = CreateCongestionControl(type, custom_name);
+    if (!cc) {
+        LOG_WARN("SendControl: unknown congestion control type:%d name:\"%s\", keeping current one",
+            static_cast<int>(type), custom_name.c_str());
+        return false;
+    }
+    LOG_INFO("SendControl: using congestion control type:%d name:\"%s\"", static_cast<int>(type), custom_name.c_str());
+    congestion_control_ = std::move(cc);
+    if (qlog_trace_) {
+        congestion_control_->SetQlogTrace(qlog_trace_);
+    }
+    return true;
+}
+
 void SendControl::LogRecoveryMetricsIfChanged(uint64_t now) {
     if (!qlog_trace_ || !congestion_control_) {
         return;
@@ -3,14 +3,17 @@
 
 #include <functional>
 #include <list>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
+#include <quicx/quic/type.h>
 #include "common/timer/if_timer.h"
-#include "common/timer/timer_task.h"
+#include "common/timer/timer_node.h"
 
+#include "quic/congestion_control/careful_resume.h"
 #include "quic/congestion_control/if_congestion_control.h"
 #include "quic/connection/controler/rtt_calculator.h"
+#include "quic/connection/controler/sent_packet_tracker.h"
 #include "quic/connection/transport_param.h"
 #include "quic/packet/if_packet.h"
 #include "quic/packet/type.h"
@@ -18,41 +21,16 @@
 namespace quicx {
 namespace quic {
 
-// Stream data info in a packet for ACK tracking.
-//
-// Each entry records exactly one STREAM frame's byte range so the
-// stream-side ACK bookkeeping can do *selective* tracking instead of being
-// fooled by a single high cumulative offset.  When the same packet contains
-// several STREAM frames for the same stream (rare, but legal — e.g. a small
-// retransmitted gap followed by fresh data), we keep one StreamDataInfo per
-// frame rather than collapsing them, otherwise [offset_start, offset_start +
-// length) would lose meaning.
-struct StreamDataInfo {
-    uint64_t stream_id;
-    uint64_t offset_start;  // Offset of the first byte of this stream frame
-    uint64_t length;        // Length of the stream frame payload (0 for FIN-only)
-    bool has_fin;           // Whether this stream frame carries the FIN bit
-
-    // Backwards-compat helper: high-water mark of the contributed bytes.
-    uint64_t MaxOffset() const { return offset_start + length; }
-
-    StreamDataInfo():
-        stream_id(0),
-        offset_start(0),
-        length(0),
-        has_fin(false) {}
-    StreamDataInfo(uint64_t sid, uint64_t off_start, uint64_t len, bool fin):
-        stream_id(sid),
-        offset_start(off_start),
-        length(len),
-        has_fin(fin) {}
-};
-
 // Callback type for notifying stream data ACK.
 // Carries the precise byte range so SendStream can do selective tracking.
 using StreamDataAckCallback =
     std::function<void(uint64_t stream_id, uint64_t offset_start, uint64_t length, bool has_fin)>;
 
+// Callback type for notifying that a STREAM frame's byte range was lost.
+// SendStream queues whatever part of it is still unacknowledged for resend.
+using StreamDataLostCallback =
+    std::function<void(uint64_t stream_id, uint64_t offset_start, uint64_t length, bool has_fin)>;
+
 // controller of sender.
 class SendControl {
 public:
@@ -60,51 +38,61 @@ public:
     ~SendControl() {
         // Cancel all outstanding timers before our members are destroyed,
         // otherwise a later timer fire will touch a dangling `this` (the
-        // timer-task lambdas capture `this`).
-        //
-        // There are two classes of timers to clean up:
-        //   1. The single shared PTO timer `pto_timer_`.
-        //   2. Per-packet retransmit timer_tasks living inside
-        //      unacked_packets_. Before the P3 work these almost always
-        //      self-completed within the ~775 ms initial PTO window, which
-        //      hid the bug: benchmarks with aggressive initial-RTT overrides
-        //      (see docs/internal/perf_e2e_analysis.md §6 P3) shortened the window to
-        //      ~100 ms, leading to MultiStream teardown races that manifested
-        //      as heap corruption ("double free / unsorted double linked
-        //      list corrupted"). ClearRetransmissionData() removes each
-        //      per-packet timer; delegate to it.
+        // timer-node callbacks capture `this`). Both the shared PTO timer and
+        // the shared loss timer (which replaced the per-packet retransmit
+        // timer_tasks, see SentPacketTracker) must go; the latter is removed
+        // by ClearRetransmissionData().
         if (timer_) {
-            timer_->RemoveTimer(pto_timer_);
+            timer_->DisarmTimer(pto_timer_);
             ClearRetransmissionData();
         }
         // Clear callbacks to prevent dangling references
         stream_data_ack_cb_ = nullptr;
+        stream_data_lost_cb_ = nullptr;
+        frame_lost_cb_ = nullptr;
         packet_lost_cb_ = nullptr;
+        ack_frame_acked_cb_ = nullptr;
+        packet_outcome_cb_ = nullptr;
+        datagram_outcome_cb_ = nullptr;
     }
 
     uint32_t GetRtt() { return rtt_calculator_.GetSmoothedRtt(); }
     uint32_t GetPTO(uint32_t max_ack_delay) { return rtt_calculator_.GetPT0Interval(max_ack_delay); }
     RttCalculator& GetRttCalculator() { return rtt_calculator_; }
+    uint64_t GetCongestionWindow() const { return congestion_control_->GetCongestionWindow(); }
+    uint64_t GetBytesInFlight() const { return congestion_control_->GetBytesInFlight(); }
+    // Bytes/sec the path is believed to carry: the controller's own model
+    // when it has one, cwnd per smoothed RTT otherwise; 0 before any RTT
+    // sample.
+    uint64_t GetBandwidthEstimate();
     // For test instrumentation only: returns the underlying CC's
     // bytes_in_flight / cwnd. Lets unit tests verify that send_control's
     // packet-tracking maintains exact contract with the CC layer (see
     // send_control_test.cpp G2 group).
     uint64_t GetCcBytesInFlightForTest() const { return congestion_control_->GetBytesInFlight(); }
     uint64_t GetCcCongestionWindowForTest() const { return congestion_control_->GetCongestionWindow(); }
+    size_t GetTrackedPacketCountForTest(PacketNumberSpace ns) const { return sent_packets_[ns].Size(); }
     void OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& packet, uint32_t pkt_len);
     void OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& packet, uint32_t pkt_len,
         const std::vector<StreamDataInfo>& stream_data);
+    // `control_frames` are the retransmittable non-STREAM frames the packet
+    // carries; on loss they are handed back through the frame-lost callback.
+    void OnPacketSend(uint64_t now, const std::shared_ptr<IPacket>& packet, uint32_t pkt_len,
+        const std::vector<StreamDataInfo>& stream_data, std::vector<std::shared_ptr<IFrame>> control_frames);
     void OnPacketAck(uint64_t now, PacketNumberSpace ns, const std::shared_ptr<IFrame>& ack_frame);
     void CanSend(uint64_t now, uint64_t& can_send_bytes);
     bool NeedReSend() { return !lost_packets_.empty(); }
 
-    // A lost packet plus the stream-data records originally attached to it.
+    // A lost Initial/Handshake packet plus the stream-data records originally
+    // attached to it. Only those spaces are still replayed whole (they carry
+    // nothing but CRYPTO/ACK/PING/PADDING and are gone once the handshake is
+    // done); a lost application-space packet is split into its frame
+    // descriptors instead, see SetStreamDataLostCallback/SetFrameLostCallback.
     // The retransmit path (BaseConnection::TrySend) needs the stream_data
     // when re-registering the packet under its new PN, otherwise the
     // re-encoded packet's eventual ACK would not propagate back to
     // SendStream and the stream's selective-ACK bookkeeping would be left
-    // with permanent gaps — exactly the failure mode that left aioquic
-    // transfer interop hanging on 5MB downloads.
+    // with permanent gaps.
     struct LostPacketEntry {
         std::shared_ptr<IPacket> packet;
         std::vector<StreamDataInfo> stream_data;
@@ -117,10 +105,36 @@ public:
     // Set callback for stream data ACK notification
     void SetStreamDataAckCallback(StreamDataAckCallback callback) { stream_data_ack_cb_ = callback; }
 
-    // Set callback for packet loss notification
-    using PacketLostCallback = std::function<void(std::shared_ptr<IPacket>)>;
+    // Set callback for lost STREAM ranges of application-space packets
+    void SetStreamDataLostCallback(StreamDataLostCallback callback) { stream_data_lost_cb_ = callback; }
+
+    // Set callback for lost retransmittable control frames of application-space
+    // packets; the frame is to be queued again as is.
+    using FrameLostCallback = std::function<void(std::shared_ptr<IFrame>)>;
+    void SetFrameLostCallback(FrameLostCallback callback) { frame_lost_cb_ = callback; }
+
+    // Set callback for packet loss notification (fired once per lost packet,
+    // after its content has been handed to the callbacks above)
+    using PacketLostCallback = std::function<void(PacketNumberSpace ns, uint64_t packet_number)>;
     void SetPacketLostCallback(PacketLostCallback callback) { packet_lost_cb_ = callback; }
 
+    // Set callback for the outcome of every tracked application-space packet,
+    // with its size, once it is acknowledged or declared lost. Feeds DPLPMTUD
+    // (see PmtuProber).
+    using PacketOutcomeCallback =
+        std::function<void(uint64_t packet_number, uint32_t pkt_len, bool mtu_probe, bool acked)>;
+    void SetPacketOutcomeCallback(PacketOutcomeCallback callback) { packet_outcome_cb_ = callback; }
+
+    // Set callback for the DATAGRAM frames (RFC 9221) of an acknowledged or
+    // lost packet, by the id each frame carries. They are never requeued.
+    using DatagramOutcomeCallback = std::function<void(uint64_t datagram_id, bool acked)>;
+    void SetDatagramOutcomeCallback(DatagramOutcomeCallback callback) { datagram_outcome_cb_ = callback; }
+
+    // Set callback for ACK-of-ACK notification (RFC 9000 §13.2.4): a packet
+    // that carried one of our ACK frames was acknowledged.
+    using AckFrameAckedCallback = std::function<void(PacketNumberSpace ns, uint64_t largest_acked)>;
+    void SetAckFrameAckedCallback(AckFrameAckedCallback callback) { ack_frame_acked_cb_ = callback; }
+
     // Set callback for handshake probe needed (RFC 9002 §6.2.2.1)
     // Called when PTO fires during handshake but no ACK-eliciting data to retransmit
     using ProbeNeededCallback = std::function<void()>;
@@ -147,7 +161,7 @@ public:
     // RFC 9002 §6.2.1: While the handshake is unconfirmed, the peer's
     // max_ack_delay transport parameter has not yet been reliably delivered,
     // so it MUST be treated as zero when computing PTO. All four PTO
-    // callsites in send_control.cpp (OnPacketSend's per-packet timer,
+    // callsites in send_control.cpp (OnPacketSend's per-packet loss deadline,
     // OnPacketSend's pto_timer_ rearm, OnPacketAck's handshake-phase rearm,
     // and OnPTOTimer's post-fire rearm) route through this accessor so the
     // pre-handshake PTO stays spec-compliant. Returns 0 pre-handshake-complete,
@@ -159,9 +173,49 @@ public:
     // Clear all retransmission data (used when connection is closing)
     void ClearRetransmissionData();
 
+    // Multipath: a path added after the handshake gets its own SendControl
+    // (packet numbers, loss detection, RTT, congestion controller) that hands
+    // acked and lost data to the same places as the primary one and uses the
+    // peer's ACK delay settings. Path-specific signals (PMTU probe outcome,
+    // probe timers) are not copied, nor is the ACK-of-ACK callback: a path
+    // carries its own PATH_ACKs and reports them to its own RecvControl.
+    void InheritFrom(const SendControl& primary);
+    // Multipath: the path is abandoned. Everything still in flight in `ns`
+    // is declared lost at once, so streams and control frames are resent on
+    // the remaining paths, and nothing is tracked any longer.
+    void DeclareInFlightLost(PacketNumberSpace ns);
+
     // Set qlog trace for instrumentation
     void SetQlogTrace(std::shared_ptr<common::QlogTrace> trace);
 
+    // Replace the congestion controller chosen at construction (cubic). Only
+    // allowed while nothing is in flight, i.e. right after the connection is
+    // created; the old controller's accounting cannot be carried over.
+    // Returns false (keeping the current controller) if the type cannot be
+    // built, e.g. an unregistered kCustom name.
+    bool SetCongestionControl(CongestionControlType type, const std::string& custom_name = "");
+
+    // Careful Resume: start from the capacity an earlier connection over the
+    // same path observed (see CarefulResume). Only application-space traffic
+    // after the handshake drives the phases.
+    void StartCarefulResume(const PathCapacity& saved) { careful_resume_.Start(saved); }
+    CarefulResume::Phase GetCarefulResumePhase() const { return careful_resume_.GetPhase(); }
+    // The congestion window held data back; Careful Resume only jumps then.
+    void OnCwndLimited() { careful_resume_.OnCwndLimited(); }
+    // What this connection observed, to be saved for the next one.
+    bool GetObservedPathCapacity(PathCapacity& out) const {
+        return careful_resume_.GetObservedCapacity(*congestion_control_, out);
+    }
+
+    // Transport statistics (see QuicConnectionStats): RTT, congestion state
+    // and packet counters.
+    void FillStats(QuicConnectionStats& stats);
+
+    // ECN codepoint for outgoing packets when ECN is enabled: ECT(1) for an
+    // L4S controller, ECT(0) otherwise, Not-ECT once the peer's ECN counts
+    // failed validation (RFC 9000 §13.4.2).
+    uint8_t GetEcnCodepoint() const;
+
     // RFC 9000 Section 4.10: Discard packet number space state
     void DiscardPacketNumberSpace(PacketNumberSpace ns);
 
@@ -178,37 +232,64 @@ private:
     void DetectLostPackets(uint64_t now, PacketNumberSpace ns, uint64_t largest_acked);
     enum class EcnState { kUnknown, kValidated, kFailed };
     std::list<LostPacketEntry> lost_packets_;
-    struct PacketTimerInfo {
-        uint64_t send_time_;
-        uint32_t pkt_len_;
-        common::TimerTask timer_task_;
-        std::vector<StreamDataInfo> stream_data;  // Stream data contained in this packet
-        std::shared_ptr<IPacket> packet;          // Store packet for retransmission
-        bool is_lost = false;
-
-        PacketTimerInfo() {}
-        PacketTimerInfo(uint64_t t, uint32_t len, const common::TimerTask& task):
-            send_time_(t),
-            pkt_len_(len),
-            timer_task_(task) {}
-        PacketTimerInfo(
-            uint64_t t, uint32_t len, const common::TimerTask& task, const std::vector<StreamDataInfo>& data):
-            send_time_(t),
-            pkt_len_(len),
-            timer_task_(task),
-            stream_data(data) {}
-        PacketTimerInfo(uint64_t t, uint32_t len, const common::TimerTask& task,
-            const std::vector<StreamDataInfo>& data, std::shared_ptr<IPacket> pkt):
-            send_time_(t),
-            pkt_len_(len),
-            timer_task_(task),
-            stream_data(data),
-            packet(pkt) {}
-    };
-    std::unordered_map<uint64_t, PacketTimerInfo> unacked_packets_[PacketNumberSpace::kNumberSpaceCount];
+
+    // Sent-packet bookkeeping per packet number space. Only ack-eliciting
+    // packets are tracked (ACK-only packets early-return in OnPacketSend).
+    SentPacketTracker sent_packets_[PacketNumberSpace::kNumberSpaceCount];
+
+    // Release an acked record: update CC, drop it from the tracker and
+    // report its STREAM ranges to stream_data_ack_cb_. `ce_marks` is the
+    // number of the frame's new CE marks still to attribute; an outstanding
+    // record takes one.
+    void OnRecordAcked(PacketNumberSpace ns, SentPacketRecord& record, uint64_t now, uint32_t ack_delay,
+        uint64_t& ce_marks);
+    // Queue an outstanding record for retransmission and tell CC it is lost.
+    void MarkRecordLost(PacketNumberSpace ns, SentPacketRecord& record, uint64_t now_us);
+    // Hand the ACK and loss events queued by OnRecordAcked()/MarkRecordLost()
+    // to congestion control in one OnCongestionEvent() call, so per-event
+    // work (pacing rate, model update) runs once per ACK frame or loss pass
+    // rather than once per packet. Must run before DispatchLostData(), whose
+    // callbacks may send and so consult the congestion window.
+    void DeliverCongestionEvent(uint64_t now_us);
+    // Hand the frame descriptors collected by MarkRecordLost() to the stream
+    // and frame callbacks. Runs after the tracker walk, since the callbacks
+    // may re-enter SendControl.
+    void DispatchLostData();
+
+    // Per-packet retransmission timeout. Each record carries its own
+    // loss_deadline (send time + PTO at send); one shared timer is kept armed
+    // at the earliest deadline of the oldest outstanding packets instead of
+    // one TimerTask per packet.
+    void ArmLossTimer();
+    void ArmLossTimerAt(uint64_t deadline);
+    void OnLossTimer();
+    common::TimerNode loss_timer_;
+    bool loss_timer_armed_ = false;
+    uint64_t loss_timer_deadline_ = 0;
+
+    // Scratch buffer for STREAM ranges of an acked packet, reused so that ACK
+    // processing does not allocate in steady state.
+    std::vector<StreamDataInfo> acked_stream_data_;
+    // Frame descriptors of application-space packets declared lost during the
+    // current loss pass, pending DispatchLostData().
+    std::vector<StreamDataInfo> lost_stream_data_;
+    std::vector<std::shared_ptr<IFrame>> lost_frames_;
+    std::vector<uint64_t> lost_datagrams_;
+    // Scratch buffer for the datagram ids of an acked packet.
+    std::vector<uint64_t> acked_datagrams_;
+    std::vector<std::pair<PacketNumberSpace, uint64_t>> lost_packet_numbers_;
+    // Congestion events of the current ACK frame or loss pass, pending
+    // DeliverCongestionEvent().
+    std::vector<AckEvent> cc_acked_events_;
+    std::vector<LossEvent> cc_lost_events_;
 
     StreamDataAckCallback stream_data_ack_cb_;
+    StreamDataLostCallback stream_data_lost_cb_;
+    FrameLostCallback frame_lost_cb_;
     PacketLostCallback packet_lost_cb_;
+    AckFrameAckedCallback ack_frame_acked_cb_;
+    PacketOutcomeCallback packet_outcome_cb_;
+    DatagramOutcomeCallback datagram_outcome_cb_;
     ProbeNeededCallback probe_needed_cb_;
     ApplicationProbeCallback application_probe_cb_;
     bool handshake_complete_ = false;
@@ -225,13 +306,14 @@ private:
 
     RttCalculator rtt_calculator_;
     std::unique_ptr<ICongestionControl> congestion_control_;
+    CarefulResume careful_resume_;
 
     uint32_t max_ack_delay_ = 0;
     uint32_t ack_delay_exponent_ = 0;
     std::shared_ptr<common::ITimer> timer_;
 
     // RFC 9002: PTO timer for detecting persistent timeouts
-    common::TimerTask pto_timer_;
+    common::TimerNode pto_timer_;
     uint64_t last_ack_eliciting_sent_time_ = 0;  // Track when we last sent ack-eliciting data
 
     // RFC 9002: PTO timer callback
@@ -246,6 +328,14 @@ private:
     // Sampling state for recovery_metrics_updated
     uint64_t last_logged_cwnd_ = 0;
     uint64_t last_metrics_log_time_ = 0;
+
+    // Totals for connection statistics
+    uint64_t packets_sent_ = 0;
+    uint64_t bytes_sent_ = 0;
+    uint64_t packets_lost_ = 0;
+    uint64_t bytes_lost_ = 0;
+    uint64_t packets_retransmitted_ = 0;
+    uint64_t pto_count_ = 0;
 };
 
 }  // namespace quic
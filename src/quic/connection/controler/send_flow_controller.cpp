@@ -1,6 +1,7 @@
 #include "quic/connection/controler/send_flow_controller.h"
 
 #include "common/log/log.h"
+#include "common/util/time.h"
 
 #include "quic/config.h"
 #include "quic/frame/data_blocked_frame.h"
@@ -38,6 +39,11 @@ void SendFlowController::OnMaxDataReceived(uint64_t limit) {
         LOG_INFO(
             "SendFlowController::OnMaxDataReceived: increasing limit from %llu to %llu", max_data_, limit);
         max_data_ = limit;
+        if (blocked_since_ != 0) {
+            uint64_t now = common::UTCTimeMsec();
+            blocked_time_ms_ += now > blocked_since_ ? now - blocked_since_ : 0;
+            blocked_since_ = 0;
+        }
         // Limit increased -> peer might block us at the new limit later; reset
         // de-dup so a fresh DATA_BLOCKED can be emitted if we hit the new wall.
         last_data_blocked_limit_ = 0;
@@ -68,6 +74,9 @@ bool SendFlowController::CanSendData(uint64_t& can_send_size, std::shared_ptr<IF
         } else {
             LOG_DEBUG("SendFlowController::CanSendData: BLOCKED at limit %llu (suppressed duplicate DATA_BLOCKED)", max_data_);
         }
+        if (blocked_since_ == 0) {
+            blocked_since_ = common::UTCTimeMsec();
+        }
         can_send_size = 0;
         return false;
     }
@@ -91,6 +100,13 @@ bool SendFlowController::CanSendData(uint64_t& can_send_size, std::shared_ptr<IF
     return true;
 }
 
+uint64_t SendFlowController::GetBlockedTime(uint64_t now) const {
+    if (blocked_since_ == 0 || now <= blocked_since_) {
+        return blocked_time_ms_;
+    }
+    return blocked_time_ms_ + (now - blocked_since_);
+}
+
 void SendFlowController::OnMaxStreamsBidiReceived(uint64_t limit) {
     if (limit > max_streams_bidi_) {
         LOG_DEBUG(
@@ -139,6 +139,24 @@ public:
      */
     uint64_t GetUniStreamLimit() const { return max_streams_uni_; }
 
+    /**
+     * @brief Get how long sending has been held back by MAX_DATA
+     *
+     * Counts from the first CanSendData() refusal until the peer raises the
+     * limit; a stall still in progress is included up to `now`.
+     *
+     * @param now Current time in milliseconds
+     * @return Accumulated blocked time in milliseconds
+     */
+    uint64_t GetBlockedTime(uint64_t now) const;
+
+    /**
+     * @brief Get how many more bytes MAX_DATA lets us send
+     *
+     * @return Remaining connection-level credit, 0 when blocked
+     */
+    uint64_t GetAvailableWindow() const { return max_data_ > sent_bytes_ ? max_data_ - sent_bytes_ : 0; }
+
 private:
     // Connection-level data flow control
     uint64_t sent_bytes_;              // Total bytes sent on connection
@@ -164,6 +182,10 @@ private:
     // Tracks the max_data_ value for which a DATA_BLOCKED was last emitted; a
     // value of 0 means "not yet sent for any limit".
     uint64_t last_data_blocked_limit_ = 0;
+
+    // Time spent blocked on max_data_, for connection statistics
+    uint64_t blocked_since_ = 0;      // Start of the current stall, 0 if not blocked
+    uint64_t blocked_time_ms_ = 0;    // Stalls already ended
 };
 
 }  // namespace quic
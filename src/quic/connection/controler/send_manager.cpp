@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "common/log/log.h"
 #include "common/util/time.h"
 #include <quicx/common/metrics.h>
@@ -7,6 +9,7 @@
 #include "quic/connection/controler/send_manager.h"
 #include "quic/crypto/tls/type.h"
 #include "quic/frame/ack_frame.h"
+#include "quic/frame/ack_frequency_frame.h"
 #include "quic/frame/type.h"
 
 namespace quicx {
@@ -16,8 +19,9 @@ SendManager::SendManager(std::shared_ptr<common::ITimer> timer):
     send_control_(timer),
     send_flow_controller_(nullptr),
     packet_number_(),
+    pmtu_prober_(timer),
+    path_scheduler_(MakePathScheduler(PathSchedulerType::kMinRtt)),
     timer_(timer) {
-    pacing_timer_task_ = common::TimerTask();
     pacing_timer_task_.SetTimeoutCallback([this]() {
         if (send_retry_cb_) {
             send_retry_cb_();
@@ -30,7 +34,6 @@ SendManager::SendManager(std::shared_ptr<common::ITimer> timer):
     // max_data exhausted, all in-flight packets already acked, peer not
     // forthcoming with MAX_DATA) gets removed from the worker's active set
     // and never re-examined until idle timeout fires.
-    flow_control_recheck_task_ = common::TimerTask();
     flow_control_recheck_task_.SetTimeoutCallback([this]() {
         flow_control_recheck_scheduled_ = false;
         if (!is_flow_control_blocked_) {
@@ -42,8 +45,35 @@ SendManager::SendManager(std::shared_ptr<common::ITimer> timer):
         }
     });
 
-    send_control_.SetPacketLostCallback([this](std::shared_ptr<IPacket> packet) {
-        LOG_WARN("SendManager: packet %llu lost, triggering retransmission", packet->GetPacketNumber());
+    // DPLPMTUD: probe outcomes and black-hole signals come from loss
+    // detection; a raise-timer probe needs a send to go out.
+    send_control_.SetPacketOutcomeCallback([this](uint64_t packet_number, uint32_t pkt_len, bool mtu_probe, bool acked) {
+        if (acked) {
+            pmtu_prober_.OnPacketAcked(packet_number, pkt_len, mtu_probe);
+        } else {
+            pmtu_prober_.OnPacketLost(packet_number, pkt_len, mtu_probe);
+        }
+    });
+    pmtu_prober_.SetProbeNeededCallback([this]() {
+        if (send_retry_cb_) {
+            send_retry_cb_();
+        }
+    });
+
+    // RFC 9000 §13.3: a lost control frame is queued again as is; its STREAM
+    // data goes back to the owning stream (see BaseConnection).
+    send_control_.SetFrameLostCallback([this](std::shared_ptr<IFrame> frame) { ToSendFrame(frame); });
+    // RFC 9221: DATAGRAM frames are not resent, only reported.
+    send_control_.SetDatagramOutcomeCallback([this](uint64_t id, bool acked) {
+        if (acked) {
+            datagram_queue_.OnAcked(id);
+        } else {
+            datagram_queue_.OnLost(id);
+        }
+    });
+
+    send_control_.SetPacketLostCallback([this](PacketNumberSpace ns, uint64_t packet_number) {
+        LOG_WARN("SendManager: packet %llu lost in ns=%d, triggering retransmission", packet_number, ns);
         // Note: send_retry_cb_ (which calls BaseConnection::ActiveSend) will check connection state
         // and ignore the callback if connection is closing/draining/closed
         if (send_retry_cb_) {
@@ -56,11 +86,15 @@ SendManager::~SendManager() {}
 
 void SendManager::UpdateConfig(const TransportParam& tp) {
     send_control_.UpdateConfig(tp);
+    for (auto& path : paths_) {
+        path.second->send_control.UpdateConfig(tp);
+    }
+    ack_frequency_controller_.UpdateConfig(tp);
 }
 
 SendOperation SendManager::GetSendOperation() {
     // Check if there are frames or active streams to send
-    bool has_active_data = !wait_frame_list_.empty();
+    bool has_active_data = !wait_frame_list_.empty() || !datagram_queue_.Empty();
     if (stream_manager_) {
         has_active_data = has_active_data || stream_manager_->HasActiveStreams();
     }
@@ -74,11 +108,10 @@ SendOperation SendManager::GetSendOperation() {
         return SendOperation::kAllSendDone;
 
     } else {
-        // Use the PMTU prober's current effective MTU rather than a hard-coded
-        // 1500: the prober starts at the RFC 9000 §14.1 floor (1200) on a new
-        // path and probes upwards (up to 1500) only after success. This makes
-        // CanSend() honour the discovered path MTU instead of optimistically
-        // assuming wire-MTU on every connection.
+        // Use the PMTU prober's current PLPMTU rather than a hard-coded 1500:
+        // it drops to the RFC 9000 §14.1 floor (1200) on a new path or a
+        // black hole and grows as probes succeed (up to kMaxPlpmtu). This
+        // makes CanSend() honour the discovered path MTU.
         uint64_t can_send_size = pmtu_prober_.GetMtuLimit();
         uint64_t now = common::UTCTimeMsec();
         send_control_.CanSend(now, can_send_size);
@@ -88,9 +121,10 @@ SendOperation SendManager::GetSendOperation() {
                 uint64_t next_time = send_control_.GetNextSendTime(now);
                 if (next_time > now) {
                     uint64_t delay = next_time - now;
-                    timer_->AddTimer(pacing_timer_task_, delay);
+                    timer_->ArmTimer(pacing_timer_task_, delay);
                 } else {
                     is_cwnd_limited_ = true;
+                    send_control_.OnCwndLimited();
                     LOG_WARN("congestion control send data limited.");
                 }
                 // PERF VALIDATION: this branch covers both pacing-throttled
@@ -117,8 +151,25 @@ void SendManager::ToSendFrame(std::shared_ptr<IFrame> frame) {
 
 void SendManager::OnPacketAck(PacketNumberSpace ns, std::shared_ptr<IFrame> frame) {
     // Pass to send control for RTT/loss/cc updates
-    send_control_.OnPacketAck(common::UTCTimeMsec(), ns, frame);
+    uint64_t now = common::UTCTimeMsec();
+    send_control_.OnPacketAck(now, ns, frame);
+
+    // draft-ietf-quic-ack-frequency: the ACK may have moved cwnd far enough
+    // to ask the peer for a different ACK rate. ACK_FREQUENCY is only
+    // allowed in 0-RTT/1-RTT packets, and application-space ACKs only arrive
+    // once the peer's transport parameters (and so its min_ack_delay) are known.
+    if (ns == PacketNumberSpace::kApplicationNumberSpace) {
+        auto ack_frequency = ack_frequency_controller_.MayGenerateFrame(
+            now, send_control_.GetCongestionWindow(), send_control_.GetRtt(), pmtu_prober_.GetMtuLimit());
+        if (ack_frequency) {
+            ToSendFrame(ack_frequency);
+        }
+    }
+
+    ResumeAfterAck();
+}
 
+void SendManager::ResumeAfterAck() {
     // Bug #17: an incoming ACK is also a wake-up signal for a flow-control-
     // blocked connection. The peer might bundle MAX_DATA with the ACK, and
     // even if it doesn't, the ACK can free congestion-window room or expose
@@ -145,11 +196,145 @@ void SendManager::OnPacketAck(PacketNumberSpace ns, std::shared_ptr<IFrame> fram
             LOG_WARN("SendManager::OnPacketAck: send_retry_cb_ is null!");
         }
     }
+}
+
+void SendManager::FillStats(QuicConnectionStats& stats) {
+    send_control_.FillStats(stats);
+    stats.mtu_ = GetMaxPacketSize();
+    stats.app_limited_ = app_limited_ ? 1 : 0;
+}
+
+bool SendManager::AddPath(uint64_t path_id) {
+    if (path_id == kInvalidPathId || HasPath(path_id)) {
+        return false;
+    }
+    auto path = std::unique_ptr<PathSendState>(new PathSendState(timer_));
+    if (!path->send_control.SetCongestionControl(cc_type_, cc_custom_name_)) {
+        return false;
+    }
+    path->send_control.InheritFrom(send_control_);
+    if (qlog_trace_) {
+        path->send_control.SetQlogTrace(qlog_trace_);
+    }
+    paths_.emplace(path_id, std::move(path));
+    LOG_INFO("SendManager: path %llu added, %zu paths", path_id, GetPathCount());
+    return true;
+}
 
-    // PMTU probe success detection: delegate to PmtuProber
-    if (pmtu_prober_.CheckAckCoversProbe(frame)) {
+bool SendManager::AbandonPath(uint64_t path_id) {
+    auto iter = paths_.find(path_id);
+    if (iter == paths_.end()) {
+        return false;
+    }
+    // Take it out of the map first: the lost-data callbacks may send again,
+    // and that must not pick the path being dropped.
+    auto path = std::move(iter->second);
+    paths_.erase(iter);
+    path->send_control.DeclareInFlightLost(PacketNumberSpace::kApplicationNumberSpace);
+    LOG_INFO("SendManager: path %llu abandoned, %zu paths", path_id, GetPathCount());
+    return true;
+}
+
+SendControl* SendManager::GetPathSendControl(uint64_t path_id) {
+    if (path_id == 0) {
+        return &send_control_;
+    }
+    auto iter = paths_.find(path_id);
+    return iter == paths_.end() ? nullptr : &iter->second->send_control;
+}
+
+PacketNumber* SendManager::GetPathPacketNumber(uint64_t path_id) {
+    if (path_id == 0) {
+        return &packet_number_;
+    }
+    auto iter = paths_.find(path_id);
+    return iter == paths_.end() ? nullptr : &iter->second->packet_number;
+}
+
+void SendManager::OnPathAck(uint64_t path_id, std::shared_ptr<IFrame> frame) {
+    if (path_id == 0) {
+        OnPacketAck(PacketNumberSpace::kApplicationNumberSpace, frame);
+        return;
+    }
+    auto iter = paths_.find(path_id);
+    if (iter == paths_.end()) {
+        // an ACK for a path abandoned meanwhile: its data was already resent
+        LOG_DEBUG("SendManager: ack for unknown path %llu ignored", path_id);
+        return;
+    }
+    iter->second->send_control.OnPacketAck(
+        common::UTCTimeMsec(), PacketNumberSpace::kApplicationNumberSpace, frame);
+    ResumeAfterAck();
+}
+
+void SendManager::SetPathUsable(uint64_t path_id, bool usable) {
+    auto iter = paths_.find(path_id);
+    if (iter != paths_.end()) {
+        iter->second->usable = usable;
+    }
+}
+
+void SendManager::SetPathBackup(uint64_t path_id, bool backup) {
+    if (path_id == 0) {
+        primary_path_backup_ = backup;
         return;
     }
+    auto iter = paths_.find(path_id);
+    if (iter != paths_.end()) {
+        iter->second->backup = backup;
+    }
+}
+
+uint64_t SendManager::SelectPath() {
+    uint64_t now = common::UTCTimeMsec();
+    std::vector<PathCandidate> candidates;
+    std::vector<bool> backup;
+    candidates.reserve(GetPathCount());
+    backup.reserve(GetPathCount());
+
+    auto add_candidate = [&](uint64_t path_id, SendControl& send_control, bool usable, bool is_backup) {
+        // a path that keeps timing out is treated as broken until it is acked again
+        usable = usable && send_control.GetRttCalculator().GetConsecutivePTOCount() < kPathFailoverPtoCount;
+        uint64_t window = GetPathMaxPacketSize(path_id);
+        send_control.CanSend(now, window);
+        candidates.push_back(PathCandidate{path_id, send_control.GetRtt(), window, usable});
+        backup.push_back(is_backup);
+    };
+    add_candidate(0, send_control_, streams_allowed_, primary_path_backup_);
+    for (auto& path : paths_) {
+        add_candidate(path.first, path.second->send_control, path.second->usable, path.second->backup);
+    }
+
+    // draft-ietf-quic-multipath §3.3: backup paths only when no available
+    // path is usable at all, not when they are just congestion limited
+    bool have_available = false;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        have_available = have_available || (candidates[i].usable && !backup[i]);
+    }
+    if (have_available) {
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            candidates[i].usable = candidates[i].usable && !backup[i];
+        }
+    }
+    // any room will do: the packet is cut to the window as on a single path
+    return path_scheduler_->SelectPath(candidates, 1);
+}
+
+uint32_t SendManager::GetPathAvailableWindow(uint64_t path_id) {
+    if (path_id == 0) {
+        return GetAvailableWindow();
+    }
+    auto iter = paths_.find(path_id);
+    if (iter == paths_.end()) {
+        return 0;
+    }
+    uint64_t can_send_size = GetPathMaxPacketSize(path_id);
+    iter->second->send_control.CanSend(common::UTCTimeMsec(), can_send_size);
+    return static_cast<uint32_t>(can_send_size);
+}
+
+uint16_t SendManager::GetPathMaxPacketSize(uint64_t path_id) const {
+    return path_id == 0 ? pmtu_prober_.GetMtuLimit() : kMinInitialPacketSize;
 }
 
 void SendManager::ResetPathSignals() {
@@ -171,18 +356,23 @@ void SendManager::ClearActiveStreams() {
         stream_manager_->ClearActiveStreams();
     }
     wait_frame_list_.clear();
+    datagram_queue_.Clear();
     send_control_.ClearRetransmissionData();
+    paths_.clear();
     // Bug #17: connection is closing — disarm the flow-control recheck so the
     // timer wheel's pending callback does not fire on a teardowning connection.
     is_flow_control_blocked_ = false;
     if (flow_control_recheck_scheduled_ && timer_) {
-        timer_->RemoveTimer(flow_control_recheck_task_);
+        timer_->DisarmTimer(flow_control_recheck_task_);
         flow_control_recheck_scheduled_ = false;
     }
 }
 
 void SendManager::ClearRetransmissionData() {
     send_control_.ClearRetransmissionData();
+    for (auto& path : paths_) {
+        path.second->send_control.ClearRetransmissionData();
+    }
 }
 
 bool SendManager::CheckAndChargeAmpBudget(uint32_t bytes) {
@@ -206,6 +396,8 @@ bool SendManager::IsAllowedOnUnvalidated(uint16_t type) const {
         case FrameType::kPathResponse:
         case FrameType::kAck:
         case FrameType::kAckEcn:
+        case FrameType::kPathAck:
+        case FrameType::kPathAckEcn:
         case FrameType::kPing:
         case FrameType::kPadding:
         case FrameType::kNewConnectionId:
@@ -237,11 +429,10 @@ bool SendManager::ShouldSendRetry() const {
 }
 
 void SendManager::StartMtuProbe() {
-    pmtu_prober_.StartProbe();
-}
-
-void SendManager::OnMtuProbeResult(bool success) {
-    pmtu_prober_.OnProbeResult(success);
+    // a repeated trigger (duplicate HANDSHAKE_DONE) must not restart a search
+    if (pmtu_prober_.GetState() == PmtuProber::State::kBase) {
+        pmtu_prober_.StartProbe();
+    }
 }
 
 // RFC 9002: Check if frames are exempt from congestion control (ACKs, CONNECTION_CLOSE)
@@ -256,8 +447,8 @@ bool SendManager::IsCongestionControlExempt() const {
     // Check if all pending frames are exempt (ACKs or CONNECTION_CLOSE)
     for (const auto& frame : wait_frame_list_) {
         auto frame_type = frame->GetType();
-        if (frame_type == FrameType::kAck || frame_type == FrameType::kAckEcn ||
-            frame_type == FrameType::kConnectionClose || frame_type == FrameType::kConnectionCloseApp) {
+        if (frame_type == FrameType::kAck || frame_type == FrameType::kAckEcn || frame_type == FrameType::kPathAck ||
+            frame_type == FrameType::kPathAckEcn || frame_type == FrameType::kConnectionClose || frame_type == FrameType::kConnectionCloseApp) {
             continue;
         } else {
             return false;
@@ -282,6 +473,18 @@ uint32_t SendManager::GetAvailableWindow() {
 
 void SendManager::SetCwndLimited() {
     is_cwnd_limited_ = true;
+    app_limited_ = false;
+    send_control_.OnCwndLimited();
+}
+
+uint64_t SendManager::GetSendBudget() {
+    uint64_t cwnd = send_control_.GetCongestionWindow();
+    uint64_t in_flight = send_control_.GetBytesInFlight();
+    uint64_t budget = cwnd > in_flight ? cwnd - in_flight : 0;
+    if (send_flow_controller_) {
+        budget = std::min(budget, send_flow_controller_->GetAvailableWindow());
+    }
+    return budget;
 }
 
 void SendManager::SetFlowControlBlocked() {
@@ -296,7 +499,7 @@ void SendManager::SetFlowControlBlocked() {
     static constexpr uint32_t kFlowControlRecheckIntervalMs = 100;
     if (!flow_control_recheck_scheduled_ && timer_) {
         flow_control_recheck_scheduled_ = true;
-        timer_->AddTimer(flow_control_recheck_task_, kFlowControlRecheckIntervalMs);
+        timer_->ArmTimer(flow_control_recheck_task_, kFlowControlRecheckIntervalMs);
     }
 }
 
@@ -3,14 +3,19 @@
 
 #include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "common/timer/if_timer.h"
+#include "common/timer/timer_node.h"
 
 #include "quic/connection/connection_id_manager.h"
+#include "quic/connection/controler/ack_frequency_controller.h"
 #include "quic/connection/controler/anti_amplification_controller.h"
+#include "quic/connection/controler/datagram_queue.h"
+#include "quic/connection/controler/path_scheduler.h"
 #include "quic/connection/controler/pmtu_prober.h"
 #include "quic/connection/controler/send_control.h"
 #include "quic/connection/controler/send_flow_controller.h"
@@ -55,6 +60,25 @@ public:
      */
     void SetCwndLimited();
 
+    /**
+     * @brief Notify that the sender ran out of application data
+     *
+     * Called by BaseConnection::TrySend when a 1-RTT round ends with nothing
+     * left to send. The period lasts until the congestion window limits
+     * sending again (SetCwndLimited()).
+     */
+    void SetAppLimited() { app_limited_ = true; }
+    bool IsAppLimited() const { return app_limited_; }
+
+    /**
+     * @brief Bytes the connection could put on the wire right now
+     *
+     * The smaller of the congestion window's free room and the peer's
+     * connection-level MAX_DATA credit. Streams cap it further with their
+     * own credit, see IQuicSendStream::GetSendableBytes().
+     */
+    uint64_t GetSendBudget();
+
     /**
      * @brief Notify that connection-level flow control is blocking send
      *
@@ -120,11 +144,56 @@ public:
     // Check if should send Retry (approaching amplification limit)
     bool ShouldSendRetry() const;
 
-    // ---- PMTU probing (skeleton) ----
-    // Start a simple PMTU probe sequence after migration (skeleton only).
+    // ---- PMTU probing (DPLPMTUD, see PmtuProber) ----
+    // Start searching for a larger PLPMTU: once the handshake is confirmed
+    // and after migration.
     void StartMtuProbe();
-    // Notify probe result (success selects the higher MTU, failure falls back).
-    void OnMtuProbeResult(bool success);
+    // Upper bound of the search, from the peer's transport parameters.
+    void SetPeerMaxUdpPayloadSize(uint64_t size) { pmtu_prober_.SetPeerMaxUdpPayloadSize(size); }
+    // Size of the PING+PADDING probe to send now, 0 if none is due.
+    uint16_t GetMtuProbeSize() const { return pmtu_prober_.GetProbeSize(); }
+    void OnMtuProbeSent(uint64_t packet_number, uint32_t size) { pmtu_prober_.OnProbeSent(packet_number, size); }
+    // Datagram size limit for regular packets (the PLPMTU).
+    uint16_t GetMaxPacketSize() const { return pmtu_prober_.GetMtuLimit(); }
+    PmtuProber& GetPmtuProber() { return pmtu_prober_; }
+
+    // ---- Unreliable datagrams (RFC 9221, see DatagramQueue) ----
+    // Upper bound of frames we send, from the peer's transport parameters.
+    void SetPeerMaxDatagramFrameSize(uint64_t size) { datagram_queue_.SetPeerMaxFrameSize(size); }
+    DatagramQueue& GetDatagramQueue() { return datagram_queue_; }
+
+    // Sender side of QuicConnectionStats: RTT, congestion state and packet counters.
+    void FillStats(QuicConnectionStats& stats);
+
+    // ---- Multipath (draft-ietf-quic-multipath, see IPathScheduler) ----
+    // Path 0 is the path the handshake ran on and uses GetSendControl() and
+    // GetPacketNumber(). Every path added later has its own 1-RTT packet
+    // number space, loss detection, RTT and congestion controller of the
+    // same type.
+    bool AddPath(uint64_t path_id);
+    // Drop a path added by AddPath(); its data in flight is declared lost so
+    // it goes out again on the remaining paths.
+    bool AbandonPath(uint64_t path_id);
+    // A path carries new data only once validated. A backup path (the peer
+    // sent PATH_STATUS_BACKUP) only when no other path is usable.
+    void SetPathUsable(uint64_t path_id, bool usable);
+    void SetPathBackup(uint64_t path_id, bool backup);
+    bool HasPath(uint64_t path_id) const { return path_id == 0 || paths_.count(path_id) > 0; }
+    size_t GetPathCount() const { return 1 + paths_.size(); }
+    // nullptr for an unknown path id
+    SendControl* GetPathSendControl(uint64_t path_id);
+    PacketNumber* GetPathPacketNumber(uint64_t path_id);
+    // ACK of the 1-RTT packets of one path (what a PATH_ACK frame carries).
+    void OnPathAck(uint64_t path_id, std::shared_ptr<IFrame> frame);
+    // Path for the next 1-RTT packet, or kInvalidPathId when no path is
+    // usable or every usable one is blocked by its congestion window.
+    uint64_t SelectPath();
+    // GetAvailableWindow() and GetMaxPacketSize() of one path. Paths other
+    // than path 0 are not PMTU probed and stay at the 1200 byte floor.
+    uint32_t GetPathAvailableWindow(uint64_t path_id);
+    uint16_t GetPathMaxPacketSize(uint64_t path_id) const;
+    void SetPathScheduler(PathSchedulerType type) { path_scheduler_ = MakePathScheduler(type); }
+    PathSchedulerType GetPathSchedulerType() const { return path_scheduler_->GetType(); }
 
     void SetSendFlowController(SendFlowController* send_flow_controller) {
         send_flow_controller_ = send_flow_controller;
@@ -150,13 +219,27 @@ public:
         // strictly greater than the highest PN sent before Retry
     }
 
+    // Select the congestion controller (delegates to SendControl)
+    bool SetCongestionControl(CongestionControlType type, const std::string& custom_name) {
+        if (!send_control_.SetCongestionControl(type, custom_name)) {
+            return false;
+        }
+        // paths added later use the same controller
+        cc_type_ = type;
+        cc_custom_name_ = custom_name;
+        return true;
+    }
+
     // Accessors for BaseConnection (needed for TrySend)
     PacketNumber& GetPacketNumber() { return packet_number_; }
     SendControl& GetSendControl() { return send_control_; }
+    AckFrequencyController& GetAckFrequencyController() { return ack_frequency_controller_; }
 
 private:
     bool CheckAndChargeAmpBudget(uint32_t bytes);
     bool IsAllowedOnUnvalidated(uint16_t type) const;
+    // Wake the send loop after an ACK if it was held back.
+    void ResumeAfterAck();
 
 private:
     SendControl send_control_;
@@ -182,10 +265,33 @@ private:
     // Anti-amplification controller for unvalidated path
     AntiAmplificationController amp_controller_;
 
+    // Asks the peer for sparser ACKs once cwnd is large (ACK_FREQUENCY)
+    AckFrequencyController ack_frequency_controller_;
+
+    // Application datagrams waiting for the congestion window
+    DatagramQueue datagram_queue_;
+
+    // Multipath: sender state of the paths other than path 0
+    struct PathSendState {
+        explicit PathSendState(std::shared_ptr<common::ITimer> timer): send_control(timer) {}
+        SendControl send_control;
+        PacketNumber packet_number;
+        bool usable{false};
+        bool backup{false};
+    };
+    std::map<uint64_t, std::unique_ptr<PathSendState>> paths_;
+    std::unique_ptr<IPathScheduler> path_scheduler_;
+    bool primary_path_backup_{false};
+    // consecutive PTOs after which a path gets no new data (failover)
+    static constexpr uint32_t kPathFailoverPtoCount = 2;
+    CongestionControlType cc_type_{CongestionControlType::kCubic};
+    std::string cc_custom_name_;
+
     std::shared_ptr<common::ITimer> timer_;
-    common::TimerTask pacing_timer_task_;
+    common::TimerNode pacing_timer_task_;
     std::function<void()> send_retry_cb_;
     bool is_cwnd_limited_{false};
+    bool app_limited_{false};
 
     // Bug #17: connection-level flow control coordination.
     //   - is_flow_control_blocked_:  set by SetFlowControlBlocked() when the
@@ -199,7 +305,7 @@ private:
     //     while one is already pending.
     bool is_flow_control_blocked_{false};
     bool flow_control_recheck_scheduled_{false};
-    common::TimerTask flow_control_recheck_task_;
+    common::TimerNode flow_control_recheck_task_;
 
     // Qlog trace for instrumentation
     std::shared_ptr<common::QlogTrace> qlog_trace_;
@@ -0,0 +1,184 @@
+#include "common/log/log.h"
+
+#include "quic/connection/controler/sent_packet_tracker.h"
+
+namespace quicx {
+namespace quic {
+
+SentPacketTracker::SentPacketTracker():
+    records_(kInitialRecordCapacity),
+    packets_(kInitialRecordCapacity),
+    control_frames_(kInitialRecordCapacity),
+    mask_(kInitialRecordCapacity - 1),
+    stream_data_(kInitialStreamDataCapacity),
+    stream_data_mask_(kInitialStreamDataCapacity - 1) {}
+
+SentPacketRecord* SentPacketTracker::Add(uint64_t packet_number, uint64_t send_time, uint64_t loss_deadline,
+    uint32_t pkt_len, const std::vector<StreamDataInfo>& stream_data, const std::shared_ptr<IPacket>& packet,
+    std::vector<std::shared_ptr<IFrame>> control_frames) {
+    if (size_ == 0) {
+        // Empty window: re-anchor at this packet number. Every slot is free
+        // at this point, so no stale record can alias the new one.
+        tail_pn_ = packet_number;
+        head_pn_ = packet_number;
+    } else if (packet_number < head_pn_) {
+        LOG_ERROR("SentPacketTracker::Add: packet number went backwards. pn:%llu, head:%llu", packet_number, head_pn_);
+        return nullptr;
+    }
+
+    GrowRecords(packet_number - tail_pn_ + 1);
+
+    // Packet numbers skipped since the last tracked packet (ACK-only packets)
+    // occupy free slots inside the window.
+    for (uint64_t pn = head_pn_; pn < packet_number; ++pn) {
+        records_[pn & mask_].state = SentPacketRecord::State::kFree;
+    }
+
+    ReserveStreamData(stream_data.size());
+
+    SentPacketRecord& record = records_[packet_number & mask_];
+    record.packet_number = packet_number;
+    record.send_time = send_time;
+    record.loss_deadline = loss_deadline;
+    record.pkt_len = pkt_len;
+    record.stream_data_begin = stream_data_head_;
+    record.stream_data_count = static_cast<uint16_t>(stream_data.size());
+    record.carries_ack = false;
+    record.carried_ack_largest = 0;
+    record.mtu_probe = false;
+    record.packet_type = PacketType::kUnknownPacketType;
+    record.state = SentPacketRecord::State::kOutstanding;
+    for (const auto& info : stream_data) {
+        stream_data_[stream_data_head_ & stream_data_mask_] = info;
+        ++stream_data_head_;
+    }
+    packets_[packet_number & mask_] = packet;
+    control_frames_[packet_number & mask_] = std::move(control_frames);
+
+    head_pn_ = packet_number + 1;
+    ++size_;
+    return &record;
+}
+
+SentPacketRecord* SentPacketTracker::Find(uint64_t packet_number) {
+    if (size_ == 0 || packet_number < tail_pn_ || packet_number >= head_pn_) {
+        return nullptr;
+    }
+    SentPacketRecord& record = records_[packet_number & mask_];
+    if (!record.InUse() || record.packet_number != packet_number) {
+        return nullptr;
+    }
+    return &record;
+}
+
+void SentPacketTracker::Remove(SentPacketRecord* record) {
+    if (!record || !record->InUse()) {
+        return;
+    }
+    record->state = SentPacketRecord::State::kFree;
+    packets_[record->packet_number & mask_].reset();
+    control_frames_[record->packet_number & mask_].clear();
+    --size_;
+    if (record->packet_number == tail_pn_) {
+        AdvanceTail();
+    }
+}
+
+void SentPacketTracker::Clear() {
+    for (uint64_t pn = tail_pn_; size_ > 0 && pn < head_pn_; ++pn) {
+        SentPacketRecord& record = records_[pn & mask_];
+        if (record.InUse() && record.packet_number == pn) {
+            record.state = SentPacketRecord::State::kFree;
+            packets_[pn & mask_].reset();
+            control_frames_[pn & mask_].clear();
+            --size_;
+        }
+    }
+    size_ = 0;
+    tail_pn_ = head_pn_;
+    stream_data_tail_ = stream_data_head_;
+}
+
+std::vector<StreamDataInfo> SentPacketTracker::CopyStreamData(const SentPacketRecord& record) const {
+    std::vector<StreamDataInfo> result;
+    result.reserve(record.stream_data_count);
+    ForEachStreamData(record, [&result](const StreamDataInfo& info) { result.push_back(info); });
+    return result;
+}
+
+SentPacketRecord* SentPacketTracker::OldestOutstanding() {
+    for (uint64_t pn = tail_pn_; size_ > 0 && pn < head_pn_; ++pn) {
+        SentPacketRecord& record = records_[pn & mask_];
+        if (record.state == SentPacketRecord::State::kOutstanding && record.packet_number == pn) {
+            return &record;
+        }
+    }
+    return nullptr;
+}
+
+void SentPacketTracker::AdvanceTail() {
+    while (tail_pn_ < head_pn_) {
+        const SentPacketRecord& record = records_[tail_pn_ & mask_];
+        if (record.InUse() && record.packet_number == tail_pn_) {
+            break;
+        }
+        ++tail_pn_;
+    }
+    // Stream-data entries older than the oldest live record can be reused.
+    if (tail_pn_ < head_pn_) {
+        stream_data_tail_ = records_[tail_pn_ & mask_].stream_data_begin;
+    } else {
+        stream_data_tail_ = stream_data_head_;
+    }
+}
+
+void SentPacketTracker::GrowRecords(uint64_t required_span) {
+    if (required_span <= records_.size()) {
+        return;
+    }
+    size_t new_capacity = records_.size();
+    while (new_capacity < required_span) {
+        new_capacity <<= 1;
+    }
+    uint64_t new_mask = new_capacity - 1;
+
+    std::vector<SentPacketRecord> new_records(new_capacity);
+    std::vector<std::shared_ptr<IPacket>> new_packets(new_capacity);
+    std::vector<std::vector<std::shared_ptr<IFrame>>> new_control_frames(new_capacity);
+    for (uint64_t pn = tail_pn_; pn < head_pn_; ++pn) {
+        SentPacketRecord& record = records_[pn & mask_];
+        if (record.InUse() && record.packet_number == pn) {
+            new_records[pn & new_mask] = record;
+            new_packets[pn & new_mask] = std::move(packets_[pn & mask_]);
+            new_control_frames[pn & new_mask] = std::move(control_frames_[pn & mask_]);
+        }
+    }
+    records_.swap(new_records);
+    packets_.swap(new_packets);
+    control_frames_.swap(new_control_frames);
+    mask_ = new_mask;
+    LOG_DEBUG("SentPacketTracker: grew record ring to %zu slots", new_capacity);
+}
+
+void SentPacketTracker::ReserveStreamData(size_t count) {
+    uint64_t required = stream_data_head_ - stream_data_tail_ + count;
+    if (required <= stream_data_.size()) {
+        return;
+    }
+    size_t new_capacity = stream_data_.size();
+    while (new_capacity < required) {
+        new_capacity <<= 1;
+    }
+    uint64_t new_mask = new_capacity - 1;
+
+    std::vector<StreamDataInfo> new_stream_data(new_capacity);
+    for (uint64_t i = stream_data_tail_; i < stream_data_head_; ++i) {
+        new_stream_data[i & new_mask] = stream_data_[i & stream_data_mask_];
+    }
+    stream_data_.swap(new_stream_data);
+    stream_data_mask_ = new_mask;
+    LOG_DEBUG("SentPacketTracker: grew stream-data ring to %zu entries", new_capacity);
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,237 @@
+#ifndef QUIC_CONNECTION_CONTROLER_SENT_PACKET_TRACKER
+#define QUIC_CONNECTION_CONTROLER_SENT_PACKET_TRACKER
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "quic/frame/if_frame.h"
+#include "quic/packet/if_packet.h"
+
+namespace quicx {
+namespace quic {
+
+// Stream data info in a packet for ACK tracking.
+//
+// Each entry records exactly one STREAM frame's byte range so the
+// stream-side ACK bookkeeping can do *selective* tracking instead of being
+// fooled by a single high cumulative offset.  When the same packet contains
+// several STREAM frames for the same stream (rare, but legal — e.g. a small
+// retransmitted gap followed by fresh data), we keep one StreamDataInfo per
+// frame rather than collapsing them, otherwise [offset_start, offset_start +
+// length) would lose meaning.
+struct StreamDataInfo {
+    uint64_t stream_id;
+    uint64_t offset_start;  // Offset of the first byte of this stream frame
+    uint64_t length;        // Length of the stream frame payload (0 for FIN-only)
+    bool has_fin;           // Whether this stream frame carries the FIN bit
+
+    // Backwards-compat helper: high-water mark of the contributed bytes.
+    uint64_t MaxOffset() const { return offset_start + length; }
+
+    StreamDataInfo():
+        stream_id(0),
+        offset_start(0),
+        length(0),
+        has_fin(false) {}
+    StreamDataInfo(uint64_t sid, uint64_t off_start, uint64_t len, bool fin):
+        stream_id(sid),
+        offset_start(off_start),
+        length(len),
+        has_fin(fin) {}
+};
+
+// Compact per-packet record kept for every ack-eliciting packet in flight.
+//
+// The record deliberately holds no owning pointers and no timer task: the
+// loss deadline that used to live in a per-packet TimerTask is stored as a
+// plain timestamp and serviced by a single SendControl loss timer, and the
+// STREAM frame ranges live in the tracker's pooled stream-data ring.
+// Together with the control frames kept next to it, those ranges are the
+// packet's frame descriptors: a lost 1-RTT packet is never replayed as is,
+// its still-needed content is regenerated into new packets instead.
+struct SentPacketRecord {
+    enum class State : uint8_t {
+        kFree = 0,     // slot not in use (never sent, ACK-only, acked or removed)
+        kOutstanding,  // in flight, counted in bytes_in_flight
+        kLost,         // declared lost by timeout, kept so a late ACK still reaches the streams
+    };
+
+    uint64_t packet_number = 0;
+    uint64_t send_time = 0;       // ms, same clock as SendControl::largest_sent_time_
+    uint64_t loss_deadline = 0;   // ms, send_time + PTO at send (per-packet timeout)
+    uint64_t stream_data_begin = 0;  // virtual index into the stream-data ring
+    uint64_t carried_ack_largest = 0;  // Largest Acknowledged of the ACK frame carried, if any
+    uint32_t pkt_len = 0;
+    uint16_t stream_data_count = 0;
+    PacketType packet_type = PacketType::kUnknownPacketType;
+    State state = State::kFree;
+    bool carries_ack = false;
+    bool mtu_probe = false;  // DPLPMTUD probe, kept out of congestion control
+
+    bool InUse() const { return state != State::kFree; }
+    bool IsLost() const { return state == State::kLost; }
+};
+
+/**
+ * @brief Packet-number-indexed circular buffer of sent-packet records.
+ *
+ * Records are addressed by `packet_number & mask`, so Find() is a single
+ * array access and an ACK range or loss-detection pass is a linear walk over
+ * contiguous memory instead of a set of hash probes. The window
+ * [SmallestPacketNumber(), LargestPacketNumber()] only ever slides forward:
+ * packet numbers are strictly increasing per space (RFC 9000 §12.3), and the
+ * tail advances over freed slots as the oldest packets are acked or lost.
+ *
+ * STREAM frame metadata is kept in a parallel ring of StreamDataInfo that is
+ * appended to in send order and reclaimed together with the tail record, so
+ * steady-state sending performs no allocation at all. Both rings grow by
+ * doubling when the in-flight window outgrows them.
+ *
+ * Retransmittable control frames (MAX_DATA, RESET_STREAM, NEW_CONNECTION_ID,
+ * ...) are kept per slot in a third parallel array. Only Initial/Handshake
+ * packets are still replayed whole, so only they store their IPacket in the
+ * fourth one; application-space slots leave it empty and do not pin the
+ * packet's plaintext buffer for an RTT.
+ */
+class SentPacketTracker {
+public:
+    SentPacketTracker();
+    ~SentPacketTracker() = default;
+
+    // Track a newly sent packet. `packet_number` must be larger than every
+    // packet number tracked so far (or the tracker must be empty). `packet`
+    // is only needed for packets that are replayed whole on loss and may be
+    // null; `control_frames` are the retransmittable non-STREAM frames.
+    // Returns the stored record, or nullptr if the packet number went backwards.
+    SentPacketRecord* Add(uint64_t packet_number, uint64_t send_time, uint64_t loss_deadline, uint32_t pkt_len,
+        const std::vector<StreamDataInfo>& stream_data, const std::shared_ptr<IPacket>& packet,
+        std::vector<std::shared_ptr<IFrame>> control_frames = {});
+
+    // O(1) lookup. Returns nullptr when the packet is not (or no longer) tracked.
+    SentPacketRecord* Find(uint64_t packet_number);
+
+    // Release a record (acked, declared lost, or discarded). Advances the
+    // window tail over any freed slots.
+    void Remove(SentPacketRecord* record);
+
+    void Clear();
+
+    bool Empty() const { return size_ == 0; }
+    size_t Size() const { return size_; }
+    size_t Capacity() const { return records_.size(); }
+
+    // Window bounds. Only meaningful when !Empty().
+    uint64_t SmallestPacketNumber() const { return tail_pn_; }
+    uint64_t LargestPacketNumber() const { return head_pn_ - 1; }
+
+    const std::shared_ptr<IPacket>& GetPacket(const SentPacketRecord& record) const {
+        return packets_[record.packet_number & mask_];
+    }
+
+    // Hand the record's control frames over to the caller (on loss); the
+    // record keeps its STREAM ranges so a late ACK still reaches the streams.
+    std::vector<std::shared_ptr<IFrame>> TakeControlFrames(const SentPacketRecord& record) {
+        return std::move(control_frames_[record.packet_number & mask_]);
+    }
+    size_t ControlFrameCount(const SentPacketRecord& record) const {
+        return control_frames_[record.packet_number & mask_].size();
+    }
+
+    // Visit the STREAM frame ranges recorded for `record`, in frame order.
+    template <typename Fn>
+    void ForEachStreamData(const SentPacketRecord& record, Fn&& fn) const {
+        for (uint64_t i = 0; i < record.stream_data_count; ++i) {
+            fn(stream_data_[(record.stream_data_begin + i) & stream_data_mask_]);
+        }
+    }
+    std::vector<StreamDataInfo> CopyStreamData(const SentPacketRecord& record) const;
+
+    // Visit every in-use record with packet number in [from, to], ascending.
+    // `fn` may call Remove() on the record it is handed.
+    template <typename Fn>
+    void ForEachInRange(uint64_t from, uint64_t to, Fn&& fn) {
+        if (size_ == 0) {
+            return;
+        }
+        if (from < tail_pn_) {
+            from = tail_pn_;
+        }
+        if (to >= head_pn_) {
+            to = head_pn_ - 1;
+        }
+        for (uint64_t pn = from; pn <= to && size_ > 0; ++pn) {
+            SentPacketRecord& record = records_[pn & mask_];
+            if (record.InUse() && record.packet_number == pn) {
+                fn(record);
+            }
+        }
+    }
+
+    // Same as ForEachInRange() but descending, which is the order ACK ranges
+    // are encoded in (largest acknowledged first).
+    template <typename Fn>
+    void ReverseForEachInRange(uint64_t from, uint64_t to, Fn&& fn) {
+        if (size_ == 0) {
+            return;
+        }
+        if (from < tail_pn_) {
+            from = tail_pn_;
+        }
+        if (to >= head_pn_) {
+            to = head_pn_ - 1;
+        }
+        if (from > to) {
+            return;
+        }
+        for (uint64_t pn = to; size_ > 0; --pn) {
+            SentPacketRecord& record = records_[pn & mask_];
+            if (record.InUse() && record.packet_number == pn) {
+                fn(record);
+            }
+            if (pn == from) {
+                break;
+            }
+        }
+    }
+
+    // Visit every in-use record, ascending by packet number.
+    template <typename Fn>
+    void ForEach(Fn&& fn) {
+        if (size_ == 0) {
+            return;
+        }
+        ForEachInRange(tail_pn_, head_pn_ - 1, fn);
+    }
+
+    // Oldest record that is still kOutstanding, or nullptr.
+    SentPacketRecord* OldestOutstanding();
+
+private:
+    void GrowRecords(uint64_t required_span);
+    void ReserveStreamData(size_t count);
+    void AdvanceTail();
+
+    static constexpr size_t kInitialRecordCapacity = 256;   // power of 2
+    static constexpr size_t kInitialStreamDataCapacity = 256;  // power of 2
+
+    std::vector<SentPacketRecord> records_;
+    std::vector<std::shared_ptr<IPacket>> packets_;
+    std::vector<std::vector<std::shared_ptr<IFrame>>> control_frames_;
+    uint64_t mask_;
+    uint64_t tail_pn_ = 0;  // smallest packet number that may be in use
+    uint64_t head_pn_ = 0;  // one past the largest tracked packet number
+    size_t size_ = 0;
+
+    // Pooled STREAM frame metadata, addressed by monotonically increasing
+    // virtual indices [stream_data_tail_, stream_data_head_).
+    std::vector<StreamDataInfo> stream_data_;
+    uint64_t stream_data_mask_;
+    uint64_t stream_data_tail_ = 0;
+    uint64_t stream_data_head_ = 0;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -97,6 +97,9 @@ public:
     virtual void SetPeerAddress(const common::Address& addr);
     virtual void SetPeerAddress(const common::Address&& addr);
     virtual const common::Address& GetPeerAddress();
+    // destination CID of the datagram handed to OnPackets() next; with
+    // multipath it tells the path the datagram arrived on. default no-op
+    virtual void SetRecvConnectionID(ConnectionID& cid) { (void)cid; }
     // observe peer address from incoming datagrams; default no-op
     virtual void OnObservedPeerAddress(const common::Address& addr) { (void)addr; }
     // notify candidate-path datagram was received with its address and size; default no-op
@@ -140,6 +143,9 @@ public:
 
     void SetSocket(int32_t sockfd) { sockfd_ = sockfd; }
     int32_t GetSocket() const { return sockfd_; }
+    // Socket the next datagram handed to OnPackets() arrived on; by default
+    // it becomes the send socket
+    virtual void SetRecvSocket(int32_t sockfd) { sockfd_ = sockfd; }
 
     // Set callback to register a new socket with the receiver (for connection migration)
     using RegisterSocketCallback = std::function<bool(int32_t sockfd)>;
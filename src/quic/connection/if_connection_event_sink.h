@@ -64,6 +64,16 @@ public:
      */
     virtual void OnStreamClosed(uint64_t stream_id) = 0;
 
+    /**
+     * @brief Notify that the application consumed received stream data
+     *
+     * Called by streams as their receive buffers drain, so the connection can
+     * credit the bytes back with MAX_DATA.
+     *
+     * @param bytes Number of bytes consumed since the last notification
+     */
+    virtual void OnStreamDataConsumed(uint64_t bytes) = 0;
+
     /**
      * @brief Notify that the connection should be closed
      *
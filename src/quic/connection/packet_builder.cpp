@@ -10,9 +10,13 @@
 #include "quic/common/constants.h"
 #include "quic/connection/connection_id_manager.h"
 #include "quic/connection/connection_stream_manager.h"
+#include "quic/connection/controler/datagram_queue.h"
 #include "quic/connection/controler/send_control.h"
 #include "quic/connection/util.h"
+#include "quic/frame/ack_frame.h"
 #include "quic/frame/padding_frame.h"
+#include "quic/frame/path_ack_frame.h"
+#include "quic/frame/ping_frame.h"
 #include "quic/packet/handshake_packet.h"
 #include "quic/packet/header/long_header.h"
 #include "quic/packet/init_packet.h"
@@ -188,21 +192,25 @@ PacketBuilder::BuildResult PacketBuilder::BuildDataPacket(const DataPacketContex
     // 2. Create frame visitor with MTU limit
     //
     // Per-datagram payload budget for the frame visitor.
-    //   kMaxV4PacketSize (1472)
+    //   max_packet_size (the PLPMTU, kDefaultPlpmtu = 1472 until probed)
     //     - long-header overhead (~13 B: 1 flag + 8 DCID + 4 PN max)
     //     - AEAD tag (16 B)
-    //   = 1443 B available for plaintext frames.
-    // We use 1420 to leave headroom for variable-length fields (token,
-    // multi-byte CIDs, longer PN encoding) and to stay safely below the
-    // typical Ethernet MTU once IP+UDP headers are added (28 B), so a
-    // single packet never IP-fragments on the loopback / common LAN path.
-    constexpr uint32_t kVisitorBudget = 1420;
-    FixBufferFrameVisitor visitor(kVisitorBudget);
+    //   = 1443 B available for plaintext frames at 1472.
+    // We reserve 52 B (1420 at 1472) to leave headroom for variable-length
+    // fields (token, multi-byte CIDs, longer PN encoding), so a packet never
+    // exceeds the PLPMTU and IP-fragments. A probe pads to an exact size
+    // and brings its own budget.
+    uint32_t budget = ctx.max_packet_size > kPacketOverheadReserve ? ctx.max_packet_size - kPacketOverheadReserve : 0;
+    if (ctx.mtu_probe) {
+        budget = ctx.min_size;
+    }
+    FixBufferFrameVisitor visitor(budget);
 
     // Set stream data size limit for flow control
     visitor.SetStreamDataSizeLimit(ctx.max_stream_data_size);
 
     // 3. Add all control frames
+    std::shared_ptr<AckFrame> carried_ack;
     for (auto& frame : ctx.frames) {
         if (!visitor.HandleFrame(frame)) {
             // Check if it's insufficient space or real error
@@ -214,6 +222,24 @@ PacketBuilder::BuildResult PacketBuilder::BuildDataPacket(const DataPacketContex
             LOG_ERROR("PacketBuilder::BuildDataPacket: %s", result.error_message.c_str());
             return result;
         }
+        // Only the ACK for the path this packet travels on is tracked: the
+        // ACK-of-ACK is reported through that path's SendControl
+        if (frame->GetType() == FrameType::kAck || frame->GetType() == FrameType::kAckEcn) {
+            if (ctx.path_id == 0) {
+                carried_ack = std::static_pointer_cast<AckFrame>(frame);
+            }
+        } else if (PathAckFrame::IsPathAckFrame(frame->GetType())) {
+            auto path_ack = std::static_pointer_cast<PathAckFrame>(frame);
+            if (path_ack->GetPathId() == ctx.path_id) {
+                carried_ack = path_ack;
+            }
+        }
+    }
+
+    // 3b. Unreliable datagrams go before stream data: they are usually
+    // latency sensitive, and stream data simply fills what is left
+    if (ctx.datagram_queue && ctx.level == kApplication) {
+        ctx.datagram_queue->BuildFrames(&visitor, common::UTCTimeMsec(), budget);
     }
 
     // 4. Add stream data (if requested and StreamManager provided)
@@ -230,9 +256,9 @@ PacketBuilder::BuildResult PacketBuilder::BuildDataPacket(const DataPacketContex
         return result;  // Not an error, just no data
     }
 
-    // 6. Handle Initial packet padding BEFORE creating the packet
-    // This ensures the padding is included in the payload
-    if (ctx.add_padding && ctx.level == kInitial) {
+    // 6. Handle Initial packet (and PMTU probe) padding BEFORE creating the
+    // packet. This ensures the padding is included in the payload
+    if (ctx.add_padding) {
         uint32_t current_size = payload_buffer->GetDataLength();
         if (current_size < ctx.min_size) {
             auto padding_frame = std::make_shared<PaddingFrame>();
@@ -317,6 +343,7 @@ PacketBuilder::BuildResult PacketBuilder::BuildDataPacket(const DataPacketContex
     } else if (header->GetHeaderType() == PacketHeaderType::kShortHeader) {
         // RFC 9001 §6: Set Key Phase bit for 1-RTT packets
         header->GetShortHeaderFlag().SetKeyPhase(ctx.key_phase);
+        std::static_pointer_cast<Rtt1Packet>(packet)->SetPathId(ctx.path_id);
     }
 
     // 11. Assign packet number
@@ -329,9 +356,15 @@ PacketBuilder::BuildResult PacketBuilder::BuildDataPacket(const DataPacketContex
     // 12. Set payload and cryptographer
     packet->SetPayload(payload_buffer->GetSharedReadableSpan());
     packet->SetCryptographer(ctx.cryptographer);
+    packet->SetMtuProbe(ctx.mtu_probe);
 
     // 13. Set frame type bit for ACK-eliciting detection
     packet->AddFrameTypeBit(static_cast<FrameTypeBit>(visitor.GetFrameTypeBit()));
+    if (carried_ack) {
+        // RFC 9000 §13.2.4: lets SendControl report the ACK-of-ACK back to
+        // RecvControl once this packet is acknowledged.
+        packet->SetCarriedAckLargest(carried_ack->GetLargestAck());
+    }
 
     // [DIAG-RTX] Snapshot payload bytes BEFORE first-send Encode.
     // Helps confirm whether the SharedBufferSpan held by `packet->payload_`
@@ -360,9 +393,11 @@ PacketBuilder::BuildResult PacketBuilder::BuildDataPacket(const DataPacketContex
     uint32_t encoded_size = output_buffer->GetDataLength();
     LOG_DEBUG("PacketBuilder::BuildDataPacket: encoded packet size=%u bytes", encoded_size);
 
-    // 15. Record packet send event (for congestion control)
+    // 15. Record packet send event (for congestion control) together with
+    // the frame descriptors needed to regenerate its content on loss
     auto stream_data_info = visitor.GetStreamDataInfo();
-    send_control.OnPacketSend(common::UTCTimeMsec(), packet, encoded_size, stream_data_info);
+    send_control.OnPacketSend(
+        common::UTCTimeMsec(), packet, encoded_size, stream_data_info, visitor.TakeControlFrames());
 
     // 16. Success! Fill in result
     result.success = true;
@@ -419,5 +454,41 @@ PacketBuilder::BuildResult PacketBuilder::BuildImmediatePacket(const std::shared
     return BuildDataPacket(ctx, output_buffer, packet_number, send_control);
 }
 
+PacketBuilder::BuildResult PacketBuilder::BuildMtuProbePacket(uint32_t probe_size,
+    const std::shared_ptr<ICryptographer>& cryptographer, ConnectionIDManager* local_cid_mgr,
+    ConnectionIDManager* remote_cid_mgr, const std::shared_ptr<common::IBuffer>& output_buffer,
+    PacketNumber& packet_number, SendControl& send_control, uint8_t key_phase) {
+    DataPacketContext ctx;
+    ctx.level = kApplication;
+    ctx.cryptographer = cryptographer;
+    ctx.local_cid_manager = local_cid_mgr;
+    ctx.remote_cid_manager = remote_cid_mgr;
+    ctx.key_phase = key_phase;
+    ctx.frames.push_back(std::make_shared<PingFrame>());
+    ctx.include_stream_data = false;
+    ctx.max_packet_size = probe_size;
+    ctx.mtu_probe = true;
+
+    // Short header: 1 flag byte + DCID + packet number (4 B at most) + AEAD tag
+    uint32_t overhead = 1 + 4;
+    if (remote_cid_mgr) {
+        overhead += remote_cid_mgr->GetCurrentID().GetLength();
+    }
+    if (cryptographer) {
+        overhead += static_cast<uint32_t>(cryptographer->GetTagLength());
+    }
+    if (probe_size <= overhead) {
+        BuildResult result;
+        result.success = false;
+        result.error_message = "probe size too small";
+        return result;
+    }
+    ctx.add_padding = true;
+    ctx.min_size = probe_size - overhead;
+
+    LOG_DEBUG("PacketBuilder::BuildMtuProbePacket: building %u byte probe", probe_size);
+    return BuildDataPacket(ctx, output_buffer, packet_number, send_control);
+}
+
 }  // namespace quic
 }  // namespace quicx
@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 
+#include "quic/common/constants.h"
 #include "quic/crypto/tls/type.h"
 #include "quic/frame/if_frame.h"
 #include "quic/packet/if_packet.h"
@@ -20,6 +21,7 @@ class ConnectionIDManager;
 class PacketNumber;
 class StreamManager;
 class SendControl;
+class DatagramQueue;
 
 /**
  * @brief Packet builder for unified packet construction
@@ -52,6 +54,10 @@ class SendControl;
  */
 class PacketBuilder {
 public:
+    // Payload room a data packet leaves for headers and AEAD tag, see
+    // BuildDataPacket().
+    static constexpr uint32_t kPacketOverheadReserve = 52;
+
     /**
      * @brief Build context containing all input parameters for packet building
      */
@@ -155,10 +161,20 @@ public:
         bool include_stream_data;       // Whether to include stream data
         uint32_t max_stream_data_size;  // Maximum stream data size (flow control limit)
 
+        // Optional: unreliable datagrams (RFC 9221), packed ahead of stream data
+        DatagramQueue* datagram_queue;
+
         // Optional: Initial packet requirements
         std::string token;  // Token (for Initial packets)
-        bool add_padding;   // Whether to pad to 1200 bytes
-        uint32_t min_size;  // Minimum packet size (for padding)
+        bool add_padding;   // Whether to pad the payload to min_size
+        uint32_t min_size;  // Minimum payload size (for padding)
+
+        // Datagram size limit: the path's PLPMTU (see PmtuProber)
+        uint32_t max_packet_size;
+        // DPLPMTUD probe, kept out of congestion control (see BuildMtuProbePacket)
+        bool mtu_probe;
+        // Multipath: the path the 1-RTT packet is sent on, mixed into its nonce
+        uint32_t path_id;
 
         DataPacketContext():
             level(kInitial),
@@ -169,8 +185,12 @@ public:
             stream_manager(nullptr),
             include_stream_data(true),
             max_stream_data_size(1300),  // Default to reasonable packet size
+            datagram_queue(nullptr),
             add_padding(false),
-            min_size(1200) {}
+            min_size(1200),
+            max_packet_size(kDefaultPlpmtu),
+            mtu_probe(false),
+            path_id(0) {}
     };
 
     /**
@@ -179,7 +199,7 @@ public:
      * This is the primary packet building interface for normal data transmission.
      * It handles:
      * 1. Adding control frames (ACK, PING, etc.)
-     * 2. Fetching and adding stream data (if requested)
+     * 2. Adding queued datagrams, then fetching and adding stream data (if requested)
      * 3. Padding (for Initial packets)
      * 4. Packet number assignment
      * 5. Encoding to buffer
@@ -236,6 +256,21 @@ public:
         ConnectionIDManager* remote_cid_mgr, const std::shared_ptr<common::IBuffer>& output_buffer,
         PacketNumber& packet_number, SendControl& send_control, uint32_t quic_version = 0, uint8_t key_phase = 0);
 
+    /**
+     * @brief Build a DPLPMTUD probe: a 1-RTT PING padded to probe_size bytes
+     *
+     * RFC 9000 §14.4: the probe is ack-eliciting and tracked for loss, but is
+     * marked so congestion control never sees it. The encoded size may fall
+     * up to 3 bytes short of probe_size (packet number length).
+     *
+     * @param probe_size Target datagram size
+     * @return BuildResult with success status and packet info
+     */
+    BuildResult BuildMtuProbePacket(uint32_t probe_size, const std::shared_ptr<ICryptographer>& cryptographer,
+        ConnectionIDManager* local_cid_mgr, ConnectionIDManager* remote_cid_mgr,
+        const std::shared_ptr<common::IBuffer>& output_buffer, PacketNumber& packet_number, SendControl& send_control,
+        uint8_t key_phase = 0);
+
 private:
     /**
      * @brief Create packet object based on encryption level
@@ -0,0 +1,109 @@
+#include <cstring>
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#include "common/util/time.h"
+#include "quic/connection/path_capacity_cache.h"
+
+namespace quicx {
+namespace quic {
+
+void PathCapacityCache::Store(const std::string& key, const PathCapacity& capacity) {
+    if (key.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(key);
+    if (iter != entries_.end()) {
+        lru_list_.erase(iter->second.lru_iter);
+        entries_.erase(iter);
+    }
+    while (!lru_list_.empty() && entries_.size() >= max_entries_) {
+        entries_.erase(lru_list_.back());
+        lru_list_.pop_back();
+    }
+    lru_list_.push_front(key);
+    Entry& entry = entries_[key];
+    entry.capacity = capacity;
+    entry.stored_ms = common::UTCTimeMsec();
+    entry.lru_iter = lru_list_.begin();
+}
+
+bool PathCapacityCache::Lookup(const std::string& key, PathCapacity& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) {
+        return false;
+    }
+    if (common::UTCTimeMsec() - iter->second.stored_ms > kLifetimeMs) {
+        lru_list_.erase(iter->second.lru_iter);
+        entries_.erase(iter);
+        return false;
+    }
+    lru_list_.splice(lru_list_.begin(), lru_list_, iter->second.lru_iter);
+    out = iter->second.capacity;
+    return true;
+}
+
+void PathCapacityCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_list_.clear();
+}
+
+size_t PathCapacityCache::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void PathCapacityCache::SetMaxEntries(size_t max_entries) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_entries_ = max_entries > 0 ? max_entries : 1;
+    while (entries_.size() > max_entries_) {
+        entries_.erase(lru_list_.back());
+        lru_list_.pop_back();
+    }
+}
+
+std::string PathCapacityCache::SubnetKey(const common::Address& addr) {
+    const std::string& ip = addr.GetIp();
+    char buf[INET6_ADDRSTRLEN] = {0};
+
+    struct in_addr v4;
+    if (inet_pton(AF_INET, ip.c_str(), &v4) == 1) {
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(&v4);
+        bytes[3] = 0;
+        if (inet_ntop(AF_INET, &v4, buf, sizeof(buf))) {
+            return std::string(buf) + "/24";
+        }
+        return ip;
+    }
+
+    struct in6_addr v6;
+    if (inet_pton(AF_INET6, ip.c_str(), &v6) != 1) {
+        return ip;
+    }
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&v6);
+    static const uint8_t kV4MappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+    if (memcmp(bytes, kV4MappedPrefix, sizeof(kV4MappedPrefix)) == 0) {
+        bytes[15] = 0;
+        if (inet_ntop(AF_INET, bytes + 12, buf, sizeof(buf))) {
+            return std::string(buf) + "/24";
+        }
+        return ip;
+    }
+    memset(bytes + 6, 0, 10);
+    if (inet_ntop(AF_INET6, &v6, buf, sizeof(buf))) {
+        return std::string(buf) + "/48";
+    }
+    return ip;
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,61 @@
+#ifndef QUIC_CONNECTION_PATH_CAPACITY_CACHE
+#define QUIC_CONNECTION_PATH_CAPACITY_CACHE
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/network/address.h"
+#include "common/util/singleton.h"
+#include "quic/congestion_control/careful_resume.h"
+
+namespace quicx {
+namespace quic {
+
+/**
+ * @brief Process-wide memory of path capacity for Careful Resume.
+ *
+ * Clients key entries by server (SNI, or ip:port without one); servers key
+ * them by client subnet (SubnetKey()), since a client's port and often its
+ * address change between connections while the bottleneck does not. Entries
+ * expire after kLifetimeMs and the least recently used is evicted once
+ * max_entries_ is reached. Shared by all workers, hence the mutex.
+ */
+class PathCapacityCache: public common::Singleton<PathCapacityCache> {
+public:
+    PathCapacityCache() = default;
+    ~PathCapacityCache() = default;
+
+    void Store(const std::string& key, const PathCapacity& capacity);
+    // False if there is no entry or it has expired.
+    bool Lookup(const std::string& key, PathCapacity& out);
+
+    void Clear();
+    size_t Size() const;
+    void SetMaxEntries(size_t max_entries);
+
+    // "a.b.c.0/24" for IPv4 (including v4-mapped IPv6), the /48 prefix for
+    // IPv6. Falls back to the bare IP if it cannot be parsed.
+    static std::string SubnetKey(const common::Address& addr);
+
+    static constexpr uint64_t kLifetimeMs = 60ull * 60ull * 1000ull;  // 1 hour
+    static constexpr size_t kDefaultMaxEntries = 4096;
+
+private:
+    struct Entry {
+        PathCapacity capacity;
+        uint64_t stored_ms = 0;
+        std::list<std::string>::iterator lru_iter;
+    };
+
+    mutable std::mutex mutex_;
+    size_t max_entries_ = kDefaultMaxEntries;
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_list_;  // Most recently used at front
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
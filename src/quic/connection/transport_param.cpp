@@ -1,6 +1,16 @@
+#include <algorithm>
+#include <cstring>
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#endif
+
 #include "common/decode/decode.h"
 #include "common/log/log.h"
 
+#include "quic/common/constants.h"
 #include "quic/connection/transport_param.h"
 #include "quic/connection/type.h"
 
@@ -33,8 +43,89 @@ uint8_t* EncodeVersionInformation(
     }
     return pos;
 }
+
+// RFC 9000 §18.2 preferred_address:
+//   IPv4 Address (32), IPv4 Port (16), IPv6 Address (128), IPv6 Port (16),
+//   Connection ID Length (8), Connection ID (..), Stateless Reset Token (128)
+const size_t kPreferredAddressFixedLength = 4 + 2 + 16 + 2 + 1 + 16;
+const size_t kStatelessResetTokenSize = 16;
+
+// Write one family's address and port, all zeroes when the address is unset.
+uint8_t* EncodeFamilyAddress(uint8_t* pos, uint8_t* end, const common::Address& addr, int family) {
+    uint8_t ip[16] = {0};
+    uint16_t port = 0;
+    size_t ip_len = (family == AF_INET) ? 4 : 16;
+    if (addr.GetPort() != 0) {
+        if (inet_pton(family, addr.GetIp().c_str(), ip) != 1) {
+            return nullptr;
+        }
+        port = addr.GetPort();
+    }
+    pos = common::EncodeBytes(pos, end, ip, static_cast<uint32_t>(ip_len));
+    return common::FixedEncodeUint16(pos, end, port);
+}
+
+uint8_t* DecodeFamilyAddress(uint8_t* pos, uint8_t* end, common::Address& addr, int family) {
+    uint8_t* ip = nullptr;
+    uint16_t port = 0;
+    size_t ip_len = (family == AF_INET) ? 4 : 16;
+    pos = common::DecodeBytesNoCopy(pos, end, ip, static_cast<uint32_t>(ip_len));
+    if (pos == nullptr) return nullptr;
+    pos = common::FixedDecodeUint16(pos, end, port);
+    if (pos == nullptr) return nullptr;
+    if (port != 0) {
+        char text[INET6_ADDRSTRLEN] = {0};
+        if (inet_ntop(family, ip, text, sizeof(text)) == nullptr) {
+            return nullptr;
+        }
+        addr = common::Address(text, port);
+    }
+    return pos;
+}
 }  // namespace
 
+std::string PreferredAddress::Encode() const {
+    if (cid.GetLength() == 0 || stateless_reset_token.size() != kStatelessResetTokenSize) {
+        return "";
+    }
+    std::string value(kPreferredAddressFixedLength + cid.GetLength(), '\0');
+    uint8_t* pos = reinterpret_cast<uint8_t*>(&value[0]);
+    uint8_t* end = pos + value.size();
+    pos = EncodeFamilyAddress(pos, end, ipv4, AF_INET);
+    if (pos == nullptr) return "";
+    pos = EncodeFamilyAddress(pos, end, ipv6, AF_INET6);
+    if (pos == nullptr) return "";
+    pos = common::FixedEncodeUint8(pos, end, cid.GetLength());
+    pos = common::EncodeBytes(pos, end, const_cast<uint8_t*>(cid.GetID()), cid.GetLength());
+    pos = common::EncodeBytes(
+        pos, end, (uint8_t*)stateless_reset_token.data(), static_cast<uint32_t>(kStatelessResetTokenSize));
+    return pos == end ? value : "";
+}
+
+bool PreferredAddress::Decode(const std::string& value) {
+    if (value.size() < kPreferredAddressFixedLength) {
+        return false;
+    }
+    uint8_t* pos = (uint8_t*)value.data();
+    uint8_t* end = pos + value.size();
+    pos = DecodeFamilyAddress(pos, end, ipv4, AF_INET);
+    if (pos == nullptr) return false;
+    pos = DecodeFamilyAddress(pos, end, ipv6, AF_INET6);
+    if (pos == nullptr) return false;
+
+    uint8_t cid_len = 0;
+    pos = common::FixedDecodeUint8(pos, end, cid_len);
+    // a server using zero-length connection IDs must not send this parameter
+    if (pos == nullptr || cid_len == 0 || cid_len > kMaxCidLength ||
+        value.size() != kPreferredAddressFixedLength + cid_len) {
+        return false;
+    }
+    cid = ConnectionID(pos, cid_len, 1);
+    pos += cid_len;
+    stateless_reset_token.assign((const char*)pos, kStatelessResetTokenSize);
+    return true;
+}
+
 TransportParam::TransportParam():
     max_idle_timeout_(0),
     max_udp_payload_size_(0),
@@ -49,7 +140,13 @@ TransportParam::TransportParam():
     ack_delay_exponent_(3),
     max_ack_delay_(25),
     disable_active_migration_(false),
-    active_connection_id_limit_(0) {}
+    active_connection_id_limit_(0),
+    min_ack_delay_(0),
+    peer_min_ack_delay_(0),
+    max_datagram_frame_size_(0),
+    peer_max_datagram_frame_size_(0),
+    initial_max_path_id_(0),
+    peer_initial_max_path_id_(0) {}
 
 TransportParam::~TransportParam() {}
 
@@ -61,7 +158,10 @@ void TransportParam::Init(const QuicTransportParams& conf) {
     original_destination_connection_id_ = conf.original_destination_connection_id_;
     max_idle_timeout_ = conf.max_idle_timeout_ms_;
     stateless_reset_token_ = conf.stateless_reset_token_;
-    max_udp_payload_size_ = conf.max_udp_payload_size_;
+    // never advertise more than a receive buffer holds: the peer's PMTU
+    // search is capped by this value, and receivers size their buffers from
+    // it up to the jumbo pool's kMaxPlpmtu (UdpReceiver::SetMaxDatagramSize)
+    max_udp_payload_size_ = std::min<uint32_t>(conf.max_udp_payload_size_, kMaxPlpmtu);
     initial_max_data_ = conf.initial_max_data_;
     initial_max_stream_data_bidi_local_ = conf.initial_max_stream_data_bidi_local_;
     initial_max_stream_data_bidi_remote_ = conf.initial_max_stream_data_bidi_remote_;
@@ -71,8 +171,12 @@ void TransportParam::Init(const QuicTransportParams& conf) {
     ack_delay_exponent_ = conf.ack_delay_exponent_ms_;
     max_ack_delay_ = conf.max_ack_delay_ms_;
     disable_active_migration_ = conf.disable_active_migration_;
-    preferred_address_ = conf.preferred_address_;
+    // conf.preferred_address_ is an "ip:port" setting; the server turns it
+    // into the wire value with SetPreferredAddress() once it has a CID for it.
     active_connection_id_limit_ = conf.active_connection_id_limit_;
+    min_ack_delay_ = conf.min_ack_delay_us_;
+    max_datagram_frame_size_ = conf.max_datagram_frame_size_;
+    initial_max_path_id_ = conf.initial_max_path_id_;
     initial_source_connection_id_ = conf.initial_source_connection_id_;
     retry_source_connection_id_ = conf.retry_source_connection_id_;
     for (auto& listener : transport_param_listeners_) {
@@ -80,6 +184,19 @@ void TransportParam::Init(const QuicTransportParams& conf) {
     }
 }
 
+bool TransportParam::SetPreferredAddress(const PreferredAddress& addr) {
+    std::string value = addr.Encode();
+    if (value.empty()) {
+        return false;
+    }
+    preferred_address_ = std::move(value);
+    return true;
+}
+
+bool TransportParam::GetPreferredAddress(PreferredAddress& out) const {
+    return !preferred_address_.empty() && out.Decode(preferred_address_);
+}
+
 bool TransportParam::Merge(const TransportParam& tp) {
     // RFC 9000 §18: Transport parameters are mostly peer-set limits; adopt remote values directly.
     // Only max_idle_timeout uses min (RFC 9000 §10.1: "minimum of the values ... from both endpoints").
@@ -103,6 +220,12 @@ bool TransportParam::Merge(const TransportParam& tp) {
     disable_active_migration_ = disable_active_migration_ || tp.disable_active_migration_;
     preferred_address_ = tp.preferred_address_;
     active_connection_id_limit_ = tp.active_connection_id_limit_;
+    // draft-ietf-quic-ack-frequency: min_ack_delay_ stays local (see header).
+    peer_min_ack_delay_ = tp.min_ack_delay_;
+    // RFC 9221: likewise for max_datagram_frame_size.
+    peer_max_datagram_frame_size_ = tp.max_datagram_frame_size_;
+    // draft-ietf-quic-multipath: and for initial_max_path_id.
+    peer_initial_max_path_id_ = tp.initial_max_path_id_;
     initial_source_connection_id_ = tp.initial_source_connection_id_;
     retry_source_connection_id_ = tp.retry_source_connection_id_;
 
@@ -219,6 +342,23 @@ bool TransportParam::Encode(const common::BufferSpan& buffer, size_t& bytes_writ
         if (pos == nullptr) return false;
     }
 
+    if (min_ack_delay_) {
+        pos = EncodeUint(pos, end, min_ack_delay_, static_cast<uint32_t>(TransportParamType::kMinAckDelay));
+        if (pos == nullptr) return false;
+    }
+
+    if (max_datagram_frame_size_) {
+        pos = EncodeUint(
+            pos, end, max_datagram_frame_size_, static_cast<uint32_t>(TransportParamType::kMaxDatagramFrameSize));
+        if (pos == nullptr) return false;
+    }
+
+    if (initial_max_path_id_) {
+        pos = EncodeUint(
+            pos, end, initial_max_path_id_, static_cast<uint64_t>(TransportParamType::kInitialMaxPathId));
+        if (pos == nullptr) return false;
+    }
+
     if (!initial_source_connection_id_.empty()) {
         pos = EncodeString(pos, end, initial_source_connection_id_,
             static_cast<uint32_t>(TransportParamType::kInitialSourceConnectionId));
@@ -309,14 +449,32 @@ bool TransportParam::Decode(const common::BufferSpan& buffer) {
                 pos = DecodeBool(pos, end, disable_active_migration_);
                 if (pos == nullptr) return false;
                 break;
-            case TransportParamType::kPreferredAddress:
+            case TransportParamType::kPreferredAddress: {
                 pos = DecodeString(pos, end, preferred_address_);
                 if (pos == nullptr) return false;
+                PreferredAddress checked;
+                if (!checked.Decode(preferred_address_)) {
+                    LOG_ERROR("TransportParam: malformed preferred_address, length %zu", preferred_address_.size());
+                    return false;
+                }
                 break;
+            }
             case TransportParamType::kActiveConnectionIdLimit:
                 pos = DecodeUint(pos, end, active_connection_id_limit_);
                 if (pos == nullptr) return false;
                 break;
+            case TransportParamType::kMinAckDelay:
+                pos = DecodeUint(pos, end, min_ack_delay_);
+                if (pos == nullptr) return false;
+                break;
+            case TransportParamType::kMaxDatagramFrameSize:
+                pos = DecodeUint(pos, end, max_datagram_frame_size_);
+                if (pos == nullptr) return false;
+                break;
+            case TransportParamType::kInitialMaxPathId:
+                pos = DecodeUint(pos, end, initial_max_path_id_);
+                if (pos == nullptr) return false;
+                break;
             case TransportParamType::kInitialSourceConnectionId:
                 pos = DecodeString(pos, end, initial_source_connection_id_);
                 if (pos == nullptr) return false;
@@ -394,7 +552,7 @@ uint32_t TransportParam::EncodeSize() {
     uint32_t size = 0;
 
     // Each uint param encodes as: varint(type) + varint(varint_len(value)) + varint(value)
-    auto uint_param_size = [](uint32_t type, uint64_t value) -> uint32_t {
+    auto uint_param_size = [](uint64_t type, uint64_t value) -> uint32_t {
         uint16_t value_varint_len = common::GetEncodeVarintLength(value);
         return common::GetEncodeVarintLength(type)
              + common::GetEncodeVarintLength(value_varint_len)
@@ -471,6 +629,17 @@ uint32_t TransportParam::EncodeSize() {
         size += uint_param_size(
             static_cast<uint32_t>(TransportParamType::kActiveConnectionIdLimit), active_connection_id_limit_);
     }
+    if (min_ack_delay_) {
+        size += uint_param_size(static_cast<uint32_t>(TransportParamType::kMinAckDelay), min_ack_delay_);
+    }
+    if (max_datagram_frame_size_) {
+        size += uint_param_size(
+            static_cast<uint32_t>(TransportParamType::kMaxDatagramFrameSize), max_datagram_frame_size_);
+    }
+    if (initial_max_path_id_) {
+        size += uint_param_size(
+            static_cast<uint64_t>(TransportParamType::kInitialMaxPathId), initial_max_path_id_);
+    }
     if (!initial_source_connection_id_.empty()) {
         size += string_param_size(
             static_cast<uint32_t>(TransportParamType::kInitialSourceConnectionId), initial_source_connection_id_);
@@ -491,7 +660,7 @@ uint32_t TransportParam::EncodeSize() {
     return size;
 }
 
-uint8_t* TransportParam::EncodeUint(uint8_t* start, uint8_t* end, uint64_t value, uint32_t type) {
+uint8_t* TransportParam::EncodeUint(uint8_t* start, uint8_t* end, uint64_t value, uint64_t type) {
     start = common::EncodeVarint(start, end, type);
     start = common::EncodeVarint(start, end, common::GetEncodeVarintLength(value));
     start = common::EncodeVarint(start, end, value);
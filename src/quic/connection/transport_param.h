@@ -6,11 +6,33 @@
 #include <vector>
 
 #include "common/buffer/buffer_span.h"
+#include "common/network/address.h"
+#include "quic/connection/connection_id.h"
 #include <quicx/quic/type.h>
 
 namespace quicx {
 namespace quic {
 
+/**
+ * @brief Value of the preferred_address transport parameter (RFC 9000 §18.2)
+ *
+ * An alternative server address per family, the connection ID (sequence
+ * number 1) the client uses once it migrates there, and that connection
+ * ID's stateless reset token. A family the server has no address for is
+ * sent as all zeroes and decodes to an Address with port 0.
+ */
+struct PreferredAddress {
+    common::Address ipv4;
+    common::Address ipv6;
+    ConnectionID cid;
+    std::string stateless_reset_token;  // 16 bytes
+
+    // binary form carried in the transport parameter, empty if a field is invalid
+    std::string Encode() const;
+    // false on a wrong length or a zero-length connection ID
+    bool Decode(const std::string& value);
+};
+
 class TransportParamConfig;
 class TransportParam {
 public:
@@ -53,13 +75,31 @@ public:
     uint64_t GetackDelayExponent() const { return ack_delay_exponent_; }
     uint64_t GetMaxAckDelay() const { return max_ack_delay_; }
     bool GetDisableActiveMigration() const { return disable_active_migration_; }
+    // raw preferred_address value, empty if absent
     const std::string& GetPreferredAddress() const { return preferred_address_; }
+    bool GetPreferredAddress(PreferredAddress& out) const;
     uint64_t GetActiveConnectionIdLimit() const { return active_connection_id_limit_; }
-
-    // Server-only: Set preferred address for client migration suggestion
-    // Format: "ip:port" (e.g., "192.168.1.100:8443")
-    // The server advertises this address to suggest the client migrate to it
-    void SetPreferredAddress(const std::string& addr) { preferred_address_ = addr; }
+    // draft-ietf-quic-ack-frequency min_ack_delay in microseconds, 0 if absent.
+    // Merge() keeps the local value here and stores the peer's separately: the
+    // local one bounds ACK_FREQUENCY frames we accept, the peer's gates whether
+    // we may send them at all.
+    uint64_t GetMinAckDelay() const { return min_ack_delay_; }
+    uint64_t GetPeerMinAckDelay() const { return peer_min_ack_delay_; }
+    // RFC 9221 max_datagram_frame_size, 0 if absent. Kept apart like
+    // min_ack_delay: the local value bounds DATAGRAM frames we accept, the
+    // peer's bounds the ones we may send.
+    uint64_t GetMaxDatagramFrameSize() const { return max_datagram_frame_size_; }
+    uint64_t GetPeerMaxDatagramFrameSize() const { return peer_max_datagram_frame_size_; }
+    // draft-ietf-quic-multipath initial_max_path_id, 0 if absent. Kept apart
+    // like the two above: the local value bounds the path IDs the peer may
+    // open, the peer's bounds ours. Multipath is in use only if both are set.
+    uint64_t GetInitialMaxPathId() const { return initial_max_path_id_; }
+    uint64_t GetPeerInitialMaxPathId() const { return peer_initial_max_path_id_; }
+    bool IsMultipathEnabled() const { return initial_max_path_id_ > 0 && peer_initial_max_path_id_ > 0; }
+
+    // Server-only: advertise an address the client should migrate to after
+    // the handshake (RFC 9000 §9.6)
+    bool SetPreferredAddress(const PreferredAddress& addr);
     const std::string& GetInitialSourceConnectionId() const { return initial_source_connection_id_; }
     const std::string& GetRetrySourceConnectionId() const { return retry_source_connection_id_; }
 
@@ -79,7 +119,7 @@ private:
     /*
      * internal serialization and deserialization operations
      */
-    uint8_t* EncodeUint(uint8_t* start, uint8_t* end, uint64_t value, uint32_t type);
+    uint8_t* EncodeUint(uint8_t* start, uint8_t* end, uint64_t value, uint64_t type);
     uint8_t* EncodeString(uint8_t* start, uint8_t* end, const std::string& value, uint32_t type);
     uint8_t* EncodeBool(uint8_t* start, uint8_t* end, bool value, uint32_t type);
     uint8_t* DecodeUint(uint8_t* start, uint8_t* end, uint64_t& value);
@@ -105,6 +145,12 @@ private:
     bool disable_active_migration_;
     std::string preferred_address_;  // no client
     uint64_t active_connection_id_limit_;
+    uint64_t min_ack_delay_;       // microseconds
+    uint64_t peer_min_ack_delay_;  // peer's min_ack_delay (populated during Merge)
+    uint64_t max_datagram_frame_size_;
+    uint64_t peer_max_datagram_frame_size_;  // peer's max_datagram_frame_size (populated during Merge)
+    uint64_t initial_max_path_id_;
+    uint64_t peer_initial_max_path_id_;  // peer's initial_max_path_id (populated during Merge)
     std::string initial_source_connection_id_;  // no client
     std::string retry_source_connection_id_;    // no client
 
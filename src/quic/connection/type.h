@@ -15,7 +15,7 @@ enum class SendOperation {
     kNextPeriod            = 2, // send data in next period
 };
 
-enum class TransportParamType : uint32_t {
+enum class TransportParamType : uint64_t {
     kOriginalDestinationConnectionId   = 0x00, // This parameter is the value of the Destination Connection ID field from the first Initial packet sent by the client;
     kMaxIdleTimeout                    = 0x01, // The maximum idle timeout is a value in milliseconds that is encoded as an integer
     kStatelessResetToken               = 0x02, // A stateless reset token is used in verifying a stateless reset
@@ -41,7 +41,13 @@ enum class TransportParamType : uint32_t {
     kActiveConnectionIdLimit           = 0x0e, // This is an integer value specifying the maximum number of connection IDs from the peer that an endpoint is willing to store
     kInitialSourceConnectionId         = 0x0f, // This is the value that the endpoint included in the Source Connection ID field of the first Initial packet it sends for the connection
     kRetrySourceConnectionId           = 0x10, // This is the value that the server included in the Source Connection ID field of a Retry packet
+    kMaxDatagramFrameSize              = 0x20, // RFC 9221: the maximum size of a DATAGRAM frame (including the frame type, length, and payload)
+                                               // the endpoint is willing to receive, in bytes. Absent or 0 means DATAGRAM frames are not supported.
     kVersionInformation                = 0x11, // RFC 9368 Compatible Version Negotiation: Chosen Version (32) + Available Versions (32) *
+    kMinAckDelay                       = 0xff04de1b, // draft-ietf-quic-ack-frequency: the minimum amount of time in microseconds by which
+                                               // the endpoint is able to delay an acknowledgment. Its presence means ACK_FREQUENCY is supported.
+    kInitialMaxPathId                  = 0x0f739bbc1b666d0c, // draft-ietf-quic-multipath: the largest path ID the endpoint is willing to
+                                               // maintain at the start of the connection. Its presence means multipath is supported.
 };
 
 }
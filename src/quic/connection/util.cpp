@@ -7,7 +7,43 @@ namespace quicx {
 namespace quic {
 
 bool IsAckElictingPacket(uint32_t frame_type) {
-    return ((frame_type) & ~(FrameTypeBit::kAckBit | FrameTypeBit::kAckEcnBit | FrameTypeBit::kPaddingBit | FrameTypeBit::kConnectionCloseBit));
+    return ((frame_type) & ~(FrameTypeBit::kAckBit | FrameTypeBit::kAckEcnBit | FrameTypeBit::kPathAckBit |
+                                FrameTypeBit::kPaddingBit | FrameTypeBit::kConnectionCloseBit));
+}
+
+bool IsProbingPacket(uint32_t frame_type) {
+    return (frame_type & ~(FrameTypeBit::kPathChallengeBit | FrameTypeBit::kPathResponseBit |
+                              FrameTypeBit::kNewConnectionIdBit | FrameTypeBit::kPaddingBit)) == 0;
+}
+
+bool IsRetransmittableFrame(uint16_t frame_type) {
+    switch (frame_type) {
+    case FrameType::kResetStream:
+    case FrameType::kStopSending:
+    case FrameType::kCrypto:
+    case FrameType::kNewToken:
+    case FrameType::kMaxData:
+    case FrameType::kMaxStreamData:
+    case FrameType::kMaxStreamsBidirectional:
+    case FrameType::kMaxStreamsUnidirectional:
+    case FrameType::kDataBlocked:
+    case FrameType::kStreamDataBlocked:
+    case FrameType::kStreamsBlockedBidirectional:
+    case FrameType::kStreamsBlockedUnidirectional:
+    case FrameType::kNewConnectionId:
+    case FrameType::kRetireConnectionId:
+    case FrameType::kHandshakeDone:
+    case FrameType::kAckFrequency:
+    case FrameType::kPathAbandon:
+    case FrameType::kPathStatusBackup:
+    case FrameType::kPathStatusAvailable:
+    case FrameType::kPathNewConnectionId:
+    case FrameType::kPathRetireConnectionId:
+    case FrameType::kMaxPathId:
+        return true;
+    default:
+        return false;
+    }
 }
 
 PacketNumberSpace CryptoLevel2PacketNumberSpace(uint16_t level) {
@@ -47,6 +83,18 @@ const std::string FrameType2String(uint16_t frame_type) {
         case FrameType::kStopSending:                  return "STOP_SENDING";
         case FrameType::kStreamDataBlocked:            return "STREAM_DATA_BLOCKED";
         case FrameType::kMaxStreamData:                return "MAX_STREAM_DATA";
+        case FrameType::kImmediateAck:                 return "IMMEDIATE_ACK";
+        case FrameType::kAckFrequency:                 return "ACK_FREQUENCY";
+        case FrameType::kDatagram:
+        case FrameType::kDatagramWithLength:           return "DATAGRAM";
+        case FrameType::kPathAck:                      return "PATH_ACK";
+        case FrameType::kPathAckEcn:                   return "PATH_ACK_ECN";
+        case FrameType::kPathAbandon:                  return "PATH_ABANDON";
+        case FrameType::kPathStatusBackup:             return "PATH_STATUS_BACKUP";
+        case FrameType::kPathStatusAvailable:          return "PATH_STATUS_AVAILABLE";
+        case FrameType::kPathNewConnectionId:          return "PATH_NEW_CONNECTION_ID";
+        case FrameType::kPathRetireConnectionId:       return "PATH_RETIRE_CONNECTION_ID";
+        case FrameType::kMaxPathId:                    return "MAX_PATH_ID";
         default:
             if (StreamFrame::IsStreamFrame(frame_type)) {
                 return "STREAM_DATA";
@@ -10,6 +10,16 @@ namespace quic {
 
 bool IsAckElictingPacket(uint32_t frame_type);
 
+// RFC 9000 §9.1: a packet carrying only PATH_CHALLENGE, PATH_RESPONSE,
+// NEW_CONNECTION_ID and PADDING frames is a probing packet.
+bool IsProbingPacket(uint32_t frame_type);
+
+// RFC 9000 §13.3: whether a lost frame of this type has to be sent again as
+// is. STREAM data is excluded (the stream resends the lost range itself), as
+// are frames that are never retransmitted (PADDING, PING, ACK,
+// PATH_CHALLENGE/RESPONSE, CONNECTION_CLOSE, IMMEDIATE_ACK).
+bool IsRetransmittableFrame(uint16_t frame_type);
+
 PacketNumberSpace CryptoLevel2PacketNumberSpace(uint16_t level);
 
 const std::string FrameType2String(uint16_t frame_type);
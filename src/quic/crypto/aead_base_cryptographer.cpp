@@ -263,7 +263,7 @@ ICryptographer::Result AeadBaseCryptographer::InstallInitSecretWithVersion(
 }
 
 ICryptographer::Result AeadBaseCryptographer::DecryptPacket(uint64_t pkt_number, common::BufferSpan& associated_data,
-    common::BufferSpan& ciphertext, std::shared_ptr<common::IBuffer> out_plaintext) {
+    common::BufferSpan& ciphertext, std::shared_ptr<common::IBuffer> out_plaintext, uint32_t path_id) {
     if (read_secret_.key_.empty() || read_secret_.iv_.empty()) {
         LOG_ERROR("decrypt packet but not install secret");
         return Result::kNotInitialized;
@@ -271,7 +271,7 @@ ICryptographer::Result AeadBaseCryptographer::DecryptPacket(uint64_t pkt_number,
 
     // get nonce
     uint8_t nonce[kPacketNonceLength] = {0};
-    MakePacketNonce(nonce, read_secret_.iv_, pkt_number);
+    MakePacketNonce(nonce, read_secret_.iv_, pkt_number, path_id);
 
     // encrypt
     EVP_AEAD_CTX* raw = read_aead_ctx_.get();
@@ -300,14 +300,14 @@ ICryptographer::Result AeadBaseCryptographer::DecryptPacket(uint64_t pkt_number,
 }
 
 ICryptographer::Result AeadBaseCryptographer::DecryptPacketWithPrevKey(uint64_t pkt_number, common::BufferSpan& associated_data,
-    common::BufferSpan& ciphertext, std::shared_ptr<common::IBuffer> out_plaintext) {
+    common::BufferSpan& ciphertext, std::shared_ptr<common::IBuffer> out_plaintext, uint32_t path_id) {
     if (prev_read_secret_.key_.empty() || prev_read_secret_.iv_.empty()) {
         return Result::kNotInitialized;
     }
 
     // get nonce using previous IV
     uint8_t nonce[kPacketNonceLength] = {0};
-    MakePacketNonce(nonce, prev_read_secret_.iv_, pkt_number);
+    MakePacketNonce(nonce, prev_read_secret_.iv_, pkt_number, path_id);
 
     // use previous read AEAD context
     EVP_AEAD_CTX* raw = prev_read_aead_ctx_.get();
@@ -333,7 +333,7 @@ ICryptographer::Result AeadBaseCryptographer::DecryptPacketWithPrevKey(uint64_t
 }
 
 ICryptographer::Result AeadBaseCryptographer::EncryptPacket(uint64_t pkt_number, common::BufferSpan& associated_data,
-    common::BufferSpan& plaintext, std::shared_ptr<common::IBuffer> out_ciphertext) {
+    common::BufferSpan& plaintext, std::shared_ptr<common::IBuffer> out_ciphertext, uint32_t path_id) {
     if (write_secret_.key_.empty() || write_secret_.iv_.empty()) {
         LOG_ERROR("encrypt packet but not install secret");
         return Result::kNotInitialized;
@@ -341,7 +341,7 @@ ICryptographer::Result AeadBaseCryptographer::EncryptPacket(uint64_t pkt_number,
 
     // get nonce
     uint8_t nonce[kPacketNonceLength] = {0};
-    MakePacketNonce(nonce, write_secret_.iv_, pkt_number);
+    MakePacketNonce(nonce, write_secret_.iv_, pkt_number, path_id);
 
     // encrypt
     EVP_AEAD_CTX* raw = write_aead_ctx_.get();
@@ -515,7 +515,8 @@ bool AeadBaseCryptographer::MakeHeaderProtectMask(common::BufferSpan& sample, st
     }
 }
 
-void AeadBaseCryptographer::MakePacketNonce(uint8_t* nonce, std::vector<uint8_t>& iv, uint64_t pkt_number) {
+void AeadBaseCryptographer::MakePacketNonce(
+    uint8_t* nonce, std::vector<uint8_t>& iv, uint64_t pkt_number, uint32_t path_id) {
     memcpy(nonce, iv.data(), iv.size());
     // Convert packet number to big-endian as per RFC 9001
     uint64_t be_pn = ((pkt_number & 0x00000000000000FFull) << 56) | ((pkt_number & 0x000000000000FF00ull) << 40) |
@@ -527,6 +528,12 @@ void AeadBaseCryptographer::MakePacketNonce(uint8_t* nonce, std::vector<uint8_t>
     for (size_t i = 0; i < 8; ++i) {
         nonce[iv.size() - 8 + i] ^= ((uint8_t*)&be_pn)[i];
     }
+
+    // draft-ietf-quic-multipath: the 32-bit path ID, big-endian, sits right
+    // before the packet number
+    for (size_t i = 0; i < 4; ++i) {
+        nonce[iv.size() - 12 + i] ^= static_cast<uint8_t>(path_id >> (24 - 8 * i));
+    }
 }
 
 void AeadBaseCryptographer::CleanSecret(Secret& s) {
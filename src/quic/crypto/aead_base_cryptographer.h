@@ -25,14 +25,14 @@ public:
         const uint8_t* secret, size_t secret_len, uint32_t version, bool is_server) override;
 
     virtual Result DecryptPacket(uint64_t pkt_number, common::BufferSpan& associated_data,
-        common::BufferSpan& ciphertext, std::shared_ptr<common::IBuffer> out_plaintext) override;
+        common::BufferSpan& ciphertext, std::shared_ptr<common::IBuffer> out_plaintext, uint32_t path_id = 0) override;
 
     // RFC 9001 §6: Decrypt using previous read key (for reordered packets after Key Update)
     virtual Result DecryptPacketWithPrevKey(uint64_t pkt_number, common::BufferSpan& associated_data,
-        common::BufferSpan& ciphertext, std::shared_ptr<common::IBuffer> out_plaintext) override;
+        common::BufferSpan& ciphertext, std::shared_ptr<common::IBuffer> out_plaintext, uint32_t path_id = 0) override;
 
     virtual Result EncryptPacket(uint64_t pkt_number, common::BufferSpan& associated_data,
-        common::BufferSpan& plaintext, std::shared_ptr<common::IBuffer> out_ciphertext) override;
+        common::BufferSpan& plaintext, std::shared_ptr<common::IBuffer> out_ciphertext, uint32_t path_id = 0) override;
 
     virtual Result DecryptHeader(common::BufferSpan& ciphertext, common::BufferSpan& sample, uint8_t pn_offset,
         uint8_t& out_packet_num_len, bool is_short) override;
@@ -72,7 +72,7 @@ protected:
     // available.
     virtual bool MakeHeaderProtectMask(common::BufferSpan& sample, std::vector<uint8_t>& key, uint8_t* out_mask,
         size_t mask_cap, size_t& out_mask_length, EVP_CIPHER_CTX* cached_hp_ctx = nullptr);
-    void MakePacketNonce(uint8_t* nonce, std::vector<uint8_t>& iv, uint64_t pkt_number);
+    void MakePacketNonce(uint8_t* nonce, std::vector<uint8_t>& iv, uint64_t pkt_number, uint32_t path_id = 0);
 
 protected:
     struct Secret {
@@ -43,15 +43,18 @@ public:
     // Version-aware Initial secret installation (RFC 9369 support)
     virtual Result InstallInitSecretWithVersion(const uint8_t* secret, size_t secret_len, uint32_t version, bool is_server) = 0;
 
+    // draft-ietf-quic-multipath: path_id goes into the nonce of 1-RTT packets,
+    // so each path's packet number space gets its own nonces. Path 0 gives the
+    // RFC 9001 nonce.
     virtual Result DecryptPacket(uint64_t pn, common::BufferSpan& associated_data, common::BufferSpan& ciphertext,
-                             std::shared_ptr<common::IBuffer> out_plaintext) = 0;
+                             std::shared_ptr<common::IBuffer> out_plaintext, uint32_t path_id = 0) = 0;
 
     // RFC 9001 §6: Decrypt packet using the previous read key (for reordered packets after Key Update)
     virtual Result DecryptPacketWithPrevKey(uint64_t pn, common::BufferSpan& associated_data, common::BufferSpan& ciphertext,
-                             std::shared_ptr<common::IBuffer> out_plaintext) = 0;
+                             std::shared_ptr<common::IBuffer> out_plaintext, uint32_t path_id = 0) = 0;
 
     virtual Result EncryptPacket(uint64_t pn, common::BufferSpan& associated_data, common::BufferSpan& plaintext,
-                             std::shared_ptr<common::IBuffer> out_ciphertext) = 0;
+                             std::shared_ptr<common::IBuffer> out_ciphertext, uint32_t path_id = 0) = 0;
 
     virtual Result DecryptHeader(common::BufferSpan& ciphertext, common::BufferSpan& sample, uint8_t pn_offset,
                              uint8_t& out_packet_num_len, bool is_short) = 0;
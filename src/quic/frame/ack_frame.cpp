@@ -27,6 +27,10 @@ bool AckFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
 
     common::BufferEncodeWrapper wrapper(buffer);
     CHECK_ENCODE_ERROR(wrapper.EncodeVarint(frame_type_), "failed to encode frame type");
+    return EncodeAckFields(wrapper);
+}
+
+bool AckFrame::EncodeAckFields(common::BufferEncodeWrapper& wrapper) {
     // Per RFC 9000 ACK frame format:
     // Largest Acknowledged, ACK Delay, ACK Range Count, First ACK Range
     CHECK_ENCODE_ERROR(wrapper.EncodeVarint(largest_acknowledged_), "failed to encode largest acknowledged");
@@ -59,30 +63,9 @@ bool AckFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type) {
             }
         }
 
-        // Per RFC 9000 ACK frame format:
-        // Largest Acknowledged, ACK Delay, ACK Range Count, First ACK Range
-        CHECK_DECODE_ERROR(wrapper.DecodeVarint(largest_acknowledged_), "failed to decode largest acknowledged");
-        CHECK_DECODE_ERROR(wrapper.DecodeVarint(ack_delay_), "failed to decode ack delay");
-        uint64_t ack_range_count = 0;
-        CHECK_DECODE_ERROR(wrapper.DecodeVarint(ack_range_count), "failed to decode ack range count");
-
-        // RFC 9000: Limit ack_range_count to prevent memory exhaustion from malicious packets.
-        // A reasonable upper bound: no more than 256 ACK ranges in a single frame.
-        static constexpr uint64_t kMaxAckRangeCount = 256;
-        if (ack_range_count > kMaxAckRangeCount) {
-            LOG_ERROR("ack range count too large. count:%llu, max:%llu", ack_range_count, kMaxAckRangeCount);
+        if (!DecodeAckFields(wrapper)) {
             return false;
         }
-
-        CHECK_DECODE_ERROR(wrapper.DecodeVarint(first_ack_range_), "failed to decode first ack range");
-
-        uint64_t gap;
-        uint64_t range;
-        for (uint64_t i = 0; i < ack_range_count; i++) {
-            CHECK_DECODE_ERROR(wrapper.DecodeVarint(gap), "failed to decode gap");
-            CHECK_DECODE_ERROR(wrapper.DecodeVarint(range), "failed to decode range");
-            ack_ranges_.emplace_back(AckRange(gap, range));
-        }
     }  // wrapper destroyed here, Flush() called
 
     uint32_t buffer_len_after = buffer->GetDataLength();
@@ -91,11 +74,42 @@ bool AckFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type) {
     return true;
 }
 
+bool AckFrame::DecodeAckFields(common::BufferDecodeWrapper& wrapper) {
+    // Per RFC 9000 ACK frame format:
+    // Largest Acknowledged, ACK Delay, ACK Range Count, First ACK Range
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(largest_acknowledged_), "failed to decode largest acknowledged");
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(ack_delay_), "failed to decode ack delay");
+    uint64_t ack_range_count = 0;
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(ack_range_count), "failed to decode ack range count");
+
+    // RFC 9000: Limit ack_range_count to prevent memory exhaustion from malicious packets.
+    // A reasonable upper bound: no more than 256 ACK ranges in a single frame.
+    static constexpr uint64_t kMaxAckRangeCount = 256;
+    if (ack_range_count > kMaxAckRangeCount) {
+        LOG_ERROR("ack range count too large. count:%llu, max:%llu", ack_range_count, kMaxAckRangeCount);
+        return false;
+    }
+
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(first_ack_range_), "failed to decode first ack range");
+
+    uint64_t gap;
+    uint64_t range;
+    for (uint64_t i = 0; i < ack_range_count; i++) {
+        CHECK_DECODE_ERROR(wrapper.DecodeVarint(gap), "failed to decode gap");
+        CHECK_DECODE_ERROR(wrapper.DecodeVarint(range), "failed to decode range");
+        ack_ranges_.emplace_back(AckRange(gap, range));
+    }
+    return true;
+}
+
 uint32_t AckFrame::EncodeSize() {
     // frame type encoded as varint
-    uint32_t size = common::GetEncodeVarintLength(frame_type_);
+    return common::GetEncodeVarintLength(frame_type_) + AckFieldsSize();
+}
+
+uint32_t AckFrame::AckFieldsSize() {
     // Largest Acknowledged
-    size += common::GetEncodeVarintLength(largest_acknowledged_);
+    uint32_t size = common::GetEncodeVarintLength(largest_acknowledged_);
     // ACK Delay
     size += common::GetEncodeVarintLength(ack_delay_);
     // ACK Range Count
@@ -122,6 +136,12 @@ AckEcnFrame::AckEcnFrame():
     ect_1_(0),
     ecn_ce_(0) {}
 
+AckEcnFrame::AckEcnFrame(FrameType ft):
+    AckFrame(ft),
+    ect_0_(0),
+    ect_1_(0),
+    ecn_ce_(0) {}
+
 AckEcnFrame::~AckEcnFrame() {}
 
 bool AckEcnFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
@@ -144,6 +164,10 @@ bool AckEcnFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
     }
 
     common::BufferEncodeWrapper wrapper(buffer);
+    return EncodeEcnCounts(wrapper);
+}
+
+bool AckEcnFrame::EncodeEcnCounts(common::BufferEncodeWrapper& wrapper) {
     CHECK_ENCODE_ERROR(wrapper.EncodeVarint(ect_0_), "failed to encode ect 0");
     CHECK_ENCODE_ERROR(wrapper.EncodeVarint(ect_1_), "failed to encode ect 1");
     CHECK_ENCODE_ERROR(wrapper.EncodeVarint(ecn_ce_), "failed to encode ecn ce");
@@ -157,6 +181,10 @@ bool AckEcnFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type
     }
 
     common::BufferDecodeWrapper wrapper(buffer);
+    return DecodeEcnCounts(wrapper);
+}
+
+bool AckEcnFrame::DecodeEcnCounts(common::BufferDecodeWrapper& wrapper) {
     CHECK_DECODE_ERROR(wrapper.DecodeVarint(ect_0_), "failed to decode ect 0");
     CHECK_DECODE_ERROR(wrapper.DecodeVarint(ect_1_), "failed to decode ect 1");
     CHECK_DECODE_ERROR(wrapper.DecodeVarint(ecn_ce_), "failed to decode ecn ce");
@@ -165,11 +193,15 @@ bool AckEcnFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type
 }
 
 uint32_t AckEcnFrame::EncodeSize() {
+    return AckFrame::EncodeSize() + EcnCountsSize();
+}
+
+uint32_t AckEcnFrame::EcnCountsSize() {
     // Calculate the actual size needed for ECN fields using varint encoding
     uint32_t ect0_size = common::GetEncodeVarintLength(ect_0_);
     uint32_t ect1_size = common::GetEncodeVarintLength(ect_1_);
     uint32_t ecn_ce_size = common::GetEncodeVarintLength(ecn_ce_);
-    return AckFrame::EncodeSize() + ect0_size + ect1_size + ecn_ce_size;
+    return ect0_size + ect1_size + ecn_ce_size;
 }
 
 }  // namespace quic
@@ -6,6 +6,8 @@
 
 #include "quic/frame/if_frame.h"
 #include "quic/frame/ack_range.h"
+#include "common/buffer/buffer_decode_wrapper.h"
+#include "common/buffer/buffer_encode_wrapper.h"
 
 namespace quicx {
 namespace quic {
@@ -31,10 +33,16 @@ public:
 
     void AddAckRange(uint64_t gap, uint64_t range) { ack_ranges_.emplace_back(AckRange(gap, range)); }
     const std::vector<AckRange>& GetAckRange() { return ack_ranges_; }
+    void ClearAckRange() { ack_ranges_.clear(); }
 
 protected:
     AckFrame(FrameType ft);
 
+    // The fields after the frame type, shared with PATH_ACK.
+    bool EncodeAckFields(common::BufferEncodeWrapper& wrapper);
+    bool DecodeAckFields(common::BufferDecodeWrapper& wrapper);
+    uint32_t AckFieldsSize();
+
 private:
     uint64_t largest_acknowledged_; // A variable-length integer representing the largest packet number the peer is acknowledging.
     uint32_t ack_delay_;            // the time delta in microseconds between when this ACK was sent and when the largest acknowledged packet.
@@ -62,6 +70,13 @@ public:
     void SetEcnCe(uint64_t ce) { ecn_ce_ = ce; }
     uint64_t GetEcnCe() { return ecn_ce_; }
 
+protected:
+    AckEcnFrame(FrameType ft);
+
+    bool EncodeEcnCounts(common::BufferEncodeWrapper& wrapper);
+    bool DecodeEcnCounts(common::BufferDecodeWrapper& wrapper);
+    uint32_t EcnCountsSize();
+
 private:
     uint64_t ect_0_;    // the total number of packets received with the ECT(0) codepoint in the packet number space of the ACK frame.
     uint64_t ect_1_;    // the total number of packets received with the ECT(1) codepoint in the packet number space of the ACK frame.
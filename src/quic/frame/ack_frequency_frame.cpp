@@ -0,0 +1,62 @@
+#include "quic/frame/ack_frequency_frame.h"
+#include "common/buffer/buffer_decode_wrapper.h"
+#include "common/buffer/buffer_encode_wrapper.h"
+#include "common/log/log.h"
+
+namespace quicx {
+namespace quic {
+
+AckFrequencyFrame::AckFrequencyFrame():
+    IFrame(FrameType::kAckFrequency),
+    sequence_number_(0),
+    ack_eliciting_threshold_(1),
+    request_max_ack_delay_(0),
+    reordering_threshold_(1) {}
+
+AckFrequencyFrame::~AckFrequencyFrame() {}
+
+bool AckFrequencyFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
+    uint32_t need_size = EncodeSize();
+    if (need_size > buffer->GetFreeLength()) {
+        LOG_ERROR(
+            "insufficient remaining cache space. remain_size:%d, need_size:%d", buffer->GetFreeLength(), need_size);
+        return false;
+    }
+
+    common::BufferEncodeWrapper wrapper(buffer);
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(frame_type_), "failed to encode frame type");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(sequence_number_), "failed to encode sequence number");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(ack_eliciting_threshold_), "failed to encode ack eliciting threshold");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(request_max_ack_delay_), "failed to encode request max ack delay");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(reordering_threshold_), "failed to encode reordering threshold");
+
+    return true;
+}
+
+bool AckFrequencyFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type) {
+    common::BufferDecodeWrapper wrapper(buffer);
+
+    if (with_type) {
+        uint64_t type = 0;
+        CHECK_DECODE_ERROR(wrapper.DecodeVarint(type), "failed to decode frame type");
+        frame_type_ = static_cast<uint16_t>(type);
+        if (frame_type_ != FrameType::kAckFrequency) {
+            LOG_ERROR("invalid frame type. frame_type:%d", frame_type_);
+            return false;
+        }
+    }
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(sequence_number_), "failed to decode sequence number");
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(ack_eliciting_threshold_), "failed to decode ack eliciting threshold");
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(request_max_ack_delay_), "failed to decode request max ack delay");
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(reordering_threshold_), "failed to decode reordering threshold");
+    return true;
+}
+
+uint32_t AckFrequencyFrame::EncodeSize() {
+    return common::GetEncodeVarintLength(frame_type_) + common::GetEncodeVarintLength(sequence_number_) +
+           common::GetEncodeVarintLength(ack_eliciting_threshold_) +
+           common::GetEncodeVarintLength(request_max_ack_delay_) + common::GetEncodeVarintLength(reordering_threshold_);
+}
+
+}  // namespace quic
+}  // namespace quicx
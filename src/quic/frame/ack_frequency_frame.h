@@ -0,0 +1,47 @@
+#ifndef QUIC_FRAME_ACK_FREQUENCY_FRAME
+#define QUIC_FRAME_ACK_FREQUENCY_FRAME
+
+#include <cstdint>
+#include "quic/frame/if_frame.h"
+
+namespace quicx {
+namespace quic {
+
+// draft-ietf-quic-ack-frequency: lets the sender of this frame tell its peer
+// how often to acknowledge. Only valid if the receiver advertised the
+// min_ack_delay transport parameter.
+class AckFrequencyFrame:
+    public IFrame {
+public:
+    AckFrequencyFrame();
+    ~AckFrequencyFrame();
+
+    virtual bool Encode(std::shared_ptr<common::IBuffer> buffer);
+    virtual bool Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type = false);
+    virtual uint32_t EncodeSize();
+    // the frame type (0xaf) is out of the bit field range, see kAckFrequencyBit
+    virtual uint32_t GetFrameTypeBit() { return FrameTypeBit::kAckFrequencyBit; }
+
+    void SetSequenceNumber(uint64_t sequence) { sequence_number_ = sequence; }
+    uint64_t GetSequenceNumber() { return sequence_number_; }
+
+    void SetAckElicitingThreshold(uint64_t threshold) { ack_eliciting_threshold_ = threshold; }
+    uint64_t GetAckElicitingThreshold() { return ack_eliciting_threshold_; }
+
+    void SetRequestMaxAckDelay(uint64_t delay_us) { request_max_ack_delay_ = delay_us; }
+    uint64_t GetRequestMaxAckDelay() { return request_max_ack_delay_; }
+
+    void SetReorderingThreshold(uint64_t threshold) { reordering_threshold_ = threshold; }
+    uint64_t GetReorderingThreshold() { return reordering_threshold_; }
+
+private:
+    uint64_t sequence_number_;          // frames with a sequence number not larger than the last processed are ignored.
+    uint64_t ack_eliciting_threshold_;  // ack-eliciting packets that may be received before an ACK is sent.
+    uint64_t request_max_ack_delay_;    // the max_ack_delay the peer should use, in microseconds.
+    uint64_t reordering_threshold_;     // how far out of order a packet may be before an immediate ACK. 0 disables.
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include "common/buffer/buffer_decode_wrapper.h"
+#include "common/buffer/buffer_encode_wrapper.h"
+#include "common/log/log.h"
+
+#include "quic/frame/datagram_frame.h"
+
+namespace quicx {
+namespace quic {
+
+DatagramFrame::DatagramFrame(uint16_t frame_type):
+    IFrame(frame_type),
+    length_(0),
+    datagram_id_(0) {}
+
+DatagramFrame::~DatagramFrame() {}
+
+bool DatagramFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
+    uint32_t need_size = EncodeSize();
+    if (need_size > buffer->GetFreeLength()) {
+        LOG_DEBUG(
+            "insufficient remaining cache space. remain_size:%d, need_size:%d", buffer->GetFreeLength(), need_size);
+        return false;
+    }
+
+    common::BufferEncodeWrapper wrapper(buffer);
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(frame_type_), "failed to encode frame type");
+    if (frame_type_ == FrameType::kDatagramWithLength) {
+        CHECK_ENCODE_ERROR(wrapper.EncodeVarint(length_), "failed to encode length");
+    }
+    if (length_ > 0) {
+        CHECK_ENCODE_ERROR(wrapper.EncodeBytes(data_.GetStart(), length_), "failed to encode data");
+    }
+    return true;
+}
+
+bool DatagramFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type) {
+    common::BufferDecodeWrapper wrapper(buffer);
+
+    if (with_type) {
+        uint64_t type = 0;
+        CHECK_DECODE_ERROR(wrapper.DecodeVarint(type), "failed to decode frame type");
+        frame_type_ = static_cast<uint16_t>(type);
+        if (!IsDatagramFrame(frame_type_)) {
+            LOG_ERROR("invalid frame type. frame_type:%d", frame_type_);
+            return false;
+        }
+    }
+    if (frame_type_ == FrameType::kDatagramWithLength) {
+        CHECK_DECODE_ERROR(wrapper.DecodeVarint(length_), "failed to decode length");
+    }
+    wrapper.Flush();
+
+    // Without a Length field the data extends to the end of the packet
+    if (frame_type_ == FrameType::kDatagram) {
+        length_ = buffer->GetDataLength();
+    }
+    if (length_ > buffer->GetDataLength()) {
+        LOG_ERROR("insufficient remaining data. remain_size:%d, need_size:%d", buffer->GetDataLength(), length_);
+        return false;
+    }
+    data_ = buffer->GetSharedReadableSpan(length_);
+    buffer->MoveReadPt(length_);
+    return true;
+}
+
+uint32_t DatagramFrame::EncodeSize() {
+    uint32_t size = common::GetEncodeVarintLength(frame_type_) + length_;
+    if (frame_type_ == FrameType::kDatagramWithLength) {
+        size += common::GetEncodeVarintLength(length_);
+    }
+    return size;
+}
+
+uint32_t DatagramFrame::GetOverhead(uint32_t length) {
+    return common::GetEncodeVarintLength(FrameType::kDatagramWithLength) + common::GetEncodeVarintLength(length);
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,55 @@
+#ifndef QUIC_FRAME_DATAGRAM_FRAME
+#define QUIC_FRAME_DATAGRAM_FRAME
+
+#include <cstdint>
+#include "common/buffer/shared_buffer_span.h"
+#include "quic/frame/if_frame.h"
+
+namespace quicx {
+namespace quic {
+
+// RFC 9221: unreliable application data. Never retransmitted; only valid if
+// the receiver advertised a non-zero max_datagram_frame_size.
+class DatagramFrame:
+    public IFrame {
+public:
+    // 0x31 carries a Length field; 0x30 runs to the end of the packet
+    DatagramFrame(uint16_t frame_type = FrameType::kDatagramWithLength);
+    ~DatagramFrame();
+
+    virtual bool Encode(std::shared_ptr<common::IBuffer> buffer);
+    virtual bool Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type = false);
+    virtual uint32_t EncodeSize();
+    // the frame types (0x30, 0x31) are out of the bit field range, see kDatagramBit
+    virtual uint32_t GetFrameTypeBit() { return FrameTypeBit::kDatagramBit; }
+
+    void SetData(common::SharedBufferSpan data) {
+        data_ = data;
+        length_ = data.GetLength();
+    }
+    common::SharedBufferSpan GetData() { return data_; }
+    uint32_t GetLength() { return length_; }
+    // Drop the payload once encoded; the sent-packet record only needs the id.
+    void ReleaseData() { data_ = common::SharedBufferSpan(); }
+
+    // Local bookkeeping, not on the wire: the id the send queue reports
+    // acknowledgement or loss under.
+    void SetDatagramId(uint64_t id) { datagram_id_ = id; }
+    uint64_t GetDatagramId() { return datagram_id_; }
+
+    static bool IsDatagramFrame(uint16_t frame_type) {
+        return frame_type == FrameType::kDatagram || frame_type == FrameType::kDatagramWithLength;
+    }
+    // Frame type and Length field of a frame carrying `length` bytes.
+    static uint32_t GetOverhead(uint32_t length);
+
+private:
+    uint32_t length_;                // the length of the Datagram Data field.
+    common::SharedBufferSpan data_;  // the application data.
+    uint64_t datagram_id_;
+};
+
+}
+}
+
+#endif
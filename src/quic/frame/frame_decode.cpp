@@ -8,19 +8,28 @@
 
 #include "quic/connection/util.h"
 #include "quic/frame/ack_frame.h"
+#include "quic/frame/ack_frequency_frame.h"
 #include "quic/frame/connection_close_frame.h"
 #include "quic/frame/crypto_frame.h"
 #include "quic/frame/data_blocked_frame.h"
+#include "quic/frame/datagram_frame.h"
 #include "quic/frame/frame_decode.h"
 #include "quic/frame/handshake_done_frame.h"
+#include "quic/frame/immediate_ack_frame.h"
 #include "quic/frame/max_data_frame.h"
+#include "quic/frame/max_path_id_frame.h"
 #include "quic/frame/max_stream_data_frame.h"
 #include "quic/frame/max_streams_frame.h"
 #include "quic/frame/new_connection_id_frame.h"
 #include "quic/frame/new_token_frame.h"
 #include "quic/frame/padding_frame.h"
+#include "quic/frame/path_abandon_frame.h"
+#include "quic/frame/path_ack_frame.h"
 #include "quic/frame/path_challenge_frame.h"
+#include "quic/frame/path_new_connection_id_frame.h"
 #include "quic/frame/path_response_frame.h"
+#include "quic/frame/path_retire_connection_id_frame.h"
+#include "quic/frame/path_status_frame.h"
 #include "quic/frame/ping_frame.h"
 #include "quic/frame/reset_stream_frame.h"
 #include "quic/frame/retire_connection_id_frame.h"
@@ -88,6 +97,28 @@ static const std::unordered_map<uint16_t, std::function<std::shared_ptr<IFrame>(
         [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<ConnectionCloseFrame>(type); }},
     {FrameType::kHandshakeDone,
         [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<HandshakeDoneFrame>(); }},
+    {FrameType::kImmediateAck,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<ImmediateAckFrame>(); }},
+    {FrameType::kAckFrequency,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<AckFrequencyFrame>(); }},
+    {FrameType::kDatagram,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<DatagramFrame>(type); }},
+    {FrameType::kDatagramWithLength,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<DatagramFrame>(type); }},
+    {FrameType::kPathAck, [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<PathAckFrame>(type); }},
+    {FrameType::kPathAckEcn,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<PathAckFrame>(type); }},
+    {FrameType::kPathAbandon,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<PathAbandonFrame>(); }},
+    {FrameType::kPathStatusBackup,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<PathStatusFrame>(type); }},
+    {FrameType::kPathStatusAvailable,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<PathStatusFrame>(type); }},
+    {FrameType::kPathNewConnectionId,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<PathNewConnectionIDFrame>(); }},
+    {FrameType::kPathRetireConnectionId,
+        [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<PathRetireConnectionIDFrame>(); }},
+    {FrameType::kMaxPathId, [](uint16_t type) -> std::shared_ptr<IFrame> { return std::make_shared<MaxPathIdFrame>(); }},
 };
 
 bool DecodeFrames(std::shared_ptr<common::IBuffer> buffer, std::vector<std::shared_ptr<IFrame>>& frames) {
@@ -122,6 +153,12 @@ bool DecodeFrames(std::shared_ptr<common::IBuffer> buffer, std::vector<std::shar
         buffer->MoveReadPt(next_pos - start_pos);
 
         uint16_t frame_type = (uint16_t)frame_type_64;
+        // FrameType keeps the low 16 bits. The only wider types known are the
+        // multipath ones, and those are only valid with their prefix.
+        if (GetWireFrameType(frame_type) != frame_type_64) {
+            LOG_ERROR("invalid frame type. type:%llu", frame_type_64);
+            return false;
+        }
 
         auto creator = kFrameCreatorMap.find(frame_type);
         if (creator != kFrameCreatorMap.end()) {
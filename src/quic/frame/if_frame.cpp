@@ -27,7 +27,7 @@ bool IFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
     }
 
     common::BufferEncodeWrapper wrapper(buffer);
-    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(frame_type_), "failed to encode frame type");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(GetWireFrameType(frame_type_)), "failed to encode frame type");
 
     return true;
 }
@@ -43,7 +43,7 @@ bool IFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type) {
 }
 
 uint32_t IFrame::EncodeSize() {
-    return common::GetEncodeVarintLength(frame_type_);
+    return common::GetEncodeVarintLength(GetWireFrameType(frame_type_));
 }
 
 uint32_t IFrame::GetFrameTypeBit() {
@@ -0,0 +1,21 @@
+#ifndef QUIC_FRAME_IMMEDIATE_ACK_FRAME
+#define QUIC_FRAME_IMMEDIATE_ACK_FRAME
+
+#include "quic/frame/if_frame.h"
+
+namespace quicx {
+namespace quic {
+
+// draft-ietf-quic-ack-frequency: asks the peer to send an ACK frame
+// immediately, regardless of its current ACK_FREQUENCY thresholds.
+class ImmediateAckFrame:
+    public IFrame {
+public:
+    ImmediateAckFrame(): IFrame(FrameType::kImmediateAck) {}
+    ~ImmediateAckFrame() {}
+};
+
+}
+}
+
+#endif
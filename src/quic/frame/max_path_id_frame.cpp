@@ -0,0 +1,50 @@
+#include "quic/frame/max_path_id_frame.h"
+#include "common/buffer/buffer_decode_wrapper.h"
+#include "common/buffer/buffer_encode_wrapper.h"
+#include "common/decode/decode.h"
+#include "common/log/log.h"
+
+namespace quicx {
+namespace quic {
+
+MaxPathIdFrame::MaxPathIdFrame():
+    IFrame(FrameType::kMaxPathId),
+    max_path_id_(0) {}
+
+MaxPathIdFrame::~MaxPathIdFrame() {}
+
+bool MaxPathIdFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
+    uint32_t need_size = EncodeSize();
+    if (need_size > buffer->GetFreeLength()) {
+        LOG_ERROR(
+            "insufficient remaining cache space. remain_size:%d, need_size:%d", buffer->GetFreeLength(), need_size);
+        return false;
+    }
+
+    common::BufferEncodeWrapper wrapper(buffer);
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(GetWireFrameType(frame_type_)), "failed to encode frame type");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(max_path_id_), "failed to encode max path id");
+    return true;
+}
+
+bool MaxPathIdFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type) {
+    common::BufferDecodeWrapper wrapper(buffer);
+
+    if (with_type) {
+        uint64_t type = 0;
+        CHECK_DECODE_ERROR(wrapper.DecodeVarint(type), "failed to decode frame type");
+        if (type != GetWireFrameType(FrameType::kMaxPathId)) {
+            LOG_ERROR("invalid frame type. frame_type:%llu", type);
+            return false;
+        }
+    }
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(max_path_id_), "failed to decode max path id");
+    return true;
+}
+
+uint32_t MaxPathIdFrame::EncodeSize() {
+    return common::GetEncodeVarintLength(GetWireFrameType(frame_type_)) + common::GetEncodeVarintLength(max_path_id_);
+}
+
+}  // namespace quic
+}  // namespace quicx
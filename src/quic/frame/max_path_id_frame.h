@@ -0,0 +1,34 @@
+#ifndef QUIC_FRAME_MAX_PATH_ID_FRAME
+#define QUIC_FRAME_MAX_PATH_ID_FRAME
+
+#include <cstdint>
+#include "quic/frame/if_frame.h"
+
+namespace quicx {
+namespace quic {
+
+// draft-ietf-quic-multipath: raises the largest path ID the peer may open,
+// above the initial_max_path_id transport parameter.
+class MaxPathIdFrame:
+    public IFrame {
+public:
+    MaxPathIdFrame();
+    ~MaxPathIdFrame();
+
+    virtual bool Encode(std::shared_ptr<common::IBuffer> buffer);
+    virtual bool Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type = false);
+    virtual uint32_t EncodeSize();
+    // the frame type is out of the bit field range, see kMultipathBit
+    virtual uint32_t GetFrameTypeBit() { return FrameTypeBit::kMultipathBit; }
+
+    void SetMaxPathId(uint32_t max_path_id) { max_path_id_ = max_path_id; }
+    uint32_t GetMaxPathId() { return max_path_id_; }
+
+private:
+    uint32_t max_path_id_;  // the largest path ID the sender allows.
+};
+
+}
+}
+
+#endif
@@ -9,7 +9,10 @@ namespace quicx {
 namespace quic {
 
 NewConnectionIDFrame::NewConnectionIDFrame():
-    IFrame(FrameType::kNewConnectionId),
+    NewConnectionIDFrame(FrameType::kNewConnectionId) {}
+
+NewConnectionIDFrame::NewConnectionIDFrame(uint16_t frame_type):
+    IFrame(frame_type),
     sequence_number_(0),
     retire_prior_to_(0),
     length_(0) {
@@ -29,6 +32,10 @@ bool NewConnectionIDFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
 
     common::BufferEncodeWrapper wrapper(buffer);
     CHECK_ENCODE_ERROR(wrapper.EncodeVarint(frame_type_), "failed to encode frame type");
+    return EncodeFields(wrapper);
+}
+
+bool NewConnectionIDFrame::EncodeFields(common::BufferEncodeWrapper& wrapper) {
     CHECK_ENCODE_ERROR(wrapper.EncodeVarint(sequence_number_), "failed to encode sequence number");
     CHECK_ENCODE_ERROR(wrapper.EncodeVarint(retire_prior_to_), "failed to encode retire prior to");
     CHECK_ENCODE_ERROR(wrapper.EncodeFixedUint8(length_), "failed to encode length");
@@ -51,6 +58,10 @@ bool NewConnectionIDFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool
             return false;
         }
     }
+    return DecodeFields(wrapper);
+}
+
+bool NewConnectionIDFrame::DecodeFields(common::BufferDecodeWrapper& wrapper) {
     CHECK_DECODE_ERROR(wrapper.DecodeVarint(sequence_number_), "failed to decode sequence number");
     CHECK_DECODE_ERROR(wrapper.DecodeVarint(retire_prior_to_), "failed to decode retire prior to");
     CHECK_DECODE_ERROR(wrapper.DecodeFixedUint8(length_), "failed to decode length");
@@ -62,9 +73,9 @@ bool NewConnectionIDFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool
     }
 
     // Check if we have enough data for connection ID
-    if (length_ > buffer->GetDataLength()) {
+    if (length_ > wrapper.GetDataLength()) {
         LOG_ERROR(
-            "insufficient data for connection ID. need:%d, available:%d", length_, buffer->GetDataLength());
+            "insufficient data for connection ID. need:%d, available:%d", length_, wrapper.GetDataLength());
         return false;
     }
 
@@ -74,9 +85,9 @@ bool NewConnectionIDFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool
     CHECK_DECODE_ERROR(wrapper.DecodeBytes(conn_id_ptr, length_), "failed to decode connection id");
 
     // Check if we have enough data for stateless reset token
-    if (kStatelessResetTokenLength > buffer->GetDataLength()) {
+    if (kStatelessResetTokenLength > wrapper.GetDataLength()) {
         LOG_ERROR("insufficient data for stateless reset token. need:%d, available:%d",
-            kStatelessResetTokenLength, buffer->GetDataLength());
+            kStatelessResetTokenLength, wrapper.GetDataLength());
         return false;
     }
 
@@ -88,12 +99,16 @@ bool NewConnectionIDFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool
 }
 
 uint32_t NewConnectionIDFrame::EncodeSize() {
+    return common::GetEncodeVarintLength(frame_type_) + FieldsSize();
+}
+
+uint32_t NewConnectionIDFrame::FieldsSize() {
     // Calculate the actual size needed for varint encoding
     uint32_t sequence_size = common::GetEncodeVarintLength(sequence_number_);
     uint32_t retire_size = common::GetEncodeVarintLength(retire_prior_to_);
 
-    // Fixed sizes: frame type (varint) + length (1) + connection ID (length_) + token (16)
-    uint32_t fixed_size = common::GetEncodeVarintLength(frame_type_) + 1 + length_ + kStatelessResetTokenLength;
+    // Fixed sizes: length (1) + connection ID (length_) + token (16)
+    uint32_t fixed_size = 1 + length_ + kStatelessResetTokenLength;
 
     return sequence_size + retire_size + fixed_size;
 }
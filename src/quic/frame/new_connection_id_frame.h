@@ -3,6 +3,8 @@
 
 #include <cstdint>
 #include "quic/frame/if_frame.h"
+#include "common/buffer/buffer_decode_wrapper.h"
+#include "common/buffer/buffer_encode_wrapper.h"
 #include "quic/connection/type.h"
 #include "quic/connection/connection_id.h"
 
@@ -33,6 +35,14 @@ public:
     void SetStatelessResetToken(uint8_t* token);
     const uint8_t* GetStatelessResetToken() { return stateless_reset_token_; }
 
+protected:
+    NewConnectionIDFrame(uint16_t frame_type);
+
+    // The fields after the frame type, shared with PATH_NEW_CONNECTION_ID.
+    bool EncodeFields(common::BufferEncodeWrapper& wrapper);
+    bool DecodeFields(common::BufferDecodeWrapper& wrapper);
+    uint32_t FieldsSize();
+
 private:
     uint64_t sequence_number_;  // the connection ID by the sender.
     uint64_t retire_prior_to_;  // which connection IDs should be retired.
@@ -0,0 +1,54 @@
+#include "quic/frame/path_abandon_frame.h"
+#include "common/buffer/buffer_decode_wrapper.h"
+#include "common/buffer/buffer_encode_wrapper.h"
+#include "common/decode/decode.h"
+#include "common/log/log.h"
+
+namespace quicx {
+namespace quic {
+
+PathAbandonFrame::PathAbandonFrame():
+    IFrame(FrameType::kPathAbandon),
+    path_id_(0),
+    error_code_(0) {}
+
+PathAbandonFrame::~PathAbandonFrame() {}
+
+bool PathAbandonFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
+    uint32_t need_size = EncodeSize();
+    if (need_size > buffer->GetFreeLength()) {
+        LOG_ERROR(
+            "insufficient remaining cache space. remain_size:%d, need_size:%d", buffer->GetFreeLength(), need_size);
+        return false;
+    }
+
+    common::BufferEncodeWrapper wrapper(buffer);
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(GetWireFrameType(frame_type_)), "failed to encode frame type");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(path_id_), "failed to encode path id");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(error_code_), "failed to encode error code");
+    return true;
+}
+
+bool PathAbandonFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type) {
+    common::BufferDecodeWrapper wrapper(buffer);
+
+    if (with_type) {
+        uint64_t type = 0;
+        CHECK_DECODE_ERROR(wrapper.DecodeVarint(type), "failed to decode frame type");
+        if (type != GetWireFrameType(FrameType::kPathAbandon)) {
+            LOG_ERROR("invalid frame type. frame_type:%llu", type);
+            return false;
+        }
+    }
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(path_id_), "failed to decode path id");
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(error_code_), "failed to decode error code");
+    return true;
+}
+
+uint32_t PathAbandonFrame::EncodeSize() {
+    return common::GetEncodeVarintLength(GetWireFrameType(frame_type_)) + common::GetEncodeVarintLength(path_id_) +
+           common::GetEncodeVarintLength(error_code_);
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,38 @@
+#ifndef QUIC_FRAME_PATH_ABANDON_FRAME
+#define QUIC_FRAME_PATH_ABANDON_FRAME
+
+#include <cstdint>
+#include "quic/frame/if_frame.h"
+
+namespace quicx {
+namespace quic {
+
+// draft-ietf-quic-multipath: closes one path. The receiver stops sending on
+// it and retires the connection IDs bound to it.
+class PathAbandonFrame:
+    public IFrame {
+public:
+    PathAbandonFrame();
+    ~PathAbandonFrame();
+
+    virtual bool Encode(std::shared_ptr<common::IBuffer> buffer);
+    virtual bool Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type = false);
+    virtual uint32_t EncodeSize();
+    // the frame type is out of the bit field range, see kMultipathBit
+    virtual uint32_t GetFrameTypeBit() { return FrameTypeBit::kMultipathBit; }
+
+    void SetPathId(uint32_t path_id) { path_id_ = path_id; }
+    uint32_t GetPathId() { return path_id_; }
+
+    void SetErrorCode(uint64_t error_code) { error_code_ = error_code; }
+    uint64_t GetErrorCode() { return error_code_; }
+
+private:
+    uint32_t path_id_;     // the path being abandoned.
+    uint64_t error_code_;  // why the path is abandoned.
+};
+
+}
+}
+
+#endif
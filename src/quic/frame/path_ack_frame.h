@@ -0,0 +1,41 @@
+#ifndef QUIC_FRAME_PATH_ACK_FRAME
+#define QUIC_FRAME_PATH_ACK_FRAME
+
+#include <cstdint>
+#include "quic/frame/ack_frame.h"
+
+namespace quicx {
+namespace quic {
+
+// draft-ietf-quic-multipath: an ACK for the packet number space of one path.
+// PATH_ACK_ECN carries the ECN counts as well, so it derives from AckEcnFrame;
+// the counts are only on the wire for that type.
+class PathAckFrame:
+    public AckEcnFrame {
+public:
+    PathAckFrame(uint16_t frame_type = FrameType::kPathAck);
+    ~PathAckFrame();
+
+    virtual bool Encode(std::shared_ptr<common::IBuffer> buffer);
+    virtual bool Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type = false);
+    virtual uint32_t EncodeSize();
+    // the frame types are out of the bit field range, see kPathAckBit
+    virtual uint32_t GetFrameTypeBit() { return FrameTypeBit::kPathAckBit; }
+
+    void SetPathId(uint32_t path_id) { path_id_ = path_id; }
+    uint32_t GetPathId() { return path_id_; }
+
+    bool HasEcnCounts() { return frame_type_ == FrameType::kPathAckEcn; }
+
+    static bool IsPathAckFrame(uint16_t frame_type) {
+        return frame_type == FrameType::kPathAck || frame_type == FrameType::kPathAckEcn;
+    }
+
+private:
+    uint32_t path_id_;  // the path whose packet number space is acknowledged.
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,51 @@
+#include "quic/frame/path_new_connection_id_frame.h"
+#include "common/buffer/buffer_decode_wrapper.h"
+#include "common/buffer/buffer_encode_wrapper.h"
+#include "common/decode/decode.h"
+#include "common/log/log.h"
+
+namespace quicx {
+namespace quic {
+
+PathNewConnectionIDFrame::PathNewConnectionIDFrame():
+    NewConnectionIDFrame(FrameType::kPathNewConnectionId),
+    path_id_(0) {}
+
+PathNewConnectionIDFrame::~PathNewConnectionIDFrame() {}
+
+bool PathNewConnectionIDFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
+    uint32_t need_size = EncodeSize();
+    if (need_size > buffer->GetFreeLength()) {
+        LOG_ERROR(
+            "insufficient remaining cache space. remain_size:%d, need_size:%d", buffer->GetFreeLength(), need_size);
+        return false;
+    }
+
+    common::BufferEncodeWrapper wrapper(buffer);
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(GetWireFrameType(frame_type_)), "failed to encode frame type");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(path_id_), "failed to encode path id");
+    return EncodeFields(wrapper);
+}
+
+bool PathNewConnectionIDFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type) {
+    common::BufferDecodeWrapper wrapper(buffer);
+
+    if (with_type) {
+        uint64_t type = 0;
+        CHECK_DECODE_ERROR(wrapper.DecodeVarint(type), "failed to decode frame type");
+        if (type != GetWireFrameType(FrameType::kPathNewConnectionId)) {
+            LOG_ERROR("invalid frame type. frame_type:%llu", type);
+            return false;
+        }
+    }
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(path_id_), "failed to decode path id");
+    return DecodeFields(wrapper);
+}
+
+uint32_t PathNewConnectionIDFrame::EncodeSize() {
+    return common::GetEncodeVarintLength(GetWireFrameType(frame_type_)) + common::GetEncodeVarintLength(path_id_) +
+           FieldsSize();
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,34 @@
+#ifndef QUIC_FRAME_PATH_RETIRE_CONNECTION_ID_FRAME
+#define QUIC_FRAME_PATH_RETIRE_CONNECTION_ID_FRAME
+
+#include <cstdint>
+#include "quic/frame/retire_connection_id_frame.h"
+
+namespace quicx {
+namespace quic {
+
+// draft-ietf-quic-multipath: RETIRE_CONNECTION_ID for a connection ID issued
+// with PATH_NEW_CONNECTION_ID.
+class PathRetireConnectionIDFrame:
+    public RetireConnectionIDFrame {
+public:
+    PathRetireConnectionIDFrame();
+    ~PathRetireConnectionIDFrame();
+
+    virtual bool Encode(std::shared_ptr<common::IBuffer> buffer);
+    virtual bool Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type = false);
+    virtual uint32_t EncodeSize();
+    // the frame type is out of the bit field range, see kMultipathBit
+    virtual uint32_t GetFrameTypeBit() { return FrameTypeBit::kMultipathBit; }
+
+    void SetPathId(uint32_t path_id) { path_id_ = path_id; }
+    uint32_t GetPathId() { return path_id_; }
+
+private:
+    uint32_t path_id_;  // the path the retired connection ID belongs to.
+};
+
+}
+}
+
+#endif
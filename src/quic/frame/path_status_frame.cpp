@@ -0,0 +1,55 @@
+#include "quic/frame/path_status_frame.h"
+#include "common/buffer/buffer_decode_wrapper.h"
+#include "common/buffer/buffer_encode_wrapper.h"
+#include "common/decode/decode.h"
+#include "common/log/log.h"
+
+namespace quicx {
+namespace quic {
+
+PathStatusFrame::PathStatusFrame(uint16_t frame_type):
+    IFrame(frame_type),
+    path_id_(0),
+    sequence_number_(0) {}
+
+PathStatusFrame::~PathStatusFrame() {}
+
+bool PathStatusFrame::Encode(std::shared_ptr<common::IBuffer> buffer) {
+    uint32_t need_size = EncodeSize();
+    if (need_size > buffer->GetFreeLength()) {
+        LOG_ERROR(
+            "insufficient remaining cache space. remain_size:%d, need_size:%d", buffer->GetFreeLength(), need_size);
+        return false;
+    }
+
+    common::BufferEncodeWrapper wrapper(buffer);
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(GetWireFrameType(frame_type_)), "failed to encode frame type");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(path_id_), "failed to encode path id");
+    CHECK_ENCODE_ERROR(wrapper.EncodeVarint(sequence_number_), "failed to encode sequence number");
+    return true;
+}
+
+bool PathStatusFrame::Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type) {
+    common::BufferDecodeWrapper wrapper(buffer);
+
+    if (with_type) {
+        uint64_t type = 0;
+        CHECK_DECODE_ERROR(wrapper.DecodeVarint(type), "failed to decode frame type");
+        frame_type_ = static_cast<uint16_t>(type);
+        if (!IsPathStatusFrame(frame_type_) || GetWireFrameType(frame_type_) != type) {
+            LOG_ERROR("invalid frame type. frame_type:%llu", type);
+            return false;
+        }
+    }
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(path_id_), "failed to decode path id");
+    CHECK_DECODE_ERROR(wrapper.DecodeVarint(sequence_number_), "failed to decode sequence number");
+    return true;
+}
+
+uint32_t PathStatusFrame::EncodeSize() {
+    return common::GetEncodeVarintLength(GetWireFrameType(frame_type_)) + common::GetEncodeVarintLength(path_id_) +
+           common::GetEncodeVarintLength(sequence_number_);
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,45 @@
+#ifndef QUIC_FRAME_PATH_STATUS_FRAME
+#define QUIC_FRAME_PATH_STATUS_FRAME
+
+#include <cstdint>
+#include "quic/frame/if_frame.h"
+
+namespace quicx {
+namespace quic {
+
+// draft-ietf-quic-multipath: PATH_STATUS_BACKUP asks the peer to send on a
+// path only when no available path is usable; PATH_STATUS_AVAILABLE undoes
+// it. Only the frame with the highest sequence number for a path counts.
+class PathStatusFrame:
+    public IFrame {
+public:
+    PathStatusFrame(uint16_t frame_type = FrameType::kPathStatusAvailable);
+    ~PathStatusFrame();
+
+    virtual bool Encode(std::shared_ptr<common::IBuffer> buffer);
+    virtual bool Decode(std::shared_ptr<common::IBuffer> buffer, bool with_type = false);
+    virtual uint32_t EncodeSize();
+    // the frame types are out of the bit field range, see kMultipathBit
+    virtual uint32_t GetFrameTypeBit() { return FrameTypeBit::kMultipathBit; }
+
+    void SetPathId(uint32_t path_id) { path_id_ = path_id; }
+    uint32_t GetPathId() { return path_id_; }
+
+    void SetSequenceNumber(uint64_t sequence) { sequence_number_ = sequence; }
+    uint64_t GetSequenceNumber() { return sequence_number_; }
+
+    bool IsBackup() { return frame_type_ == FrameType::kPathStatusBackup; }
+
+    static bool IsPathStatusFrame(uint16_t frame_type) {
+        return frame_type == FrameType::kPathStatusBackup || frame_type == FrameType::kPathStatusAvailable;
+    }
+
+private:
+    uint32_t path_id_;          // the path whose status changes.
+    uint64_t sequence_number_;  // increases with every status frame sent for the path.
+};
+
+}
+}
+
+#endif
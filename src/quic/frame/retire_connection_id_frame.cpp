@@ -7,7 +7,10 @@ namespace quicx {
 namespace quic {
 
 RetireConnectionIDFrame::RetireConnectionIDFrame():
-    IFrame(FrameType::kRetireConnectionId),
+    RetireConnectionIDFrame(FrameType::kRetireConnectionId) {}
+
+RetireConnectionIDFrame::RetireConnectionIDFrame(uint16_t frame_type):
+    IFrame(frame_type),
     sequence_number_(0) {}
 
 RetireConnectionIDFrame::~RetireConnectionIDFrame() {}
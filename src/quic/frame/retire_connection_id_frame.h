@@ -20,7 +20,9 @@ public:
     void SetSequenceNumber(uint64_t num) { sequence_number_ = num; }
     uint64_t GetSequenceNumber() { return sequence_number_; }
 
-private:
+protected:
+    RetireConnectionIDFrame(uint16_t frame_type);
+
     uint64_t sequence_number_;  // the connection ID being retired.
 };
 
@@ -48,10 +48,38 @@ enum FrameType: uint16_t {
     kConnectionClose                 = 0x1c,
     kConnectionCloseApp              = 0x1d,
     kHandshakeDone                   = 0x1e,
+    // draft-ietf-quic-ack-frequency
+    kImmediateAck                    = 0x1f,
+    kAckFrequency                    = 0xaf,
+    // RFC 9221: DATAGRAM, without and with a Length field
+    kDatagram                        = 0x30,
+    kDatagramWithLength              = 0x31,
+    // draft-ietf-quic-multipath. The wire codepoints are 0x15228cXX; only the
+    // low 16 bits are kept here, see GetWireFrameType().
+    kPathAck                         = 0x8c00,
+    kPathAckEcn                      = 0x8c01,
+    kPathAbandon                     = 0x8c05,
+    kPathStatusBackup                = 0x8c07,
+    kPathStatusAvailable             = 0x8c08,
+    kPathNewConnectionId             = 0x8c09,
+    kPathRetireConnectionId          = 0x8c0a,
+    kMaxPathId                       = 0x8c0c,
 
     kUnknown                         = 0xff,
 };
 
+// Prefix of the 32-bit multipath frame types on the wire.
+static const uint64_t kMultipathFrameTypePrefix = 0x15220000;
+
+inline bool IsMultipathFrameType(uint16_t frame_type) {
+    return (frame_type & 0xff00) == 0x8c00;
+}
+
+// The varint written on the wire for a FrameType.
+inline uint64_t GetWireFrameType(uint16_t frame_type) {
+    return IsMultipathFrameType(frame_type) ? (kMultipathFrameTypePrefix | frame_type) : frame_type;
+}
+
 
 // Note: kUnknown (0xff) MUST NOT be used with bit-shift operations as it exceeds uint32_t width.
 // Use GetFrameTypeBit() which includes bounds checking for safe conversion.
@@ -80,6 +108,17 @@ enum FrameTypeBit: uint32_t {
     kConnectionCloseBit                 = 1u << FrameType::kConnectionClose,
     kConnectionCloseAppBit              = 1u << FrameType::kConnectionCloseApp,
     kHandshakeDoneBit                   = 1u << FrameType::kHandshakeDone,
+    kImmediateAckBit                    = 1u << FrameType::kImmediateAck,
+    // ACK_FREQUENCY (0xaf) does not fit the 32-bit field. Bits 0x09-0x0f are
+    // never set because every STREAM variant reports kStreamBit, so it borrows
+    // the first of them (see AckFrequencyFrame::GetFrameTypeBit()).
+    kAckFrequencyBit                    = 1u << (FrameType::kStream + 1),
+    // DATAGRAM (0x30, 0x31) borrows the next one (see DatagramFrame::GetFrameTypeBit()).
+    kDatagramBit                        = 1u << (FrameType::kStream + 2),
+    // PATH_ACK and PATH_ACK_ECN, not ack-eliciting like ACK.
+    kPathAckBit                         = 1u << (FrameType::kStream + 3),
+    // The other multipath frames, all ack-eliciting.
+    kMultipathBit                       = 1u << (FrameType::kStream + 4),
 };
 
 }
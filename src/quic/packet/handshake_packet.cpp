@@ -198,7 +198,7 @@ bool HandshakePacket::DecodeWithCrypto(std::shared_ptr<common::IBuffer> buffer)
 
     // Set frame_type_bit based on decoded frames for ACK tracking
     for (const auto& frame : frames_list_) {
-        frame_type_bit_ |= (1u << frame->GetType());
+        frame_type_bit_ |= frame->GetFrameTypeBit();
     }
 
     return true;
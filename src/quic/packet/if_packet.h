@@ -138,6 +138,31 @@ public:
      */
     uint64_t GetLargestReceivedPn() const { return largest_received_pn_; }
 
+    /**
+     * @brief Record the Largest Acknowledged of the ACK frame this packet carries
+     *
+     * RFC 9000 §13.2.4: once this packet is acknowledged, the receive side may
+     * stop reporting packet numbers up to this value (ACK-of-ACK). Kept on the
+     * packet so a retransmission, which re-sends the same bytes, keeps it too.
+     *
+     * @param largest_ack Largest Acknowledged field of the carried ACK frame
+     */
+    void SetCarriedAckLargest(uint64_t largest_ack) {
+        carries_ack_ = true;
+        carried_ack_largest_ = largest_ack;
+    }
+    bool CarriesAck() const { return carries_ack_; }
+    uint64_t GetCarriedAckLargest() const { return carried_ack_largest_; }
+
+    /**
+     * @brief Mark this packet as a DPLPMTUD probe (RFC 9000 §14.4)
+     *
+     * A probe is tracked for loss like any packet, but congestion control
+     * never sees it: its loss means the size did not fit, not congestion.
+     */
+    void SetMtuProbe(bool probe) { mtu_probe_ = probe; }
+    bool IsMtuProbe() const { return mtu_probe_; }
+
     /**
      * @brief Set the cryptographer for encryption/decryption
      *
@@ -156,6 +181,9 @@ protected:
     uint64_t packet_number_;
     uint64_t largest_received_pn_;  // RFC 9000 Appendix A: for PN recovery
     bool key_phase_changed_ = false;  // RFC 9001 §6: set when key phase differs from expected
+    bool carries_ack_ = false;          // RFC 9000 §13.2.4: sender side, for ACK-of-ACK
+    uint64_t carried_ack_largest_ = 0;
+    bool mtu_probe_ = false;            // RFC 9000 §14.4: sender side, see SetMtuProbe
     common::SharedBufferSpan packet_src_data_;
 
     std::shared_ptr<ICryptographer> crypto_grapher_;
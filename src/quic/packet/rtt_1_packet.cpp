@@ -52,7 +52,7 @@ bool Rtt1Packet::Encode(std::shared_ptr<common::IBuffer> buffer) {
     // For Short Header: AD = [Flag][DCID][PN]
     auto ad_span = common::BufferSpan(header_span.GetStart(), cur_pos);
     auto payload_span = payload_.GetSpan();
-    auto result = crypto_grapher_->EncryptPacket(packet_number_, ad_span, payload_span, buffer);
+    auto result = crypto_grapher_->EncryptPacket(packet_number_, ad_span, payload_span, buffer, path_id_);
     if (result != ICryptographer::Result::kOk) {
         LOG_ERROR("encrypt payload failed. result:%d", result);
         return false;
@@ -175,14 +175,15 @@ bool Rtt1Packet::DecodeWithCrypto(std::shared_ptr<common::IBuffer> buffer) {
 
     if (!key_phase_changed) {
         // Key Phase matches: try decrypt with current key
-        result = crypto_grapher_->DecryptPacket(packet_number_, ad_span, payload, plaintext_buffer);
+        result = crypto_grapher_->DecryptPacket(packet_number_, ad_span, payload, plaintext_buffer, path_id_);
         if (result != ICryptographer::Result::kOk) {
             // Current key failed, maybe this is a reordered packet from previous key phase
             if (crypto_grapher_->HasPrevReadKey()) {
                 // Reset plaintext buffer for retry
                 chunk = common::BufferChunkPool::Acquire(GlobalResource::Instance().GetThreadLocalBlockPool());
                 plaintext_buffer = std::make_shared<common::SingleBlockBuffer>(chunk);
-                result = crypto_grapher_->DecryptPacketWithPrevKey(packet_number_, ad_span, payload, plaintext_buffer);
+                result = crypto_grapher_->DecryptPacketWithPrevKey(
+                    packet_number_, ad_span, payload, plaintext_buffer, path_id_);
                 if (result != ICryptographer::Result::kOk) {
                     LOG_ERROR("decrypt packet failed with both current and prev key. result:%d, pn:%llu",
                         result, packet_number_);
@@ -218,7 +219,7 @@ bool Rtt1Packet::DecodeWithCrypto(std::shared_ptr<common::IBuffer> buffer) {
 
     // Set frame_type_bit based on decoded frames for ACK tracking
     for (const auto& frame : frames_list_) {
-        frame_type_bit_ |= (1u << frame->GetType());
+        frame_type_bit_ |= frame->GetFrameTypeBit();
     }
 
     return true;
@@ -242,7 +243,7 @@ bool Rtt1Packet::RetryPayloadDecrypt() {
     auto chunk = common::BufferChunkPool::Acquire(GlobalResource::Instance().GetThreadLocalBlockPool());
     auto plaintext_buffer = std::make_shared<common::SingleBlockBuffer>(chunk);
 
-    auto result = crypto_grapher_->DecryptPacket(packet_number_, ad_span, payload, plaintext_buffer);
+    auto result = crypto_grapher_->DecryptPacket(packet_number_, ad_span, payload, plaintext_buffer, path_id_);
     if (result != ICryptographer::Result::kOk) {
         LOG_ERROR("RetryPayloadDecrypt: decrypt still failed after key update. result:%d, pn:%llu",
             result, packet_number_);
@@ -256,7 +257,7 @@ bool Rtt1Packet::RetryPayloadDecrypt() {
 
     // Set frame_type_bit based on decoded frames for ACK tracking
     for (const auto& frame : frames_list_) {
-        frame_type_bit_ |= (1u << frame->GetType());
+        frame_type_bit_ |= frame->GetFrameTypeBit();
     }
 
     // Clear saved state
@@ -33,6 +33,11 @@ public:
     // RFC 9001 §6: Set the expected key phase for Key Update detection
     void SetExpectedKeyPhase(uint8_t key_phase) { expected_key_phase_ = key_phase; }
 
+    // draft-ietf-quic-multipath: the path this packet is sent or received on,
+    // mixed into the AEAD nonce. Must be set before Encode/DecodeWithCrypto.
+    void SetPathId(uint32_t path_id) { path_id_ = path_id; }
+    uint32_t GetPathId() const { return path_id_; }
+
     // RFC 9001 §6: Retry only the payload decryption after Key Update
     // Called when initial decrypt failed due to key phase change, and the connection
     // has rotated the read keys. Skips header decryption (already done).
@@ -44,6 +49,7 @@ protected:
 
     uint32_t payload_offset_;
     uint8_t expected_key_phase_ = 0;  // RFC 9001 §6: expected key phase from connection
+    uint32_t path_id_ = 0;
     // Saved state for retry after Key Update
     uint8_t* saved_payload_start_ = nullptr;
     uint8_t* saved_ad_start_ = nullptr;
@@ -1,9 +1,11 @@
+#include "quic/common/constants.h"
 #include "quic/quicx/global_resource.h"
 
 namespace quicx {
 namespace quic {
 
 thread_local std::shared_ptr<common::BlockMemoryPool> pool_;
+thread_local std::shared_ptr<common::BlockMemoryPool> jumbo_pool_;
 thread_local std::shared_ptr<quic::IPacketAllotor> packet_allotor_;
 thread_local std::weak_ptr<common::IEventLoop> thread_event_loop_;
 
@@ -21,6 +23,21 @@ std::shared_ptr<common::BlockMemoryPool> GlobalResource::GetThreadLocalBlockPool
     return pool_;
 }
 
+std::shared_ptr<common::BlockMemoryPool> GlobalResource::GetThreadLocalBlockPool(uint32_t size) {
+    auto pool = GetThreadLocalBlockPool();
+    if (size <= pool->GetBlockLength()) {
+        return pool;
+    }
+    if (!jumbo_pool_) {
+        jumbo_pool_ = MakeJumboPool();
+        auto loop = thread_event_loop_.lock();
+        if (loop) {
+            jumbo_pool_->SetEventLoop(loop);
+        }
+    }
+    return jumbo_pool_;
+}
+
 std::shared_ptr<quic::IPacketAllotor> GlobalResource::GetThreadLocalPacketAllotor() {
     if (!packet_allotor_) {
         packet_allotor_ = MakeDefaultPacketAllotor();
@@ -34,6 +51,9 @@ void GlobalResource::RegisterThreadEventLoop(std::shared_ptr<common::IEventLoop>
     if (pool_) {
         pool_->SetEventLoop(event_loop);
     }
+    if (jumbo_pool_) {
+        jumbo_pool_->SetEventLoop(event_loop);
+    }
 }
 
 std::weak_ptr<common::IEventLoop> GlobalResource::GetThreadEventLoop() {
@@ -58,6 +78,12 @@ std::shared_ptr<common::BlockMemoryPool> GlobalResource::MakeDefaultPool() {
     return common::MakeBlockMemoryPoolPtr(1500, 4);
 }
 
+std::shared_ptr<common::BlockMemoryPool> GlobalResource::MakeJumboPool() {
+    // Datagrams above the default 1500-byte blocks, once DPLPMTUD found a
+    // jumbo-frame path (see PmtuProber).
+    return common::MakeBlockMemoryPoolPtr(kMaxPlpmtu, 4);
+}
+
 std::shared_ptr<IPacketAllotor> GlobalResource::MakeDefaultPacketAllotor() {
     return IPacketAllotor::MakePacketAllotor(IPacketAllotor::PacketAllotorType::POOL);
 }
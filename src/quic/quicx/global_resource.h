@@ -14,6 +14,10 @@ namespace quic {
 class GlobalResource: public common::Singleton<GlobalResource> {
 public:
     std::shared_ptr<common::BlockMemoryPool> GetThreadLocalBlockPool();
+    // Pool whose blocks hold a datagram of `size` bytes: the default pool, or
+    // past its 1500-byte blocks a jumbo pool sized for kMaxPlpmtu, created on
+    // first use so connections that never probe that high do not pay for it.
+    std::shared_ptr<common::BlockMemoryPool> GetThreadLocalBlockPool(uint32_t size);
     std::shared_ptr<quic::IPacketAllotor> GetThreadLocalPacketAllotor();
 
     // Register event loop for current thread (for lock-free pool operations)
@@ -26,6 +30,7 @@ private:
     ~GlobalResource() = default;
 
     std::shared_ptr<common::BlockMemoryPool> MakeDefaultPool();
+    std::shared_ptr<common::BlockMemoryPool> MakeJumboPool();
     std::shared_ptr<IPacketAllotor> MakeDefaultPacketAllotor();
 };
 
@@ -4,8 +4,9 @@
 namespace quicx {
 namespace quic {
 
-Master::Master(bool ecn_enabled, std::shared_ptr<common::IEventLoop> event_loop):
-    ecn_enabled_(ecn_enabled) {
+Master::Master(bool ecn_enabled, uint32_t max_datagram_size, std::shared_ptr<common::IEventLoop> event_loop):
+    ecn_enabled_(ecn_enabled),
+    max_datagram_size_(max_datagram_size) {
     receiver_ = IReceiver::MakeReceiver(event_loop);
     if (!receiver_) {
         LOG_ERROR("Master::Master: failed to create receiver");
@@ -14,6 +15,7 @@ Master::Master(bool ecn_enabled, std::shared_ptr<common::IEventLoop> event_loop)
 
 void Master::Init() {
     receiver_->SetEcnEnabled(ecn_enabled_);
+    receiver_->SetMaxDatagramSize(max_datagram_size_);
 
     LOG_DEBUG("Master::Init: processing %zu pending listeners", pending_listeners_.size());
     for (auto& info : pending_listeners_) {
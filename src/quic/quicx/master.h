@@ -18,7 +18,9 @@ class Master:
     public std::enable_shared_from_this<Master> {
 public:
 public:
-    Master(bool ecn_enabled, std::shared_ptr<common::IEventLoop> event_loop);
+    // max_datagram_size: the max_udp_payload_size we advertise, see
+    // IReceiver::SetMaxDatagramSize()
+    Master(bool ecn_enabled, uint32_t max_datagram_size, std::shared_ptr<common::IEventLoop> event_loop);
     virtual ~Master();
 
     virtual void Init();
@@ -41,6 +43,7 @@ private:
 
 protected:
     bool ecn_enabled_;
+    uint32_t max_datagram_size_;
     std::shared_ptr<IReceiver> receiver_;
     std::unordered_map<uint64_t, std::string> cid_worker_map_;
     std::unordered_map<std::string, std::shared_ptr<IWorker>> worker_map_;
@@ -7,8 +7,9 @@
 namespace quicx {
 namespace quic {
 
-MasterWithThread::MasterWithThread(bool ecn_enabled, std::shared_ptr<common::IEventLoop> event_loop):
-    Master(ecn_enabled, event_loop),
+MasterWithThread::MasterWithThread(
+    bool ecn_enabled, uint32_t max_datagram_size, std::shared_ptr<common::IEventLoop> event_loop):
+    Master(ecn_enabled, max_datagram_size, event_loop),
     event_loop_(event_loop),
     ready_future_(ready_promise_.get_future().share()) {}
 
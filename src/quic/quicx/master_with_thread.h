@@ -13,7 +13,7 @@ namespace quic {
 
 class MasterWithThread: public Master, public common::Thread {
 public:
-    MasterWithThread(bool ecn_enabled, std::shared_ptr<common::IEventLoop> event_loop);
+    MasterWithThread(bool ecn_enabled, uint32_t max_datagram_size, std::shared_ptr<common::IEventLoop> event_loop);
     virtual ~MasterWithThread();
 
     void Run() override;
@@ -125,7 +125,8 @@ bool QuicClient::Init(const QuicClientConfig& config) {
         return false;
     }
 
-    master_ = std::make_shared<MasterWithThread>(config.config_.enable_ecn_, master_event_loop_);
+    master_ = std::make_shared<MasterWithThread>(
+        config.config_.enable_ecn_, params_.max_udp_payload_size_, master_event_loop_);
     master_->Start();
 
     if (!master_->WaitUntilReady()) {
@@ -146,6 +147,7 @@ bool QuicClient::Init(const QuicClientConfig& config) {
         LOG_ERROR("set non block failed. err:%d", nonblock_ret.error_code_);
         return false;
     }
+    common::EnableUdpDontFragment(sockfd);
 
     thread_mode_ = config.config_.thread_mode_;
     auto sender = ISender::MakeSender(sockfd);
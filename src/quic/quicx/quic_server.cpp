@@ -129,7 +129,8 @@ bool QuicServer::Init(const QuicServerConfig& config) {
         return false;
     }
 
-    master_ = std::make_shared<MasterWithThread>(config.config_.enable_ecn_, master_event_loop_);
+    master_ = std::make_shared<MasterWithThread>(
+        config.config_.enable_ecn_, params_.max_udp_payload_size_, master_event_loop_);
     master_->Start();
 
     if (!master_->WaitUntilReady()) {
@@ -203,6 +204,18 @@ bool QuicServer::ListenAndAccept(const std::string& ip, uint16_t port) {
             listen_data.port = port;
             listen_data.ip_version = (ip.find(':') != std::string::npos) ? "ipv6" : "ipv4";
             QLOG_SERVER_LISTENING(common::QlogManager::Instance(), listen_data);
+
+            // Per-worker preferred address sockets only pay off when workers
+            // have their own threads; each opens one on its own loop.
+            for (auto& kv : worker_map_) {
+                auto wwt = std::dynamic_pointer_cast<WorkerWithThread>(kv.second);
+                if (!wwt) {
+                    continue;
+                }
+                if (auto worker = std::dynamic_pointer_cast<ServerWorker>(wwt->GetWorker())) {
+                    worker->OpenPreferredAddressSocket(ip);
+                }
+            }
         }
         return result;
     }
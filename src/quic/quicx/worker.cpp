@@ -31,6 +31,14 @@ Worker::Worker(const QuicConfig& config, std::shared_ptr<TLSCtx> ctx, std::share
     ecn_enabled_ = config.enable_ecn_;
     enable_key_update_ = config.enable_key_update_;
     quic_version_ = config.quic_version_;
+    cc_type_ = config.congestion_control_;
+    cc_name_ = config.congestion_control_name_;
+    enable_careful_resume_ = config.enable_careful_resume_;
+    stream_scheduler_ = config.stream_scheduler_;
+    stream_send_buffer_high_ = config.stream_send_buffer_high_;
+    stream_send_buffer_low_ = config.stream_send_buffer_low_;
+    connection_send_buffer_high_ = config.connection_send_buffer_high_;
+    connection_send_buffer_low_ = config.connection_send_buffer_low_;
 }
 
 Worker::~Worker() {}
@@ -63,6 +63,15 @@ protected:
     bool ecn_enabled_;
     bool enable_key_update_;  // RFC 9001: Key Update support
     uint32_t quic_version_;   // QUIC version from config
+    CongestionControlType cc_type_;  // congestion control for new connections
+    std::string cc_name_;            // registered name when cc_type_ is kCustom
+    bool enable_careful_resume_;     // reuse saved path capacity on new connections
+    StreamSchedulerType stream_scheduler_;  // stream scheduling policy for new connections
+    // send buffer watermarks for new connections
+    uint32_t stream_send_buffer_high_;
+    uint32_t stream_send_buffer_low_;
+    uint32_t connection_send_buffer_high_;
+    uint32_t connection_send_buffer_low_;
     std::string worker_id_;
     QuicTransportParams params_;
 
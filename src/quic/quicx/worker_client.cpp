@@ -8,6 +8,15 @@
 namespace quicx {
 namespace quic {
 
+namespace {
+
+// Same key the session cache uses: SNI, or the peer address without one.
+std::string PathCapacityKey(const std::string& ip, uint16_t port, const std::string& server_name) {
+    return server_name.empty() ? common::Address(ip, port).AsString() : server_name;
+}
+
+}  // namespace
+
 // a normal worker
 ClientWorker::ClientWorker(const QuicConfig& config, std::shared_ptr<TLSCtx> ctx, std::shared_ptr<ISender> sender,
     const QuicTransportParams& params, connection_state_callback connection_handler,
@@ -46,6 +55,14 @@ void ClientWorker::Connect(const std::string& ip, uint16_t port, const std::stri
         LOG_INFO("Key Update enabled for connection");
     }
 
+    conn->SetCongestionControl(cc_type_, cc_name_);
+    conn->SetStreamScheduler(stream_scheduler_);
+    conn->SetSendBufferWatermarks(stream_send_buffer_high_, stream_send_buffer_low_, connection_send_buffer_high_,
+        connection_send_buffer_low_);
+    if (enable_careful_resume_) {
+        conn->EnableCarefulResume(PathCapacityKey(ip, port, server_name));
+    }
+
     // RFC 9000 Section 6: Version Negotiation
     // Set callback to handle version negotiation from server.
     // IMPORTANT: capture |conn| as weak_ptr. Capturing by value would create a
@@ -103,8 +120,10 @@ bool ClientWorker::InnerHandlePacket(PacketParseResult& packet_info) {
         common::LogTagGuard guard("conn:" + std::to_string(cid_code));
         // Pin the connection with a local shared_ptr copy (see worker_server.cpp).
         auto connection = conn->second;
-        // update socket fd so GetLocalAddr() works for connection migration
-        connection->SetSocket(packet_info.net_packet_->GetSocket());
+        // the first datagram sets the socket fd so GetLocalAddr() works for
+        // connection migration; later ones only move it with the path
+        connection->SetRecvSocket(packet_info.net_packet_->GetSocket());
+        connection->SetRecvConnectionID(packet_info.cid_);
         // report observed address for path change detection
         auto& observed_addr = packet_info.net_packet_->GetAddress();
         connection->OnObservedPeerAddress(observed_addr);
@@ -220,6 +239,13 @@ void ClientWorker::HandleVersionNegotiation(std::shared_ptr<IConnection> conn, c
     if (enable_key_update_) {
         new_conn->SetKeyUpdateEnabled(true);
     }
+    new_conn->SetCongestionControl(cc_type_, cc_name_);
+    new_conn->SetStreamScheduler(stream_scheduler_);
+    new_conn->SetSendBufferWatermarks(stream_send_buffer_high_, stream_send_buffer_low_,
+        connection_send_buffer_high_, connection_send_buffer_low_);
+    if (enable_careful_resume_) {
+        new_conn->EnableCarefulResume(PathCapacityKey(ip, port, server_name));
+    }
 
     // Set version negotiation callback for the new connection.
     // If server sends another VN packet, the connection will be closed (see BaseConnection::OnVersionNegotiationPacket).
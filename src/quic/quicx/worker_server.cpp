@@ -1,6 +1,7 @@
 #include "common/buffer/buffer_chunk.h"
 #include "common/log/log.h"
 #include "common/log/log_context.h"
+#include "common/network/io_handle.h"
 #include <quicx/common/metrics.h>
 #include <quicx/common/metrics_std.h>
 
@@ -10,12 +11,14 @@
 #include "quic/connection/connection_id_generator.h"
 #include "quic/connection/connection_server.h"
 #include "quic/connection/error.h"
+#include "quic/connection/path_capacity_cache.h"
 #include "quic/crypto/retry_crypto.h"
 #include "quic/crypto/type.h"
 #include "quic/packet/init_packet.h"
 #include "quic/packet/retry_packet.h"
 #include "quic/packet/version_negotiation_packet.h"
 #include "quic/quicx/global_resource.h"
+#include "quic/quicx/msg_parser.h"
 #include "quic/quicx/worker_server.h"
 
 namespace quicx {
@@ -28,7 +31,10 @@ ServerWorker::ServerWorker(const QuicServerConfig& config, std::shared_ptr<TLSCt
     server_alpn_(config.alpn_),
     retry_policy_(config.retry_policy_),
     selective_config_(config.selective_retry_config_),
-    retry_token_lifetime_(config.retry_token_lifetime_) {
+    retry_token_lifetime_(config.retry_token_lifetime_),
+    cc_selector_(config.congestion_control_selector_),
+    worker_preferred_address_(config.worker_preferred_address_),
+    preferred_sock_(-1) {
     // Initialize Retry infrastructure based on policy
     if (retry_policy_ != RetryPolicy::NEVER) {
         retry_token_manager_ = std::make_shared<RetryTokenManager>();
@@ -49,7 +55,11 @@ ServerWorker::ServerWorker(const QuicServerConfig& config, std::shared_ptr<TLSCt
     }
 }
 
-ServerWorker::~ServerWorker() {}
+ServerWorker::~ServerWorker() {
+    if (preferred_packet_receiver_) {
+        preferred_packet_receiver_->Detach();
+    }
+}
 
 void ServerWorker::Shutdown() {
     // Precondition (enforced by QuicServer::~QuicServer): the worker's
@@ -74,9 +84,95 @@ void ServerWorker::Shutdown() {
     ip_limiter_.reset();
     retry_token_manager_.reset();
 
+    // The loop's fd table still references the receiver; with the loop
+    // stopped it only has to stop calling into this worker.
+    if (preferred_packet_receiver_) {
+        preferred_packet_receiver_->Detach();
+    }
+    if (preferred_sock_ >= 0) {
+        common::Close(preferred_sock_);
+        preferred_sock_ = -1;
+    }
+    preferred_address_.clear();
+    preferred_receiver_.reset();
+
     Worker::Shutdown();
 }
 
+void ServerWorker::OpenPreferredAddressSocket(const std::string& ip) {
+    if (!worker_preferred_address_) {
+        return;
+    }
+    auto loop = event_loop_.lock();
+    if (!loop) {
+        return;
+    }
+    if (!loop->IsInLoopThread()) {
+        loop->RunInLoop([this, ip]() { OpenPreferredAddressSocket(ip); });
+        return;
+    }
+    if (preferred_sock_ >= 0) {
+        return;  // one per worker, from the first concrete listener
+    }
+    if (ip.empty() || ip == "0.0.0.0" || ip == "::") {
+        LOG_WARN("worker %s: wildcard listener %s cannot be advertised as preferred address", GetWorkerId().c_str(),
+            ip.c_str());
+        return;
+    }
+
+    bool is_ipv6 = common::Address::CheckAddressType(ip) == common::AddressType::kIpv6;
+    auto sock_ret = is_ipv6 ? common::UdpSocket() : common::UdpSocket4();
+    if (sock_ret.error_code_ != 0) {
+        LOG_ERROR("create preferred address socket failed. err:%d", sock_ret.error_code_);
+        return;
+    }
+    int32_t sockfd = sock_ret.return_value_;
+    common::SocketNoblocking(sockfd);
+    if (ecn_enabled_) {
+        common::EnableUdpEcn(sockfd);
+    }
+    common::EnableUdpDontFragment(sockfd);
+
+    common::Address local_addr(ip, 0);
+    auto bind_ret = common::Bind(sockfd, sock_ret.family_, local_addr);
+    if (bind_ret.error_code_ != 0 || !common::ParseLocalAddress(sockfd, local_addr)) {
+        LOG_ERROR("bind preferred address socket to %s failed. err:%d", ip.c_str(), bind_ret.error_code_);
+        common::Close(sockfd);
+        return;
+    }
+
+    // Datagrams on this socket skip Master::OnPacket and the dispatch queue:
+    // they are parsed and handled right here on the worker loop.
+    preferred_packet_receiver_ = std::make_shared<WorkerSocketReceiver>([this](std::shared_ptr<NetPacket>& pkt) {
+        if (pkt->GetData()->GetDataLength() == 0) {
+            return;
+        }
+        if (!ecn_enabled_) {
+            pkt->SetEcn(0);
+        }
+        PacketParseResult packet_info;
+        if (MsgParser::ParsePacket(pkt, packet_info)) {
+            HandlePacket(packet_info);
+        }
+    });
+    preferred_receiver_ = IReceiver::MakeReceiver(loop);
+    preferred_receiver_->SetEcnEnabled(ecn_enabled_);
+    preferred_receiver_->SetMaxDatagramSize(params_.max_udp_payload_size_);
+    if (!preferred_receiver_->AddReceiver(sockfd, preferred_packet_receiver_)) {
+        LOG_ERROR("register preferred address socket %d failed", sockfd);
+        preferred_packet_receiver_->Detach();
+        preferred_receiver_.reset();
+        common::Close(sockfd);
+        return;
+    }
+
+    preferred_sock_ = sockfd;
+    std::string port = std::to_string(local_addr.GetPort());
+    preferred_address_ = is_ipv6 ? "[" + ip + "]:" + port : ip + ":" + port;
+    LOG_INFO("worker %s: preferred address %s on socket %d", GetWorkerId().c_str(), preferred_address_.c_str(),
+        sockfd);
+}
+
 bool ServerWorker::ShouldSendRetry(bool has_valid_token, const common::Address& client_addr) {
     // If client already has a valid token, never send another Retry (RFC 9000 requirement)
     if (has_valid_token) {
@@ -144,7 +240,8 @@ bool ServerWorker::InnerHandlePacket(PacketParseResult& packet_info) {
         // removes the entry from conn_map_. Without this pin, the iterator
         // would be the last owner and `this` would be destroyed mid-call.
         auto connection = conn->second;
-        connection->SetSocket(packet_info.net_packet_->GetSocket());
+        connection->SetRecvSocket(packet_info.net_packet_->GetSocket());
+        connection->SetRecvConnectionID(packet_info.cid_);
         // report observed address for path change detection
         auto& observed_addr = packet_info.net_packet_->GetAddress();
         connection->OnObservedPeerAddress(observed_addr);
@@ -262,9 +359,27 @@ bool ServerWorker::InnerHandlePacket(PacketParseResult& packet_info) {
     // chosen_version) we will compatibly upgrade during TP processing.
     new_conn->SetPreferredVersion(quic_version_);
 
+    // Congestion control: server-wide default, optionally overridden per peer
+    CongestionControlType cc_type = cc_type_;
+    std::string cc_name = cc_name_;
+    if (cc_selector_) {
+        const common::Address& peer = packet_info.net_packet_->GetAddress();
+        cc_selector_(peer.GetIp(), peer.GetPort(), cc_type, cc_name);
+    }
+    new_conn->SetCongestionControl(cc_type, cc_name);
+    new_conn->SetStreamScheduler(stream_scheduler_);
+    new_conn->SetSendBufferWatermarks(stream_send_buffer_high_, stream_send_buffer_low_,
+        connection_send_buffer_high_, connection_send_buffer_low_);
+    if (enable_careful_resume_) {
+        new_conn->EnableCarefulResume(PathCapacityCache::SubnetKey(packet_info.net_packet_->GetAddress()));
+    }
+
     // RFC 9000 §18.2: Server MUST include original_destination_connection_id
     // in transport parameters, set to the DCID from the client's first Initial packet.
     QuicTransportParams server_params = params_;
+    if (!preferred_address_.empty()) {
+        server_params.preferred_address_ = preferred_address_;
+    }
     if (retry_was_used) {
         // After Retry: ODCID comes from the validated token (the client's very first DCID),
         // and retry_source_connection_id is the SCID the server chose in its Retry packet
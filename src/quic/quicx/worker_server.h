@@ -11,11 +11,30 @@
 #include "quic/quicx/connection_rate_monitor.h"
 #include "quic/quicx/ip_rate_limiter.h"
 #include "quic/quicx/worker.h"
+#include "quic/udp/if_receiver.h"
 #include "quic/udp/if_sender.h"
 
 namespace quicx {
 namespace quic {
 
+// Hands datagrams of a worker-owned socket to a callback. The event loop
+// keeps its receiver (and so this object) alive past the worker, which
+// therefore detaches the callback on shutdown instead of being held.
+class WorkerSocketReceiver: public IPacketReceiver {
+public:
+    explicit WorkerSocketReceiver(std::function<void(std::shared_ptr<NetPacket>&)> handler): handler_(handler) {}
+
+    void OnPacket(std::shared_ptr<NetPacket>& pkt) override {
+        if (handler_) {
+            handler_(pkt);
+        }
+    }
+    void Detach() { handler_ = nullptr; }
+
+private:
+    std::function<void(std::shared_ptr<NetPacket>&)> handler_;
+};
+
 // a normal worker
 class ServerWorker: public Worker {
 public:
@@ -49,6 +68,20 @@ public:
     // loop, so the EventLoop↔Worker refcount cycle can terminate.
     void Shutdown() override;
 
+    /**
+     * @brief Open this worker's own socket on `ip` with an ephemeral port and
+     * advertise it as preferred_address to the connections it accepts.
+     *
+     * A client that migrates there is served straight from this worker's
+     * event loop instead of through the master and the dispatch queue. No-op
+     * unless QuicServerConfig::worker_preferred_address_ is set; callable
+     * from any thread, the socket is opened on the worker loop.
+     */
+    void OpenPreferredAddressSocket(const std::string& ip);
+    // "ip:port" and fd of that socket, empty and -1 until it is open
+    const std::string& GetPreferredAddress() const { return preferred_address_; }
+    int32_t GetPreferredSocket() const { return preferred_sock_; }
+
 protected:
     void SendVersionNegotiatePacket(const common::Address& addr, int32_t socket,
         const uint8_t* client_dcid, uint8_t client_dcid_len,
@@ -96,6 +129,16 @@ private:
     SelectiveRetryConfig selective_config_;
     uint32_t retry_token_lifetime_;
 
+    /** Per-connection congestion control override */
+    congestion_control_selector cc_selector_;
+
+    /** Per-worker preferred address socket, see OpenPreferredAddressSocket() */
+    bool worker_preferred_address_;
+    int32_t preferred_sock_;
+    std::string preferred_address_;  // "ip:port" of preferred_sock_
+    std::shared_ptr<IReceiver> preferred_receiver_;
+    std::shared_ptr<WorkerSocketReceiver> preferred_packet_receiver_;
+
     /** Retry infrastructure */
     std::shared_ptr<RetryTokenManager> retry_token_manager_;
     std::shared_ptr<ConnectionRateMonitor> rate_monitor_;
@@ -31,6 +31,9 @@ public:
     // send data to peer, return the number of bytes sended.
     virtual int32_t Send(uint8_t* data, uint32_t len) override;
     virtual int32_t Send(std::shared_ptr<IBufferRead> buffer) override;
+    virtual int32_t SendZeroCopy(const uint8_t* data, uint32_t len, std::function<void()> release) override {
+        return SendStream::SendZeroCopy(data, len, std::move(release));
+    }
     virtual std::shared_ptr<IBufferWrite> GetSendBuffer() override;
     virtual bool Flush() override;
 
@@ -38,16 +41,25 @@ public:
     // called in the send thread, so do not do any blocking operation.
     // if you don't care about send data detail, you may not set the callback.
     virtual void SetStreamWriteCallBack(stream_write_callback cb) override;
+    virtual void SetSendBufferWatermark(uint32_t high, uint32_t low) override {
+        SendStream::SetSendBufferWatermark(high, low);
+    }
+    virtual void SetStreamWritableCallBack(stream_writable_callback cb) override {
+        SendStream::SetStreamWritableCallBack(cb);
+    }
 
     // Forward to SendStream — reports bytes currently queued in the send
     // buffer awaiting transmission. Used by HTTP/3 streaming body provider
     // to apply backpressure (see ReqRespBaseStream::HandleSent).
     virtual uint64_t GetPendingSendBytes() override { return SendStream::GetPendingSendBytes(); }
+    virtual uint64_t GetRetainedSendBytes() override { return SendStream::GetRetainedSendBytes(); }
+    virtual uint64_t GetSendableBytes() override { return SendStream::GetSendableBytes(); }
 
     // when there are some data received, the callback function will be called.
     // the callback function will be called in the recv thread. so you should not do any blocking operation in the
     // callback function. you should set the callback function firstly, otherwise the data received will be discarded.
     virtual void SetStreamReadCallBack(stream_read_callback cb) override;
+    virtual void SetZeroCopyRead(bool enable) override { RecvStream::SetZeroCopyRead(enable); }
 
     // ***************  inner interface ***************//
     virtual uint32_t OnFrame(std::shared_ptr<IFrame> frame) override;
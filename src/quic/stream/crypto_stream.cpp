@@ -2,6 +2,8 @@
 
 #include "common/log/log.h"
 
+#include "quic/config.h"
+#include "quic/connection/error.h"
 #include "quic/frame/crypto_frame.h"
 #include "quic/quicx/global_resource.h"
 #include "quic/stream/crypto_stream.h"
@@ -18,7 +20,9 @@ CryptoStream::CryptoStream(std::weak_ptr<common::IEventLoop> loop,
         next_read_offset_[i] = 0;
         send_offset_[i] = 0;
         read_buffers_[i] =
-            std::make_shared<common::MultiBlockBuffer>(GlobalResource::Instance().GetThreadLocalBlockPool());
+            std::make_shared<common::MultiBlockBuffer>(GlobalResource::Instance().GetThreadLocalBlockPool(), false);
+        reassembly_[i] = std::unique_ptr<ReassemblyBuffer>(
+            new ReassemblyBuffer(GlobalResource::Instance().GetThreadLocalBlockPool(), kMaxCryptoReassemblyBytes));
         send_buffers_[i] = nullptr;
     }
 }
@@ -114,9 +118,9 @@ void CryptoStream::ResetForRetry() {
 
     // Reset read state
     read_buffers_[level] =
-        std::make_shared<common::MultiBlockBuffer>(GlobalResource::Instance().GetThreadLocalBlockPool());
+        std::make_shared<common::MultiBlockBuffer>(GlobalResource::Instance().GetThreadLocalBlockPool(), false);
     next_read_offset_[level] = 0;
-    out_order_frame_[level].clear();
+    reassembly_[level]->Reset();
 
     // Reset send state
     send_buffers_[level] = nullptr;  // Next send will recreate it if needed
@@ -233,56 +237,32 @@ void CryptoStream::OnCryptoFrame(std::shared_ptr<IFrame> frame) {
     LOG_INFO("CryptoStream::OnCryptoFrame: level=%d, offset=%llu, len=%u, expected=%llu", level,
         crypto_frame->GetOffset(), crypto_frame->GetLength(), next_read_offset_[level]);
 
-    if (crypto_frame->GetOffset() == next_read_offset_[level]) {
-        // IMPORTANT: Copy the bytes into read_buffers_ (do NOT push the shared
-        // chunk). CRYPTO frames from a received packet share the packet's
-        // decode buffer; that buffer is recycled once the packet is fully
-        // processed, so holding a shared pointer is not enough to guarantee
-        // the bytes remain stable. Copy into a fresh chunk owned by
-        // read_buffers_[level] to avoid later corruption.
-        auto data_span = crypto_frame->GetData();
-        read_buffers_[level]->Write(data_span.GetStart(), crypto_frame->GetLength());
-        next_read_offset_[level] += crypto_frame->GetLength();
-
-        // Check for out-of-order frames that can now be processed
-        auto& out_order = out_order_frame_[level];
-        while (true) {
-            auto iter = out_order.find(next_read_offset_[level]);
-            if (iter == out_order.end()) {
-                break;
-            }
-
-            crypto_frame = std::dynamic_pointer_cast<CryptoFrame>(iter->second);
-            auto queued_span = crypto_frame->GetData();
-            read_buffers_[level]->Write(queued_span.GetStart(), crypto_frame->GetLength());
-            next_read_offset_[level] += crypto_frame->GetLength();
-            out_order.erase(iter);
+    // IMPORTANT: CRYPTO frames from a received packet share the packet's
+    // decode buffer, which is recycled once the packet is processed, so the
+    // bytes are copied into the level's reassembly ring right away. Duplicates
+    // and overlaps only copy what is still missing.
+    uint64_t new_bytes = 0;
+    if (!reassembly_[level]->Insert(
+            crypto_frame->GetOffset(), crypto_frame->GetData().GetStart(), crypto_frame->GetLength(), new_bytes)) {
+        // RFC 9000 Section 7.5: too much out-of-order CRYPTO data
+        LOG_ERROR("CryptoStream reassembly buffer exceeded. level=%d, offset=%llu, len=%u", level,
+            crypto_frame->GetOffset(), crypto_frame->GetLength());
+        if (connection_close_cb_) {
+            connection_close_cb_(
+                QuicErrorCode::kCryptoBufferExceeded, crypto_frame->GetType(), "crypto buffer exceeded.");
         }
+        return;
+    }
+
+    if (reassembly_[level]->GetReadOffset() > next_read_offset_[level]) {
+        reassembly_[level]->Drain(*read_buffers_[level]);
+        next_read_offset_[level] = reassembly_[level]->GetReadOffset();
 
         // Notify upper layer (TLS) with correct level
         if (recv_cb_) {
             recv_cb_(read_buffers_[level], 0, level);
         }
-    } else if (crypto_frame->GetOffset() > next_read_offset_[level]) {
-        // Cache out-of-order frame only if not already cached; ignore duplicates
-        // at same offset to avoid overwriting already-buffered frames.
-        if (out_order_frame_[level].find(crypto_frame->GetOffset()) == out_order_frame_[level].end()) {
-            // Must also detach from packet buffer: copy into a standalone frame.
-            auto data_span = crypto_frame->GetData();
-            auto new_frame = std::make_shared<CryptoFrame>();
-            new_frame->SetOffset(crypto_frame->GetOffset());
-            new_frame->SetEncryptionLevel(level);
-            // Allocate a dedicated buffer and copy bytes so the span stays valid
-            // after the source packet buffer is recycled.
-            auto standalone = std::make_shared<common::MultiBlockBuffer>(
-                GlobalResource::Instance().GetThreadLocalBlockPool());
-            standalone->Write(data_span.GetStart(), crypto_frame->GetLength());
-            auto owned_span = standalone->GetSharedReadableSpan(crypto_frame->GetLength());
-            new_frame->SetData(owned_span);
-            out_order_frame_[level][crypto_frame->GetOffset()] = new_frame;
-        }
     }
-    // else: offset < next_read_offset_ -> already processed / retransmit, ignore
 }
 
 }  // namespace quic
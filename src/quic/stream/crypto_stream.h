@@ -1,10 +1,11 @@
 #ifndef QUIC_STREAM_CRYPTO_STREAM
 #define QUIC_STREAM_CRYPTO_STREAM
 
-#include <unordered_map>
+#include <memory>
 #include "common/buffer/multi_block_buffer.h"
 #include "quic/crypto/tls/type.h"
 #include "quic/stream/if_stream.h"
+#include "quic/stream/reassembly_buffer.h"
 
 namespace quicx {
 namespace quic {
@@ -50,7 +51,7 @@ private:
 
     // in order next data offset for each encryption level
     uint64_t next_read_offset_[kNumEncryptionLevels];
-    std::unordered_map<uint64_t, std::shared_ptr<IFrame>> out_order_frame_[kNumEncryptionLevels];
+    std::unique_ptr<ReassemblyBuffer> reassembly_[kNumEncryptionLevels];
 
     // local data send offset for each encryption level
     uint64_t send_offset_[kNumEncryptionLevels];
@@ -7,6 +7,7 @@
 #include "quic/connection/util.h"
 #include "quic/crypto/tls/type.h"
 #include "quic/frame/crypto_frame.h"
+#include "quic/frame/datagram_frame.h"
 #include "quic/frame/stream_frame.h"
 #include "quic/quicx/global_resource.h"
 #include "quic/stream/fix_buffer_frame_visitor.h"
@@ -20,7 +21,7 @@ FixBufferFrameVisitor::FixBufferFrameVisitor(uint32_t limit_size):
     limit_data_offset_(0),
     frame_type_bit_(0),
     last_error_(FrameEncodeError::kNone) {
-    auto chunk = std::make_shared<common::BufferChunk>(GlobalResource::Instance().GetThreadLocalBlockPool());
+    auto chunk = std::make_shared<common::BufferChunk>(GlobalResource::Instance().GetThreadLocalBlockPool(limit_size));
     if (!chunk || !chunk->Valid()) {
         LOG_ERROR("failed to allocate buffer chunk");
         return;
@@ -53,7 +54,7 @@ bool FixBufferFrameVisitor::HandleFrame(std::shared_ptr<IFrame> frame) {
 
     // Remember pre-encode size; if the frame fails to encode below, the
     // stream-data record we are about to push must be rolled back so that
-    // unacked_packets_[ns][pn].stream_data does not advertise bytes that
+    // the sent-packet record for this pn does not advertise bytes that
     // never made it onto the wire.
     size_t pre_encode_stream_data_count = stream_data_list_.size();
 
@@ -100,6 +101,15 @@ bool FixBufferFrameVisitor::HandleFrame(std::shared_ptr<IFrame> frame) {
     LOG_DEBUG(
         "encoded frame. type:%s, length:%u", FrameType2String(frame->GetType()).c_str(), buffer_->GetDataLength());
 
+    if (IsRetransmittableFrame(ftype)) {
+        control_frames_.push_back(frame);
+    } else if (DatagramFrame::IsDatagramFrame(ftype)) {
+        // Never resent, but kept with the packet so its ack or loss can be
+        // reported under the datagram's id. The payload is on the wire now.
+        std::static_pointer_cast<DatagramFrame>(frame)->ReleaseData();
+        control_frames_.push_back(frame);
+    }
+
     // Metrics: Frame transmitted
     common::Metrics::CounterInc(common::MetricsStd::FramesTxTotal);
 
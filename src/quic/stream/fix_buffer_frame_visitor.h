@@ -40,6 +40,8 @@ public:
     
     virtual std::vector<StreamDataInfo> GetStreamDataInfo() const override;
 
+    virtual std::vector<std::shared_ptr<IFrame>> TakeControlFrames() override { return std::move(control_frames_); }
+
     // Get accumulated frame type bit for all frames processed
     uint32_t GetFrameTypeBit() const { return frame_type_bit_; }
 
@@ -61,6 +63,11 @@ private:
     // cumulative-ACK assumption that broke server-side stream completion.
     std::vector<StreamDataInfo> stream_data_list_;
 
+    // Successfully encoded frames that must be resent as is on loss (see
+    // IsRetransmittableFrame), plus DATAGRAM frames whose outcome is reported
+    // to the application; STREAM frames are described by stream_data_list_.
+    std::vector<std::shared_ptr<IFrame>> control_frames_;
+
     // Accumulated frame type bit for all frames processed
     uint32_t frame_type_bit_;
 
@@ -48,6 +48,10 @@ public:
     // Get stream data info for ACK tracking
     virtual std::vector<StreamDataInfo> GetStreamDataInfo() const { return {}; }
 
+    // Move out the retransmittable control frames encoded so far (kept by
+    // SendControl so they can be queued again if the packet is lost)
+    virtual std::vector<std::shared_ptr<IFrame>> TakeControlFrames() { return {}; }
+
     // Get last encoding error
     virtual FrameEncodeError GetLastError() const { return FrameEncodeError::kNone; }
 };
@@ -10,6 +10,21 @@ IStream::TrySendResult IStream::TrySendData(IFrameVisitor* visitor, EncryptionLe
     return TrySendResult::kSuccess;
 }
 
+void IStream::SetPriority(uint8_t urgency, bool incremental) {
+    auto loop = event_loop_.lock();
+    if (loop && !loop->IsInLoopThread()) {
+        auto weak_self = weak_from_this();
+        loop->RunInLoop([weak_self, urgency, incremental]() {
+            auto self = weak_self.lock();
+            if (!self) return;
+            self->SetPriority(urgency, incremental);
+        });
+        return;
+    }
+    urgency_ = urgency > kStreamUrgencyMax ? kStreamUrgencyMax : urgency;
+    incremental_ = incremental;
+}
+
 void IStream::ToClose() {
     if (stream_close_cb_) {
         stream_close_cb_(stream_id_);
@@ -42,6 +42,12 @@ public:
 
     virtual TrySendResult TrySendData(IFrameVisitor* visitor, EncryptionLevel level = kApplication);
 
+    // Send priority, read by the connection's stream scheduler. A stream
+    // already queued moves to its new place the next time it comes up.
+    virtual void SetPriority(uint8_t urgency, bool incremental) override;
+    uint8_t GetUrgency() const { return urgency_; }
+    bool IsIncremental() const { return incremental_; }
+
 protected:
     void ToClose();
     void ToSend();
@@ -52,6 +58,8 @@ protected:
     uint64_t stream_id_;
     // is already active to send?
     bool is_active_send_ = false;
+    uint8_t urgency_ = kStreamUrgencyDefault;
+    bool incremental_ = false;
     // frames that wait for sending
     std::list<std::shared_ptr<IFrame>> frames_list_;
 
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "common/buffer/buffer_chunk.h"
+#include "common/buffer/shared_buffer_span.h"
+#include "common/log/log.h"
+
+#include "quic/config.h"
+#include "quic/stream/reassembly_buffer.h"
+
+namespace quicx {
+namespace quic {
+
+ReassemblyBuffer::ReassemblyBuffer(std::shared_ptr<common::BlockMemoryPool> pool, uint64_t max_span):
+    pool_(pool),
+    max_span_(max_span),
+    block_length_(pool ? pool->GetBlockLength() : 0),
+    base_offset_(0),
+    drained_offset_(0),
+    read_offset_(0),
+    highest_offset_(0) {}
+
+ReassemblyBuffer::~ReassemblyBuffer() {}
+
+bool ReassemblyBuffer::Insert(uint64_t offset, const uint8_t* data, uint32_t len, uint64_t& new_bytes) {
+    new_bytes = 0;
+    uint64_t end = offset + len;
+    if (len == 0 || end <= read_offset_) {
+        return true;
+    }
+    if (offset < read_offset_) {
+        data += read_offset_ - offset;
+        offset = read_offset_;
+    }
+    if (max_span_ > 0 && end - read_offset_ > max_span_) {
+        LOG_WARN("reassembly data beyond max span. offset:%llu, end:%llu, read offset:%llu, max span:%llu", offset,
+            end, read_offset_, max_span_);
+        return false;
+    }
+
+    // first range that touches [offset, end]
+    auto iter = ranges_.upper_bound(offset);
+    if (iter != ranges_.begin() && std::prev(iter)->second >= offset) {
+        --iter;
+    }
+    bool isolated = offset > read_offset_ && (iter == ranges_.end() || iter->first > end);
+    if (isolated && ranges_.size() >= kMaxReassemblyRanges) {
+        LOG_WARN("too many reassembly ranges. count:%zu, offset:%llu", ranges_.size(), offset);
+        return false;
+    }
+
+    // allocate before touching the ranges so a failure leaves them intact
+    uint64_t last_slot = (end - 1 - base_offset_) / block_length_;
+    if (slots_.size() <= last_slot) {
+        slots_.resize(last_slot + 1);
+    }
+    for (uint64_t slot = (offset - base_offset_) / block_length_; slot <= last_slot; slot++) {
+        if (!slots_[slot]) {
+            auto chunk = std::make_shared<common::BufferChunk>(pool_);
+            if (!chunk->Valid()) {
+                LOG_ERROR("reassembly buffer failed to allocate a block");
+                return false;
+            }
+            slots_[slot] = chunk;
+        }
+    }
+
+    // copy only the gaps between ranges already held, merging as we go
+    uint64_t start = offset;
+    uint64_t stop = end;
+    uint64_t cursor = offset;
+    while (iter != ranges_.end() && iter->first <= end) {
+        if (iter->first > cursor) {
+            CopyIn(cursor, data + (cursor - offset), iter->first - cursor);
+            new_bytes += iter->first - cursor;
+        }
+        cursor = std::max(cursor, iter->second);
+        start = std::min(start, iter->first);
+        stop = std::max(stop, iter->second);
+        iter = ranges_.erase(iter);
+    }
+    if (cursor < end) {
+        CopyIn(cursor, data + (cursor - offset), end - cursor);
+        new_bytes += end - cursor;
+    }
+
+    if (start == read_offset_) {
+        read_offset_ = stop;
+    } else {
+        ranges_[start] = stop;
+    }
+    highest_offset_ = std::max(highest_offset_, end);
+    return true;
+}
+
+bool ReassemblyBuffer::Skip(uint64_t offset, uint32_t len) {
+    if (len == 0 || offset != read_offset_ || drained_offset_ != read_offset_ || !ranges_.empty() ||
+        highest_offset_ > read_offset_) {
+        return false;
+    }
+    if (max_span_ > 0 && len > max_span_) {
+        return false;
+    }
+    // a partly drained block stays with the reader's spans; the ring starts
+    // over past the skipped bytes
+    slots_.clear();
+    read_offset_ += len;
+    drained_offset_ = read_offset_;
+    highest_offset_ = read_offset_;
+    base_offset_ = read_offset_;
+    return true;
+}
+
+uint64_t ReassemblyBuffer::Drain(common::IBuffer& reader) {
+    uint64_t appended = 0;
+    while (drained_offset_ < read_offset_) {
+        uint32_t available = 0;
+        uint8_t* start = SlotData(drained_offset_, available);
+        uint32_t len = static_cast<uint32_t>(std::min<uint64_t>(available, read_offset_ - drained_offset_));
+        reader.Write(common::SharedBufferSpan(slots_.front(), start, len));
+        drained_offset_ += len;
+        appended += len;
+
+        // the reader's span keeps the block alive from here on
+        if (len == available) {
+            slots_.pop_front();
+            base_offset_ += block_length_;
+        }
+    }
+    return appended;
+}
+
+void ReassemblyBuffer::Reset() {
+    slots_.clear();
+    ranges_.clear();
+    base_offset_ = 0;
+    drained_offset_ = 0;
+    read_offset_ = 0;
+    highest_offset_ = 0;
+}
+
+void ReassemblyBuffer::CopyIn(uint64_t offset, const uint8_t* data, uint64_t len) {
+    while (len > 0) {
+        uint32_t available = 0;
+        uint8_t* dst = SlotData(offset, available);
+        uint32_t step = static_cast<uint32_t>(std::min<uint64_t>(available, len));
+        memcpy(dst, data, step);
+        offset += step;
+        data += step;
+        len -= step;
+    }
+}
+
+uint8_t* ReassemblyBuffer::SlotData(uint64_t offset, uint32_t& available) {
+    uint64_t pos = offset - base_offset_;
+    uint32_t in_block = static_cast<uint32_t>(pos % block_length_);
+    available = block_length_ - in_block;
+    return slots_[pos / block_length_]->GetData() + in_block;
+}
+
+}  // namespace quic
+}  // namespace quicx
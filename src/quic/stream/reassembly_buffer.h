@@ -0,0 +1,85 @@
+#ifndef QUIC_STREAM_REASSEMBLY_BUFFER
+#define QUIC_STREAM_REASSEMBLY_BUFFER
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+
+#include "common/alloter/pool_block.h"
+#include "common/buffer/if_buffer.h"
+#include "common/buffer/if_buffer_chunk.h"
+
+namespace quicx {
+namespace quic {
+
+/**
+ * @brief Puts stream or crypto bytes back in offset order.
+ *
+ * Every received byte is copied once, straight to its final position in a
+ * ring of pool blocks that covers [read offset, highest offset). The blocks
+ * holding the contiguous prefix are then handed to the reader as spans, so
+ * in-order data reaches the application without a second copy, and a block
+ * leaves the ring once the reader has been given all of it.
+ *
+ * Filled ranges beyond the contiguous prefix are kept as disjoint intervals,
+ * so retransmitted and overlapping frames only copy the bytes still missing
+ * and a filled gap costs one interval lookup.
+ */
+class ReassemblyBuffer {
+public:
+    // |max_span| bounds how far past the read offset data may land; 0 leaves
+    // it to the caller (stream flow control already does).
+    explicit ReassemblyBuffer(std::shared_ptr<common::BlockMemoryPool> pool, uint64_t max_span = 0);
+    ~ReassemblyBuffer();
+
+    // Store [offset, offset + len). |new_bytes| is set to how many of them
+    // were not held or delivered before. Returns false, storing nothing, if
+    // the data lies beyond max_span or would need more than
+    // kMaxReassemblyRanges gaps.
+    bool Insert(uint64_t offset, const uint8_t* data, uint32_t len, uint64_t& new_bytes);
+
+    // Take [offset, offset + len) as delivered without storing it, so the
+    // caller can pass the bytes on where they are. Only possible when they
+    // start at the read offset and nothing is held or undrained; returns
+    // false, changing nothing, otherwise.
+    bool Skip(uint64_t offset, uint32_t len);
+
+    // Append the contiguous bytes not handed out yet to |reader| as spans of
+    // the ring's blocks. Returns the number of bytes appended.
+    uint64_t Drain(common::IBuffer& reader);
+
+    // End of the contiguous prefix, i.e. the next expected offset.
+    uint64_t GetReadOffset() const { return read_offset_; }
+    // Highest offset received so far.
+    uint64_t GetHighestOffset() const { return highest_offset_; }
+    // Number of filled ranges waiting for a gap before them.
+    size_t GetRangeCount() const { return ranges_.size(); }
+
+    // Drop everything and start again at offset 0.
+    void Reset();
+
+private:
+    void CopyIn(uint64_t offset, const uint8_t* data, uint64_t len);
+    uint8_t* SlotData(uint64_t offset, uint32_t& available);
+
+private:
+    std::shared_ptr<common::BlockMemoryPool> pool_;
+    uint64_t max_span_;
+    uint32_t block_length_;
+
+    // ring of blocks; slots_[0] starts at base_offset_, unused slots are null
+    std::deque<std::shared_ptr<common::IBufferChunk>> slots_;
+    uint64_t base_offset_;
+    // bytes below this were appended to a reader by Drain()
+    uint64_t drained_offset_;
+    uint64_t read_offset_;
+    uint64_t highest_offset_;
+    // filled [start, end) ranges above read_offset_, keyed by start
+    std::map<uint64_t, uint64_t> ranges_;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -1,6 +1,7 @@
 #include <algorithm>
 
 #include "common/log/log.h"
+#include "common/util/time.h"
 #include <quicx/common/metrics.h>
 #include <quicx/common/metrics_std.h>
 
@@ -23,11 +24,18 @@ RecvStream::RecvStream(std::weak_ptr<common::IEventLoop> loop, uint64_t init_dat
     std::function<void(uint64_t stream_id)> stream_close_cb,
     std::function<void(uint64_t error, uint16_t frame_type, const std::string& resion)> connection_close_cb):
     IStream(loop, id, active_send_cb, stream_close_cb, connection_close_cb),
-    local_data_limit_(init_data_limit),
     final_offset_(0),
+    local_data_limit_(init_data_limit),
     except_offset_(0),
-    reset_error_(0) {
-    buffer_ = std::make_shared<common::MultiBlockBuffer>(GlobalResource::Instance().GetThreadLocalBlockPool());
+    reassembly_(GlobalResource::Instance().GetThreadLocalBlockPool()),
+    reset_error_(0),
+    consumed_offset_(0),
+    recv_bytes_(0),
+    zero_copy_read_(false),
+    held_bytes_(0) {
+    window_tuner_.Reset(init_data_limit, kMaxStreamWindowSize);
+    // no pre-allocated block: the reader only receives the reassembly ring's blocks
+    buffer_ = std::make_shared<common::MultiBlockBuffer>(GlobalResource::Instance().GetThreadLocalBlockPool(), false);
     recv_machine_ = std::make_shared<StreamStateMachineRecv>();
 }
 
@@ -160,114 +168,89 @@ uint32_t RecvStream::OnStreamFrame(std::shared_ptr<IFrame> frame) {
     LOG_DEBUG("stream recv stream frame. stream id:%llu, offset:%llu, length:%u, final offset:%llu", stream_id_,
         stream_frame->GetOffset(), stream_frame->GetLength(), final_offset_);
 
-    if (stream_frame->GetOffset() == except_offset_) {
-        // CRITICAL: Use deep copy (Write(uint8_t*, len)) instead of shallow copy (Write(SharedBufferSpan, len)).
-        // SharedBufferSpan points into the packet buffer chunk, which may be shared by multiple STREAM frames
-        // from the same packet (belonging to different streams). If we shallow-copy (push the chunk directly
-        // into our buffer's chunk list), subsequent Write operations may use the "free" space after our data
-        // in that chunk — but that space may contain another stream's data. This causes cross-stream
-        // data contamination. Deep copy avoids this by copying data into our own exclusive chunks.
-        buffer_->Write(stream_frame->GetData().GetStart(), stream_frame->GetLength());
-        except_offset_ += stream_frame->GetLength();
-
-        while (true) {
-            auto iter = out_order_frame_.find(except_offset_);
-            if (iter == out_order_frame_.end()) {
-                break;
-            }
+    // RFC 9000 Section 4.5: once the final size is known, no data may lie beyond it
+    if (final_offset_ != 0 && frame_end > final_offset_) {
+        LOG_ERROR("stream recv data out of final size. stream id:%d, offset:%d, final offset:%d",
+            stream_id_, stream_frame->GetOffset(), final_offset_);
+        if (connection_close_cb_) {
+            connection_close_cb_(QuicErrorCode::kFinalSizeError, frame->GetType(), "data out of final size.");
+        }
+        return 0;
+    }
 
-            stream_frame = std::dynamic_pointer_cast<StreamFrame>(iter->second);
-            buffer_->Write(stream_frame->GetData().GetStart(), stream_frame->GetLength());
-            except_offset_ += stream_frame->GetLength();
-            out_order_frame_.erase(iter);
+    // Copy the bytes to their final position in the reassembly ring. The frame's
+    // span points into the decrypted packet's block, which other frames share;
+    // keeping it pins the whole block, so only zero-copy reads do that, and
+    // only for data arriving in order.
+    bool zero_copy = zero_copy_read_ && recv_cb_;
+    bool in_place = zero_copy && reassembly_.Skip(stream_frame->GetOffset(), stream_frame->GetLength());
+    uint64_t new_bytes = in_place ? stream_frame->GetLength() : 0;
+    if (!in_place && !reassembly_.Insert(stream_frame->GetOffset(), stream_frame->GetData().GetStart(),
+            stream_frame->GetLength(), new_bytes)) {
+        LOG_ERROR("too many out-of-order ranges. stream id:%d, count:%d", stream_id_,
+            (int)reassembly_.GetRangeCount());
+        if (connection_close_cb_) {
+            connection_close_cb_(QuicErrorCode::kFlowControlError, frame->GetType(), "too many out-of-order frames");
         }
+        return 0;
+    }
+
+    // a FIN without data at the expected offset still completes the stream
+    bool fin_here = stream_frame->IsFin() && stream_frame->GetOffset() == except_offset_;
+    if (new_bytes == 0 && !fin_here) {
+        LOG_DEBUG("stream recv repeat packet. stream id:%d, offset:%d", stream_id_, stream_frame->GetOffset());
+        return 0;
+    }
+
+    if (reassembly_.GetReadOffset() > except_offset_ || fin_here) {
+        // RFC 9000 Section 2.2: data at a given offset never changes, so the
+        // ring's blocks go to the reader as they are, without another copy
+        std::shared_ptr<common::MultiBlockBuffer> data = buffer_;
+        if (zero_copy) {
+            std::unique_ptr<common::MultiBlockBuffer> read(
+                new common::MultiBlockBuffer(GlobalResource::Instance().GetThreadLocalBlockPool(), false));
+            // bytes buffered before zero-copy reads were enabled come first
+            if (buffer_->GetDataLength() > 0) {
+                read->Write(std::static_pointer_cast<common::IBuffer>(buffer_));
+            }
+            if (in_place) {
+                read->Write(stream_frame->GetData());
+            } else {
+                reassembly_.Drain(*read);
+            }
+            data = HoldReadBuffer(std::move(read));
+        } else {
+            reassembly_.Drain(*buffer_);
+        }
+        except_offset_ = reassembly_.GetReadOffset();
 
         bool is_last = false;
-        if (final_offset_ != 0 && final_offset_ == except_offset_ && out_order_frame_.empty()) {
+        if (final_offset_ != 0 && final_offset_ == except_offset_) {
             is_last = true;
             recv_machine_->RecvAllData();
         }
 
         LOG_DEBUG("RecvStream::OnStreamFrame triggering recv_cb_. stream id:%d, has_cb:%d, is_last:%d, "
-            "buffer_len:%d, final_offset:%d, except_offset:%d, out_order_size:%d",
+            "buffer_len:%d, final_offset:%d, except_offset:%d, out_order_ranges:%d",
             stream_id_, (recv_cb_ ? 1 : 0), is_last, buffer_->GetDataLength(),
-            final_offset_, except_offset_, (int)out_order_frame_.size());
+            final_offset_, except_offset_, (int)reassembly_.GetRangeCount());
 
         if (recv_cb_) {
-            recv_cb_(buffer_, is_last, reset_error_);
+            recv_cb_(data, is_last, reset_error_);
         }
 
         if (recv_machine_->CanAppReadAllData()) {
             recv_machine_->AppReadAllData();
         }
-
-    } else {
-        // RFC 9000 Section 4.6: If a RESET_STREAM or STREAM frame
-        // is received indicating a change in the final size for the stream, an endpoint MUST respond with
-        // an error of type FINAL_SIZE_ERROR.
-        if (final_offset_ != 0 && stream_frame->GetOffset() > final_offset_) {
-            LOG_ERROR("stream recv data out of final size. stream id:%d, offset:%d, final offset:%d",
-                stream_id_, stream_frame->GetOffset(), final_offset_);
-            if (connection_close_cb_) {
-                connection_close_cb_(QuicErrorCode::kFinalSizeError, frame->GetType(), "data out of final size.");
-            }
-            return 0;
-        }
-
-        // RFC 9000 Section 2.2: The data at a given offset MUST NOT change if it is sent multiple times.
-        if (out_order_frame_.find(stream_frame->GetOffset()) != out_order_frame_.end() ||
-            stream_frame->GetOffset() < except_offset_) {
-            LOG_DEBUG(
-                "stream recv repeat packet. stream id:%d, offset:%d", stream_id_, stream_frame->GetOffset());
-            return 0;
-        }
-
-        // Limit out-of-order frame buffer to prevent memory exhaustion from malicious peers
-        if (out_order_frame_.size() >= kMaxOutOfOrderFrames) {
-            LOG_ERROR("too many out-of-order frames. stream id:%d, count:%d",
-                stream_id_, (int)out_order_frame_.size());
-            if (connection_close_cb_) {
-                connection_close_cb_(QuicErrorCode::kFlowControlError,
-                    frame->GetType(), "too many out-of-order frames");
-            }
-            return 0;
-        }
-        out_order_frame_[stream_frame->GetOffset()] = stream_frame;
     }
 
-    // Proactive flow control window update strategy:
-    // - Send MAX_STREAM_DATA early (when 25% consumed) to prevent sender stalling
-    // - Use large increments to reduce frequency of updates
-    // - This allows sender to continue at full speed without waiting for window updates
-    const uint64_t kWindowThreshold = local_data_limit_ / 4;      // Trigger at 25% remaining (proactive)
-    const uint64_t kWindowIncrement = kStreamWindowIncrement;     // Use configured increment for high throughput
-
-    uint64_t remaining_window = local_data_limit_ - except_offset_;
-    if (remaining_window < kWindowThreshold) {
-        if (recv_machine_->CheckCanSendFrame(FrameType::kMaxStreamData)) {
-            // Calculate increment to restore window to a healthy size
-            // Aim for at least 2MB available window after update
-            uint64_t target_window = kStreamWindowIncrement;
-            uint64_t needed = (target_window > remaining_window) ? (target_window - remaining_window) : kWindowIncrement;
-            // Round up to nearest kWindowIncrement
-            needed = ((needed + kWindowIncrement - 1) / kWindowIncrement) * kWindowIncrement;
-            
-            local_data_limit_ += needed;
-            auto max_frame = std::make_shared<MaxStreamDataFrame>();
-            max_frame->SetStreamID(stream_id_);
-            max_frame->SetMaximumData(local_data_limit_);
-            frames_list_.emplace_back(max_frame);
-
-            ToSend();
-            LOG_DEBUG("Proactive flow control update: stream_id=%llu, new_limit=%llu, consumed=%llu, added=%llu", 
-                stream_id_, local_data_limit_, except_offset_, needed);
-        }
-    }
+    recv_bytes_ += new_bytes;
+    CheckRecvWindow(false);
 
     // Metrics: Stream data received
-    common::Metrics::CounterInc(common::MetricsStd::QuicStreamsBytesRx, stream_frame->GetLength());
+    common::Metrics::CounterInc(common::MetricsStd::QuicStreamsBytesRx, new_bytes);
 
-    return stream_frame->GetLength();
+    return static_cast<uint32_t>(new_bytes);
 }
 
 void RecvStream::OnStreamDataBlockFrame(std::shared_ptr<IFrame> frame) {
@@ -278,26 +261,12 @@ void RecvStream::OnStreamDataBlockFrame(std::shared_ptr<IFrame> frame) {
     }
 
     auto block_frame = std::dynamic_pointer_cast<StreamDataBlockedFrame>(frame);
+    LOG_DEBUG("stream recv data blocked. stream id:%d, blocked_at:%llu, limit:%llu, consumed:%llu", stream_id_,
+        block_frame->GetMaximumData(), local_data_limit_, consumed_offset_);
 
-    // When peer is blocked, increase window significantly to allow high throughput
-    // Use configured increments (see quic/config.h)
-
-    if (local_data_limit_ >= kMaxStreamWindowSize) {
-        LOG_WARN("stream recv window already at max. stream id:%d, limit:%llu",
-            stream_id_, local_data_limit_);
-        return;
-    }
-    local_data_limit_ = std::min(local_data_limit_ + kBlockedWindowIncrement, kMaxStreamWindowSize);
-
-    auto max_frame = std::make_shared<MaxStreamDataFrame>();
-    max_frame->SetStreamID(stream_id_);
-    max_frame->SetMaximumData(local_data_limit_);
-    frames_list_.emplace_back(max_frame);
-
-    LOG_DEBUG("stream recv data blocked, increased window. stream id:%d, blocked_at:%llu, new_limit:%llu",
-        stream_id_, block_frame->GetMaximumData(), local_data_limit_);
-
-    ToSend();
+    // the window only moves with what the application read, but hand that
+    // back right away instead of waiting for half a window
+    CheckRecvWindow(true);
 }
 
 void RecvStream::OnResetStreamFrame(std::shared_ptr<IFrame> frame) {
@@ -336,5 +305,67 @@ void RecvStream::OnResetStreamFrame(std::shared_ptr<IFrame> frame) {
     common::Metrics::CounterInc(common::MetricsStd::QuicStreamsResetRx);
 }
 
+std::shared_ptr<common::MultiBlockBuffer> RecvStream::HoldReadBuffer(std::unique_ptr<common::MultiBlockBuffer> buffer) {
+    uint64_t bytes = buffer->GetDataLength();
+    held_bytes_ += bytes;
+
+    auto weak_self = weak_from_this();
+    auto weak_loop = event_loop_;
+    return std::shared_ptr<common::MultiBlockBuffer>(
+        buffer.release(), [weak_self, weak_loop, bytes](common::MultiBlockBuffer* read) {
+            // the blocks go back to the pools of the loop's thread
+            auto release = [weak_self, bytes, read]() {
+                delete read;
+                auto self = std::dynamic_pointer_cast<RecvStream>(weak_self.lock());
+                if (self) {
+                    self->OnReadBufferReleased(bytes);
+                }
+            };
+            auto loop = weak_loop.lock();
+            if (loop && !loop->IsInLoopThread()) {
+                loop->RunInLoop(release);
+                return;
+            }
+            release();
+        });
+}
+
+void RecvStream::OnReadBufferReleased(uint64_t bytes) {
+    held_bytes_ -= std::min(bytes, held_bytes_);
+    CheckRecvWindow(false);
+}
+
+void RecvStream::CheckRecvWindow(bool peer_blocked) {
+    uint64_t consumed = except_offset_ - buffer_->GetDataLength() - held_bytes_;
+    if (consumed > consumed_offset_) {
+        uint64_t delta = consumed - consumed_offset_;
+        consumed_offset_ = consumed;
+        if (data_consumed_cb_) {
+            data_consumed_cb_(delta);
+        }
+    }
+
+    // RFC 9000 Section 3.2: no MAX_STREAM_DATA once all data has been received
+    if (!recv_machine_->CheckCanSendFrame(FrameType::kMaxStreamData)) {
+        return;
+    }
+
+    uint64_t new_limit = 0;
+    uint32_t smoothed_rtt = rtt_cb_ ? rtt_cb_() : 0;
+    if (!window_tuner_.OnConsumed(consumed_offset_, common::UTCTimeMsec(), smoothed_rtt, new_limit, peer_blocked)) {
+        return;
+    }
+    local_data_limit_ = new_limit;
+
+    auto max_frame = std::make_shared<MaxStreamDataFrame>();
+    max_frame->SetStreamID(stream_id_);
+    max_frame->SetMaximumData(local_data_limit_);
+    frames_list_.emplace_back(max_frame);
+
+    ToSend();
+    LOG_DEBUG("stream recv window update. stream id:%llu, new limit:%llu, consumed:%llu, window:%llu", stream_id_,
+        local_data_limit_, consumed_offset_, window_tuner_.GetWindow());
+}
+
 }  // namespace quic
 }  // namespace quicx
@@ -3,13 +3,14 @@
 
 #include <functional>
 #include <string>
-#include <unordered_map>
 
 #include "common/buffer/multi_block_buffer.h"
 
 #include <quicx/quic/if_quic_recv_stream.h>
+#include "quic/connection/controler/recv_window_tuner.h"
 #include "quic/stream/if_frame_visitor.h"
 #include "quic/stream/if_stream.h"
+#include "quic/stream/reassembly_buffer.h"
 #include "quic/stream/state_machine_recv.h"
 
 namespace quicx {
@@ -28,6 +29,7 @@ public:
     virtual uint64_t GetStreamID() { return stream_id_; }
     virtual void Reset(uint32_t error);
     virtual void SetStreamReadCallBack(stream_read_callback cb) { recv_cb_ = cb; }
+    virtual void SetZeroCopyRead(bool enable) { zero_copy_read_ = enable; }
 
     // *************** inner interface ***************//
     // process recv frames, return the number of bytes consumed.
@@ -36,13 +38,30 @@ public:
     // try generate data to send
     virtual IStream::TrySendResult TrySendData(IFrameVisitor* visitor);
 
+    // smoothed RTT of the connection, lets the receive window auto-tune
+    void SetRttProvider(std::function<uint32_t()> cb) { rtt_cb_ = cb; }
+    // told how many bytes the application read, for connection-level flow control
+    void SetDataConsumedCallBack(std::function<void(uint64_t bytes)> cb) { data_consumed_cb_ = cb; }
+    // bytes received on this stream that the application has not read
+    uint64_t GetUnconsumedBytes() const { return recv_bytes_ > consumed_offset_ ? recv_bytes_ - consumed_offset_ : 0; }
+    // bytes handed out by zero-copy reads and still held by the application
+    uint64_t GetHeldReadBytes() const { return held_bytes_; }
+
     // Getter for testing
     std::shared_ptr<StreamStateMachineRecv> GetRecvStateMachine() const { return recv_machine_; }
+    uint64_t GetRecvWindow() const { return window_tuner_.GetWindow(); }
+    uint64_t GetLocalDataLimit() const { return local_data_limit_; }
 
 protected:
     virtual uint32_t OnStreamFrame(std::shared_ptr<IFrame> frame);
     virtual void OnStreamDataBlockFrame(std::shared_ptr<IFrame> frame);
     virtual void OnResetStreamFrame(std::shared_ptr<IFrame> frame);
+    // report what the application consumed and queue MAX_STREAM_DATA when due
+    void CheckRecvWindow(bool peer_blocked);
+    // Hand |buffer| to the application for a zero-copy read; dropping it
+    // gives its bytes back to the receive window, on the loop thread.
+    std::shared_ptr<common::MultiBlockBuffer> HoldReadBuffer(std::unique_ptr<common::MultiBlockBuffer> buffer);
+    void OnReadBufferReleased(uint64_t bytes);
 
 protected:
     uint64_t final_offset_;
@@ -51,11 +70,21 @@ protected:
     // next except data offset
     uint64_t except_offset_;
     std::shared_ptr<common::MultiBlockBuffer> buffer_;
-    std::unordered_map<uint64_t, std::shared_ptr<IFrame>> out_order_frame_;
+    ReassemblyBuffer reassembly_;
 
     std::shared_ptr<StreamStateMachineRecv> recv_machine_;
     stream_read_callback recv_cb_;
     uint32_t reset_error_;
+
+    // flow control window, credited as the application reads
+    RecvWindowTuner window_tuner_;
+    uint64_t consumed_offset_;
+    uint64_t recv_bytes_;
+    std::function<uint32_t()> rtt_cb_;
+    std::function<void(uint64_t bytes)> data_consumed_cb_;
+
+    bool zero_copy_read_;
+    uint64_t held_bytes_;  // zero-copy reads not dropped yet
 };
 
 }  // namespace quic
@@ -0,0 +1,50 @@
+#ifndef QUIC_STREAM_SCHEDULER_IF_STREAM_SCHEDULER
+#define QUIC_STREAM_SCHEDULER_IF_STREAM_SCHEDULER
+
+#include <cstddef>
+#include <memory>
+
+#include <quicx/quic/type.h>
+
+namespace quicx {
+namespace quic {
+
+class IStream;
+
+/**
+ * @brief Ready queue deciding which stream fills the next packet
+ *
+ * The connection pushes a stream when it has something to send, pops the
+ * stream to serve and, when that stream filled the packet and still has
+ * data, hands it back with Requeue() so the scheduler can decide whether
+ * it keeps the turn. Priorities are read from IStream at push time; a
+ * stream whose priority changed while queued is moved when it is popped.
+ *
+ * The crypto stream is not scheduled here, the connection always serves
+ * it first.
+ */
+class IStreamScheduler {
+public:
+    IStreamScheduler() {}
+    virtual ~IStreamScheduler() {}
+
+    // Queue a stream with data to send; does nothing if it is queued already.
+    virtual void Push(std::shared_ptr<IStream> stream) = 0;
+    // Take the stream to serve next out of the queue, nullptr when empty.
+    virtual std::shared_ptr<IStream> Pop() = 0;
+    // Put back the stream just popped that filled the packet and has more to send.
+    virtual void Requeue(std::shared_ptr<IStream> stream) = 0;
+
+    virtual bool IsEmpty() const = 0;
+    virtual size_t Size() const = 0;
+    virtual void Clear() = 0;
+
+    virtual StreamSchedulerType GetType() const = 0;
+};
+
+std::unique_ptr<IStreamScheduler> MakeStreamScheduler(StreamSchedulerType type);
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
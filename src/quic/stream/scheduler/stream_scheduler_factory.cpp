@@ -0,0 +1,22 @@
+#include "quic/stream/scheduler/if_stream_scheduler.h"
+#include "quic/stream/scheduler/strict_priority_scheduler.h"
+#include "quic/stream/scheduler/urgency_incremental_scheduler.h"
+#include "quic/stream/scheduler/weighted_round_robin_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+std::unique_ptr<IStreamScheduler> MakeStreamScheduler(StreamSchedulerType type) {
+    switch (type) {
+        case StreamSchedulerType::kStrictPriority:
+            return std::unique_ptr<IStreamScheduler>(new StrictPriorityScheduler());
+        case StreamSchedulerType::kWeightedRoundRobin:
+            return std::unique_ptr<IStreamScheduler>(new WeightedRoundRobinScheduler());
+        case StreamSchedulerType::kUrgencyIncremental:
+        default:
+            return std::unique_ptr<IStreamScheduler>(new UrgencyIncrementalScheduler());
+    }
+}
+
+}  // namespace quic
+}  // namespace quicx
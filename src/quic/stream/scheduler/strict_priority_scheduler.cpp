@@ -0,0 +1,54 @@
+#include "quic/stream/if_stream.h"
+#include "quic/stream/scheduler/strict_priority_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+StrictPriorityScheduler::StrictPriorityScheduler(): non_empty_(0) {}
+
+StrictPriorityScheduler::~StrictPriorityScheduler() {}
+
+void StrictPriorityScheduler::Push(std::shared_ptr<IStream> stream) {
+    if (!stream || queued_.count(stream.get())) {
+        return;
+    }
+    uint8_t urgency = stream->GetUrgency();
+    queued_.emplace(stream.get(), urgency);
+    buckets_[urgency].push_back(stream);
+    non_empty_ |= 1u << urgency;
+}
+
+std::shared_ptr<IStream> StrictPriorityScheduler::Pop() {
+    while (non_empty_ != 0) {
+        uint8_t urgency = 0;
+        while ((non_empty_ & (1u << urgency)) == 0) {
+            urgency++;
+        }
+        auto& bucket = buckets_[urgency];
+        std::shared_ptr<IStream> stream = bucket.front();
+        bucket.pop_front();
+        if (bucket.empty()) {
+            non_empty_ &= ~(1u << urgency);
+        }
+        queued_.erase(stream.get());
+
+        // priority changed while queued: move it and look again
+        if (stream->GetUrgency() != urgency) {
+            Push(stream);
+            continue;
+        }
+        return stream;
+    }
+    return nullptr;
+}
+
+void StrictPriorityScheduler::Clear() {
+    for (auto& bucket : buckets_) {
+        bucket.clear();
+    }
+    non_empty_ = 0;
+    queued_.clear();
+}
+
+}  // namespace quic
+}  // namespace quicx
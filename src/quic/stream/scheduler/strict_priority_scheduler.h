@@ -0,0 +1,45 @@
+#ifndef QUIC_STREAM_SCHEDULER_STRICT_PRIORITY_SCHEDULER
+#define QUIC_STREAM_SCHEDULER_STRICT_PRIORITY_SCHEDULER
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+#include "quic/stream/scheduler/if_stream_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+/**
+ * @brief Lowest urgency first, round-robin within an urgency
+ *
+ * One FIFO per urgency and a bit mask of the non-empty ones, so every
+ * operation is O(1). A less urgent stream only sends when nothing more
+ * urgent has data ready.
+ */
+class StrictPriorityScheduler: public IStreamScheduler {
+public:
+    StrictPriorityScheduler();
+    virtual ~StrictPriorityScheduler();
+
+    virtual void Push(std::shared_ptr<IStream> stream) override;
+    virtual std::shared_ptr<IStream> Pop() override;
+    virtual void Requeue(std::shared_ptr<IStream> stream) override { Push(stream); }
+
+    virtual bool IsEmpty() const override { return queued_.empty(); }
+    virtual size_t Size() const override { return queued_.size(); }
+    virtual void Clear() override;
+
+    virtual StreamSchedulerType GetType() const override { return StreamSchedulerType::kStrictPriority; }
+
+private:
+    std::deque<std::shared_ptr<IStream>> buckets_[kStreamUrgencyMax + 1];
+    uint32_t non_empty_;  // bit u set while buckets_[u] holds a stream
+    // queued stream -> urgency of the bucket it sits in
+    std::unordered_map<IStream*, uint8_t> queued_;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -0,0 +1,67 @@
+#include "quic/stream/if_stream.h"
+#include "quic/stream/scheduler/urgency_incremental_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+UrgencyIncrementalScheduler::UrgencyIncrementalScheduler(): non_empty_(0) {}
+
+UrgencyIncrementalScheduler::~UrgencyIncrementalScheduler() {}
+
+void UrgencyIncrementalScheduler::Push(std::shared_ptr<IStream> stream) {
+    if (!stream || queued_.count(stream.get())) {
+        return;
+    }
+    Slot slot{stream->GetUrgency(), stream->IsIncremental()};
+    queued_.emplace(stream.get(), slot);
+    auto& bucket = buckets_[slot.urgency];
+    if (slot.incremental) {
+        bucket.incremental.push_back(stream);
+    } else {
+        bucket.sequential.emplace(stream->GetStreamID(), stream);
+    }
+    non_empty_ |= 1u << slot.urgency;
+}
+
+std::shared_ptr<IStream> UrgencyIncrementalScheduler::Pop() {
+    while (non_empty_ != 0) {
+        uint8_t urgency = 0;
+        while ((non_empty_ & (1u << urgency)) == 0) {
+            urgency++;
+        }
+        auto& bucket = buckets_[urgency];
+        std::shared_ptr<IStream> stream;
+        bool incremental = bucket.sequential.empty();
+        if (!incremental) {
+            stream = bucket.sequential.begin()->second;
+            bucket.sequential.erase(bucket.sequential.begin());
+        } else {
+            stream = bucket.incremental.front();
+            bucket.incremental.pop_front();
+        }
+        if (bucket.IsEmpty()) {
+            non_empty_ &= ~(1u << urgency);
+        }
+        queued_.erase(stream.get());
+
+        // priority changed while queued: move it and look again
+        if (stream->GetUrgency() != urgency || stream->IsIncremental() != incremental) {
+            Push(stream);
+            continue;
+        }
+        return stream;
+    }
+    return nullptr;
+}
+
+void UrgencyIncrementalScheduler::Clear() {
+    for (auto& bucket : buckets_) {
+        bucket.sequential.clear();
+        bucket.incremental.clear();
+    }
+    non_empty_ = 0;
+    queued_.clear();
+}
+
+}  // namespace quic
+}  // namespace quicx
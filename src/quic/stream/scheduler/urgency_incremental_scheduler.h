@@ -0,0 +1,59 @@
+#ifndef QUIC_STREAM_SCHEDULER_URGENCY_INCREMENTAL_SCHEDULER
+#define QUIC_STREAM_SCHEDULER_URGENCY_INCREMENTAL_SCHEDULER
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <unordered_map>
+
+#include "quic/stream/scheduler/if_stream_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+/**
+ * @brief RFC 9218 Extensible Priorities
+ *
+ * Lowest urgency first. Within an urgency, non-incremental streams are sent
+ * one at a time in stream ID order (a half-sent response is useless to the
+ * peer), then incremental streams share what is left packet by packet.
+ *
+ * Each urgency keeps an ordered map for the non-incremental streams and a
+ * FIFO for the incremental ones, with a bit mask of the non-empty
+ * urgencies: O(log n) push and pop.
+ */
+class UrgencyIncrementalScheduler: public IStreamScheduler {
+public:
+    UrgencyIncrementalScheduler();
+    virtual ~UrgencyIncrementalScheduler();
+
+    virtual void Push(std::shared_ptr<IStream> stream) override;
+    virtual std::shared_ptr<IStream> Pop() override;
+    virtual void Requeue(std::shared_ptr<IStream> stream) override { Push(stream); }
+
+    virtual bool IsEmpty() const override { return queued_.empty(); }
+    virtual size_t Size() const override { return queued_.size(); }
+    virtual void Clear() override;
+
+    virtual StreamSchedulerType GetType() const override { return StreamSchedulerType::kUrgencyIncremental; }
+
+private:
+    struct Bucket {
+        std::map<uint64_t, std::shared_ptr<IStream>> sequential;  // by stream ID
+        std::deque<std::shared_ptr<IStream>> incremental;
+        bool IsEmpty() const { return sequential.empty() && incremental.empty(); }
+    };
+    struct Slot {
+        uint8_t urgency;
+        bool incremental;
+    };
+
+    Bucket buckets_[kStreamUrgencyMax + 1];
+    uint32_t non_empty_;  // bit u set while buckets_[u] holds a stream
+    std::unordered_map<IStream*, Slot> queued_;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -0,0 +1,54 @@
+#include "quic/stream/if_stream.h"
+#include "quic/stream/scheduler/weighted_round_robin_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+WeightedRoundRobinScheduler::WeightedRoundRobinScheduler(): serving_(nullptr), turns_left_(0) {}
+
+WeightedRoundRobinScheduler::~WeightedRoundRobinScheduler() {}
+
+void WeightedRoundRobinScheduler::Push(std::shared_ptr<IStream> stream) {
+    if (!stream || !queued_.insert(stream.get()).second) {
+        return;
+    }
+    ring_.push_back(stream);
+}
+
+std::shared_ptr<IStream> WeightedRoundRobinScheduler::Pop() {
+    if (ring_.empty()) {
+        return nullptr;
+    }
+    std::shared_ptr<IStream> stream = ring_.front();
+    ring_.pop_front();
+    queued_.erase(stream.get());
+
+    if (stream.get() != serving_) {
+        serving_ = stream.get();
+        turns_left_ = kStreamUrgencyMax + 1 - stream->GetUrgency();
+    }
+    turns_left_--;
+    return stream;
+}
+
+void WeightedRoundRobinScheduler::Requeue(std::shared_ptr<IStream> stream) {
+    if (!stream || !queued_.insert(stream.get()).second) {
+        return;
+    }
+    if (stream.get() == serving_ && turns_left_ > 0) {
+        ring_.push_front(stream);
+        return;
+    }
+    ring_.push_back(stream);
+    serving_ = nullptr;
+}
+
+void WeightedRoundRobinScheduler::Clear() {
+    ring_.clear();
+    queued_.clear();
+    serving_ = nullptr;
+    turns_left_ = 0;
+}
+
+}  // namespace quic
+}  // namespace quicx
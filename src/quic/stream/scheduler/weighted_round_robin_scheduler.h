@@ -0,0 +1,48 @@
+#ifndef QUIC_STREAM_SCHEDULER_WEIGHTED_ROUND_ROBIN_SCHEDULER
+#define QUIC_STREAM_SCHEDULER_WEIGHTED_ROUND_ROBIN_SCHEDULER
+
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+
+#include "quic/stream/scheduler/if_stream_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+/**
+ * @brief Weighted round-robin over every ready stream
+ *
+ * A stream keeps the turn for (kStreamUrgencyMax + 1 - urgency) packets,
+ * then goes to the back of the ring, so an urgency 0 stream gets eight
+ * packets for every one of an urgency 7 stream and nobody starves. One
+ * FIFO ring: O(1) push and pop.
+ */
+class WeightedRoundRobinScheduler: public IStreamScheduler {
+public:
+    WeightedRoundRobinScheduler();
+    virtual ~WeightedRoundRobinScheduler();
+
+    virtual void Push(std::shared_ptr<IStream> stream) override;
+    virtual std::shared_ptr<IStream> Pop() override;
+    virtual void Requeue(std::shared_ptr<IStream> stream) override;
+
+    virtual bool IsEmpty() const override { return queued_.empty(); }
+    virtual size_t Size() const override { return queued_.size(); }
+    virtual void Clear() override;
+
+    virtual StreamSchedulerType GetType() const override { return StreamSchedulerType::kWeightedRoundRobin; }
+
+private:
+    std::deque<std::shared_ptr<IStream>> ring_;
+    std::unordered_set<IStream*> queued_;
+    // stream holding the turn and the packets it has left in it; only
+    // compared, never dereferenced
+    IStream* serving_;
+    uint8_t turns_left_;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
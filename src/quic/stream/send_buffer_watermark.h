@@ -0,0 +1,75 @@
+#ifndef QUIC_STREAM_SEND_BUFFER_WATERMARK
+#define QUIC_STREAM_SEND_BUFFER_WATERMARK
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace quicx {
+namespace quic {
+
+/**
+ * @brief High/low marks on the bytes queued for sending
+ *
+ * Send() takes no more than the room below the high mark; writers cut short
+ * are told to go on once the queue drained to the low mark. A high mark of 0
+ * means no limit. One instance sits in every SendStream and one is shared by
+ * all streams of a connection.
+ *
+ * Counters are atomics so that Send() called off the connection's thread can
+ * reserve room before posting its data; concurrent writers may overshoot the
+ * high mark by at most what they reserve at once.
+ */
+class SendBufferWatermark {
+public:
+    SendBufferWatermark(): high_(0), low_(0), queued_(0), blocked_(false) {}
+
+    void SetMarks(uint64_t high, uint64_t low) {
+        high_.store(high, std::memory_order_relaxed);
+        low_.store(std::min(low, high), std::memory_order_relaxed);
+    }
+    uint64_t GetHigh() const { return high_.load(std::memory_order_relaxed); }
+    uint64_t GetLow() const { return low_.load(std::memory_order_relaxed); }
+
+    // Bytes the next Send() may still take.
+    uint64_t GetRoom() const {
+        uint64_t high = high_.load(std::memory_order_relaxed);
+        if (high == 0) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        uint64_t queued = queued_.load(std::memory_order_relaxed);
+        return high > queued ? high - queued : 0;
+    }
+
+    void Add(uint64_t bytes) { queued_.fetch_add(bytes, std::memory_order_relaxed); }
+    void Sub(uint64_t bytes) { queued_.fetch_sub(bytes, std::memory_order_relaxed); }
+    uint64_t GetQueued() const { return queued_.load(std::memory_order_relaxed); }
+
+    bool IsDrained() const {
+        return high_.load(std::memory_order_relaxed) == 0 ||
+               queued_.load(std::memory_order_relaxed) <= low_.load(std::memory_order_relaxed);
+    }
+
+    // A writer was cut short and waits for IsDrained().
+    void MarkBlocked() { blocked_.store(true, std::memory_order_relaxed); }
+    bool IsBlocked() const { return blocked_.load(std::memory_order_relaxed); }
+    // True once per blocked period, when the queue drained.
+    bool TakeBlockedIfDrained() {
+        if (!blocked_.load(std::memory_order_relaxed) || !IsDrained()) {
+            return false;
+        }
+        return blocked_.exchange(false, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> high_;
+    std::atomic<uint64_t> low_;
+    std::atomic<uint64_t> queued_;
+    std::atomic<bool> blocked_;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
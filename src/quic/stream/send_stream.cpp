@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <cstdint>
 
+#include "common/buffer/external_buffer_chunk.h"
 #include "common/log/log.h"
 
 #include <quicx/common/metrics.h>
@@ -19,6 +20,60 @@
 namespace quicx {
 namespace quic {
 
+namespace {
+
+// Reserved room for the STREAM frame header when sizing a frame to the
+// packet (worst case: type<=2B + stream_id<=8B + offset<=8B + length<=2B =
+// 20B; rounded to 24B for safety).
+constexpr uint32_t kStreamHeaderReserve = 24;
+
+// Add [start, end) to a set of disjoint [start, end) ranges, merging any
+// neighbours it touches.
+void InsertRange(std::map<uint64_t, uint64_t>& ranges, uint64_t start, uint64_t end) {
+    // Find the first range whose start > start, then step back if the
+    // preceding range overlaps/abuts. This collapses any chain of ranges
+    // that the new interval bridges in one pass.
+    auto it = ranges.upper_bound(start);
+    if (it != ranges.begin()) {
+        auto prev = std::prev(it);
+        if (prev->second >= start) {
+            start = prev->first;
+            if (prev->second > end) end = prev->second;
+            it = prev;
+        }
+    }
+    while (it != ranges.end() && it->first <= end) {
+        if (it->second > end) end = it->second;
+        it = ranges.erase(it);
+    }
+    ranges.emplace(start, end);
+}
+
+// Remove [start, end) from a set of disjoint [start, end) ranges.
+void EraseRange(std::map<uint64_t, uint64_t>& ranges, uint64_t start, uint64_t end) {
+    auto it = ranges.upper_bound(start);
+    if (it != ranges.begin()) {
+        auto prev = std::prev(it);
+        if (prev->second > start) {
+            it = prev;
+        }
+    }
+    while (it != ranges.end() && it->first < end) {
+        uint64_t range_start = it->first;
+        uint64_t range_end = it->second;
+        it = ranges.erase(it);
+        if (range_start < start) {
+            ranges.emplace(range_start, start);
+        }
+        if (range_end > end) {
+            it = ranges.emplace(end, range_end).first;
+            break;
+        }
+    }
+}
+
+}  // namespace
+
 SendStream::SendStream(std::weak_ptr<common::IEventLoop> loop, uint64_t init_data_limit, uint64_t id,
     std::function<void(std::shared_ptr<IStream>)> active_send_cb,
     std::function<void(uint64_t stream_id)> stream_close_cb,
@@ -30,11 +85,21 @@ SendStream::SendStream(std::weak_ptr<common::IEventLoop> loop, uint64_t init_dat
     fin_sent_(false),
     peer_data_limit_(init_data_limit),
     blocked_at_limit_(0),  // Initialize to 0 - means STREAM_DATA_BLOCKED not sent yet
-    send_buffer_(std::make_shared<common::MultiBlockBuffer>(GlobalResource::Instance().GetThreadLocalBlockPool())) {
+    send_buffer_(std::make_shared<common::MultiBlockBuffer>(GlobalResource::Instance().GetThreadLocalBlockPool())),
+    retained_bytes_(0),
+    fin_lost_(false),
+    fin_acked_(false),
+    accounted_bytes_(0),
+    write_blocked_(false) {
     send_machine_ = std::make_shared<StreamStateMachineSend>();
 }
 
-SendStream::~SendStream() {}
+SendStream::~SendStream() {
+    if (retained_bytes_ > 0) {
+        common::Metrics::GaugeDec(common::MetricsStd::QuicStreamsSendRetainedBytes, retained_bytes_);
+    }
+    ReleaseSendBuffer();
+}
 
 void SendStream::Close() {
     auto loop = event_loop_.lock();
@@ -77,6 +142,13 @@ void SendStream::Reset(uint32_t error) {
         return;
     }
 
+    // RFC 9000 §3.3: once RESET_STREAM is sent, lost STREAM data is not resent.
+    unacked_data_.clear();
+    common::Metrics::GaugeDec(common::MetricsStd::QuicStreamsSendRetainedBytes, retained_bytes_);
+    retained_bytes_ = 0;
+    lost_ranges_.clear();
+    fin_lost_ = false;
+
     auto frame = std::make_shared<ResetStreamFrame>();
     frame->SetStreamID(stream_id_);
     frame->SetFinalSize(send_data_offset_);
@@ -98,16 +170,27 @@ int32_t SendStream::Send(uint8_t* data, uint32_t len) {
     if (!loop->IsInLoopThread()) {
         LOG_WARN("SendStream::Send called from wrong thread, posting to EventLoop: stream_id=%llu, len=%u",
             GetStreamID(), len);
+        len = ReserveWriteRoom(len);
+        if (len == 0) {
+            return 0;
+        }
         std::vector<uint8_t> vec(data, data + len);
         auto weak_self = weak_from_this();
-        loop->RunInLoop([weak_self, vec = std::move(vec)]() {
+        auto conn_watermark = conn_watermark_;
+        loop->RunInLoop([weak_self, conn_watermark, vec = std::move(vec)]() {
+            if (conn_watermark) {
+                conn_watermark->Sub(vec.size());
+            }
             auto self = weak_self.lock();
             if (!self) return;
             auto stream = std::dynamic_pointer_cast<SendStream>(self);
             if (stream) {
                 LOG_DEBUG("SendStream::Send async execution in EventLoop: stream_id=%llu, len=%zu",
                     stream->GetStreamID(), vec.size());
-                stream->Send(const_cast<uint8_t*>(vec.data()), vec.size());
+                stream->buffer_watermark_.Sub(vec.size());
+                stream->WriteReserved([&vec](common::MultiBlockBuffer& buffer) {
+                    buffer.Write(const_cast<uint8_t*>(vec.data()), vec.size());
+                });
             }
         });
         return len;
@@ -118,7 +201,12 @@ int32_t SendStream::Send(uint8_t* data, uint32_t len) {
         return -1;
     }
 
-    int32_t ret = send_buffer_->Write(data, len);
+    uint32_t accepted = TakeWriteRoom(len);
+    if (accepted == 0 && len > 0) {
+        return 0;
+    }
+    int32_t ret = send_buffer_->Write(data, accepted);
+    SyncBufferedBytes();
     LOG_DEBUG("SendStream::Send: wrote to buffer, stream_id=%llu, requested=%u, written=%d, buffer_size=%u",
         GetStreamID(), len, ret, send_buffer_->GetDataLength());
 
@@ -133,29 +221,199 @@ int32_t SendStream::Send(std::shared_ptr<IBufferRead> buffer) {
     auto loop = event_loop_.lock();
     if (!loop) return -1;
     if (!loop->IsInLoopThread()) {
+        uint32_t len = ReserveWriteRoom(buffer->GetDataLength());
+        if (len == 0) {
+            return 0;
+        }
         auto weak_self = weak_from_this();
-        loop->RunInLoop([weak_self, buffer]() {
+        auto conn_watermark = conn_watermark_;
+        loop->RunInLoop([weak_self, conn_watermark, buffer, len]() {
+            if (conn_watermark) {
+                conn_watermark->Sub(len);
+            }
             auto self = weak_self.lock();
             if (!self) return;
             auto stream = std::dynamic_pointer_cast<SendStream>(self);
             if (stream) {
-                stream->Send(buffer);
+                stream->buffer_watermark_.Sub(len);
+                stream->WriteReserved([&buffer, len](common::MultiBlockBuffer& send_buffer) {
+                    send_buffer.Write(buffer, len);
+                });
             }
         });
-        return buffer->GetDataLength();
+        return len;
     }
 
     if (!send_machine_->CheckCanSendFrame(FrameType::kStream)) {
         return -1;
     }
 
-    int32_t ret = send_buffer_->Write(buffer);
+    uint32_t len = buffer->GetDataLength();
+    uint32_t accepted = TakeWriteRoom(len);
+    if (accepted == 0 && len > 0) {
+        return 0;
+    }
+    int32_t ret = send_buffer_->Write(buffer, accepted);
+    SyncBufferedBytes();
     if (active_send_cb_) {
         active_send_cb_(shared_from_this());
     }
     return ret;
 }
 
+int32_t SendStream::SendZeroCopy(const uint8_t* data, uint32_t len, std::function<void()> release) {
+    auto loop = event_loop_.lock();
+    if (!loop || !data) return -1;
+    if (len == 0) {
+        return 0;
+    }
+
+    if (!loop->IsInLoopThread()) {
+        if (ReserveWriteRoom(len, true) == 0) {
+            return 0;
+        }
+        // from here on the chunk owns the memory, whatever happens to the stream
+        auto chunk = std::make_shared<common::ExternalBufferChunk>(data, len, std::move(release));
+        common::SharedBufferSpan span(chunk, chunk->GetData(), len);
+        auto weak_self = weak_from_this();
+        auto conn_watermark = conn_watermark_;
+        loop->RunInLoop([weak_self, conn_watermark, span, len]() {
+            if (conn_watermark) {
+                conn_watermark->Sub(len);
+            }
+            auto self = weak_self.lock();
+            if (!self) return;
+            auto stream = std::dynamic_pointer_cast<SendStream>(self);
+            if (stream) {
+                stream->buffer_watermark_.Sub(len);
+                stream->WriteReserved([&span](common::MultiBlockBuffer& send_buffer) { send_buffer.Write(span); });
+            }
+        });
+        return len;
+    }
+
+    if (!send_machine_->CheckCanSendFrame(FrameType::kStream)) {
+        return -1;
+    }
+    if (TakeWriteRoom(len, true) == 0) {
+        return 0;
+    }
+
+    auto chunk = std::make_shared<common::ExternalBufferChunk>(data, len, std::move(release));
+    send_buffer_->Write(common::SharedBufferSpan(chunk, chunk->GetData(), len));
+    SyncBufferedBytes();
+    if (active_send_cb_) {
+        active_send_cb_(shared_from_this());
+    }
+    return len;
+}
+
+uint64_t SendStream::GetSendableBytes() {
+    // stream and connection send state both belong to the loop thread
+    auto loop = event_loop_.lock();
+    if (loop) {
+        loop->AssertInLoopThread();
+    }
+    if (to_fin_ || !send_machine_->CheckCanSendFrame(FrameType::kStream)) {
+        return 0;
+    }
+    uint64_t budget = peer_data_limit_ > send_data_offset_ ? peer_data_limit_ - send_data_offset_ : 0;
+    if (send_budget_cb_) {
+        budget = std::min(budget, send_budget_cb_());
+    }
+    uint64_t pending = GetPendingSendBytes();
+    return budget > pending ? budget - pending : 0;
+}
+
+uint64_t SendStream::GetWriteRoom() const {
+    uint64_t room = buffer_watermark_.GetRoom();
+    auto conn_watermark = conn_watermark_;
+    if (conn_watermark) {
+        room = std::min(room, conn_watermark->GetRoom());
+    }
+    return room;
+}
+
+uint32_t SendStream::TakeWriteRoom(uint32_t len, bool whole) {
+    uint64_t room = GetWriteRoom();
+    if (room >= len || (whole && room > 0)) {
+        return len;
+    }
+    write_blocked_ = true;
+    auto conn_watermark = conn_watermark_;
+    if (conn_watermark) {
+        conn_watermark->MarkBlocked();
+    }
+    LOG_DEBUG("stream send buffer above high watermark. stream id:%llu, requested:%u, room:%llu", stream_id_, len,
+        room);
+    return static_cast<uint32_t>(room);
+}
+
+uint32_t SendStream::ReserveWriteRoom(uint32_t len, bool whole) {
+    len = TakeWriteRoom(len, whole);
+    buffer_watermark_.Add(len);
+    auto conn_watermark = conn_watermark_;
+    if (conn_watermark) {
+        conn_watermark->Add(len);
+    }
+    return len;
+}
+
+void SendStream::WriteReserved(const std::function<void(common::MultiBlockBuffer&)>& write) {
+    // the stream may have been reset or closed since Send() took the data
+    if (!send_machine_->CheckCanSendFrame(FrameType::kStream)) {
+        return;
+    }
+    write(*send_buffer_);
+    SyncBufferedBytes();
+    if (active_send_cb_) {
+        active_send_cb_(shared_from_this());
+    }
+}
+
+void SendStream::SyncBufferedBytes() {
+    uint64_t buffered = send_buffer_->GetDataLength();
+    if (buffered == accounted_bytes_) {
+        return;
+    }
+    if (buffered > accounted_bytes_) {
+        buffer_watermark_.Add(buffered - accounted_bytes_);
+        if (conn_watermark_) {
+            conn_watermark_->Add(buffered - accounted_bytes_);
+        }
+    } else {
+        buffer_watermark_.Sub(accounted_bytes_ - buffered);
+        if (conn_watermark_) {
+            conn_watermark_->Sub(accounted_bytes_ - buffered);
+        }
+    }
+    accounted_bytes_ = buffered;
+}
+
+void SendStream::ReleaseSendBuffer() {
+    buffer_watermark_.Sub(accounted_bytes_);
+    if (conn_watermark_) {
+        conn_watermark_->Sub(accounted_bytes_);
+    }
+    accounted_bytes_ = 0;
+}
+
+void SendStream::CheckWritable() {
+    if (!write_blocked_ || !buffer_watermark_.IsDrained()) {
+        return;
+    }
+    if (conn_watermark_ && !conn_watermark_->IsDrained()) {
+        // other streams still hold the connection's buffer; the connection
+        // wakes us once it drained
+        conn_watermark_->MarkBlocked();
+        return;
+    }
+    write_blocked_ = false;
+    if (writable_cb_) {
+        writable_cb_(GetWriteRoom());
+    }
+}
+
 std::shared_ptr<IBufferWrite> SendStream::GetSendBuffer() {
     return std::dynamic_pointer_cast<IBufferWrite>(send_buffer_);
 }
@@ -186,6 +444,8 @@ bool SendStream::Flush() {
             "stream send flush failed. stream id:%llu, buffer length:%u", stream_id_, send_buffer_->GetDataLength());
         return false;
     }
+    // data written straight into GetSendBuffer()
+    SyncBufferedBytes();
 
     if (active_send_cb_) {
         active_send_cb_(shared_from_this());
@@ -211,6 +471,15 @@ uint32_t SendStream::OnFrame(std::shared_ptr<IFrame> frame) {
 IStream::TrySendResult SendStream::TrySendData(IFrameVisitor* visitor, EncryptionLevel level) {
     IStream::TrySendData(nullptr, level);
 
+    // RFC 9000 §13.3: lost data goes out before anything new. It was already
+    // counted against flow control when first sent, so no limit applies.
+    if (HasLostData()) {
+        auto ret = TrySendLostData(visitor);
+        if (ret != TrySendResult::kSuccess) {
+            return ret;
+        }
+    }
+
     // check peer limit (guard against unsigned underflow when send_data_offset_ > peer_data_limit_)
     if (peer_data_limit_ > send_data_offset_ && peer_data_limit_ - send_data_offset_ < kStreamDataBlockedThreshold) {
         // Only send STREAM_DATA_BLOCKED once per limit value
@@ -273,13 +542,11 @@ IStream::TrySendResult SendStream::TrySendData(IFrameVisitor* visitor, Encryptio
 
         // Per-datagram cap: the STREAM frame must fit into whatever space
         // the current packet buffer still has. Reserve a small budget for
-        // the STREAM header (worst case: type<=2B + stream_id<=8B + offset
-        // <=8B + length<=2B = 20B; round to 24B for safety). This replaces
+        // the STREAM header (kStreamHeaderReserve). This replaces
         // the historical hardcoded 1300 cap which was ~120B smaller than
         // the visitor's real budget (kVisitorBudget=1420), causing each
         // 1500B send_buffer chunk to be split into 1300+200 fragments and
         // halving steady-state datagram payload.
-        constexpr uint32_t kStreamHeaderReserve = 24;
         uint32_t pkt_left = visitor->GetPacketLeftSize();
         uint32_t pkt_cap = pkt_left > kStreamHeaderReserve ? pkt_left - kStreamHeaderReserve : 0;
         if (send_size > pkt_cap) {
@@ -431,8 +698,16 @@ IStream::TrySendResult SendStream::TrySendData(IFrameVisitor* visitor, Encryptio
     LOG_DEBUG("stream send data. stream id:%d, send size:%d,is fin:%d, left data size:%d", stream_id_,
         frame->GetData().GetLength(), frame->IsFin(), send_buffer_->GetDataLength());
 
+    // Keep the bytes until they are ACKed so a lost range can be resent
+    // without holding on to the packet.
+    if (frame->GetData().GetLength() > 0) {
+        unacked_data_.push_back(SentData{send_data_offset_, frame->GetData().GetLength(), frame->GetData()});
+        retained_bytes_ += frame->GetData().GetLength();
+        common::Metrics::GaugeInc(common::MetricsStd::QuicStreamsSendRetainedBytes, frame->GetData().GetLength());
+    }
     send_buffer_->MoveReadPt(frame->GetData().GetLength());
     send_data_offset_ += frame->GetData().GetLength();
+    SyncBufferedBytes();
 
     LOG_DEBUG("stream send data callback. stream id:%d, send size:%d,is fin:%d", stream_id_,
         frame->GetData().GetLength(), frame->IsFin());
@@ -444,6 +719,7 @@ IStream::TrySendResult SendStream::TrySendData(IFrameVisitor* visitor, Encryptio
 
     // Metrics: Stream data sent
     common::Metrics::CounterInc(common::MetricsStd::QuicStreamsBytesTx, frame->GetData().GetLength());
+    CheckWritable();
 
     // if there is still data in the buffer, signal that more packets are needed
     if (send_buffer_->GetDataLength() > 0) {
@@ -507,40 +783,27 @@ void SendStream::OnDataAcked(uint64_t offset_start, uint64_t length, bool has_fi
         "send_data_offset=%llu",
         stream_id_, offset_start, offset_start + length, has_fin, acked_offset_, send_data_offset_);
 
-    // 1. Insert [offset_start, offset_start + length) into the disjoint
-    //    interval set, merging any neighbours we touch. A length of 0 is
-    //    legal (e.g. a FIN-only frame) — we just skip the range insert.
-    if (length > 0) {
-        uint64_t new_start = offset_start;
-        uint64_t new_end = offset_start + length;
-
-        // Find the first range whose start > new_start, then step back if the
-        // preceding range overlaps/abuts. This collapses any chain of ranges
-        // that the new interval bridges in one pass.
-        auto it = acked_ranges_.upper_bound(new_start);
-        if (it != acked_ranges_.begin()) {
-            auto prev = std::prev(it);
-            if (prev->second >= new_start) {
-                new_start = prev->first;
-                if (prev->second > new_end) new_end = prev->second;
-                it = prev;
-            }
+    // 1. Insert the part of [offset_start, offset_start + length) above the
+    //    contiguous prefix into the disjoint interval list, merging any
+    //    neighbours we touch. A length of 0 is legal (e.g. a FIN-only
+    //    frame) — we just skip the range insert. A range ACKed through a
+    //    later packet no longer needs resending.
+    uint64_t offset_end = offset_start + length;
+    if (offset_end > acked_offset_) {
+        acked_ranges_.Insert(std::max(offset_start, acked_offset_), offset_end);
+        if (!lost_ranges_.empty()) {
+            EraseRange(lost_ranges_, offset_start, offset_end);
         }
-        while (it != acked_ranges_.end() && it->first <= new_end) {
-            if (it->second > new_end) new_end = it->second;
-            it = acked_ranges_.erase(it);
-        }
-        acked_ranges_.emplace(new_start, new_end);
     }
 
-    // 2. Recompute the contiguous ACKed prefix length. acked_offset_ is the
-    //    largest N such that [0, N) is fully covered. With a sorted map this
-    //    is just the end of the first range, *iff* it starts at 0.
-    if (!acked_ranges_.empty()) {
-        auto first = acked_ranges_.begin();
-        if (first->first == 0 && first->second > acked_offset_) {
-            acked_offset_ = first->second;
-        }
+    // 2. Advance the contiguous ACKed prefix. acked_offset_ is the largest N
+    //    such that [0, N) is fully covered: if the lowest range now touches
+    //    it, fold that range in and trim it from the list.
+    if (!acked_ranges_.IsEmpty() && acked_ranges_.Front().start <= acked_offset_) {
+        acked_offset_ = acked_ranges_.Front().end;
+        acked_ranges_.TrimBelow(acked_offset_);
+    } else if (offset_end > acked_offset_) {
+        ReleaseAckedData(offset_start, offset_end);
     }
 
     // 3. Track FIN ACK separately. The flag is also set in TrySendData when
@@ -550,12 +813,16 @@ void SendStream::OnDataAcked(uint64_t offset_start, uint64_t length, bool has_fi
     //    AllAckDone to fire on the ACK rather than the original send.
     if (has_fin) {
         fin_sent_ = true;
+        fin_acked_ = true;
+        fin_lost_ = false;
     }
 
-    // 4. Stream completion: every sent byte must be inside acked_ranges_ AND
-    //    FIN must have been ACKed. The first condition collapses to
-    //    acked_offset_ >= send_data_offset_ because acked_ranges_ is disjoint
-    //    and the contiguous prefix anchored at 0 is exactly acked_offset_.
+    ReleaseAckedData();
+
+    // 4. Stream completion: every sent byte must be ACKed AND FIN must have
+    //    been ACKed. The first condition collapses to
+    //    acked_offset_ >= send_data_offset_ because acked_ranges_ only holds
+    //    what lies above the contiguous prefix.
     CheckAllDataAcked();
 }
 
@@ -566,7 +833,7 @@ void SendStream::CheckAllDataAcked() {
         LOG_DEBUG(
             "SendStream::CheckAllDataAcked: all data acked for stream %d, transitioning to Data Recvd state "
             "(acked=%llu, sent=%llu, ranges=%zu)",
-            stream_id_, acked_offset_, send_data_offset_, acked_ranges_.size());
+            stream_id_, acked_offset_, send_data_offset_, acked_ranges_.Size());
 
         // Transition to terminal state (Data Recvd)
         if (send_machine_->AllAckDone()) {
@@ -577,5 +844,174 @@ void SendStream::CheckAllDataAcked() {
     }
 }
 
+void SendStream::OnDataLost(uint64_t offset_start, uint64_t length, bool has_fin) {
+    // RFC 9000 §3.3: nothing is resent after RESET_STREAM, nor once every
+    // byte has been acknowledged.
+    auto state = send_machine_->GetStatus();
+    if (state == StreamState::kResetSent || state == StreamState::kResetRecvd ||
+        state == StreamState::kDataRecvd) {
+        LOG_DEBUG("SendStream::OnDataLost: stream %llu in state %d, dropping lost range", stream_id_,
+            static_cast<int>(state));
+        return;
+    }
+
+    // Queue the parts of [offset_start, offset_start + length) that are not
+    // covered by acked_ranges_: a later packet may already have delivered them.
+    bool queued = false;
+    uint64_t end = offset_start + length;
+    uint64_t pos = offset_start < acked_offset_ ? acked_offset_ : offset_start;
+    for (auto it = acked_ranges_.FindEndingAfter(pos); pos < end; ++it) {
+        uint64_t gap_end = end;
+        if (it != acked_ranges_.end() && it->start < end) {
+            gap_end = it->start;
+        }
+        if (gap_end > pos) {
+            InsertRange(lost_ranges_, pos, gap_end);
+            queued = true;
+        }
+        if (it == acked_ranges_.end() || it->start >= end) {
+            break;
+        }
+        pos = it->end;
+    }
+
+    if (has_fin && !fin_acked_) {
+        fin_lost_ = true;
+        queued = true;
+    }
+
+    LOG_DEBUG("SendStream::OnDataLost: stream_id=%llu, range=[%llu,%llu), has_fin=%d, queued=%d, lost ranges=%zu",
+        stream_id_, offset_start, end, has_fin, queued, lost_ranges_.size());
+    if (queued) {
+        ToSend();
+    }
+}
+
+IStream::TrySendResult SendStream::TrySendLostData(IFrameVisitor* visitor) {
+    while (!lost_ranges_.empty()) {
+        uint64_t start = lost_ranges_.begin()->first;
+        uint64_t end = lost_ranges_.begin()->second;
+        lost_ranges_.erase(lost_ranges_.begin());
+
+        // Bytes below the oldest retained entry were ACKed and released.
+        if (unacked_data_.empty() || start >= send_data_offset_) {
+            continue;
+        }
+        if (start < unacked_data_.front().offset) {
+            start = unacked_data_.front().offset;
+        }
+        if (start >= end) {
+            continue;
+        }
+
+        // Entries are contiguous and sorted by offset: the last one starting
+        // at or below `start` holds it.
+        auto it = std::upper_bound(unacked_data_.begin(), unacked_data_.end(), start,
+            [](uint64_t offset, const SentData& sent) { return offset < sent.offset; });
+        --it;
+        uint64_t data_end = it->offset + it->length;
+        if (it->data.GetLength() == 0) {
+            // released, so every byte of it was ACKed since the loss
+            if (data_end < end) {
+                lost_ranges_.emplace(data_end, end);
+            }
+            continue;
+        }
+        uint64_t len = std::min(end, data_end) - start;
+
+        uint32_t pkt_left = visitor->GetPacketLeftSize();
+        uint32_t pkt_cap = pkt_left > kStreamHeaderReserve ? pkt_left - kStreamHeaderReserve : 0;
+        if (len > pkt_cap) {
+            len = pkt_cap;
+        }
+        if (len == 0) {
+            InsertRange(lost_ranges_, start, end);
+            return TrySendResult::kBreak;  // no room left in this packet
+        }
+
+        auto frame = std::make_shared<StreamFrame>();
+        frame->SetStreamID(stream_id_);
+        frame->SetOffset(start);
+        frame->SetData(common::SharedBufferSpan(
+            it->data.GetChunk(), it->data.GetStart() + (start - it->offset), static_cast<uint32_t>(len)));
+        bool has_fin = fin_lost_ && start + len == send_data_offset_;
+        if (has_fin) {
+            frame->SetFin();
+        }
+
+        if (!visitor->HandleFrame(frame)) {
+            InsertRange(lost_ranges_, start, end);
+            if (visitor->GetLastError() == FrameEncodeError::kInsufficientSpace) {
+                return TrySendResult::kBreak;
+            }
+            LOG_ERROR("stream resend lost data failed. stream id:%llu, offset:%llu", stream_id_, start);
+            return TrySendResult::kFailed;
+        }
+        if (has_fin) {
+            fin_lost_ = false;
+        }
+        if (start + len < end) {
+            lost_ranges_.emplace(start + len, end);
+        }
+        LOG_DEBUG("stream resend lost data. stream id:%llu, offset:%llu, len:%llu, fin:%d", stream_id_, start, len,
+            has_fin);
+        common::Metrics::CounterInc(common::MetricsStd::QuicStreamsBytesRetransmit, len);
+    }
+
+    if (fin_lost_) {
+        // FIN-only frame at the final size
+        auto frame = std::make_shared<StreamFrame>();
+        frame->SetStreamID(stream_id_);
+        frame->SetOffset(send_data_offset_);
+        frame->SetFin();
+        if (!visitor->HandleFrame(frame)) {
+            return visitor->GetLastError() == FrameEncodeError::kInsufficientSpace ? TrySendResult::kBreak
+                                                                                    : TrySendResult::kFailed;
+        }
+        fin_lost_ = false;
+        LOG_DEBUG("stream resend lost fin. stream id:%llu, final size:%llu", stream_id_, send_data_offset_);
+    }
+    return TrySendResult::kSuccess;
+}
+
+void SendStream::ReleaseAckedData() {
+    uint64_t released = 0;
+    while (!unacked_data_.empty()) {
+        const SentData& oldest = unacked_data_.front();
+        if (oldest.offset + oldest.length > acked_offset_) {
+            break;
+        }
+        released += oldest.data.GetLength();
+        unacked_data_.pop_front();
+    }
+    if (released > 0) {
+        retained_bytes_ -= released;
+        common::Metrics::GaugeDec(common::MetricsStd::QuicStreamsSendRetainedBytes, released);
+    }
+}
+
+void SendStream::ReleaseAckedData(uint64_t start, uint64_t end) {
+    if (unacked_data_.empty() || end <= unacked_data_.front().offset) {
+        return;
+    }
+    // Only entries overlapping the new range can have become fully ACKed.
+    auto it = std::upper_bound(unacked_data_.begin(), unacked_data_.end(), start,
+        [](uint64_t offset, const SentData& sent) { return offset < sent.offset; });
+    if (it != unacked_data_.begin()) {
+        --it;
+    }
+    uint64_t released = 0;
+    for (; it != unacked_data_.end() && it->offset < end; ++it) {
+        if (it->data.GetLength() > 0 && acked_ranges_.Contains(it->offset, it->offset + it->length)) {
+            released += it->length;
+            it->data = common::SharedBufferSpan();
+        }
+    }
+    if (released > 0) {
+        retained_bytes_ -= released;
+        common::Metrics::GaugeDec(common::MetricsStd::QuicStreamsSendRetainedBytes, released);
+    }
+}
+
 }  // namespace quic
 }  // namespace quicx
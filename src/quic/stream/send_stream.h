@@ -1,15 +1,20 @@
 #ifndef QUIC_STREAM_SEND_STREAM
 #define QUIC_STREAM_SEND_STREAM
 
+#include <atomic>
+#include <deque>
 #include <map>
 #include <string>
 
 #include "common/buffer/multi_block_buffer.h"
+#include "common/buffer/shared_buffer_span.h"
+#include "common/structure/interval_list.h"
 #include <quicx/common/if_buffer_read.h>
 #include <quicx/common/if_buffer_write.h>
 
 #include <quicx/quic/if_quic_send_stream.h>
 #include "quic/stream/if_stream.h"
+#include "quic/stream/send_buffer_watermark.h"
 #include "quic/stream/state_machine_send.h"
 
 namespace quicx {
@@ -34,14 +39,34 @@ public:
     // send data to peer, return the number of bytes sended.
     virtual int32_t Send(uint8_t* data, uint32_t len) override;
     virtual int32_t Send(std::shared_ptr<IBufferRead> buffer) override;
+    virtual int32_t SendZeroCopy(const uint8_t* data, uint32_t len, std::function<void()> release) override;
     virtual std::shared_ptr<IBufferWrite> GetSendBuffer() override;
     virtual bool Flush() override;
 
     virtual void SetStreamWriteCallBack(stream_write_callback cb) override { sended_cb_ = cb; }
+    virtual void SetSendBufferWatermark(uint32_t high, uint32_t low) override { buffer_watermark_.SetMarks(high, low); }
+    virtual void SetStreamWritableCallBack(stream_writable_callback cb) override { writable_cb_ = cb; }
 
     virtual uint64_t GetPendingSendBytes() override {
         return send_buffer_ ? send_buffer_->GetDataLength() : 0;
     }
+    virtual uint64_t GetRetainedSendBytes() override { return retained_bytes_; }
+    virtual uint64_t GetSendableBytes() override;
+
+    // Connection-level part of GetSendableBytes(): congestion window room
+    // and MAX_DATA credit (see SendManager::GetSendBudget()), read on the
+    // loop thread
+    void SetSendBudgetProvider(std::function<uint64_t()> cb) { send_budget_cb_ = cb; }
+
+    // Marks shared by every stream of the connection. Set once, before the
+    // stream is handed to the application.
+    void SetConnectionWatermark(std::shared_ptr<SendBufferWatermark> watermark) { conn_watermark_ = watermark; }
+    // Give back what the send buffer holds to the connection's marks; the
+    // stream is leaving the connection.
+    void ReleaseSendBuffer();
+    // Fire the writable callback if a Send() was cut short and both the
+    // stream's and the connection's buffers drained to their low marks.
+    void CheckWritable();
 
     // *************** inside interface ***************//
     // process recv frames
@@ -63,6 +88,16 @@ public:
     // is ACKed", which is strictly safe (cumulative ⊆ selective).
     void OnDataAcked(uint64_t max_offset, bool has_fin) { OnDataAcked(0, max_offset, has_fin); }
 
+    // Frame-level retransmission (RFC 9000 §13.3): the packet that carried
+    // [offset_start, offset_start + length) was declared lost. Whatever part
+    // of it is still unacknowledged is queued and resent by the next
+    // TrySendData() ahead of new data; nothing is queued once the stream has
+    // been reset.
+    virtual void OnDataLost(uint64_t offset_start, uint64_t length, bool has_fin);
+    bool HasLostData() const { return !lost_ranges_.empty() || fin_lost_; }
+    // ACKed ranges above the contiguous prefix, i.e. the holes left by loss.
+    size_t GetAckedRangeCount() const { return acked_ranges_.Size(); }
+
     // Getter for testing
     std::shared_ptr<StreamStateMachineSend> GetSendStateMachine() const { return send_machine_; }
 
@@ -70,6 +105,24 @@ protected:
     void OnMaxStreamDataFrame(std::shared_ptr<IFrame> frame);
     void OnStopSendingFrame(std::shared_ptr<IFrame> frame);
     void CheckAllDataAcked();
+    // Resend queued lost ranges. Returns kSuccess once the queue is drained.
+    IStream::TrySendResult TrySendLostData(IFrameVisitor* visitor);
+    // Drop retained data covered by the contiguous ACKed prefix.
+    void ReleaseAckedData();
+    // Drop retained data inside [start, end) that is now fully ACKed, even
+    // with holes below it.
+    void ReleaseAckedData(uint64_t start, uint64_t end);
+    // Room below the stream's and the connection's high marks.
+    uint64_t GetWriteRoom() const;
+    // Cut a write of len bytes down to the room, noting when it was cut. A
+    // whole write is taken in full while there is any room at all.
+    uint32_t TakeWriteRoom(uint32_t len, bool whole = false);
+    // TakeWriteRoom() for Send() off the loop thread: the room stays charged
+    // until the posted write runs, which undoes it and calls WriteReserved().
+    uint32_t ReserveWriteRoom(uint32_t len, bool whole = false);
+    void WriteReserved(const std::function<void(common::MultiBlockBuffer&)>& write);
+    // Charge the send buffer's length change to the watermarks.
+    void SyncBufferedBytes();
 
 protected:
     bool to_fin_;                // whether to send fin
@@ -80,17 +133,45 @@ protected:
     uint64_t blocked_at_limit_;  // the limit at which we sent STREAM_DATA_BLOCKED (to avoid duplicate)
     std::shared_ptr<common::MultiBlockBuffer> send_buffer_;
 
-    // Selective ACK byte ranges over the stream's send-side offset space.
-    // Each entry is [start, end) — the keys are start offsets, the values are
-    // (exclusive) end offsets. Entries are kept disjoint and merged on insert.
+    // Selective ACK byte ranges above acked_offset_, disjoint [start, end).
+    // A range that joins the contiguous prefix is folded into acked_offset_
+    // and trimmed, so without loss the list stays empty.
     // We must NOT degrade this to a single high-water mark: aioquic-style
     // peers can ACK a packet carrying (5MB, FIN) while still missing earlier
     // segments, and treating that as "all done" stops retransmission and
     // strands the connection until idle_timeout.
-    std::map<uint64_t, uint64_t> acked_ranges_;
+    common::IntervalList acked_ranges_;
+
+    // Sent but not yet ACKed bytes, one entry per STREAM frame in offset
+    // order, covering [unacked_data_.front().offset, send_data_offset_)
+    // without holes. The spans pin the send buffer's chunks so a lost range
+    // can be resent without keeping the whole packet around. An entry ACKed
+    // behind a hole drops its span at once, so a chunk goes back to the pool
+    // as soon as every frame cut from it is ACKed.
+    struct SentData {
+        uint64_t offset;
+        uint32_t length;
+        common::SharedBufferSpan data;  // empty once released
+    };
+    std::deque<SentData> unacked_data_;
+    uint64_t retained_bytes_;  // bytes of unacked_data_ still holding a span
+    // Lost byte ranges waiting to be resent, [start, end) like acked_ranges_.
+    std::map<uint64_t, uint64_t> lost_ranges_;
+    bool fin_lost_;   // a packet carrying our FIN was lost and FIN is not ACKed yet
+    bool fin_acked_;  // a packet carrying our FIN was ACKed
 
     std::shared_ptr<StreamStateMachineSend> send_machine_;
     stream_write_callback sended_cb_;
+    std::function<uint64_t()> send_budget_cb_;
+
+    // Bytes in send_buffer_ are charged to buffer_watermark_ and to the
+    // connection's marks; Send() off the loop thread reserves its room
+    // before posting the write.
+    SendBufferWatermark buffer_watermark_;
+    std::shared_ptr<SendBufferWatermark> conn_watermark_;
+    uint64_t accounted_bytes_;  // loop thread only
+    std::atomic<bool> write_blocked_;
+    stream_writable_callback writable_cb_;
 };
 
 }  // namespace quic
@@ -1,12 +1,29 @@
+#include <mutex>
+
 #include "quic/udp/if_receiver.h"
 #include "quic/udp/udp_receiver.h"
 
 namespace quicx {
 namespace quic {
 
+static std::mutex factory_mutex_;
+static std::function<std::shared_ptr<IReceiver>(std::shared_ptr<common::IEventLoop>)> factory_;
+
 std::shared_ptr<IReceiver> IReceiver::MakeReceiver(std::shared_ptr<common::IEventLoop> event_loop) {
+    {
+        std::lock_guard<std::mutex> lock(factory_mutex_);
+        if (factory_) {
+            return factory_(event_loop);
+        }
+    }
     return std::make_shared<UdpReceiver>(event_loop);
 }
 
+void IReceiver::SetFactoryForTest(
+    std::function<std::shared_ptr<IReceiver>(std::shared_ptr<common::IEventLoop>)> factory) {
+    std::lock_guard<std::mutex> lock(factory_mutex_);
+    factory_ = std::move(factory);
+}
+
 }  // namespace quic
 }  // namespace quicx
\ No newline at end of file
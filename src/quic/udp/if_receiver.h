@@ -3,6 +3,7 @@
 
 #include <string>
 #include <cstdint>
+#include <functional>
 
 #include "quic/udp/net_packet.h"
 #include <quicx/common/if_event_loop.h>
@@ -37,7 +38,16 @@ public:
     // Enable or disable ECN features on underlying sockets created/managed by receiver
     virtual void SetEcnEnabled(bool enabled) = 0;
 
+    // Largest datagram to receive whole, the max_udp_payload_size we
+    // advertise. Larger ones are truncated.
+    virtual void SetMaxDatagramSize(uint32_t size) = 0;
+
     static std::shared_ptr<IReceiver> MakeReceiver(std::shared_ptr<common::IEventLoop> event_loop);
+
+    // make MakeReceiver() build receivers with `factory` instead, e.g. an in-memory
+    // link for simulation. an empty function restores UdpReceiver.
+    static void SetFactoryForTest(
+        std::function<std::shared_ptr<IReceiver>(std::shared_ptr<common::IEventLoop>)> factory);
 };
 
 }  // namespace quic
@@ -1,13 +1,27 @@
+#include <mutex>
+
 #include "quic/udp/if_sender.h"
 #include "quic/udp/udp_sender.h"
 
 namespace quicx {
 namespace quic {
-
+static std::mutex factory_mutex_;
+static std::function<std::shared_ptr<ISender>(int32_t)> factory_;
 
 std::shared_ptr<ISender> ISender::MakeSender(int32_t sockfd) {
+    {
+        std::lock_guard<std::mutex> lock(factory_mutex_);
+        if (factory_) {
+            return factory_(sockfd);
+        }
+    }
     return std::make_shared<UdpSender>(sockfd);
 }
 
+void ISender::SetFactoryForTest(std::function<std::shared_ptr<ISender>(int32_t)> factory) {
+    std::lock_guard<std::mutex> lock(factory_mutex_);
+    factory_ = std::move(factory);
+}
+
 }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define QUIC_UDP_IF_SENDER
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include "quic/udp/net_packet.h"
 
@@ -62,6 +63,12 @@ public:
      * @return Sender instance
      */
     static std::shared_ptr<ISender> MakeSender(int32_t sockfd = -1);
+
+    /**
+     * @brief Make MakeSender() build senders with `factory` instead, e.g. an
+     * in-memory link for simulation. An empty function restores UdpSender.
+     */
+    static void SetFactoryForTest(std::function<std::shared_ptr<ISender>(int32_t)> factory);
 };
 
 }
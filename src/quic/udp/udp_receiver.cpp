@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #ifdef _WIN32
@@ -10,6 +11,8 @@
 #include <netinet/ip6.h>
 #include <sys/socket.h>
 #endif
+#include "common/buffer/buffer_chunk.h"
+#include "common/buffer/single_block_buffer.h"
 #include "common/log/log.h"
 #include <quicx/common/metrics.h>
 #include <quicx/common/metrics_std.h>
@@ -26,7 +29,8 @@ namespace quic {
 
 UdpReceiver::UdpReceiver(std::shared_ptr<common::IEventLoop> event_loop):
     event_loop_(event_loop),
-    ecn_enabled_(false) {}
+    ecn_enabled_(false),
+    max_datagram_size_(kPacketBufferSize) {}
 
 UdpReceiver::~UdpReceiver() {
     // Close only those UDP sockets that we created ourselves (via
@@ -47,6 +51,10 @@ UdpReceiver::~UdpReceiver() {
     receiver_map_.clear();
 }
 
+void UdpReceiver::SetMaxDatagramSize(uint32_t size) {
+    max_datagram_size_ = std::min<uint32_t>(std::max<uint32_t>(size, kPacketBufferSize), kMaxPlpmtu);
+}
+
 bool UdpReceiver::AddReceiver(int32_t socket_fd, std::shared_ptr<IPacketReceiver> receiver) {
     auto loop = event_loop_.lock();
     if (!loop) return false;
@@ -106,6 +114,8 @@ bool UdpReceiver::AddReceiver(const std::string& ip, uint16_t port, std::shared_
         // enable receiving TOS/TCLASS for ECN via io_handle abstraction
         common::EnableUdpEcn(socket_fd);
     }
+    // servers send from this socket too: DF keeps PMTU probes honest
+    common::EnableUdpDontFragment(socket_fd);
 
     opt_ret = Bind(socket_fd, addr);
     if (opt_ret.error_code_ != 0) {
@@ -170,7 +180,7 @@ void UdpReceiver::OnRead(uint32_t fd) {
     // Combined with the EventLoop loop which runs all fixed_processes_
     // (including Worker::ProcessSend) on every Wait() return, the result
     // was that every incoming data packet caused a full wakeup → recv 1
-    // pkt → ProcessSend → emit ACK cycle. wait_ack_packet_numbers_ never
+    // pkt → ProcessSend → emit ACK cycle. The pending-ACK queue never
     // got a chance to accumulate beyond 1 entry, so the kAckThreshold=10
     // branch in RecvControl::ShouldSendImmediateAck was almost never hit;
     // ACKs flowed at ~1:1 with data packets, defeating ACK aggregation
@@ -182,7 +192,7 @@ void UdpReceiver::OnRead(uint32_t fd) {
     // The fix: drain the socket non-blockingly via a single
     // common::RecvFromBatch() call, dispatching each datagram before
     // continuing. This lets ack-eliciting packets pile up in
-    // wait_ack_packet_numbers_ within a single wakeup; the very next
+    // RecvControl within a single wakeup; the very next
     // ProcessSend invocation can then emit one ACK frame covering the
     // whole batch.
     //
@@ -244,7 +254,7 @@ void UdpReceiver::OnRead(uint32_t fd) {
         std::shared_ptr<NetPacket> pkt;
         common::BufferSpan span;
         while (retries < kMaxRecycleRetries) {
-            pkt = GlobalResource::Instance().GetThreadLocalPacketAllotor()->Malloc();
+            pkt = MallocPacket();
             span = pkt->GetData()->GetWritableSpan();
             if (span.GetLength() >= kMaxV4PacketSize) {
                 break;
@@ -330,6 +340,19 @@ void UdpReceiver::OnRead(uint32_t fd) {
     }
 }
 
+std::shared_ptr<NetPacket> UdpReceiver::MallocPacket() {
+    if (max_datagram_size_ <= kPacketBufferSize) {
+        return GlobalResource::Instance().GetThreadLocalPacketAllotor()->Malloc();
+    }
+    // jumbo datagrams allowed by max_udp_payload_size, e.g. PMTU probes
+    // beyond Ethernet size: one block of the jumbo pool per read
+    auto chunk =
+        std::make_shared<common::BufferChunk>(GlobalResource::Instance().GetThreadLocalBlockPool(max_datagram_size_));
+    auto pkt = std::make_shared<NetPacket>();
+    pkt->SetData(std::make_shared<common::SingleBlockBuffer>(chunk));
+    return pkt;
+}
+
 void UdpReceiver::OnWrite(uint32_t fd) {
     LOG_ERROR("write should not be called. fd:%d", fd);
 }
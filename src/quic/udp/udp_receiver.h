@@ -29,6 +29,8 @@ public:
     virtual bool RemoveReceiver(int32_t socket_fd) override;
 
     virtual void SetEcnEnabled(bool enabled) override { ecn_enabled_ = enabled; }
+    // up to kMaxPlpmtu; above kPacketBufferSize reads go to jumbo pool blocks
+    virtual void SetMaxDatagramSize(uint32_t size) override;
 
 protected:
     void OnRead(uint32_t fd) override;
@@ -38,9 +40,12 @@ protected:
 
 private:
     bool TryRecv(std::shared_ptr<NetPacket>& pkt);
+    // packet whose buffer holds max_datagram_size_ bytes
+    std::shared_ptr<NetPacket> MallocPacket();
 
 private:
     bool ecn_enabled_;
+    uint32_t max_datagram_size_;
     std::weak_ptr<common::IEventLoop> event_loop_;  // Observer reference (owner is QuicClient/QuicServer)
     std::unordered_map<int32_t, std::weak_ptr<IPacketReceiver>> receiver_map_;
     // fds that were created internally by AddReceiver(ip, port, ...); the
@@ -3,6 +3,7 @@
 #include <quicx/common/metrics.h>
 #include <quicx/common/metrics_std.h>
 #include "common/network/io_handle.h"
+#include "common/network/socket_family_cache.h"
 
 #include <atomic>
 #include <chrono>
@@ -209,6 +210,7 @@ private:
         if (sock <= 0) {
             return;
         }
+        common::ApplySocketEcnCodepoint(sock, dp.pkt->GetEcn());
         auto ret = common::SendTo(sock, (const char*)span.GetStart(),
                                   span.GetLength(), 0, dp.pkt->GetAddress());
         if (ret.error_code_ != 0) {
@@ -324,6 +326,7 @@ bool UdpSender::Send(std::shared_ptr<NetPacket>& pkt) {
     // the delay-queue check entirely. This is the dominant path on every
     // real deployment.
     if (any_fault_enabled_.load(std::memory_order_relaxed) == 0) {
+        common::ApplySocketEcnCodepoint(sock, pkt->GetEcn());
         // PERF DIAG: isolate the sendto() syscall cost. On loopback with our
         // observed pkts_tx ~24k/s a one-call-per-packet model puts a strict
         // ceiling around 30-50k pps based on syscall + softirq. If
@@ -393,6 +396,7 @@ bool UdpSender::Send(std::shared_ptr<NetPacket>& pkt) {
     // ---- production path (fault-injection enabled but all knobs let this
     // particular packet through; e.g. delay==0 and rate==0 but drop_pm!=0
     // and the random draw didn't drop). ----
+    common::ApplySocketEcnCodepoint(sock, pkt->GetEcn());
     auto ret = common::SendTo(sock, (const char*)span.GetStart(), span.GetLength(), 0, pkt->GetAddress());
     if (ret.error_code_ != 0) {
         LOG_ERROR(
@@ -553,9 +557,10 @@ uint32_t UdpSender::SendBatch(std::vector<std::shared_ptr<NetPacket>>& batch) {
     for (; prepared < batch_n; prepared++) {
         auto& pkt = batch[prepared];
         const int32_t s = pkt->GetSocket() > 0 ? pkt->GetSocket() : sock_;
-        if (s != sock0) {
-            // Mixed sockets in a single batch -> degrade. Bail out before
-            // any sendmmsg so ordering stays simple.
+        if (s != sock0 || pkt->GetEcn() != first->GetEcn()) {
+            // Mixed sockets (or ECN codepoints, a per-socket option) in a
+            // single batch -> degrade. Bail out before any sendmmsg so
+            // ordering stays simple.
             break;
         }
 
@@ -599,6 +604,9 @@ uint32_t UdpSender::SendBatch(std::vector<std::shared_ptr<NetPacket>>& batch) {
         return ok;
     }
 
+    // Every prepared packet carries the first one's codepoint.
+    common::ApplySocketEcnCodepoint(sock0, first->GetEcn());
+
     // ---- (GSO fast-fast-path) ----
     //
     // Try to find a contiguous prefix [0, gso_run) of the prepared batch
@@ -1,6 +1,7 @@
 #if defined(QUICX_ENABLE_BENCHMARKS)
 #include <benchmark/benchmark.h>
 #include <memory>
+#include <vector>
 
 #include "quic/congestion_control/if_congestion_control.h"
 #include "quic/congestion_control/reno_congestion_control.h"
@@ -42,10 +43,30 @@ static void BM_Congestion_OnLoss(benchmark::State& state) {
     }
 }
 
+// Same window as BM_Congestion_OnAck, delivered as one congestion event the
+// way SendControl hands over a whole ACK frame.
+static void BM_Congestion_OnAckBatched(benchmark::State& state) {
+    auto cc = MakeReno();
+    CcConfigV2 cfg;
+    cc->Configure(cfg);
+    for (uint64_t i = 0; i < 10000; ++i) {
+        cc->OnPacketSent({i, 1200, i});
+    }
+    std::vector<AckEvent> acked;
+    std::vector<LossEvent> lost;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        acked.push_back({i, 1200, i});
+    }
+    for (auto _ : state) {
+        cc->OnCongestionEvent(acked, lost, cc->GetBytesInFlight(), 1000);
+    }
+}
+
 }  // namespace quic
 }  // namespace quicx
 
 BENCHMARK(quicx::quic::BM_Congestion_OnAck);
+BENCHMARK(quicx::quic::BM_Congestion_OnAckBatched);
 BENCHMARK(quicx::quic::BM_Congestion_OnLoss);
 BENCHMARK_MAIN();
 #else
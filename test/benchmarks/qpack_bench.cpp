@@ -1,10 +1,12 @@
 #if defined(QUICX_ENABLE_BENCHMARKS)
 #include <benchmark/benchmark.h>
 #include <memory>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
 #include "http3/qpack/util.h"
+#include "http3/qpack/dynamic_table.h"
 #include "common/alloter/pool_block.h"
 #include "http3/qpack/qpack_encoder.h"
 #include "common/buffer/multi_block_buffer.h"
@@ -38,10 +40,89 @@ static void BM_Qpack_Insert_And_IndexedDecode(benchmark::State& state) {
     }
 }
 
+static std::vector<std::pair<std::string, std::string>> MakeFields(int count, size_t value_len) {
+    std::vector<std::pair<std::string, std::string>> fields;
+    for (int i = 0; i < count; ++i) {
+        std::string value = std::to_string(i);
+        value.resize(value_len, 'v');
+        fields.emplace_back("x-bench-" + std::to_string(i), value);
+    }
+    return fields;
+}
+
+// Steady state of a full 4 KiB table: every insert evicts the oldest entries.
+static void BM_Qpack_DynamicTable_InsertEvict(benchmark::State& state) {
+    DynamicTable table(4096);
+    auto fields = MakeFields(256, static_cast<size_t>(state.range(0)));
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& f = fields[i++ % fields.size()];
+        bool ok = table.AddHeaderItem(f.first, f.second);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Evicting one entry at a time from a table holding range(0) entries.
+static void BM_Qpack_DynamicTable_Evict(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto fields = MakeFields(count, 16);
+    DynamicTable table(64 * 1024);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (const auto& f : fields) {
+            table.AddHeaderItem(f.first, f.second);
+        }
+        state.ResumeTiming();
+        while (table.GetEntryCount() > 0) {
+            table.EvictEntries();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Name+value and name-only lookups hitting a table of range(0) entries.
+static void BM_Qpack_DynamicTable_FindHit(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto fields = MakeFields(count, 16);
+    DynamicTable table(64 * 1024);
+    for (const auto& f : fields) {
+        table.AddHeaderItem(f.first, f.second);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& f = fields[i++ % fields.size()];
+        benchmark::DoNotOptimize(table.FindAbsoluteIndex(f.first, f.second));
+        benchmark::DoNotOptimize(table.FindAbsoluteNameIndex(f.first));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// The common encoder case: a header the table does not hold.
+static void BM_Qpack_DynamicTable_FindMiss(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    auto fields = MakeFields(count, 16);
+    DynamicTable table(64 * 1024);
+    for (const auto& f : fields) {
+        table.AddHeaderItem(f.first, f.second);
+    }
+    std::string name = "user-agent";
+    std::string value = "bench/1.0";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.FindAbsoluteIndex(name, value));
+        benchmark::DoNotOptimize(table.FindAbsoluteNameIndex(name));
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
 } // namespace http3
 } // namespace quicx
 
 BENCHMARK(quicx::http3::BM_Qpack_Insert_And_IndexedDecode);
+BENCHMARK(quicx::http3::BM_Qpack_DynamicTable_InsertEvict)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(quicx::http3::BM_Qpack_DynamicTable_Evict)->Arg(16)->Arg(256);
+BENCHMARK(quicx::http3::BM_Qpack_DynamicTable_FindHit)->Arg(16)->Arg(256);
+BENCHMARK(quicx::http3::BM_Qpack_DynamicTable_FindMiss)->Arg(16)->Arg(256);
 BENCHMARK_MAIN();
 #else
 int main() { return 0; }
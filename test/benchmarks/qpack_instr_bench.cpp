@@ -47,12 +47,33 @@ static void BM_Qpack_Instr_Duplicate(benchmark::State& state) {
     }
 }
 
+// Decoder side of a full table: each Insert evicts, and names rotate so the
+// index keeps changing.
+static void BM_Qpack_Instr_DecodeInsertEvicting(benchmark::State& state) {
+    QpackEncoder enc;
+    QpackEncoder dec;
+    std::vector<std::vector<std::pair<std::string,std::string>>> inserts;
+    for (int i = 0; i < 64; ++i) {
+        inserts.push_back({{"x-e-" + std::to_string(i), std::string((size_t)state.range(0), 'v')}});
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto ctrl = MakeBuffer();
+        enc.EncodeEncoderInstructions(inserts[i++ % inserts.size()], ctrl, /*with_name_ref*/false);
+        state.ResumeTiming();
+        bool ok = dec.DecodeEncoderInstructions(ctrl);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+
 } // namespace http3
 } // namespace quicx
 
 BENCHMARK(quicx::http3::BM_Qpack_Instr_InsertWithoutNameRef)->Arg(8)->Arg(64)->Arg(512);
 BENCHMARK(quicx::http3::BM_Qpack_Instr_InsertWithStaticNameRef)->Arg(1);
 BENCHMARK(quicx::http3::BM_Qpack_Instr_Duplicate);
+BENCHMARK(quicx::http3::BM_Qpack_Instr_DecodeInsertEvicting)->Arg(8)->Arg(64)->Arg(512);
 BENCHMARK_MAIN();
 #else
 int main() { return 0; }
@@ -0,0 +1,132 @@
+#if defined(QUICX_ENABLE_BENCHMARKS)
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <quicx/common/if_event_loop.h>
+
+#include "quic/stream/fix_buffer_frame_visitor.h"
+#include "quic/stream/scheduler/if_stream_scheduler.h"
+#include "quic/stream/send_stream.h"
+
+namespace quicx {
+namespace quic {
+
+// Time to first byte of small streams opened while a bulk transfer is
+// running on the same connection. Every iteration sends kPackets packets of
+// kPacketSize bytes; a 2KB stream opens every kSmallInterval packets. The
+// counters report how many packets each small stream waited for its first
+// byte and for its last byte.
+//
+// Arg 0: StreamSchedulerType
+// Arg 1: urgency of the small streams (the bulk stream keeps the default)
+static constexpr uint32_t kPacketSize = 1200;
+static constexpr uint32_t kPackets = 3000;
+static constexpr uint32_t kSmallStreams = 40;
+static constexpr uint32_t kSmallInterval = 50;
+static constexpr uint32_t kSmallSize = 2048;
+static constexpr uint32_t kBulkRefill = 64 * 1024;
+
+static void BM_StreamScheduler_SmallStreamTtfb(benchmark::State& state) {
+    auto type = static_cast<StreamSchedulerType>(state.range(0));
+    uint8_t small_urgency = static_cast<uint8_t>(state.range(1));
+
+    auto loop = common::MakeEventLoop();
+    loop->Init();
+    std::vector<uint8_t> payload(kBulkRefill, 'x');
+
+    double ttfb_sum = 0;
+    double ttfb_max = 0;
+    double done_sum = 0;
+    for (auto _ : state) {
+        auto scheduler = MakeStreamScheduler(type);
+        auto active_cb = [&scheduler](std::shared_ptr<IStream> stream) { scheduler->Push(stream); };
+        auto close_cb = [](uint64_t) {};
+        auto conn_close_cb = [](uint64_t, uint16_t, const std::string&) {};
+
+        auto bulk = std::make_shared<SendStream>(loop, UINT32_MAX, 0, active_cb, close_cb, conn_close_cb);
+        bulk->Send(payload.data(), kBulkRefill);
+
+        std::vector<std::shared_ptr<SendStream>> smalls;
+        std::vector<int64_t> opened(kSmallStreams + 1, -1);
+        std::vector<int64_t> first_byte(kSmallStreams + 1, -1);
+        std::vector<int64_t> last_byte(kSmallStreams + 1, -1);
+        std::vector<uint64_t> sent(kSmallStreams + 1, 0);
+
+        for (uint32_t packet = 0; packet < kPackets; packet++) {
+            if (packet % kSmallInterval == 0 && smalls.size() < kSmallStreams) {
+                uint64_t id = (smalls.size() + 1) * 4;
+                auto small = std::make_shared<SendStream>(loop, UINT32_MAX, id, active_cb, close_cb, conn_close_cb);
+                small->SetPriority(small_urgency, false);
+                small->Send(payload.data(), kSmallSize);
+                smalls.push_back(small);
+                opened[smalls.size()] = packet;
+            }
+            if (bulk->GetPendingSendBytes() < kBulkRefill / 2) {
+                bulk->Send(payload.data(), kBulkRefill);
+            }
+
+            // one BuildStreamFrames() pass
+            FixBufferFrameVisitor visitor(kPacketSize);
+            visitor.SetStreamDataSizeLimit(UINT32_MAX);
+            while (auto stream = scheduler->Pop()) {
+                auto ret = stream->TrySendData(&visitor);
+                if (ret == IStream::TrySendResult::kBreak) {
+                    scheduler->Requeue(stream);
+                    break;
+                }
+            }
+
+            for (const auto& info : visitor.GetStreamDataInfo()) {
+                size_t index = info.stream_id / 4;
+                if (index == 0 || index > kSmallStreams) {
+                    continue;
+                }
+                if (first_byte[index] < 0) {
+                    first_byte[index] = packet;
+                }
+                sent[index] += info.length;
+                if (sent[index] >= kSmallSize && last_byte[index] < 0) {
+                    last_byte[index] = packet;
+                }
+            }
+        }
+
+        ttfb_sum = 0;
+        ttfb_max = 0;
+        done_sum = 0;
+        for (size_t i = 1; i <= kSmallStreams; i++) {
+            // a stream that never got a byte counts as waiting until the end
+            double ttfb = (first_byte[i] < 0 ? kPackets : first_byte[i]) - opened[i];
+            double done = (last_byte[i] < 0 ? kPackets : last_byte[i]) - opened[i];
+            ttfb_sum += ttfb;
+            ttfb_max = std::max(ttfb_max, ttfb);
+            done_sum += done;
+        }
+        benchmark::DoNotOptimize(ttfb_sum);
+    }
+    state.counters["ttfb_avg_pkts"] = ttfb_sum / kSmallStreams;
+    state.counters["ttfb_max_pkts"] = ttfb_max;
+    state.counters["complete_avg_pkts"] = done_sum / kSmallStreams;
+}
+
+}  // namespace quic
+}  // namespace quicx
+
+// {scheduler, small stream urgency}: default urgency shows the policy alone,
+// urgency 1 shows what prioritizing the small streams buys.
+BENCHMARK(quicx::quic::BM_StreamScheduler_SmallStreamTtfb)
+    ->ArgNames({"scheduler", "small_urgency"})
+    ->Args({static_cast<int>(quicx::StreamSchedulerType::kUrgencyIncremental), 3})
+    ->Args({static_cast<int>(quicx::StreamSchedulerType::kUrgencyIncremental), 1})
+    ->Args({static_cast<int>(quicx::StreamSchedulerType::kStrictPriority), 3})
+    ->Args({static_cast<int>(quicx::StreamSchedulerType::kStrictPriority), 1})
+    ->Args({static_cast<int>(quicx::StreamSchedulerType::kWeightedRoundRobin), 3})
+    ->Args({static_cast<int>(quicx::StreamSchedulerType::kWeightedRoundRobin), 1})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_MAIN();
+#else
+int main() { return 0; }
+#endif
@@ -1,8 +1,11 @@
 #if defined(QUICX_ENABLE_BENCHMARKS)
 #include <benchmark/benchmark.h>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "common/timer/timer_multiplexer.h"
+#include "common/timer/timer_node.h"
 #include "common/timer/timer_task.h"
 #include "common/timer/timing_wheel_timer.h"
 #include "common/timer/treemap_timer.h"
@@ -16,6 +19,9 @@
 //    3. TimerRun (fire N expired timers)
 //    4. Mixed workload: add -> advance -> fire -> re-add
 //    5. Scatter: N tasks with varied delays (short / medium / long)
+//    6. Mixed tick: add -> advance -> fire -> re-add
+//    7. Re-arm one timer among 1M armed: TimerTask vs TimerNode vs
+//       per-connection TimerMultiplexer
 // ============================================================
 
 namespace quicx {
@@ -274,6 +280,99 @@ static void BM_Wheel_MixedTick(benchmark::State& state) {
 }
 BENCHMARK(BM_Wheel_MixedTick)->Arg(100)->Arg(1000)->Arg(10000);
 
+// ────────────────────────────────────────────────────────────
+// 7. Re-arm among N armed timers (state.range(0) = N)
+//    A connection re-arms PTO / ACK delay / pacing on nearly every
+//    packet, so this is the per-packet timer cost on a busy server.
+//    Delays are spread over all wheel levels.
+// ────────────────────────────────────────────────────────────
+
+static uint32_t RearmDelay(int i) {
+    return static_cast<uint32_t>(10 + (i * 7919) % 60000);
+}
+
+// TimerTask: every re-arm frees a list node and allocates a new one
+// holding a copy of the callback.
+static void BM_Wheel_RearmTask(benchmark::State& state) {
+    const int N = static_cast<int>(state.range(0));
+    uint64_t now = UTCTimeMsec();
+    TimingWheelTimer timer;
+    std::vector<TimerTask> tasks(N);
+    for (int i = 0; i < N; ++i) {
+        TimerTask* self = &tasks[i];
+        tasks[i].SetTimeoutCallback([self](){ benchmark::DoNotOptimize(self); });
+        timer.AddTimer(tasks[i], RearmDelay(i), now);
+    }
+
+    int i = 0;
+    for (auto _ : state) {
+        timer.RemoveTimer(tasks[i]);
+        timer.AddTimer(tasks[i], RearmDelay(i + 1), now);
+        if (++i == N) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Wheel_RearmTask)->Arg(1000)->Arg(1000000);
+
+// TimerNode: re-arm relinks the caller's node, nothing is allocated.
+static void BM_Wheel_RearmNode(benchmark::State& state) {
+    const int N = static_cast<int>(state.range(0));
+    uint64_t now = UTCTimeMsec();
+    TimingWheelTimer timer;
+    std::unique_ptr<TimerNode[]> nodes(new TimerNode[N]);
+    for (int i = 0; i < N; ++i) {
+        TimerNode* self = &nodes[i];
+        nodes[i].SetTimeoutCallback([self](){ benchmark::DoNotOptimize(self); });
+        timer.ArmTimer(nodes[i], RearmDelay(i), now);
+    }
+
+    int i = 0;
+    for (auto _ : state) {
+        timer.ArmTimer(nodes[i], RearmDelay(i + 1), now);
+        if (++i == N) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Wheel_RearmNode)->Arg(1000)->Arg(1000000);
+
+// TimerMultiplexer: N nodes spread over N / 5 connections, each connection
+// holds one wheel entry. Re-arming a node whose deadline is not the
+// connection's earliest (ACK delay behind a pending PTO) never touches
+// the wheel.
+static void BM_Multiplexer_Rearm(benchmark::State& state) {
+    static constexpr int kTimersPerConnection = 5;
+    const int N = static_cast<int>(state.range(0));
+    const int connections = N / kTimersPerConnection;
+    uint64_t now = UTCTimeMsec();
+    auto wheel = std::make_shared<TimingWheelTimer>();
+    std::vector<std::unique_ptr<TimerMultiplexer>> muxes;
+    std::unique_ptr<TimerNode[]> nodes(new TimerNode[N]);
+    for (int c = 0; c < connections; ++c) {
+        muxes.emplace_back(new TimerMultiplexer(wheel));
+        for (int t = 0; t < kTimersPerConnection; ++t) {
+            int i = c * kTimersPerConnection + t;
+            TimerNode* self = &nodes[i];
+            nodes[i].SetTimeoutCallback([self](){ benchmark::DoNotOptimize(self); });
+            // node 0 stays the earliest deadline of its connection
+            muxes[c]->ArmTimer(nodes[i], t == 0 ? 5 : RearmDelay(i), now);
+        }
+    }
+
+    int c = 0;
+    int t = 1;
+    for (auto _ : state) {
+        int i = c * kTimersPerConnection + t;
+        muxes[c]->ArmTimer(nodes[i], RearmDelay(i + 1), now);
+        if (++c == connections) {
+            c = 0;
+            if (++t == kTimersPerConnection) t = 1;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["wheel_entries"] = connections;
+}
+BENCHMARK(BM_Multiplexer_Rearm)->Arg(1000)->Arg(1000000);
+
 }  // namespace common
 }  // namespace quicx
 
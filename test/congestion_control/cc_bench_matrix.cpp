@@ -0,0 +1,788 @@
+// cc_bench_matrix - congestion-control regression benchmark on the network
+// simulator.
+//
+// Runs every controller the factory builds across a matrix of bottlenecks
+// (bandwidth, RTT, random loss, buffer depth, competing flows, step changes,
+// an L4S queue) and reports, per controller and scenario:
+//
+//   goodput_mbps            bytes delivered to the receiver over the run
+//   utilization             goodput / bottleneck capacity
+//   queue_delay_p50/p99_ms  bottleneck queueing delay seen by each packet
+//   loss_rate               packets dropped by the path / packets sent
+//   jain_fairness           Jain's index of per-flow goodput once every flow
+//                           has joined (1.0 for a single flow)
+//   convergence_ms          time from the last disturbance (start, flow join
+//                           or step change) until three consecutive windows
+//                           run at >= 80% utilization with Jain >= 0.8;
+//                           -1 if that never happens
+//
+// The simulation runs in virtual time and is seeded, so results only change
+// when a controller (or this file) does; the loss draws come from
+// std::uniform_real_distribution, so a different standard library may shift
+// the lossy scenarios and wants its own baseline. A baseline is the JSON output of an
+// earlier run; --compare flags every metric that moved past the tolerance in
+// the wrong direction and exits non-zero.
+//
+// Usage:
+//   ./build/bin/benchmarks/cc_bench_matrix                        # JSON to stdout
+//   ./build/bin/benchmarks/cc_bench_matrix --out=results.json
+//   ./build/bin/benchmarks/cc_bench_matrix --filter=cubic/        # one controller
+//   ./build/bin/benchmarks/cc_bench_matrix \
+//       --compare=test/congestion_control/cc_bench_baseline.json [--tolerance=0.05]
+//
+// Regenerate the baseline after an intended behaviour change:
+//   ./build/bin/benchmarks/cc_bench_matrix --out=test/congestion_control/cc_bench_baseline.json
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "network_simulator.h"
+#include "quic/congestion_control/congestion_control_factory.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+constexpr uint64_t kTickUs = 100;             // simulation step, as in CCTestFramework
+constexpr uint64_t kMss = 1460;
+constexpr uint64_t kMaxBurstPackets = 100;    // per flow per tick
+constexpr uint64_t kBucketUs = 10000;         // delivery accounting granularity
+constexpr uint64_t kPacketThreshold = 3;      // RFC 9002 §6.1.1
+constexpr uint64_t kMinRtoUs = 200000;
+constexpr uint64_t kMaxFlows = 16;
+
+// ========== Scenarios ==========
+
+struct BenchScenario {
+    std::string name;
+    uint64_t bandwidth_mbps = 50;
+    uint64_t rtt_ms = 40;
+    double loss_rate = 0.0;
+    double buffer_bdp = 1.0;  // bottleneck buffer, in BDPs of the initial path
+    uint64_t flows = 1;
+    uint64_t flow_stagger_us = 0;  // flow i starts at i * stagger
+    bool vs_cubic = false;         // the second flow runs CUBIC
+    bool l4s = false;              // DualQ step marking of ECT(1) at 1ms
+    uint64_t duration_us = 10000000;
+
+    // Optional step change of the path.
+    uint64_t step_time_us = 0;
+    uint64_t step_bandwidth_mbps = 0;
+    uint64_t step_rtt_ms = 0;
+};
+
+std::vector<BenchScenario> ScenarioMatrix() {
+    std::vector<BenchScenario> matrix;
+    auto add = [&matrix](const std::string& name, std::function<void(BenchScenario&)> tweak) {
+        BenchScenario s;
+        s.name = name;
+        tweak(s);
+        matrix.push_back(s);
+    };
+
+    add("base_50mbit_40ms", [](BenchScenario&) {});
+
+    add("bw_10mbit", [](BenchScenario& s) { s.bandwidth_mbps = 10; });
+    add("bw_200mbit", [](BenchScenario& s) { s.bandwidth_mbps = 200; });
+
+    add("rtt_10ms", [](BenchScenario& s) { s.rtt_ms = 10; });
+    add("rtt_160ms", [](BenchScenario& s) { s.rtt_ms = 160; });
+
+    add("loss_0.1pct", [](BenchScenario& s) { s.loss_rate = 0.001; });
+    add("loss_1pct", [](BenchScenario& s) { s.loss_rate = 0.01; });
+
+    add("buffer_0.25bdp", [](BenchScenario& s) { s.buffer_bdp = 0.25; });
+    add("buffer_4bdp", [](BenchScenario& s) { s.buffer_bdp = 4.0; });
+
+    add("flows_2", [](BenchScenario& s) {
+        s.flows = 2;
+        s.flow_stagger_us = 2000000;
+        s.duration_us = 15000000;
+    });
+    add("flows_4", [](BenchScenario& s) {
+        s.flows = 4;
+        s.flow_stagger_us = 2000000;
+        s.duration_us = 15000000;
+    });
+    add("vs_cubic", [](BenchScenario& s) {
+        s.flows = 2;
+        s.flow_stagger_us = 2000000;
+        s.vs_cubic = true;
+        s.duration_us = 15000000;
+    });
+
+    add("step_bw_down", [](BenchScenario& s) {
+        s.step_time_us = 5000000;
+        s.step_bandwidth_mbps = 10;
+    });
+    add("step_bw_up", [](BenchScenario& s) {
+        s.bandwidth_mbps = 10;
+        s.step_time_us = 5000000;
+        s.step_bandwidth_mbps = 50;
+    });
+    add("step_rtt_up", [](BenchScenario& s) {
+        s.rtt_ms = 20;
+        s.step_time_us = 5000000;
+        s.step_rtt_ms = 80;
+    });
+
+    add("l4s_dualq", [](BenchScenario& s) {
+        s.rtt_ms = 20;
+        s.l4s = true;
+    });
+
+    return matrix;
+}
+
+struct Controller {
+    std::string name;
+    CongestionControlType type;
+};
+
+// Every built-in controller of CreateCongestionControl().
+std::vector<Controller> AllControllers() {
+    return {
+        {"reno", CongestionControlType::kReno},
+        {"cubic", CongestionControlType::kCubic},
+        {"bbr_v1", CongestionControlType::kBbrV1},
+        {"bbr_v2", CongestionControlType::kBbrV2},
+        {"bbr_v3", CongestionControlType::kBbrV3},
+        {"prague", CongestionControlType::kPrague},
+    };
+}
+
+// ========== Results ==========
+
+struct BenchResult {
+    std::string algorithm;
+    std::string scenario;
+    double goodput_mbps = 0.0;
+    double utilization = 0.0;
+    double queue_delay_p50_ms = 0.0;
+    double queue_delay_p99_ms = 0.0;
+    double loss_rate = 0.0;
+    double jain_fairness = 1.0;
+    double convergence_ms = -1.0;
+    std::vector<double> flow_goodput_mbps;
+};
+
+double JainIndex(const std::vector<double>& x) {
+    double sum = 0, sum_sq = 0;
+    for (double v : x) {
+        sum += v;
+        sum_sq += v * v;
+    }
+    if (x.empty() || sum_sq == 0) {
+        return 0.0;
+    }
+    return (sum * sum) / (x.size() * sum_sq);
+}
+
+double Percentile(std::vector<uint64_t>& samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    size_t idx = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+    std::nth_element(samples.begin(), samples.begin() + idx, samples.end());
+    return static_cast<double>(samples[idx]);
+}
+
+// ========== Simulation ==========
+
+// One sender sharing the bottleneck. Loss detection follows RFC 9002 §6.1
+// (packet and time thresholds) plus a coarse RTO for a fully lost flight,
+// and ACKs reach the controller in one batch per tick, like SendControl.
+// The controllers' own pacers read the wall clock, so pacing here is done
+// in virtual time from GetPacingRateBytesPerSec(), once there is an RTT sample.
+class Flow {
+public:
+    Flow(std::unique_ptr<ICongestionControl> cc, uint64_t index, uint64_t start_us)
+        : cc_(std::move(cc)), index_(index), start_us_(start_us) {
+        CcConfigV2 cfg;
+        cfg.mss_bytes = kMss;
+        cfg.initial_cwnd_bytes = 10 * kMss;
+        cfg.min_cwnd_bytes = 2 * kMss;
+        cfg.max_cwnd_bytes = 4096 * kMss;
+        cc_->Configure(cfg);
+    }
+
+    uint64_t StartTime() const { return start_us_; }
+    uint64_t PacketsSent() const { return packets_sent_; }
+    uint64_t PacketsDropped() const { return packets_dropped_; }
+    const std::vector<uint64_t>& DeliveredBuckets() const { return delivered_buckets_; }
+
+    // The receiver got packet `pn`; its ACK is back at `ack_time`.
+    void OnDelivered(const InFlightPacket& packet, uint64_t pn, uint64_t ack_time) {
+        size_t bucket = packet.delivery_time / kBucketUs;
+        if (delivered_buckets_.size() <= bucket) {
+            delivered_buckets_.resize(bucket + 1, 0);
+        }
+        delivered_buckets_[bucket] += packet.bytes;
+        pending_acks_.push_back({pn, ack_time, packet.ce_marked});
+    }
+
+    void ProcessAcks(uint64_t now) {
+        std::vector<AckEvent> acked;
+        std::vector<LossEvent> lost;
+        uint64_t latest_rtt = 0;
+
+        while (!pending_acks_.empty() && pending_acks_.front().ack_time <= now) {
+            PendingAck ack = pending_acks_.front();
+            pending_acks_.pop_front();
+            auto it = sent_.find(ack.pn);
+            if (it == sent_.end()) {
+                continue;  // already declared lost: the loss was spurious
+            }
+            AckEvent ev;
+            ev.pn = ack.pn;
+            ev.bytes_acked = it->second.bytes;
+            ev.ack_time = now;
+            ev.ecn_ce = ack.ce_marked;
+            ev.acked_packet_send_time = it->second.sent_time;
+            acked.push_back(ev);
+            if (ack.pn >= largest_acked_) {
+                largest_acked_ = ack.pn;
+                latest_rtt = now - it->second.sent_time;
+            }
+            sent_.erase(it);
+        }
+        if (latest_rtt > 0) {
+            srtt_us_ = srtt_us_ == 0 ? latest_rtt : (7 * srtt_us_ + latest_rtt) / 8;
+            latest_rtt_us_ = latest_rtt;
+        }
+
+        DetectLosses(now, lost);
+        if (acked.empty() && lost.empty()) {
+            return;
+        }
+        if (latest_rtt > 0) {
+            cc_->OnRoundTripSample(latest_rtt, 0);
+        }
+        cc_->OnCongestionEvent(acked, lost, cc_->GetBytesInFlight(), now);
+    }
+
+    void TrySend(uint64_t now, NetworkSimulator& sim, std::vector<uint64_t>& queue_delays) {
+        if (now < start_us_) {
+            return;
+        }
+        for (uint64_t i = 0; i < kMaxBurstPackets; i++) {
+            uint64_t can_send_bytes = 0;
+            if (cc_->CanSend(now, can_send_bytes) != ICongestionControl::SendState::kOk ||
+                can_send_bytes < kMss) {
+                break;
+            }
+            if (next_send_us_ > now + kTickUs) {
+                break;
+            }
+            SendOne(now, sim, queue_delays);
+        }
+    }
+
+private:
+    struct SentInfo {
+        uint64_t bytes;
+        uint64_t sent_time;
+    };
+    struct PendingAck {
+        uint64_t pn;
+        uint64_t ack_time;
+        bool ce_marked;
+    };
+
+    void SendOne(uint64_t now, NetworkSimulator& sim, std::vector<uint64_t>& queue_delays) {
+        uint64_t pn = next_pn_++;
+        SentPacketEvent ev;
+        ev.pn = pn;
+        ev.bytes = kMss;
+        ev.sent_time = now;
+        cc_->OnPacketSent(ev);
+        sent_[pn] = {kMss, now};
+        packets_sent_++;
+
+        queue_delays.push_back(sim.GetQueueDelay(now));
+        // Flows share the simulator's packet-number space.
+        if (!sim.SendPacket(now, pn * kMaxFlows + index_, kMss, cc_->UsesL4sEcn())) {
+            packets_dropped_++;  // found by loss detection, like a real drop
+        }
+
+        uint64_t rate = cc_->GetPacingRateBytesPerSec();
+        if (srtt_us_ > 0 && rate > 0) {
+            next_send_us_ = std::max(next_send_us_, now) + kMss * 1000000 / rate;
+        }
+    }
+
+    void DetectLosses(uint64_t now, std::vector<LossEvent>& lost) {
+        uint64_t loss_delay = std::max<uint64_t>(std::max(srtt_us_, latest_rtt_us_) * 9 / 8, 1000);
+        uint64_t rto = std::max<uint64_t>(3 * srtt_us_, kMinRtoUs);
+        for (auto it = sent_.begin(); it != sent_.end();) {
+            bool below_largest = it->first < largest_acked_;
+            bool is_lost = (below_largest && (largest_acked_ >= it->first + kPacketThreshold ||
+                                              now - it->second.sent_time >= loss_delay)) ||
+                           now - it->second.sent_time >= rto;
+            if (!is_lost) {
+                if (!below_largest) {
+                    break;  // nothing newer can be lost by threshold, only by RTO
+                }
+                ++it;
+                continue;
+            }
+            LossEvent ev;
+            ev.pn = it->first;
+            ev.bytes_lost = it->second.bytes;
+            ev.lost_time = now;
+            lost.push_back(ev);
+            it = sent_.erase(it);
+        }
+    }
+
+    std::unique_ptr<ICongestionControl> cc_;
+    uint64_t index_;
+    uint64_t start_us_;
+
+    uint64_t next_pn_ = 1;
+    uint64_t largest_acked_ = 0;
+    uint64_t srtt_us_ = 0;
+    uint64_t latest_rtt_us_ = 0;
+    uint64_t next_send_us_ = 0;
+    std::map<uint64_t, SentInfo> sent_;
+    std::deque<PendingAck> pending_acks_;
+
+    uint64_t packets_sent_ = 0;
+    uint64_t packets_dropped_ = 0;
+    std::vector<uint64_t> delivered_buckets_;
+};
+
+NetworkCondition PathCondition(const BenchScenario& s, uint64_t bandwidth_mbps, uint64_t rtt_ms) {
+    NetworkCondition cond;
+    cond.base_rtt_us = rtt_ms * 1000;
+    cond.rtt_jitter_us = 0;
+    cond.packet_loss_rate = s.loss_rate;
+    // The simulator divides by bandwidth_bps as bits per second.
+    cond.bandwidth_bps = bandwidth_mbps * 1000 * 1000;
+    uint64_t bdp_bytes = s.bandwidth_mbps * 1000 * 1000 / 8 * s.rtt_ms / 1000;
+    cond.queue_size_bytes = std::max<uint64_t>(static_cast<uint64_t>(bdp_bytes * s.buffer_bdp), 4 * kMss);
+    cond.drop_on_overflow = true;
+    cond.l4s_mark_threshold_us = s.l4s ? 1000 : 0;
+    return cond;
+}
+
+// Capacity in bytes per bucket at time t.
+double CapacityBytesPerBucket(const BenchScenario& s, uint64_t t) {
+    uint64_t mbps = (s.step_time_us > 0 && s.step_bandwidth_mbps > 0 && t >= s.step_time_us) ? s.step_bandwidth_mbps
+                                                                                                : s.bandwidth_mbps;
+    return mbps * 1000.0 * 1000.0 / 8.0 * kBucketUs / 1000000.0;
+}
+
+double ConvergenceMs(const BenchScenario& s, const std::vector<std::unique_ptr<Flow>>& flows) {
+    uint64_t disturbance = (s.flows - 1) * s.flow_stagger_us;
+    if (s.step_time_us > 0) {
+        disturbance = std::max(disturbance, s.step_time_us);
+    }
+    uint64_t rtt_ms = std::max(s.rtt_ms, s.step_rtt_ms);
+    uint64_t window_us = std::max<uint64_t>(100000, 2 * rtt_ms * 1000);
+    uint64_t buckets_per_window = window_us / kBucketUs;
+
+    const uint64_t kHold = 3;
+    uint64_t good_run = 0;
+    for (uint64_t start = disturbance; start + window_us <= s.duration_us; start += window_us) {
+        std::vector<double> per_flow;
+        double total = 0, capacity = 0;
+        for (const auto& flow : flows) {
+            const auto& buckets = flow->DeliveredBuckets();
+            double bytes = 0;
+            for (uint64_t b = start / kBucketUs; b < start / kBucketUs + buckets_per_window; b++) {
+                bytes += b < buckets.size() ? buckets[b] : 0;
+            }
+            per_flow.push_back(bytes);
+            total += bytes;
+        }
+        for (uint64_t b = 0; b < buckets_per_window; b++) {
+            capacity += CapacityBytesPerBucket(s, start + b * kBucketUs);
+        }
+        bool good = total >= 0.8 * capacity && (flows.size() == 1 || JainIndex(per_flow) >= 0.8);
+        good_run = good ? good_run + 1 : 0;
+        if (good_run == kHold) {
+            uint64_t first_good = start - (kHold - 1) * window_us;
+            return (first_good + window_us - disturbance) / 1000.0;
+        }
+    }
+    return -1.0;
+}
+
+BenchResult RunScenario(const Controller& controller, const BenchScenario& s) {
+    NetworkSimulator sim(PathCondition(s, s.bandwidth_mbps, s.rtt_ms));
+    if (s.step_time_us > 0) {
+        uint64_t bw = s.step_bandwidth_mbps > 0 ? s.step_bandwidth_mbps : s.bandwidth_mbps;
+        uint64_t rtt = s.step_rtt_ms > 0 ? s.step_rtt_ms : s.rtt_ms;
+        sim.ScheduleConditionChange(s.step_time_us, PathCondition(s, bw, rtt));
+    }
+
+    std::vector<std::unique_ptr<Flow>> flows;
+    for (uint64_t i = 0; i < s.flows; i++) {
+        CongestionControlType type = (s.vs_cubic && i == 1) ? CongestionControlType::kCubic : controller.type;
+        flows.emplace_back(new Flow(CreateCongestionControl(type), i, i * s.flow_stagger_us));
+    }
+
+    std::vector<uint64_t> queue_delays;
+    for (uint64_t now = 0; now < s.duration_us; now += kTickUs) {
+        sim.ApplyScheduledChanges(now);
+        uint64_t return_delay = sim.GetCurrentCondition().base_rtt_us / 2;
+        for (const auto& packet : sim.GetDeliveredPackets(now)) {
+            flows[packet.packet_number % kMaxFlows]->OnDelivered(packet, packet.packet_number / kMaxFlows,
+                packet.delivery_time + return_delay);
+        }
+        for (auto& flow : flows) {
+            flow->ProcessAcks(now);
+        }
+        // Rotate who sends first so no flow always gets the emptier queue.
+        for (size_t i = 0; i < flows.size(); i++) {
+            flows[(i + now / kTickUs) % flows.size()]->TrySend(now, sim, queue_delays);
+        }
+    }
+
+    BenchResult r;
+    r.algorithm = controller.name;
+    r.scenario = s.name;
+
+    double duration_sec = s.duration_us / 1000000.0;
+    uint64_t sent = 0, dropped = 0;
+    double total_bytes = 0, capacity_bytes = 0;
+    uint64_t last_join = (s.flows - 1) * s.flow_stagger_us;
+    std::vector<double> joined_bytes;
+    for (const auto& flow : flows) {
+        sent += flow->PacketsSent();
+        dropped += flow->PacketsDropped();
+        double bytes = 0, after_join = 0;
+        const auto& buckets = flow->DeliveredBuckets();
+        for (size_t b = 0; b < buckets.size(); b++) {
+            bytes += buckets[b];
+            if (b * kBucketUs >= last_join) {
+                after_join += buckets[b];
+            }
+        }
+        total_bytes += bytes;
+        joined_bytes.push_back(after_join);
+        r.flow_goodput_mbps.push_back(bytes * 8 / duration_sec / 1e6);
+    }
+    for (uint64_t t = 0; t < s.duration_us; t += kBucketUs) {
+        capacity_bytes += CapacityBytesPerBucket(s, t);
+    }
+
+    r.goodput_mbps = total_bytes * 8 / duration_sec / 1e6;
+    r.utilization = capacity_bytes > 0 ? total_bytes / capacity_bytes : 0.0;
+    r.queue_delay_p50_ms = Percentile(queue_delays, 0.50) / 1000.0;
+    r.queue_delay_p99_ms = Percentile(queue_delays, 0.99) / 1000.0;
+    r.loss_rate = sent > 0 ? static_cast<double>(dropped) / sent : 0.0;
+    r.jain_fairness = flows.size() > 1 ? JainIndex(joined_bytes) : 1.0;
+    r.convergence_ms = ConvergenceMs(s, flows);
+    return r;
+}
+
+// ========== JSON ==========
+
+std::string ToJson(const std::vector<BenchResult>& results) {
+    std::ostringstream out;
+    char buf[512];
+    out << "{\n  \"version\": 1,\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        snprintf(buf, sizeof(buf),
+            "    {\"algorithm\": \"%s\", \"scenario\": \"%s\", \"goodput_mbps\": %.3f, \"utilization\": %.4f, "
+            "\"queue_delay_p50_ms\": %.3f, \"queue_delay_p99_ms\": %.3f, \"loss_rate\": %.5f, "
+            "\"jain_fairness\": %.4f, \"convergence_ms\": %.1f, \"flow_goodput_mbps\": [",
+            r.algorithm.c_str(), r.scenario.c_str(), r.goodput_mbps, r.utilization, r.queue_delay_p50_ms,
+            r.queue_delay_p99_ms, r.loss_rate, r.jain_fairness, r.convergence_ms);
+        out << buf;
+        for (size_t f = 0; f < r.flow_goodput_mbps.size(); f++) {
+            snprintf(buf, sizeof(buf), "%s%.3f", f ? ", " : "", r.flow_goodput_mbps[f]);
+            out << buf;
+        }
+        out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return out.str();
+}
+
+// Just enough JSON to read back what ToJson() writes (and hand edits of it):
+// objects, arrays, strings without escapes beyond \" and \\, numbers.
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text): text_(text) {}
+
+    // Flat string/number members of every object in the top-level "results"
+    // array. Nested arrays are skipped.
+    bool ReadResults(std::vector<std::map<std::string, std::string>>& out) {
+        if (!Expect('{')) return false;
+        while (true) {
+            std::string key;
+            if (!ReadString(key) || !Expect(':')) return false;
+            if (key == "results") {
+                if (!ReadResultArray(out)) return false;
+            } else if (!SkipValue()) {
+                return false;
+            }
+            if (Peek() == ',') {
+                pos_++;
+                continue;
+            }
+            return Expect('}');
+        }
+    }
+
+private:
+    bool ReadResultArray(std::vector<std::map<std::string, std::string>>& out) {
+        if (!Expect('[')) return false;
+        if (Peek() == ']') return Expect(']');
+        while (true) {
+            std::map<std::string, std::string> obj;
+            if (!Expect('{')) return false;
+            while (Peek() != '}') {
+                std::string key, value;
+                if (!ReadString(key) || !Expect(':')) return false;
+                if (Peek() == '"') {
+                    if (!ReadString(value)) return false;
+                    obj[key] = value;
+                } else if (Peek() == '[' || Peek() == '{') {
+                    if (!SkipValue()) return false;
+                } else {
+                    size_t start = pos_;
+                    while (pos_ < text_.size() && (isdigit(text_[pos_]) || strchr("+-.eE", text_[pos_]))) pos_++;
+                    if (pos_ == start) return false;
+                    obj[key] = text_.substr(start, pos_ - start);
+                }
+                if (Peek() == ',') pos_++;
+            }
+            pos_++;
+            out.push_back(obj);
+            if (Peek() == ',') {
+                pos_++;
+                continue;
+            }
+            return Expect(']');
+        }
+    }
+
+    bool SkipValue() {
+        char c = Peek();
+        if (c == '"') {
+            std::string ignored;
+            return ReadString(ignored);
+        }
+        if (c == '[' || c == '{') {
+            char close = c == '[' ? ']' : '}';
+            pos_++;
+            while (Peek() != close) {
+                if (close == '}') {
+                    std::string ignored;
+                    if (!ReadString(ignored) || !Expect(':')) return false;
+                }
+                if (!SkipValue()) return false;
+                if (Peek() == ',') pos_++;
+            }
+            pos_++;
+            return true;
+        }
+        size_t start = pos_;
+        while (pos_ < text_.size() && (isalnum(text_[pos_]) || strchr("+-.", text_[pos_]))) pos_++;
+        return pos_ > start;
+    }
+
+    bool ReadString(std::string& out) {
+        if (!Expect('"')) return false;
+        out.clear();
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) pos_++;
+            out += text_[pos_++];
+        }
+        return pos_++ < text_.size();
+    }
+
+    char Peek() {
+        while (pos_ < text_.size() && isspace(static_cast<unsigned char>(text_[pos_]))) pos_++;
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    bool Expect(char c) {
+        if (Peek() != c) return false;
+        pos_++;
+        return true;
+    }
+
+    const std::string& text_;
+    size_t pos_ = 0;
+};
+
+// ========== Comparison ==========
+
+struct MetricRule {
+    const char* name;
+    bool higher_is_better;
+    double abs_floor;  // changes smaller than this never count
+};
+
+const MetricRule kRules[] = {
+    {"goodput_mbps", true, 0.5},
+    {"queue_delay_p50_ms", false, 0.5},
+    {"queue_delay_p99_ms", false, 1.0},
+    {"loss_rate", false, 0.001},
+    {"jain_fairness", true, 0.02},
+    {"convergence_ms", false, 100.0},
+};
+
+double ToDouble(const std::map<std::string, std::string>& obj, const char* key, bool& ok) {
+    auto it = obj.find(key);
+    if (it == obj.end()) {
+        ok = false;
+        return 0.0;
+    }
+    return atof(it->second.c_str());
+}
+
+// Returns the number of regressions.
+int Compare(const std::vector<BenchResult>& current, const std::string& current_json,
+    const std::vector<std::map<std::string, std::string>>& baseline, double tolerance) {
+    std::vector<std::map<std::string, std::string>> now;
+    JsonReader(current_json).ReadResults(now);
+
+    std::map<std::string, const std::map<std::string, std::string>*> base_by_key;
+    for (const auto& obj : baseline) {
+        auto a = obj.find("algorithm"), s = obj.find("scenario");
+        if (a != obj.end() && s != obj.end()) {
+            base_by_key[a->second + "/" + s->second] = &obj;
+        }
+    }
+
+    int regressions = 0, improvements = 0;
+    for (size_t i = 0; i < now.size(); i++) {
+        std::string key = current[i].algorithm + "/" + current[i].scenario;
+        auto it = base_by_key.find(key);
+        if (it == base_by_key.end()) {
+            fprintf(stderr, "  %-32s  new (no baseline)\n", key.c_str());
+            continue;
+        }
+        for (const auto& rule : kRules) {
+            bool ok = true;
+            double before = ToDouble(*it->second, rule.name, ok);
+            double after = ToDouble(now[i], rule.name, ok);
+            if (!ok) {
+                continue;
+            }
+            // -1 means "never converged": worse than any time.
+            bool before_never = std::string(rule.name) == "convergence_ms" && before < 0;
+            bool after_never = std::string(rule.name) == "convergence_ms" && after < 0;
+            bool worse, better;
+            if (before_never || after_never) {
+                worse = after_never && !before_never;
+                better = before_never && !after_never;
+            } else {
+                double delta = rule.higher_is_better ? before - after : after - before;
+                double limit = std::max(rule.abs_floor, std::fabs(before) * tolerance);
+                worse = delta > limit;
+                better = -delta > limit;
+            }
+            if (worse || better) {
+                fprintf(stderr, "  %-32s  %-20s %10.3f -> %10.3f  %s\n", key.c_str(), rule.name, before, after,
+                    worse ? "REGRESSED" : "improved");
+            }
+            regressions += worse;
+            improvements += better;
+        }
+    }
+    fprintf(stderr, "%d regression(s), %d improvement(s) against the baseline (tolerance %.0f%%)\n", regressions,
+        improvements, tolerance * 100);
+    return regressions;
+}
+
+void PrintUsage(const char* argv0) {
+    fprintf(stderr,
+        "usage: %s [--filter=<substr>] [--out=<file>] [--compare=<baseline.json>] [--tolerance=<fraction>]\n"
+        "  --filter     run only the <algorithm>/<scenario> pairs containing <substr>\n"
+        "  --out        write the JSON results to <file> instead of stdout\n"
+        "  --compare    compare against a baseline; exit 1 if any metric regressed\n"
+        "  --tolerance  relative change tolerated before a metric counts as moved (default 0.05)\n",
+        argv0);
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
+
+int main(int argc, char** argv) {
+    using namespace quicx::quic;
+
+    std::string filter, out_path, compare_path;
+    double tolerance = 0.05;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&arg](const char* flag) { return arg.substr(strlen(flag)); };
+        if (arg.rfind("--filter=", 0) == 0) {
+            filter = value("--filter=");
+        } else if (arg.rfind("--out=", 0) == 0) {
+            out_path = value("--out=");
+        } else if (arg.rfind("--compare=", 0) == 0) {
+            compare_path = value("--compare=");
+        } else if (arg.rfind("--tolerance=", 0) == 0) {
+            tolerance = atof(value("--tolerance=").c_str());
+        } else {
+            PrintUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    std::vector<std::map<std::string, std::string>> baseline;
+    if (!compare_path.empty()) {
+        std::ifstream in(compare_path);
+        std::stringstream text;
+        text << in.rdbuf();
+        std::string content = text.str();
+        if (!in || !JsonReader(content).ReadResults(baseline)) {
+            fprintf(stderr, "cannot read baseline %s\n", compare_path.c_str());
+            return 2;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for (const auto& controller : AllControllers()) {
+        for (const auto& scenario : ScenarioMatrix()) {
+            std::string key = controller.name + "/" + scenario.name;
+            if (!filter.empty() && key.find(filter) == std::string::npos) {
+                continue;
+            }
+            BenchResult r = RunScenario(controller, scenario);
+            fprintf(stderr, "%-32s goodput %8.2f Mbps  util %5.1f%%  qdelay p50 %7.2f p99 %7.2f ms  loss %6.3f%%  "
+                "jain %.3f  conv %8.1f ms\n",
+                key.c_str(), r.goodput_mbps, r.utilization * 100, r.queue_delay_p50_ms, r.queue_delay_p99_ms,
+                r.loss_rate * 100, r.jain_fairness, r.convergence_ms);
+            results.push_back(r);
+        }
+    }
+
+    std::string json = ToJson(results);
+    if (out_path.empty()) {
+        fputs(json.c_str(), stdout);
+    } else {
+        std::ofstream out(out_path);
+        out << json;
+        if (!out) {
+            fprintf(stderr, "cannot write %s\n", out_path.c_str());
+            return 2;
+        }
+    }
+
+    if (!compare_path.empty()) {
+        return Compare(results, json, baseline, tolerance) > 0 ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "cc_test_framework.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+// Queueing delay after slow start has settled.
+double SteadyQueueDelayUs(const CCTestMetrics& metrics, uint64_t from_us) {
+    double sum = 0;
+    size_t count = 0;
+    for (const auto& snapshot : metrics.state_history) {
+        if (snapshot.time_us >= from_us) {
+            sum += snapshot.queue_delay_us;
+            count++;
+        }
+    }
+    return count > 0 ? sum / count : 0.0;
+}
+
+// ========== L4S / DualQ ==========
+
+TEST(CCL4S, PragueKeepsQueueBelowOneMillisecond) {
+    printf("\n=== Prague over a DualQ L4S bottleneck ===\n");
+
+    auto scenario = TestScenario::L4SNetwork();
+    CCTestFramework test(CCAlgorithmFactory::Prague(), scenario);
+    test.Run();
+    test.PrintStats(true);
+
+    auto metrics = test.GetMetrics();
+    double queue_delay_us = SteadyQueueDelayUs(metrics, scenario.test_duration_us / 5);
+    printf("Steady-state queue delay: %.0f us, CE marks: %llu\n", queue_delay_us, metrics.total_ce_marks);
+
+    EXPECT_GT(metrics.total_ce_marks, 0u);
+    EXPECT_EQ(metrics.total_packets_lost, 0u);
+    EXPECT_LT(queue_delay_us, 1000.0);
+    // Shallow queue without starving the link (1Gbps preset = 125Mbit/s in
+    // the simulator's arithmetic).
+    EXPECT_GT(metrics.throughput_mbps, 100.0);
+}
+
+TEST(CCL4S, ClassicTrafficIsNotMarked) {
+    printf("\n=== CUBIC over the same bottleneck (classic queue) ===\n");
+
+    auto scenario = TestScenario::L4SNetwork();
+    CCTestFramework cubic(CCAlgorithmFactory::CUBIC(), scenario);
+    cubic.Run();
+    cubic.PrintStats();
+    CCTestFramework prague(CCAlgorithmFactory::Prague(), scenario);
+    prague.Run();
+
+    // ECT(0) traffic is never CE-marked by the L-queue, so CUBIC only backs
+    // off on loss and builds a standing queue that Prague avoids.
+    EXPECT_EQ(cubic.GetMetrics().total_ce_marks, 0u);
+    double from = scenario.test_duration_us / 5;
+    EXPECT_GT(SteadyQueueDelayUs(cubic.GetMetrics(), from), 5 * SteadyQueueDelayUs(prague.GetMetrics(), from));
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
@@ -6,6 +6,7 @@
 #include "quic/congestion_control/bbr_v1_congestion_control.h"
 #include "quic/congestion_control/bbr_v2_congestion_control.h"
 #include "quic/congestion_control/bbr_v3_congestion_control.h"
+#include "quic/congestion_control/prague_congestion_control.h"
 
 
 
@@ -87,6 +88,14 @@ TestScenario TestScenario::ExtremeLoss(uint64_t duration_us) {
     return scenario;
 }
 
+TestScenario TestScenario::L4SNetwork(uint64_t duration_us) {
+    TestScenario scenario;
+    scenario.name = "L4S (DualQ)";
+    scenario.network_condition = NetworkCondition::L4S();
+    scenario.test_duration_us = duration_us;
+    return scenario;
+}
+
 TestScenario TestScenario::NetworkDegradation(uint64_t duration_us) {
     TestScenario scenario;
     scenario.name = "Network Degradation";
@@ -223,7 +232,7 @@ void CCTestFramework::SendPacket(uint64_t bytes) {
     metrics_.total_bytes_sent += bytes;
     metrics_.total_packets_sent++;
 
-    bool sent = network_sim_.SendPacket(current_time_us_, pn, bytes);
+    bool sent = network_sim_.SendPacket(current_time_us_, pn, bytes, cc_->UsesL4sEcn());
 
     if (sent) {
         SentPacketInfo info;
@@ -269,7 +278,10 @@ void CCTestFramework::ProcessAcks() {
         ack_ev.bytes_acked = packet.bytes;
         ack_ev.ack_time = current_time_us_;
         ack_ev.ack_delay = 0;
-        ack_ev.ecn_ce = false;
+        ack_ev.ecn_ce = packet.ce_marked;
+        if (packet.ce_marked) {
+            metrics_.total_ce_marks++;
+        }
         // RFC 9002 §7.3.2: CC implementations rely on this field to decide
         // when to exit recovery (only when an ACK arrives for a packet sent
         // AFTER recovery start). Without it, every ACK has send_time==0 and
@@ -324,6 +336,7 @@ void CCTestFramework::RecordStateSnapshot() {
     snapshot.in_slow_start = cc_->InSlowStart();
     snapshot.in_recovery = cc_->InRecovery();
     snapshot.rtt_us = network_sim_.GetCurrentRtt(current_time_us_);
+    snapshot.queue_delay_us = network_sim_.GetQueueDelay(current_time_us_);
     
     metrics_.state_history.push_back(snapshot);
     
@@ -346,19 +359,22 @@ void CCTestFramework::CalculateMetrics() {
         ? static_cast<double>(metrics_.total_packets_lost) / metrics_.total_packets_sent : 0.0;
     
     if (!metrics_.state_history.empty()) {
-        double sum_cwnd = 0, sum_rtt = 0;
+        double sum_cwnd = 0, sum_rtt = 0, sum_queue_delay = 0;
         metrics_.max_cwnd_bytes = 0;
         metrics_.min_cwnd_bytes = std::numeric_limits<double>::max();
         
         for (const auto& snapshot : metrics_.state_history) {
             sum_cwnd += snapshot.cwnd_bytes;
             sum_rtt += snapshot.rtt_us;
+            sum_queue_delay += snapshot.queue_delay_us;
+            metrics_.max_queue_delay_us = std::max(metrics_.max_queue_delay_us, snapshot.queue_delay_us);
             metrics_.max_cwnd_bytes = std::max(metrics_.max_cwnd_bytes, static_cast<double>(snapshot.cwnd_bytes));
             metrics_.min_cwnd_bytes = std::min(metrics_.min_cwnd_bytes, static_cast<double>(snapshot.cwnd_bytes));
         }
         
         metrics_.avg_cwnd_bytes = sum_cwnd / metrics_.state_history.size();
         metrics_.avg_rtt_ms = (sum_rtt / metrics_.state_history.size()) / 1000.0;
+        metrics_.avg_queue_delay_us = sum_queue_delay / metrics_.state_history.size();
     }
     
     metrics_.slow_start_duration_us = slow_start_exit_time_ > 0 ? slow_start_exit_time_ : scenario_.test_duration_us;
@@ -389,6 +405,7 @@ void CCTestFramework::PrintStats(bool detailed) const {
     printf("Bytes Sent: %llu, Acked: %llu\n", metrics_.total_bytes_sent, metrics_.total_bytes_acked);
     printf("Loss Rate: %.2f%%\n", metrics_.packet_loss_rate * 100);
     printf("Avg RTT: %.2f ms\n", metrics_.avg_rtt_ms);
+    printf("Queue Delay: avg %.0f us, max %llu us\n", metrics_.avg_queue_delay_us, metrics_.max_queue_delay_us);
     
     if (detailed) {
         printf("\n--- Detailed Metrics ---\n");
@@ -425,6 +442,10 @@ CCTestFramework::CCFactory CCAlgorithmFactory::BBRv3() {
     return []() { return std::make_unique<BBRv3CongestionControl>(); };
 }
 
+CCTestFramework::CCFactory CCAlgorithmFactory::Prague() {
+    return []() { return std::make_unique<PragueCongestionControl>(); };
+}
+
 std::vector<std::pair<std::string, CCTestFramework::CCFactory>> CCAlgorithmFactory::AllAlgorithms() {
     return {
         {"Reno", Reno()},
@@ -30,6 +30,11 @@ struct CCTestMetrics {
     
     // RTT statistics
     double avg_rtt_ms = 0.0;
+
+    // Bottleneck queueing delay, sampled with the state snapshots
+    double avg_queue_delay_us = 0.0;
+    uint64_t max_queue_delay_us = 0;
+    uint64_t total_ce_marks = 0;
     
     // Algorithm behavior
     uint64_t slow_start_duration_us = 0;
@@ -45,6 +50,7 @@ struct CCTestMetrics {
         bool in_slow_start;
         bool in_recovery;
         uint64_t rtt_us;
+        uint64_t queue_delay_us;
     };
     std::vector<StateSnapshot> state_history;
 };
@@ -65,6 +71,7 @@ struct TestScenario {
     static TestScenario BufferBloat(uint64_t duration_us = 10000000);
     static TestScenario SatelliteLink(uint64_t duration_us = 20000000);
     static TestScenario ExtremeLoss(uint64_t duration_us = 10000000);
+    static TestScenario L4SNetwork(uint64_t duration_us = 5000000);
     
     // Dynamic scenarios
     static TestScenario NetworkDegradation(uint64_t duration_us = 10000000);
@@ -128,6 +135,7 @@ public:
     static CCTestFramework::CCFactory BBRv1();
     static CCTestFramework::CCFactory BBRv2();
     static CCTestFramework::CCFactory BBRv3();
+    static CCTestFramework::CCFactory Prague();
     
     static std::vector<std::pair<std::string, CCTestFramework::CCFactory>> AllAlgorithms();
 };
@@ -13,7 +13,7 @@ NetworkSimulator::NetworkSimulator(const NetworkCondition& condition)
       next_event_index_(0) {
 }
 
-bool NetworkSimulator::SendPacket(uint64_t now, uint64_t packet_number, uint64_t bytes) {
+bool NetworkSimulator::SendPacket(uint64_t now, uint64_t packet_number, uint64_t bytes, bool ect1) {
     // Check if packet should be dropped due to loss
     if (condition_.packet_loss_rate > 0.0) {
         double random_val = loss_dist_(rng_);
@@ -21,15 +21,27 @@ bool NetworkSimulator::SendPacket(uint64_t now, uint64_t packet_number, uint64_t
             return false;  // Packet lost
         }
     }
+
+    if (condition_.drop_on_overflow && condition_.queue_size_bytes > 0 && condition_.bandwidth_bps > 0) {
+        uint64_t backlog_bytes = GetQueueDelay(now) * condition_.bandwidth_bps / 8 / 1000000;
+        if (backlog_bytes + bytes > condition_.queue_size_bytes) {
+            return false;  // Tail drop
+        }
+    }
     
     // Calculate delivery time
-    uint64_t delivery_time = CalculateDeliveryTime(now, bytes);
+    uint64_t queue_delay_us = 0;
+    uint64_t delivery_time = CalculateDeliveryTime(now, bytes, queue_delay_us);
     
     InFlightPacket packet;
     packet.packet_number = packet_number;
     packet.bytes = bytes;
     packet.sent_time = now;
     packet.delivery_time = delivery_time;
+    // DualQ step marking on the L4S queue's sojourn time. Marking at enqueue
+    // with the known wait is the same as DualPI2 marking it at dequeue.
+    packet.ce_marked = ect1 && condition_.l4s_mark_threshold_us > 0 &&
+                       queue_delay_us > condition_.l4s_mark_threshold_us;
     
     in_flight_packets_.push(packet);
     queued_bytes_ += bytes;
@@ -109,7 +121,7 @@ void NetworkSimulator::ApplyScheduledChanges(uint64_t now) {
     }
 }
 
-uint64_t NetworkSimulator::CalculateDeliveryTime(uint64_t now, uint64_t bytes) {
+uint64_t NetworkSimulator::CalculateDeliveryTime(uint64_t now, uint64_t bytes, uint64_t& queue_delay_us) {
     uint64_t rtt = GenerateRtt();
     uint64_t one_way_delay = rtt / 2;
     
@@ -122,7 +134,7 @@ uint64_t NetworkSimulator::CalculateDeliveryTime(uint64_t now, uint64_t bytes) {
     uint64_t transmission_time_us = (bytes * 8 * 1000000) / condition_.bandwidth_bps;
     
     // Calculate queuing delay
-    uint64_t queue_delay_us = 0;
+    queue_delay_us = 0;
     if (last_dequeue_time_ > now) {
         // If previous packet is still transmitting, need to wait
         queue_delay_us = last_dequeue_time_ - now;
@@ -130,7 +142,7 @@ uint64_t NetworkSimulator::CalculateDeliveryTime(uint64_t now, uint64_t bytes) {
     
     // Check queue overflow - in reality, this would result in packet drop
     // For now we still accept the packet but this could be enhanced
-    if (condition_.queue_size_bytes > 0) {
+    if (condition_.queue_size_bytes > 0 && !condition_.drop_on_overflow) {
         uint64_t future_queue_size = queued_bytes_ + bytes;
         if (future_queue_size > condition_.queue_size_bytes) {
             // Queue is approaching full - calculate additional queuing delay
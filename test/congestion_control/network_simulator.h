@@ -25,6 +25,16 @@ struct NetworkCondition {
     
     // Queue size in bytes for simulating buffer bloat, 0 means unlimited
     uint64_t queue_size_bytes = 0;
+
+    // Tail-drop a packet that finds queue_size_bytes already waiting at the
+    // bottleneck (propagation not counted). Off, an overflowing queue only
+    // adds delay.
+    bool drop_on_overflow = false;
+
+    // DualQ Coupled AQM (RFC 9332) L-queue: an ECT(1) packet that will wait
+    // longer than this in the queue is CE-marked. Other packets go through the
+    // classic queue unmarked. 0 disables marking.
+    uint64_t l4s_mark_threshold_us = 0;
     
     // Random seed for reproducible tests
     uint32_t random_seed = 42;
@@ -161,6 +171,18 @@ struct NetworkCondition {
         return cond;
     }
     
+    // L4S-enabled bottleneck: DualQ AQM marking ECT(1) traffic at 1ms
+    static NetworkCondition L4S() {
+        NetworkCondition cond;
+        cond.base_rtt_us = 20000;  // 20ms
+        cond.rtt_jitter_us = 0;
+        cond.packet_loss_rate = 0.0;
+        cond.bandwidth_bps = 1000 * 1000 * 1000 / 8;  // 1Gbps
+        cond.queue_size_bytes = 1000 * 1460;
+        cond.l4s_mark_threshold_us = 1000;  // DualPI2 default step threshold
+        return cond;
+    }
+
     // Cross-continent network (e.g., US-Europe)
     static NetworkCondition CrossContinent() {
         NetworkCondition cond;
@@ -179,6 +201,7 @@ struct InFlightPacket {
     uint64_t bytes;
     uint64_t sent_time;
     uint64_t delivery_time;  // Expected delivery time
+    bool ce_marked = false;  // CE set by the L4S queue
 };
 
 // Network event for dynamic condition changes
@@ -192,8 +215,9 @@ class NetworkSimulator {
 public:
     explicit NetworkSimulator(const NetworkCondition& condition);
     
-    // Send a packet, returns whether it was dropped
-    bool SendPacket(uint64_t now, uint64_t packet_number, uint64_t bytes);
+    // Send a packet, returns whether it was dropped. `ect1` sends it ECT(1),
+    // i.e. into the L4S queue.
+    bool SendPacket(uint64_t now, uint64_t packet_number, uint64_t bytes, bool ect1 = false);
     
     // Get packets delivered at specified time
     std::vector<InFlightPacket> GetDeliveredPackets(uint64_t now);
@@ -203,6 +227,9 @@ public:
     
     // Get bytes in queue
     uint64_t GetQueuedBytes() const { return queued_bytes_; }
+
+    // Time a packet sent now would wait behind those already queued
+    uint64_t GetQueueDelay(uint64_t now) const { return last_dequeue_time_ > now ? last_dequeue_time_ - now : 0; }
     
     // Reset simulator
     void Reset();
@@ -234,7 +261,7 @@ private:
     size_t next_event_index_;
     
     // Calculate packet transmission time and queuing delay
-    uint64_t CalculateDeliveryTime(uint64_t now, uint64_t bytes);
+    uint64_t CalculateDeliveryTime(uint64_t now, uint64_t bytes, uint64_t& queue_delay_us);
     
     // Generate RTT with jitter
     uint64_t GenerateRtt();
@@ -0,0 +1,284 @@
+// Tests of the simulation harness itself: virtual clock, lockstep scheduling
+// and the link model. They drive bare event loops, no QUIC handshake involved.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "common/network/if_event_driver.h"
+#include "common/network/io_handle.h"
+#include "common/util/time.h"
+#include "quic/udp/if_receiver.h"
+#include "quic/udp/if_sender.h"
+#include <quicx/common/if_event_loop.h>
+
+#include "simulation.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+// An event loop on its own thread, the way MasterWithThread runs one.
+class LoopThread {
+public:
+    LoopThread():
+        loop_(common::MakeEventLoop()) {
+        std::promise<void> ready;
+        auto ready_future = ready.get_future();
+        thread_ = std::thread([this, &ready]() {
+            loop_->Init();
+            ready.set_value();
+            while (!stop_) {
+                loop_->Wait();
+            }
+        });
+        ready_future.wait();
+    }
+
+    ~LoopThread() {
+        stop_ = true;
+        loop_->Wakeup();
+        thread_.join();
+    }
+
+    std::shared_ptr<common::IEventLoop> GetLoop() { return loop_; }
+
+private:
+    std::shared_ptr<common::IEventLoop> loop_;
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+// Records what arrives: virtual arrival time in ms and the sequence number
+// SendPackets() put in the first two bytes.
+class RecordingReceiver:
+    public IPacketReceiver {
+public:
+    void OnPacket(std::shared_ptr<NetPacket>& pkt) override {
+        uint8_t seq[2] = {0, 0};
+        pkt->GetData()->ReadNotMovePt(seq, 2);
+        times.push_back(pkt->GetTime());
+        ids.push_back(static_cast<uint16_t>(seq[0] << 8 | seq[1]));
+        lengths.push_back(pkt->GetData()->GetDataLength());
+    }
+
+    std::vector<uint64_t> times;
+    std::vector<uint16_t> ids;
+    std::vector<uint32_t> lengths;
+};
+
+struct Endpoint {
+    int32_t fd = -1;
+    std::shared_ptr<IReceiver> receiver;
+    std::shared_ptr<RecordingReceiver> recorder = std::make_shared<RecordingReceiver>();
+
+    explicit Endpoint(std::shared_ptr<common::IEventLoop> loop) {
+        fd = common::UdpSocket().return_value_;
+        receiver = IReceiver::MakeReceiver(loop);
+        receiver->AddReceiver(fd, recorder);
+    }
+    ~Endpoint() {
+        receiver.reset();
+        common::Close(fd);
+    }
+};
+
+void SendPackets(
+    Simulation& sim, int32_t src_fd, const common::Address& dst, int count, uint32_t size, uint16_t first_seq = 0) {
+    std::vector<uint8_t> payload(size);
+    for (int i = 0; i < count; i++) {
+        uint16_t seq = static_cast<uint16_t>(first_seq + i);
+        payload[0] = static_cast<uint8_t>(seq >> 8);
+        payload[1] = static_cast<uint8_t>(seq);
+        sim.GetNetwork()->Transmit(src_fd, dst, payload.data(), size, 0);
+    }
+}
+
+TEST(SimulationTest, TimersRunOnVirtualClock) {
+    Simulation sim(1);
+    LoopThread loop_thread;
+    auto loop = loop_thread.GetLoop();
+
+    const uint64_t start_ms = sim.NowMs();
+    EXPECT_EQ(common::UTCTimeMsec(), start_ms);
+
+    // a 10 ms tick re-armed from its own callback, as the stack's timers are
+    std::atomic<uint32_t> fired{0};
+    std::atomic<uint64_t> first_fire_ms{0};
+    std::function<void()> tick = [&]() {
+        if (fired++ == 0) {
+            first_fire_ms = common::UTCTimeMsec();
+        }
+        loop->AddTimer(tick, 10);
+    };
+    loop->RunInLoop([&]() { loop->AddTimer(tick, 10); });
+
+    auto wall_start = std::chrono::steady_clock::now();
+    sim.RunFor(60 * 1000);
+    auto wall_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - wall_start).count();
+
+    EXPECT_EQ(sim.NowMs(), start_ms + 60 * 1000);
+    EXPECT_EQ(first_fire_ms.load(), start_ms + 10);
+    EXPECT_GE(fired.load(), 5990u);
+    EXPECT_LE(fired.load(), 6000u);
+    // a minute of virtual time must not take anything close to a minute
+    EXPECT_LT(wall_ms, 10000);
+}
+
+TEST(SimulationTest, RunUntilStopsWhenDone) {
+    Simulation sim(1);
+    LoopThread loop_thread;
+    auto loop = loop_thread.GetLoop();
+
+    std::atomic<bool> done{false};
+    loop->RunInLoop([&]() { loop->AddTimer([&]() { done = true; }, 250); });
+
+    const uint64_t start_ms = sim.NowMs();
+    EXPECT_TRUE(sim.RunUntil([&]() { return done.load(); }, 10 * 1000));
+    EXPECT_EQ(sim.NowMs(), start_ms + 250);
+
+    EXPECT_FALSE(sim.RunUntil([]() { return false; }, 1000));
+    EXPECT_EQ(sim.NowMs(), start_ms + 1250);
+}
+
+TEST(SimulationTest, LinkDelayAndBandwidth) {
+    Simulation sim(1);
+    SimLinkConfig link;
+    link.delay_us = 20000;
+    link.bandwidth_bps = 8 * 1000 * 1000;  // 1 byte/us
+    sim.SetLink(link);
+
+    LoopThread a_thread, b_thread;
+    Endpoint a(a_thread.GetLoop());
+    Endpoint b(b_thread.GetLoop());
+    common::Address b_addr = sim.GetNetwork()->LocalAddress(b.fd);
+
+    const uint64_t start_ms = sim.NowMs();
+    SendPackets(sim, a.fd, b_addr, 100, 1000);
+    sim.RunFor(1000);
+
+    auto& rx = *b.recorder;
+    ASSERT_EQ(rx.times.size(), 100u);
+    for (size_t i = 0; i < rx.ids.size(); i++) {
+        EXPECT_EQ(rx.ids[i], i);
+        EXPECT_EQ(rx.lengths[i], 1000u);
+    }
+    // 1 ms to serialize each packet, then 20 ms of propagation
+    EXPECT_EQ(rx.times.front(), start_ms + 21);
+    EXPECT_EQ(rx.times.back(), start_ms + 120);
+    EXPECT_TRUE(a.recorder->times.empty());
+}
+
+TEST(SimulationTest, MtuAndQueueDrops) {
+    Simulation sim(1);
+    SimLinkConfig link;
+    link.bandwidth_bps = 8 * 1000 * 1000;
+    link.queue_bytes = 10000;
+    link.mtu_bytes = 1200;
+    sim.SetLink(link);
+
+    LoopThread a_thread, b_thread;
+    Endpoint a(a_thread.GetLoop());
+    Endpoint b(b_thread.GetLoop());
+    common::Address a_addr = sim.GetNetwork()->LocalAddress(a.fd);
+    common::Address b_addr = sim.GetNetwork()->LocalAddress(b.fd);
+
+    SendPackets(sim, a.fd, b_addr, 1, 1300);
+    SendPackets(sim, a.fd, b_addr, 20, 1000);
+    sim.RunFor(1000);
+
+    auto stats = sim.GetNetwork()->GetLinkStats(a_addr.GetIp(), b_addr.GetIp());
+    EXPECT_EQ(stats.packets_sent, 21u);
+    EXPECT_EQ(stats.packets_too_big, 1u);
+    EXPECT_EQ(stats.packets_queue_dropped, 10u);
+    EXPECT_EQ(stats.packets_delivered, 10u);
+    EXPECT_EQ(b.recorder->times.size(), 10u);
+}
+
+TEST(SimulationTest, UnknownDestinationIsDropped) {
+    Simulation sim(1);
+    LoopThread a_thread;
+    Endpoint a(a_thread.GetLoop());
+
+    SendPackets(sim, a.fd, common::Address("10.9.9.9", 443), 3, 100);
+    sim.RunFor(1000);
+    EXPECT_EQ(sim.GetNetwork()->GetUndeliverable(), 3u);
+}
+
+// Returns while the Simulation is live, the way a failed ASSERT does
+bool SawVirtualClockThenReturned() {
+    Simulation sim(1);
+    if (common::UTCTimeMsec() == sim.NowMs()) {
+        return true;
+    }
+    sim.RunFor(1);
+    return false;
+}
+
+TEST(SimulationTest, HooksRemovedOnEarlyReturn) {
+    ASSERT_TRUE(SawVirtualClockThenReturned());
+
+    auto wall_ms = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    EXPECT_LT(std::abs(static_cast<int64_t>(common::UTCTimeMsec()) - wall_ms), 10000);
+    auto driver = common::IEventDriver::Create();
+    EXPECT_EQ(dynamic_cast<SimEventDriver*>(driver.get()), nullptr);
+    EXPECT_EQ(std::dynamic_pointer_cast<SimSender>(ISender::MakeSender()), nullptr);
+    EXPECT_EQ(std::dynamic_pointer_cast<SimReceiver>(IReceiver::MakeReceiver(common::MakeEventLoop())), nullptr);
+
+    // and the next Simulation may start
+    Simulation next(2);
+    EXPECT_EQ(common::UTCTimeMsec(), next.NowMs());
+}
+
+std::vector<uint16_t> RunLossyReorderingLink(uint64_t seed) {
+    Simulation sim(seed);
+    SimLinkConfig link;
+    link.delay_us = 10000;
+    link.jitter_us = 2000;
+    link.loss_rate = 0.1;
+    link.reorder_rate = 0.1;
+    link.reorder_delay_us = 3000;
+    sim.SetLink(link);
+
+    LoopThread a_thread, b_thread;
+    Endpoint a(a_thread.GetLoop());
+    Endpoint b(b_thread.GetLoop());
+    common::Address b_addr = sim.GetNetwork()->LocalAddress(b.fd);
+
+    for (int round = 0; round < 20; round++) {
+        SendPackets(sim, a.fd, b_addr, 25, 200, static_cast<uint16_t>(round * 25));
+        sim.RunFor(1);
+    }
+    sim.RunFor(1000);
+    return b.recorder->ids;
+}
+
+TEST(SimulationTest, LossAndReorderingReproducibleFromSeed) {
+    auto first = RunLossyReorderingLink(7);
+    auto second = RunLossyReorderingLink(7);
+    auto other = RunLossyReorderingLink(8);
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, other);
+
+    // about 10% of 500 lost, and some arrive out of order
+    EXPECT_GT(first.size(), 400u);
+    EXPECT_LT(first.size(), 480u);
+    bool reordered = false;
+    for (size_t i = 1; i < first.size(); i++) {
+        reordered = reordered || first[i] < first[i - 1];
+    }
+    EXPECT_TRUE(reordered);
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,66 @@
+#include <algorithm>
+
+#include "sim_link.h"
+
+namespace quicx {
+namespace quic {
+
+SimLink::SimLink(const SimLinkConfig& config, uint64_t seed):
+    config_(config),
+    rng_(seed) {}
+
+SimLink::Verdict SimLink::Transmit(uint64_t now_us, uint32_t bytes, uint64_t& arrival_us) {
+    stats_.packets_sent++;
+    stats_.bytes_sent += bytes;
+
+    if (config_.mtu_bytes > 0 && bytes > config_.mtu_bytes) {
+        stats_.packets_too_big++;
+        return Verdict::kTooBig;
+    }
+
+    uint64_t departure_us = now_us;
+    if (config_.bandwidth_bps > 0) {
+        uint64_t start_us = std::max(now_us, busy_until_us_);
+        if (config_.queue_bytes > 0) {
+            uint64_t backlog_bytes = (start_us - now_us) * config_.bandwidth_bps / 8 / 1000000;
+            if (backlog_bytes + bytes > config_.queue_bytes) {
+                stats_.packets_queue_dropped++;
+                return Verdict::kQueueFull;
+            }
+        }
+        uint64_t serialize_us = (static_cast<uint64_t>(bytes) * 8 * 1000000 + config_.bandwidth_bps - 1) /
+                                config_.bandwidth_bps;
+        busy_until_us_ = start_us + serialize_us;
+        departure_us = busy_until_us_;
+    }
+
+    // lost on the wire, after having used the bottleneck
+    if (config_.loss_rate > 0 && NextUniform() < config_.loss_rate) {
+        stats_.packets_lost++;
+        return Verdict::kLost;
+    }
+
+    arrival_us = departure_us + config_.delay_us;
+    if (config_.jitter_us > 0) {
+        arrival_us += static_cast<uint64_t>(NextUniform() * static_cast<double>(config_.jitter_us + 1));
+    }
+    if (config_.reorder_rate > 0 && NextUniform() < config_.reorder_rate) {
+        arrival_us += config_.reorder_delay_us;
+        stats_.packets_reordered++;
+    } else {
+        arrival_us = std::max(arrival_us, last_arrival_us_);
+        last_arrival_us_ = arrival_us;
+    }
+
+    stats_.packets_delivered++;
+    stats_.bytes_delivered += bytes;
+    return Verdict::kDelivered;
+}
+
+double SimLink::NextUniform() {
+    // top 53 bits, exactly representable in a double
+    return static_cast<double>(rng_() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+}  // namespace quic
+}  // namespace quicx
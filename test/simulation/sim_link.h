@@ -0,0 +1,93 @@
+#ifndef TEST_SIMULATION_SIM_LINK
+#define TEST_SIMULATION_SIM_LINK
+
+#include <cstdint>
+#include <random>
+
+namespace quicx {
+namespace quic {
+
+// One direction of a simulated path.
+struct SimLinkConfig {
+    // One-way propagation delay in microseconds
+    uint64_t delay_us = 10000;
+
+    // Extra delay drawn uniformly from [0, jitter_us]. Jitter alone never
+    // reorders: a packet is held until the one before it arrived.
+    uint64_t jitter_us = 0;
+
+    // Random loss rate (0.0 - 1.0), applied after the bottleneck
+    double loss_rate = 0.0;
+
+    // Probability (0.0 - 1.0) that a packet is held back reorder_delay_us
+    // longer than its neighbours and arrives out of order
+    double reorder_rate = 0.0;
+    uint64_t reorder_delay_us = 5000;
+
+    // Bottleneck rate in bits per second, 0 means unlimited
+    uint64_t bandwidth_bps = 0;
+
+    // Bottleneck buffer in bytes, tail-drop when full. 0 means unlimited
+    uint64_t queue_bytes = 0;
+
+    // Largest UDP payload the path carries, larger datagrams are dropped.
+    // 0 means unlimited
+    uint32_t mtu_bytes = 1500;
+};
+
+struct SimLinkStats {
+    uint64_t packets_sent = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t packets_delivered = 0;
+    uint64_t bytes_delivered = 0;
+    uint64_t packets_lost = 0;         // random loss
+    uint64_t packets_queue_dropped = 0;
+    uint64_t packets_too_big = 0;
+    uint64_t packets_reordered = 0;
+};
+
+/**
+ * @brief Delay, jitter, loss, reordering, bandwidth and MTU model of one
+ * direction of a path.
+ *
+ * Random decisions come from a seeded std::mt19937_64 and are turned into
+ * numbers by hand rather than through <random> distributions, whose output
+ * is implementation-defined, so a seed gives the same run on every platform.
+ */
+class SimLink {
+public:
+    enum class Verdict {
+        kDelivered,
+        kLost,
+        kQueueFull,
+        kTooBig,
+    };
+
+    SimLink(const SimLinkConfig& config, uint64_t seed);
+
+    // Push a datagram of `bytes` into the link at `now_us`. On kDelivered,
+    // `arrival_us` is when it comes out of the far end.
+    Verdict Transmit(uint64_t now_us, uint32_t bytes, uint64_t& arrival_us);
+
+    const SimLinkConfig& GetConfig() const { return config_; }
+    const SimLinkStats& GetStats() const { return stats_; }
+
+private:
+    // uniform in [0, 1)
+    double NextUniform();
+
+private:
+    SimLinkConfig config_;
+    SimLinkStats stats_;
+    std::mt19937_64 rng_;
+
+    // when the bottleneck finishes serializing everything accepted so far
+    uint64_t busy_until_us_ = 0;
+    // arrival of the last in-order packet
+    uint64_t last_arrival_us_ = 0;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
@@ -0,0 +1,284 @@
+#include "common/log/log.h"
+#include "common/network/io_handle.h"
+#include "common/util/time.h"
+#include "quic/quicx/global_resource.h"
+
+#include "sim_network.h"
+
+namespace quicx {
+namespace quic {
+
+namespace {
+
+std::string LinkKey(const std::string& src_ip, const std::string& dst_ip) {
+    return src_ip + ">" + dst_ip;
+}
+
+// FNV-1a, so link seeds do not depend on std::hash
+uint64_t HashString(const std::string& str) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+}  // namespace
+
+SimNetwork::SimNetwork(std::shared_ptr<SimScheduler> scheduler, uint64_t seed):
+    scheduler_(scheduler),
+    seed_(seed) {}
+
+SimNetwork::~SimNetwork() {}
+
+void SimNetwork::SetDefaultLink(const SimLinkConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    default_link_ = config;
+}
+
+void SimNetwork::SetLink(const std::string& src_ip, const std::string& dst_ip, const SimLinkConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    link_configs_[LinkKey(src_ip, dst_ip)] = config;
+}
+
+void SimNetwork::SetEphemeralIp(const std::string& ip) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ephemeral_ip_ = ip;
+}
+
+bool SimNetwork::Bind(int32_t fd, const common::Address& addr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto key = addr.AsString();
+    if (addr_to_fd_.count(key) || fd_to_addr_.count(fd)) {
+        LOG_ERROR("sim bind failed, address in use. addr:%s, fd:%d", key.c_str(), fd);
+        return false;
+    }
+    fd_to_addr_[fd] = addr;
+    addr_to_fd_[key] = fd;
+    return true;
+}
+
+common::Address SimNetwork::LocalAddress(int32_t fd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return LocalAddressLocked(fd);
+}
+
+common::Address SimNetwork::LocalAddressLocked(int32_t fd) {
+    auto iter = fd_to_addr_.find(fd);
+    if (iter != fd_to_addr_.end()) {
+        return iter->second;
+    }
+    common::Address addr(ephemeral_ip_, next_ephemeral_port_);
+    while (addr_to_fd_.count(addr.AsString())) {
+        addr.SetPort(++next_ephemeral_port_);
+    }
+    next_ephemeral_port_++;
+    fd_to_addr_[fd] = addr;
+    addr_to_fd_[addr.AsString()] = fd;
+    return addr;
+}
+
+void SimNetwork::Attach(int32_t fd, std::shared_ptr<common::IEventLoop> loop,
+    std::shared_ptr<IPacketReceiver> receiver, bool ecn_enabled) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LocalAddressLocked(fd);
+    Endpoint& endpoint = endpoints_[fd];
+    endpoint.loop = loop;
+    endpoint.receiver = receiver;
+    endpoint.ecn_enabled = ecn_enabled;
+}
+
+void SimNetwork::Detach(int32_t fd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    endpoints_.erase(fd);
+    auto iter = fd_to_addr_.find(fd);
+    if (iter != fd_to_addr_.end()) {
+        addr_to_fd_.erase(iter->second.AsString());
+        fd_to_addr_.erase(iter);
+    }
+}
+
+void SimNetwork::Transmit(
+    int32_t src_fd, const common::Address& dst, const uint8_t* data, uint32_t len, uint8_t ecn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    common::Address src = LocalAddressLocked(src_fd);
+    SimLink& link = GetLinkLocked(src.GetIp(), dst.GetIp());
+
+    uint64_t arrival_us = 0;
+    if (link.Transmit(scheduler_->NowUs(), len, arrival_us) != SimLink::Verdict::kDelivered) {
+        return;
+    }
+
+    std::string bytes(reinterpret_cast<const char*>(data), len);
+    std::weak_ptr<SimNetwork> weak_self = shared_from_this();
+    scheduler_->ScheduleAt(arrival_us, [weak_self, src, dst, bytes, ecn]() {
+        if (auto self = weak_self.lock()) {
+            self->Deliver(src, dst, bytes, ecn);
+        }
+    });
+}
+
+void SimNetwork::Deliver(
+    const common::Address& src, const common::Address& dst, const std::string& data, uint8_t ecn) {
+    std::shared_ptr<common::IEventLoop> loop;
+    std::weak_ptr<IPacketReceiver> weak_receiver;
+    int32_t fd = -1;
+    bool ecn_enabled = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = addr_to_fd_.find(dst.AsString());
+        if (iter == addr_to_fd_.end()) {
+            // a socket bound to the wildcard address takes the datagram too
+            iter = addr_to_fd_.find(common::Address(dst.IsIPv6() ? "::" : "0.0.0.0", dst.GetPort()).AsString());
+        }
+        auto endpoint = iter == addr_to_fd_.end() ? endpoints_.end() : endpoints_.find(iter->second);
+        if (endpoint == endpoints_.end() || !(loop = endpoint->second.loop.lock())) {
+            undeliverable_++;
+            return;
+        }
+        fd = endpoint->first;
+        weak_receiver = endpoint->second.receiver;
+        ecn_enabled = endpoint->second.ecn_enabled;
+    }
+
+    loop->PostTask([weak_receiver, fd, src, data, ecn, ecn_enabled]() {
+        auto receiver = weak_receiver.lock();
+        if (!receiver) {
+            return;
+        }
+        auto pkt = GlobalResource::Instance().GetThreadLocalPacketAllotor()->Malloc();
+        pkt->GetData()->Write(reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
+        pkt->SetAddress(src);
+        pkt->SetSocket(fd);
+        pkt->SetTime(common::UTCTimeMsec());
+        pkt->SetEcn(ecn_enabled ? ecn : 0);
+        receiver->OnPacket(pkt);
+    });
+}
+
+SimLink& SimNetwork::GetLinkLocked(const std::string& src_ip, const std::string& dst_ip) {
+    auto key = LinkKey(src_ip, dst_ip);
+    auto iter = links_.find(key);
+    if (iter != links_.end()) {
+        return *iter->second;
+    }
+    auto config = link_configs_.find(key);
+    uint64_t seed = seed_ ^ HashString(key);
+    std::unique_ptr<SimLink> link(
+        new SimLink(config != link_configs_.end() ? config->second : default_link_, seed));
+    SimLink& ref = *link;
+    links_[key] = std::move(link);
+    return ref;
+}
+
+SimLinkStats SimNetwork::GetLinkStats(const std::string& src_ip, const std::string& dst_ip) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = links_.find(LinkKey(src_ip, dst_ip));
+    return iter != links_.end() ? iter->second->GetStats() : SimLinkStats();
+}
+
+SimLinkStats SimNetwork::GetTotalStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SimLinkStats total;
+    for (auto& entry : links_) {
+        const SimLinkStats& stats = entry.second->GetStats();
+        total.packets_sent += stats.packets_sent;
+        total.bytes_sent += stats.bytes_sent;
+        total.packets_delivered += stats.packets_delivered;
+        total.bytes_delivered += stats.bytes_delivered;
+        total.packets_lost += stats.packets_lost;
+        total.packets_queue_dropped += stats.packets_queue_dropped;
+        total.packets_too_big += stats.packets_too_big;
+        total.packets_reordered += stats.packets_reordered;
+    }
+    return total;
+}
+
+uint64_t SimNetwork::GetUndeliverable() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return undeliverable_;
+}
+
+SimSender::SimSender(std::shared_ptr<SimNetwork> network, int32_t sockfd):
+    network_(network),
+    sock_(sockfd) {}
+
+bool SimSender::Send(std::shared_ptr<NetPacket>& pkt) {
+    auto span = pkt->GetData()->GetReadableSpan();
+    auto sock = pkt->GetSocket() > 0 ? pkt->GetSocket() : sock_;
+    if (sock <= 0) {
+        LOG_ERROR(
+            "send packet to: %s, len: %d, sock: %d", pkt->GetAddress().AsString().c_str(), span.GetLength(), sock);
+        return false;
+    }
+    network_->Transmit(sock, pkt->GetAddress(), span.GetStart(), span.GetLength(), pkt->GetEcn());
+    return true;
+}
+
+uint32_t SimSender::SendBatch(std::vector<std::shared_ptr<NetPacket>>& batch) {
+    uint32_t sent = 0;
+    for (auto& pkt : batch) {
+        if (Send(pkt)) {
+            sent++;
+        }
+    }
+    return sent;
+}
+
+SimReceiver::SimReceiver(std::shared_ptr<SimNetwork> network, std::shared_ptr<common::IEventLoop> event_loop):
+    network_(network),
+    event_loop_(event_loop) {}
+
+SimReceiver::~SimReceiver() {
+    for (int32_t fd : fds_) {
+        network_->Detach(fd);
+    }
+    for (int32_t fd : owned_fds_) {
+        common::Close(fd);
+    }
+}
+
+bool SimReceiver::AddReceiver(int32_t socket_fd, std::shared_ptr<IPacketReceiver> receiver) {
+    auto loop = event_loop_.lock();
+    if (!loop) {
+        return false;
+    }
+    network_->Attach(socket_fd, loop, receiver, ecn_enabled_);
+    fds_.insert(socket_fd);
+    return true;
+}
+
+bool SimReceiver::AddReceiver(const std::string& ip, uint16_t port, std::shared_ptr<IPacketReceiver> receiver) {
+    auto loop = event_loop_.lock();
+    if (!loop) {
+        return false;
+    }
+    // a real but never bound socket, only used as the endpoint's identity
+    auto ret = common::UdpSocket();
+    if (ret.error_code_ != 0) {
+        LOG_ERROR("create udp socket failed. err:%d", ret.error_code_);
+        return false;
+    }
+    int32_t socket_fd = ret.return_value_;
+    if (!network_->Bind(socket_fd, common::Address(ip, port))) {
+        common::Close(socket_fd);
+        return false;
+    }
+    owned_fds_.insert(socket_fd);
+    return AddReceiver(socket_fd, receiver);
+}
+
+bool SimReceiver::RemoveReceiver(int32_t socket_fd) {
+    if (!fds_.erase(socket_fd)) {
+        return false;
+    }
+    network_->Detach(socket_fd);
+    if (owned_fds_.erase(socket_fd)) {
+        common::Close(socket_fd);
+    }
+    return true;
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,141 @@
+#ifndef TEST_SIMULATION_SIM_NETWORK
+#define TEST_SIMULATION_SIM_NETWORK
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/network/address.h"
+#include "quic/udp/if_receiver.h"
+#include "quic/udp/if_sender.h"
+#include <quicx/common/if_event_loop.h>
+
+#include "sim_link.h"
+#include "sim_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+/**
+ * @brief In-memory datagram network between simulated endpoints.
+ *
+ * Sockets are real fds (so code that inspects them keeps working) that never
+ * carry traffic; the network maps each one to a virtual address. A socket
+ * bound through SimReceiver::AddReceiver(ip, port) gets that address, any
+ * other one is given `ephemeral ip : next free port` the first time it sends
+ * or receives, the way the kernel binds an unbound UDP socket.
+ *
+ * Every (source ip, destination ip) pair has its own SimLink, configured with
+ * SetLink() or falling back to the default config, and seeded from the
+ * network seed and the two addresses. Arrivals are scheduled on the
+ * SimScheduler and handed to the receiver as a task posted to its loop.
+ */
+class SimNetwork:
+    public std::enable_shared_from_this<SimNetwork> {
+public:
+    SimNetwork(std::shared_ptr<SimScheduler> scheduler, uint64_t seed);
+    ~SimNetwork();
+
+    void SetDefaultLink(const SimLinkConfig& config);
+    // Only affects links not used yet.
+    void SetLink(const std::string& src_ip, const std::string& dst_ip, const SimLinkConfig& config);
+    void SetEphemeralIp(const std::string& ip);
+
+    // Bind `fd` to `addr`. Fails if another socket has the address.
+    bool Bind(int32_t fd, const common::Address& addr);
+    common::Address LocalAddress(int32_t fd);
+
+    // Deliver datagrams addressed to `fd` to `receiver` on `loop`.
+    void Attach(int32_t fd, std::shared_ptr<common::IEventLoop> loop, std::shared_ptr<IPacketReceiver> receiver,
+        bool ecn_enabled);
+    void Detach(int32_t fd);
+
+    // Send one datagram from `src_fd`. Drops are silent, as with UDP.
+    void Transmit(int32_t src_fd, const common::Address& dst, const uint8_t* data, uint32_t len, uint8_t ecn);
+
+    SimLinkStats GetLinkStats(const std::string& src_ip, const std::string& dst_ip);
+    SimLinkStats GetTotalStats();
+    // delivered by a link but no socket had the destination address
+    uint64_t GetUndeliverable();
+
+private:
+    struct Endpoint {
+        std::weak_ptr<common::IEventLoop> loop;
+        std::weak_ptr<IPacketReceiver> receiver;
+        bool ecn_enabled = false;
+    };
+
+    common::Address LocalAddressLocked(int32_t fd);
+    SimLink& GetLinkLocked(const std::string& src_ip, const std::string& dst_ip);
+    void Deliver(const common::Address& src, const common::Address& dst, const std::string& data, uint8_t ecn);
+
+private:
+    std::mutex mutex_;
+    std::shared_ptr<SimScheduler> scheduler_;
+    uint64_t seed_;
+
+    SimLinkConfig default_link_;
+    std::map<std::string, SimLinkConfig> link_configs_;
+    // ordered so stats and iteration never depend on hashing
+    std::map<std::string, std::unique_ptr<SimLink>> links_;
+
+    std::string ephemeral_ip_ = "10.0.0.2";
+    uint16_t next_ephemeral_port_ = 40000;
+
+    std::unordered_map<int32_t, common::Address> fd_to_addr_;
+    std::unordered_map<std::string, int32_t> addr_to_fd_;
+    std::unordered_map<int32_t, Endpoint> endpoints_;
+    uint64_t undeliverable_ = 0;
+};
+
+/**
+ * @brief ISender that hands datagrams to a SimNetwork.
+ */
+class SimSender:
+    public ISender {
+public:
+    SimSender(std::shared_ptr<SimNetwork> network, int32_t sockfd);
+
+    bool Send(std::shared_ptr<NetPacket>& pkt) override;
+    uint32_t SendBatch(std::vector<std::shared_ptr<NetPacket>>& batch) override;
+    int32_t GetSocket() const override { return sock_; }
+
+private:
+    std::shared_ptr<SimNetwork> network_;
+    int32_t sock_;
+};
+
+/**
+ * @brief IReceiver fed by a SimNetwork instead of socket reads.
+ */
+class SimReceiver:
+    public IReceiver {
+public:
+    SimReceiver(std::shared_ptr<SimNetwork> network, std::shared_ptr<common::IEventLoop> event_loop);
+    ~SimReceiver();
+
+    bool AddReceiver(int32_t socket_fd, std::shared_ptr<IPacketReceiver> receiver) override;
+    bool AddReceiver(const std::string& ip, uint16_t port, std::shared_ptr<IPacketReceiver> receiver) override;
+    bool RemoveReceiver(int32_t socket_fd) override;
+    void SetEcnEnabled(bool enabled) override { ecn_enabled_ = enabled; }
+    // datagrams are copied into the default packets of kPacketBufferSize
+    void SetMaxDatagramSize(uint32_t size) override {}
+
+private:
+    std::shared_ptr<SimNetwork> network_;
+    std::weak_ptr<common::IEventLoop> event_loop_;
+    bool ecn_enabled_ = false;
+    std::unordered_set<int32_t> fds_;
+    // created by AddReceiver(ip, port, ...), closed with the receiver
+    std::unordered_set<int32_t> owned_fds_;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
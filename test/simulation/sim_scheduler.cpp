@@ -0,0 +1,255 @@
+#include <algorithm>
+
+#include "common/log/log.h"
+#include "sim_scheduler.h"
+
+namespace quicx {
+namespace quic {
+
+// Detaches the loops of a thread when it exits. An event loop usually outlives
+// its thread (QuicClient joins the thread long before it drops the loop), and a
+// loop that still counted as running would stall the scheduler forever.
+struct SimThreadExitGuard {
+    std::vector<std::pair<std::weak_ptr<SimScheduler>, uint64_t>> loops;
+
+    ~SimThreadExitGuard() {
+        for (auto& entry : loops) {
+            if (auto scheduler = entry.first.lock()) {
+                scheduler->Detach(entry.second);
+            }
+        }
+    }
+};
+
+static thread_local SimThreadExitGuard thread_exit_guard_;
+
+SimScheduler::SimScheduler(uint64_t start_time_us):
+    now_us_(start_time_us) {}
+
+SimScheduler::~SimScheduler() {}
+
+uint64_t SimScheduler::NowUs() {
+    return now_us_.load(std::memory_order_relaxed);
+}
+
+void SimScheduler::ScheduleAt(uint64_t at_us, std::function<void()> fn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.emplace(std::make_pair(at_us, event_seq_++), std::move(fn));
+}
+
+void SimScheduler::RunFor(uint64_t duration_us) {
+    RunUntil(nullptr, duration_us);
+}
+
+bool SimScheduler::RunUntil(const std::function<bool()>& done, uint64_t max_duration_us) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    in_run_ = true;
+    uint64_t start = now_us_.load(std::memory_order_relaxed);
+    uint64_t end = (UINT64_MAX - start > max_duration_us) ? start + max_duration_us : UINT64_MAX;
+    bool finished = false;
+
+    while (true) {
+        all_parked_.wait(lock, [this]() { return running_ == 0; });
+
+        if (done) {
+            // done() may post to a loop, which only marks it woken while in_run_
+            lock.unlock();
+            finished = done();
+            lock.lock();
+            if (finished) {
+                break;
+            }
+        }
+
+        Loop* next = nullptr;
+        for (auto& loop : loops_) {
+            if (loop->state == LoopState::kParked && !loop->detached && loop->wake_pending) {
+                next = loop.get();
+                break;
+            }
+        }
+
+        uint64_t now = now_us_.load(std::memory_order_relaxed);
+        if (!next) {
+            uint64_t event_time = events_.empty() ? UINT64_MAX : events_.begin()->first.first;
+            uint64_t timer_time = UINT64_MAX;
+            for (auto& loop : loops_) {
+                if (loop->state == LoopState::kParked && !loop->detached && loop->deadline_us < timer_time) {
+                    timer_time = loop->deadline_us;
+                    next = loop.get();
+                }
+            }
+
+            uint64_t at = std::min(event_time, timer_time);
+            if (at == UINT64_MAX || at > end) {
+                if (end != UINT64_MAX && end > now) {
+                    now_us_.store(end, std::memory_order_relaxed);
+                }
+                break;
+            }
+            if (at > now) {
+                now = at;
+                now_us_.store(now, std::memory_order_relaxed);
+            }
+
+            if (event_time <= timer_time) {
+                auto iter = events_.begin();
+                auto fn = std::move(iter->second);
+                events_.erase(iter);
+                lock.unlock();
+                fn();
+                lock.lock();
+                continue;
+            }
+        }
+
+        if (spin_instant_us_ == now) {
+            if (++spin_count_ > kMaxSpinsPerInstant) {
+                LOG_WARN("SimScheduler: %u resumptions at t=%llu us, advancing the clock by %llu us", spin_count_,
+                    now, kSpinStepUs);
+                now_us_.store(now + kSpinStepUs, std::memory_order_relaxed);
+                spin_instant_us_ = now + kSpinStepUs;
+                spin_count_ = 0;
+            }
+        } else {
+            spin_instant_us_ = now;
+            spin_count_ = 1;
+        }
+        ResumeLocked(*next);
+    }
+
+    in_run_ = false;
+    return finished;
+}
+
+uint64_t SimScheduler::GetResumeCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resume_count_;
+}
+
+uint64_t SimScheduler::Register() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<Loop> loop(new Loop());
+    loop->id = next_loop_id_++;
+    loop->state = LoopState::kRunning;
+    running_++;
+    uint64_t id = loop->id;
+    loops_.push_back(std::move(loop));
+    thread_exit_guard_.loops.emplace_back(shared_from_this(), id);
+    return id;
+}
+
+void SimScheduler::Unregister(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = std::find_if(
+        loops_.begin(), loops_.end(), [id](const std::unique_ptr<Loop>& loop) { return loop->id == id; });
+    if (iter == loops_.end()) {
+        return;
+    }
+    if ((*iter)->state == LoopState::kRunning) {
+        running_--;
+    }
+    loops_.erase(iter);
+    all_parked_.notify_all();
+}
+
+void SimScheduler::Park(uint64_t id, int timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Loop* loop = FindLoop(id);
+    if (!loop) {
+        return;
+    }
+    if (loop->wake_pending) {
+        loop->wake_pending = false;
+        return;
+    }
+    if (!in_run_ && timeout_ms == 0) {
+        // time is frozen: a poll outside a run returns at once, like it would on the OS
+        return;
+    }
+
+    uint64_t now = now_us_.load(std::memory_order_relaxed);
+    loop->deadline_us = timeout_ms < 0 ? UINT64_MAX : now + static_cast<uint64_t>(timeout_ms) * 1000;
+    loop->state = LoopState::kParked;
+    running_--;
+    all_parked_.notify_all();
+    loop->resume.wait(lock, [loop]() { return loop->state == LoopState::kRunning; });
+}
+
+void SimScheduler::Wake(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Loop* loop = FindLoop(id);
+    if (!loop || loop->detached) {
+        return;
+    }
+    if (loop->state == LoopState::kParked && !in_run_) {
+        ResumeLocked(*loop);
+        return;
+    }
+    // running: its next Park() returns at once; parked in a run: picked next
+    loop->wake_pending = true;
+}
+
+void SimScheduler::Detach(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Loop* loop = FindLoop(id);
+    if (!loop) {
+        return;
+    }
+    if (loop->state == LoopState::kRunning) {
+        running_--;
+    }
+    loop->state = LoopState::kParked;
+    loop->detached = true;
+    all_parked_.notify_all();
+}
+
+SimScheduler::Loop* SimScheduler::FindLoop(uint64_t id) {
+    for (auto& loop : loops_) {
+        if (loop->id == id) {
+            return loop.get();
+        }
+    }
+    return nullptr;
+}
+
+void SimScheduler::ResumeLocked(Loop& loop) {
+    loop.state = LoopState::kRunning;
+    loop.wake_pending = false;
+    running_++;
+    resume_count_++;
+    loop.resume.notify_one();
+}
+
+SimEventDriver::SimEventDriver(std::shared_ptr<SimScheduler> scheduler):
+    scheduler_(scheduler) {}
+
+SimEventDriver::~SimEventDriver() {
+    if (id_ != 0) {
+        scheduler_->Unregister(id_);
+    }
+}
+
+bool SimEventDriver::Init() {
+    if (id_ == 0) {
+        id_ = scheduler_->Register();
+    }
+    return true;
+}
+
+int SimEventDriver::Wait(std::vector<common::Event>& events, int timeout_ms) {
+    (void)events;
+    if (id_ != 0) {
+        scheduler_->Park(id_, timeout_ms);
+    }
+    return 0;
+}
+
+void SimEventDriver::Wakeup() {
+    if (id_ != 0) {
+        scheduler_->Wake(id_);
+    }
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,144 @@
+#ifndef TEST_SIMULATION_SIM_SCHEDULER
+#define TEST_SIMULATION_SIM_SCHEDULER
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "common/network/if_event_driver.h"
+
+namespace quicx {
+namespace quic {
+
+class SimEventDriver;
+
+/**
+ * @brief Virtual clock and lockstep scheduler for full-stack simulation.
+ *
+ * Every event loop created while a simulation is active gets a SimEventDriver.
+ * Its Wait() does not block on the OS: it parks the loop thread here and hands
+ * control back to the scheduler. The scheduler only moves on once every loop
+ * is parked, so exactly one loop thread runs at a time, and it advances the
+ * virtual clock straight to the next thing that can happen:
+ *
+ *   1. a loop that was woken (PostTask/Wakeup) runs first, clock unchanged;
+ *   2. otherwise the earliest of the pending network events and the loops'
+ *      timer deadlines is taken and the clock jumps to it.
+ *
+ * Ties are broken by registration order and event sequence number, so a run
+ * is a pure function of its inputs and the seed of the link model.
+ *
+ * Time only advances inside RunFor()/RunUntil(), which must be called from a
+ * thread that owns no event loop. Outside of them a woken loop runs at once at
+ * the frozen time, which keeps blocking setup and teardown calls (Init, Start,
+ * Stop/Join) working from the test thread.
+ */
+class SimScheduler:
+    public std::enable_shared_from_this<SimScheduler> {
+public:
+    explicit SimScheduler(uint64_t start_time_us);
+    ~SimScheduler();
+
+    uint64_t NowUs();
+
+    // Run `fn` on the controller thread at virtual time `at_us`. Used by the
+    // link model for packet arrivals; fn must not block.
+    void ScheduleAt(uint64_t at_us, std::function<void()> fn);
+
+    // Advance virtual time by `duration_us`, running everything due meanwhile.
+    void RunFor(uint64_t duration_us);
+    // Run until `done` returns true (checked whenever all loops are parked) or
+    // `max_duration_us` of virtual time passed. Returns the final value of done().
+    bool RunUntil(const std::function<bool()>& done, uint64_t max_duration_us);
+
+    // Number of loop resumptions, for tests and run summaries.
+    uint64_t GetResumeCount();
+
+    // More resumptions than this at one instant means some loop is polling
+    // with a zero timeout; the clock is then nudged forward by kSpinStepUs.
+    static constexpr uint32_t kMaxSpinsPerInstant = 10000;
+    static constexpr uint64_t kSpinStepUs = 1000;
+
+private:
+    friend class SimEventDriver;
+    friend struct SimThreadExitGuard;
+
+    enum class LoopState { kRunning, kParked };
+    struct Loop {
+        uint64_t id = 0;
+        LoopState state = LoopState::kRunning;
+        uint64_t deadline_us = UINT64_MAX;
+        bool wake_pending = false;
+        // the loop thread exited; never resumed again
+        bool detached = false;
+        std::condition_variable resume;
+    };
+
+    // Called on the loop thread from the driver's Init(); the loop counts as
+    // running until its first Park().
+    uint64_t Register();
+    void Unregister(uint64_t id);
+    // Called on the loop thread; blocks until the scheduler resumes it.
+    void Park(uint64_t id, int timeout_ms);
+    void Wake(uint64_t id);
+    // The loop thread is gone (its event loop may outlive it).
+    void Detach(uint64_t id);
+
+    Loop* FindLoop(uint64_t id);
+    void ResumeLocked(Loop& loop);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable all_parked_;
+    std::atomic<uint64_t> now_us_;
+    bool in_run_ = false;
+    uint32_t running_ = 0;
+    uint64_t resume_count_ = 0;
+    uint64_t next_loop_id_ = 1;
+
+    // in registration order, which is the tie-break order
+    std::vector<std::unique_ptr<Loop>> loops_;
+
+    // (time, sequence) -> event
+    std::map<std::pair<uint64_t, uint64_t>, std::function<void()>> events_;
+    uint64_t event_seq_ = 0;
+
+    uint64_t spin_instant_us_ = 0;
+    uint32_t spin_count_ = 0;
+};
+
+/**
+ * @brief IEventDriver that parks in a SimScheduler instead of the OS.
+ *
+ * Socket fds are accepted and ignored: in simulation no fd ever becomes
+ * readable, packets are handed to the receivers through posted tasks.
+ */
+class SimEventDriver:
+    public common::IEventDriver {
+public:
+    explicit SimEventDriver(std::shared_ptr<SimScheduler> scheduler);
+    ~SimEventDriver() override;
+
+    bool Init() override;
+    bool AddFd(int32_t fd, int32_t events) override { return true; }
+    bool RemoveFd(int32_t fd) override { return true; }
+    bool ModifyFd(int32_t fd, int32_t events) override { return true; }
+    int Wait(std::vector<common::Event>& events, int timeout_ms = -1) override;
+    int GetMaxEvents() const override { return 1; }
+    void Wakeup() override;
+
+private:
+    std::shared_ptr<SimScheduler> scheduler_;
+    uint64_t id_ = 0;
+};
+
+}  // namespace quic
+}  // namespace quicx
+
+#endif
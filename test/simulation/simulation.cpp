@@ -0,0 +1,77 @@
+#include <atomic>
+#include <cstdlib>
+
+#include "common/log/log.h"
+#include "common/util/time.h"
+
+#include "simulation.h"
+
+namespace quicx {
+namespace quic {
+
+static std::atomic<SimScheduler*> active_scheduler_{nullptr};
+
+Simulation::Simulation(uint64_t seed, uint64_t start_time_us):
+    scheduler_(std::make_shared<SimScheduler>(start_time_us)),
+    network_(std::make_shared<SimNetwork>(scheduler_, seed)) {
+    SimScheduler* expected = nullptr;
+    if (!active_scheduler_.compare_exchange_strong(expected, scheduler_.get())) {
+        LOG_FATAL("only one Simulation may exist at a time");
+        std::abort();
+    }
+    // the destructor does not run if the constructor throws, so a half
+    // installed set of hooks is removed here
+    try {
+        common::SetUTCClockForTest(&Simulation::Clock);
+
+        auto scheduler = scheduler_;
+        auto network = network_;
+        common::IEventDriver::SetFactoryForTest([scheduler]() -> std::unique_ptr<common::IEventDriver> {
+            return std::unique_ptr<common::IEventDriver>(new SimEventDriver(scheduler));
+        });
+        ISender::SetFactoryForTest([network](int32_t sockfd) -> std::shared_ptr<ISender> {
+            return std::make_shared<SimSender>(network, sockfd);
+        });
+        IReceiver::SetFactoryForTest([network](std::shared_ptr<common::IEventLoop> loop) -> std::shared_ptr<IReceiver> {
+            return std::make_shared<SimReceiver>(network, loop);
+        });
+    } catch (...) {
+        RemoveHooks();
+        throw;
+    }
+}
+
+Simulation::~Simulation() {
+    RemoveHooks();
+}
+
+void Simulation::RemoveHooks() {
+    IReceiver::SetFactoryForTest(nullptr);
+    ISender::SetFactoryForTest(nullptr);
+    common::IEventDriver::SetFactoryForTest(nullptr);
+    common::SetUTCClockForTest(nullptr);
+    active_scheduler_.store(nullptr);
+}
+
+void Simulation::SetLink(const SimLinkConfig& config) {
+    network_->SetDefaultLink(config);
+}
+
+void Simulation::SetLink(const std::string& src_ip, const std::string& dst_ip, const SimLinkConfig& config) {
+    network_->SetLink(src_ip, dst_ip, config);
+}
+
+void Simulation::RunFor(uint64_t duration_ms) {
+    scheduler_->RunFor(duration_ms * 1000);
+}
+
+bool Simulation::RunUntil(const std::function<bool()>& done, uint64_t max_duration_ms) {
+    return scheduler_->RunUntil(done, max_duration_ms * 1000);
+}
+
+uint64_t Simulation::Clock() {
+    return active_scheduler_.load(std::memory_order_relaxed)->NowUs();
+}
+
+}  // namespace quic
+}  // namespace quicx
@@ -8,6 +8,7 @@
 
 #include "common/alloter/pool_block.h"
 #include "common/buffer/buffer_chunk.h"
+#include "common/buffer/external_buffer_chunk.h"
 #include "common/buffer/multi_block_buffer.h"
 #include "common/buffer/shared_buffer_span.h"
 #include "common/buffer/single_block_buffer.h"
@@ -1034,6 +1035,35 @@ TEST(MultiBlockBufferTest, EmptyBufferOperations) {
     buffer.Clear();  // Should not crash
 }
 
+// Test: caller memory is chained in place, never written into, and released
+// with its last span
+TEST(MultiBlockBufferTest, ExternalChunkChainedWithoutCopy) {
+    auto pool = MakePool();
+    MultiBlockBuffer buffer(pool, false);
+
+    std::vector<uint8_t> payload(200, 'E');
+    bool released = false;
+    {
+        auto chunk = std::make_shared<ExternalBufferChunk>(payload.data(), payload.size(), [&]() { released = true; });
+        EXPECT_EQ(chunk->GetWriteFloor(), chunk->GetData() + payload.size());
+        EXPECT_EQ(200u, buffer.Write(SharedBufferSpan(chunk, chunk->GetData(), 200u)));
+    }
+    const uint8_t tail[] = {'a', 'b', 'c'};
+    EXPECT_EQ(3u, buffer.Write(tail, sizeof(tail)));
+    EXPECT_EQ(2u, buffer.GetChunkCount());
+    EXPECT_EQ(203u, buffer.GetDataLength());
+    EXPECT_EQ(std::vector<uint8_t>(200, 'E'), payload);
+
+    // zero-copy: the first readable span is the caller's memory
+    auto span = buffer.GetFirstChunkReadable(100);
+    EXPECT_EQ(span.GetStart(), payload.data());
+
+    buffer.MoveReadPt(203);
+    EXPECT_FALSE(released);
+    span = SharedBufferSpan();
+    EXPECT_TRUE(released);
+}
+
 }
 }
 }
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "common/network/io_handle.h"
+#include "common/network/socket_family_cache.h"
+
+namespace quicx {
+namespace common {
+namespace {
+
+TEST(socket_family_cache_utest, ecn_codepoint_per_socket) {
+    auto sock = UdpSocket4();
+    ASSERT_GE(sock.return_value_, 0);
+    EXPECT_EQ(GetSocketFamily(sock.return_value_), sock.family_);
+    EXPECT_EQ(GetSocketEcnCodepoint(sock.return_value_), 0u);
+
+    ApplySocketEcnCodepoint(sock.return_value_, 0x01);
+    EXPECT_EQ(GetSocketEcnCodepoint(sock.return_value_), 0x01);
+    // setting the family again keeps the codepoint
+    RememberSocketFamily(sock.return_value_, sock.family_);
+    EXPECT_EQ(GetSocketEcnCodepoint(sock.return_value_), 0x01);
+
+    ApplySocketEcnCodepoint(sock.return_value_, 0x02);
+    EXPECT_EQ(GetSocketEcnCodepoint(sock.return_value_), 0x02);
+    Close(sock.return_value_);
+}
+
+TEST(socket_family_cache_utest, close_forgets_ecn_codepoint) {
+    auto sock = UdpSocket4();
+    ASSERT_GE(sock.return_value_, 0);
+    ApplySocketEcnCodepoint(sock.return_value_, 0x01);
+    int32_t fd = sock.return_value_;
+    Close(fd);
+    EXPECT_EQ(GetSocketEcnCodepoint(fd), 0u);
+    EXPECT_EQ(GetSocketFamily(fd), 0);
+
+    // the lowest free fd comes back: it starts out as Not-ECT again, so the
+    // next ECT(1) packet on it sets the option instead of skipping it
+    auto reused = UdpSocket4();
+    ASSERT_GE(reused.return_value_, 0);
+    EXPECT_EQ(GetSocketEcnCodepoint(reused.return_value_), 0u);
+    ApplySocketEcnCodepoint(reused.return_value_, 0x01);
+    EXPECT_EQ(GetSocketEcnCodepoint(reused.return_value_), 0x01);
+    Close(reused.return_value_);
+}
+
+}  // namespace
+}  // namespace common
+}  // namespace quicx
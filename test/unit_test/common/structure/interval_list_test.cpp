@@ -0,0 +1,80 @@
+#include "common/structure/interval_list.h"
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace quicx {
+namespace common {
+
+static std::vector<std::pair<uint64_t, uint64_t>> Dump(const IntervalList& list) {
+    std::vector<std::pair<uint64_t, uint64_t>> out;
+    for (const auto& interval : list) {
+        out.emplace_back(interval.start, interval.end);
+    }
+    return out;
+}
+
+TEST(IntervalListTest, AppendsAndExtendsTail) {
+    IntervalList list;
+    EXPECT_TRUE(list.IsEmpty());
+
+    list.Insert(0, 10);
+    list.Insert(10, 20);  // abuts
+    list.Insert(15, 25);  // overlaps
+    list.Insert(30, 40);  // new tail
+    EXPECT_EQ(Dump(list), (std::vector<std::pair<uint64_t, uint64_t>>{{0, 25}, {30, 40}}));
+
+    // empty ranges are ignored
+    list.Insert(50, 50);
+    EXPECT_EQ(list.Size(), 2u);
+}
+
+TEST(IntervalListTest, OutOfOrderInsertMerges) {
+    IntervalList list;
+    list.Insert(100, 110);
+    list.Insert(120, 130);
+    list.Insert(140, 150);
+
+    list.Insert(50, 60);  // before everything
+    EXPECT_EQ(list.Size(), 4u);
+    EXPECT_EQ(list.Front().start, 50u);
+
+    list.Insert(105, 145);  // bridges three ranges
+    EXPECT_EQ(Dump(list), (std::vector<std::pair<uint64_t, uint64_t>>{{50, 60}, {100, 150}}));
+
+    list.Insert(70, 80);  // lands in a gap
+    EXPECT_EQ(Dump(list), (std::vector<std::pair<uint64_t, uint64_t>>{{50, 60}, {70, 80}, {100, 150}}));
+}
+
+TEST(IntervalListTest, LookupAndContains) {
+    IntervalList list;
+    list.Insert(10, 20);
+    list.Insert(30, 40);
+
+    EXPECT_EQ(list.FindEndingAfter(0)->start, 10u);
+    EXPECT_EQ(list.FindEndingAfter(15)->start, 10u);
+    EXPECT_EQ(list.FindEndingAfter(20)->start, 30u);
+    EXPECT_TRUE(list.FindEndingAfter(40) == list.end());
+
+    EXPECT_TRUE(list.Contains(10, 20));
+    EXPECT_TRUE(list.Contains(32, 35));
+    EXPECT_FALSE(list.Contains(15, 35));
+    EXPECT_FALSE(list.Contains(20, 30));
+}
+
+TEST(IntervalListTest, TrimBelow) {
+    IntervalList list;
+    list.Insert(10, 20);
+    list.Insert(30, 40);
+    list.Insert(50, 60);
+
+    list.TrimBelow(35);
+    EXPECT_EQ(Dump(list), (std::vector<std::pair<uint64_t, uint64_t>>{{35, 40}, {50, 60}}));
+    list.TrimBelow(60);
+    EXPECT_TRUE(list.IsEmpty());
+}
+
+}  // namespace common
+}  // namespace quicx
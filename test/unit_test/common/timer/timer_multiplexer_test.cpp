@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "common/timer/timer_multiplexer.h"
+#include "common/timer/timing_wheel_timer.h"
+#include "common/util/time.h"
+
+namespace quicx {
+namespace common {
+namespace {
+
+// Forwards to a wheel and counts how often the multiplexer touches it.
+class CountingTimer: public ITimer {
+public:
+    uint64_t AddTimer(TimerTask& task, uint32_t time, uint64_t now = 0) override { return wheel_.AddTimer(task, time, now); }
+    bool RemoveTimer(TimerTask& task) override { return wheel_.RemoveTimer(task); }
+    void ArmTimer(TimerNode& node, uint32_t time, uint64_t now = 0) override {
+        arm_count++;
+        wheel_.ArmTimer(node, time, now);
+    }
+    bool DisarmTimer(TimerNode& node) override {
+        disarm_count++;
+        return wheel_.DisarmTimer(node);
+    }
+    int32_t MinTime(uint64_t now = 0) override { return wheel_.MinTime(now); }
+    void TimerRun(uint64_t now = 0) override { wheel_.TimerRun(now); }
+    bool Empty() override { return wheel_.Empty(); }
+
+    uint32_t arm_count = 0;
+    uint32_t disarm_count = 0;
+
+private:
+    TimingWheelTimer wheel_;
+};
+
+class TimerMultiplexerTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        now_ = UTCTimeMsec();
+        shared_ = std::make_shared<CountingTimer>();
+        shared_->TimerRun(now_);
+        mux_ = std::make_shared<TimerMultiplexer>(shared_);
+    }
+
+    uint64_t now_;
+    std::shared_ptr<CountingTimer> shared_;
+    std::shared_ptr<TimerMultiplexer> mux_;
+};
+
+TEST_F(TimerMultiplexerTest, OneEntryAtEarliestDeadline) {
+    std::vector<int> fired;
+    TimerNode pto([&] { fired.push_back(0); });
+    TimerNode ack([&] { fired.push_back(1); });
+    TimerNode idle([&] { fired.push_back(2); });
+
+    mux_->ArmTimer(pto, 100, now_);
+    mux_->ArmTimer(idle, 5000, now_);
+    mux_->ArmTimer(ack, 25, now_);
+    EXPECT_EQ(3u, mux_->GetArmedCount());
+    EXPECT_EQ(25, shared_->MinTime(now_));
+    EXPECT_EQ(2u, shared_->arm_count);
+
+    // re-arming later deadlines never touches the shared timer
+    for (uint32_t i = 1; i <= 100; i++) {
+        mux_->ArmTimer(pto, 100, now_ + i);
+        mux_->ArmTimer(idle, 5000, now_ + i);
+    }
+    EXPECT_EQ(2u, shared_->arm_count);
+
+    shared_->TimerRun(now_ + 25);
+    EXPECT_EQ((std::vector<int>{1}), fired);
+    EXPECT_EQ(200 - 25, shared_->MinTime(now_ + 25));
+
+    shared_->TimerRun(now_ + 200);
+    EXPECT_EQ((std::vector<int>{1, 0}), fired);
+    EXPECT_EQ(1u, mux_->GetArmedCount());
+    EXPECT_EQ(5100 - 200, shared_->MinTime(now_ + 200));
+}
+
+TEST_F(TimerMultiplexerTest, DisarmLeavesEntryUntilLastNode) {
+    int fired = 0;
+    TimerNode early([&] { fired++; });
+    TimerNode late([&] { fired++; });
+
+    mux_->ArmTimer(early, 10, now_);
+    mux_->ArmTimer(late, 50, now_);
+    EXPECT_TRUE(mux_->DisarmTimer(early));
+    EXPECT_FALSE(mux_->DisarmTimer(early));
+    EXPECT_EQ(0u, shared_->disarm_count);
+
+    // the stale entry fires with nothing due and moves to the next deadline
+    shared_->TimerRun(now_ + 10);
+    EXPECT_EQ(0, fired);
+    EXPECT_TRUE(mux_->IsEntryArmed());
+    EXPECT_EQ(40, shared_->MinTime(now_ + 10));
+
+    EXPECT_TRUE(mux_->DisarmTimer(late));
+    EXPECT_FALSE(mux_->IsEntryArmed());
+    EXPECT_TRUE(shared_->Empty());
+}
+
+TEST_F(TimerMultiplexerTest, CallbacksMayRearmAndDisarm) {
+    int fired_a = 0;
+    int fired_b = 0;
+    TimerNode b([&] { fired_b++; });
+    TimerNode a([&] {
+        fired_a++;
+        mux_->DisarmTimer(b);
+        if (fired_a < 3) {
+            mux_->ArmTimer(a, 10, now_ + 10 * fired_a);
+        }
+    });
+
+    mux_->ArmTimer(a, 10, now_);
+    mux_->ArmTimer(b, 10, now_);
+    for (uint64_t t = now_; t <= now_ + 100; t++) {
+        shared_->TimerRun(t);
+    }
+    EXPECT_EQ(3, fired_a);
+    EXPECT_EQ(0, fired_b);
+    EXPECT_EQ(0u, mux_->GetArmedCount());
+    EXPECT_TRUE(shared_->Empty());
+}
+
+TEST_F(TimerMultiplexerTest, LifetimeOfNodesAndMultiplexer) {
+    {
+        TimerNode scoped([] {});
+        mux_->ArmTimer(scoped, 10, now_);
+    }
+    EXPECT_EQ(0u, mux_->GetArmedCount());
+    EXPECT_TRUE(shared_->Empty());
+
+    TimerNode node([] {});
+    mux_->ArmTimer(node, 10, now_);
+    mux_.reset();
+    EXPECT_FALSE(node.IsArmed());
+    EXPECT_TRUE(shared_->Empty());
+}
+
+}  // namespace
+}  // namespace common
+}  // namespace quicx
@@ -931,6 +931,120 @@ TEST(timing_wheel_timer_utest, bitmap_stress_random_remove_forces_rescan) {
     EXPECT_EQ(-1, tw.MinTime(now));
 }
 
+// ---- TimerNode (intrusive) --------------------------------------------------
+
+TEST(timing_wheel_timer_utest, node_rearm_moves_single_entry) {
+    int fired = 0;
+    TimerNode node([&]{ ++fired; });
+    TimingWheelTimer tw;
+    uint64_t now = Now();
+    tw.TimerRun(now);
+
+    tw.ArmTimer(node, 10, now);
+    tw.ArmTimer(node, 300, now);   // L1
+    tw.ArmTimer(node, 50, now);    // back to L0
+    EXPECT_TRUE(node.IsArmed());
+    EXPECT_EQ(now + 50, node.GetDeadline());
+    EXPECT_EQ(50, tw.MinTime(now));
+
+    tw.TimerRun(now + 49);
+    EXPECT_EQ(0, fired);
+    tw.TimerRun(now + 50);
+    EXPECT_EQ(1, fired);
+    EXPECT_FALSE(node.IsArmed());
+    EXPECT_TRUE(tw.Empty());
+
+    // re-arm after firing, then disarm
+    tw.ArmTimer(node, 20, now + 50);
+    EXPECT_TRUE(tw.DisarmTimer(node));
+    EXPECT_FALSE(tw.DisarmTimer(node));
+    tw.TimerRun(now + 100);
+    EXPECT_EQ(1, fired);
+    EXPECT_TRUE(tw.Empty());
+}
+
+TEST(timing_wheel_timer_utest, node_across_levels_fires_on_time) {
+    std::vector<uint64_t> fired_at;
+    uint64_t now = Now();
+    uint64_t tick = now;
+    TimerNode short_node([&]{ fired_at.push_back(tick); });
+    TimerNode l1_node([&]{ fired_at.push_back(tick); });
+    TimerNode l2_node([&]{ fired_at.push_back(tick); });
+    TimingWheelTimer tw;
+    tw.TimerRun(now);
+
+    tw.ArmTimer(l2_node, 20000, now);
+    tw.ArmTimer(l1_node, 1000, now);
+    tw.ArmTimer(short_node, 5, now);
+    EXPECT_EQ(5, tw.MinTime(now));
+
+    for (tick = now; tick <= now + 20000; tick += 5) {
+        tw.TimerRun(tick);
+    }
+    EXPECT_EQ((std::vector<uint64_t>{now + 5, now + 1000, now + 20000}), fired_at);
+    EXPECT_TRUE(tw.Empty());
+}
+
+TEST(timing_wheel_timer_utest, node_disarmed_by_earlier_callback_in_same_slot) {
+    int fired_b = 0;
+    TimerNode b([&]{ ++fired_b; });
+    TimingWheelTimer tw;
+    TimerNode a([&]{ tw.DisarmTimer(b); });
+    uint64_t now = Now();
+    tw.TimerRun(now);
+
+    tw.ArmTimer(a, 10, now);
+    tw.ArmTimer(b, 10, now);
+    tw.TimerRun(now + 10);
+    EXPECT_EQ(0, fired_b);
+    EXPECT_TRUE(tw.Empty());
+    EXPECT_EQ(-1, tw.MinTime(now + 10));
+}
+
+TEST(timing_wheel_timer_utest, node_and_task_share_the_wheel) {
+    int fired_node = 0, fired_task = 0;
+    TimerNode node([&]{ ++fired_node; });
+    TimerTask task([&]{ ++fired_task; });
+    TimingWheelTimer tw;
+    uint64_t now = Now();
+    tw.TimerRun(now);
+
+    tw.ArmTimer(node, 30, now);
+    ASSERT_NE(0u, tw.AddTimer(task, 20, now));
+    EXPECT_EQ(20, tw.MinTime(now));
+    EXPECT_TRUE(tw.RemoveTimer(task));
+    EXPECT_EQ(30, tw.MinTime(now));
+
+    tw.TimerRun(now + 30);
+    EXPECT_EQ(1, fired_node);
+    EXPECT_EQ(0, fired_task);
+}
+
+TEST(timing_wheel_timer_utest, node_lifetime_against_wheel) {
+    TimingWheelTimer tw;
+    uint64_t now = Now();
+    {
+        TimerNode scoped([]{});
+        tw.ArmTimer(scoped, 100, now);
+        EXPECT_FALSE(tw.Empty());
+    }
+    // destroying an armed node disarms it
+    EXPECT_TRUE(tw.Empty());
+
+    TimerNode node([]{});
+    {
+        TimingWheelTimer short_lived;
+        short_lived.ArmTimer(node, 100, now);
+        // arming in another timer moves the node there
+        tw.ArmTimer(node, 100, now);
+        EXPECT_FALSE(tw.Empty());
+        short_lived.ArmTimer(node, 100, now);
+        EXPECT_TRUE(tw.Empty());
+    }
+    // the wheel went away first and let go of the node
+    EXPECT_FALSE(node.IsArmed());
+}
+
 }  // namespace
 }  // namespace common
 }  // namespace quicx
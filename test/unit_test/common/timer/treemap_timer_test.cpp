@@ -2,6 +2,7 @@
 
 #include "common/util/time.h"
 #include "common/timer/timer.h"
+#include "common/timer/treemap_timer.h"
 
 namespace quicx {
 namespace common {
@@ -144,6 +145,29 @@ TEST(treemap_timer_utest, timerrun3) {
     EXPECT_TRUE(timer->Empty());
 }
 
+TEST(treemap_timer_utest, timer_node) {
+    int fired_a = 0, fired_b = 0;
+    TreeMapTimer timer;
+    TimerNode b([&] { ++fired_b; });
+    TimerNode a([&] {
+        ++fired_a;
+        timer.DisarmTimer(b);
+    });
+    uint64_t now = UTCTimeMsec();
+
+    timer.ArmTimer(a, 50, now);
+    timer.ArmTimer(a, 20, now);
+    timer.ArmTimer(b, 20, now);
+    EXPECT_EQ(20, timer.MinTime(now));
+
+    // a fires first and disarms b while it waits in the same batch
+    timer.TimerRun(now + 20);
+    EXPECT_EQ(1, fired_a);
+    EXPECT_EQ(0, fired_b);
+    EXPECT_FALSE(b.IsArmed());
+    EXPECT_TRUE(timer.Empty());
+}
+
+}
 }
 }
-}
\ No newline at end of file
@@ -19,9 +19,10 @@ TEST_F(DynamicTableTest, InsertAndLookup) {
     EXPECT_TRUE(table_->AddHeaderItem("content-type", "application/json"));
     
     // Look up the inserted field
-    auto item = table_->FindHeaderItem(0);
-    EXPECT_EQ(item->name_, "content-type");
-    EXPECT_EQ(item->value_, "application/json");
+    HeaderItem item;
+    ASSERT_TRUE(table_->FindHeaderItem(0, item));
+    EXPECT_EQ(item.name_, "content-type");
+    EXPECT_EQ(item.value_, "application/json");
 }
 
 TEST_F(DynamicTableTest, InsertMultipleEntries) {
@@ -30,17 +31,18 @@ TEST_F(DynamicTableTest, InsertMultipleEntries) {
     EXPECT_TRUE(table_->AddHeaderItem("accept", "*/*"));
 
     // Verify all entries can be looked up correctly
-    auto item = table_->FindHeaderItem(0);
-    EXPECT_EQ(item->name_, "accept");
-    EXPECT_EQ(item->value_, "*/*");
-
-    item = table_->FindHeaderItem(1);
-    EXPECT_EQ(item->name_, "cache-control");
-    EXPECT_EQ(item->value_, "no-cache");
-
-    item = table_->FindHeaderItem(2);
-    EXPECT_EQ(item->name_, "content-type");
-    EXPECT_EQ(item->value_, "application/json");
+    HeaderItem item;
+    ASSERT_TRUE(table_->FindHeaderItem(0, item));
+    EXPECT_EQ(item.name_, "accept");
+    EXPECT_EQ(item.value_, "*/*");
+
+    ASSERT_TRUE(table_->FindHeaderItem(1, item));
+    EXPECT_EQ(item.name_, "cache-control");
+    EXPECT_EQ(item.value_, "no-cache");
+
+    ASSERT_TRUE(table_->FindHeaderItem(2, item));
+    EXPECT_EQ(item.name_, "content-type");
+    EXPECT_EQ(item.value_, "application/json");
 }
 
 TEST_F(DynamicTableTest, CapacityEviction) {
@@ -54,14 +56,15 @@ TEST_F(DynamicTableTest, CapacityEviction) {
     EXPECT_TRUE(table_->AddHeaderItem("header4", "value4")); // ~32 bytes
 
     // Verify old entries are evicted
-    auto item = table_->FindHeaderItem(0);
-    EXPECT_EQ(item->name_, "header4");
-    EXPECT_EQ(item->value_, "value4");
-    item = table_->FindHeaderItem(1);
-    EXPECT_EQ(item->name_, "header3");
-    EXPECT_EQ(item->value_, "value3");
-    EXPECT_EQ(table_->FindHeaderItem(2), nullptr);
-    EXPECT_EQ(table_->FindHeaderItem(3), nullptr);
+    HeaderItem item;
+    ASSERT_TRUE(table_->FindHeaderItem(0, item));
+    EXPECT_EQ(item.name_, "header4");
+    EXPECT_EQ(item.value_, "value4");
+    ASSERT_TRUE(table_->FindHeaderItem(1, item));
+    EXPECT_EQ(item.name_, "header3");
+    EXPECT_EQ(item.value_, "value3");
+    EXPECT_FALSE(table_->FindHeaderItem(2, item));
+    EXPECT_FALSE(table_->FindHeaderItem(3, item));
 }
 
 TEST_F(DynamicTableTest, ResizeTable) {
@@ -73,11 +76,12 @@ TEST_F(DynamicTableTest, ResizeTable) {
     table_->UpdateMaxTableSize(50);
 
     // Verify entries are evicted
-    EXPECT_EQ(table_->FindHeaderItem(1), nullptr);
+    HeaderItem item;
+    EXPECT_FALSE(table_->FindHeaderItem(1, item));
     
-    auto item = table_->FindHeaderItem(0);
-    EXPECT_EQ(item->name_, "header2");
-    EXPECT_EQ(item->value_, "value2");
+    ASSERT_TRUE(table_->FindHeaderItem(0, item));
+    EXPECT_EQ(item.name_, "header2");
+    EXPECT_EQ(item.value_, "value2");
 
     // Increase table size
     table_->UpdateMaxTableSize(200);
@@ -90,24 +94,25 @@ TEST_F(DynamicTableTest, DuplicateEntries) {
     EXPECT_TRUE(table_->AddHeaderItem("content-type", "application/json"));
 
     // Verify both entries exist and are in correct order (front=newest)
-    auto item0 = table_->FindHeaderItem(0);
-    ASSERT_NE(item0, nullptr);
-    EXPECT_EQ(item0->name_, "content-type");
-    EXPECT_EQ(item0->value_, "application/json");
-
-    auto item1 = table_->FindHeaderItem(1);
-    ASSERT_NE(item1, nullptr);
-    EXPECT_EQ(item1->name_, "content-type");
-    EXPECT_EQ(item1->value_, "application/json");
+    HeaderItem item0;
+    ASSERT_TRUE(table_->FindHeaderItem(0, item0));
+    EXPECT_EQ(item0.name_, "content-type");
+    EXPECT_EQ(item0.value_, "application/json");
+
+    HeaderItem item1;
+    ASSERT_TRUE(table_->FindHeaderItem(1, item1));
+    EXPECT_EQ(item1.name_, "content-type");
+    EXPECT_EQ(item1.value_, "application/json");
 }
 
 TEST_F(DynamicTableTest, InvalidLookup) {
     EXPECT_TRUE(table_->AddHeaderItem("header1", "value1"));
 
     // Try to look up invalid indices
-    EXPECT_TRUE(table_->FindHeaderItem(0) != nullptr);  // Index 0 is valid
-    EXPECT_EQ(table_->FindHeaderItem(2), nullptr);  // Index 2 doesn't exist
-    EXPECT_EQ(table_->FindHeaderItem(100), nullptr); // Large index doesn't exist
+    HeaderItem item;
+    EXPECT_TRUE(table_->FindHeaderItem(0, item));  // Index 0 is valid
+    EXPECT_FALSE(table_->FindHeaderItem(2, item));  // Index 2 doesn't exist
+    EXPECT_FALSE(table_->FindHeaderItem(100, item)); // Large index doesn't exist
 }
 
 TEST_F(DynamicTableTest, EmptyStrings) {
@@ -116,9 +121,10 @@ TEST_F(DynamicTableTest, EmptyStrings) {
     EXPECT_TRUE(table_->AddHeaderItem("name", ""));
     EXPECT_TRUE(table_->AddHeaderItem("", ""));
 
-    auto item = table_->FindHeaderItem(0);
-    EXPECT_TRUE(item->name_.empty());
-    EXPECT_TRUE(item->value_.empty());
+    HeaderItem item;
+    ASSERT_TRUE(table_->FindHeaderItem(0, item));
+    EXPECT_TRUE(item.name_.empty());
+    EXPECT_TRUE(item.value_.empty());
 }
 
 TEST_F(DynamicTableTest, SizeCalculation) {
@@ -135,6 +141,72 @@ TEST_F(DynamicTableTest, SizeCalculation) {
     EXPECT_EQ(table_->GetTableSize(), 113);
 }
 
+TEST_F(DynamicTableTest, EntriesWrapAroundArena) {
+    // room for two entries of 40 bytes at a time, so the bytes keep wrapping
+    table_->UpdateMaxTableSize(80);
+    for (int i = 0; i < 20; i++) {
+        std::string name = "n" + std::to_string(i % 10);
+        std::string value = "val" + std::to_string(i % 10);
+        ASSERT_TRUE(table_->AddHeaderItem(name, value));
+
+        EXPECT_EQ(table_->GetEntryCount(), i == 0 ? 1u : 2u);
+        HeaderItem item;
+        ASSERT_TRUE(table_->FindHeaderItemByAbsoluteIndex(i, item));
+        EXPECT_EQ(item.name_, name);
+        EXPECT_EQ(item.value_, value);
+        EXPECT_EQ(table_->FindAbsoluteIndex(name, value), i);
+        EXPECT_EQ(table_->FindAbsoluteNameIndex(name), i);
+        if (i >= 2) {
+            EXPECT_FALSE(table_->FindHeaderItemByAbsoluteIndex(i - 2, item));
+        }
+    }
+    EXPECT_EQ(table_->FindAbsoluteIndex("n0", "val0"), -1);
+    EXPECT_EQ(table_->FindAbsoluteNameIndex("n7"), -1);
+}
+
+TEST_F(DynamicTableTest, IndexFollowsNewestMatch) {
+    EXPECT_TRUE(table_->AddHeaderItem("a", "1"));
+    EXPECT_TRUE(table_->AddHeaderItem("a", "2"));
+    EXPECT_TRUE(table_->AddHeaderItem("a", "1"));
+
+    EXPECT_EQ(table_->FindAbsoluteIndex("a", "1"), 2);
+    EXPECT_EQ(table_->FindAbsoluteIndex("a", "2"), 1);
+    EXPECT_EQ(table_->FindAbsoluteNameIndex("a"), 2);
+    EXPECT_EQ(table_->FindHeaderItemIndex("a", "2"), 1);
+    // same bytes, split differently
+    EXPECT_EQ(table_->FindAbsoluteIndex("a1", ""), -1);
+    EXPECT_EQ(table_->FindAbsoluteIndex("", "a1"), -1);
+
+    // evicting the oldest ("a", "1") keeps the index on the newer duplicate
+    table_->EvictEntries();
+    EXPECT_EQ(table_->FindAbsoluteIndex("a", "1"), 2);
+    table_->EvictEntries();
+    EXPECT_EQ(table_->FindAbsoluteIndex("a", "2"), -1);
+    EXPECT_EQ(table_->FindAbsoluteNameIndex("a"), 2);
+
+    // resizing keeps absolute indexes
+    table_->UpdateMaxTableSize(4096);
+    EXPECT_EQ(table_->FindAbsoluteIndex("a", "1"), 2);
+    EXPECT_TRUE(table_->DuplicateEntry(2));
+    EXPECT_EQ(table_->FindAbsoluteIndex("a", "1"), 3);
+    EXPECT_EQ(table_->GetInsertCount(), 4u);
+}
+
+TEST_F(DynamicTableTest, ManyNamesStayFindable) {
+    table_->UpdateMaxTableSize(16 * 1024);
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(table_->AddHeaderItem("x-hdr-" + std::to_string(i), std::to_string(i)));
+    }
+    // the oldest entries were evicted, the rest must still be found after the index shifted slots around
+    uint32_t evicted = static_cast<uint32_t>(table_->GetInsertCount() - table_->GetEntryCount());
+    ASSERT_GT(evicted, 0u);
+    for (int i = 0; i < 1000; i++) {
+        int64_t expected = i < static_cast<int>(evicted) ? -1 : i;
+        EXPECT_EQ(table_->FindAbsoluteIndex("x-hdr-" + std::to_string(i), std::to_string(i)), expected);
+        EXPECT_EQ(table_->FindAbsoluteNameIndex("x-hdr-" + std::to_string(i)), expected);
+    }
+}
+
 }  // namespace
 }  // namespace http3
 }  // namespace quicx
\ No newline at end of file
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 #include <unordered_map>
+#include <vector>
+
+#include <quicx/common/if_event_loop.h>
+#include "quic/stream/send_stream.h"
+#include "quic/stream/send_buffer_watermark.h"
 
 #include "http3/stream/type.h"
 #include "http3/connection/type.h"
@@ -127,6 +132,34 @@ TEST_F(ControlServerSenderStreamTest, SendSettings) {
     EXPECT_EQ(client_connection_->GetSettings(), settings);
 }
 
+TEST(ControlSenderStreamWatermarkTest, QpackInstructionsNotCutByConnectionWatermark) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto noop_active = [](std::shared_ptr<quic::IStream>) {};
+    auto noop_close = [](uint64_t) {};
+    auto noop_conn_close = [](uint64_t, uint16_t, const std::string&) {};
+
+    // a request stream already filled the connection up to its high mark
+    auto conn_watermark = std::make_shared<quic::SendBufferWatermark>();
+    conn_watermark->SetMarks(1000, 500);
+    auto request = std::make_shared<quic::SendStream>(event_loop, 100000, 0, noop_active, noop_close, noop_conn_close);
+    request->SetConnectionWatermark(conn_watermark);
+    std::vector<uint8_t> body(1000, 'B');
+    ASSERT_EQ(request->Send(body.data(), static_cast<uint32_t>(body.size())), 1000);
+    ASSERT_EQ(conn_watermark->GetRoom(), 0u);
+
+    auto control = std::make_shared<quic::SendStream>(event_loop, 100000, 3, noop_active, noop_close, noop_conn_close);
+    control->SetConnectionWatermark(conn_watermark);
+    uint32_t error = 0;
+    ControlSenderStream sender(control, [&error](uint64_t, uint32_t code) { error = code; });
+
+    std::vector<uint8_t> blob(300, 0x42);
+    EXPECT_TRUE(sender.SendQpackInstructions(blob));
+    EXPECT_EQ(error, 0u);
+    // the stream type byte and the whole blob are queued
+    EXPECT_EQ(control->GetPendingSendBytes(), 1u + blob.size());
+}
+
 
 }  // namespace
 }  // namespace http3
@@ -41,22 +41,32 @@ public:
 
     virtual StreamDirection GetDirection() override;
     virtual uint64_t GetStreamID() override;
+    virtual void SetPriority(uint8_t urgency, bool incremental) override { urgency_ = urgency; }
+    uint8_t GetUrgency() const { return urgency_; }
 
     virtual void Close() override;
 
     virtual void Reset(uint32_t error) override;
 
     virtual void SetStreamReadCallBack(stream_read_callback cb) override;
+    virtual void SetZeroCopyRead(bool enable) override {}
 
     virtual int32_t Send(uint8_t* data, uint32_t len) override;
     virtual int32_t Send(std::shared_ptr<IBufferRead> buffer) override;
+    virtual int32_t SendZeroCopy(const uint8_t* data, uint32_t len, std::function<void()> release) override {
+        return -1;
+    }
 
     virtual std::shared_ptr<IBufferWrite> GetSendBuffer() override;
     virtual bool Flush() override;
 
     virtual void SetStreamWriteCallBack(stream_write_callback cb) override;
+    virtual void SetSendBufferWatermark(uint32_t high, uint32_t low) override {}
+    virtual void SetStreamWritableCallBack(stream_writable_callback cb) override {}
 
     virtual uint64_t GetPendingSendBytes() override;
+    virtual uint64_t GetRetainedSendBytes() override { return 0; }
+    virtual uint64_t GetSendableBytes() override { return 0; }
 
     // Test-only helper: directly invoke the registered read callback to
     // simulate the QUIC layer delivering a STREAM frame with a specific
@@ -88,6 +98,7 @@ private:
     std::shared_ptr<common::IBuffer> send_buffer_;
     uint64_t stream_id_;
     StreamDirection direction_;
+    uint8_t urgency_ = kStreamUrgencyDefault;
 
     // Inbound bytes that arrived before SetStreamReadCallBack() installed
     // a read callback. The HTTP/3 Init() flow opens the QPACK encoder /
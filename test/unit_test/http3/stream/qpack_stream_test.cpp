@@ -8,6 +8,7 @@
 #include "http3/qpack/blocked_registry.h"
 #include "http3/frame/qpack_decoder_frames.h"
 #include "http3/frame/qpack_encoder_frames.h"
+#include "http3/stream/control_sender_stream.h"
 #include "http3/stream/qpack_decoder_sender_stream.h"
 #include "http3/stream/qpack_encoder_sender_stream.h"
 #include "http3/stream/qpack_encoder_receiver_stream.h"
@@ -84,6 +85,16 @@ protected:
     uint32_t decoder_notify_count_{0};
 };
 
+TEST_F(QpackStreamTest, CriticalStreamsAreMostUrgent) {
+    // QPACK and control streams must not wait behind request data
+    EXPECT_EQ(encoder_send_stream_->GetUrgency(), 0);
+    EXPECT_EQ(decoder_send_stream_->GetUrgency(), 0);
+
+    auto control_stream = std::make_shared<quic::MockQuicStream>();
+    ControlSenderStream control(control_stream, [](uint64_t, uint32_t) {});
+    EXPECT_EQ(control_stream->GetUrgency(), 0);
+}
+
 TEST_F(QpackStreamTest, EncoderSenderBasicInstructionsSucceed) {
     // Send a simple name/value insert then a duplicate; just ensure no errors are reported.
     EXPECT_TRUE(encoder_sender_->SendInsertWithoutNameRef("x-name", "x-value"));
@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "common/network/address.h"
+#include "quic/congestion_control/careful_resume.h"
+#include "quic/congestion_control/congestion_control_factory.h"
+#include "quic/connection/path_capacity_cache.h"
+
+using namespace quicx;
+using namespace quicx::quic;
+
+namespace {
+
+constexpr uint64_t kMss = 1200;
+constexpr uint64_t kRttUs = 20000;
+
+CcConfigV2 TestConfig() {
+    CcConfigV2 cfg;
+    cfg.mss_bytes = kMss;
+    cfg.initial_cwnd_bytes = 10 * kMss;
+    cfg.min_cwnd_bytes = 2 * kMss;
+    cfg.max_cwnd_bytes = 1000 * kMss;
+    return cfg;
+}
+
+// 400 packets per 20ms saved: jump_cwnd = 200 packets.
+PathCapacity SavedCapacity() {
+    PathCapacity saved;
+    saved.min_rtt_us = kRttUs;
+    saved.cwnd_bytes = 400 * kMss;
+    saved.bandwidth_bytes_per_sec = 400 * kMss * 1000000 / kRttUs;
+    return saved;
+}
+
+class CarefulResumeTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        cc_ = CreateCongestionControl(CongestionControlType::kCubic);
+        cc_->Configure(TestConfig());
+    }
+
+    // Like SendControl: a sender that fills the window reports itself
+    // cwnd-limited.
+    void Send(uint64_t from, uint64_t to) {
+        for (uint64_t pn = from; pn <= to; ++pn) {
+            cc_->OnPacketSent(SentPacketEvent{pn, kMss, now_});
+            cr_.OnPacketSent(pn);
+        }
+        if (cc_->GetBytesInFlight() >= cc_->GetCongestionWindow()) {
+            cr_.OnCwndLimited();
+        }
+    }
+
+    void Ack(uint64_t from, uint64_t to, bool ecn_ce = false) {
+        std::vector<AckEvent> acked;
+        for (uint64_t pn = to + 1; pn-- > from;) {
+            acked.push_back(AckEvent{pn, kMss, now_, 0, ecn_ce, now_ - kRttUs});
+        }
+        Deliver(acked, {});
+    }
+
+    void Deliver(const std::vector<AckEvent>& acked, const std::vector<LossEvent>& lost) {
+        cc_->OnCongestionEvent(acked, lost, cc_->GetBytesInFlight(), now_);
+        cr_.OnCongestionEvent(acked, lost, now_, *cc_);
+    }
+
+    // First flight of 10 packets, acknowledged one RTT later.
+    void FirstRoundTrip(uint64_t rtt_us) {
+        Send(1, 10);
+        now_ += rtt_us;
+        cc_->OnRoundTripSample(rtt_us, 0);
+        cr_.OnRoundTripSample(rtt_us);
+        Ack(1, 1);
+    }
+
+    std::unique_ptr<ICongestionControl> cc_;
+    CarefulResume cr_;
+    uint64_t now_ = 1000000;
+};
+
+}  // namespace
+
+TEST_F(CarefulResumeTest, JumpsAfterConfirmedRtt) {
+    cr_.Start(SavedCapacity());
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kReconnaissance);
+
+    FirstRoundTrip(kRttUs);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kUnvalidated);
+    EXPECT_EQ(cc_->GetCongestionWindow(), 200 * kMss);
+    EXPECT_EQ(cc_->GetSsthresh(), 200 * kMss);
+}
+
+TEST_F(CarefulResumeTest, AppLimitedSenderDoesNotJump) {
+    cr_.Start(SavedCapacity());
+    // Three packets never fill the initial window.
+    Send(1, 3);
+    now_ += kRttUs;
+    cc_->OnRoundTripSample(kRttUs, 0);
+    cr_.OnRoundTripSample(kRttUs);
+    Ack(1, 1);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kReconnaissance);
+    EXPECT_LT(cc_->GetCongestionWindow(), 200 * kMss);
+
+    // Once the window is filled, the next ACK takes the jump.
+    Send(4, 12);
+    now_ += 5000;
+    Ack(2, 2);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kUnvalidated);
+    EXPECT_EQ(cc_->GetCongestionWindow(), 200 * kMss);
+}
+
+TEST_F(CarefulResumeTest, NoSlowStartOnTopOfTheJump) {
+    cr_.Start(SavedCapacity());
+    FirstRoundTrip(kRttUs);
+    ASSERT_EQ(cr_.GetPhase(), CarefulResume::Phase::kUnvalidated);
+
+    // Slow start would add one MSS per acknowledged packet.
+    Send(11, 210);
+    now_ += 5000;
+    Ack(2, 10);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kUnvalidated);
+    EXPECT_LT(cc_->GetCongestionWindow(), 200 * kMss + 9 * kMss);
+}
+
+TEST_F(CarefulResumeTest, RttMismatchFallsBackToNormal) {
+    cr_.Start(SavedCapacity());
+    uint64_t cwnd = cc_->GetCongestionWindow();
+
+    FirstRoundTrip(kRttUs * CarefulResume::kRttConfirmMaxFactor + 1000);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kNormal);
+    // Slow start only: nowhere near the saved window.
+    EXPECT_LT(cc_->GetCongestionWindow(), cwnd + 2 * kMss);
+}
+
+TEST_F(CarefulResumeTest, LossBeforeJumpFallsBackToNormal) {
+    cr_.Start(SavedCapacity());
+    Send(1, 10);
+    now_ += kRttUs;
+    cr_.OnRoundTripSample(kRttUs);
+    Deliver({AckEvent{2, kMss, now_}}, {LossEvent{1, kMss, now_}});
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kNormal);
+}
+
+TEST_F(CarefulResumeTest, ValidatesJumpOnceUnvalidatedPacketsAreAcked) {
+    cr_.Start(SavedCapacity());
+    FirstRoundTrip(kRttUs);
+    ASSERT_EQ(cr_.GetPhase(), CarefulResume::Phase::kUnvalidated);
+
+    // Use the jumped window, then the rest of the first flight comes back.
+    Send(11, 110);
+    now_ += 5000;
+    Ack(2, 10);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kUnvalidated);
+
+    // The first packet sent after the jump is acknowledged: PipeSize caps cwnd.
+    now_ += kRttUs;
+    Ack(11, 11);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kValidating);
+    EXPECT_LE(cc_->GetCongestionWindow(), 200 * kMss);
+    EXPECT_EQ(cc_->GetSsthresh(), cc_->GetCongestionWindow());
+
+    Ack(12, 110);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kNormal);
+}
+
+TEST_F(CarefulResumeTest, LossWhileUnvalidatedRetreatsToHalfPipeSize) {
+    cr_.Start(SavedCapacity());
+    FirstRoundTrip(kRttUs);
+    ASSERT_EQ(cr_.GetPhase(), CarefulResume::Phase::kUnvalidated);
+
+    Send(11, 110);
+    now_ += 5000;
+    Ack(2, 10);
+    // PipeSize: 9 packets in flight at the jump + 9 acked since.
+    now_ += 5000;
+    Deliver({}, {LossEvent{11, kMss, now_}});
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kSafeRetreat);
+    EXPECT_EQ(cc_->GetCongestionWindow(), 9 * kMss);
+    EXPECT_EQ(cc_->GetSsthresh(), 9 * kMss);
+
+    Ack(12, 110);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kNormal);
+}
+
+TEST_F(CarefulResumeTest, EcnCeCountsAsCongestion) {
+    cr_.Start(SavedCapacity());
+    FirstRoundTrip(kRttUs);
+    Send(11, 20);
+    now_ += 5000;
+    Ack(2, 2, true);
+    EXPECT_EQ(cr_.GetPhase(), CarefulResume::Phase::kSafeRetreat);
+}
+
+TEST_F(CarefulResumeTest, ObservedCapacity) {
+    PathCapacity observed;
+    EXPECT_FALSE(cr_.GetObservedCapacity(*cc_, observed));
+
+    Send(1, 40);
+    cr_.OnRoundTripSample(kRttUs);
+    now_ += kRttUs;
+    Ack(1, 10);
+    now_ += kRttUs;
+    Ack(11, 30);
+    ASSERT_TRUE(cr_.GetObservedCapacity(*cc_, observed));
+    EXPECT_EQ(observed.min_rtt_us, kRttUs);
+    EXPECT_EQ(observed.bandwidth_bytes_per_sec, 20 * kMss * 1000000 / kRttUs);
+    EXPECT_EQ(observed.cwnd_bytes, cc_->GetCongestionWindow());
+}
+
+TEST(CarefulResumeCcTest, BuiltInControllersAcceptSetCongestionWindow) {
+    for (auto type : {CongestionControlType::kCubic, CongestionControlType::kReno, CongestionControlType::kBbrV1,
+             CongestionControlType::kBbrV2, CongestionControlType::kBbrV3}) {
+        auto cc = CreateCongestionControl(type);
+        cc->Configure(TestConfig());
+        ASSERT_TRUE(cc->SetCongestionWindow(100 * kMss, 50 * kMss)) << static_cast<int>(type);
+        EXPECT_EQ(cc->GetCongestionWindow(), 100 * kMss) << static_cast<int>(type);
+        // Clamped to the configured bounds.
+        cc->SetCongestionWindow(kMss, kMss);
+        EXPECT_EQ(cc->GetCongestionWindow(), 2 * kMss) << static_cast<int>(type);
+    }
+}
+
+TEST(PathCapacityCacheTest, StoreLookupAndEvict) {
+    PathCapacityCache cache;
+    cache.SetMaxEntries(2);
+    PathCapacity capacity = SavedCapacity();
+
+    cache.Store("a", capacity);
+    cache.Store("b", capacity);
+    PathCapacity out;
+    ASSERT_TRUE(cache.Lookup("a", out));  // "a" is now the most recent
+    EXPECT_EQ(out.cwnd_bytes, capacity.cwnd_bytes);
+
+    cache.Store("c", capacity);
+    EXPECT_EQ(cache.Size(), 2u);
+    EXPECT_FALSE(cache.Lookup("b", out));
+    EXPECT_TRUE(cache.Lookup("a", out));
+    EXPECT_TRUE(cache.Lookup("c", out));
+
+    cache.Clear();
+    EXPECT_FALSE(cache.Lookup("a", out));
+}
+
+TEST(PathCapacityCacheTest, SubnetKey) {
+    EXPECT_EQ(PathCapacityCache::SubnetKey(common::Address("192.168.7.42", 4433)), "192.168.7.0/24");
+    EXPECT_EQ(PathCapacityCache::SubnetKey(common::Address("::ffff:10.1.2.3", 4433)), "10.1.2.0/24");
+    EXPECT_EQ(PathCapacityCache::SubnetKey(common::Address("2001:db8:abcd:12::1", 4433)), "2001:db8:abcd::/48");
+    // Different hosts and ports in one subnet share the entry.
+    EXPECT_EQ(PathCapacityCache::SubnetKey(common::Address("192.168.7.1", 1)),
+        PathCapacityCache::SubnetKey(common::Address("192.168.7.200", 2)));
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+
+#include "common/timer/timer.h"
+#include "quic/congestion_control/congestion_control_factory.h"
+#include "quic/connection/controler/send_control.h"
+#include "quic/packet/rtt_1_packet.h"
+
+using namespace quicx;
+using namespace quicx::quic;
+
+namespace {
+
+// Minimal plug-in: fixed window, counts the events it is fed.
+class CountingCongestionControl: public ICongestionControl {
+public:
+    static constexpr uint64_t kWindow = 4321;
+
+    void Configure(const CcConfigV2& cfg) override {}
+    void OnPacketSent(const SentPacketEvent& ev) override {
+        ++sent_;
+        in_flight_ += ev.bytes;
+    }
+    void OnPacketAcked(const AckEvent& ev) override {
+        ++acked_;
+        in_flight_ -= std::min(in_flight_, ev.bytes_acked);
+    }
+    void OnPacketLost(const LossEvent& ev) override {
+        ++lost_;
+        in_flight_ -= std::min(in_flight_, ev.bytes_lost);
+    }
+    void OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay) override {}
+    SendState CanSend(uint64_t now, uint64_t& can_send_bytes) const override {
+        can_send_bytes = in_flight_ < kWindow ? kWindow - in_flight_ : 0;
+        return can_send_bytes > 0 ? SendState::kOk : SendState::kBlockedByCwnd;
+    }
+    uint64_t GetCongestionWindow() const override { return kWindow; }
+    uint64_t GetBytesInFlight() const override { return in_flight_; }
+    uint64_t GetPacingRateBytesPerSec() const override { return 0; }
+    uint64_t NextSendTime(uint64_t now) const override { return now; }
+    bool InSlowStart() const override { return false; }
+    bool InRecovery() const override { return false; }
+    uint64_t GetSsthresh() const override { return kWindow; }
+
+    static int sent_;
+    static int acked_;
+    static int lost_;
+
+private:
+    uint64_t in_flight_ = 0;
+};
+
+int CountingCongestionControl::sent_ = 0;
+int CountingCongestionControl::acked_ = 0;
+int CountingCongestionControl::lost_ = 0;
+
+std::shared_ptr<IPacket> MakePacket(uint64_t pn) {
+    auto packet = std::make_shared<Rtt1Packet>();
+    packet->SetPacketNumber(pn);
+    packet->AddFrameTypeBit(FrameTypeBit::kStreamBit);
+    return packet;
+}
+
+}  // namespace
+
+TEST(CongestionControlFactoryTest, BuiltinTypes) {
+    for (auto type : {CongestionControlType::kCubic, CongestionControlType::kReno, CongestionControlType::kBbrV1,
+             CongestionControlType::kBbrV2, CongestionControlType::kBbrV3}) {
+        EXPECT_NE(CreateCongestionControl(type), nullptr);
+    }
+    EXPECT_EQ(CreateCongestionControl(CongestionControlType::kCustom, "no-such-cc"), nullptr);
+}
+
+TEST(CongestionControlFactoryTest, RegisterCustom) {
+    EXPECT_FALSE(RegisterCongestionControl("", []() { return std::unique_ptr<ICongestionControl>(); }));
+    EXPECT_FALSE(RegisterCongestionControl("counting", nullptr));
+    ASSERT_TRUE(RegisterCongestionControl("counting",
+        []() { return std::unique_ptr<ICongestionControl>(new CountingCongestionControl()); }));
+
+    auto cc = CreateCongestionControl(CongestionControlType::kCustom, "counting");
+    ASSERT_NE(cc, nullptr);
+    EXPECT_EQ(cc->GetCongestionWindow(), CountingCongestionControl::kWindow);
+}
+
+TEST(CongestionControlFactoryTest, SendControlUsesSelectedController) {
+    ASSERT_TRUE(RegisterCongestionControl("counting",
+        []() { return std::unique_ptr<ICongestionControl>(new CountingCongestionControl()); }));
+    CountingCongestionControl::sent_ = 0;
+
+    auto timer = common::MakeTimer();
+    SendControl send_control(timer);
+    // Unknown names keep the current controller.
+    EXPECT_FALSE(send_control.SetCongestionControl(CongestionControlType::kCustom, "no-such-cc"));
+    ASSERT_TRUE(send_control.SetCongestionControl(CongestionControlType::kCustom, "counting"));
+    EXPECT_EQ(send_control.GetCongestionWindow(), CountingCongestionControl::kWindow);
+
+    send_control.OnPacketSend(1, MakePacket(1), 1200);
+    EXPECT_EQ(CountingCongestionControl::sent_, 1);
+    EXPECT_EQ(send_control.GetCcBytesInFlightForTest(), 1200u);
+
+    // In-flight accounting can't move between controllers.
+    EXPECT_FALSE(send_control.SetCongestionControl(CongestionControlType::kReno));
+    EXPECT_EQ(send_control.GetCongestionWindow(), CountingCongestionControl::kWindow);
+}
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/timer/timer.h"
+#include "quic/congestion_control/congestion_control_factory.h"
+#include "quic/connection/controler/send_control.h"
+#include "quic/frame/ack_frame.h"
+#include "quic/packet/rtt_1_packet.h"
+
+using namespace quicx;
+using namespace quicx::quic;
+
+namespace {
+
+constexpr uint64_t kMss = 1200;
+
+// Plug-in that only implements the per-packet methods: records the order the
+// default OnCongestionEvent() forwards them in.
+class PerPacketCongestionControl: public ICongestionControl {
+public:
+    void Configure(const CcConfigV2& cfg) override {}
+    void OnPacketSent(const SentPacketEvent& ev) override {}
+    void OnPacketAcked(const AckEvent& ev) override { calls_.push_back("ack" + std::to_string(ev.pn)); }
+    void OnPacketLost(const LossEvent& ev) override { calls_.push_back("lost" + std::to_string(ev.pn)); }
+    void OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay) override {}
+    SendState CanSend(uint64_t now, uint64_t& can_send_bytes) const override { return SendState::kOk; }
+    uint64_t GetCongestionWindow() const override { return 0; }
+    uint64_t GetBytesInFlight() const override { return 0; }
+    uint64_t GetPacingRateBytesPerSec() const override { return 0; }
+    uint64_t NextSendTime(uint64_t now) const override { return now; }
+    bool InSlowStart() const override { return false; }
+    bool InRecovery() const override { return false; }
+    uint64_t GetSsthresh() const override { return 0; }
+
+    std::vector<std::string> calls_;
+};
+
+// Plug-in that records every batch SendControl hands it.
+class BatchRecordingCongestionControl: public ICongestionControl {
+public:
+    struct Batch {
+        size_t acked;
+        size_t lost;
+        uint64_t prior_in_flight;
+        size_t ce;
+    };
+
+    void Configure(const CcConfigV2& cfg) override {}
+    void OnPacketSent(const SentPacketEvent& ev) override { in_flight_ += ev.bytes; }
+    void OnPacketAcked(const AckEvent& ev) override { ADD_FAILURE() << "per-packet ACK bypassed the batch"; }
+    void OnPacketLost(const LossEvent& ev) override { ADD_FAILURE() << "per-packet loss bypassed the batch"; }
+    void OnCongestionEvent(const std::vector<AckEvent>& acked, const std::vector<LossEvent>& lost,
+        uint64_t prior_in_flight, uint64_t event_time) override {
+        size_t ce = 0;
+        for (const auto& ev : acked) {
+            in_flight_ -= std::min(in_flight_, ev.bytes_acked);
+            ce += ev.ecn_ce ? 1 : 0;
+        }
+        batches_.push_back(Batch{acked.size(), lost.size(), prior_in_flight, ce});
+        for (const auto& ev : lost) {
+            in_flight_ -= std::min(in_flight_, ev.bytes_lost);
+        }
+    }
+    void OnRoundTripSample(uint64_t latest_rtt, uint64_t ack_delay) override {}
+    SendState CanSend(uint64_t now, uint64_t& can_send_bytes) const override { return SendState::kOk; }
+    uint64_t GetCongestionWindow() const override { return UINT64_MAX; }
+    uint64_t GetBytesInFlight() const override { return in_flight_; }
+    uint64_t GetPacingRateBytesPerSec() const override { return 0; }
+    uint64_t NextSendTime(uint64_t now) const override { return now; }
+    bool InSlowStart() const override { return false; }
+    bool InRecovery() const override { return false; }
+    uint64_t GetSsthresh() const override { return 0; }
+
+    static std::vector<Batch> batches_;
+
+private:
+    uint64_t in_flight_ = 0;
+};
+
+std::vector<BatchRecordingCongestionControl::Batch> BatchRecordingCongestionControl::batches_;
+
+CcConfigV2 TestConfig() {
+    CcConfigV2 cfg;
+    cfg.mss_bytes = kMss;
+    cfg.initial_cwnd_bytes = 10 * kMss;
+    cfg.min_cwnd_bytes = 2 * kMss;
+    cfg.max_cwnd_bytes = 1000 * kMss;
+    return cfg;
+}
+
+std::shared_ptr<IPacket> MakePacket(uint64_t pn) {
+    auto packet = std::make_shared<Rtt1Packet>();
+    packet->SetPacketNumber(pn);
+    packet->AddFrameTypeBit(FrameTypeBit::kStreamBit);
+    return packet;
+}
+
+}  // namespace
+
+TEST(CongestionEventTest, DefaultForwardsLossesBeforeAcks) {
+    PerPacketCongestionControl cc;
+    cc.OnCongestionEvent({AckEvent{5, kMss, 100}, AckEvent{4, kMss, 100}}, {LossEvent{1, kMss, 100}}, 3 * kMss, 100);
+    EXPECT_EQ(cc.calls_, (std::vector<std::string>{"lost1", "ack5", "ack4"}));
+}
+
+// Reno and CUBIC carry per-packet state; a batch must land exactly where the
+// same packets fed one by one (losses first) would.
+TEST(CongestionEventTest, LossBasedBatchMatchesPerPacket) {
+    for (auto type : {CongestionControlType::kReno, CongestionControlType::kCubic}) {
+        auto batched = CreateCongestionControl(type);
+        auto sequential = CreateCongestionControl(type);
+        batched->Configure(TestConfig());
+        sequential->Configure(TestConfig());
+
+        std::vector<AckEvent> acked;
+        std::vector<LossEvent> lost{LossEvent{1, kMss, 5000}};
+        for (uint64_t pn = 1; pn <= 20; ++pn) {
+            batched->OnPacketSent(SentPacketEvent{pn, kMss, pn * 100});
+            sequential->OnPacketSent(SentPacketEvent{pn, kMss, pn * 100});
+            if (pn >= 4) {
+                acked.push_back(AckEvent{pn, kMss, 5000, 0, false, pn * 100});
+            }
+        }
+
+        batched->OnCongestionEvent(acked, lost, batched->GetBytesInFlight(), 5000);
+        sequential->OnPacketLost(lost[0]);
+        for (const auto& ev : acked) {
+            sequential->OnPacketAcked(ev);
+        }
+
+        EXPECT_EQ(batched->GetBytesInFlight(), 2 * kMss);
+        EXPECT_EQ(batched->GetBytesInFlight(), sequential->GetBytesInFlight());
+        EXPECT_EQ(batched->GetCongestionWindow(), sequential->GetCongestionWindow());
+        EXPECT_EQ(batched->GetSsthresh(), sequential->GetSsthresh());
+        EXPECT_EQ(batched->InRecovery(), sequential->InRecovery());
+        EXPECT_EQ(batched->GetPacingRateBytesPerSec(), sequential->GetPacingRateBytesPerSec());
+    }
+}
+
+TEST(CongestionEventTest, BatchReleasesAllBytesInFlight) {
+    for (auto type : {CongestionControlType::kCubic, CongestionControlType::kReno, CongestionControlType::kBbrV1,
+             CongestionControlType::kBbrV2, CongestionControlType::kBbrV3}) {
+        auto cc = CreateCongestionControl(type);
+        cc->Configure(TestConfig());
+        for (uint64_t pn = 1; pn <= 8; ++pn) {
+            cc->OnPacketSent(SentPacketEvent{pn, kMss, pn * 100});
+        }
+        cc->OnRoundTripSample(10000, 0);
+        cc->OnCongestionEvent({AckEvent{8, kMss, 20000}, AckEvent{7, kMss, 20000}, AckEvent{6, kMss, 20000}},
+            {LossEvent{1, kMss, 20000}, LossEvent{2, kMss, 20000}}, 8 * kMss, 20000);
+        EXPECT_EQ(cc->GetBytesInFlight(), 3 * kMss) << static_cast<int>(type);
+    }
+}
+
+TEST(CongestionEventTest, BbrLossBurstLeavesStartupOnce) {
+    for (auto type : {CongestionControlType::kBbrV1, CongestionControlType::kBbrV2, CongestionControlType::kBbrV3}) {
+        auto cc = CreateCongestionControl(type);
+        cc->Configure(TestConfig());
+        ASSERT_TRUE(cc->InSlowStart());
+        for (uint64_t pn = 1; pn <= 5; ++pn) {
+            cc->OnPacketSent(SentPacketEvent{pn, kMss, pn * 100});
+        }
+        uint64_t cwnd = cc->GetCongestionWindow();
+        cc->OnCongestionEvent({}, {LossEvent{1, kMss, 1000}, LossEvent{2, kMss, 1000}, LossEvent{3, kMss, 1000}},
+            5 * kMss, 1000);
+        EXPECT_FALSE(cc->InSlowStart()) << static_cast<int>(type);
+        // BBR is rate-based: loss moves the state machine, not the window.
+        EXPECT_EQ(cc->GetCongestionWindow(), cwnd) << static_cast<int>(type);
+    }
+}
+
+TEST(CongestionEventTest, SendControlDeliversOneEventPerAckFrame) {
+    ASSERT_TRUE(RegisterCongestionControl("batch-recording",
+        []() { return std::unique_ptr<ICongestionControl>(new BatchRecordingCongestionControl()); }));
+    BatchRecordingCongestionControl::batches_.clear();
+
+    auto timer = common::MakeTimer();
+    SendControl send_control(timer);
+    ASSERT_TRUE(send_control.SetCongestionControl(CongestionControlType::kCustom, "batch-recording"));
+    for (uint64_t pn = 1; pn <= 6; ++pn) {
+        send_control.OnPacketSend(pn, MakePacket(pn), kMss);
+    }
+
+    // ACK 5..6: packet threshold declares 1..3 lost, 4 stays outstanding.
+    auto ack = std::make_shared<AckFrame>();
+    ack->SetLargestAck(6);
+    ack->SetAckDelay(0);
+    ack->SetFirstAckRange(1);
+    send_control.OnPacketAck(10, PacketNumberSpace::kApplicationNumberSpace, ack);
+
+    ASSERT_EQ(BatchRecordingCongestionControl::batches_.size(), 1u);
+    EXPECT_EQ(BatchRecordingCongestionControl::batches_[0].acked, 2u);
+    EXPECT_EQ(BatchRecordingCongestionControl::batches_[0].lost, 3u);
+    EXPECT_EQ(BatchRecordingCongestionControl::batches_[0].prior_in_flight, 6 * kMss);
+    EXPECT_EQ(send_control.GetCcBytesInFlightForTest(), kMss);
+}
+
+// ACK_ECN carries cumulative counts: only the increase since the previous
+// frame is news, and each new mark lands on exactly one acked packet.
+TEST(CongestionEventTest, SendControlAttributesOnlyNewCeMarks) {
+    ASSERT_TRUE(RegisterCongestionControl("batch-recording",
+        []() { return std::unique_ptr<ICongestionControl>(new BatchRecordingCongestionControl()); }));
+    BatchRecordingCongestionControl::batches_.clear();
+
+    auto timer = common::MakeTimer();
+    SendControl send_control(timer);
+    ASSERT_TRUE(send_control.SetCongestionControl(CongestionControlType::kCustom, "batch-recording"));
+    for (uint64_t pn = 1; pn <= 8; ++pn) {
+        send_control.OnPacketSend(pn, MakePacket(pn), kMss);
+    }
+
+    auto ack = std::make_shared<AckEcnFrame>();
+    ack->SetLargestAck(4);
+    ack->SetAckDelay(0);
+    ack->SetFirstAckRange(3);
+    ack->SetEct1(2);
+    ack->SetEcnCe(2);
+    send_control.OnPacketAck(10, PacketNumberSpace::kApplicationNumberSpace, ack);
+
+    ack = std::make_shared<AckEcnFrame>();
+    ack->SetLargestAck(8);
+    ack->SetAckDelay(0);
+    ack->SetFirstAckRange(3);
+    ack->SetEct1(5);
+    ack->SetEcnCe(3);
+    send_control.OnPacketAck(20, PacketNumberSpace::kApplicationNumberSpace, ack);
+
+    ASSERT_EQ(BatchRecordingCongestionControl::batches_.size(), 2u);
+    EXPECT_EQ(BatchRecordingCongestionControl::batches_[0].acked, 4u);
+    EXPECT_EQ(BatchRecordingCongestionControl::batches_[0].ce, 2u);
+    EXPECT_EQ(BatchRecordingCongestionControl::batches_[1].acked, 4u);
+    EXPECT_EQ(BatchRecordingCongestionControl::batches_[1].ce, 1u);
+}
+
+TEST(CongestionEventTest, EcnCodepointFollowsController) {
+    auto timer = common::MakeTimer();
+    SendControl send_control(timer);
+    EXPECT_EQ(send_control.GetEcnCodepoint(), 0x02);  // ECT(0)
+    ASSERT_TRUE(send_control.SetCongestionControl(CongestionControlType::kPrague));
+    EXPECT_EQ(send_control.GetEcnCodepoint(), 0x01);  // ECT(1)
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "quic/congestion_control/prague_congestion_control.h"
+
+using namespace quicx::quic;
+
+namespace {
+
+constexpr uint64_t kMss = 1000;
+
+CcConfigV2 TestConfig() {
+    CcConfigV2 cfg;
+    cfg.mss_bytes = kMss;
+    cfg.initial_cwnd_bytes = 10 * kMss;
+    cfg.min_cwnd_bytes = 2 * kMss;
+    cfg.max_cwnd_bytes = 1000 * kMss;
+    cfg.beta = 0.5;
+    return cfg;
+}
+
+// Sends `count` packets starting at `pn` and acks them in one event, the
+// first `ce` of them CE-marked. Returns the next packet number.
+uint64_t RoundTrip(PragueCongestionControl& cc, uint64_t pn, uint64_t count, uint64_t ce, uint64_t now) {
+    std::vector<AckEvent> acked;
+    for (uint64_t i = 0; i < count; ++i) {
+        cc.OnPacketSent(SentPacketEvent{pn + i, kMss, now});
+        acked.push_back(AckEvent{pn + i, kMss, now + 10000, 0, i < ce, now});
+    }
+    cc.OnCongestionEvent(acked, {}, cc.GetBytesInFlight(), now + 10000);
+    return pn + count;
+}
+
+}  // namespace
+
+TEST(PragueCongestionControlTest, InitialState) {
+    PragueCongestionControl cc;
+    cc.Configure(TestConfig());
+    EXPECT_TRUE(cc.UsesL4sEcn());
+    EXPECT_TRUE(cc.InSlowStart());
+    EXPECT_DOUBLE_EQ(cc.GetAlpha(), 1.0);
+    EXPECT_EQ(cc.GetCongestionWindow(), 10 * kMss);
+}
+
+TEST(PragueCongestionControlTest, FirstCeLeavesSlowStartWithFullAlpha) {
+    PragueCongestionControl cc;
+    cc.Configure(TestConfig());
+    cc.OnPacketSent(SentPacketEvent{1, kMss, 0});
+    cc.OnPacketAcked(AckEvent{1, kMss, 10000, 0, true, 0});
+    // alpha starts at 1: the first mark halves the window, like a loss.
+    EXPECT_FALSE(cc.InSlowStart());
+    EXPECT_FALSE(cc.InRecovery());
+    EXPECT_EQ(cc.GetCongestionWindow(), 5 * kMss);
+    EXPECT_EQ(cc.GetBytesInFlight(), 0u);
+}
+
+TEST(PragueCongestionControlTest, ReductionScalesWithMarkedFraction) {
+    PragueCongestionControl cc;
+    cc.Configure(TestConfig());
+    cc.SetCongestionWindow(100 * kMss, 100 * kMss);
+
+    // Unmarked rounds decay alpha towards zero.
+    uint64_t pn = 1;
+    uint64_t now = 0;
+    for (int round = 0; round < 40; ++round) {
+        pn = RoundTrip(cc, pn, 10, 0, now);
+        now += 10000;
+    }
+    double alpha = cc.GetAlpha();
+    EXPECT_LT(alpha, 0.1);
+
+    // One marked packet in ten: cwnd shrinks by about alpha/2, not by half.
+    uint64_t cwnd = cc.GetCongestionWindow();
+    RoundTrip(cc, pn, 10, 1, now);
+    double expected_alpha = alpha + PragueCongestionControl::kAlphaGain * (0.1 - alpha);
+    EXPECT_NEAR(cc.GetAlpha(), expected_alpha, 1e-9);
+    EXPECT_LT(cc.GetCongestionWindow(), cwnd + 9 * kMss);
+    EXPECT_GT(cc.GetCongestionWindow(), cwnd * 9 / 10);
+}
+
+TEST(PragueCongestionControlTest, ReducesAtMostOncePerRoundTrip) {
+    PragueCongestionControl cc;
+    cc.Configure(TestConfig());
+    cc.SetCongestionWindow(100 * kMss, 100 * kMss);
+    for (uint64_t pn = 1; pn <= 20; ++pn) {
+        cc.OnPacketSent(SentPacketEvent{pn, kMss, 0});
+    }
+    cc.OnPacketAcked(AckEvent{1, kMss, 10000, 0, true, 0});
+    uint64_t reduced = cc.GetCongestionWindow();
+    EXPECT_LT(reduced, 100 * kMss);
+
+    // More marks from the same window: no further cut.
+    cc.OnPacketAcked(AckEvent{2, kMss, 10000, 0, true, 0});
+    cc.OnPacketAcked(AckEvent{3, kMss, 10000, 0, true, 0});
+    EXPECT_EQ(cc.GetCongestionWindow(), reduced);
+
+    // A mark on a packet sent after the reduction cuts again.
+    cc.OnPacketSent(SentPacketEvent{21, kMss, 10000});
+    cc.OnPacketAcked(AckEvent{21, kMss, 20000, 0, true, 10000});
+    EXPECT_LT(cc.GetCongestionWindow(), reduced);
+}
+
+TEST(PragueCongestionControlTest, LossFallsBackToClassicResponse) {
+    PragueCongestionControl cc;
+    cc.Configure(TestConfig());
+    cc.SetCongestionWindow(100 * kMss, UINT64_MAX);
+    cc.OnPacketSent(SentPacketEvent{1, kMss, 0});
+    cc.OnPacketLost(LossEvent{1, kMss, 5000});
+    EXPECT_TRUE(cc.InRecovery());
+    EXPECT_EQ(cc.GetCongestionWindow(), 50 * kMss);
+    EXPECT_EQ(cc.GetSsthresh(), 50 * kMss);
+}
+
+TEST(PragueCongestionControlTest, AdditiveIncreaseOfOneMssPerRound) {
+    PragueCongestionControl cc;
+    cc.Configure(TestConfig());
+    cc.SetCongestionWindow(20 * kMss, 20 * kMss);
+    ASSERT_FALSE(cc.InSlowStart());
+    RoundTrip(cc, 1, 20, 0, 0);
+    EXPECT_NEAR(static_cast<double>(cc.GetCongestionWindow()), 21.0 * kMss, kMss / 2.0);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "quic/config.h"
+#include "quic/connection/controler/ack_frequency_controller.h"
+#include "quic/connection/transport_param.h"
+#include "quic/frame/ack_frequency_frame.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+constexpr uint32_t kMtu = 1200;
+
+TransportParam PeerParams(uint32_t min_ack_delay_us) {
+    QuicTransportParams conf;
+    conf.min_ack_delay_us_ = min_ack_delay_us;
+    conf.max_ack_delay_ms_ = 25;
+    TransportParam tp;
+    tp.Init(conf);
+    return tp;
+}
+
+TEST(AckFrequencyControllerTest, DisabledWithoutPeerMinAckDelay) {
+    AckFrequencyController controller;
+    controller.UpdateConfig(PeerParams(0));
+    EXPECT_FALSE(controller.IsEnabled());
+    EXPECT_EQ(controller.MayGenerateFrame(1000, 1000 * kMtu, 20, kMtu), nullptr);
+}
+
+TEST(AckFrequencyControllerTest, SmallWindowKeepsDefaultAckRate) {
+    AckFrequencyController controller;
+    controller.UpdateConfig(PeerParams(1000));
+    EXPECT_EQ(controller.MayGenerateFrame(1000, (kAckFrequencyMinCwndPackets - 1) * kMtu, 20, kMtu), nullptr);
+}
+
+TEST(AckFrequencyControllerTest, LargeWindowRequestsSparserAcks) {
+    AckFrequencyController controller;
+    controller.UpdateConfig(PeerParams(1000));
+
+    auto frame = controller.MayGenerateFrame(1000, 256 * kMtu, 40, kMtu);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->GetSequenceNumber(), 0u);
+    EXPECT_EQ(frame->GetAckElicitingThreshold(), 256 / kAckFrequencyAcksPerCwnd);
+    EXPECT_EQ(frame->GetRequestMaxAckDelay(), 10000u);  // srtt / 4
+    EXPECT_EQ(frame->GetReorderingThreshold(), kAckFrequencyReorderingThreshold);
+
+    // Small changes of the window do not produce another frame.
+    EXPECT_EQ(controller.MayGenerateFrame(2000, 300 * kMtu, 40, kMtu), nullptr);
+
+    // Doubling does, but at most once per RTT.
+    EXPECT_EQ(controller.MayGenerateFrame(1010, 1024 * kMtu, 40, kMtu), nullptr);
+    frame = controller.MayGenerateFrame(2000, 1024 * kMtu, 40, kMtu);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->GetSequenceNumber(), 1u);
+    EXPECT_EQ(frame->GetAckElicitingThreshold(), kMaxAckElicitingThreshold);
+}
+
+TEST(AckFrequencyControllerTest, CollapsedWindowRestoresDefault) {
+    AckFrequencyController controller;
+    controller.UpdateConfig(PeerParams(1000));
+    ASSERT_NE(controller.MayGenerateFrame(1000, 256 * kMtu, 40, kMtu), nullptr);
+
+    auto frame = controller.MayGenerateFrame(2000, 10 * kMtu, 40, kMtu);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->GetAckElicitingThreshold(), 1u);
+}
+
+TEST(AckFrequencyControllerTest, RequestedDelayIsBounded) {
+    AckFrequencyController controller;
+    controller.UpdateConfig(PeerParams(5000));
+
+    // srtt / 4 = 1ms is below the peer's min_ack_delay.
+    auto frame = controller.MayGenerateFrame(1000, 256 * kMtu, 4, kMtu);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->GetRequestMaxAckDelay(), 5000u);
+
+    // srtt / 4 = 100ms is above the peer's max_ack_delay (25ms).
+    frame = controller.MayGenerateFrame(5000, 10 * kMtu, 400, kMtu);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->GetRequestMaxAckDelay(), 25000u);
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
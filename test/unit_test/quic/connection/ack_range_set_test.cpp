@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "quic/config.h"
+#include "quic/connection/controler/ack_range_set.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+TEST(AckRangeSetTest, InOrderPacketsExtendOneRange) {
+    AckRangeSet set;
+    for (uint64_t pn = 0; pn < 100; ++pn) {
+        EXPECT_TRUE(set.Add(pn));
+    }
+    ASSERT_EQ(set.Size(), 1u);
+    EXPECT_EQ(set[0].low, 0u);
+    EXPECT_EQ(set[0].high, 99u);
+    EXPECT_EQ(set.Largest(), 99u);
+}
+
+TEST(AckRangeSetTest, GapsAreOrderedDescending) {
+    AckRangeSet set;
+    set.Add(1);
+    set.Add(2);
+    set.Add(5);
+    set.Add(9);
+    ASSERT_EQ(set.Size(), 3u);
+    EXPECT_EQ(set[0].low, 9u);
+    EXPECT_EQ(set[1].low, 5u);
+    EXPECT_EQ(set[2].low, 1u);
+    EXPECT_EQ(set[2].high, 2u);
+}
+
+TEST(AckRangeSetTest, OutOfOrderFillsAndMergesGaps) {
+    AckRangeSet set;
+    set.Add(1);
+    set.Add(3);
+    set.Add(5);
+    ASSERT_EQ(set.Size(), 3u);
+
+    EXPECT_TRUE(set.Add(4));  // joins [3] and [5]
+    ASSERT_EQ(set.Size(), 2u);
+    EXPECT_EQ(set[0].low, 3u);
+    EXPECT_EQ(set[0].high, 5u);
+
+    EXPECT_TRUE(set.Add(2));  // joins [1] and [3..5]
+    ASSERT_EQ(set.Size(), 1u);
+    EXPECT_EQ(set[0].low, 1u);
+    EXPECT_EQ(set[0].high, 5u);
+
+    EXPECT_TRUE(set.Add(0));  // extends the oldest range downward
+    EXPECT_EQ(set[0].low, 0u);
+}
+
+TEST(AckRangeSetTest, DuplicatesAreReported) {
+    AckRangeSet set;
+    set.Add(10);
+    set.Add(11);
+    set.Add(20);
+    EXPECT_FALSE(set.Add(10));
+    EXPECT_FALSE(set.Add(20));
+    EXPECT_TRUE(set.Contains(11));
+    EXPECT_FALSE(set.Contains(15));
+    EXPECT_EQ(set.Size(), 2u);
+}
+
+TEST(AckRangeSetTest, RemoveUpToDropsAndTrimsRanges) {
+    AckRangeSet set;
+    for (uint64_t pn : {1, 2, 3, 6, 7, 8, 12}) {
+        set.Add(pn);
+    }
+    EXPECT_TRUE(set.RemoveUpTo(6));
+    ASSERT_EQ(set.Size(), 2u);
+    EXPECT_EQ(set[0].low, 12u);
+    EXPECT_EQ(set[1].low, 7u);
+    EXPECT_EQ(set[1].high, 8u);
+
+    // Packets at or below the floor are not re-added.
+    EXPECT_FALSE(set.Add(5));
+    EXPECT_FALSE(set.RemoveUpTo(6));
+
+    EXPECT_TRUE(set.RemoveUpTo(100));
+    EXPECT_TRUE(set.Empty());
+}
+
+TEST(AckRangeSetTest, HistoryIsBounded) {
+    AckRangeSet set;
+    // Every other packet number: each one opens a new range.
+    for (uint64_t i = 0; i < kMaxAckRanges + 10; ++i) {
+        set.Add(i * 2);
+    }
+    ASSERT_EQ(set.Size(), kMaxAckRanges);
+    EXPECT_EQ(set.Largest(), (kMaxAckRanges + 9) * 2);
+    // The oldest ranges were forgotten first.
+    EXPECT_FALSE(set.Contains(0));
+    EXPECT_TRUE(set.Contains(20));
+
+    // A packet older than everything we hold is dropped while full.
+    EXPECT_FALSE(set.Add(1));
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
@@ -31,6 +31,10 @@ public:
         return true;
     }
 
+    // only TimerTasks are recorded, the connection's own timers are nodes
+    void ArmTimer(common::TimerNode& /*node*/, uint32_t /*time*/, uint64_t /*now*/ = 0) override {}
+    bool DisarmTimer(common::TimerNode& /*node*/) override { return true; }
+
     int32_t MinTime(uint64_t /*now*/ = 0) override { return entries_.empty() ? -1 : static_cast<int32_t>(entries_.front().timeout_ms); }
     void TimerRun(uint64_t /*now*/ = 0) override {}
     bool Empty() override { return entries_.empty(); }
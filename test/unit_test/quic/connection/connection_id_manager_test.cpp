@@ -82,6 +82,36 @@ TEST(ConnectionIDManagerTest, UseNextIdAdvancesCurrent) {
     EXPECT_FALSE(manager.UseNextID());  // Only one ID left
 }
 
+TEST(ConnectionIDManagerTest, UseIdSwitchesFromHandshakeCid) {
+    // Client side: the server's SCID from the handshake is current but not in
+    // the pool, which holds only the CID of the preferred_address (seq 1).
+    std::vector<uint64_t> retired_sequences;
+    ConnectionIDManager manager(nullptr, [&](ConnectionID& id) { retired_sequences.push_back(id.GetSequenceNumber()); });
+    uint8_t handshake[] = {1, 2, 3, 4};
+    uint8_t preferred[] = {5, 6, 7, 8};
+    ConnectionID preferred_cid(preferred, sizeof(preferred), 1);
+    manager.AddID(preferred_cid);
+    manager.SetCurrentID(handshake, sizeof(handshake), 0);
+
+    // UseNextID() needs two pooled CIDs, the explicit switch does not
+    EXPECT_FALSE(manager.UseNextID());
+    EXPECT_FALSE(manager.UseID(2));
+    EXPECT_TRUE(manager.UseID(1));
+    EXPECT_TRUE(manager.GetCurrentID() == preferred_cid);
+    // the handshake CID was never pooled, the caller retires it on the wire
+    EXPECT_TRUE(retired_sequences.empty());
+    EXPECT_EQ(manager.GetAvailableIDCount(), 1u);
+
+    // switching away from a pooled CID drops it
+    uint8_t next[] = {9, 10, 11, 12};
+    ConnectionID next_cid(next, sizeof(next), 2);
+    manager.AddID(next_cid);
+    EXPECT_TRUE(manager.UseID(2));
+    ASSERT_EQ(retired_sequences.size(), 1u);
+    EXPECT_EQ(retired_sequences[0], 1u);
+    EXPECT_EQ(manager.GetAvailableIDCount(), 1u);
+}
+
 }  // namespace
 }  // namespace quic
 }  // namespace quicx
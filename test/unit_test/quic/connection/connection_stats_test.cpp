@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/timer/timing_wheel_timer.h"
+#include "common/util/time.h"
+#include "quic/connection/connection_stats.h"
+#include "quic/connection/controler/send_manager.h"
+#include "quic/frame/ack_frame.h"
+#include "quic/frame/max_data_frame.h"
+#include "quic/packet/rtt_1_packet.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+TEST(ConnectionStatsSnapshotTest, ReadReturnsLastPublished) {
+    ConnectionStatsSnapshot snapshot;
+    QuicConnectionStats stats;
+    EXPECT_FALSE(snapshot.Read(stats));
+
+    stats.smoothed_rtt_ms_ = 25;
+    stats.packets_sent_ = 3;
+    stats.flow_control_blocked_ms_ = 7;
+    snapshot.Publish(stats);
+    stats.packets_sent_ = 4;
+    snapshot.Publish(stats);
+
+    QuicConnectionStats read;
+    ASSERT_TRUE(snapshot.Read(read));
+    EXPECT_EQ(read.smoothed_rtt_ms_, 25u);
+    EXPECT_EQ(read.packets_sent_, 4u);
+    EXPECT_EQ(read.flow_control_blocked_ms_, 7u);
+}
+
+TEST(ConnectionStatsSnapshotTest, ReaderNeverSeesTornSnapshot) {
+    ConnectionStatsSnapshot snapshot;
+    std::atomic<bool> done{false};
+
+    // every field of snapshot i holds i
+    std::thread writer([&]() {
+        for (uint64_t i = 1; i <= 20000; i++) {
+            QuicConnectionStats stats;
+            uint64_t* fields = reinterpret_cast<uint64_t*>(&stats);
+            for (size_t f = 0; f < sizeof(stats) / sizeof(uint64_t); f++) {
+                fields[f] = i;
+            }
+            snapshot.Publish(stats);
+        }
+        done.store(true);
+    });
+
+    uint64_t torn = 0;
+    while (!done.load()) {
+        QuicConnectionStats stats;
+        if (!snapshot.Read(stats)) {
+            continue;
+        }
+        const uint64_t* fields = reinterpret_cast<const uint64_t*>(&stats);
+        for (size_t f = 1; f < sizeof(stats) / sizeof(uint64_t); f++) {
+            if (fields[f] != fields[0]) {
+                torn++;
+                break;
+            }
+        }
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0u);
+}
+
+class SendManagerStatsTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        timer_ = std::make_shared<common::TimingWheelTimer>();
+        send_manager_ = std::make_unique<SendManager>(timer_);
+    }
+
+    void Send(uint32_t pkt_len) {
+        uint64_t pn = send_manager_->GetPacketNumber().NextPacketNumber(kApplicationNumberSpace);
+        auto packet = std::make_shared<Rtt1Packet>();
+        packet->SetPacketNumber(pn);
+        packet->GetHeader()->SetPacketNumberLength(PacketNumber::GetPacketNumberLength(pn));
+        packet->AddFrameTypeBit(FrameTypeBit::kMaxDataBit);
+        std::vector<std::shared_ptr<IFrame>> frames = {std::make_shared<MaxDataFrame>()};
+        send_manager_->GetSendControl().OnPacketSend(
+            common::UTCTimeMsec(), packet, pkt_len, std::vector<StreamDataInfo>(), std::move(frames));
+    }
+
+    std::shared_ptr<common::TimingWheelTimer> timer_;
+    std::unique_ptr<SendManager> send_manager_;
+};
+
+TEST_F(SendManagerStatsTest, CountsSentLostAndRetransmitted) {
+    Send(1200);
+    Send(800);
+
+    QuicConnectionStats stats;
+    send_manager_->FillStats(stats);
+    EXPECT_EQ(stats.packets_sent_, 2u);
+    EXPECT_EQ(stats.bytes_sent_, 2000u);
+    EXPECT_EQ(stats.bytes_in_flight_, 2000u);
+    EXPECT_GT(stats.cwnd_bytes_, 0u);
+    EXPECT_EQ(stats.mtu_, send_manager_->GetMaxPacketSize());
+    EXPECT_EQ(stats.packets_lost_, 0u);
+
+    // acking packet 5 alone leaves 1 and 2 three packets behind (RFC 9002
+    // §6.1.1); their MAX_DATA frames are queued again, so both count as
+    // retransmitted
+    Send(100);
+    Send(100);
+    Send(100);
+    auto ack = std::make_shared<AckFrame>();
+    ack->SetLargestAck(5);
+    ack->SetAckDelay(0);
+    ack->SetFirstAckRange(0);
+    send_manager_->OnPacketAck(PacketNumberSpace::kApplicationNumberSpace, ack);
+
+    QuicConnectionStats after;
+    send_manager_->FillStats(after);
+    EXPECT_EQ(after.packets_sent_, 5u);
+    EXPECT_EQ(after.packets_lost_, 2u);
+    EXPECT_EQ(after.bytes_lost_, 2000u);
+    EXPECT_EQ(after.packets_retransmitted_, 2u);
+    EXPECT_EQ(after.bytes_in_flight_, 200u);
+}
+
+TEST_F(SendManagerStatsTest, BandwidthEstimateFallsBackToCwndPerRtt) {
+    auto& send_control = send_manager_->GetSendControl();
+    // no RTT sample yet
+    EXPECT_EQ(send_control.GetBandwidthEstimate(), 0u);
+
+    uint64_t now = common::UTCTimeMsec();
+    send_control.GetRttCalculator().UpdateRtt(now - 50, now, 0);
+    uint32_t srtt = send_control.GetRtt();
+    ASSERT_GT(srtt, 0u);
+    // cubic keeps no bandwidth model
+    EXPECT_EQ(send_control.GetBandwidthEstimate(), send_control.GetCongestionWindow() * 1000 / srtt);
+}
+
+TEST_F(SendManagerStatsTest, SendBudgetAndAppLimited) {
+    uint64_t cwnd = send_manager_->GetSendControl().GetCongestionWindow();
+    EXPECT_EQ(send_manager_->GetSendBudget(), cwnd);
+    Send(1200);
+    EXPECT_EQ(send_manager_->GetSendBudget(), cwnd - 1200);
+
+    // connection-level MAX_DATA credit caps it too
+    SendFlowController flow_controller(StreamIDGenerator::StreamStarter::kClient);
+    flow_controller.OnMaxDataReceived(1000);
+    send_manager_->SetSendFlowController(&flow_controller);
+    EXPECT_EQ(send_manager_->GetSendBudget(), 1000u);
+
+    EXPECT_FALSE(send_manager_->IsAppLimited());
+    send_manager_->SetAppLimited();
+    QuicConnectionStats stats;
+    send_manager_->FillStats(stats);
+    EXPECT_EQ(stats.app_limited_, 1u);
+    // the period ends once the congestion window limits sending again
+    send_manager_->SetCwndLimited();
+    EXPECT_FALSE(send_manager_->IsAppLimited());
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/buffer/standalone_buffer_chunk.h"
+#include "quic/config.h"
+#include "quic/connection/controler/datagram_queue.h"
+#include "quic/frame/datagram_frame.h"
+#include "quic/stream/fix_buffer_frame_visitor.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+common::SharedBufferSpan MakeSpan(uint32_t len, uint8_t fill = 0xab) {
+    auto chunk = std::make_shared<common::StandaloneBufferChunk>(len > 0 ? len : 1);
+    memset(chunk->GetData(), fill, len);
+    return common::SharedBufferSpan(chunk, chunk->GetData(), len);
+}
+
+class DatagramQueueTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        queue_.SetPeerMaxFrameSize(1200);
+        queue_.SetStatusCallback([this](uint64_t id, DatagramStatus status) { reports_.emplace_back(id, status); });
+    }
+
+    DatagramQueue queue_;
+    std::vector<std::pair<uint64_t, DatagramStatus>> reports_;
+};
+
+TEST_F(DatagramQueueTest, PeerLimitGatesPush) {
+    DatagramQueue disabled;
+    EXPECT_EQ(disabled.GetMaxPayloadSize(), 0u);
+    EXPECT_FALSE(disabled.Push(1, MakeSpan(10), 0));
+
+    // the frame limit includes type and Length field
+    uint32_t max_payload = queue_.GetMaxPayloadSize();
+    EXPECT_EQ(max_payload + DatagramFrame::GetOverhead(max_payload), 1200u);
+    EXPECT_TRUE(queue_.Push(1, MakeSpan(max_payload), 0));
+    EXPECT_FALSE(queue_.Push(2, MakeSpan(max_payload + 1), 0));
+    EXPECT_EQ(queue_.Size(), 1u);
+    // a refused push is not reported, the caller sees it directly
+    EXPECT_TRUE(reports_.empty());
+}
+
+TEST_F(DatagramQueueTest, QueueIsBounded) {
+    for (size_t i = 0; i < kMaxDatagramQueueSize; i++) {
+        EXPECT_TRUE(queue_.Push(i + 1, MakeSpan(8), 0));
+    }
+    EXPECT_FALSE(queue_.Push(kMaxDatagramQueueSize + 1, MakeSpan(8), 0));
+}
+
+TEST_F(DatagramQueueTest, BuildPacksInOrderUntilPacketIsFull) {
+    EXPECT_TRUE(queue_.Push(1, MakeSpan(700, 1), 0));
+    EXPECT_TRUE(queue_.Push(2, MakeSpan(700, 2), 0));
+    EXPECT_TRUE(queue_.Push(3, MakeSpan(100, 3), 0));
+
+    FixBufferFrameVisitor visitor(1400);
+    // the second one does not fit what is left and keeps its place
+    EXPECT_EQ(queue_.BuildFrames(&visitor, 1000, 1400), 1u);
+    EXPECT_EQ(queue_.Size(), 2u);
+
+    auto frames = visitor.TakeControlFrames();
+    ASSERT_EQ(frames.size(), 1u);
+    auto frame = std::static_pointer_cast<DatagramFrame>(frames[0]);
+    EXPECT_EQ(frame->GetDatagramId(), 1u);
+    // only the id is kept with the packet
+    EXPECT_EQ(frame->GetData().GetLength(), 0u);
+
+    FixBufferFrameVisitor next(1400);
+    EXPECT_EQ(queue_.BuildFrames(&next, 1000, 1400), 2u);
+    EXPECT_TRUE(queue_.Empty());
+    EXPECT_TRUE(reports_.empty());
+}
+
+TEST_F(DatagramQueueTest, ExpiredAndOversizedAreReported) {
+    EXPECT_TRUE(queue_.Push(1, MakeSpan(50), 1500));
+    EXPECT_TRUE(queue_.Push(2, MakeSpan(1000), 0));
+    EXPECT_TRUE(queue_.Push(3, MakeSpan(50), 0));
+
+    // the path shrank below datagram 2 after it was queued
+    FixBufferFrameVisitor visitor(900);
+    EXPECT_EQ(queue_.BuildFrames(&visitor, 2000, 900), 1u);
+    ASSERT_EQ(reports_.size(), 2u);
+    EXPECT_EQ(reports_[0], std::make_pair(uint64_t(1), DatagramStatus::kExpired));
+    EXPECT_EQ(reports_[1], std::make_pair(uint64_t(2), DatagramStatus::kDropped));
+
+    queue_.OnAcked(3);
+    EXPECT_EQ(reports_.back(), std::make_pair(uint64_t(3), DatagramStatus::kAcked));
+}
+
+TEST_F(DatagramQueueTest, ClearReportsDropped) {
+    EXPECT_TRUE(queue_.Push(1, MakeSpan(10), 0));
+    EXPECT_TRUE(queue_.Push(2, MakeSpan(10), 0));
+    queue_.Clear();
+    EXPECT_TRUE(queue_.Empty());
+    ASSERT_EQ(reports_.size(), 2u);
+    EXPECT_EQ(reports_[0].second, DatagramStatus::kDropped);
+    EXPECT_EQ(reports_[1].second, DatagramStatus::kDropped);
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
@@ -16,6 +16,8 @@ class TestTimer : public common::ITimer {
 public:
     uint64_t AddTimer(common::TimerTask& task, uint32_t time, uint64_t now = 0) override { return 1; }
     bool RemoveTimer(common::TimerTask& task) override { return true; }
+    void ArmTimer(common::TimerNode& node, uint32_t time, uint64_t now = 0) override {}
+    bool DisarmTimer(common::TimerNode& node) override { return true; }
     int32_t MinTime(uint64_t now = 0) override { return -1; }
     void TimerRun(uint64_t now = 0) override {}
     bool Empty() override { return true; }
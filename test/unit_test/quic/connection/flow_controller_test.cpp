@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 
+#include "common/util/time.h"
 #include "quic/connection/transport_param.h"
 #include "quic/frame/data_blocked_frame.h"
 #include "quic/frame/max_data_frame.h"
@@ -119,6 +120,24 @@ TEST_F(SendFlowControllerTest, OnMaxDataReceivedIncreasesLimit) {
     EXPECT_EQ(can_send_size, 10000u);  // 20000 - 10000
 }
 
+// Test: time spent blocked on MAX_DATA is accumulated until the limit rises
+TEST_F(SendFlowControllerTest, BlockedTimeCoversStallUntilMaxData) {
+    uint64_t start = common::UTCTimeMsec();
+    EXPECT_EQ(controller_->GetBlockedTime(start + 1000), 0u);
+
+    controller_->OnDataSent(10000);
+    uint64_t can_send_size = 0;
+    std::shared_ptr<IFrame> blocked_frame;
+    EXPECT_FALSE(controller_->CanSendData(can_send_size, blocked_frame));
+    // a stall in progress counts up to now
+    EXPECT_GE(controller_->GetBlockedTime(start + 1000), 900u);
+
+    controller_->OnMaxDataReceived(20000);
+    uint64_t blocked = controller_->GetBlockedTime(common::UTCTimeMsec());
+    // once unblocked it no longer grows
+    EXPECT_EQ(controller_->GetBlockedTime(common::UTCTimeMsec() + 1000), blocked);
+}
+
 // Test: OnMaxDataReceived ignores non-increasing limits (RFC 9000 Section 4.1)
 TEST_F(SendFlowControllerTest, OnMaxDataReceivedIgnoresNonIncreasingLimits) {
     controller_->OnMaxDataReceived(5000);  // Lower than current limit
@@ -285,8 +304,9 @@ TEST_F(RecvFlowControllerTest, OnDataReceivedDetectsViolation) {
 
 // Test: ShouldSendMaxData generates MAX_DATA frame when near limit
 TEST_F(RecvFlowControllerTest, ShouldSendMaxDataGeneratesFrameNearLimit) {
-    // Receive data close to the limit (threshold is 8912)
+    // Receive and consume data close to the limit
     controller_->OnDataReceived(9999);
+    controller_->OnDataConsumed(9999);
 
     std::shared_ptr<IFrame> max_data_frame;
     EXPECT_TRUE(controller_->ShouldSendMaxData(max_data_frame));
@@ -307,6 +327,57 @@ TEST_F(RecvFlowControllerTest, ShouldSendMaxDataNoFrameWhenRoomRemains) {
     EXPECT_EQ(max_data_frame, nullptr);  // No frame needed
 }
 
+// Test: only data the application consumed is credited back
+TEST_F(RecvFlowControllerTest, ShouldSendMaxDataWaitsForConsumption) {
+    controller_->OnDataReceived(9000);
+
+    std::shared_ptr<IFrame> max_data_frame;
+    EXPECT_TRUE(controller_->ShouldSendMaxData(max_data_frame));
+    EXPECT_EQ(max_data_frame, nullptr);  // nothing read yet
+
+    controller_->OnDataConsumed(4999);
+    EXPECT_TRUE(controller_->ShouldSendMaxData(max_data_frame));
+    EXPECT_EQ(max_data_frame, nullptr);  // more than half the window left
+
+    controller_->OnDataConsumed(1);
+    EXPECT_TRUE(controller_->ShouldSendMaxData(max_data_frame));
+    auto max_data = std::dynamic_pointer_cast<MaxDataFrame>(max_data_frame);
+    ASSERT_NE(max_data, nullptr);
+    EXPECT_EQ(max_data->GetMaximumData(), 15000u);  // consumed + window
+    EXPECT_EQ(controller_->GetMaxData(), 15000u);
+}
+
+// Test: DATA_BLOCKED hands back consumed bytes without waiting for half a window
+TEST_F(RecvFlowControllerTest, ShouldSendMaxDataWhenPeerBlocked) {
+    controller_->OnDataReceived(10000);
+    controller_->OnDataConsumed(1000);
+
+    std::shared_ptr<IFrame> max_data_frame;
+    EXPECT_TRUE(controller_->ShouldSendMaxData(max_data_frame, 1000, 50, true));
+    auto max_data = std::dynamic_pointer_cast<MaxDataFrame>(max_data_frame);
+    ASSERT_NE(max_data, nullptr);
+    EXPECT_EQ(max_data->GetMaximumData(), 11000u);
+}
+
+// Test: a window drained quickly grows
+TEST_F(RecvFlowControllerTest, WindowGrowsWhenDrainedWithinTwoRtts) {
+    std::shared_ptr<IFrame> max_data_frame;
+    uint64_t now = 1000;
+    controller_->OnDataReceived(5000);
+    controller_->OnDataConsumed(5000);
+    EXPECT_TRUE(controller_->ShouldSendMaxData(max_data_frame, now, 50));
+    EXPECT_EQ(controller_->GetWindow(), 10000u);
+
+    now += 20;
+    controller_->OnDataReceived(5000);
+    controller_->OnDataConsumed(5000);
+    max_data_frame.reset();
+    EXPECT_TRUE(controller_->ShouldSendMaxData(max_data_frame, now, 50));
+    ASSERT_NE(max_data_frame, nullptr);
+    EXPECT_EQ(controller_->GetWindow(), 20000u);
+    EXPECT_EQ(controller_->GetMaxData(), 30000u);
+}
+
 // Test: ShouldSendMaxData returns false after violation
 TEST_F(RecvFlowControllerTest, ShouldSendMaxDataReturnsFalseAfterViolation) {
     controller_->OnDataReceived(10001);  // Exceed limit
@@ -85,6 +85,9 @@ static QuicTransportParams TEST_TRANSPORT_PARAMS = {
     false,     // disable_active_migration
     "",        // preferred_address
     8,         // active_connection_id_limit
+    1000,      // min_ack_delay_us
+    0,         // max_datagram_frame_size
+    0,         // initial_max_path_id
     "",        // initial_source_connection_id
     "",        // retry_source_connection_id
 };
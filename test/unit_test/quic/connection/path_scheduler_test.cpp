@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "common/timer/timing_wheel_timer.h"
+#include "common/util/time.h"
+#include "quic/connection/controler/path_scheduler.h"
+#include "quic/connection/controler/send_manager.h"
+#include "quic/frame/path_ack_frame.h"
+#include "quic/frame/max_data_frame.h"
+#include "quic/packet/rtt_1_packet.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+TEST(PathSchedulerTest, MinRttPrefersFastestPathWithRoom) {
+    MinRttPathScheduler scheduler;
+    std::vector<PathCandidate> paths = {
+        {0, 80, 12000, true},
+        {1, 20, 12000, true},
+        {2, 10, 12000, false},  // not validated
+    };
+    EXPECT_EQ(scheduler.SelectPath(paths, 1200), 1u);
+
+    // the fast path's window is full: spill over to the slower one
+    paths[1].send_window = 0;
+    EXPECT_EQ(scheduler.SelectPath(paths, 1200), 0u);
+
+    paths[0].send_window = 1000;
+    EXPECT_EQ(scheduler.SelectPath(paths, 1200), kInvalidPathId);
+
+    // equal RTTs keep path 0
+    std::vector<PathCandidate> tie = {{1, 30, 12000, true}, {0, 30, 12000, true}};
+    EXPECT_EQ(scheduler.SelectPath(tie, 1200), 0u);
+}
+
+TEST(PathSchedulerTest, RoundRobinRotatesOverPathsWithRoom) {
+    RoundRobinPathScheduler scheduler;
+    std::vector<PathCandidate> paths = {
+        {0, 80, 12000, true},
+        {1, 20, 12000, true},
+        {2, 10, 12000, true},
+    };
+    EXPECT_EQ(scheduler.SelectPath(paths, 1200), 0u);
+    EXPECT_EQ(scheduler.SelectPath(paths, 1200), 1u);
+    EXPECT_EQ(scheduler.SelectPath(paths, 1200), 2u);
+    EXPECT_EQ(scheduler.SelectPath(paths, 1200), 0u);
+
+    // a blocked path loses its turn
+    paths[1].send_window = 0;
+    EXPECT_EQ(scheduler.SelectPath(paths, 1200), 2u);
+
+    // path 2 goes away while it was the last served: path 0 is next
+    paths.pop_back();
+    EXPECT_EQ(scheduler.SelectPath(paths, 1200), 0u);
+
+    EXPECT_EQ(MakePathScheduler(PathSchedulerType::kRoundRobin)->GetType(), PathSchedulerType::kRoundRobin);
+    EXPECT_EQ(MakePathScheduler(PathSchedulerType::kMinRtt)->GetType(), PathSchedulerType::kMinRtt);
+}
+
+class MultipathSendManagerTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        timer_ = std::make_shared<common::TimingWheelTimer>();
+        send_manager_ = std::make_unique<SendManager>(timer_);
+    }
+
+    // Send one ack-eliciting 1-RTT packet on `path_id`, carrying `frame`.
+    uint64_t SendOnPath(uint64_t path_id, std::shared_ptr<IFrame> frame) {
+        uint64_t pn = send_manager_->GetPathPacketNumber(path_id)->NextPacketNumber(kApplicationNumberSpace);
+        auto packet = std::make_shared<Rtt1Packet>();
+        packet->SetPacketNumber(pn);
+        packet->GetHeader()->SetPacketNumberLength(PacketNumber::GetPacketNumberLength(pn));
+        packet->AddFrameTypeBit(FrameTypeBit::kMaxDataBit);
+        std::vector<std::shared_ptr<IFrame>> frames = {frame};
+        send_manager_->GetPathSendControl(path_id)->OnPacketSend(
+            common::UTCTimeMsec(), packet, 1200, std::vector<StreamDataInfo>(), std::move(frames));
+        return pn;
+    }
+
+    std::shared_ptr<common::TimingWheelTimer> timer_;
+    std::unique_ptr<SendManager> send_manager_;
+};
+
+TEST_F(MultipathSendManagerTest, PathsHaveTheirOwnPacketNumberSpace) {
+    EXPECT_FALSE(send_manager_->AddPath(0));
+    EXPECT_TRUE(send_manager_->AddPath(1));
+    EXPECT_FALSE(send_manager_->AddPath(1));
+    EXPECT_EQ(send_manager_->GetPathCount(), 2u);
+    EXPECT_EQ(send_manager_->GetPathSendControl(2), nullptr);
+
+    uint64_t pn0 = SendOnPath(0, std::make_shared<MaxDataFrame>());
+    uint64_t pn1 = SendOnPath(1, std::make_shared<MaxDataFrame>());
+    EXPECT_EQ(pn0, pn1);
+
+    // the ACK of path 1 only reaches path 1
+    auto ack = std::make_shared<PathAckFrame>();
+    ack->SetPathId(1);
+    ack->SetLargestAck(pn1);
+    ack->SetAckDelay(0);
+    ack->SetFirstAckRange(0);
+    send_manager_->OnPathAck(1, ack);
+    EXPECT_EQ(send_manager_->GetPathSendControl(1)->GetTrackedPacketCountForTest(kApplicationNumberSpace), 0u);
+    EXPECT_EQ(send_manager_->GetPathSendControl(0)->GetTrackedPacketCountForTest(kApplicationNumberSpace), 1u);
+
+    // an ACK for an unknown path is ignored
+    send_manager_->OnPathAck(7, ack);
+}
+
+TEST_F(MultipathSendManagerTest, MinRttSchedulingFollowsPerPathRtt) {
+    ASSERT_TRUE(send_manager_->AddPath(1));
+    // not validated yet
+    EXPECT_EQ(send_manager_->SelectPath(), 0u);
+    send_manager_->SetPathUsable(1, true);
+    uint64_t now = common::UTCTimeMsec();
+    send_manager_->GetPathSendControl(0)->GetRttCalculator().UpdateRtt(now - 90, now, 0);
+    send_manager_->GetPathSendControl(1)->GetRttCalculator().UpdateRtt(now - 15, now, 0);
+    EXPECT_EQ(send_manager_->GetPathSchedulerType(), PathSchedulerType::kMinRtt);
+    EXPECT_EQ(send_manager_->SelectPath(), 1u);
+
+    // path 0 is not usable while it is being validated
+    send_manager_->SetStreamsAllowed(false);
+    EXPECT_EQ(send_manager_->SelectPath(), 1u);
+    send_manager_->SetStreamsAllowed(true);
+
+    send_manager_->SetPathScheduler(PathSchedulerType::kRoundRobin);
+    uint64_t first = send_manager_->SelectPath();
+    uint64_t second = send_manager_->SelectPath();
+    EXPECT_NE(first, second);
+}
+
+TEST_F(MultipathSendManagerTest, BackupPathOnlyWhenNoOtherIsUsable) {
+    ASSERT_TRUE(send_manager_->AddPath(1));
+    send_manager_->SetPathUsable(1, true);
+    uint64_t now = common::UTCTimeMsec();
+    send_manager_->GetPathSendControl(0)->GetRttCalculator().UpdateRtt(now - 90, now, 0);
+    send_manager_->GetPathSendControl(1)->GetRttCalculator().UpdateRtt(now - 15, now, 0);
+
+    send_manager_->SetPathBackup(1, true);
+    EXPECT_EQ(send_manager_->SelectPath(), 0u);
+
+    // path 0 is being validated: the backup path is all there is
+    send_manager_->SetStreamsAllowed(false);
+    EXPECT_EQ(send_manager_->SelectPath(), 1u);
+    send_manager_->SetStreamsAllowed(true);
+
+    send_manager_->SetPathBackup(1, false);
+    EXPECT_EQ(send_manager_->SelectPath(), 1u);
+}
+
+TEST_F(MultipathSendManagerTest, AbandonedPathDataIsResent) {
+    ASSERT_TRUE(send_manager_->AddPath(1));
+    auto frame = std::make_shared<MaxDataFrame>();
+    frame->SetMaximumData(4096);
+    SendOnPath(1, frame);
+
+    EXPECT_TRUE(send_manager_->AbandonPath(1));
+    EXPECT_FALSE(send_manager_->AbandonPath(1));
+    EXPECT_FALSE(send_manager_->HasPath(1));
+    EXPECT_EQ(send_manager_->SelectPath(), 0u);
+
+    // the frame in flight on path 1 is queued again for the other paths
+    auto pending = send_manager_->GetPendingFrames(EncryptionLevel::kApplication, 1200);
+    ASSERT_EQ(pending.size(), 1u);
+    EXPECT_EQ(pending[0], frame);
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
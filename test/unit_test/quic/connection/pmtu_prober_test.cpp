@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "common/timer/treemap_timer.h"
+#include "common/util/time.h"
+#include "quic/common/constants.h"
+#include "quic/connection/controler/pmtu_prober.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+// Drives the prober against a path that carries datagrams up to path_mtu.
+class PmtuProberTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        timer_ = std::make_shared<common::TreeMapTimer>();
+        prober_ = std::make_unique<PmtuProber>(timer_);
+    }
+
+    // Send the due probe and deliver its outcome. Returns its size, 0 if none was due.
+    uint16_t Probe(uint16_t path_mtu) {
+        uint16_t size = prober_->GetProbeSize();
+        if (size == 0) {
+            return 0;
+        }
+        uint64_t pn = next_pn_++;
+        prober_->OnProbeSent(pn, size);
+        if (size <= path_mtu) {
+            prober_->OnPacketAcked(pn, size, true);
+        } else {
+            prober_->OnPacketLost(pn, size, true);
+        }
+        return size;
+    }
+
+    void RunSearch(uint16_t path_mtu) {
+        for (int i = 0; i < 100 && Probe(path_mtu) > 0; i++) {
+        }
+    }
+
+    std::shared_ptr<common::TreeMapTimer> timer_;
+    std::unique_ptr<PmtuProber> prober_;
+    uint64_t next_pn_ = 1;
+};
+
+TEST_F(PmtuProberTest, NoProbeBeforeStart) {
+    EXPECT_EQ(prober_->GetState(), PmtuProber::State::kBase);
+    EXPECT_EQ(prober_->GetMtuLimit(), kDefaultPlpmtu);
+    EXPECT_EQ(prober_->GetProbeSize(), 0);
+}
+
+TEST_F(PmtuProberTest, BinarySearchConvergesOnPathMtu) {
+    prober_->SetPeerMaxUdpPayloadSize(0);
+    prober_->StartProbe();
+    RunSearch(4000);
+
+    EXPECT_EQ(prober_->GetState(), PmtuProber::State::kSearchComplete);
+    EXPECT_LE(prober_->GetMtuLimit(), 4000);
+    EXPECT_GT(prober_->GetMtuLimit(), 4000 - PmtuProber::kSearchGranularity);
+    // the raise timer waits to look for a larger PMTU
+    EXPECT_FALSE(timer_->Empty());
+}
+
+TEST_F(PmtuProberTest, SizeGivenUpAfterMaxProbes) {
+    prober_->SetPeerMaxUdpPayloadSize(9000);
+    prober_->StartProbe();
+    uint16_t target = prober_->GetProbeSize();
+    ASSERT_GT(target, kDefaultPlpmtu);
+
+    for (uint32_t i = 0; i < PmtuProber::kMaxProbes - 1; i++) {
+        EXPECT_EQ(Probe(kDefaultPlpmtu), target);
+    }
+    EXPECT_EQ(Probe(kDefaultPlpmtu), target);
+    EXPECT_LT(prober_->GetProbeSize(), target);
+    EXPECT_EQ(prober_->GetMtuLimit(), kDefaultPlpmtu);
+}
+
+TEST_F(PmtuProberTest, PeerLimitCapsSearch) {
+    prober_->SetPeerMaxUdpPayloadSize(1500);
+    prober_->StartProbe();
+    RunSearch(9000);
+    EXPECT_LE(prober_->GetMtuLimit(), 1500);
+    EXPECT_GT(prober_->GetMtuLimit(), 1500 - PmtuProber::kSearchGranularity);
+
+    // a limit at or below the default completes right away
+    PmtuProber small(timer_);
+    small.SetPeerMaxUdpPayloadSize(1300);
+    EXPECT_EQ(small.GetMtuLimit(), 1300);
+    small.StartProbe();
+    EXPECT_EQ(small.GetState(), PmtuProber::State::kSearchComplete);
+    EXPECT_EQ(small.GetProbeSize(), 0);
+}
+
+TEST_F(PmtuProberTest, BlackHoleFallsBackToBase) {
+    prober_->SetPeerMaxUdpPayloadSize(0);
+    prober_->StartProbe();
+    RunSearch(3000);
+    uint16_t found = prober_->GetMtuLimit();
+    ASSERT_GT(found, 2900);
+
+    // the path shrinks: full-size packets vanish
+    for (uint32_t i = 0; i < PmtuProber::kMaxProbes; i++) {
+        prober_->OnPacketLost(next_pn_++, found, false);
+    }
+    EXPECT_EQ(prober_->GetProbeSize(), found);
+    for (uint32_t i = 0; i < PmtuProber::kMaxProbes; i++) {
+        EXPECT_EQ(Probe(1400), found);
+    }
+    EXPECT_EQ(prober_->GetMtuLimit(), kMinInitialPacketSize);
+    EXPECT_EQ(prober_->GetState(), PmtuProber::State::kSearching);
+
+    // and the new search stays below the size that failed
+    RunSearch(1400);
+    EXPECT_LE(prober_->GetMtuLimit(), 1400);
+    EXPECT_GT(prober_->GetMtuLimit(), 1400 - PmtuProber::kSearchGranularity);
+}
+
+TEST_F(PmtuProberTest, LargeAckEndsValidation) {
+    prober_->SetPeerMaxUdpPayloadSize(1500);
+    prober_->StartProbe();
+    RunSearch(1500);
+    uint16_t found = prober_->GetMtuLimit();
+
+    // congestion loss: later full-size packets are acked in between
+    uint64_t lost = next_pn_++;
+    prober_->OnPacketAcked(next_pn_++, found, false);
+    prober_->OnPacketLost(lost, found, false);
+    prober_->OnPacketLost(next_pn_++, found, false);
+    EXPECT_EQ(prober_->GetProbeSize(), 0);
+
+    prober_->OnPacketLost(next_pn_++, found, false);
+    prober_->OnPacketLost(next_pn_++, found, false);
+    ASSERT_EQ(prober_->GetProbeSize(), found);
+    prober_->OnPacketAcked(next_pn_++, found, false);
+    EXPECT_EQ(prober_->GetProbeSize(), 0);
+    EXPECT_EQ(prober_->GetMtuLimit(), found);
+}
+
+TEST_F(PmtuProberTest, RaiseTimerRestartsSearch) {
+    int needed = 0;
+    prober_->SetProbeNeededCallback([&needed]() { needed++; });
+    prober_->SetPeerMaxUdpPayloadSize(0);
+    prober_->StartProbe();
+    RunSearch(2000);
+    uint16_t found = prober_->GetMtuLimit();
+    ASSERT_EQ(prober_->GetState(), PmtuProber::State::kSearchComplete);
+
+    timer_->TimerRun(common::UTCTimeMsec() + PmtuProber::kRaiseTimerMs + 1000);
+    EXPECT_EQ(needed, 1);
+    EXPECT_EQ(prober_->GetState(), PmtuProber::State::kSearching);
+    EXPECT_GT(prober_->GetProbeSize(), found);
+
+    // the path grew meanwhile
+    RunSearch(6000);
+    EXPECT_GT(prober_->GetMtuLimit(), 6000 - PmtuProber::kSearchGranularity);
+}
+
+TEST_F(PmtuProberTest, NewPathStartsFromBase) {
+    prober_->SetPeerMaxUdpPayloadSize(0);
+    prober_->StartProbe();
+    RunSearch(3000);
+
+    prober_->ResetForNewPath();
+    EXPECT_EQ(prober_->GetState(), PmtuProber::State::kBase);
+    EXPECT_EQ(prober_->GetMtuLimit(), kMinInitialPacketSize);
+    EXPECT_EQ(prober_->GetProbeSize(), 0);
+    EXPECT_TRUE(timer_->Empty());
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
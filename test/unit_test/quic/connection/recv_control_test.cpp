@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <set>
 
 #include "quic/frame/type.h"
 #include "quic/frame/ack_frame.h"
+#include "quic/frame/path_ack_frame.h"
 #include "common/timer/if_timer.h"
 #include "common/timer/timer_task.h"
 #include "quic/packet/rtt_1_packet.h"
@@ -40,12 +42,29 @@ public:
         return false;
     }
 
-    int32_t MinTime(uint64_t /*now*/ = 0) override { return tasks_.empty() ? -1 : 0; }
+    void ArmTimer(common::TimerNode& node, uint32_t /*time*/, uint64_t /*now*/ = 0) override {
+        // re-arming an armed node replaces it
+        if (!nodes_.insert(&node).second) {
+            rm_count++;
+        }
+        add_count++;
+    }
+
+    bool DisarmTimer(common::TimerNode& node) override {
+        if (nodes_.erase(&node) == 0) {
+            return false;
+        }
+        rm_count++;
+        return true;
+    }
+
+    int32_t MinTime(uint64_t /*now*/ = 0) override { return Empty() ? -1 : 0; }
     void TimerRun(uint64_t /*now*/ = 0) override {}
-    bool Empty() override { return tasks_.empty(); }
+    bool Empty() override { return tasks_.empty() && nodes_.empty(); }
 
 private:
     std::vector<common::TimerTask> tasks_;
+    std::set<common::TimerNode*> nodes_;
 };
 
 std::shared_ptr<Rtt1Packet> MakePacket(uint64_t number, FrameTypeBit frame_bits) {
@@ -130,6 +149,172 @@ TEST(RecvControlTest, EcnCountersReportedInAckEcnFrame) {
     EXPECT_EQ(ack_ecn->GetEcnCe(), 1u);
 }
 
+TEST(RecvControlTest, AckRangesRepeatUntilAckOfAck) {
+    auto timer = std::make_shared<MockTimer>();
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    event_loop->SetTimerForTest(timer);
+    RecvControl recv_control(timer);
+    auto ns = PacketNumberSpace::kApplicationNumberSpace;
+
+    recv_control.OnPacketRecv(100, MakePacket(1, FrameTypeBit::kStreamBit));
+    recv_control.OnPacketRecv(100, MakePacket(2, FrameTypeBit::kStreamBit));
+    auto first = std::dynamic_pointer_cast<AckFrame>(recv_control.MayGenerateAckFrame(110, ns, false));
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->GetLargestAck(), 2u);
+    EXPECT_EQ(first->GetFirstAckRange(), 1u);
+    EXPECT_FALSE(recv_control.HasPendingAck(ns));
+
+    // Nothing new arrived: no ACK is due.
+    EXPECT_EQ(recv_control.MayGenerateAckFrame(111, ns, false), nullptr);
+
+    // The next ACK still reports packets 1..2 in case the first ACK was lost.
+    recv_control.OnPacketRecv(120, MakePacket(4, FrameTypeBit::kStreamBit));
+    auto second = std::dynamic_pointer_cast<AckFrame>(recv_control.MayGenerateAckFrame(130, ns, false));
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(second->GetLargestAck(), 4u);
+    EXPECT_EQ(second->GetFirstAckRange(), 0u);
+    ASSERT_EQ(second->GetAckRange().size(), 1u);
+    EXPECT_EQ(second->GetAckRange()[0].GetGap(), 0u);
+    EXPECT_EQ(second->GetAckRange()[0].GetAckRangeLength(), 1u);
+    // `first` is still referenced here, so it was not rewritten in place.
+    EXPECT_EQ(first->GetLargestAck(), 2u);
+
+    // The peer acknowledged the packet that carried the first ACK: 1..2 no
+    // longer need reporting.
+    recv_control.OnAckFrameAcked(ns, 2);
+    recv_control.OnPacketRecv(140, MakePacket(5, FrameTypeBit::kStreamBit));
+    auto third = std::dynamic_pointer_cast<AckFrame>(recv_control.MayGenerateAckFrame(150, ns, false));
+    ASSERT_NE(third, nullptr);
+    EXPECT_EQ(third->GetLargestAck(), 5u);
+    EXPECT_EQ(third->GetFirstAckRange(), 1u);
+    EXPECT_TRUE(third->GetAckRange().empty());
+}
+
+TEST(RecvControlTest, CachedAckFrameReusedWhenUnreferenced) {
+    auto timer = std::make_shared<MockTimer>();
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    event_loop->SetTimerForTest(timer);
+    RecvControl recv_control(timer);
+    auto ns = PacketNumberSpace::kApplicationNumberSpace;
+
+    recv_control.OnPacketRecv(100, MakePacket(1, FrameTypeBit::kStreamBit));
+    IFrame* first_ptr = recv_control.MayGenerateAckFrame(110, ns, false).get();
+    ASSERT_NE(first_ptr, nullptr);
+
+    // The previous frame is no longer held by anyone, so it is updated in place.
+    recv_control.OnPacketRecv(120, MakePacket(2, FrameTypeBit::kStreamBit));
+    auto second = std::dynamic_pointer_cast<AckFrame>(recv_control.MayGenerateAckFrame(130, ns, false));
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(second.get(), first_ptr);
+    EXPECT_EQ(second->GetLargestAck(), 2u);
+    EXPECT_EQ(second->GetFirstAckRange(), 1u);
+}
+
+TEST(RecvControlTest, AckFrequencyRaisesThreshold) {
+    auto timer = std::make_shared<MockTimer>();
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    event_loop->SetTimerForTest(timer);
+    RecvControl recv_control(timer);
+    auto ns = PacketNumberSpace::kApplicationNumberSpace;
+
+    // Ack-Eliciting Threshold 20: the 21st unacknowledged packet makes an ACK due.
+    EXPECT_TRUE(recv_control.OnAckFrequency(0, 20, 5000, 1));
+    for (uint64_t pn = 0; pn < 20; ++pn) {
+        recv_control.OnPacketRecv(100, MakePacket(pn, FrameTypeBit::kStreamBit));
+    }
+    EXPECT_FALSE(recv_control.ShouldSendAckNow(ns));
+    recv_control.OnPacketRecv(100, MakePacket(20, FrameTypeBit::kStreamBit));
+    EXPECT_TRUE(recv_control.ShouldSendAckNow(ns));
+
+    // A frame that is not newer than the applied one is ignored.
+    EXPECT_FALSE(recv_control.OnAckFrequency(0, 1, 5000, 1));
+    ASSERT_NE(recv_control.MayGenerateAckFrame(110, ns, false), nullptr);
+    recv_control.OnPacketRecv(120, MakePacket(21, FrameTypeBit::kStreamBit));
+    recv_control.OnPacketRecv(120, MakePacket(22, FrameTypeBit::kStreamBit));
+    EXPECT_FALSE(recv_control.ShouldSendAckNow(ns));
+}
+
+TEST(RecvControlTest, ImmediateAckFlushesOnNextPacket) {
+    auto timer = std::make_shared<MockTimer>();
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    event_loop->SetTimerForTest(timer);
+    RecvControl recv_control(timer);
+    auto ns = PacketNumberSpace::kApplicationNumberSpace;
+
+    recv_control.OnPacketRecv(100, MakePacket(0, FrameTypeBit::kStreamBit));
+    EXPECT_FALSE(recv_control.ShouldSendAckNow(ns));
+
+    // Frames are processed before the packet carrying them is recorded.
+    recv_control.OnImmediateAck(ns);
+    recv_control.OnPacketRecv(101, MakePacket(1, FrameTypeBit::kImmediateAckBit));
+    EXPECT_TRUE(recv_control.ShouldSendAckNow(ns));
+
+    // The request is consumed by that packet.
+    ASSERT_NE(recv_control.MayGenerateAckFrame(102, ns, false), nullptr);
+    recv_control.OnPacketRecv(103, MakePacket(2, FrameTypeBit::kStreamBit));
+    EXPECT_FALSE(recv_control.ShouldSendAckNow(ns));
+}
+
+TEST(RecvControlTest, ReorderingThresholdDelaysGapAck) {
+    auto timer = std::make_shared<MockTimer>();
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    event_loop->SetTimerForTest(timer);
+    RecvControl recv_control(timer);
+    auto ns = PacketNumberSpace::kApplicationNumberSpace;
+
+    EXPECT_TRUE(recv_control.OnAckFrequency(1, 100, 5000, 3));
+    recv_control.OnPacketRecv(100, MakePacket(0, FrameTypeBit::kStreamBit));
+    recv_control.OnPacketRecv(100, MakePacket(1, FrameTypeBit::kStreamBit));
+    // Packet 2 is missing. A reordered packet filling an older gap, or a gap
+    // shorter than the threshold, does not force an ACK.
+    recv_control.OnPacketRecv(100, MakePacket(3, FrameTypeBit::kStreamBit));
+    recv_control.OnPacketRecv(100, MakePacket(4, FrameTypeBit::kStreamBit));
+    EXPECT_FALSE(recv_control.ShouldSendAckNow(ns));
+    // Packet 5 puts packet 2 three behind the largest.
+    recv_control.OnPacketRecv(100, MakePacket(5, FrameTypeBit::kStreamBit));
+    EXPECT_TRUE(recv_control.ShouldSendAckNow(ns));
+
+    // The same gap does not trigger again on later packets.
+    ASSERT_NE(recv_control.MayGenerateAckFrame(110, ns, false), nullptr);
+    recv_control.OnPacketRecv(120, MakePacket(6, FrameTypeBit::kStreamBit));
+    EXPECT_FALSE(recv_control.ShouldSendAckNow(ns));
+}
+
+TEST(RecvControlTest, PathAckFrameCarriesPathId) {
+    auto timer = std::make_shared<MockTimer>();
+    RecvControl recv_control(timer);
+    recv_control.SetPathId(1);
+    const auto ns = PacketNumberSpace::kApplicationNumberSpace;
+
+    recv_control.OnPacketRecv(100, MakePacket(7, FrameTypeBit::kStreamBit));
+    recv_control.OnPacketRecv(100, MakePacket(8, FrameTypeBit::kStreamBit));
+
+    auto frame = recv_control.MayGenerateAckFrame(110, ns, false);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->GetType(), FrameType::kPathAck);
+    auto path_ack = std::dynamic_pointer_cast<PathAckFrame>(frame);
+    ASSERT_NE(path_ack, nullptr);
+    EXPECT_EQ(path_ack->GetPathId(), 1u);
+    EXPECT_EQ(path_ack->GetLargestAck(), 8u);
+    EXPECT_EQ(path_ack->GetFirstAckRange(), 1u);
+
+    // With ECN counts the PATH_ACK_ECN variant is used.
+    recv_control.OnPacketRecv(120, MakePacket(9, FrameTypeBit::kStreamBit));
+    recv_control.OnEcnCounters(0x02, ns);
+    frame = recv_control.MayGenerateAckFrame(130, ns, true);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->GetType(), FrameType::kPathAckEcn);
+    path_ack = std::dynamic_pointer_cast<PathAckFrame>(frame);
+    ASSERT_NE(path_ack, nullptr);
+    EXPECT_EQ(path_ack->GetPathId(), 1u);
+    EXPECT_TRUE(path_ack->HasEcnCounts());
+}
+
 }  // namespace
 }  // namespace quic
 }  // namespace quicx
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "quic/config.h"
+#include "quic/connection/controler/recv_window_tuner.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+constexpr uint64_t kWindow = 100000;
+constexpr uint32_t kRtt = 50;
+
+TEST(RecvWindowTunerTest, UpdatesAtHalfWindow) {
+    RecvWindowTuner tuner;
+    tuner.Reset(kWindow, kWindow * 8);
+
+    uint64_t limit = 0;
+    EXPECT_FALSE(tuner.OnConsumed(kWindow / 2 - 1, 1000, kRtt, limit));
+    EXPECT_TRUE(tuner.OnConsumed(kWindow / 2, 1000, kRtt, limit));
+    EXPECT_EQ(limit, kWindow / 2 + kWindow);
+    EXPECT_EQ(tuner.GetLimit(), limit);
+    // the first update has no history, the window stays
+    EXPECT_EQ(tuner.GetWindow(), kWindow);
+}
+
+TEST(RecvWindowTunerTest, FastReaderDoublesWindow) {
+    RecvWindowTuner tuner;
+    tuner.Reset(kWindow, kWindow * 8);
+
+    uint64_t limit = 0;
+    uint64_t now = 1000;
+    uint64_t consumed = kWindow / 2;
+    ASSERT_TRUE(tuner.OnConsumed(consumed, now, kRtt, limit));
+
+    // each half window drained within one RTT
+    for (uint64_t expected : {kWindow * 2, kWindow * 4, kWindow * 8, kWindow * 8}) {
+        now += kRtt;
+        consumed = limit - tuner.GetWindow() / 2;
+        ASSERT_TRUE(tuner.OnConsumed(consumed, now, kRtt, limit));
+        EXPECT_EQ(tuner.GetWindow(), expected);
+        EXPECT_EQ(limit, consumed + expected);
+    }
+}
+
+TEST(RecvWindowTunerTest, SlowReaderKeepsWindow) {
+    RecvWindowTuner tuner;
+    tuner.Reset(kWindow, kWindow * 8);
+
+    uint64_t limit = 0;
+    uint64_t now = 1000;
+    ASSERT_TRUE(tuner.OnConsumed(kWindow / 2, now, kRtt, limit));
+
+    now += kRtt * kWindowAutoTuneRttMultiple;
+    ASSERT_TRUE(tuner.OnConsumed(limit - kWindow / 2, now, kRtt, limit));
+    EXPECT_EQ(tuner.GetWindow(), kWindow);
+
+    // without an RTT sample the window never grows
+    ASSERT_TRUE(tuner.OnConsumed(limit - kWindow / 2, now + 1, 0, limit));
+    EXPECT_EQ(tuner.GetWindow(), kWindow);
+}
+
+TEST(RecvWindowTunerTest, PeerBlockedCreditsConsumedBytes) {
+    RecvWindowTuner tuner;
+    tuner.Reset(kWindow, kWindow * 8);
+
+    uint64_t limit = 0;
+    EXPECT_FALSE(tuner.OnConsumed(1000, 1000, kRtt, limit));
+    EXPECT_TRUE(tuner.OnConsumed(1000, 1000, kRtt, limit, true));
+    EXPECT_EQ(limit, kWindow + 1000);
+
+    // nothing new consumed, nothing to hand back
+    EXPECT_FALSE(tuner.OnConsumed(1000, 1001, kRtt, limit, true));
+}
+
+TEST(RecvWindowTunerTest, ReleasesGlobalReservation) {
+    uint64_t before = RecvWindowTuner::GetGlobalReserved();
+    {
+        RecvWindowTuner tuner;
+        tuner.Reset(kWindow, kWindow * 8);
+        uint64_t limit = 0;
+        ASSERT_TRUE(tuner.OnConsumed(kWindow / 2, 1000, kRtt, limit));
+        ASSERT_TRUE(tuner.OnConsumed(limit - kWindow / 2, 1010, kRtt, limit));
+        EXPECT_EQ(RecvWindowTuner::GetGlobalReserved(), before + kWindow);
+
+        tuner.Reset(kWindow, kWindow * 8);
+        EXPECT_EQ(RecvWindowTuner::GetGlobalReserved(), before);
+        ASSERT_TRUE(tuner.OnConsumed(kWindow / 2, 2000, kRtt, limit));
+        ASSERT_TRUE(tuner.OnConsumed(limit - kWindow / 2, 2010, kRtt, limit));
+    }
+    EXPECT_EQ(RecvWindowTuner::GetGlobalReserved(), before);
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
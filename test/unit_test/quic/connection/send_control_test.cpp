@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <set>
 #include <tuple>
 #include <vector>
 
@@ -8,6 +9,7 @@
 #include "common/timer/timer_task.h"
 #include "quic/connection/controler/send_control.h"
 #include "quic/frame/ack_frame.h"
+#include "quic/frame/datagram_frame.h"
 #include "quic/frame/type.h"
 #include "quic/packet/packet_number.h"
 #include "quic/packet/rtt_1_packet.h"
@@ -43,12 +45,29 @@ public:
         return false;
     }
 
-    int32_t MinTime(uint64_t /*now*/ = 0) override { return tasks_.empty() ? -1 : 0; }
+    void ArmTimer(common::TimerNode& node, uint32_t /*time*/, uint64_t /*now*/ = 0) override {
+        // re-arming an armed node replaces it
+        if (!nodes_.insert(&node).second) {
+            rm_count++;
+        }
+        add_count++;
+    }
+
+    bool DisarmTimer(common::TimerNode& node) override {
+        if (nodes_.erase(&node) == 0) {
+            return false;
+        }
+        rm_count++;
+        return true;
+    }
+
+    int32_t MinTime(uint64_t /*now*/ = 0) override { return Empty() ? -1 : 0; }
     void TimerRun(uint64_t /*now*/ = 0) override {}
-    bool Empty() override { return tasks_.empty(); }
+    bool Empty() override { return tasks_.empty() && nodes_.empty(); }
 
 private:
     std::vector<common::TimerTask> tasks_;
+    std::set<common::TimerNode*> nodes_;
 };
 
 std::shared_ptr<Rtt1Packet> MakePacket(uint64_t packet_number, FrameTypeBit frame_bits) {
@@ -83,10 +102,11 @@ TEST(SendControlTest, AckElicitingPacketsTriggerCallbacks) {
     std::vector<StreamDataInfo> data10 = {StreamDataInfo(4, /*offset=*/100, /*len=*/50, /*fin=*/true)};
     send_control.OnPacketSend(0, pkt10, 1300, data10);
 
-    // Expect 4 timer adds:
-    // - 2 for packet timeout timers (one per packet)
+    // Expect 3 timer adds:
+    // - 1 for the shared loss timer (armed at packet 9's deadline; packet 10's
+    //   deadline is not earlier, so it is left alone)
     // - 2 for PTO timer (scheduled after each packet send, with the second one replacing the first)
-    EXPECT_EQ(timer->add_count, 4u);
+    EXPECT_EQ(timer->add_count, 3u);
 
     auto ack = std::make_shared<AckFrame>();
     ack->SetLargestAck(10);
@@ -106,11 +126,11 @@ TEST(SendControlTest, AckElicitingPacketsTriggerCallbacks) {
     EXPECT_EQ(std::get<2>(callbacks[1]), 100u);  // length
     EXPECT_FALSE(std::get<3>(callbacks[1]));
 
-    // Expect 4 timer removes:
+    // Expect 3 timer removes:
     // - 1 for removing old PTO timer when sending packet 10
-    // - 2 for packet timeout timers (cancelled when ACKed)
     // - 1 for PTO timer (cancelled when ACK received)
-    EXPECT_EQ(timer->rm_count, 4u);
+    // - 1 for the loss timer (nothing left outstanding after the ACK)
+    EXPECT_EQ(timer->rm_count, 3u);
 }
 
 TEST(SendControlTest, NonAckElicitingPacketsAreNotTracked) {
@@ -286,7 +306,7 @@ TEST(SendControlG2Test, S2_RfcCompliantSelectiveAckPnsByValue) {
 //   after ACK {2,3,5}:      0
 //
 // This exercises the DetectLostPackets branch (line ~537) which DOES erase
-// from unacked_packets_. If C3 holds at this layer, in_flight ends at 0.
+// from the sent-packet tracker. If C3 holds at this layer, in_flight ends at 0.
 TEST(SendControlG2Test, S3_DetectLossPathThenRetransmitDoesNotLeakInFlight) {
     auto timer = std::make_shared<MockTimer>();
     auto event_loop = common::MakeEventLoop();
@@ -379,6 +399,59 @@ TEST(SendControlG2Test, S4_SpuriousAckForErasedLostPnIsNoOp) {
 
 }  // namespace g2
 
+TEST(SendControlTest, MtuProbesStayOutOfCongestionControl) {
+    auto timer = std::make_shared<MockTimer>();
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    event_loop->SetTimerForTest(timer);
+    SendControl sc(timer);
+
+    std::vector<std::tuple<uint64_t, uint32_t, bool, bool>> outcomes;
+    sc.SetPacketOutcomeCallback([&outcomes](uint64_t pn, uint32_t len, bool mtu_probe, bool acked) {
+        outcomes.emplace_back(pn, len, mtu_probe, acked);
+    });
+
+    auto data = MakePacket(1, FrameTypeBit::kStreamBit);
+    sc.OnPacketSend(100, data, 1200);
+    auto probe = MakePacket(2, FrameTypeBit::kPingBit);
+    probe->SetMtuProbe(true);
+    sc.OnPacketSend(101, probe, 1400);
+    EXPECT_EQ(sc.GetCcBytesInFlightForTest(), 1200u);
+
+    g2::AckContiguous(sc, 1, 2, 200);
+    EXPECT_EQ(sc.GetCcBytesInFlightForTest(), 0u);
+
+    ASSERT_EQ(outcomes.size(), 2u);
+    EXPECT_EQ(outcomes[0], std::make_tuple(uint64_t(2), uint32_t(1400), true, true));
+    EXPECT_EQ(outcomes[1], std::make_tuple(uint64_t(1), uint32_t(1200), false, true));
+}
+
+TEST(SendControlTest, DatagramsAreReportedNotResent) {
+    auto timer = std::make_shared<MockTimer>();
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    event_loop->SetTimerForTest(timer);
+    SendControl sc(timer);
+
+    std::vector<std::pair<uint64_t, bool>> outcomes;
+    sc.SetDatagramOutcomeCallback([&outcomes](uint64_t id, bool acked) { outcomes.emplace_back(id, acked); });
+    int requeued = 0;
+    sc.SetFrameLostCallback([&requeued](std::shared_ptr<IFrame>) { requeued++; });
+
+    for (uint64_t pn = 1; pn <= 4; ++pn) {
+        auto datagram = std::make_shared<DatagramFrame>();
+        datagram->SetDatagramId(100 + pn);
+        sc.OnPacketSend(100 + pn, MakePacket(pn, FrameTypeBit::kDatagramBit), 1200, {}, {datagram});
+    }
+
+    // ACK of pn=4 declares pn=1 lost (packet threshold)
+    g2::AckContiguous(sc, 4, 4, 200);
+    ASSERT_EQ(outcomes.size(), 2u);
+    EXPECT_EQ(outcomes[0], std::make_pair(uint64_t(104), true));
+    EXPECT_EQ(outcomes[1], std::make_pair(uint64_t(101), false));
+    EXPECT_EQ(requeued, 0);
+}
+
 }  // namespace
 }  // namespace quic
 }  // namespace quicx
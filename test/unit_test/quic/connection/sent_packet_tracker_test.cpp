@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "quic/connection/controler/sent_packet_tracker.h"
+#include "quic/frame/max_data_frame.h"
+#include "quic/packet/packet_number.h"
+#include "quic/packet/rtt_1_packet.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+std::shared_ptr<Rtt1Packet> MakePacket(uint64_t packet_number) {
+    auto packet = std::make_shared<Rtt1Packet>();
+    packet->SetPacketNumber(packet_number);
+    packet->GetHeader()->SetPacketNumberLength(PacketNumber::GetPacketNumberLength(packet_number));
+    packet->AddFrameTypeBit(FrameTypeBit::kStreamBit);
+    return packet;
+}
+
+std::vector<StreamDataInfo> OneFrame(uint64_t offset) {
+    return {StreamDataInfo(4, offset, 100, false)};
+}
+
+TEST(SentPacketTrackerTest, AddFindRemove) {
+    SentPacketTracker tracker;
+    EXPECT_TRUE(tracker.Empty());
+
+    for (uint64_t pn = 1; pn <= 3; ++pn) {
+        ASSERT_NE(tracker.Add(pn, pn * 10, pn * 10 + 100, 1200, OneFrame(pn * 100), MakePacket(pn)), nullptr);
+    }
+    EXPECT_EQ(tracker.Size(), 3u);
+    EXPECT_EQ(tracker.SmallestPacketNumber(), 1u);
+    EXPECT_EQ(tracker.LargestPacketNumber(), 3u);
+
+    auto record = tracker.Find(2);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->send_time, 20u);
+    EXPECT_EQ(record->loss_deadline, 120u);
+    EXPECT_EQ(tracker.GetPacket(*record)->GetPacketNumber(), 2u);
+    auto stream_data = tracker.CopyStreamData(*record);
+    ASSERT_EQ(stream_data.size(), 1u);
+    EXPECT_EQ(stream_data[0].offset_start, 200u);
+
+    EXPECT_EQ(tracker.Find(0), nullptr);
+    EXPECT_EQ(tracker.Find(4), nullptr);
+
+    // Removing a middle packet must not move the tail.
+    tracker.Remove(record);
+    EXPECT_EQ(tracker.Find(2), nullptr);
+    EXPECT_EQ(tracker.SmallestPacketNumber(), 1u);
+
+    // Removing the tail skips over the already-freed slot.
+    tracker.Remove(tracker.Find(1));
+    EXPECT_EQ(tracker.SmallestPacketNumber(), 3u);
+    EXPECT_EQ(tracker.Size(), 1u);
+}
+
+TEST(SentPacketTrackerTest, RejectsDecreasingPacketNumber) {
+    SentPacketTracker tracker;
+    ASSERT_NE(tracker.Add(10, 0, 0, 1200, {}, MakePacket(10)), nullptr);
+    EXPECT_EQ(tracker.Add(9, 0, 0, 1200, {}, MakePacket(9)), nullptr);
+    EXPECT_EQ(tracker.Size(), 1u);
+}
+
+TEST(SentPacketTrackerTest, SkippedPacketNumbersAreFreeSlots) {
+    SentPacketTracker tracker;
+    tracker.Add(1, 0, 0, 1200, {}, MakePacket(1));
+    tracker.Add(4, 0, 0, 1200, {}, MakePacket(4));  // 2 and 3 were ACK-only
+
+    std::vector<uint64_t> visited;
+    tracker.ForEach([&visited](SentPacketRecord& record) { visited.push_back(record.packet_number); });
+    EXPECT_EQ(visited, (std::vector<uint64_t>{1, 4}));
+    EXPECT_EQ(tracker.Find(2), nullptr);
+
+    tracker.Remove(tracker.Find(1));
+    EXPECT_EQ(tracker.SmallestPacketNumber(), 4u);
+}
+
+TEST(SentPacketTrackerTest, GrowsPastInitialCapacityAndKeepsRecords) {
+    SentPacketTracker tracker;
+    size_t initial_capacity = tracker.Capacity();
+    uint64_t count = initial_capacity * 4;
+    for (uint64_t pn = 0; pn < count; ++pn) {
+        ASSERT_NE(tracker.Add(pn, pn, pn, 1200, OneFrame(pn * 100), MakePacket(pn)), nullptr);
+    }
+    EXPECT_GE(tracker.Capacity(), count);
+    EXPECT_EQ(tracker.Size(), count);
+    for (uint64_t pn = 0; pn < count; ++pn) {
+        auto record = tracker.Find(pn);
+        ASSERT_NE(record, nullptr);
+        auto stream_data = tracker.CopyStreamData(*record);
+        ASSERT_EQ(stream_data.size(), 1u);
+        EXPECT_EQ(stream_data[0].offset_start, pn * 100);
+    }
+}
+
+TEST(SentPacketTrackerTest, SlidingWindowReusesSlots) {
+    SentPacketTracker tracker;
+    size_t initial_capacity = tracker.Capacity();
+    // Keep a small window in flight while the packet number runs far past
+    // the ring size: the ring must not grow.
+    for (uint64_t pn = 0; pn < initial_capacity * 8; ++pn) {
+        ASSERT_NE(tracker.Add(pn, pn, pn, 1200, OneFrame(pn), MakePacket(pn)), nullptr);
+        if (pn >= 16) {
+            tracker.Remove(tracker.Find(pn - 16));
+        }
+    }
+    EXPECT_EQ(tracker.Capacity(), initial_capacity);
+    EXPECT_EQ(tracker.Size(), 16u);
+}
+
+TEST(SentPacketTrackerTest, RangeWalksAreClampedAndOrdered) {
+    SentPacketTracker tracker;
+    for (uint64_t pn = 5; pn <= 9; ++pn) {
+        tracker.Add(pn, 0, 0, 1200, {}, MakePacket(pn));
+    }
+
+    std::vector<uint64_t> visited;
+    tracker.ReverseForEachInRange(0, 100, [&](SentPacketRecord& record) {
+        visited.push_back(record.packet_number);
+        tracker.Remove(&record);
+    });
+    EXPECT_EQ(visited, (std::vector<uint64_t>{9, 8, 7, 6, 5}));
+    EXPECT_TRUE(tracker.Empty());
+
+    // Empty tracker re-anchors at the next packet number.
+    ASSERT_NE(tracker.Add(1000, 0, 0, 1200, {}, MakePacket(1000)), nullptr);
+    EXPECT_EQ(tracker.SmallestPacketNumber(), 1000u);
+}
+
+TEST(SentPacketTrackerTest, OldestOutstandingSkipsLostRecords) {
+    SentPacketTracker tracker;
+    tracker.Add(1, 0, 0, 1200, {}, MakePacket(1));
+    tracker.Add(2, 0, 0, 1200, {}, MakePacket(2));
+    tracker.Find(1)->state = SentPacketRecord::State::kLost;
+
+    auto oldest = tracker.OldestOutstanding();
+    ASSERT_NE(oldest, nullptr);
+    EXPECT_EQ(oldest->packet_number, 2u);
+    // The lost record is still tracked so a late ACK can find it.
+    EXPECT_NE(tracker.Find(1), nullptr);
+}
+
+TEST(SentPacketTrackerTest, ControlFramesAreTakenOnce) {
+    SentPacketTracker tracker;
+    auto frame = std::make_shared<MaxDataFrame>();
+    // Application packets are tracked without the packet itself.
+    auto record = tracker.Add(1, 0, 0, 1200, OneFrame(0), nullptr, {frame});
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(tracker.GetPacket(*record), nullptr);
+    EXPECT_EQ(tracker.ControlFrameCount(*record), 1u);
+
+    auto frames = tracker.TakeControlFrames(*record);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], frame);
+    EXPECT_EQ(tracker.ControlFrameCount(*record), 0u);
+
+    // A reused slot starts out empty.
+    tracker.Remove(record);
+    record = tracker.Add(2, 0, 0, 1200, {}, nullptr);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(tracker.ControlFrameCount(*record), 0u);
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
@@ -40,6 +40,7 @@ TEST(transport_param_utest, test1) {
     EXPECT_EQ(tp1.GetDisableActiveMigration(), tp2.GetDisableActiveMigration());
     EXPECT_EQ(tp1.GetPreferredAddress(), tp2.GetPreferredAddress());
     EXPECT_EQ(tp1.GetActiveConnectionIdLimit(), tp2.GetActiveConnectionIdLimit());
+    EXPECT_EQ(tp1.GetMinAckDelay(), tp2.GetMinAckDelay());
     EXPECT_EQ(tp1.GetInitialSourceConnectionId(), tp2.GetInitialSourceConnectionId());
     EXPECT_EQ(tp1.GetRetrySourceConnectionId(), tp2.GetRetrySourceConnectionId());
 }
@@ -170,7 +171,159 @@ TEST(transport_param_utest, VersionInformation_MergedFromPeer) {
     EXPECT_EQ(local.GetAvailableVersions()[0], kQuicVersion2);
     EXPECT_EQ(local.GetAvailableVersions()[1], kQuicVersion1);
 }
+// draft-ietf-quic-ack-frequency: Merge() keeps our own min_ack_delay (it
+// bounds the ACK_FREQUENCY frames we accept) and records the peer's apart.
+TEST(transport_param_utest, MinAckDelay_MergeKeepsLocal) {
+    QuicTransportParams conf;
+    conf.min_ack_delay_us_ = 2000;
+    TransportParam local;
+    local.Init(conf);
+
+    conf.min_ack_delay_us_ = 500;
+    TransportParam peer;
+    peer.Init(conf);
+
+    uint8_t buf[1024] = {0};
+    size_t bytes_written = 0;
+    EXPECT_TRUE(peer.Encode(common::BufferSpan(buf, sizeof(buf)), bytes_written));
+    TransportParam decoded;
+    EXPECT_TRUE(decoded.Decode(common::BufferSpan(buf, static_cast<uint32_t>(bytes_written))));
+    EXPECT_EQ(decoded.GetMinAckDelay(), 500u);
+
+    local.Merge(decoded);
+    EXPECT_EQ(local.GetMinAckDelay(), 2000u);
+    EXPECT_EQ(local.GetPeerMinAckDelay(), 500u);
+}
+
+// RFC 9221: max_datagram_frame_size is opt-in, and Merge() keeps ours (it
+// bounds the DATAGRAM frames we accept) while recording the peer's apart.
+TEST(transport_param_utest, MaxDatagramFrameSize_MergeKeepsLocal) {
+    QuicTransportParams conf;
+    EXPECT_EQ(conf.max_datagram_frame_size_, 0u);
+    conf.max_datagram_frame_size_ = 1200;
+    TransportParam local;
+    local.Init(conf);
+
+    conf.max_datagram_frame_size_ = 65535;
+    TransportParam peer;
+    peer.Init(conf);
+
+    uint8_t buf[1024] = {0};
+    size_t bytes_written = 0;
+    EXPECT_TRUE(peer.Encode(common::BufferSpan(buf, sizeof(buf)), bytes_written));
+    EXPECT_EQ(bytes_written, peer.EncodeSize());
+    TransportParam decoded;
+    EXPECT_TRUE(decoded.Decode(common::BufferSpan(buf, static_cast<uint32_t>(bytes_written))));
+    EXPECT_EQ(decoded.GetMaxDatagramFrameSize(), 65535u);
+
+    local.Merge(decoded);
+    EXPECT_EQ(local.GetMaxDatagramFrameSize(), 1200u);
+    EXPECT_EQ(local.GetPeerMaxDatagramFrameSize(), 65535u);
+}
+
+// draft-ietf-quic-multipath: initial_max_path_id has a 64-bit codepoint and
+// multipath is only on once both endpoints sent it.
+TEST(transport_param_utest, InitialMaxPathId_BothSidesEnable) {
+    QuicTransportParams conf;
+    EXPECT_EQ(conf.initial_max_path_id_, 0u);
+    TransportParam local;
+    local.Init(conf);
+
+    conf.initial_max_path_id_ = 4;
+    TransportParam peer;
+    peer.Init(conf);
+
+    uint8_t buf[1024] = {0};
+    size_t bytes_written = 0;
+    EXPECT_TRUE(peer.Encode(common::BufferSpan(buf, sizeof(buf)), bytes_written));
+    EXPECT_EQ(bytes_written, peer.EncodeSize());
+    TransportParam decoded;
+    EXPECT_TRUE(decoded.Decode(common::BufferSpan(buf, static_cast<uint32_t>(bytes_written))));
+    EXPECT_EQ(decoded.GetInitialMaxPathId(), 4u);
+
+    // the peer supports it, we do not
+    local.Merge(decoded);
+    EXPECT_EQ(local.GetPeerInitialMaxPathId(), 4u);
+    EXPECT_FALSE(local.IsMultipathEnabled());
+
+    conf.initial_max_path_id_ = 2;
+    TransportParam both;
+    both.Init(conf);
+    both.Merge(decoded);
+    EXPECT_EQ(both.GetInitialMaxPathId(), 2u);
+    EXPECT_TRUE(both.IsMultipathEnabled());
+}
+
+// RFC 9000 §18.2: preferred_address is a fixed binary layout; the family the
+// server leaves out is all zeroes and comes back unset.
+TEST(transport_param_utest, PreferredAddress_RoundTrip) {
+    const uint8_t cid_bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    PreferredAddress preferred;
+    preferred.ipv4 = common::Address("192.168.1.100", 8443);
+    preferred.cid = ConnectionID(cid_bytes, sizeof(cid_bytes), 1);
+    preferred.stateless_reset_token = std::string(16, '\x5a');
+
+    TransportParam tp1;
+    ASSERT_TRUE(tp1.SetPreferredAddress(preferred));
+    EXPECT_EQ(tp1.GetPreferredAddress().size(), 41u + sizeof(cid_bytes));
+
+    uint8_t buf[256] = {0};
+    size_t bytes_written = 0;
+    ASSERT_TRUE(tp1.Encode(common::BufferSpan(buf, sizeof(buf)), bytes_written));
+    EXPECT_EQ(bytes_written, tp1.EncodeSize());
+    TransportParam tp2;
+    ASSERT_TRUE(tp2.Decode(common::BufferSpan(buf, static_cast<uint32_t>(bytes_written))));
+
+    PreferredAddress decoded;
+    ASSERT_TRUE(tp2.GetPreferredAddress(decoded));
+    EXPECT_EQ(decoded.ipv4.GetIp(), "192.168.1.100");
+    EXPECT_EQ(decoded.ipv4.GetPort(), 8443);
+    EXPECT_EQ(decoded.ipv6.GetPort(), 0);
+    EXPECT_TRUE(decoded.cid == preferred.cid);
+    EXPECT_EQ(decoded.cid.GetSequenceNumber(), 1u);
+    EXPECT_EQ(decoded.stateless_reset_token, preferred.stateless_reset_token);
+
+    preferred.ipv4 = common::Address();
+    preferred.ipv6 = common::Address("2001:db8::1", 443);
+    PreferredAddress v6;
+    ASSERT_TRUE(v6.Decode(preferred.Encode()));
+    EXPECT_EQ(v6.ipv4.GetPort(), 0);
+    EXPECT_EQ(v6.ipv6.GetIp(), "2001:db8::1");
+    EXPECT_EQ(v6.ipv6.GetPort(), 443);
+
+    // Init() takes no wire value from the "ip:port" setting
+    QuicTransportParams conf;
+    conf.preferred_address_ = "192.168.1.100:8443";
+    TransportParam from_conf;
+    from_conf.Init(conf);
+    EXPECT_TRUE(from_conf.GetPreferredAddress().empty());
+}
+
+TEST(transport_param_utest, PreferredAddress_RejectMalformed) {
+    const uint8_t cid_bytes[] = {9, 9, 9, 9};
+    PreferredAddress preferred;
+    preferred.ipv4 = common::Address("10.0.0.1", 4433);
+    preferred.stateless_reset_token = std::string(16, '\0');
+    // a zero-length connection ID cannot be advertised
+    preferred.cid = ConnectionID(cid_bytes, 0, 1);
+    TransportParam tp;
+    EXPECT_FALSE(tp.SetPreferredAddress(preferred));
+
+    preferred.cid = ConnectionID(cid_bytes, sizeof(cid_bytes), 1);
+    std::string value = preferred.Encode();
+    ASSERT_FALSE(value.empty());
+
+    PreferredAddress decoded;
+    EXPECT_FALSE(decoded.Decode(value.substr(0, value.size() - 1)));
+    value[24] = 0;  // Connection ID Length
+    EXPECT_FALSE(decoded.Decode(value));
+
+    // TP id 0x0d with a 3-byte value
+    uint8_t buf[] = {0x0d, 0x03, 0x01, 0x02, 0x03};
+    TransportParam short_value;
+    EXPECT_FALSE(short_value.Decode(common::BufferSpan(buf, sizeof(buf))));
+}
 
 }  // namespace
 }  // namespace quic
-}  // namespace quicx
\ No newline at end of file
+}  // namespace quicx
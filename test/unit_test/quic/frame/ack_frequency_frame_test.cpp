@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "quic/connection/util.h"
+#include "quic/frame/frame_decode.h"
+#include "quic/frame/ack_frequency_frame.h"
+#include "quic/frame/immediate_ack_frame.h"
+#include "common/buffer/single_block_buffer.h"
+#include "common/buffer/standalone_buffer_chunk.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+TEST(ack_frequency_frame_utest, codec) {
+    AckFrequencyFrame frame1;
+    AckFrequencyFrame frame2;
+
+    std::shared_ptr<common::SingleBlockBuffer> read_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+    std::shared_ptr<common::SingleBlockBuffer> write_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    frame1.SetSequenceNumber(7);
+    frame1.SetAckElicitingThreshold(32);
+    frame1.SetRequestMaxAckDelay(25000);
+    frame1.SetReorderingThreshold(3);
+
+    EXPECT_TRUE(frame1.Encode(write_buffer));
+    // the 0xaf frame type takes a two byte varint
+    EXPECT_EQ(write_buffer->GetDataLength(), frame1.EncodeSize());
+
+    auto data_span = write_buffer->GetReadableSpan();
+    auto pos_span = read_buffer->GetWritableSpan();
+    memcpy(pos_span.GetStart(), data_span.GetStart(), data_span.GetLength());
+    read_buffer->MoveWritePt(data_span.GetLength());
+    EXPECT_TRUE(frame2.Decode(read_buffer, true));
+
+    EXPECT_EQ(frame1.GetType(), frame2.GetType());
+    EXPECT_EQ(frame1.GetSequenceNumber(), frame2.GetSequenceNumber());
+    EXPECT_EQ(frame1.GetAckElicitingThreshold(), frame2.GetAckElicitingThreshold());
+    EXPECT_EQ(frame1.GetRequestMaxAckDelay(), frame2.GetRequestMaxAckDelay());
+    EXPECT_EQ(frame1.GetReorderingThreshold(), frame2.GetReorderingThreshold());
+}
+
+TEST(ack_frequency_frame_utest, decode_frames) {
+    std::shared_ptr<common::SingleBlockBuffer> buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    AckFrequencyFrame ack_frequency;
+    ack_frequency.SetSequenceNumber(1);
+    ImmediateAckFrame immediate_ack;
+    EXPECT_TRUE(ack_frequency.Encode(buffer));
+    EXPECT_TRUE(immediate_ack.Encode(buffer));
+
+    std::vector<std::shared_ptr<IFrame>> frames;
+    EXPECT_TRUE(DecodeFrames(buffer, frames));
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0]->GetType(), FrameType::kAckFrequency);
+    EXPECT_EQ(frames[1]->GetType(), FrameType::kImmediateAck);
+
+    // both are ack-eliciting even though 0xaf is outside the frame type bit field
+    EXPECT_TRUE(IsAckElictingPacket(frames[0]->GetFrameTypeBit()));
+    EXPECT_TRUE(IsAckElictingPacket(frames[1]->GetFrameTypeBit()));
+}
+
+}
+}
+}
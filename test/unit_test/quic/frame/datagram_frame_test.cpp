@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "quic/connection/util.h"
+#include "quic/frame/frame_decode.h"
+#include "quic/frame/datagram_frame.h"
+#include "quic/frame/ping_frame.h"
+#include "common/buffer/single_block_buffer.h"
+#include "common/buffer/standalone_buffer_chunk.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+common::SharedBufferSpan MakeSpan(const char* data) {
+    uint32_t len = static_cast<uint32_t>(strlen(data));
+    auto chunk = std::make_shared<common::StandaloneBufferChunk>(len);
+    memcpy(chunk->GetData(), data, len);
+    return common::SharedBufferSpan(chunk, chunk->GetData(), len);
+}
+
+TEST(datagram_frame_utest, codec) {
+    DatagramFrame frame1;
+    DatagramFrame frame2;
+
+    std::shared_ptr<common::SingleBlockBuffer> read_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+    std::shared_ptr<common::SingleBlockBuffer> write_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    frame1.SetData(MakeSpan("unreliable"));
+    EXPECT_TRUE(frame1.Encode(write_buffer));
+    EXPECT_EQ(write_buffer->GetDataLength(), frame1.EncodeSize());
+    EXPECT_EQ(frame1.EncodeSize(), 10 + DatagramFrame::GetOverhead(10));
+
+    auto data_span = write_buffer->GetReadableSpan();
+    auto pos_span = read_buffer->GetWritableSpan();
+    memcpy(pos_span.GetStart(), data_span.GetStart(), data_span.GetLength());
+    read_buffer->MoveWritePt(data_span.GetLength());
+    EXPECT_TRUE(frame2.Decode(read_buffer, true));
+
+    EXPECT_EQ(frame2.GetType(), FrameType::kDatagramWithLength);
+    EXPECT_EQ(frame2.GetLength(), 10u);
+    EXPECT_EQ(memcmp(frame2.GetData().GetStart(), "unreliable", 10), 0);
+    EXPECT_EQ(read_buffer->GetDataLength(), 0u);
+}
+
+TEST(datagram_frame_utest, without_length_runs_to_packet_end) {
+    std::shared_ptr<common::SingleBlockBuffer> buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    PingFrame ping;
+    DatagramFrame datagram(FrameType::kDatagram);
+    datagram.SetData(MakeSpan("tail"));
+    EXPECT_TRUE(ping.Encode(buffer));
+    EXPECT_TRUE(datagram.Encode(buffer));
+    EXPECT_EQ(datagram.EncodeSize(), 5u);
+
+    std::vector<std::shared_ptr<IFrame>> frames;
+    EXPECT_TRUE(DecodeFrames(buffer, frames));
+    ASSERT_EQ(frames.size(), 2u);
+    ASSERT_EQ(frames[1]->GetType(), FrameType::kDatagram);
+    auto decoded = std::static_pointer_cast<DatagramFrame>(frames[1]);
+    EXPECT_EQ(decoded->GetLength(), 4u);
+    EXPECT_EQ(memcmp(decoded->GetData().GetStart(), "tail", 4), 0);
+
+    // ack-eliciting although 0x30 is outside the frame type bit field
+    EXPECT_TRUE(IsAckElictingPacket(frames[1]->GetFrameTypeBit()));
+    EXPECT_FALSE(IsRetransmittableFrame(frames[1]->GetType()));
+}
+
+TEST(datagram_frame_utest, truncated_length) {
+    std::shared_ptr<common::SingleBlockBuffer> buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    DatagramFrame datagram;
+    datagram.SetData(MakeSpan("0123456789"));
+    EXPECT_TRUE(datagram.Encode(buffer));
+
+    // drop the last bytes: the Length field now points past the packet
+    auto span = buffer->GetReadableSpan();
+    std::shared_ptr<common::SingleBlockBuffer> truncated = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+    memcpy(truncated->GetWritableSpan().GetStart(), span.GetStart(), span.GetLength() - 3);
+    truncated->MoveWritePt(span.GetLength() - 3);
+
+    DatagramFrame decoded;
+    EXPECT_FALSE(decoded.Decode(truncated, true));
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include "quic/frame/immediate_ack_frame.h"
+#include "common/buffer/single_block_buffer.h"
+#include "common/buffer/standalone_buffer_chunk.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+TEST(immediate_ack_frame_utest, codec) {
+    ImmediateAckFrame frame1;
+    ImmediateAckFrame frame2;
+
+    std::shared_ptr<common::SingleBlockBuffer> read_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+    std::shared_ptr<common::SingleBlockBuffer> write_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    EXPECT_TRUE(frame1.Encode(write_buffer));
+
+    auto data_span = write_buffer->GetReadableSpan();
+    auto pos_span = read_buffer->GetWritableSpan();
+    memcpy(pos_span.GetStart(), data_span.GetStart(), data_span.GetLength());
+    read_buffer->MoveWritePt(data_span.GetLength());
+    EXPECT_TRUE(frame2.Decode(read_buffer, true));
+
+    EXPECT_EQ(frame1.GetType(), frame2.GetType());
+    EXPECT_EQ(frame2.GetFrameTypeBit(), FrameTypeBit::kImmediateAckBit);
+}
+
+}
+}
+}
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include "quic/connection/util.h"
+#include "common/buffer/single_block_buffer.h"
+#include "common/buffer/standalone_buffer_chunk.h"
+#include "quic/frame/path_abandon_frame.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+TEST(path_abandon_frame_utest, codec) {
+    PathAbandonFrame frame1;
+    PathAbandonFrame frame2;
+
+    std::shared_ptr<common::SingleBlockBuffer> read_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+    std::shared_ptr<common::SingleBlockBuffer> write_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    frame1.SetPathId(7);
+    frame1.SetErrorCode(0x10);
+
+    EXPECT_TRUE(frame1.Encode(write_buffer));
+    EXPECT_EQ(write_buffer->GetDataLength(), frame1.EncodeSize());
+
+    auto data_span = write_buffer->GetReadableSpan();
+    auto pos_span = read_buffer->GetWritableSpan();
+    memcpy(pos_span.GetStart(), data_span.GetStart(), data_span.GetLength());
+    read_buffer->MoveWritePt(data_span.GetLength());
+    EXPECT_TRUE(frame2.Decode(read_buffer, true));
+
+    EXPECT_EQ(frame1.GetType(), frame2.GetType());
+    EXPECT_EQ(frame2.GetPathId(), 7u);
+    EXPECT_EQ(frame2.GetErrorCode(), 0x10u);
+    EXPECT_TRUE(IsAckElictingPacket(frame2.GetFrameTypeBit()));
+}
+
+}
+}
+}
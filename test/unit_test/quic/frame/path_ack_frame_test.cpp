@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "quic/connection/util.h"
+#include "quic/frame/frame_decode.h"
+#include "quic/frame/path_ack_frame.h"
+#include "common/buffer/single_block_buffer.h"
+#include "common/buffer/standalone_buffer_chunk.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+TEST(path_ack_frame_utest, codec) {
+    PathAckFrame frame1;
+    PathAckFrame frame2;
+
+    std::shared_ptr<common::SingleBlockBuffer> read_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+    std::shared_ptr<common::SingleBlockBuffer> write_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    frame1.SetPathId(3);
+    frame1.SetLargestAck(1000);
+    frame1.SetAckDelay(104);
+    frame1.SetFirstAckRange(5);
+    frame1.AddAckRange(2, 4);
+    frame1.AddAckRange(6, 8);
+
+    EXPECT_TRUE(frame1.Encode(write_buffer));
+    EXPECT_EQ(write_buffer->GetDataLength(), frame1.EncodeSize());
+    // the 32-bit frame type takes a four byte varint
+    auto data_span = write_buffer->GetReadableSpan();
+    EXPECT_EQ(data_span.GetStart()[0], 0x95);
+    EXPECT_EQ(data_span.GetStart()[1], 0x22);
+    EXPECT_EQ(data_span.GetStart()[2], 0x8c);
+    EXPECT_EQ(data_span.GetStart()[3], 0x00);
+
+    auto pos_span = read_buffer->GetWritableSpan();
+    memcpy(pos_span.GetStart(), data_span.GetStart(), data_span.GetLength());
+    read_buffer->MoveWritePt(data_span.GetLength());
+    EXPECT_TRUE(frame2.Decode(read_buffer, true));
+
+    EXPECT_EQ(frame2.GetType(), FrameType::kPathAck);
+    EXPECT_EQ(frame2.GetPathId(), 3u);
+    EXPECT_EQ(frame1.GetLargestAck(), frame2.GetLargestAck());
+    EXPECT_EQ(frame1.GetAckDelay(), frame2.GetAckDelay());
+    EXPECT_EQ(frame1.GetFirstAckRange(), frame2.GetFirstAckRange());
+    ASSERT_EQ(frame2.GetAckRange().size(), 2u);
+    EXPECT_EQ(frame2.GetAckRange()[1].GetGap(), 6u);
+    EXPECT_EQ(frame2.GetAckRange()[1].GetAckRangeLength(), 8u);
+    EXPECT_EQ(read_buffer->GetDataLength(), 0u);
+}
+
+TEST(path_ack_frame_utest, ecn_codec) {
+    PathAckFrame frame1(FrameType::kPathAckEcn);
+    PathAckFrame frame2;
+
+    std::shared_ptr<common::SingleBlockBuffer> buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    frame1.SetPathId(1);
+    frame1.SetLargestAck(20);
+    frame1.SetFirstAckRange(20);
+    frame1.SetEct0(15);
+    frame1.SetEct1(0);
+    frame1.SetEcnCe(6);
+
+    EXPECT_TRUE(frame1.Encode(buffer));
+    EXPECT_EQ(buffer->GetDataLength(), frame1.EncodeSize());
+    EXPECT_TRUE(frame2.Decode(buffer, true));
+
+    EXPECT_EQ(frame2.GetType(), FrameType::kPathAckEcn);
+    EXPECT_TRUE(frame2.HasEcnCounts());
+    EXPECT_EQ(frame2.GetPathId(), 1u);
+    EXPECT_EQ(frame2.GetLargestAck(), 20u);
+    EXPECT_EQ(frame2.GetEct0(), 15u);
+    EXPECT_EQ(frame2.GetEcnCe(), 6u);
+    EXPECT_EQ(buffer->GetDataLength(), 0u);
+}
+
+TEST(path_ack_frame_utest, decode_frames) {
+    std::shared_ptr<common::SingleBlockBuffer> buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    PathAckFrame path_ack;
+    path_ack.SetPathId(2);
+    path_ack.SetLargestAck(9);
+    EXPECT_TRUE(path_ack.Encode(buffer));
+
+    std::vector<std::shared_ptr<IFrame>> frames;
+    EXPECT_TRUE(DecodeFrames(buffer, frames));
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0]->GetType(), FrameType::kPathAck);
+    EXPECT_EQ(std::dynamic_pointer_cast<PathAckFrame>(frames[0])->GetPathId(), 2u);
+
+    // like ACK, PATH_ACK alone does not elicit an acknowledgement
+    EXPECT_FALSE(IsAckElictingPacket(frames[0]->GetFrameTypeBit()));
+}
+
+TEST(path_ack_frame_utest, reject_type_without_prefix) {
+    std::shared_ptr<common::SingleBlockBuffer> buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    // the low 16 bits of PATH_ACK (0x8c00) without the 0x1522 prefix
+    uint8_t data[] = {0x80, 0x00, 0x8c, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00};
+    auto span = buffer->GetWritableSpan();
+    memcpy(span.GetStart(), data, sizeof(data));
+    buffer->MoveWritePt(sizeof(data));
+
+    std::vector<std::shared_ptr<IFrame>> frames;
+    EXPECT_FALSE(DecodeFrames(buffer, frames));
+    EXPECT_TRUE(frames.empty());
+}
+
+}
+}
+}
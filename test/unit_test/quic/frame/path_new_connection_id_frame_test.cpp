@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "common/buffer/single_block_buffer.h"
+#include "common/buffer/standalone_buffer_chunk.h"
+#include "quic/frame/path_new_connection_id_frame.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+TEST(path_new_connection_id_frame_utest, codec) {
+    PathNewConnectionIDFrame frame1;
+    PathNewConnectionIDFrame frame2;
+
+    std::shared_ptr<common::SingleBlockBuffer> read_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(256));
+    std::shared_ptr<common::SingleBlockBuffer> write_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(256));
+
+    frame1.SetPathId(4);
+    frame1.SetRetirePriorTo(1);
+    frame1.SetSequenceNumber(3);
+
+    uint8_t token[kStatelessResetTokenLength];
+    for (size_t i = 0; i < kStatelessResetTokenLength; i++) {
+        token[i] = i;
+    }
+    frame1.SetStatelessResetToken(token);
+
+    uint8_t cid_bytes[] = {1,2,3,4,5,6,7,8};
+    uint8_t len = sizeof(cid_bytes);
+    frame1.SetConnectionID(cid_bytes, len);
+
+    EXPECT_TRUE(frame1.Encode(write_buffer));
+    EXPECT_EQ(write_buffer->GetDataLength(), frame1.EncodeSize());
+
+    auto data_span = write_buffer->GetReadableSpan();
+    auto pos_span = read_buffer->GetWritableSpan();
+    memcpy(pos_span.GetStart(), data_span.GetStart(), data_span.GetLength());
+    read_buffer->MoveWritePt(data_span.GetLength());
+    EXPECT_TRUE(frame2.Decode(read_buffer, true));
+
+    EXPECT_EQ(frame2.GetType(), FrameType::kPathNewConnectionId);
+    EXPECT_EQ(frame2.GetPathId(), 4u);
+    EXPECT_EQ(frame1.GetRetirePriorTo(), frame2.GetRetirePriorTo());
+    EXPECT_EQ(frame1.GetSequenceNumber(), frame2.GetSequenceNumber());
+
+    ConnectionID cid;
+    frame2.GetConnectionID(cid);
+    EXPECT_EQ(std::string((char*)cid.GetID(), cid.GetLength()), std::string((char*)cid_bytes, len));
+    EXPECT_EQ(std::string((char*)frame1.GetStatelessResetToken(), kStatelessResetTokenLength),
+        std::string((char*)frame2.GetStatelessResetToken(), kStatelessResetTokenLength));
+}
+
+TEST(path_new_connection_id_frame_utest, reject_new_connection_id_type) {
+    NewConnectionIDFrame frame1;
+    PathNewConnectionIDFrame frame2;
+
+    std::shared_ptr<common::SingleBlockBuffer> buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(256));
+
+    uint8_t cid_bytes[] = {1,2,3,4};
+    frame1.SetConnectionID(cid_bytes, sizeof(cid_bytes));
+    EXPECT_TRUE(frame1.Encode(buffer));
+    EXPECT_FALSE(frame2.Decode(buffer, true));
+}
+
+}
+}
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "common/buffer/single_block_buffer.h"
+#include "common/buffer/standalone_buffer_chunk.h"
+#include "quic/frame/frame_decode.h"
+#include "quic/frame/path_status_frame.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+TEST(path_status_frame_utest, codec) {
+    PathStatusFrame frame1(FrameType::kPathStatusBackup);
+    PathStatusFrame frame2;
+
+    std::shared_ptr<common::SingleBlockBuffer> read_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+    std::shared_ptr<common::SingleBlockBuffer> write_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    frame1.SetPathId(1);
+    frame1.SetSequenceNumber(5);
+
+    EXPECT_TRUE(frame1.Encode(write_buffer));
+    EXPECT_EQ(write_buffer->GetDataLength(), frame1.EncodeSize());
+
+    auto data_span = write_buffer->GetReadableSpan();
+    auto pos_span = read_buffer->GetWritableSpan();
+    memcpy(pos_span.GetStart(), data_span.GetStart(), data_span.GetLength());
+    read_buffer->MoveWritePt(data_span.GetLength());
+    EXPECT_TRUE(frame2.Decode(read_buffer, true));
+
+    EXPECT_EQ(frame2.GetType(), FrameType::kPathStatusBackup);
+    EXPECT_TRUE(frame2.IsBackup());
+    EXPECT_EQ(frame2.GetPathId(), 1u);
+    EXPECT_EQ(frame2.GetSequenceNumber(), 5u);
+}
+
+TEST(path_status_frame_utest, decode_frames) {
+    std::shared_ptr<common::SingleBlockBuffer> buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(128));
+
+    PathStatusFrame backup(FrameType::kPathStatusBackup);
+    PathStatusFrame available(FrameType::kPathStatusAvailable);
+    backup.SetSequenceNumber(1);
+    available.SetSequenceNumber(2);
+    EXPECT_TRUE(backup.Encode(buffer));
+    EXPECT_TRUE(available.Encode(buffer));
+
+    std::vector<std::shared_ptr<IFrame>> frames;
+    EXPECT_TRUE(DecodeFrames(buffer, frames));
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0]->GetType(), FrameType::kPathStatusBackup);
+    EXPECT_EQ(frames[1]->GetType(), FrameType::kPathStatusAvailable);
+}
+
+}
+}
+}
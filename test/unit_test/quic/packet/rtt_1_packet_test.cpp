@@ -80,6 +80,41 @@ TEST(rtt_1_packet_utest, crypto_codec) {
     }
 }
 
+// draft-ietf-quic-multipath: the path ID is part of the nonce, so a packet
+// only opens with the path ID it was sealed with.
+TEST(rtt_1_packet_utest, path_id_in_nonce) {
+    auto frame = PacketTest::GetTestFrame();
+
+    std::shared_ptr<common::SingleBlockBuffer> frame_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(kBufLength));
+    EXPECT_TRUE(frame->Encode(frame_buffer));
+
+    auto encode = [&](uint32_t path_id) {
+        Rtt1Packet packet;
+        common::SharedBufferSpan payload(frame_buffer->GetSharedReadableSpan()); packet.SetPayload(payload);
+        packet.SetPacketNumber(10);
+        packet.GetHeader()->SetPacketNumberLength(2);
+        packet.SetPathId(path_id);
+        packet.SetCryptographer(PacketTest::Instance().GetTestClientCryptographer());
+        std::shared_ptr<common::SingleBlockBuffer> packet_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(kBufLength));
+        EXPECT_TRUE(packet.Encode(packet_buffer));
+        return packet_buffer;
+    };
+    auto decode = [&](std::shared_ptr<common::SingleBlockBuffer> packet_buffer, uint32_t path_id) {
+        HeaderFlag flag;
+        EXPECT_TRUE(flag.DecodeFlag(packet_buffer));
+        Rtt1Packet new_packet(flag.GetFlag());
+        new_packet.SetCryptographer(PacketTest::Instance().GetTestServerCryptographer());
+        new_packet.SetPathId(path_id);
+        EXPECT_TRUE(new_packet.DecodeWithoutCrypto(packet_buffer));
+        std::shared_ptr<common::SingleBlockBuffer> plaintext_buffer = std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(kBufLength));
+        return new_packet.DecodeWithCrypto(plaintext_buffer);
+    };
+
+    EXPECT_TRUE(decode(encode(3), 3));
+    EXPECT_FALSE(decode(encode(3), 0));
+    EXPECT_FALSE(decode(encode(0), 1));
+}
+
 }
 }
 }
\ No newline at end of file
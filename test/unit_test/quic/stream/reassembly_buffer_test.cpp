@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "common/buffer/multi_block_buffer.h"
+
+#include "quic/config.h"
+#include "quic/quicx/global_resource.h"
+#include "quic/stream/reassembly_buffer.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+class ReassemblyBufferTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        pool_ = GlobalResource::Instance().GetThreadLocalBlockPool();
+        reader_ = std::make_shared<common::MultiBlockBuffer>(pool_, false);
+        // position-dependent bytes so misplaced data shows up
+        for (uint32_t i = 0; i < 4 * pool_->GetBlockLength(); i++) {
+            source_.push_back(static_cast<uint8_t>(i * 7 + i / 251));
+        }
+    }
+
+    bool Insert(ReassemblyBuffer& buffer, uint64_t offset, uint32_t len, uint64_t& new_bytes) {
+        return buffer.Insert(offset, source_.data() + offset, len, new_bytes);
+    }
+
+    std::string Expected(uint64_t offset, uint64_t len) {
+        return std::string(reinterpret_cast<const char*>(source_.data() + offset), len);
+    }
+
+    std::shared_ptr<common::BlockMemoryPool> pool_;
+    std::shared_ptr<common::MultiBlockBuffer> reader_;
+    std::vector<uint8_t> source_;
+};
+
+TEST_F(ReassemblyBufferTest, InOrderDataReachesReaderWithoutCopy) {
+    ReassemblyBuffer buffer(pool_);
+    uint64_t new_bytes = 0;
+
+    ASSERT_TRUE(Insert(buffer, 0, 100, new_bytes));
+    EXPECT_EQ(new_bytes, 100u);
+    EXPECT_EQ(buffer.Drain(*reader_), 100u);
+    ASSERT_TRUE(Insert(buffer, 100, 200, new_bytes));
+    EXPECT_EQ(buffer.Drain(*reader_), 200u);
+
+    // both pieces share one block and one reader chunk
+    EXPECT_EQ(reader_->GetChunkCount(), 1u);
+    EXPECT_EQ(reader_->GetDataAsString(), Expected(0, 300));
+    EXPECT_EQ(buffer.Drain(*reader_), 0u);
+}
+
+TEST_F(ReassemblyBufferTest, FillsGapsOutOfOrder) {
+    ReassemblyBuffer buffer(pool_);
+    uint64_t new_bytes = 0;
+
+    ASSERT_TRUE(Insert(buffer, 100, 100, new_bytes));
+    ASSERT_TRUE(Insert(buffer, 300, 100, new_bytes));
+    EXPECT_EQ(buffer.GetRangeCount(), 2u);
+    EXPECT_EQ(buffer.GetReadOffset(), 0u);
+    EXPECT_EQ(buffer.GetHighestOffset(), 400u);
+    EXPECT_EQ(buffer.Drain(*reader_), 0u);
+
+    ASSERT_TRUE(Insert(buffer, 0, 100, new_bytes));
+    EXPECT_EQ(buffer.GetReadOffset(), 200u);
+    EXPECT_EQ(buffer.GetRangeCount(), 1u);
+
+    ASSERT_TRUE(Insert(buffer, 200, 100, new_bytes));
+    EXPECT_EQ(buffer.GetReadOffset(), 400u);
+    EXPECT_EQ(buffer.GetRangeCount(), 0u);
+
+    EXPECT_EQ(buffer.Drain(*reader_), 400u);
+    EXPECT_EQ(reader_->GetDataAsString(), Expected(0, 400));
+}
+
+TEST_F(ReassemblyBufferTest, DuplicatesAndOverlapsCountOnlyNewBytes) {
+    ReassemblyBuffer buffer(pool_);
+    uint64_t new_bytes = 0;
+
+    ASSERT_TRUE(Insert(buffer, 100, 100, new_bytes));
+    ASSERT_TRUE(Insert(buffer, 100, 100, new_bytes));
+    EXPECT_EQ(new_bytes, 0u);
+
+    // covers [50, 250): the held [100, 200) is not counted again
+    ASSERT_TRUE(Insert(buffer, 50, 200, new_bytes));
+    EXPECT_EQ(new_bytes, 100u);
+    EXPECT_EQ(buffer.GetRangeCount(), 1u);
+
+    ASSERT_TRUE(Insert(buffer, 0, 60, new_bytes));
+    EXPECT_EQ(new_bytes, 50u);
+    EXPECT_EQ(buffer.GetReadOffset(), 250u);
+
+    // already delivered
+    ASSERT_TRUE(Insert(buffer, 0, 250, new_bytes));
+    EXPECT_EQ(new_bytes, 0u);
+
+    EXPECT_EQ(buffer.Drain(*reader_), 250u);
+    EXPECT_EQ(reader_->GetDataAsString(), Expected(0, 250));
+}
+
+TEST_F(ReassemblyBufferTest, DataSpanningBlocks) {
+    ReassemblyBuffer buffer(pool_);
+    uint32_t block = pool_->GetBlockLength();
+    uint64_t new_bytes = 0;
+
+    ASSERT_TRUE(Insert(buffer, block - 10, block + 20, new_bytes));
+    ASSERT_TRUE(Insert(buffer, 0, block - 10, new_bytes));
+    EXPECT_EQ(buffer.Drain(*reader_), 2u * block + 10);
+    EXPECT_EQ(reader_->GetDataAsString(), Expected(0, 2 * block + 10));
+
+    // blocks drained to the reader left the ring, the rest continues in place
+    reader_->MoveReadPt(reader_->GetDataLength());
+    ASSERT_TRUE(Insert(buffer, 2 * block + 10, block, new_bytes));
+    EXPECT_EQ(buffer.Drain(*reader_), block);
+    EXPECT_EQ(reader_->GetDataAsString(), Expected(2 * block + 10, block));
+}
+
+TEST_F(ReassemblyBufferTest, RejectsDataBeyondMaxSpan) {
+    ReassemblyBuffer buffer(pool_, 1000);
+    uint64_t new_bytes = 0;
+
+    EXPECT_FALSE(Insert(buffer, 900, 101, new_bytes));
+    EXPECT_TRUE(Insert(buffer, 900, 100, new_bytes));
+    EXPECT_TRUE(Insert(buffer, 0, 500, new_bytes));
+    // the span moves with the read offset
+    EXPECT_TRUE(Insert(buffer, 1400, 100, new_bytes));
+}
+
+TEST_F(ReassemblyBufferTest, LimitsNumberOfRanges) {
+    ReassemblyBuffer buffer(pool_);
+    uint64_t new_bytes = 0;
+
+    for (size_t i = 0; i < kMaxReassemblyRanges; i++) {
+        ASSERT_TRUE(buffer.Insert(2 * i + 1, source_.data(), 1, new_bytes));
+    }
+    EXPECT_FALSE(buffer.Insert(2 * kMaxReassemblyRanges + 1, source_.data(), 1, new_bytes));
+    // joining existing ranges is still fine
+    EXPECT_TRUE(buffer.Insert(2, source_.data(), 1, new_bytes));
+    EXPECT_EQ(buffer.GetRangeCount(), kMaxReassemblyRanges - 1);
+    EXPECT_TRUE(buffer.Insert(0, source_.data(), 1, new_bytes));
+    EXPECT_EQ(buffer.GetReadOffset(), 4u);
+}
+
+TEST_F(ReassemblyBufferTest, ResetStartsOver) {
+    ReassemblyBuffer buffer(pool_);
+    uint64_t new_bytes = 0;
+
+    ASSERT_TRUE(Insert(buffer, 0, 100, new_bytes));
+    ASSERT_TRUE(Insert(buffer, 200, 100, new_bytes));
+    buffer.Reset();
+    EXPECT_EQ(buffer.GetReadOffset(), 0u);
+    EXPECT_EQ(buffer.GetRangeCount(), 0u);
+
+    ASSERT_TRUE(Insert(buffer, 0, 50, new_bytes));
+    EXPECT_EQ(new_bytes, 50u);
+    EXPECT_EQ(buffer.Drain(*reader_), 50u);
+}
+
+TEST_F(ReassemblyBufferTest, SkipOnlyWhenNothingIsHeld) {
+    ReassemblyBuffer buffer(pool_);
+    uint64_t new_bytes = 0;
+
+    // bytes passed on by the caller never enter the ring
+    ASSERT_TRUE(buffer.Skip(0, 100));
+    EXPECT_EQ(buffer.GetReadOffset(), 100u);
+    EXPECT_EQ(buffer.Drain(*reader_), 0u);
+
+    // not at the read offset, or with data held beyond it
+    EXPECT_FALSE(buffer.Skip(120, 10));
+    ASSERT_TRUE(Insert(buffer, 150, 50, new_bytes));
+    EXPECT_FALSE(buffer.Skip(100, 20));
+
+    // filled but not drained yet
+    ASSERT_TRUE(Insert(buffer, 100, 50, new_bytes));
+    EXPECT_FALSE(buffer.Skip(200, 10));
+    EXPECT_EQ(buffer.Drain(*reader_), 100u);
+
+    ASSERT_TRUE(buffer.Skip(200, 10));
+    ASSERT_TRUE(Insert(buffer, 210, 30, new_bytes));
+    EXPECT_EQ(new_bytes, 30u);
+    EXPECT_EQ(buffer.Drain(*reader_), 30u);
+    EXPECT_EQ(reader_->GetDataAsString(), Expected(100, 100) + Expected(210, 30));
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
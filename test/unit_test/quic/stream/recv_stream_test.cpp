@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 #include "common/buffer/single_block_buffer.h"
 #include "common/buffer/standalone_buffer_chunk.h"
@@ -611,11 +612,14 @@ TEST_F(RecvStreamTest, RecvStreamDataBlocked) {
     auto stream = std::make_shared<RecvStream>(event_loop, 10000, 5, active_send_cb_, stream_close_cb_,
         connection_close_cb_);  // initial limit 10000
 
-    stream->SetStreamReadCallBack(recv_cb_);
+    // the application reads everything it is given
+    stream->SetStreamReadCallBack([this](std::shared_ptr<IBufferRead> buffer, bool is_last, uint32_t err) {
+        recv_cb_(buffer, is_last, err);
+        buffer->MoveReadPt(buffer->GetDataLength());
+    });
 
     // 1. Recv partial data (small enough to NOT trigger auto-update)
-    // Limit 10000. Threshold 7360. Need remaining > 7360.
-    // 10000 - offset > 7360 => offset < 2640.
+    // Limit 10000, an update is due once 5000 bytes were read.
     // Send 1000 bytes.
     auto frame1 = std::make_shared<StreamFrame>();
     frame1->SetStreamID(5);
@@ -638,8 +642,8 @@ TEST_F(RecvStreamTest, RecvStreamDataBlocked) {
 
     stream->OnFrame(block_frame);
 
-    // Server should send MAX_STREAM_DATA (10000 + 3096 = 13096)
-    // AND update local limit to 13096.
+    // Server should hand back what was read: MAX_STREAM_DATA 1000 + 10000
+    EXPECT_EQ(stream->GetLocalDataLimit(), 11000u);
 
     // 3. Recv data beyond old limit (10000)
     auto frame2 = std::make_shared<StreamFrame>();
@@ -662,6 +666,103 @@ TEST_F(RecvStreamTest, RecvStreamDataBlocked) {
     // If rejected due to flow control, it returns 0.
 }
 
+// Test 6.2: credit follows what the application reads
+TEST_F(RecvStreamTest, RecvWindowFollowsConsumption) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto stream = std::make_shared<RecvStream>(event_loop, 10000, 5, active_send_cb_, stream_close_cb_,
+        connection_close_cb_);
+
+    std::shared_ptr<IBufferRead> held;
+    uint64_t reported = 0;
+    stream->SetStreamReadCallBack([&held](std::shared_ptr<IBufferRead> buffer, bool, uint32_t) { held = buffer; });
+    stream->SetDataConsumedCallBack([&reported](uint64_t bytes) { reported += bytes; });
+
+    auto send = [&stream](uint64_t offset, uint32_t len) {
+        std::vector<uint8_t> data(len, 'A');
+        auto data_buffer =
+            std::make_shared<common::SingleBlockBuffer>(std::make_shared<common::StandaloneBufferChunk>(len));
+        data_buffer->Write(data.data(), len);
+        auto frame = std::make_shared<StreamFrame>();
+        frame->SetStreamID(5);
+        frame->SetOffset(offset);
+        frame->SetData(data_buffer->GetSharedReadableSpan());
+        return stream->OnFrame(frame);
+    };
+
+    // nothing read yet: the window does not move
+    EXPECT_EQ(send(0, 6000), 6000u);
+    EXPECT_EQ(stream->GetLocalDataLimit(), 10000u);
+    EXPECT_EQ(stream->GetUnconsumedBytes(), 6000u);
+
+    // the application reads, the next frame carries the update
+    ASSERT_NE(held, nullptr);
+    held->MoveReadPt(6000);
+    EXPECT_EQ(send(6000, 100), 100u);
+    EXPECT_EQ(reported, 6000u);
+    EXPECT_EQ(stream->GetLocalDataLimit(), 16000u);
+    EXPECT_EQ(stream->GetUnconsumedBytes(), 100u);
+}
+
+TEST_F(RecvStreamTest, ZeroCopyReadHandsOverPacketMemory) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto stream = std::make_shared<RecvStream>(event_loop, 10000, 5, active_send_cb_, stream_close_cb_,
+        connection_close_cb_);
+
+    std::vector<std::shared_ptr<IBufferRead>> held;
+    uint64_t reported = 0;
+    stream->SetZeroCopyRead(true);
+    stream->SetStreamReadCallBack([&held](std::shared_ptr<IBufferRead> buffer, bool, uint32_t) {
+        held.push_back(buffer);
+    });
+    stream->SetDataConsumedCallBack([&reported](uint64_t bytes) { reported += bytes; });
+
+    // the decrypted packet's block
+    auto send = [&stream](uint64_t offset, std::shared_ptr<common::IBufferChunk> chunk, uint32_t len) {
+        memset(chunk->GetData(), 'Z', len);
+        auto frame = std::make_shared<StreamFrame>();
+        frame->SetStreamID(5);
+        frame->SetOffset(offset);
+        frame->SetData(common::SharedBufferSpan(chunk, chunk->GetData(), len));
+        return stream->OnFrame(frame);
+    };
+
+    std::shared_ptr<common::IBufferChunk> packet = std::make_shared<common::StandaloneBufferChunk>(6000);
+    std::weak_ptr<common::IBufferChunk> weak_packet = packet;
+    uint8_t* packet_data = packet->GetData();
+    EXPECT_EQ(send(0, packet, 6000), 6000u);
+    packet.reset();
+
+    // in order: the application reads the packet's own bytes
+    ASSERT_EQ(held.size(), 1u);
+    uint8_t* first = nullptr;
+    held[0]->VisitData([&first](uint8_t* data, uint32_t) {
+        first = data;
+        return false;
+    });
+    EXPECT_EQ(first, packet_data);
+    EXPECT_FALSE(weak_packet.expired());
+    EXPECT_EQ(stream->GetHeldReadBytes(), 6000u);
+
+    // out of order data goes through the ring and comes in its own buffer
+    EXPECT_EQ(send(7000, std::make_shared<common::StandaloneBufferChunk>(100), 100), 100u);
+    EXPECT_EQ(held.size(), 1u);
+    EXPECT_EQ(send(6000, std::make_shared<common::StandaloneBufferChunk>(1000), 1000), 1000u);
+    ASSERT_EQ(held.size(), 2u);
+    EXPECT_EQ(held[1]->GetDataLength(), 1100u);
+
+    // nothing is consumed while the application holds the buffers
+    EXPECT_EQ(reported, 0u);
+    EXPECT_EQ(stream->GetLocalDataLimit(), 10000u);
+
+    held[0].reset();
+    EXPECT_TRUE(weak_packet.expired());
+    EXPECT_EQ(reported, 6000u);
+    EXPECT_EQ(stream->GetHeldReadBytes(), 1100u);
+    EXPECT_EQ(stream->GetLocalDataLimit(), 16000u);
+}
+
 }  // namespace
 }  // namespace quic
 }  // namespace quicx
\ No newline at end of file
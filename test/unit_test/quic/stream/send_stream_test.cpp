@@ -477,6 +477,168 @@ TEST_F(SendStreamTest, OnDataAckedBasic) {
     EXPECT_TRUE(state == StreamState::kSend || state == StreamState::kDataSent || state == StreamState::kReady);
 }
 
+// ==== 7. GetSendableBytes test (1) ====
+
+// Test 7.1: sendable bytes follow stream credit, connection budget and buffered data
+TEST_F(SendStreamTest, SendableBytesTracksCreditAndBuffer) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto stream =
+        std::make_shared<SendStream>(event_loop, 10000, 4, active_send_cb_, stream_close_cb_, connection_close_cb_);
+
+    // only the stream's own credit without a connection budget
+    EXPECT_EQ(stream->GetSendableBytes(), 10000u);
+
+    uint64_t budget = 3000;
+    stream->SetSendBudgetProvider([&budget]() { return budget; });
+    EXPECT_EQ(stream->GetSendableBytes(), 3000u);
+
+    // buffered data is already committed
+    uint8_t data[1000];
+    memset(data, 'C', sizeof(data));
+    stream->Send(data, sizeof(data));
+    EXPECT_EQ(stream->GetSendableBytes(), 2000u);
+
+    budget = 50000;
+    EXPECT_EQ(stream->GetSendableBytes(), 9000u);
+
+    budget = 500;
+    EXPECT_EQ(stream->GetSendableBytes(), 0u);
+
+    stream->Close();
+    budget = 50000;
+    EXPECT_EQ(stream->GetSendableBytes(), 0u);
+}
+
+// ==== 8. send buffer watermark test (2) ====
+
+// send one STREAM frame of at most 1000 bytes
+static void SendOneFrame(std::shared_ptr<SendStream> stream) {
+    FixBufferFrameVisitor visitor(1500);
+    visitor.SetStreamDataSizeLimit(1000);
+    stream->TrySendData(&visitor);
+}
+
+// Test 8.1: Send takes what fits below the high mark and the writable
+// callback fires once the buffer drained to the low mark
+TEST_F(SendStreamTest, SendStopsAtHighWatermark) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto stream =
+        std::make_shared<SendStream>(event_loop, 100000, 4, active_send_cb_, stream_close_cb_, connection_close_cb_);
+    stream->SetSendBufferWatermark(3000, 1000);
+    int writable_calls = 0;
+    uint64_t writable_bytes = 0;
+    stream->SetStreamWritableCallBack([&](uint64_t bytes) {
+        writable_calls++;
+        writable_bytes = bytes;
+    });
+
+    uint8_t data[2000];
+    memset(data, 'W', sizeof(data));
+    EXPECT_EQ(stream->Send(data, sizeof(data)), 2000);
+    EXPECT_EQ(stream->Send(data, sizeof(data)), 1000);
+    EXPECT_EQ(stream->Send(data, 10), 0);
+    EXPECT_EQ(stream->GetPendingSendBytes(), 3000u);
+
+    // 2000 bytes left, still above the low mark
+    SendOneFrame(stream);
+    EXPECT_EQ(stream->GetPendingSendBytes(), 2000u);
+    EXPECT_EQ(writable_calls, 0);
+
+    SendOneFrame(stream);
+    EXPECT_EQ(stream->GetPendingSendBytes(), 1000u);
+    EXPECT_EQ(writable_calls, 1);
+    EXPECT_EQ(writable_bytes, 2000u);
+
+    // once per blocked period
+    SendOneFrame(stream);
+    EXPECT_EQ(writable_calls, 1);
+
+    // without a high mark nothing is refused
+    stream->SetSendBufferWatermark(0, 0);
+    uint8_t big[8000];
+    memset(big, 'B', sizeof(big));
+    EXPECT_EQ(stream->Send(big, sizeof(big)), 8000);
+}
+
+// Test 8.2: the connection's marks cover every stream; a stream refused by
+// them goes on when the connection drained, even with nothing of its own
+TEST_F(SendStreamTest, ConnectionWatermarkSharedByStreams) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto conn_watermark = std::make_shared<SendBufferWatermark>();
+    conn_watermark->SetMarks(2000, 500);
+    auto stream_a =
+        std::make_shared<SendStream>(event_loop, 100000, 4, active_send_cb_, stream_close_cb_, connection_close_cb_);
+    auto stream_b =
+        std::make_shared<SendStream>(event_loop, 100000, 8, active_send_cb_, stream_close_cb_, connection_close_cb_);
+    stream_a->SetConnectionWatermark(conn_watermark);
+    stream_b->SetConnectionWatermark(conn_watermark);
+    bool b_writable = false;
+    stream_b->SetStreamWritableCallBack([&](uint64_t) { b_writable = true; });
+
+    uint8_t data[2000];
+    memset(data, 'S', sizeof(data));
+    EXPECT_EQ(stream_a->Send(data, sizeof(data)), 2000);
+    EXPECT_EQ(conn_watermark->GetQueued(), 2000u);
+    EXPECT_EQ(stream_b->Send(data, 100), 0);
+    EXPECT_TRUE(conn_watermark->IsBlocked());
+
+    SendOneFrame(stream_a);
+    EXPECT_FALSE(conn_watermark->TakeBlockedIfDrained());
+    SendOneFrame(stream_a);
+    EXPECT_EQ(conn_watermark->GetQueued(), 0u);
+    // what StreamManager does after building frames
+    ASSERT_TRUE(conn_watermark->TakeBlockedIfDrained());
+    stream_b->CheckWritable();
+    EXPECT_TRUE(b_writable);
+    EXPECT_EQ(stream_b->Send(data, 100), 100);
+
+    // a stream leaving the connection gives its bytes back
+    stream_b->ReleaseSendBuffer();
+    EXPECT_EQ(conn_watermark->GetQueued(), 0u);
+}
+
+// ==== 9. zero-copy send test (1) ====
+
+// Test 9.1: caller memory is sent in place and released once ACKed
+TEST_F(SendStreamTest, SendZeroCopyReleasesAfterAck) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto stream =
+        std::make_shared<SendStream>(event_loop, 100000, 4, active_send_cb_, stream_close_cb_, connection_close_cb_);
+
+    std::vector<uint8_t> payload(5000, 'Z');
+    int released = 0;
+    EXPECT_EQ(stream->SendZeroCopy(payload.data(), payload.size(), [&]() { released++; }), 5000);
+    EXPECT_EQ(stream->GetPendingSendBytes(), 5000u);
+
+    while (stream->GetPendingSendBytes() > 0) {
+        SendOneFrame(stream);
+    }
+    // still held for retransmission
+    EXPECT_EQ(stream->GetRetainedSendBytes(), 5000u);
+    EXPECT_EQ(released, 0);
+
+    stream->OnDataAcked(5000, false);
+    EXPECT_EQ(released, 1);
+
+    // a full buffer refuses it and leaves the memory with the caller
+    stream->SetSendBufferWatermark(1000, 0);
+    uint8_t data[1000];
+    memset(data, 'F', sizeof(data));
+    EXPECT_EQ(stream->Send(data, sizeof(data)), 1000);
+    bool refused_released = false;
+    EXPECT_EQ(stream->SendZeroCopy(payload.data(), payload.size(), [&]() { refused_released = true; }), 0);
+    EXPECT_FALSE(refused_released);
+
+    // once there is room it is taken whole
+    SendOneFrame(stream);
+    EXPECT_EQ(stream->SendZeroCopy(payload.data(), payload.size(), [&]() { released++; }), 5000);
+    EXPECT_EQ(stream->GetPendingSendBytes(), 5000u);
+}
+
 }  // namespace
 }  // namespace quic
 }  // namespace quicx
\ No newline at end of file
@@ -12,6 +12,7 @@
 
 #include "quic/connection/controler/send_control.h"
 #include "quic/frame/ack_frame.h"
+#include "quic/frame/max_data_frame.h"
 #include "quic/frame/stream_frame.h"
 #include "quic/packet/rtt_1_packet.h"
 #include "quic/stream/fix_buffer_frame_visitor.h"
@@ -25,6 +26,8 @@ class MockTimer: public common::ITimer {
 public:
     virtual uint64_t AddTimer(common::TimerTask& task, uint32_t time, uint64_t now = 0) override { return 1; }
     virtual bool RemoveTimer(common::TimerTask& task) override { return true; }
+    virtual void ArmTimer(common::TimerNode& node, uint32_t time, uint64_t now = 0) override {}
+    virtual bool DisarmTimer(common::TimerNode& node) override { return true; }
     virtual int32_t MinTime(uint64_t now = 0) override { return -1; }
     virtual void TimerRun(uint64_t now = 0) override {}
     virtual bool Empty() override { return true; }
@@ -445,3 +448,173 @@ TEST_F(StreamAckTrackingTest, MultipleStreamsInOnePacket) {
     EXPECT_TRUE(found_stream4);
     EXPECT_TRUE(found_stream8);
 }
+
+// Test 11: A lost range is resent from the retained send data
+TEST_F(StreamAckTrackingTest, LostDataIsResent) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto stream =
+        std::make_shared<SendStream>(event_loop, 10000, 4, active_send_cb_, stream_close_cb_, connection_close_cb_);
+
+    uint8_t data[] = "Hello World from QUIC!";
+    stream->Send(data, 22);
+    stream->Close();
+
+    FixBufferFrameVisitor visitor(1500);
+    visitor.SetStreamDataSizeLimit(10000);
+    ASSERT_EQ(stream->TrySendData(&visitor), IStream::TrySendResult::kSuccess);
+
+    stream->OnDataLost(0, 22, true);
+    EXPECT_TRUE(stream->HasLostData());
+
+    FixBufferFrameVisitor resend_visitor(1500);
+    resend_visitor.SetStreamDataSizeLimit(10000);
+    ASSERT_EQ(stream->TrySendData(&resend_visitor), IStream::TrySendResult::kSuccess);
+    EXPECT_FALSE(stream->HasLostData());
+
+    auto stream_data = resend_visitor.GetStreamDataInfo();
+    ASSERT_EQ(stream_data.size(), 1);
+    EXPECT_EQ(stream_data[0].offset_start, 0);
+    EXPECT_EQ(stream_data[0].length, 22);
+    EXPECT_TRUE(stream_data[0].has_fin);
+}
+
+// Test 12: Bytes ACKed through another packet are not resent
+TEST_F(StreamAckTrackingTest, LostDataSkipsAckedRanges) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto stream =
+        std::make_shared<SendStream>(event_loop, 10000, 4, active_send_cb_, stream_close_cb_, connection_close_cb_);
+
+    uint8_t data[] = "Hello World from QUIC!";
+    stream->Send(data, 22);
+    stream->Close();
+
+    FixBufferFrameVisitor visitor(1500);
+    visitor.SetStreamDataSizeLimit(10000);
+    ASSERT_EQ(stream->TrySendData(&visitor), IStream::TrySendResult::kSuccess);
+
+    stream->OnDataAcked(0, 10, false);
+    stream->OnDataLost(0, 22, true);
+
+    FixBufferFrameVisitor resend_visitor(1500);
+    resend_visitor.SetStreamDataSizeLimit(10000);
+    ASSERT_EQ(stream->TrySendData(&resend_visitor), IStream::TrySendResult::kSuccess);
+
+    auto stream_data = resend_visitor.GetStreamDataInfo();
+    ASSERT_EQ(stream_data.size(), 1);
+    EXPECT_EQ(stream_data[0].offset_start, 10);
+    EXPECT_EQ(stream_data[0].length, 12);
+    EXPECT_TRUE(stream_data[0].has_fin);
+
+    // Once everything is ACKed a late loss report is ignored.
+    stream->OnDataAcked(10, 12, true);
+    stream->OnDataLost(0, 22, true);
+    EXPECT_FALSE(stream->HasLostData());
+}
+
+// Test 13: Nothing is resent after RESET_STREAM
+TEST_F(StreamAckTrackingTest, LostDataDroppedAfterReset) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto stream =
+        std::make_shared<SendStream>(event_loop, 10000, 4, active_send_cb_, stream_close_cb_, connection_close_cb_);
+
+    uint8_t data[] = "Hello";
+    stream->Send(data, 5);
+
+    FixBufferFrameVisitor visitor(1500);
+    visitor.SetStreamDataSizeLimit(10000);
+    ASSERT_EQ(stream->TrySendData(&visitor), IStream::TrySendResult::kSuccess);
+
+    stream->OnDataLost(0, 5, false);
+    EXPECT_TRUE(stream->HasLostData());
+    stream->Reset(0);
+    EXPECT_FALSE(stream->HasLostData());
+
+    stream->OnDataLost(0, 5, false);
+    EXPECT_FALSE(stream->HasLostData());
+}
+
+// Test 14: Application-space losses are reported as stream ranges and
+// control frames, not as whole packets to replay
+TEST_F(StreamAckTrackingTest, SendControlReportsLostFrames) {
+    SendControl send_control(timer_);
+
+    std::vector<StreamDataInfo> lost_data;
+    send_control.SetStreamDataLostCallback(
+        [&lost_data](uint64_t stream_id, uint64_t offset_start, uint64_t length, bool has_fin) {
+            lost_data.push_back(StreamDataInfo(stream_id, offset_start, length, has_fin));
+        });
+    std::vector<std::shared_ptr<IFrame>> lost_frames;
+    send_control.SetFrameLostCallback([&lost_frames](std::shared_ptr<IFrame> frame) { lost_frames.push_back(frame); });
+
+    auto max_data = std::make_shared<MaxDataFrame>();
+    max_data->SetMaximumData(65536);
+    for (uint64_t pn = 1; pn <= 4; ++pn) {
+        auto packet = std::make_shared<Rtt1Packet>();
+        packet->SetPacketNumber(pn);
+        packet->AddFrameTypeBit(FrameTypeBit::kStreamBit);
+        std::vector<StreamDataInfo> data = {StreamDataInfo(4, (pn - 1) * 100, 100, false)};
+        std::vector<std::shared_ptr<IFrame>> control_frames;
+        if (pn == 1) {
+            control_frames.push_back(max_data);
+        }
+        send_control.OnPacketSend(common::UTCTimeMsec(), packet, 1200, data, control_frames);
+    }
+
+    // ACK only packet 4: packet 1 crosses the packet threshold (RFC 9002 §6.1.1).
+    auto ack_frame = std::make_shared<AckFrame>();
+    ack_frame->SetLargestAck(4);
+    ack_frame->SetAckDelay(0);
+    ack_frame->SetFirstAckRange(0);
+    send_control.OnPacketAck(common::UTCTimeMsec(), PacketNumberSpace::kApplicationNumberSpace, ack_frame);
+
+    ASSERT_EQ(lost_data.size(), 1);
+    EXPECT_EQ(lost_data[0].stream_id, 4);
+    EXPECT_EQ(lost_data[0].offset_start, 0);
+    EXPECT_EQ(lost_data[0].length, 100);
+    ASSERT_EQ(lost_frames.size(), 1);
+    EXPECT_EQ(lost_frames[0], max_data);
+    EXPECT_FALSE(send_control.NeedReSend());
+}
+
+// Test 15: Data ACKed behind a lost frame is released before the hole fills
+TEST_F(StreamAckTrackingTest, AckedDataReleasedBehindHole) {
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto stream =
+        std::make_shared<SendStream>(event_loop, 10000, 4, active_send_cb_, stream_close_cb_, connection_close_cb_);
+
+    // three frames: [0, 100), [100, 300), [300, 600)
+    uint8_t data[300] = {0};
+    for (uint32_t len : {100u, 200u, 300u}) {
+        stream->Send(data, len);
+        FixBufferFrameVisitor visitor(1500);
+        visitor.SetStreamDataSizeLimit(10000);
+        ASSERT_NE(stream->TrySendData(&visitor), IStream::TrySendResult::kFailed);
+    }
+    EXPECT_EQ(stream->GetRetainedSendBytes(), 600u);
+
+    stream->OnDataAcked(100, 200, false);
+    EXPECT_EQ(stream->GetRetainedSendBytes(), 400u);
+    EXPECT_EQ(stream->GetAckedRangeCount(), 1u);
+
+    stream->OnDataAcked(300, 300, false);
+    EXPECT_EQ(stream->GetRetainedSendBytes(), 100u);
+    EXPECT_EQ(stream->GetAckedRangeCount(), 1u);
+
+    // the hole is still resendable
+    stream->OnDataLost(0, 100, false);
+    FixBufferFrameVisitor resend_visitor(1500);
+    resend_visitor.SetStreamDataSizeLimit(10000);
+    stream->TrySendData(&resend_visitor);
+    auto stream_data = resend_visitor.GetStreamDataInfo();
+    ASSERT_EQ(stream_data.size(), 1);
+    EXPECT_EQ(stream_data[0].offset_start, 0);
+    EXPECT_EQ(stream_data[0].length, 100);
+
+    stream->OnDataAcked(0, 100, false);
+    EXPECT_EQ(stream->GetRetainedSendBytes(), 0u);
+    EXPECT_EQ(stream->GetAckedRangeCount(), 0u);
+}
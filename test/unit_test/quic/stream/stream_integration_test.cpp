@@ -34,6 +34,8 @@ public:
         return next_timer_id_++;
     }
     virtual bool RemoveTimer(common::TimerTask& task) override { return true; }
+    virtual void ArmTimer(common::TimerNode& node, uint32_t time, uint64_t now = 0) override {}
+    virtual bool DisarmTimer(common::TimerNode& node) override { return true; }
     virtual int32_t MinTime(uint64_t now = 0) override { return -1; }
     virtual void TimerRun(uint64_t now = 0) override {}
     virtual bool Empty() override { return true; }
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "quic/stream/if_stream.h"
+#include "quic/stream/scheduler/if_stream_scheduler.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+class TestStream: public IStream {
+public:
+    explicit TestStream(uint64_t id): IStream(std::weak_ptr<common::IEventLoop>(), id, nullptr, nullptr, nullptr) {}
+    virtual uint32_t OnFrame(std::shared_ptr<IFrame> frame) override { return 0; }
+    virtual void Reset(uint32_t error) override {}
+    virtual StreamDirection GetDirection() override { return StreamDirection::kSend; }
+    virtual uint64_t GetStreamID() override { return stream_id_; }
+};
+
+std::shared_ptr<IStream> MakeTestStream(uint64_t id, uint8_t urgency = kStreamUrgencyDefault, bool incremental = false) {
+    auto stream = std::make_shared<TestStream>(id);
+    stream->SetPriority(urgency, incremental);
+    return stream;
+}
+
+// Serve |packets| packets; every stream popped fills its packet and stays ready.
+std::vector<uint64_t> Serve(IStreamScheduler& scheduler, size_t packets) {
+    std::vector<uint64_t> order;
+    for (size_t i = 0; i < packets; i++) {
+        auto stream = scheduler.Pop();
+        if (!stream) {
+            break;
+        }
+        order.push_back(stream->GetStreamID());
+        scheduler.Requeue(stream);
+    }
+    return order;
+}
+
+TEST(StreamSchedulerTest, FactoryAndQueueBasics) {
+    for (auto type : {StreamSchedulerType::kUrgencyIncremental, StreamSchedulerType::kStrictPriority,
+             StreamSchedulerType::kWeightedRoundRobin}) {
+        auto scheduler = MakeStreamScheduler(type);
+        ASSERT_NE(scheduler, nullptr);
+        EXPECT_EQ(scheduler->GetType(), type);
+        EXPECT_TRUE(scheduler->IsEmpty());
+        EXPECT_EQ(scheduler->Pop(), nullptr);
+
+        auto stream = MakeTestStream(4);
+        scheduler->Push(stream);
+        scheduler->Push(stream);  // already queued
+        EXPECT_EQ(scheduler->Size(), 1u);
+        EXPECT_EQ(scheduler->Pop(), stream);
+        EXPECT_TRUE(scheduler->IsEmpty());
+
+        scheduler->Push(stream);
+        scheduler->Push(MakeTestStream(8));
+        scheduler->Clear();
+        EXPECT_TRUE(scheduler->IsEmpty());
+        EXPECT_EQ(scheduler->Pop(), nullptr);
+    }
+}
+
+TEST(StreamSchedulerTest, StrictPriorityServesMostUrgentFirst) {
+    auto scheduler = MakeStreamScheduler(StreamSchedulerType::kStrictPriority);
+    auto bulk = MakeTestStream(4, 5);
+    scheduler->Push(bulk);
+    scheduler->Push(MakeTestStream(8, 5));
+    scheduler->Push(MakeTestStream(12, 1));
+
+    // urgency 1 owns the link while it has data, urgency 5 streams alternate
+    EXPECT_EQ(Serve(*scheduler, 3), (std::vector<uint64_t>{12, 12, 12}));
+    auto control = scheduler->Pop();
+    ASSERT_EQ(control->GetStreamID(), 12u);
+    EXPECT_EQ(Serve(*scheduler, 4), (std::vector<uint64_t>{4, 8, 4, 8}));
+}
+
+TEST(StreamSchedulerTest, UrgencyIncrementalFollowsRfc9218) {
+    auto scheduler = MakeStreamScheduler(StreamSchedulerType::kUrgencyIncremental);
+    scheduler->Push(MakeTestStream(12));
+    scheduler->Push(MakeTestStream(4));
+    scheduler->Push(MakeTestStream(16, kStreamUrgencyDefault, true));
+    scheduler->Push(MakeTestStream(20, kStreamUrgencyDefault, true));
+
+    // non-incremental streams go one at a time in stream ID order
+    EXPECT_EQ(Serve(*scheduler, 2), (std::vector<uint64_t>{4, 4}));
+    ASSERT_EQ(scheduler->Pop()->GetStreamID(), 4u);
+    ASSERT_EQ(scheduler->Pop()->GetStreamID(), 12u);
+
+    // then incremental ones share packets
+    EXPECT_EQ(Serve(*scheduler, 4), (std::vector<uint64_t>{16, 20, 16, 20}));
+
+    // a more urgent stream jumps ahead
+    scheduler->Push(MakeTestStream(24, 0));
+    EXPECT_EQ(Serve(*scheduler, 1), (std::vector<uint64_t>{24}));
+}
+
+TEST(StreamSchedulerTest, DefaultDoesNotHoldSmallStreamBehindBulk) {
+    auto scheduler = MakeStreamScheduler(QuicConfig().stream_scheduler_);
+    auto bulk = MakeTestStream(0);
+    scheduler->Push(bulk);
+    EXPECT_EQ(Serve(*scheduler, 3), (std::vector<uint64_t>{0, 0, 0}));
+
+    // a small stream opened while stream 0 is mid-transfer gets the next turn
+    auto small = MakeTestStream(4);
+    scheduler->Push(small);
+    EXPECT_EQ(Serve(*scheduler, 1), (std::vector<uint64_t>{0}));
+    EXPECT_EQ(scheduler->Pop(), small);
+
+    // an HTTP/3 control/QPACK stream (urgency 0) goes ahead of a bulk
+    // stream 0 under both priority policies
+    for (auto type : {StreamSchedulerType::kUrgencyIncremental, StreamSchedulerType::kStrictPriority}) {
+        auto other = MakeStreamScheduler(type);
+        other->Push(MakeTestStream(0));
+        other->Push(MakeTestStream(3, 0));
+        EXPECT_EQ(other->Pop()->GetStreamID(), 3u);
+    }
+}
+
+TEST(StreamSchedulerTest, WeightedRoundRobinSharesByUrgency) {
+    auto scheduler = MakeStreamScheduler(StreamSchedulerType::kWeightedRoundRobin);
+    scheduler->Push(MakeTestStream(4, 5));  // weight 3
+    scheduler->Push(MakeTestStream(8, 7));  // weight 1
+
+    auto order = Serve(*scheduler, 8);
+    EXPECT_EQ(order, (std::vector<uint64_t>{4, 4, 4, 8, 4, 4, 4, 8}));
+}
+
+TEST(StreamSchedulerTest, PriorityChangeWhileQueued) {
+    for (auto type : {StreamSchedulerType::kUrgencyIncremental, StreamSchedulerType::kStrictPriority}) {
+        auto scheduler = MakeStreamScheduler(type);
+        auto first = MakeTestStream(4, 2);
+        auto second = MakeTestStream(8, 4);
+        scheduler->Push(first);
+        scheduler->Push(second);
+
+        first->SetPriority(6, false);
+        EXPECT_EQ(scheduler->Pop(), second);
+        EXPECT_EQ(scheduler->Pop(), first);
+        EXPECT_TRUE(scheduler->IsEmpty());
+    }
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx
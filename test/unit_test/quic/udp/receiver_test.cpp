@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include "common/buffer/buffer_span.h"
+#include "common/buffer/single_block_buffer.h"
+#include "common/buffer/standalone_buffer_chunk.h"
+#include "common/network/io_handle.h"
+#include "quic/common/constants.h"
+#include "quic/config.h"
+#include "quic/connection/transport_param.h"
+#include "quic/udp/udp_receiver.h"
+#include "quic/udp/udp_sender.h"
+
+namespace quicx {
+namespace quic {
+namespace {
+
+class CaptureHandler: public IPacketReceiver {
+public:
+    void OnPacket(std::shared_ptr<NetPacket>& pkt) override {
+        auto span = pkt->GetData()->GetReadableSpan();
+        datagrams_.emplace_back(span.GetStart(), span.GetStart() + span.GetLength());
+    }
+    std::vector<std::vector<uint8_t>> datagrams_;
+};
+
+// A PMTU probe above Ethernet size, sent where the peer advertised a jumbo
+// max_udp_payload_size, arrives whole instead of cut to kPacketBufferSize
+TEST(UdpReceiverTest, JumboProbeReceivedWhole) {
+#ifdef _WIN32
+    GTEST_SKIP() << "Skipped on Windows: loopback UDP may be blocked by firewall";
+#endif
+    // the advertised limit is no longer capped at the 1500-byte buffers
+    QuicTransportParams conf = DEFAULT_QUIC_TRANSPORT_PARAMS;
+    conf.max_udp_payload_size_ = kMaxPlpmtu;
+    TransportParam local_tp;
+    local_tp.Init(conf);
+    uint8_t buf[1024] = {0};
+    size_t bytes_written = 0;
+    common::BufferSpan write_span(buf, sizeof(buf));
+    ASSERT_TRUE(local_tp.Encode(write_span, bytes_written));
+    TransportParam peer_view;
+    ASSERT_TRUE(peer_view.Decode(common::BufferSpan(buf, static_cast<uint32_t>(bytes_written))));
+    ASSERT_EQ(peer_view.GetmaxUdpPayloadSize(), kMaxPlpmtu);
+
+    auto event_loop = common::MakeEventLoop();
+    ASSERT_TRUE(event_loop->Init());
+    auto recv_sock = common::UdpSocket4();
+    ASSERT_EQ(recv_sock.error_code_, 0);
+    common::SocketNoblocking(recv_sock.return_value_);
+    common::Address recv_addr("127.0.0.1", 0);
+    ASSERT_EQ(common::Bind(recv_sock.return_value_, recv_sock.family_, recv_addr).error_code_, 0);
+    ASSERT_TRUE(common::ParseLocalAddress(recv_sock.return_value_, recv_addr));
+
+    auto handler = std::make_shared<CaptureHandler>();
+    auto receiver = std::make_shared<UdpReceiver>(event_loop);
+    receiver->SetMaxDatagramSize(local_tp.GetmaxUdpPayloadSize());
+    ASSERT_TRUE(receiver->AddReceiver(recv_sock.return_value_, handler));
+
+    auto send_sock = common::UdpSocket4();
+    ASSERT_EQ(send_sock.error_code_, 0);
+    common::EnableUdpDontFragment(send_sock.return_value_);
+    UdpSender sender(send_sock.return_value_);
+    const uint32_t sizes[] = {kPacketBufferSize + 500, kMaxPlpmtu};
+    for (uint32_t size : sizes) {
+        std::vector<uint8_t> probe(size);
+        for (uint32_t i = 0; i < size; i++) {
+            probe[i] = static_cast<uint8_t>(i);
+        }
+        auto chunk = std::make_shared<common::StandaloneBufferChunk>(size);
+        ASSERT_TRUE(chunk->Valid());
+        auto buffer = std::make_shared<common::SingleBlockBuffer>(chunk);
+        buffer->Write(probe.data(), size);
+        auto pkt = std::make_shared<NetPacket>();
+        pkt->SetData(buffer);
+        pkt->SetAddress(recv_addr);
+        ASSERT_TRUE(sender.Send(pkt));
+
+        size_t before = handler->datagrams_.size();
+        for (int i = 0; i < 20 && handler->datagrams_.size() == before; i++) {
+            event_loop->Wait();
+        }
+        ASSERT_EQ(handler->datagrams_.size(), before + 1);
+        EXPECT_EQ(handler->datagrams_.back(), probe);
+    }
+
+    receiver->RemoveReceiver(recv_sock.return_value_);
+    common::Close(recv_sock.return_value_);
+    common::Close(send_sock.return_value_);
+}
+
+}  // namespace
+}  // namespace quic
+}  // namespace quicx